@@ -0,0 +1,111 @@
+/*
+ * Sim65 function call benchmark.
+ *
+ * Description
+ * -----------
+ *
+ * This example uses the clock cycle counter of sim65 to measure the cost of
+ * calls to small functions. A __fastcall__ function gets its last parameter
+ * in A/X and pushes it onto the C stack on entry. For leaf functions that
+ * only read the parameter back into A/X, the optimizer removes the push and
+ * the stack cleanup. A call at the end of a function is done after the
+ * parameters are dropped, so it is a jump and the callee returns directly
+ * to the caller.
+ *
+ * Each test calls the function a hundred times, the loop overhead is
+ * measured separately. Compare the numbers with and without the steps, for
+ * example
+ *
+ *   cl65 -t sim6502 -Osir call_example.c
+ *   cl65 -t sim6502 -Osir -Wc --disable-opt,OptLeafFrame call_example.c
+ *
+ * Running the example
+ * -------------------
+ *
+ * cl65 -t sim6502 -Osir call_example.c -o call_example.prg
+ * sim65 call_example.prg
+ *
+ */
+
+#include <stdio.h>
+#include <sim65.h>
+
+#define CALLS   100
+
+static int result;
+static unsigned char ch;
+
+static uint32_t timestamp(void)
+{
+    peripherals.counter.select = COUNTER_SELECT_CLOCKCYCLE_COUNTER;
+    peripherals.counter.latch = 0;
+    return peripherals.counter.value32[0];
+}
+
+/* Leaf functions */
+static int inc(int x)
+{
+    return x + 1;
+}
+
+static unsigned char lower(unsigned char c)
+{
+    return c | 0x20;
+}
+
+/* Calls at the end of a function */
+static int twice(int x)
+{
+    return inc(x * 2);
+}
+
+static int sum(int a, int b)
+{
+    return inc(a + b);
+}
+
+static uint32_t overhead;
+
+static void measure(const char* name, uint32_t t1)
+{
+    uint32_t t = timestamp() - t1 - overhead;
+    printf("%-12s %lu cycles, %lu per call\n", name, t, t / CALLS);
+}
+
+int main(void)
+{
+    uint32_t t;
+    unsigned char i;
+
+    t = timestamp();
+    for (i = 0; i < CALLS; ++i) {
+        result = i;
+    }
+    overhead = timestamp() - t;
+
+    t = timestamp();
+    for (i = 0; i < CALLS; ++i) {
+        result = inc(i);
+    }
+    measure("inc", t);
+
+    t = timestamp();
+    for (i = 0; i < CALLS; ++i) {
+        ch = lower(i);
+    }
+    measure("lower", t);
+
+    t = timestamp();
+    for (i = 0; i < CALLS; ++i) {
+        result = twice(i);
+    }
+    measure("twice", t);
+
+    t = timestamp();
+    for (i = 0; i < CALLS; ++i) {
+        result = sum(i, i);
+    }
+    measure("sum", t);
+
+    return (result == 2 * (CALLS - 1) + 1 && ch == ((CALLS - 1) | 0x20))? 0 : 1;
+}
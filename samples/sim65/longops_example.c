@@ -0,0 +1,131 @@
+/*
+ * Sim65 long arithmetic benchmark.
+ *
+ * Description
+ * -----------
+ *
+ * This example uses the clock cycle counter of sim65 to compare the runtime
+ * calls for operations on longs with the inline code that the compiler
+ * generates for them if one operand is a constant or a static variable:
+ *
+ *   checksum   running sums as in Fletcher and Adler checksums (+=)
+ *   crc32      the bitwise CRC-32 (&, >>, ^)
+ *   fixed      16.16 fixed point motion (+, -, <, >=, >>, <<)
+ *
+ * Each function is compiled twice, once with the lowest code size factor,
+ * which selects the runtime calls, and once with a cycle weight of 100,
+ * which selects the inline code whenever it is faster. Without the cycle
+ * weight, the code size factor decides, see the --codesize option.
+ *
+ * Running the example
+ * -------------------
+ *
+ * cl65 -t sim6502 -O longops_example.c -o longops_example.prg
+ * sim65 longops_example.prg
+ *
+ */
+
+#include <stdio.h>
+#include <sim65.h>
+
+#define COUNT   10
+
+static unsigned char data[32] = "The quick brown fox jumps over";
+static unsigned long sum1, sum2;
+static unsigned long crc;
+static long px = 0x120000L, py = 0x340000L;
+static long vx = 0x18000L, vy = -0x8000L;
+static long offset;
+static unsigned char i, k;
+
+static uint32_t timestamp(void)
+{
+    peripherals.counter.select = COUNTER_SELECT_CLOCKCYCLE_COUNTER;
+    peripherals.counter.latch = 0;
+    return peripherals.counter.value32[0];
+}
+
+#define FUNCTIONS(prefix)                                                   \
+static void prefix##checksum(void)                                          \
+{                                                                           \
+    sum1 = 1;                                                               \
+    sum2 = 0;                                                               \
+    for (i = 0; i < sizeof(data); ++i) {                                    \
+        sum1 += data[i];                                                    \
+        sum2 += sum1;                                                       \
+    }                                                                       \
+}                                                                           \
+static void prefix##crc32(void)                                             \
+{                                                                           \
+    crc = 0xFFFFFFFFUL;                                                     \
+    for (i = 0; i < sizeof(data); ++i) {                                    \
+        crc ^= data[i];                                                     \
+        for (k = 0; k < 8; ++k) {                                           \
+            if (crc & 1) {                                                  \
+                crc = (crc >> 1) ^ 0xEDB88320UL;                            \
+            } else {                                                        \
+                crc >>= 1;                                                  \
+            }                                                               \
+        }                                                                   \
+    }                                                                       \
+}                                                                           \
+static void prefix##fixed(void)                                             \
+{                                                                           \
+    px = px + vx;                                                           \
+    py = py - vy;                                                           \
+    if (px < 0x10000L || px >= 0x13F0000L) {                                \
+        vx = -vx;                                                           \
+    }                                                                       \
+    if (py < 0x10000L || py >= 0xC70000L) {                                 \
+        vy = -vy;                                                           \
+    }                                                                       \
+    offset = ((py >> 16) << 6) + (px >> 19);                                \
+}
+
+#pragma codesize (push, 10)
+FUNCTIONS(call_)
+#pragma codesize (pop)
+
+#pragma cycle-weight (push, 100)
+FUNCTIONS(inline_)
+#pragma cycle-weight (pop)
+
+static uint32_t measure(void (*func)(void))
+{
+    uint32_t t1, t2, overhead;
+    unsigned n;
+
+    /* Calibration measurement with an empty loop, to determine the overhead. */
+
+    t1 = timestamp();
+    for (n = 0; n < COUNT; ++n) {
+    }
+    t2 = timestamp();
+    overhead = t2 - t1;
+
+    t1 = timestamp();
+    for (n = 0; n < COUNT; ++n) {
+        func();
+    }
+    t2 = timestamp();
+
+    return (t2 - t1 - overhead) / COUNT;
+}
+
+static void compare(const char* name, void (*call)(void), void (*inl)(void))
+{
+    printf("%-8s %6lu cycles called, %6lu cycles inline\n",
+           name, measure(call), measure(inl));
+}
+
+int main(void)
+{
+    compare("checksum", call_checksum, inline_checksum);
+    printf("sums %08lx %08lx\n", sum1, sum2);
+    compare("crc32", call_crc32, inline_crc32);
+    printf("crc %08lx\n", crc ^ 0xFFFFFFFFUL);
+    compare("fixed", call_fixed, inline_fixed);
+    printf("position %08lx %08lx\n", px, py);
+
+    return 0;
+}
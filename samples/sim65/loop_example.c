@@ -0,0 +1,115 @@
+/*
+ * Sim65 array loop benchmark.
+ *
+ * Description
+ * -----------
+ *
+ * This example uses the clock cycle counter of sim65 to measure the cost of
+ * simple loops over arrays, as they are used to fill, copy or sum buffers.
+ * The counters are declared as int, as it is common in portable C code.
+ *
+ * With --narrow-loop-vars, counters that never leave the range of a byte
+ * are compiled as unsigned char. The optimizer then indexes pointers with
+ * the counter in the Y register, and loads the pointers only once in front
+ * of the loop. Compare the numbers for different options, for example
+ *
+ *   cl65 -t sim6502 -Osir loop_example.c
+ *   cl65 -t sim6502 -Osir --narrow-loop-vars loop_example.c
+ *
+ * Running the example
+ * -------------------
+ *
+ * cl65 -t sim6502 -Osir --narrow-loop-vars loop_example.c -o loop_example.prg
+ * sim65 loop_example.prg
+ *
+ */
+
+#include <stdio.h>
+#include <sim65.h>
+
+#define SIZE    200
+
+static unsigned char src[SIZE];
+static unsigned char dst[SIZE];
+static int words[SIZE / 2];
+static unsigned sum;
+
+static uint32_t timestamp(void)
+{
+    peripherals.counter.select = COUNTER_SELECT_CLOCKCYCLE_COUNTER;
+    peripherals.counter.latch = 0;
+    return peripherals.counter.value32[0];
+}
+
+static void fill(void)
+{
+    int i;
+    for (i = 0; i < SIZE; ++i) {
+        src[i] = i;
+    }
+}
+
+static void clear(unsigned char* p)
+{
+    int i;
+    for (i = 0; i < SIZE; ++i) {
+        p[i] = 0;
+    }
+}
+
+static void copy(unsigned char* d, const unsigned char* s)
+{
+    int i;
+    for (i = 0; i < SIZE; ++i) {
+        d[i] = s[i];
+    }
+}
+
+static void add(const unsigned char* p)
+{
+    int i;
+    sum = 0;
+    for (i = 0; i < SIZE; ++i) {
+        sum += p[i];
+    }
+}
+
+static void fillwords(int v)
+{
+    int i;
+    for (i = 0; i < SIZE / 2; ++i) {
+        words[i] = v;
+    }
+}
+
+static void measure(const char* name, uint32_t t1)
+{
+    printf("%-12s %lu cycles\n", name, timestamp() - t1);
+}
+
+int main(void)
+{
+    uint32_t t;
+
+    t = timestamp();
+    fill();
+    measure("fill", t);
+
+    t = timestamp();
+    clear(dst);
+    measure("clear", t);
+
+    t = timestamp();
+    copy(dst, src);
+    measure("copy", t);
+
+    t = timestamp();
+    add(dst);
+    measure("add", t);
+
+    t = timestamp();
+    fillwords(-1);
+    measure("fillwords", t);
+
+    return (sum == (unsigned) SIZE * (SIZE - 1) / 2)? 0 : 1;
+}
@@ -0,0 +1,118 @@
+/*
+ * Sim65 constant multiplication benchmark.
+ *
+ * Description
+ * -----------
+ *
+ * This example uses the clock cycle counter of sim65 to measure the cost of
+ * multiplications by constants, as they are used for scaling indices: Rows
+ * of a 40 column text screen or a 320 pixel wide bitmap, and arrays of
+ * structures whose size isn't a power of two.
+ *
+ * The compiler replaces a multiplication by a constant with a chain of
+ * shifts and additions, or calls of small runtime functions, if this is
+ * cheaper than the generic multiplication. The choice depends on the code
+ * size factor and the cycle weight. Compare the numbers for different
+ * options, for example
+ *
+ *   cl65 -t sim6502 -O mul_example.c                     (smallest code)
+ *   cl65 -t sim6502 -Oi mul_example.c                    (faster code may be larger)
+ *   cl65 -t sim6502 -O --cycle-weight 100 mul_example.c  (fastest code)
+ *
+ * Running the example
+ * -------------------
+ *
+ * cl65 -t sim6502 -O mul_example.c -o mul_example.prg
+ * sim65 mul_example.prg
+ *
+ */
+
+#include <stdio.h>
+#include <sim65.h>
+
+#define COUNT   100
+
+struct entry {
+    unsigned char kind;
+    unsigned char color;
+    unsigned      x, y;
+    unsigned      dx, dy;
+    unsigned char flags;
+};
+
+static unsigned char index;
+static unsigned offset;
+static unsigned long loffset;
+
+static uint32_t timestamp(void)
+{
+    peripherals.counter.select = COUNTER_SELECT_CLOCKCYCLE_COUNTER;
+    peripherals.counter.latch = 0;
+    return peripherals.counter.value32[0];
+}
+
+static void row40(void)
+{
+    offset = index * 40;
+}
+
+static void row320(void)
+{
+    offset = index * 320;
+}
+
+static void entry(void)
+{
+    offset = index * sizeof (struct entry);
+}
+
+static void triple(void)
+{
+    offset = index * 3;
+}
+
+static void byte10(void)
+{
+    index = (unsigned char) (index * 10);
+}
+
+static void long1000(void)
+{
+    loffset = index * 1000UL;
+}
+
+static void measure(const char* name, void (*func)(void))
+{
+    uint32_t t1, t2, overhead;
+    unsigned i;
+
+    /* Calibration measurement with an empty loop, to determine the overhead. */
+
+    t1 = timestamp();
+    for (i = 0; i < COUNT; ++i) {
+        index = (unsigned char) i;
+    }
+    t2 = timestamp();
+    overhead = t2 - t1;
+
+    t1 = timestamp();
+    for (i = 0; i < COUNT; ++i) {
+        index = (unsigned char) i;
+        func();
+    }
+    t2 = timestamp();
+
+    printf("%-12s %lu cycles\n", name, (t2 - t1 - overhead) / COUNT);
+}
+
+int main(void)
+{
+    measure("row * 40", row40);
+    measure("row * 320", row320);
+    measure("entry * 11", entry);
+    measure("index * 3", triple);
+    measure("byte * 10", byte10);
+    measure("long * 1000", long1000);
+
+    return 0;
+}
@@ -0,0 +1,101 @@
+/*
+ * Sim65 profile-guided optimization example.
+ *
+ * Description
+ * -----------
+ *
+ * This example shows how an execution profile written by sim65 is used by
+ * the compiler. The program spends almost all of its time in 'checksum',
+ * while 'fill' and 'report' run only once.
+ *
+ * With --use-profile, the compiler optimizes the functions that take most of
+ * the cycles for speed, as if -Oi and --cycle-weight 50 were given for them,
+ * and the functions that take almost no time for size. With
+ * --auto-register-vars, the variables that are used most often according to
+ * the profile are placed into the register bank.
+ *
+ * Running the example
+ * -------------------
+ *
+ * First build the program with debug info and run it with a profile:
+ *
+ * cl65 -t sim6502 -Or -g -Wl --dbgfile,profile_example.dbg profile_example.c -o profile_example.prg
+ * sim65 --profile profile_example.prof --dbgfile profile_example.dbg profile_example.prg
+ *
+ * Then build it again using the profile and compare the number of cycles:
+ *
+ * cl65 -t sim6502 -Or --use-profile profile_example.prof profile_example.c -o profile_example.prg
+ * sim65 profile_example.prg
+ *
+ */
+
+#include <stdio.h>
+#include <sim65.h>
+
+#define SIZE    200
+#define ROUNDS  20
+
+static unsigned char buf[SIZE];
+
+static uint32_t timestamp(void)
+{
+    peripherals.counter.select = COUNTER_SELECT_CLOCKCYCLE_COUNTER;
+    peripherals.counter.latch = 0;
+    return peripherals.counter.value32[0];
+}
+
+static void fill(unsigned seed)
+/* Fill the buffer with pseudo random numbers. */
+{
+    unsigned i;
+
+    for (i = 0; i < SIZE; ++i) {
+        seed = seed * 5 + 1;
+        buf[i] = seed >> 8;
+    }
+}
+
+static unsigned checksum(const unsigned char* p, unsigned n)
+/* Return a Fletcher checksum of n bytes at p. */
+{
+    unsigned char a = 0;
+    unsigned char b = 0;
+    unsigned i;
+
+    for (i = 0; i < n; ++i) {
+        a += p[i];
+        if (a < p[i]) {
+            ++a;
+        }
+        b += a;
+        if (b < a) {
+            ++b;
+        }
+    }
+    return (b << 8) | a;
+}
+
+static void report(unsigned sum, uint32_t cycles)
+/* Print the results. */
+{
+    printf("checksum $%04X, %lu cycles per round\n", sum, cycles / ROUNDS);
+}
+
+int main(void)
+{
+    unsigned char r;
+    unsigned sum = 0;
+    uint32_t t1, t2;
+
+    fill(1234);
+
+    t1 = timestamp();
+    for (r = 0; r < ROUNDS; ++r) {
+        sum += checksum(buf, SIZE);
+    }
+    t2 = timestamp();
+
+    report(sum, t2 - t1);
+
+    return 0;
+}
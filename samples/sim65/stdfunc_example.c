@@ -0,0 +1,109 @@
+/*
+ * Sim65 inline standard function benchmark.
+ *
+ * Description
+ * -----------
+ *
+ * This example uses the clock cycle counter of sim65 to compare calls of
+ * some standard library functions with the inline code that the compiler
+ * generates for them if the arguments are constant or known-small:
+ *
+ *   abs, labs          for any argument, negative values still call the runtime
+ *   memcmp, strncpy    for constant addresses and a constant count
+ *   memmove            for constant addresses whose overlap is known
+ *   strchr             for a constant character and a small array
+ *
+ * Each function is compiled twice, once with inlining disabled by
+ * #pragma inline-stdfuncs, and once with inlining enabled and a cycle
+ * weight of 100, which selects the inline code whenever it is faster.
+ * Without the cycle weight, the code size factor decides; the inline code
+ * for memmove is always used, since it is smaller than the call.
+ *
+ * Running the example
+ * -------------------
+ *
+ * cl65 -t sim6502 -O stdfunc_example.c -o stdfunc_example.prg
+ * sim65 stdfunc_example.prg
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sim65.h>
+
+#define COUNT   20
+
+static char name[16] = "sim65 example";
+static char other[16] = "sim65 benchmark";
+static char buffer[32];
+static int value = 1234;
+static long lvalue = 123456L;
+static int result;
+static long lresult;
+static char* ptr;
+
+static uint32_t timestamp(void)
+{
+    peripherals.counter.select = COUNTER_SELECT_CLOCKCYCLE_COUNTER;
+    peripherals.counter.latch = 0;
+    return peripherals.counter.value32[0];
+}
+
+#define FUNCTIONS(prefix)                                                   \
+static void prefix##abs(void)     { result = abs(value); }                  \
+static void prefix##labs(void)    { lresult = labs(lvalue); }               \
+static void prefix##memcmp(void)  { result = memcmp(name, other, 16); }     \
+static void prefix##memmove(void) { memmove(buffer + 1, buffer, 16); }      \
+static void prefix##strchr(void)  { ptr = strchr(name, 'x'); }             \
+static void prefix##strncpy(void) { strncpy(buffer, name, 32); }
+
+#pragma inline-stdfuncs (push, off)
+FUNCTIONS(call_)
+#pragma inline-stdfuncs (pop)
+
+#pragma inline-stdfuncs (push, on)
+#pragma cycle-weight (push, 100)
+FUNCTIONS(inline_)
+#pragma cycle-weight (pop)
+#pragma inline-stdfuncs (pop)
+
+static uint32_t measure(void (*func)(void))
+{
+    uint32_t t1, t2, overhead;
+    unsigned i;
+
+    /* Calibration measurement with an empty loop, to determine the overhead. */
+
+    t1 = timestamp();
+    for (i = 0; i < COUNT; ++i) {
+    }
+    t2 = timestamp();
+    overhead = t2 - t1;
+
+    t1 = timestamp();
+    for (i = 0; i < COUNT; ++i) {
+        func();
+    }
+    t2 = timestamp();
+
+    return (t2 - t1 - overhead) / COUNT;
+}
+
+static void compare(const char* name, void (*call)(void), void (*inl)(void))
+{
+    printf("%-8s %5lu cycles called, %5lu cycles inline\n",
+           name, measure(call), measure(inl));
+}
+
+int main(void)
+{
+    compare("abs", call_abs, inline_abs);
+    compare("labs", call_labs, inline_labs);
+    compare("memcmp", call_memcmp, inline_memcmp);
+    compare("memmove", call_memmove, inline_memmove);
+    compare("strchr", call_strchr, inline_strchr);
+    compare("strncpy", call_strncpy, inline_strncpy);
+
+    return 0;
+}
@@ -0,0 +1,119 @@
+/*
+ * Sim65 switch statement benchmark.
+ *
+ * Description
+ * -----------
+ *
+ * This example uses the clock cycle counter of sim65 to measure the cost of
+ * dispatching a switch statement, as used in a typical state machine.
+ *
+ * The function 'step' contains a switch over a dense range of 40 states with
+ * a few holes. The compiler chooses between a compare cascade, a binary search
+ * and a jump table for such a switch, depending on the number and density of
+ * the case values and on the code size factor.
+ *
+ * The main function runs the state machine through all states several times
+ * and prints the average number of clock cycles per step, including the call
+ * of 'step'. Compare the numbers for different options, for example
+ *
+ *   cl65 -t sim6502 -O switch_example.c      (smallest code)
+ *   cl65 -t sim6502 -Oi switch_example.c     (faster code may be larger)
+ *   cl65 -t sim65c02 -O switch_example.c     (65C02 jump tables)
+ *
+ * Running the example
+ * -------------------
+ *
+ * cl65 -t sim6502 -O switch_example.c -o switch_example.prg
+ * sim65 switch_example.prg
+ *
+ */
+
+#include <stdio.h>
+#include <sim65.h>
+
+#define ROUNDS  10
+
+static unsigned char count;
+
+static uint32_t timestamp(void)
+{
+    peripherals.counter.select = COUNTER_SELECT_CLOCKCYCLE_COUNTER;
+    peripherals.counter.latch = 0;
+    return peripherals.counter.value32[0];
+}
+
+static unsigned char step(unsigned char state)
+/* Return the state following 'state'. */
+{
+    switch (state) {
+        case 0:  ++count; return 1;
+        case 1:  return 2;
+        case 2:  return 3;
+        case 3:  return 4;
+        case 4:  return 5;
+        case 5:  return 7;
+        case 7:  return 8;
+        case 8:  return 9;
+        case 9:  return 10;
+        case 10: return 11;
+        case 11: return 12;
+        case 12: return 13;
+        case 13: return 14;
+        case 14: return 15;
+        case 15: return 17;
+        case 17: return 18;
+        case 18: return 19;
+        case 19: return 20;
+        case 20: return 21;
+        case 21: return 22;
+        case 22: return 23;
+        case 23: return 24;
+        case 24: return 25;
+        case 25: return 26;
+        case 26: return 28;
+        case 28: return 29;
+        case 29: return 30;
+        case 30: return 31;
+        case 31: return 32;
+        case 32: return 33;
+        case 33: return 34;
+        case 34: return 35;
+        case 35: return 36;
+        case 36: return 37;
+        case 37: return 38;
+        case 38: return 39;
+        case 39: return 40;
+        case 40: return 41;
+        case 41: return 42;
+        case 42: return 43;
+        case 43: return 0;
+        default: return 0;
+    }
+}
+
+int main(void)
+{
+    unsigned char state = 0;
+    unsigned steps = 0;
+    uint32_t t1, t2, overhead;
+
+    /* Calibration measurement of zero clock cycles, to determine the overhead. */
+
+    t1 = timestamp();
+    t2 = timestamp();
+    overhead = t2 - t1;
+
+    /* Run the state machine */
+
+    count = 0;
+    t1 = timestamp();
+    while (count <= ROUNDS) {
+        state = step(state);
+        ++steps;
+    }
+    t2 = timestamp();
+
+    printf("%u steps, %lu cycles per step\n", steps, (t2 - t1 - overhead) / steps);
+
+    return 0;
+}
@@ -53,6 +53,9 @@
 
 static const char AnonTag[] = "$anon";
 
+/* Counter for anonymous names */
+static unsigned ACount = 0;
+
 
 
 /*****************************************************************************/
@@ -77,7 +80,6 @@ char* AnonName (char* Buf, const char* Spec)
 ** to be IDENTSIZE characters long. A pointer to the buffer is returned.
 */
 {
-    static unsigned ACount = 0;
     xsprintf (Buf, IDENTSIZE, "%s-%s-%04X", AnonTag, Spec, ++ACount);
     return Buf;
 }
@@ -89,3 +91,11 @@ int IsAnonName (const char* Name)
 {
     return (strncmp (Name, AnonTag, sizeof (AnonTag) - 1) == 0);
 }
+
+
+
+void ResetAnonNames (void)
+/* Restart the numbering of anonymous names for a new translation unit */
+{
+    ACount = 0;
+}
@@ -57,6 +57,9 @@ char* AnonName (char* Buf, const char* Spec);
 int IsAnonName (const char* Name);
 /* Check if the given symbol name is that of an anonymous symbol */
 
+void ResetAnonNames (void);
+/* Restart the numbering of anonymous names for a new translation unit */
+
 
 
 /* End of anonname.h */
@@ -126,6 +126,9 @@ void WriteAsmOutput (void)
         if (SymIsOutputFunc (Entry)) {
             /* Function which is defined and referenced or extern */
             OutputSegments (Entry->V.F.Seg);
+
+            /* The code isn't needed any longer */
+            CS_ReleaseCode (Entry->V.F.Seg->Code);
         }
         Entry = Entry->NextSym;
     }
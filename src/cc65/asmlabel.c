@@ -38,6 +38,7 @@
 
 /* common */
 #include "chartype.h"
+#include "thread.h"
 
 /* cc65 */
 #include "asmlabel.h"
@@ -52,7 +53,11 @@
 
 
 
-static struct SegContext* CurrentFunctionSegment;
+/* Per thread, since functions may be optimized in parallel */
+static THREAD_LOCAL struct SegContext* CurrentFunctionSegment;
+
+/* Number to generate unique literal labels */
+static unsigned NextLiteralLabel = 0;
 
 
 
@@ -88,11 +93,11 @@ unsigned GetLocalLabel (void)
 
 const char* LocalLabelName (unsigned L)
 /* Make a label name from the given label number. The label name will be
-** created in static storage and overwritten when calling the function
-** again.
+** created in static per thread storage and overwritten when calling the
+** function again.
 */
 {
-    static char Buf[64];
+    static THREAD_LOCAL char Buf[64];
     sprintf (Buf, "L%04X", L);
     return Buf;
 }
@@ -137,10 +142,11 @@ unsigned GetLocalDataLabel (void)
 
 const char* LocalDataLabelName (unsigned L)
 /* Make a label name from the given data label number. The label name will be
-** created in static storage and overwritten when calling the function again.
+** created in static per thread storage and overwritten when calling the
+** function again.
 */
 {
-    static char Buf[64];
+    static THREAD_LOCAL char Buf[64];
     sprintf (Buf, "M%04X", L);
     return Buf;
 }
@@ -150,16 +156,21 @@ const char* LocalDataLabelName (unsigned L)
 unsigned GetPooledLiteralLabel (void)
 /* Get an unused literal label. Will never return zero. */
 {
-    /* Number to generate unique labels */
-    static unsigned NextLabel = 0;
-
     /* Check for an overflow */
-    if (NextLabel >= 0xFFFF) {
+    if (NextLiteralLabel >= 0xFFFF) {
         Internal ("Literal label overflow");
     }
 
     /* Return the next label */
-    return ++NextLabel;
+    return ++NextLiteralLabel;
+}
+
+
+
+void ResetPooledLiteralLabels (void)
+/* Restart the numbering of literal labels for a new translation unit */
+{
+    NextLiteralLabel = 0;
 }
 
 
@@ -80,6 +80,9 @@ const char* LocalDataLabelName (unsigned L);
 unsigned GetPooledLiteralLabel (void);
 /* Get an unused literal label. Will never return zero. */
 
+void ResetPooledLiteralLabels (void);
+/* Restart the numbering of literal labels for a new translation unit */
+
 const char* PooledLiteralLabelName (unsigned L);
 /* Make a litral label name from the given label number. The label name will be
 ** created in static storage and overwritten when calling the function again.
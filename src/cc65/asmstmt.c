@@ -51,6 +51,7 @@
 #include "segments.h"
 #include "stackptr.h"
 #include "symtab.h"
+#include "unused.h"
 #include "asmstmt.h"
 
 
@@ -119,6 +120,7 @@ static SymEntry* AsmGetSym (unsigned Arg, int OnStack)
 
     /* Mark the symbol as referenced */
     Sym->Flags |= SC_REF;
+    AddSymRef (Sym);
 
     /* Return it */
     return Sym;
@@ -350,6 +352,9 @@ static void ParseAsm (void)
     /* Skip the string token */
     NextToken ();
 
+    /* Functions and objects may be used by their assembler names */
+    AddAsmRefs (&S);
+
     /* Parse the statement. It may contain several lines and one or more
     ** of the following place holders:
     **   %b     - Numerical 8 bit value
@@ -474,7 +474,10 @@ static void OpAssignArithmetic (const GenDesc* Gen, ExprDesc* Expr, const char*
 
     if (Gen == 0) {
 
-        /* Read the expression on the right side of the '=' */
+        /* Read the expression on the right side of the '='. If the lhs is a
+        ** char, only the low byte of the rhs is used.
+        */
+        ED_RequireByteFor (&Expr2, Expr->Type);
         MarkedExprWithCheck (hie1, &Expr2);
 
         /* Do type conversion if necessary. Beware: Do not use char type
@@ -715,8 +718,9 @@ void OpAddSubAssign (const GenDesc* Gen, ExprDesc *Expr, const char* Op)
     Expr2.Flags |= Expr->Flags & E_MASK_KEEP_SUBEXPR;
 
     /* Evaluate the rhs. We expect an integer here, since float is not
-    ** supported
+    ** supported. If the lhs is a char, only the low byte of the rhs is used.
     */
+    ED_RequireByteFor (&Expr2, Expr->Type);
     hie1 (&Expr2);
     if (!IsClassInt (Expr2.Type)) {
         Error ("Invalid right operand for binary operator '%s'", Op);
@@ -0,0 +1,403 @@
+/*****************************************************************************/
+/*                                                                           */
+/*                                 codecfg.c                                 */
+/*                                                                           */
+/*              Control flow graph and liveness for code segments            */
+/*                                                                           */
+/*                                                                           */
+/*                                                                           */
+/* Copyright 2026 The cc65 Authors                                           */
+/*                                                                           */
+/*                                                                           */
+/* This software is provided 'as-is', without any expressed or implied       */
+/* warranty.  In no event will the authors be held liable for any damages    */
+/* arising from the use of this software.                                    */
+/*                                                                           */
+/* Permission is granted to anyone to use this software for any purpose,     */
+/* including commercial applications, and to alter it and redistribute it    */
+/* freely, subject to the following restrictions:                            */
+/*                                                                           */
+/* 1. The origin of this software must not be misrepresented; you must not   */
+/*    claim that you wrote the original software. If you use this software   */
+/*    in a product, an acknowledgment in the product documentation would be  */
+/*    appreciated but is not required.                                       */
+/* 2. Altered source versions must be plainly marked as such, and must not   */
+/*    be misrepresented as being the original software.                      */
+/* 3. This notice may not be removed or altered from any source              */
+/*    distribution.                                                          */
+/*                                                                           */
+/*****************************************************************************/
+
+
+
+#include <stdlib.h>
+#include <string.h>
+
+/* common */
+#include "check.h"
+#include "xmalloc.h"
+
+/* cc65 */
+#include "codecfg.h"
+#include "codeent.h"
+#include "codeinfo.h"
+#include "error.h"
+
+
+
+/*****************************************************************************/
+/*                                   Data                                    */
+/*****************************************************************************/
+
+
+
+/* Block flag for blocks reached by indirect jumps */
+#define CBF_INDIRECT    0x0100U
+
+/* Map from an entry that starts a block to the block */
+typedef struct BlockMap BlockMap;
+struct BlockMap {
+    const CodeEntry*    E;
+    unsigned            Block;
+};
+
+
+
+/*****************************************************************************/
+/*                             Helper functions                              */
+/*****************************************************************************/
+
+
+
+static int CmpBlockMap (const void* A, const void* B)
+/* Compare function for qsort/bsearch */
+{
+    const CodeEntry* EA = ((const BlockMap*) A)->E;
+    const CodeEntry* EB = ((const BlockMap*) B)->E;
+    return (EA < EB)? -1 : (EA > EB);
+}
+
+
+
+static int IsIndirectJump (const CodeEntry* E)
+/* Return true if E is an unconditional jump without a known target that may
+** go to a label in the function. This is jmp (zp), jmp (abs) and jmp (abs,x),
+** which are parsed as zero page modes, and a jump to the runtime functions
+** that jump to the address in a register, as used by jump tables. Jumps to
+** other named functions are tail calls.
+*/
+{
+    if (E->AM == AM65_ZP_IND || E->AM == AM65_ZPX_IND) {
+        return 1;
+    }
+    return E->AM == AM65_ABS &&
+           (strcmp (E->Arg, "callax") == 0 || strcmp (E->Arg, "callptr4") == 0);
+}
+
+
+
+static CodeBlock* FindTarget (CodeCFG* G, const BlockMap* Map, unsigned Count,
+                              const CodeEntry* E)
+/* Return the block at the jump target of E */
+{
+    BlockMap Key;
+    const BlockMap* M;
+
+    Key.E = E->JumpTo->Owner;
+    M = bsearch (&Key, Map, Count, sizeof (BlockMap), CmpBlockMap);
+    if (M == 0) {
+        Internal ("FindTarget: Jump to '%s' has no block", E->JumpTo->Name);
+    }
+    return G->Blocks + M->Block;
+}
+
+
+
+static unsigned EntryLive (const CodeSeg* S, const CodeEntry* E, unsigned Live)
+/* Return the registers and flags used before E, given the ones used after E */
+{
+    if (E->OPC == OP65_RTS || E->OPC == OP65_RTL ||
+        ((E->Info & OF_UBRA) != 0 && E->JumpTo == 0)) {
+        /* This instruction will leave the function. For an indirect jump,
+        ** Live contains the registers used at the possible targets.
+        */
+        return Live | E->Use | S->ExitRegs;
+    }
+    return E->Use | (Live & ~E->Chg);
+}
+
+
+
+static unsigned BlockLiveOut (const CodeCFG* G, const CodeBlock* B,
+                              unsigned IndirectLive)
+/* Return the registers and flags used after the last entry of B */
+{
+    unsigned Live = 0;
+    if (B->Next) {
+        Live |= B->Next->LiveIn;
+    }
+    if (B->Target) {
+        Live |= B->Target->LiveIn;
+    }
+    if (B->Flags & CBF_INDJMP) {
+        Live |= IndirectLive;
+    }
+    if ((B->Flags & CBF_EXIT) != 0 &&
+        (CS_GetEntry (G->Code, B->Last)->Info & OF_CBRA) != 0) {
+        /* Conditional branch to an external label */
+        Live |= G->Code->ExitRegs;
+    }
+    return Live;
+}
+
+
+
+/*****************************************************************************/
+/*                                   Code                                    */
+/*****************************************************************************/
+
+
+
+CodeCFG* NewCodeCFG (CodeSeg* S)
+/* Build the control flow graph for the given code segment */
+{
+    unsigned    I;
+    unsigned    Count = CS_GetEntryCount (S);
+    unsigned    Labeled;
+    unsigned    PredTotal;
+    BlockMap*   Map;
+    CodeBlock*  B;
+
+    /* Allocate the graph */
+    CodeCFG* G = xmalloc (sizeof (CodeCFG));
+    G->Code       = S;
+    G->BlockCount = 0;
+    G->Blocks     = 0;
+    G->PredBuf    = 0;
+    if (Count == 0) {
+        return G;
+    }
+
+    /* Count the blocks and the blocks that start with a label */
+    Labeled = 0;
+    for (I = 0; I < Count; ++I) {
+        CodeEntry* E = CS_GetEntry (S, I);
+        if (CE_HasLabel (E)) {
+            ++Labeled;
+            ++G->BlockCount;
+        } else if (I == 0 ||
+                   (CS_GetEntry (S, I - 1)->Info & (OF_BRA | OF_RET)) != 0) {
+            ++G->BlockCount;
+        }
+    }
+
+    /* Create the blocks and remember the labeled ones */
+    G->Blocks = xmalloc (G->BlockCount * sizeof (CodeBlock));
+    Map       = xmalloc ((Labeled? Labeled : 1) * sizeof (BlockMap));
+    Labeled   = 0;
+    B         = 0;
+    for (I = 0; I < Count; ++I) {
+        CodeEntry* E = CS_GetEntry (S, I);
+        int HasLabel = CE_HasLabel (E);
+        if (HasLabel || B == 0 ||
+            (CS_GetEntry (S, I - 1)->Info & (OF_BRA | OF_RET)) != 0) {
+            B = (B == 0)? G->Blocks : B + 1;
+            B->Index     = B - G->Blocks;
+            B->First     = I;
+            B->Flags     = 0;
+            B->Next      = 0;
+            B->Target    = 0;
+            B->Pred      = 0;
+            B->PredCount = 0;
+            B->LiveIn    = 0;
+            B->LiveOut   = 0;
+            if (HasLabel) {
+                Map[Labeled].E     = E;
+                Map[Labeled].Block = B->Index;
+                ++Labeled;
+                if (CE_HasIndirectLabel (E)) {
+                    B->Flags |= CBF_ROOT | CBF_INDIRECT;
+                }
+            }
+        }
+        B->Last = I;
+    }
+    qsort (Map, Labeled, sizeof (BlockMap), CmpBlockMap);
+
+    /* Determine the successors */
+    PredTotal = 0;
+    for (I = 0; I < G->BlockCount; ++I) {
+
+        CodeEntry* E;
+
+        B = G->Blocks + I;
+        E = CS_GetEntry (S, B->Last);
+
+        if (E->Info & OF_RET) {
+            B->Flags |= CBF_EXIT;
+        } else if (E->Info & OF_UBRA) {
+            if (E->JumpTo) {
+                B->Target = FindTarget (G, Map, Labeled, E);
+            } else {
+                B->Flags |= CBF_EXIT;
+                if (IsIndirectJump (E)) {
+                    B->Flags |= CBF_INDJMP;
+                }
+            }
+        } else {
+            if (I + 1 < G->BlockCount) {
+                B->Next = B + 1;
+            }
+            if (E->Info & OF_CBRA) {
+                if (E->JumpTo) {
+                    B->Target = FindTarget (G, Map, Labeled, E);
+                } else {
+                    B->Flags |= CBF_EXIT;
+                }
+            }
+        }
+
+        /* Count the predecessors */
+        if (B->Next) {
+            ++B->Next->PredCount;
+            ++PredTotal;
+        }
+        if (B->Target && B->Target != B->Next) {
+            ++B->Target->PredCount;
+            ++PredTotal;
+        }
+    }
+    xfree (Map);
+
+    /* Assign space for the predecessor lists and fill them */
+    G->PredBuf = xmalloc ((PredTotal? PredTotal : 1) * sizeof (CodeBlock*));
+    PredTotal = 0;
+    for (I = 0; I < G->BlockCount; ++I) {
+        B = G->Blocks + I;
+        B->Pred = G->PredBuf + PredTotal;
+        PredTotal += B->PredCount;
+        B->PredCount = 0;
+    }
+    for (I = 0; I < G->BlockCount; ++I) {
+        B = G->Blocks + I;
+        if (B->Next) {
+            B->Next->Pred[B->Next->PredCount++] = B;
+        }
+        if (B->Target && B->Target != B->Next) {
+            B->Target->Pred[B->Target->PredCount++] = B;
+        }
+    }
+
+    /* The first block and blocks without predecessors are entered from
+    ** outside. For the latter, this is true only if the code is unreachable,
+    ** but assuming unknown contents for them is always safe.
+    */
+    G->Blocks[0].Flags |= CBF_ROOT;
+    for (I = 1; I < G->BlockCount; ++I) {
+        if (G->Blocks[I].PredCount == 0) {
+            G->Blocks[I].Flags |= CBF_ROOT;
+        }
+    }
+
+    /* Return the graph */
+    return G;
+}
+
+
+
+void FreeCodeCFG (CodeCFG* G)
+/* Free a control flow graph */
+{
+    xfree (G->PredBuf);
+    xfree (G->Blocks);
+    xfree (G);
+}
+
+
+
+unsigned CFG_GetBlockIndex (const CodeCFG* G, unsigned Index)
+/* Return the index of the block that contains the entry with the given index */
+{
+    unsigned Lo = 0;
+    unsigned Hi = G->BlockCount;
+
+    PRECONDITION (Hi > 0 && Index <= G->Blocks[Hi-1].Last);
+
+    while (Hi - Lo > 1) {
+        unsigned Mid = (Lo + Hi) / 2;
+        if (G->Blocks[Mid].First <= Index) {
+            Lo = Mid;
+        } else {
+            Hi = Mid;
+        }
+    }
+    return Lo;
+}
+
+
+
+void CFG_GenLiveInfo (CodeCFG* G)
+/* Compute which registers and flags are used on entry and exit of each block,
+** following all branches and loop back edges until the information doesn't
+** change anymore. If the entries of the segment have register infos, the
+** registers and flags used after each entry are stored in the LiveOut field
+** of the info.
+*/
+{
+    CodeSeg*    S = G->Code;
+    unsigned    IndirectLive;
+    unsigned    I;
+    int         Changed;
+
+    /* Start with nothing used and walk backwards over the blocks. Values
+    ** only grow, so this terminates.
+    */
+    for (I = 0; I < G->BlockCount; ++I) {
+        G->Blocks[I].LiveIn  = 0;
+        G->Blocks[I].LiveOut = 0;
+    }
+    do {
+
+        /* Registers used at the targets of indirect jumps */
+        IndirectLive = 0;
+        for (I = 0; I < G->BlockCount; ++I) {
+            if (G->Blocks[I].Flags & CBF_INDIRECT) {
+                IndirectLive |= G->Blocks[I].LiveIn;
+            }
+        }
+
+        Changed = 0;
+        I = G->BlockCount;
+        while (I-- > 0) {
+
+            CodeBlock* B = G->Blocks + I;
+            unsigned Out = BlockLiveOut (G, B, IndirectLive);
+            unsigned Live = Out;
+            unsigned J = B->Last + 1;
+            while (J-- > B->First) {
+                Live = EntryLive (S, CS_GetEntry (S, J), Live);
+            }
+
+            if (Live != B->LiveIn || Out != B->LiveOut) {
+                B->LiveIn  = Live;
+                B->LiveOut = Out;
+                Changed    = 1;
+            }
+        }
+
+    } while (Changed);
+
+    /* Store the information for the single entries */
+    for (I = 0; I < G->BlockCount; ++I) {
+        CodeBlock* B = G->Blocks + I;
+        unsigned Live = B->LiveOut;
+        unsigned J = B->Last + 1;
+        while (J-- > B->First) {
+            CodeEntry* E = CS_GetEntry (S, J);
+            if (E->RI) {
+                E->RI->LiveOut = Live;
+            }
+            Live = EntryLive (S, E, Live);
+        }
+    }
+}
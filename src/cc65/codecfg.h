@@ -0,0 +1,121 @@
+/*****************************************************************************/
+/*                                                                           */
+/*                                 codecfg.h                                 */
+/*                                                                           */
+/*              Control flow graph and liveness for code segments            */
+/*                                                                           */
+/*                                                                           */
+/*                                                                           */
+/* Copyright 2026 The cc65 Authors                                           */
+/*                                                                           */
+/*                                                                           */
+/* This software is provided 'as-is', without any expressed or implied       */
+/* warranty.  In no event will the authors be held liable for any damages    */
+/* arising from the use of this software.                                    */
+/*                                                                           */
+/* Permission is granted to anyone to use this software for any purpose,     */
+/* including commercial applications, and to alter it and redistribute it    */
+/* freely, subject to the following restrictions:                            */
+/*                                                                           */
+/* 1. The origin of this software must not be misrepresented; you must not   */
+/*    claim that you wrote the original software. If you use this software   */
+/*    in a product, an acknowledgment in the product documentation would be  */
+/*    appreciated but is not required.                                       */
+/* 2. Altered source versions must be plainly marked as such, and must not   */
+/*    be misrepresented as being the original software.                      */
+/* 3. This notice may not be removed or altered from any source              */
+/*    distribution.                                                          */
+/*                                                                           */
+/*****************************************************************************/
+
+
+
+/* The graph splits the entries of a code segment into basic blocks. A block
+** starts at the first entry, at every entry with a label, and after every
+** jump, branch or return. Each block has up to two successors (the next
+** block if the flow falls through, and the block at the branch target) and
+** any number of predecessors.
+** The graph is a snapshot: It must be rebuilt whenever entries or labels of
+** the segment are added, removed or changed.
+*/
+
+
+
+#ifndef CODECFG_H
+#define CODECFG_H
+
+
+
+/* cc65 */
+#include "codeseg.h"
+#include "reginfo.h"
+
+
+
+/*****************************************************************************/
+/*                                   Data                                    */
+/*****************************************************************************/
+
+
+
+/* Block flags */
+#define CBF_ROOT        0x0001U         /* Entered from outside the graph */
+#define CBF_EXIT        0x0002U         /* May leave the function */
+#define CBF_INDJMP      0x0004U         /* Ends with an indirect jump */
+#define CBF_DONE        0x0008U         /* Marker for the users of the graph */
+
+/* A basic block */
+typedef struct CodeBlock CodeBlock;
+struct CodeBlock {
+    unsigned            Index;          /* Index of the block in the graph */
+    unsigned            First;          /* Index of the first entry */
+    unsigned            Last;           /* Index of the last entry */
+    unsigned            Flags;          /* CBF_xxx */
+    CodeBlock*          Next;           /* Successor if the flow falls through */
+    CodeBlock*          Target;         /* Successor at the branch target */
+    CodeBlock**         Pred;           /* Predecessors, each listed once */
+    unsigned            PredCount;      /* Number of predecessors */
+    unsigned            LiveIn;         /* Registers and flags used on entry */
+    unsigned            LiveOut;        /* Registers and flags used on exit */
+    RegContents         In;             /* Register contents on entry */
+};
+
+/* The control flow graph of a code segment */
+typedef struct CodeCFG CodeCFG;
+struct CodeCFG {
+    CodeSeg*            Code;           /* The code segment */
+    unsigned            BlockCount;     /* Number of blocks */
+    CodeBlock*          Blocks;         /* Blocks in the order of the code */
+    CodeBlock**         PredBuf;        /* Memory for the predecessor lists */
+};
+
+
+
+/*****************************************************************************/
+/*                                   Code                                    */
+/*****************************************************************************/
+
+
+
+CodeCFG* NewCodeCFG (CodeSeg* S);
+/* Build the control flow graph for the given code segment */
+
+void FreeCodeCFG (CodeCFG* G);
+/* Free a control flow graph */
+
+unsigned CFG_GetBlockIndex (const CodeCFG* G, unsigned Index);
+/* Return the index of the block that contains the entry with the given index */
+
+void CFG_GenLiveInfo (CodeCFG* G);
+/* Compute which registers and flags are used on entry and exit of each block,
+** following all branches and loop back edges until the information doesn't
+** change anymore. If the entries of the segment have register infos, the
+** registers and flags used after each entry are stored in the LiveOut field
+** of the info.
+*/
+
+
+
+/* End of codecfg.h */
+
+#endif
@@ -41,6 +41,7 @@
 #include "chartype.h"
 #include "check.h"
 #include "debugflag.h"
+#include "thread.h"
 #include "xmalloc.h"
 #include "xsprintf.h"
 
@@ -49,6 +50,7 @@
 #include "codeent.h"
 #include "codeinfo.h"
 #include "codelab.h"
+#include "codepool.h"
 #include "error.h"
 #include "global.h"
 #include "ident.h"
@@ -58,53 +60,17 @@
 
 
 
-/*****************************************************************************/
-/*                                   Data                                    */
-/*****************************************************************************/
-
-
-
-/* Empty argument */
-static char EmptyArg[] = "";
-
-
-
 /*****************************************************************************/
 /*                             Helper functions                              */
 /*****************************************************************************/
 
 
 
-static void FreeArg (char* Arg)
-/* Free a code entry argument */
-{
-    if (Arg != EmptyArg) {
-        xfree (Arg);
-    }
-}
-
-
-
 static char* GetArgCopy (const char* Arg)
 /* Create an argument copy for assignment */
 {
-    if (Arg && Arg[0] != '\0') {
-        /* Create a copy */
-        return xstrdup (Arg);
-    } else {
-        /* Use the empty argument string */
-        return EmptyArg;
-    }
-}
-
-
-
-static void FreeParsedArg (char* ArgBase)
-/* Free a code entry parsed argument */
-{
-    if (ArgBase != 0 && ArgBase != EmptyArg) {
-        xfree (ArgBase);
-    }
+    /* Arguments are interned in the pool of the code segment */
+    return CP_Intern (Arg? Arg : "");
 }
 
 
@@ -120,7 +86,7 @@ static void SetUseChgInfo (CodeEntry* E, const OPCDesc* D)
     */
     if ((E->Info & (OF_UBRA | OF_CALL)) != 0 && E->JumpTo == 0) {
         /* A subroutine call or jump to external symbol (function exit) */
-        GetFuncInfo (E->Arg, &E->Use, &E->Chg);
+        GetArgFuncInfo (E->Arg, &E->Use, &E->Chg);
     } else {
         /* Some other instruction. Use the values from the opcode description
         ** plus addressing mode info.
@@ -146,7 +112,7 @@ static void SetUseChgInfo (CodeEntry* E, const OPCDesc* D)
             case AM65_ZPX:
             case AM65_ABSX:
             case AM65_ABSY:
-                Info = GetZPInfo (E->Arg);
+                Info = GetArgZPInfo (E->Arg);
                 if (Info && Info->ByteUse != REG_NONE) {
                     if (E->OPC == OP65_ASL || E->OPC == OP65_DEC ||
                         E->OPC == OP65_INC || E->OPC == OP65_LSR ||
@@ -168,7 +134,7 @@ static void SetUseChgInfo (CodeEntry* E, const OPCDesc* D)
             case AM65_ZPX_IND:
             case AM65_ZP_INDY:
             case AM65_ZP_IND:
-                Info = GetZPInfo (E->Arg);
+                Info = GetArgZPInfo (E->Arg);
                 if (Info && Info->ByteUse != REG_NONE) {
                     /* These addressing modes will never change the zp loc */
                     E->Use |= Info->WordUse;
@@ -576,12 +542,12 @@ int ParseOpcArgStr (const char* Arg, unsigned short* ArgInfo, struct StrBuf* Nam
 const char* MakeHexArg (unsigned Num)
 /* Convert Num into a string in the form $XY, suitable for passing it as an
 ** argument to NewCodeEntry, and return a pointer to the string.
-** BEWARE: The function returns a pointer to a static buffer, so the value is
-** gone if you call it twice (and apart from that it's not thread and signal
-** safe).
+** BEWARE: The function returns a pointer to a static per thread buffer, so
+** the value is gone if you call it twice (and apart from that it's not
+** signal safe).
 */
 {
-    static char Buf[16];
+    static THREAD_LOCAL char Buf[16];
     xsprintf (Buf, sizeof (Buf), "$%02X", (unsigned char) Num);
     return Buf;
 }
@@ -591,11 +557,12 @@ const char* MakeHexArg (unsigned Num)
 void PreparseArg (CodeEntry* E)
 /* Parse the argument string and memorize the result for the code entry */
 {
-    StrBuf B = AUTO_STRBUF_INITIALIZER;
+    /* Scratch buffer for the parser, the result is interned in the pool */
+    static THREAD_LOCAL StrBuf B = STATIC_STRBUF_INITIALIZER;
 
     /* Parse the argument string */
     if (ParseOpcArgStr (E->Arg, &E->ArgInfo, &B, &E->ArgOff)) {
-        E->ArgBase = SB_GetBuf (&B);
+        E->ArgBase = CP_Intern (SB_GetConstBuf (&B));
 
         if ((E->ArgInfo & (AIF_HAS_NAME | AIF_HAS_OFFSET)) == AIF_HAS_OFFSET) {
             E->Flags |= CEF_NUMARG;
@@ -606,8 +573,7 @@ void PreparseArg (CodeEntry* E)
 
     } else {
         /* Parsing fails. Issue an error/warning so that this could be spotted and fixed. */
-        E->ArgBase = EmptyArg;
-        SB_Done (&B);
+        E->ArgBase = CP_Intern ("");
         if (Debug) {
             Warning ("Parsing argument \"%s\" failed!", E->Arg);
         }
@@ -624,7 +590,7 @@ CodeEntry* NewCodeEntry (opc_t OPC, am_t AM, const char* Arg,
     const OPCDesc* D = GetOPCDesc (OPC);
 
     /* Allocate memory */
-    CodeEntry* E = xmalloc (sizeof (CodeEntry));
+    CodeEntry* E = CP_Alloc (sizeof (CodeEntry));
 
     /* Initialize the fields */
     E->OPC      = D->OPC;
@@ -640,7 +606,7 @@ CodeEntry* NewCodeEntry (opc_t OPC, am_t AM, const char* Arg,
 
     /* Parse the argument string if it's given */
     if (Arg == 0 || Arg[0] == '\0') {
-        E->ArgBase = EmptyArg;
+        E->ArgBase = E->Arg;
     } else {
         PreparseArg (E);
     }
@@ -662,11 +628,7 @@ CodeEntry* NewCodeEntry (opc_t OPC, am_t AM, const char* Arg,
 void FreeCodeEntry (CodeEntry* E)
 /* Free the given code entry */
 {
-    /* Free the argument base string if we have one */
-    FreeParsedArg (E->ArgBase);
-
-    /* Free the string argument if we have one */
-    FreeArg (E->Arg);
+    /* The argument strings are interned and live as long as the pool */
 
     /* Cleanup the collection */
     DoneCollection (&E->Labels);
@@ -678,7 +640,27 @@ void FreeCodeEntry (CodeEntry* E)
     CE_FreeRegInfo (E);
 
     /* Free the entry */
-    xfree (E);
+    CP_Free (E, sizeof (CodeEntry));
+}
+
+
+
+CodeEntry* CE_Move (CodeEntry* E)
+/* Copy the entry and its argument strings into memory from the current pool
+** and return the copy. The copy takes over the labels, line info and register
+** info of the old entry, and the old entry must not be freed.
+*/
+{
+    /* Allocate memory and copy the fields */
+    CodeEntry* N = CP_Alloc (sizeof (CodeEntry));
+    *N = *E;
+
+    /* Intern the strings in the new pool */
+    N->Arg     = CP_Intern (E->Arg);
+    N->ArgBase = CP_Intern (E->ArgBase);
+
+    /* Return the new entry */
+    return N;
 }
 
 
@@ -703,7 +685,7 @@ void CE_ReplaceOPC (CodeEntry* E, opc_t OPC)
 int CodeEntriesAreEqual (const CodeEntry* E1, const CodeEntry* E2)
 /* Check if both code entries are equal */
 {
-    return (E1->OPC == E2->OPC && E1->AM == E2->AM && strcmp (E1->Arg, E2->Arg) == 0);
+    return (E1->OPC == E2->OPC && E1->AM == E2->AM && E1->Arg == E2->Arg);
 }
 
 
@@ -748,15 +730,25 @@ void CE_MoveLabel (CodeLabel* L, CodeEntry* E)
 
 
 
-void CE_SetArg (CodeEntry* E, const char* Arg)
-/* Replace the whole argument by the new one. */
+int CE_HasIndirectLabel (CodeEntry* E)
+/* Check if one of the labels of E is used in data, so E may be reached by
+** an indirect jump.
+*/
 {
-    /* Free the old parsed argument base */
-    FreeParsedArg (E->ArgBase);
+    unsigned I;
+    for (I = 0; I < CE_GetLabelCount (E); ++I) {
+        if (CL_IsIndirect (CE_GetLabel (E, I))) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
 
-    /* Free the old argument */
-    FreeArg (E->Arg);
 
+void CE_SetArg (CodeEntry* E, const char* Arg)
+/* Replace the whole argument by the new one. */
+{
     /* Assign the new one */
     E->Arg = GetArgCopy (Arg);
 
@@ -825,7 +817,7 @@ void CE_SetArgBaseAndOff (CodeEntry* E, const char* ArgBase, long ArgOff)
             CE_SetNumArg (E, ArgOff);
         } else {
             /* Empty argument */
-            CE_SetArg (E, EmptyArg);
+            CE_SetArg (E, "");
         }
     }
 }
@@ -922,6 +914,24 @@ int CE_IsKnownImm (const CodeEntry* E, unsigned long Num)
 
 
 
+unsigned CE_GetCycles (const CodeEntry* E)
+/* Return the estimated number of cycles for E. Conditional branches are
+** assumed to be taken and page boundaries are assumed not to be crossed.
+** For a subroutine call, the typical cycles of the function are returned.
+*/
+{
+    if (E->OPC == OP65_JSR || E->OPC == OP65_JSL) {
+        /* These include the jsr */
+        return GetFuncCycles (E->Arg);
+    }
+    if (E->Info & OF_CBRA) {
+        return GetInsnCycles (E->OPC, E->AM) + GetInsnPenalty (E->OPC, E->AM);
+    }
+    return GetInsnCycles (E->OPC, E->AM);
+}
+
+
+
 int CE_UseLoadFlags (CodeEntry* E)
 /* Return true if the instruction uses any flags that are set by a load of
 ** a register (N and Z).
@@ -1748,7 +1758,7 @@ void CE_GenRegInfo (CodeEntry* E, RegContents* InputRegs)
             Out->ZNRegs = ZNREG_NONE;
 
             /* Get the code info for the function */
-            GetFuncInfo (E->Arg, &Use, &Chg);
+            GetArgFuncInfo (E->Arg, &Use, &Chg);
             if (Chg & REG_A) {
                 Out->RegA = UNKNOWN_REGVAL;
             }
@@ -2529,10 +2539,15 @@ void CE_Output (const CodeEntry* E)
     int Space;
     const char* Target;
 
-    /* If we have a label, print that */
+    /* If we have a label, print that. There may be more than one if labels
+    ** are used in data, each of these needs a line of its own.
+    */
     unsigned LabelCount = CollCount (&E->Labels);
     unsigned I;
     for (I = 0; I < LabelCount; ++I) {
+        if (I > 0) {
+            WriteOutput ("\n");
+        }
         CL_Output (CollConstAt (&E->Labels, I));
     }
 
@@ -70,7 +70,7 @@ struct CodeEntry {
     unsigned char       AM;             /* Adressing mode */
     unsigned char       Size;           /* Estimated size */
     unsigned char       Flags;          /* Flags */
-    char*               Arg;            /* Argument as string */
+    char*               Arg;            /* Argument as interned string */
     unsigned long       Num;            /* Numeric argument */
     unsigned short      Info;           /* Additional code info */
     unsigned short      ArgInfo;        /* Additional argument info */
@@ -133,6 +133,12 @@ CodeEntry* NewCodeEntry (opc_t OPC, am_t AM, const char* Arg,
 void FreeCodeEntry (CodeEntry* E);
 /* Free the given code entry */
 
+CodeEntry* CE_Move (CodeEntry* E);
+/* Copy the entry and its argument strings into memory from the current pool
+** and return the copy. The copy takes over the labels, line info and register
+** info of the old entry, and the old entry must not be freed.
+*/
+
 void CE_ReplaceOPC (CodeEntry* E, opc_t OPC);
 /* Replace the opcode of the instruction. This will also replace related info,
 ** Size, Use and Chg, but it will NOT update any arguments or labels.
@@ -193,6 +199,11 @@ INLINE void CE_ReplaceLabel (CodeEntry* E, CodeLabel* L, unsigned Index)
 void CE_MoveLabel (CodeLabel* L, CodeEntry* E);
 /* Move the code label L from it's former owner to the code entry E. */
 
+int CE_HasIndirectLabel (CodeEntry* E);
+/* Check if one of the labels of E is used in data, so E may be reached by
+** an indirect jump.
+*/
+
 #if defined(HAVE_INLINE)
 INLINE int CE_HasMark (const CodeEntry* E)
 /* Return true if the given code entry has the CEF_USERMARK flag set */
@@ -281,6 +292,12 @@ INLINE int CE_IsCallTo (const CodeEntry* E, const char* Name)
 #  define CE_IsCallTo(E, Name) (((E)->OPC == OP65_JSR || (E)->OPC == OP65_JSL) && strcmp ((E)->Arg, (Name)) == 0)
 #endif
 
+unsigned CE_GetCycles (const CodeEntry* E);
+/* Return the estimated number of cycles for E. Conditional branches are
+** assumed to be taken and page boundaries are assumed not to be crossed.
+** For a subroutine call, the typical cycles of the function are returned.
+*/
+
 int CE_UseLoadFlags (CodeEntry* E);
 /* Return true if the instruction uses any flags that are set by a load of
 ** a register (N and Z).
@@ -54,6 +54,7 @@
 #include "asmcode.h"
 #include "asmlabel.h"
 #include "casenode.h"
+#include "codeinfo.h"
 #include "codeseg.h"
 #include "dataseg.h"
 #include "error.h"
@@ -1600,6 +1601,653 @@ void g_scale (unsigned flags, long val)
 
 
 
+/*****************************************************************************/
+/*                      Inline code for long operations                      */
+/*****************************************************************************/
+
+
+
+/* Operations on longs with a constant or a static operand may be done with
+** inline code instead of a runtime call. The functions below emit the inline
+** code if they are called without a cost record. If they get one, they just
+** add the size and typical cycles of the code to it, so the callers are able
+** to decide if the inline code pays off. Code that is only executed if a
+** carry has to be propagated into the higher bytes counts no cycles.
+*/
+typedef struct LongCost LongCost;
+struct LongCost {
+    unsigned long       Size;           /* Code size in bytes */
+    unsigned long       Cycles;         /* Typical cycles */
+};
+
+/* The operand of an inline long operation */
+typedef struct LongArg LongArg;
+struct LongArg {
+    int                 IsConst;        /* True if it is a constant */
+    unsigned long       Val;            /* Value if it is a constant */
+    unsigned            Size;           /* Size of an instruction using it */
+    unsigned            Cycles;         /* Cycles of an instruction using it */
+    char                Name[256];      /* Label name if it is a variable */
+};
+
+
+
+static void LongArgConst (LongArg* A, unsigned long Val)
+/* Initialize a constant operand */
+{
+    A->IsConst = 1;
+    A->Val     = Val;
+    A->Size    = 2;
+    A->Cycles  = 2;
+    A->Name[0] = '\0';
+}
+
+
+
+static void LongArgStatic (LongArg* A, unsigned Flags, uintptr_t Label, long Offs)
+/* Initialize an operand that is a variable at a fixed address */
+{
+    A->IsConst = 0;
+    A->Val     = 0;
+    if ((Flags & CF_ADDRMASK) == CF_REGVAR) {
+        A->Size   = 2;
+        A->Cycles = 3;
+    } else {
+        A->Size   = 3;
+        A->Cycles = 4;
+    }
+    xsprintf (A->Name, sizeof (A->Name), "%s", GetLabelName (Flags, Label, Offs));
+}
+
+
+
+static unsigned char LongArgVal (const LongArg* A, unsigned Byte)
+/* Return the given byte of a constant operand */
+{
+    return (unsigned char) (A->Val >> (Byte * 8));
+}
+
+
+
+static const char* LongArgByte (const LongArg* A, unsigned Byte)
+/* Return the instruction argument for the given byte of the operand */
+{
+    static char Buf [264];
+
+    if (A->IsConst) {
+        xsprintf (Buf, sizeof (Buf), "#$%02X", LongArgVal (A, Byte));
+    } else if (Byte == 0) {
+        xsprintf (Buf, sizeof (Buf), "%s", A->Name);
+    } else {
+        xsprintf (Buf, sizeof (Buf), "%s+%u", A->Name, Byte);
+    }
+    return Buf;
+}
+
+
+
+static void LongCode (LongCost* C, unsigned Size, unsigned Cycles,
+                      const char* Format, ...)
+/* Add a line of inline code, or just its size and cycles if C is not NULL */
+{
+    if (C) {
+        C->Size   += Size;
+        C->Cycles += Cycles;
+    } else {
+        char    Buf [320];
+        va_list ap;
+        va_start (ap, Format);
+        xvsprintf (Buf, sizeof (Buf), Format, ap);
+        va_end (ap);
+        AddCodeLine ("%s", Buf);
+    }
+}
+
+
+
+static unsigned LongLabel (const LongCost* C)
+/* Return a local label for a branch in inline code */
+{
+    return C? 0 : GetLocalLabel ();
+}
+
+
+
+static void LongDefLabel (const LongCost* C, unsigned L)
+/* Define a local label of inline code */
+{
+    if (C == 0) {
+        g_defcodelabel (L);
+    }
+}
+
+
+
+static int LongInline (const LongCost* Inline, const LongCost* Call)
+/* Return true if the inline code should be used instead of the runtime call */
+{
+    unsigned Weight = (unsigned) IS_Get (&CycleWeight);
+
+    if (Weight > 0) {
+        return GetCodeCost (Inline->Size, Inline->Cycles, Weight) <
+               GetCodeCost (Call->Size, Call->Cycles, Weight);
+    }
+    return Inline->Cycles < Call->Cycles &&
+           Inline->Size <= Call->Size * IS_Get (&CodeSizeFactor) / 100;
+}
+
+
+
+static void LongCallCost (LongCost* C, const LongArg* A, const char* Func)
+/* Get the cost of pushing EAX, loading the operand and calling Func */
+{
+    C->Size   = 3 + 4 * A->Size + 4 + 3;
+    C->Cycles = GetFuncCycles ("pusheax") + 4 * A->Cycles + 6 +
+                GetFuncCycles (Func);
+}
+
+
+
+static unsigned LongFirstByte (const LongArg* A)
+/* Return the index of the lowest byte that an addition or subtraction of the
+** operand must handle. Below that, a constant has zero bytes.
+*/
+{
+    unsigned First = 0;
+
+    if (A && A->IsConst) {
+        while (First < 3 && LongArgVal (A, First) == 0) {
+            ++First;
+        }
+    }
+    return First;
+}
+
+
+
+static void LongAddSub (LongCost* C, const LongArg* A, int Sub)
+/* Add the operand to EAX, or subtract it from EAX */
+{
+    const char* Op    = Sub? "sbc" : "adc";
+    const char* Carry = Sub? "sec" : "clc";
+    unsigned    First = LongFirstByte (A);
+    unsigned    I;
+    unsigned    L;
+
+    if (Sub && A->IsConst && A->Val <= 0xFF) {
+        /* Subtract from the low byte, and propagate a borrow into the higher
+        ** bytes. X and sreg are $FF after a borrow into the next byte.
+        */
+        L = LongLabel (C);
+        LongCode (C, 1, 2, "sec");
+        LongCode (C, 2, 2, "sbc %s", LongArgByte (A, 0));
+        LongCode (C, 2, 3, "bcs %s", LocalLabelName (L));
+        LongCode (C, 1, 0, "dex");
+        LongCode (C, 2, 0, "cpx #$FF");
+        LongCode (C, 2, 0, "bne %s", LocalLabelName (L));
+        LongCode (C, 2, 0, "dec sreg");
+        LongCode (C, 2, 0, "cpx sreg");
+        LongCode (C, 2, 0, "bne %s", LocalLabelName (L));
+        LongCode (C, 2, 0, "dec sreg+1");
+        LongDefLabel (C, L);
+        return;
+    }
+
+    if (!Sub && A->IsConst && A->Val <= 0xFFFF) {
+        /* Add to the low word, and propagate a carry into the high word */
+        L = LongLabel (C);
+        if (A->Val <= 0xFF) {
+            LongCode (C, 1, 2, "clc");
+            LongCode (C, 2, 2, "adc %s", LongArgByte (A, 0));
+            LongCode (C, 2, 3, "bcc %s", LocalLabelName (L));
+            LongCode (C, 1, 0, "inx");
+            LongCode (C, 2, 0, "bne %s", LocalLabelName (L));
+        } else {
+            if (First == 0) {
+                LongCode (C, 1, 2, "clc");
+                LongCode (C, 2, 2, "adc %s", LongArgByte (A, 0));
+            }
+            LongCode (C, 1, 2, "tay");
+            LongCode (C, 1, 2, "txa");
+            if (First == 1) {
+                LongCode (C, 1, 2, "clc");
+            }
+            LongCode (C, 2, 2, "adc %s", LongArgByte (A, 1));
+            LongCode (C, 1, 2, "tax");
+            LongCode (C, 1, 2, "tya");
+            LongCode (C, 2, 3, "bcc %s", LocalLabelName (L));
+        }
+        LongCode (C, 2, 0, "inc sreg");
+        LongCode (C, 2, 0, "bne %s", LocalLabelName (L));
+        LongCode (C, 2, 0, "inc sreg+1");
+        LongDefLabel (C, L);
+        return;
+    }
+
+    /* Zero bytes at the bottom of a constant don't change anything */
+    if (First == 0) {
+        LongCode (C, 1, 2, "%s", Carry);
+        LongCode (C, A->Size, A->Cycles, "%s %s", Op, LongArgByte (A, 0));
+    }
+    LongCode (C, 1, 2, "tay");
+    if (First <= 1) {
+        LongCode (C, 1, 2, "txa");
+        if (First == 1) {
+            LongCode (C, 1, 2, "%s", Carry);
+        }
+        LongCode (C, A->Size, A->Cycles, "%s %s", Op, LongArgByte (A, 1));
+        LongCode (C, 1, 2, "tax");
+    }
+    for (I = 2; I < 4; ++I) {
+        const char* Reg = (I == 2)? "sreg" : "sreg+1";
+        if (I >= First) {
+            LongCode (C, 2, 3, "lda %s", Reg);
+            if (I == First) {
+                LongCode (C, 1, 2, "%s", Carry);
+            }
+            LongCode (C, A->Size, A->Cycles, "%s %s", Op, LongArgByte (A, I));
+            LongCode (C, 2, 3, "sta %s", Reg);
+        }
+    }
+    LongCode (C, 1, 2, "tya");
+}
+
+
+
+static void LongBitOp (LongCost* C, const LongArg* A, const char* Op,
+                       unsigned char Neutral, int Absorbing)
+/* Combine EAX with the operand using the instruction Op, which is and, ora
+** or eor. Bytes of a constant that equal Neutral leave the byte in EAX as it
+** is, bytes that equal Absorbing (if it is not negative) replace it.
+*/
+{
+    int             Keep[4];
+    int             Set[4];
+    int             SaveA;
+    int             UseY;
+    int             Loaded = -1;
+    unsigned        I;
+
+    /* Check what must be done with each byte */
+    for (I = 0; I < 4; ++I) {
+        Keep[I] = A->IsConst && LongArgVal (A, I) == Neutral;
+        Set[I]  = A->IsConst && LongArgVal (A, I) == Absorbing;
+    }
+
+    /* The low byte is done last. It must be saved if the other bytes need A,
+    ** and it is not replaced anyway. Otherwise, Y may be used to set bytes.
+    */
+    SaveA = !Set[0] && (!(Keep[1] || Set[1]) ||
+                        !(Keep[2] || Set[2]) ||
+                        !(Keep[3] || Set[3]));
+    UseY  = !SaveA && !Set[0];
+    if (SaveA) {
+        LongCode (C, 1, 2, "tay");
+    }
+
+    /* Byte 1 */
+    if (Set[1]) {
+        LongCode (C, 2, 2, "ldx #$%02X", Absorbing);
+    } else if (!Keep[1]) {
+        LongCode (C, 1, 2, "txa");
+        LongCode (C, A->Size, A->Cycles, "%s %s", Op, LongArgByte (A, 1));
+        LongCode (C, 1, 2, "tax");
+    }
+
+    /* Bytes 2 and 3 */
+    for (I = 2; I < 4; ++I) {
+        const char* Reg = (I == 2)? "sreg" : "sreg+1";
+        if (Set[I]) {
+            if (Loaded < 0) {
+                LongCode (C, 2, 2, "ld%c #$%02X", UseY? 'y' : 'a', Absorbing);
+                Loaded = Absorbing;
+            }
+            LongCode (C, 2, 3, "st%c %s", UseY? 'y' : 'a', Reg);
+        } else if (!Keep[I]) {
+            LongCode (C, 2, 3, "lda %s", Reg);
+            LongCode (C, A->Size, A->Cycles, "%s %s", Op, LongArgByte (A, I));
+            LongCode (C, 2, 3, "sta %s", Reg);
+            if (!UseY) {
+                Loaded = -1;
+            }
+        }
+    }
+
+    /* Byte 0 */
+    if (SaveA) {
+        LongCode (C, 1, 2, "tya");
+    }
+    if (Set[0]) {
+        LongCode (C, 2, 2, "lda #$%02X", Absorbing);
+    } else if (!Keep[0]) {
+        LongCode (C, A->Size, A->Cycles, "%s %s", Op, LongArgByte (A, 0));
+    }
+}
+
+
+
+static void LongCmpEq (LongCost* C, const LongArg* A)
+/* Compare EAX with the operand and set the Z flag if they are equal */
+{
+    if (A->IsConst && A->Val == 0) {
+        LongCode (C, 2, 3, "stx tmp1");
+        LongCode (C, 2, 3, "ora tmp1");
+        LongCode (C, 2, 3, "ora sreg");
+        LongCode (C, 2, 3, "ora sreg+1");
+    } else {
+        unsigned L = LongLabel (C);
+        LongCode (C, A->Size, A->Cycles, "cmp %s", LongArgByte (A, 0));
+        LongCode (C, 2, 3, "bne %s", LocalLabelName (L));
+        LongCode (C, A->Size, A->Cycles, "cpx %s", LongArgByte (A, 1));
+        LongCode (C, 2, 2, "bne %s", LocalLabelName (L));
+        LongCode (C, 2, 3, "lda sreg");
+        /* Loading a zero byte sets the Z flag already */
+        if (!A->IsConst || LongArgVal (A, 2) != 0) {
+            LongCode (C, A->Size, A->Cycles, "cmp %s", LongArgByte (A, 2));
+        }
+        LongCode (C, 2, 2, "bne %s", LocalLabelName (L));
+        LongCode (C, 2, 3, "lda sreg+1");
+        if (!A->IsConst || LongArgVal (A, 3) != 0) {
+            LongCode (C, A->Size, A->Cycles, "cmp %s", LongArgByte (A, 3));
+        }
+        LongDefLabel (C, L);
+    }
+}
+
+
+
+static void LongCmpSigned (LongCost* C, const LongArg* A, int Ge)
+/* Do a signed compare of EAX with the operand, and load the boolean result
+** of EAX < operand, or of EAX >= operand if Ge is true.
+*/
+{
+    unsigned L = LongLabel (C);
+
+    LongCode (C, A->Size, A->Cycles, "cmp %s", LongArgByte (A, 0));
+    LongCode (C, 1, 2, "txa");
+    LongCode (C, A->Size, A->Cycles, "sbc %s", LongArgByte (A, 1));
+    LongCode (C, 2, 3, "lda sreg");
+    LongCode (C, A->Size, A->Cycles, "sbc %s", LongArgByte (A, 2));
+    LongCode (C, 2, 3, "lda sreg+1");
+    LongCode (C, A->Size, A->Cycles, "sbc %s", LongArgByte (A, 3));
+    LongCode (C, 2, 3, "%s %s", Ge? "bvs" : "bvc", LocalLabelName (L));
+    LongCode (C, 2, 2, "eor #$80");
+    LongDefLabel (C, L);
+    LongCode (C, 1, 2, "asl a");                /* Bit 7 -> carry */
+    LongCode (C, 2, 2, "lda #$00");
+    LongCode (C, 2, 2, "ldx #$00");
+    LongCode (C, 1, 2, "rol a");
+}
+
+
+
+static void LongShift (LongCost* C, unsigned Count, int Right, int Signed)
+/* Shift EAX by Count bits, which must be less than 8 */
+{
+    LongCode (C, 2, 3, "stx tmp1");
+    while (Count--) {
+        if (Right) {
+            if (Signed) {
+                LongCode (C, 2, 3, "ldy sreg+1");
+                LongCode (C, 2, 2, "cpy #$80");     /* Sign bit -> carry */
+                LongCode (C, 2, 5, "ror sreg+1");
+            } else {
+                LongCode (C, 2, 5, "lsr sreg+1");
+            }
+            LongCode (C, 2, 5, "ror sreg");
+            LongCode (C, 2, 5, "ror tmp1");
+            LongCode (C, 1, 2, "ror a");
+        } else {
+            LongCode (C, 1, 2, "asl a");
+            LongCode (C, 2, 5, "rol tmp1");
+            LongCode (C, 2, 5, "rol sreg");
+            LongCode (C, 2, 5, "rol sreg+1");
+        }
+    }
+    LongCode (C, 2, 3, "ldx tmp1");
+}
+
+
+
+static void LongShiftCallCost (LongCost* C, unsigned Count, const char* Func)
+/* Get the cost of the runtime calls that shift EAX by Count bits. Func is
+** the name of the functions without the count.
+*/
+{
+    char Name [16];
+
+    C->Size   = 0;
+    C->Cycles = 0;
+    while (Count > 0) {
+        unsigned Bits = (Count > 4)? 4 : Count;
+        xsprintf (Name, sizeof (Name), "%s%u", Func, Bits);
+        C->Size   += 3;
+        C->Cycles += GetFuncCycles (Name);
+        Count     -= Bits;
+    }
+}
+
+
+
+static void LongOpEqStatic (LongCost* C, const LongArg* Var, const LongArg* A,
+                            int Sub, int Keep)
+/* Add the operand to the variable, or subtract it from the variable. If A is
+** NULL, the operand is in EAX. If Keep is true, load the result into EAX.
+*/
+{
+    unsigned    First = LongFirstByte (A);
+    unsigned    I;
+    unsigned    L;
+
+    if (A && !Sub && A->Val <= 0xFF) {
+        /* Add to the low byte, and propagate a carry into the higher bytes */
+        L = LongLabel (C);
+        LongCode (C, 2, 2, "lda %s", LongArgByte (A, 0));
+        LongCode (C, 1, 2, "clc");
+        LongCode (C, Var->Size, Var->Cycles, "adc %s", LongArgByte (Var, 0));
+        LongCode (C, Var->Size, Var->Cycles, "sta %s", LongArgByte (Var, 0));
+        LongCode (C, 2, 3, "bcc %s", LocalLabelName (L));
+        for (I = 1; I < 4; ++I) {
+            if (I > 1) {
+                LongCode (C, 2, 0, "bne %s", LocalLabelName (L));
+            }
+            LongCode (C, Var->Size, 0, "inc %s", LongArgByte (Var, I));
+        }
+        LongDefLabel (C, L);
+        if (Keep) {
+            LongCode (C, Var->Size, Var->Cycles, "lda %s", LongArgByte (Var, 3));
+            LongCode (C, 2, 3, "sta sreg+1");
+            LongCode (C, Var->Size, Var->Cycles, "lda %s", LongArgByte (Var, 2));
+            LongCode (C, 2, 3, "sta sreg");
+            LongCode (C, Var->Size, Var->Cycles, "ldx %s", LongArgByte (Var, 1));
+            LongCode (C, Var->Size, Var->Cycles, "lda %s", LongArgByte (Var, 0));
+        }
+        return;
+    }
+
+    if (A) {
+        /* Operate on the variable in memory. Zero bytes at the bottom of the
+        ** constant don't change anything.
+        */
+        for (I = First; I < 4; ++I) {
+            LongCode (C, Var->Size, Var->Cycles, "lda %s", LongArgByte (Var, I));
+            if (I == First) {
+                LongCode (C, 1, 2, Sub? "sec" : "clc");
+            }
+            LongCode (C, 2, 2, "%s %s", Sub? "sbc" : "adc", LongArgByte (A, I));
+            LongCode (C, Var->Size, Var->Cycles, "sta %s", LongArgByte (Var, I));
+            if (Keep && I >= 2) {
+                LongCode (C, 2, 3, "sta %s", (I == 2)? "sreg" : "sreg+1");
+            }
+        }
+        if (Keep) {
+            if (First == 3) {
+                LongCode (C, Var->Size, Var->Cycles, "lda %s", LongArgByte (Var, 2));
+                LongCode (C, 2, 3, "sta sreg");
+            }
+            LongCode (C, Var->Size, Var->Cycles, "ldx %s", LongArgByte (Var, 1));
+            LongCode (C, Var->Size, Var->Cycles, "lda %s", LongArgByte (Var, 0));
+        }
+        return;
+    }
+
+    /* The operand is in EAX. A subtraction adds its complement plus one. */
+    for (I = 0; I < 4; ++I) {
+        if (I == 1) {
+            LongCode (C, 1, 2, "txa");
+        } else if (I >= 2) {
+            LongCode (C, 2, 3, "lda %s", (I == 2)? "sreg" : "sreg+1");
+        }
+        if (Sub) {
+            LongCode (C, 2, 2, "eor #$FF");
+        }
+        if (I == 0) {
+            LongCode (C, 1, 2, Sub? "sec" : "clc");
+        }
+        LongCode (C, Var->Size, Var->Cycles, "adc %s", LongArgByte (Var, I));
+        LongCode (C, Var->Size, Var->Cycles, "sta %s", LongArgByte (Var, I));
+        if (Keep) {
+            if (I == 1) {
+                LongCode (C, 1, 2, "tax");
+            } else if (I >= 2) {
+                LongCode (C, 2, 3, "sta %s", (I == 2)? "sreg" : "sreg+1");
+            }
+        }
+    }
+    if (Keep) {
+        LongCode (C, Var->Size, Var->Cycles, "lda %s", LongArgByte (Var, 0));
+    }
+}
+
+
+
+static int LongTryAddSub (const LongArg* A, int Sub)
+/* Add the operand to EAX or subtract it with inline code if that pays off
+** against the runtime call. Return true if code was generated.
+*/
+{
+    LongCost Inline = { 0, 0 };
+    LongCost Call;
+
+    LongAddSub (&Inline, A, Sub);
+    LongCallCost (&Call, A, Sub? "tossubeax" : "tosaddeax");
+    if (!LongInline (&Inline, &Call)) {
+        return 0;
+    }
+    LongAddSub (0, A, Sub);
+    return 1;
+}
+
+
+
+static int LongTryBitOp (const LongArg* A, const char* Op, unsigned char Neutral,
+                         int Absorbing, const char* Func)
+/* Do a bitwise operation of EAX with the operand using inline code if that
+** pays off against calling Func. Return true if code was generated.
+*/
+{
+    LongCost Inline = { 0, 0 };
+    LongCost Call;
+
+    LongBitOp (&Inline, A, Op, Neutral, Absorbing);
+    LongCallCost (&Call, A, Func);
+    if (!LongInline (&Inline, &Call)) {
+        return 0;
+    }
+    LongBitOp (0, A, Op, Neutral, Absorbing);
+    return 1;
+}
+
+
+
+static int LongTryCmpEq (const LongArg* A, const char* Bool, const char* Func)
+/* Compare EAX with the operand for equality using inline code and the boolean
+** transformer Bool, if that pays off against calling Func. Return true if
+** code was generated.
+*/
+{
+    LongCost Inline = { 3, 0 };
+    LongCost Call;
+
+    Inline.Cycles = GetFuncCycles (Bool);
+    LongCmpEq (&Inline, A);
+    LongCallCost (&Call, A, Func);
+    if (!LongInline (&Inline, &Call)) {
+        return 0;
+    }
+    LongCmpEq (0, A);
+    AddCodeLine ("%s %s", CrtJsrOrJsl (), Bool);
+    return 1;
+}
+
+
+
+static int LongTryCmpSigned (const LongArg* A, int Ge, const char* Func)
+/* Do a signed compare of EAX with the operand using inline code, if that pays
+** off against calling Func. Return true if code was generated.
+*/
+{
+    LongCost Inline = { 0, 0 };
+    LongCost Call;
+
+    LongCmpSigned (&Inline, A, Ge);
+    LongCallCost (&Call, A, Func);
+    if (!LongInline (&Inline, &Call)) {
+        return 0;
+    }
+    LongCmpSigned (0, A, Ge);
+    return 1;
+}
+
+
+
+static int LongTryShift (unsigned Count, int Right, int Signed, const char* Func)
+/* Shift EAX by Count bits, which must be less than 8, using inline code if
+** that pays off against calling the Func functions. Return true if code was
+** generated.
+*/
+{
+    LongCost Inline = { 0, 0 };
+    LongCost Call;
+
+    LongShift (&Inline, Count, Right, Signed);
+    LongShiftCallCost (&Call, Count, Func);
+    if (!LongInline (&Inline, &Call)) {
+        return 0;
+    }
+    LongShift (0, Count, Right, Signed);
+    return 1;
+}
+
+
+
+static int LongTryOpEqStatic (const LongArg* Var, const LongArg* A, int Sub,
+                              int Keep, const char* Func, int LoadA)
+/* Add the operand to a variable at a fixed address or subtract it using
+** inline code, if that pays off against calling Func. A is NULL if the
+** operand is in EAX, LoadA is true if the call needs it loaded into A.
+** Return true if code was generated.
+*/
+{
+    LongCost Inline = { 0, 0 };
+    LongCost Call;
+
+    LongOpEqStatic (&Inline, Var, A, Sub, Keep);
+    Call.Size   = 2 + 2 + 2 + 3;            /* ldy, sty ptr1, ldy, jsr */
+    Call.Cycles = 2 + 3 + 2 + GetFuncCycles (Func);
+    if (LoadA) {
+        Call.Size   += 2;
+        Call.Cycles += 2;
+    }
+    if (!LongInline (&Inline, &Call)) {
+        return 0;
+    }
+    LongOpEqStatic (0, Var, A, Sub, Keep);
+    return 1;
+}
+
+
+
 /*****************************************************************************/
 /*              Adds and subs of variables fix a fixed address               */
 /*****************************************************************************/
@@ -1619,13 +2267,15 @@ void g_addlocal (unsigned flags, int offs)
     switch (flags & CF_TYPEMASK) {
 
         case CF_CHAR:
-            L = GetLocalLabel();
             AddCodeLine ("ldy #$%02X", NewOff & 0xFF);
             AddCodeLine ("clc");
             AddCodeLine ("adc (sp),y");
-            AddCodeLine ("bcc %s", LocalLabelName (L));
-            AddCodeLine ("inx");
-            g_defcodelabel (L);
+            if ((flags & CF_FORCECHAR) == 0) {
+                L = GetLocalLabel();
+                AddCodeLine ("bcc %s", LocalLabelName (L));
+                AddCodeLine ("inx");
+                g_defcodelabel (L);
+            }
             break;
 
         case CF_INT:
@@ -1659,6 +2309,7 @@ void g_addstatic (unsigned flags, uintptr_t label, long offs)
 /* Add a static variable to ax */
 {
     unsigned L;
+    LongArg  Arg;
 
     /* Create the correct label name */
     const char* lbuf = GetLabelName (flags, label, offs);
@@ -1666,12 +2317,14 @@ void g_addstatic (unsigned flags, uintptr_t label, long offs)
     switch (flags & CF_TYPEMASK) {
 
         case CF_CHAR:
-            L = GetLocalLabel();
             AddCodeLine ("clc");
             AddCodeLine ("adc %s", lbuf);
-            AddCodeLine ("bcc %s", LocalLabelName (L));
-            AddCodeLine ("inx");
-            g_defcodelabel (L);
+            if ((flags & CF_FORCECHAR) == 0) {
+                L = GetLocalLabel();
+                AddCodeLine ("bcc %s", LocalLabelName (L));
+                AddCodeLine ("inx");
+                g_defcodelabel (L);
+            }
             break;
 
         case CF_INT:
@@ -1685,10 +2338,13 @@ void g_addstatic (unsigned flags, uintptr_t label, long offs)
             break;
 
         case CF_LONG:
-            /* Do it the old way */
-            g_push (flags, 0);
-            g_getstatic (flags, label, offs);
-            g_add (flags, 0);
+            LongArgStatic (&Arg, flags, label, offs);
+            if (!LongTryAddSub (&Arg, 0)) {
+                /* Do it the old way */
+                g_push (flags, 0);
+                g_getstatic (flags, label, offs);
+                g_add (flags, 0);
+            }
             break;
 
         default:
@@ -1699,17 +2355,181 @@ void g_addstatic (unsigned flags, uintptr_t label, long offs)
 
 
 
-/*****************************************************************************/
-/*                           Special op= functions                           */
-/*****************************************************************************/
+void g_sublocal (unsigned flags, int offs)
+/* Subtract a local variable from ax */
+{
+    unsigned L;
+    int NewOff;
 
+    /* Correct the offset and check it */
+    NewOff = offs - StackPtr;
+    CheckLocalOffs (NewOff);
 
+    switch (flags & CF_TYPEMASK) {
 
-void g_addeqstatic (unsigned flags, uintptr_t label, long offs,
-                    unsigned long val)
-/* Emit += for a static variable */
-{
-    /* Create the correct label name */
+        case CF_CHAR:
+            AddCodeLine ("ldy #$%02X", NewOff & 0xFF);
+            AddCodeLine ("sec");
+            AddCodeLine ("sbc (sp),y");
+            if ((flags & CF_FORCECHAR) == 0) {
+                L = GetLocalLabel();
+                AddCodeLine ("bcs %s", LocalLabelName (L));
+                AddCodeLine ("dex");
+                g_defcodelabel (L);
+            }
+            break;
+
+        case CF_INT:
+            AddCodeLine ("ldy #$%02X", NewOff & 0xFF);
+            AddCodeLine ("sec");
+            AddCodeLine ("sbc (sp),y");
+            AddCodeLine ("pha");
+            AddCodeLine ("txa");
+            AddCodeLine ("iny");
+            AddCodeLine ("sbc (sp),y");
+            AddCodeLine ("tax");
+            AddCodeLine ("pla");
+            break;
+
+        case CF_LONG:
+            /* Do it the old way */
+            g_push (flags, 0);
+            g_getlocal (flags, offs);
+            g_sub (flags, 0);
+            break;
+
+        default:
+            typeerror (flags);
+
+    }
+}
+
+
+
+void g_substatic (unsigned flags, uintptr_t label, long offs)
+/* Subtract a static variable from ax */
+{
+    unsigned L;
+    LongArg  Arg;
+
+    /* Create the correct label name */
+    const char* lbuf = GetLabelName (flags, label, offs);
+
+    switch (flags & CF_TYPEMASK) {
+
+        case CF_CHAR:
+            AddCodeLine ("sec");
+            AddCodeLine ("sbc %s", lbuf);
+            if ((flags & CF_FORCECHAR) == 0) {
+                L = GetLocalLabel();
+                AddCodeLine ("bcs %s", LocalLabelName (L));
+                AddCodeLine ("dex");
+                g_defcodelabel (L);
+            }
+            break;
+
+        case CF_INT:
+            AddCodeLine ("sec");
+            AddCodeLine ("sbc %s", lbuf);
+            AddCodeLine ("tay");
+            AddCodeLine ("txa");
+            AddCodeLine ("sbc %s+1", lbuf);
+            AddCodeLine ("tax");
+            AddCodeLine ("tya");
+            break;
+
+        case CF_LONG:
+            LongArgStatic (&Arg, flags, label, offs);
+            if (!LongTryAddSub (&Arg, 1)) {
+                /* Do it the old way */
+                g_push (flags, 0);
+                g_getstatic (flags, label, offs);
+                g_sub (flags, 0);
+            }
+            break;
+
+        default:
+            typeerror (flags);
+
+    }
+}
+
+
+
+void g_andstatic (unsigned flags, uintptr_t label, long offs)
+/* And eax with a static variable. Only longs are supported. */
+{
+    LongArg Arg;
+
+    if ((flags & CF_TYPEMASK) != CF_LONG) {
+        typeerror (flags);
+    }
+
+    LongArgStatic (&Arg, flags, label, offs);
+    if (!LongTryBitOp (&Arg, "and", 0xFF, 0x00, "tosandeax")) {
+        /* Do it the old way */
+        g_push (flags, 0);
+        g_getstatic (flags, label, offs);
+        g_and (flags, 0);
+    }
+}
+
+
+
+void g_orstatic (unsigned flags, uintptr_t label, long offs)
+/* Or eax with a static variable. Only longs are supported. */
+{
+    LongArg Arg;
+
+    if ((flags & CF_TYPEMASK) != CF_LONG) {
+        typeerror (flags);
+    }
+
+    LongArgStatic (&Arg, flags, label, offs);
+    if (!LongTryBitOp (&Arg, "ora", 0x00, 0xFF, "tosoreax")) {
+        /* Do it the old way */
+        g_push (flags, 0);
+        g_getstatic (flags, label, offs);
+        g_or (flags, 0);
+    }
+}
+
+
+
+void g_xorstatic (unsigned flags, uintptr_t label, long offs)
+/* Exclusive or eax with a static variable. Only longs are supported. */
+{
+    LongArg Arg;
+
+    if ((flags & CF_TYPEMASK) != CF_LONG) {
+        typeerror (flags);
+    }
+
+    LongArgStatic (&Arg, flags, label, offs);
+    if (!LongTryBitOp (&Arg, "eor", 0x00, -1, "tosxoreax")) {
+        /* Do it the old way */
+        g_push (flags, 0);
+        g_getstatic (flags, label, offs);
+        g_xor (flags, 0);
+    }
+}
+
+
+
+/*****************************************************************************/
+/*                           Special op= functions                           */
+/*****************************************************************************/
+
+
+
+void g_addeqstatic (unsigned flags, uintptr_t label, long offs,
+                    unsigned long val)
+/* Emit += for a static variable */
+{
+    LongArg Var;
+    LongArg Arg;
+
+    /* Create the correct label name */
     const char* lbuf = GetLabelName (flags, label, offs);
 
     /* Check the size and determine operation */
@@ -1795,8 +2615,15 @@ void g_addeqstatic (unsigned flags, uintptr_t label, long offs,
             break;
 
         case CF_LONG:
+            LongArgStatic (&Var, flags, label, offs);
+            LongArgConst (&Arg, val);
             if (flags & CF_CONST) {
-                if (val < 0x100) {
+                if (val >= 0x100) {
+                    /* Operate on the variable in memory */
+                    LongOpEqStatic (0, &Var, &Arg, 0, (flags & CF_NOKEEP) == 0);
+                } else if (!LongTryOpEqStatic (&Var, &Arg, 0, (flags & CF_NOKEEP) == 0,
+                                               (val == 1)? "laddeq1" : "laddeqa",
+                                               val != 1)) {
                     AddCodeLine ("ldy #<(%s)", lbuf);
                     AddCodeLine ("sty ptr1");
                     AddCodeLine ("ldy #>(%s)", lbuf);
@@ -1806,12 +2633,9 @@ void g_addeqstatic (unsigned flags, uintptr_t label, long offs,
                         AddCodeLine ("lda #$%02X", (int)(val & 0xFF));
                         AddCodeLine ("%s laddeqa", CrtJsrOrJsl());
                     }
-                } else {
-                    g_getstatic (flags, label, offs);
-                    g_inc (flags, val);
-                    g_putstatic (flags, label, offs);
                 }
-            } else {
+            } else if (!LongTryOpEqStatic (&Var, 0, 0, (flags & CF_NOKEEP) == 0,
+                                           "laddeq", 0)) {
                 AddCodeLine ("ldy #<(%s)", lbuf);
                 AddCodeLine ("sty ptr1");
                 AddCodeLine ("ldy #>(%s)", lbuf);
@@ -1944,6 +2768,9 @@ void g_subeqstatic (unsigned flags, uintptr_t label, long offs,
                     unsigned long val)
 /* Emit -= for a static variable */
 {
+    LongArg Var;
+    LongArg Arg;
+
     /* Create the correct label name */
     const char* lbuf = GetLabelName (flags, label, offs);
 
@@ -2051,19 +2878,22 @@ void g_subeqstatic (unsigned flags, uintptr_t label, long offs,
             break;
 
         case CF_LONG:
+            LongArgStatic (&Var, flags, label, offs);
+            LongArgConst (&Arg, val);
             if (flags & CF_CONST) {
-                if (val < 0x100) {
+                if (val >= 0x100) {
+                    /* Operate on the variable in memory */
+                    LongOpEqStatic (0, &Var, &Arg, 1, (flags & CF_NOKEEP) == 0);
+                } else if (!LongTryOpEqStatic (&Var, &Arg, 1, (flags & CF_NOKEEP) == 0,
+                                               "lsubeqa", 1)) {
                     AddCodeLine ("ldy #<(%s)", lbuf);
                     AddCodeLine ("sty ptr1");
                     AddCodeLine ("ldy #>(%s)", lbuf);
                     AddCodeLine ("lda #$%02X", (unsigned char)val);
                     AddCodeLine ("%s lsubeqa", CrtJsrOrJsl());
-                } else {
-                    g_getstatic (flags, label, offs);
-                    g_dec (flags, val);
-                    g_putstatic (flags, label, offs);
                 }
-            } else {
+            } else if (!LongTryOpEqStatic (&Var, 0, 1, (flags & CF_NOKEEP) == 0,
+                                           "lsubeq", 0)) {
                 AddCodeLine ("ldy #<(%s)", lbuf);
                 AddCodeLine ("sty ptr1");
                 AddCodeLine ("ldy #>(%s)", lbuf);
@@ -2665,6 +3495,13 @@ void g_add (unsigned flags, unsigned long val)
     };
 
     if (flags & CF_CONST) {
+        if ((flags & CF_TYPEMASK) == CF_LONG) {
+            LongArg Arg;
+            LongArgConst (&Arg, val);
+            if (LongTryAddSub (&Arg, 0)) {
+                return;
+            }
+        }
         flags &= ~CF_FORCECHAR; /* Handle chars as ints */
         g_push (flags & ~CF_CONST, 0);
     }
@@ -2681,6 +3518,13 @@ void g_sub (unsigned flags, unsigned long val)
     };
 
     if (flags & CF_CONST) {
+        if ((flags & CF_TYPEMASK) == CF_LONG) {
+            LongArg Arg;
+            LongArgConst (&Arg, val);
+            if (LongTryAddSub (&Arg, 1)) {
+                return;
+            }
+        }
         flags &= ~CF_FORCECHAR; /* Handle chars as ints */
         g_push (flags & ~CF_CONST, 0);
     }
@@ -2700,6 +3544,542 @@ void g_rsub (unsigned flags, unsigned long val)
 
 
 
+/* Multiplication by a constant that is not a power of two may be done by a
+** chain of operations on the primary register: Shifts, followed by adding or
+** subtracting the operand, and multiplications by factors 2^k+1 or 2^k-1,
+** which add or subtract a shifted copy of the intermediate result. For 16
+** bit operands, the runtime functions mulax3 .. mulax10 are used as factors,
+** too. The cheapest chain is searched recursively, remembering the best
+** chain for each value (in the style of Bernstein's algorithm). Shifts are
+** done by g_asl, so the optimizer steps for shifts apply to them. The chain
+** is used if it is the fastest variant that doesn't exceed the size of the
+** runtime call by more than CodeSizeFactor allows, or if it has the lowest
+** weighted cost if a cycle weight is set.
+*/
+
+/* Operations in a multiplication chain */
+#define MUL_ONE         0               /* The operand itself */
+#define MUL_SHIFT       1               /* Shift left */
+#define MUL_ADD         2               /* Shift left, add the operand */
+#define MUL_SUB         3               /* Shift left, subtract the operand */
+#define MUL_FADD        4               /* Multiply by 2^k+1 */
+#define MUL_FSUB        5               /* Multiply by 2^k-1 */
+#define MUL_HELPER      6               /* Multiply by a runtime function */
+
+/* Number of values remembered by the search */
+#define MUL_MAX_NODES   128
+
+/* The best chain for a value */
+typedef struct MulNode MulNode;
+struct MulNode {
+    unsigned long       Val;            /* Value computed by the chain */
+    unsigned long       Prev;           /* Value the last operation applies to */
+    unsigned            Op;             /* Last operation */
+    unsigned            Arg;            /* Shift count or helper index */
+    unsigned long       Size;           /* Size of the chain in bytes */
+    unsigned long       Cycles;         /* Cycles of the chain */
+};
+
+/* Search for the chains of one multiplication */
+typedef struct MulSearch MulSearch;
+struct MulSearch {
+    unsigned            Flags;          /* Flags of the multiplication */
+    unsigned            Bits;           /* Width of the operand */
+    unsigned            Weight;         /* Cycle weight for the search */
+    unsigned            Count;          /* Number of nodes */
+    MulNode             Nodes[MUL_MAX_NODES];
+};
+
+/* Registers for the operand and for the intermediate result that is saved
+** by the factor operations.
+*/
+static const char* const MulRegs8[2][4] = {
+    { "tmp1" },
+    { "tmp2" },
+};
+static const char* const MulRegs16[2][4] = {
+    { "ptr2", "ptr2+1" },
+    { "sreg", "sreg+1" },
+};
+static const char* const MulRegs32[2][4] = {
+    { "ptr1", "ptr1+1", "ptr2", "ptr2+1" },
+    { "ptr3", "ptr3+1", "ptr4", "ptr4+1" },
+};
+
+/* Runtime functions for shifts and multiplications */
+static const char* const MulAslax[5] = {
+    0, "aslax1", "aslax2", "aslax3", "aslax4"
+};
+static const char* const MulAsleax[5] = {
+    0, "asleax1", "asleax2", "asleax3", "asleax4"
+};
+typedef struct MulHelper MulHelper;
+struct MulHelper {
+    unsigned            Factor;
+    const char*         Name;
+};
+static const MulHelper MulHelpers[] = {
+    {  3, "mulax3"  },
+    {  5, "mulax5"  },
+    {  6, "mulax6"  },
+    {  7, "mulax7"  },
+    {  9, "mulax9"  },
+    { 10, "mulax10" },
+};
+
+
+
+static const char* const* MulRegs (const MulSearch* M, int Saved)
+/* Return the registers for the operand or the saved intermediate result */
+{
+    switch (M->Bits) {
+        case 8:     return MulRegs8[Saved != 0];
+        case 16:    return MulRegs16[Saved != 0];
+        default:    return MulRegs32[Saved != 0];
+    }
+}
+
+
+
+static void MulShiftCost (const MulSearch* M, unsigned Count, MulNode* N)
+/* Add the cost of a shift by Count bits as done by g_asl to N */
+{
+    switch (M->Bits) {
+
+        case 8:
+            if (Count < 6) {
+                N->Size   += Count;
+                N->Cycles += 2 * Count;
+            } else {
+                N->Size   += 11 - Count;
+                N->Cycles += 20 - 2 * Count;
+            }
+            break;
+
+        case 16:
+            if (Count >= 8) {
+                N->Size   += 3;
+                N->Cycles += 4;
+                Count     -= 8;
+            }
+            if (Count == 7) {
+                N->Size   += 3;
+                N->Cycles += GetFuncCycles ("aslax7");
+                Count      = 0;
+            }
+            if (Count >= 4) {
+                N->Size   += 3;
+                N->Cycles += GetFuncCycles (MulAslax[4]);
+                Count     -= 4;
+            }
+            if (Count > 0) {
+                N->Size   += 3;
+                N->Cycles += GetFuncCycles (MulAslax[Count]);
+            }
+            break;
+
+        default:
+            if (Count >= 24) {
+                N->Size   += 7;
+                N->Cycles += 10;
+                Count     -= 24;
+            }
+            if (Count >= 16) {
+                N->Size   += 7;
+                N->Cycles += 10;
+                Count     -= 16;
+            }
+            if (Count >= 8) {
+                N->Size   += 9;
+                N->Cycles += 13;
+                Count     -= 8;
+            }
+            if (Count > 4) {
+                N->Size   += 3;
+                N->Cycles += GetFuncCycles (MulAsleax[4]);
+                Count     -= 4;
+            }
+            if (Count > 0) {
+                N->Size   += 3;
+                N->Cycles += GetFuncCycles (MulAsleax[Count]);
+            }
+            break;
+    }
+}
+
+
+
+static void MulSaveCost (const MulSearch* M, MulNode* N)
+/* Add the cost of MulSave to N */
+{
+    switch (M->Bits) {
+        case 8:     N->Size += 2;   N->Cycles += 3;     break;
+        case 16:    N->Size += 4;   N->Cycles += 6;     break;
+        default:    N->Size += 12;  N->Cycles += 18;    break;
+    }
+}
+
+
+
+static void MulAddCost (const MulSearch* M, MulNode* N)
+/* Add the cost of MulAdd to N */
+{
+    switch (M->Bits) {
+        case 8:     N->Size += 3;   N->Cycles += 5;     break;
+        case 16:    N->Size += 9;   N->Cycles += 14;    break;
+        default:    N->Size += 21;  N->Cycles += 34;    break;
+    }
+}
+
+
+
+static const MulNode* MulFind (MulSearch* M, unsigned long Val);
+/* Return the cheapest chain for Val, or NULL if the search gives up */
+
+
+
+static void MulTry (MulSearch* M, MulNode* Best, unsigned Op, unsigned Arg,
+                    unsigned long Prev)
+/* Check if applying Op to the chain for Prev is cheaper than Best */
+{
+    MulNode N;
+    const MulNode* P = MulFind (M, Prev);
+    if (P == 0) {
+        return;
+    }
+
+    N.Val    = Best->Val;
+    N.Prev   = Prev;
+    N.Op     = Op;
+    N.Arg    = Arg;
+    N.Size   = P->Size;
+    N.Cycles = P->Cycles;
+    switch (Op) {
+        case MUL_SHIFT:
+            MulShiftCost (M, Arg, &N);
+            break;
+        case MUL_ADD:
+        case MUL_SUB:
+            MulShiftCost (M, Arg, &N);
+            MulAddCost (M, &N);
+            break;
+        case MUL_FADD:
+        case MUL_FSUB:
+            MulSaveCost (M, &N);
+            MulShiftCost (M, Arg, &N);
+            MulAddCost (M, &N);
+            break;
+        case MUL_HELPER:
+            N.Size   += 3;
+            N.Cycles += GetFuncCycles (MulHelpers[Arg].Name);
+            break;
+    }
+
+    if (Best->Op == MUL_ONE ||
+        GetCodeCost (N.Size, N.Cycles, M->Weight) <
+        GetCodeCost (Best->Size, Best->Cycles, M->Weight)) {
+        *Best = N;
+    }
+}
+
+
+
+static unsigned MulZeros (unsigned long Val)
+/* Return the number of trailing zero bits of Val, which must not be zero */
+{
+    unsigned Count = 0;
+    while ((Val & 0x01) == 0) {
+        ++Count;
+        Val >>= 1;
+    }
+    return Count;
+}
+
+
+
+static const MulNode* MulFind (MulSearch* M, unsigned long Val)
+/* Return the cheapest chain for Val, or NULL if the search gives up */
+{
+    unsigned long Mask = (M->Bits == 32)? 0xFFFFFFFFUL : (1UL << M->Bits) - 1;
+    MulNode       Best;
+    unsigned      I;
+    unsigned      K;
+
+    /* Check if we know the value already */
+    for (I = 0; I < M->Count; ++I) {
+        if (M->Nodes[I].Val == Val) {
+            return M->Nodes + I;
+        }
+    }
+    if (M->Count >= MUL_MAX_NODES) {
+        return 0;
+    }
+
+    /* MUL_ONE is used as a marker for "nothing found" if Val isn't one */
+    Best.Val    = Val;
+    Best.Prev   = 0;
+    Best.Op     = MUL_ONE;
+    Best.Arg    = 0;
+    Best.Size   = 0;
+    Best.Cycles = 0;
+
+    if (Val != 1) {
+        if ((Val & 0x01) == 0) {
+            K = MulZeros (Val);
+            MulTry (M, &Best, MUL_SHIFT, K, Val >> K);
+        } else {
+            K = MulZeros (Val - 1);
+            MulTry (M, &Best, MUL_ADD, K, (Val - 1) >> K);
+            if (((Val + 1) & Mask) != 0) {
+                K = MulZeros (Val + 1);
+                MulTry (M, &Best, MUL_SUB, K, (Val + 1) >> K);
+            }
+            for (K = 1; K < M->Bits; ++K) {
+                unsigned long F = (1UL << K) + 1;
+                if (F < Val && Val % F == 0) {
+                    MulTry (M, &Best, MUL_FADD, K, Val / F);
+                }
+                F -= 2;
+                if (K > 1 && F < Val && Val % F == 0) {
+                    MulTry (M, &Best, MUL_FSUB, K, Val / F);
+                }
+            }
+        }
+        if (M->Bits == 16) {
+            for (I = 0; I < sizeof (MulHelpers) / sizeof (MulHelpers[0]); ++I) {
+                if (Val % MulHelpers[I].Factor == 0) {
+                    MulTry (M, &Best, MUL_HELPER, I,
+                            Val / MulHelpers[I].Factor);
+                }
+            }
+        }
+        if (Best.Op == MUL_ONE || M->Count >= MUL_MAX_NODES) {
+            /* Nothing found or no space left */
+            return 0;
+        }
+    }
+
+    M->Nodes[M->Count] = Best;
+    return M->Nodes + M->Count++;
+}
+
+
+
+static int MulUsesOperand (MulSearch* M, const MulNode* N)
+/* Return true if the chain N adds or subtracts the operand */
+{
+    while (N->Op != MUL_ONE) {
+        if (N->Op == MUL_ADD || N->Op == MUL_SUB) {
+            return 1;
+        }
+        N = MulFind (M, N->Prev);
+    }
+    return 0;
+}
+
+
+
+static void MulSave (const MulSearch* M, int Saved)
+/* Save the primary register as the operand or the intermediate result */
+{
+    const char* const* Regs = MulRegs (M, Saved);
+
+    AddCodeLine ("sta %s", Regs[0]);
+    if (M->Bits >= 16) {
+        AddCodeLine ("stx %s", Regs[1]);
+    }
+    if (M->Bits == 32) {
+        AddCodeLine ("ldy sreg");
+        AddCodeLine ("sty %s", Regs[2]);
+        AddCodeLine ("ldy sreg+1");
+        AddCodeLine ("sty %s", Regs[3]);
+    }
+}
+
+
+
+static void MulAdd (const MulSearch* M, int Sub, int Saved)
+/* Add or subtract the operand or the saved intermediate result */
+{
+    const char* const* Regs = MulRegs (M, Saved);
+    const char*        Op   = Sub? "sbc" : "adc";
+
+    AddCodeLine (Sub? "sec" : "clc");
+    AddCodeLine ("%s %s", Op, Regs[0]);
+    if (M->Bits >= 16) {
+        AddCodeLine ("tay");
+        AddCodeLine ("txa");
+        AddCodeLine ("%s %s", Op, Regs[1]);
+        AddCodeLine ("tax");
+        if (M->Bits == 32) {
+            AddCodeLine ("lda sreg");
+            AddCodeLine ("%s %s", Op, Regs[2]);
+            AddCodeLine ("sta sreg");
+            AddCodeLine ("lda sreg+1");
+            AddCodeLine ("%s %s", Op, Regs[3]);
+            AddCodeLine ("sta sreg+1");
+        }
+        AddCodeLine ("tya");
+    }
+}
+
+
+
+static void MulEmit (MulSearch* M, const MulNode* N)
+/* Generate the code for the chain N */
+{
+    if (N->Op == MUL_ONE) {
+        return;
+    }
+
+    MulEmit (M, MulFind (M, N->Prev));
+    switch (N->Op) {
+        case MUL_SHIFT:
+            g_asl (M->Flags, N->Arg);
+            break;
+        case MUL_ADD:
+        case MUL_SUB:
+            g_asl (M->Flags, N->Arg);
+            MulAdd (M, N->Op == MUL_SUB, 0);
+            break;
+        case MUL_FADD:
+        case MUL_FSUB:
+            MulSave (M, 1);
+            g_asl (M->Flags, N->Arg);
+            MulAdd (M, N->Op == MUL_FSUB, 1);
+            break;
+        case MUL_HELPER:
+            AddCodeLine ("%s %s", CrtJsrOrJsl(), MulHelpers[N->Arg].Name);
+            break;
+    }
+}
+
+
+
+static int g_mulconst (unsigned flags, unsigned long val)
+/* Generate a chain for a multiplication of the primary register by the
+** constant val if this is cheaper than the runtime call. Return true if
+** code was generated.
+*/
+{
+    MulSearch      M;
+    const MulNode* Pos;
+    const MulNode* NegPos;
+    MulNode        Chain;
+    MulNode        Call;
+    unsigned long  MinSize;
+    unsigned long  MaxSize;
+    unsigned long  Mask;
+    unsigned long  Neg;
+    int            Negate = 0;
+
+    /* Determine the width of the operand */
+    switch (flags & CF_TYPEMASK) {
+        case CF_CHAR:
+            M.Bits = (flags & CF_FORCECHAR)? 8 : 16;
+            break;
+        case CF_INT:
+            M.Bits = 16;
+            break;
+        case CF_LONG:
+            M.Bits = 32;
+            break;
+        default:
+            return 0;
+    }
+    Mask = (M.Bits == 32)? 0xFFFFFFFFUL : (1UL << M.Bits) - 1;
+    val &= Mask;
+    if (val < 2) {
+        return 0;
+    }
+    M.Flags  = flags;
+    M.Weight = (unsigned) IS_Get (&CycleWeight);
+    if (M.Weight == 0) {
+        /* Search for the smallest chain, break ties by the cycles */
+        M.Weight = 1;
+    }
+    M.Count  = 0;
+
+    /* Search for a chain for the value and for its negation */
+    Pos = MulFind (&M, val);
+    Neg = (0UL - val) & Mask;
+    NegPos = (Neg >= 2)? MulFind (&M, Neg) : 0;
+    if (Pos) {
+        Chain = *Pos;
+    }
+    if (NegPos) {
+        MulNode C = *NegPos;
+        if (M.Bits == 8) {
+            C.Size   += 5;
+            C.Cycles += 6;
+        } else {
+            C.Size   += 3;
+            C.Cycles += GetFuncCycles ((M.Bits == 16)? "negax" : "negeax");
+        }
+        if (Pos == 0 ||
+            GetCodeCost (C.Size, C.Cycles, M.Weight) <
+            GetCodeCost (Chain.Size, Chain.Cycles, M.Weight)) {
+            Chain  = C;
+            Negate = 1;
+        }
+    }
+    if (Pos == 0 && !Negate) {
+        return 0;
+    }
+    if (MulUsesOperand (&M, &Chain)) {
+        MulSaveCost (&M, &Chain);
+    }
+
+    /* The cost of the runtime call including pushing the operand and
+    ** loading the constant.
+    */
+    switch (M.Bits) {
+        case 8:
+        case 16:
+            Call.Size   = (val <= 0xFF)? 8 : 10;
+            Call.Cycles = GetFuncCycles ((M.Bits == 8)? "pusha0" : "pushax") +
+                          ((val <= 0xFF)? 2 : 4) +
+                          GetFuncCycles ((val <= 0xFF)? "tosmula0" : "tosmulax");
+            break;
+        default:
+            Call.Size   = 18;
+            Call.Cycles = GetFuncCycles ("pusheax") + 18 +
+                          GetFuncCycles ("tosmuleax");
+            break;
+    }
+
+    /* Decide */
+    if (IS_Get (&CycleWeight) > 0) {
+        if (GetCodeCost (Chain.Size, Chain.Cycles, M.Weight) >=
+            GetCodeCost (Call.Size, Call.Cycles, M.Weight)) {
+            return 0;
+        }
+    } else {
+        MinSize = (Chain.Size < Call.Size)? Chain.Size : Call.Size;
+        MaxSize = MinSize * IS_Get (&CodeSizeFactor) / 100;
+        if (MaxSize < MinSize) {
+            /* A code size factor below 100 asks for the smallest code */
+            MaxSize = MinSize;
+        }
+        if (Chain.Size > MaxSize ||
+            (Call.Size <= MaxSize && Chain.Cycles >= Call.Cycles)) {
+            return 0;
+        }
+    }
+
+    /* Generate the code */
+    if (MulUsesOperand (&M, &Chain)) {
+        MulSave (&M, 0);
+    }
+    MulEmit (&M, &Chain);
+    if (Negate) {
+        g_neg (flags);
+    }
+    return 1;
+}
+
+
+
 void g_mul (unsigned flags, unsigned long val)
 /* Primary = TOS * Primary */
 {
@@ -2734,100 +4114,398 @@ void g_mul (unsigned flags, unsigned long val)
     */
     if (flags & CF_CONST) {
 
-        switch (flags & CF_TYPEMASK) {
+        switch (flags & CF_TYPEMASK) {
+
+            case CF_CHAR:
+                if (flags & CF_FORCECHAR) {
+                    /* Handle some special cases */
+                    switch (val) {
+                        case 0:
+                            AddCodeLine ("lda #$00");
+                            return;
+                        case 1:
+                            /* Nothing to do */
+                            return;
+                    }
+                }
+                /* FALLTHROUGH */
+
+            case CF_INT:
+                switch (val) {
+                    case 0:
+                        AddCodeLine ("lda #$00");
+                        AddCodeLine ("tax");
+                        return;
+                    case 1:
+                        /* Nothing to do */
+                        return;
+                }
+                break;
+
+            case CF_LONG:
+                break;
+
+            default:
+                typeerror (flags);
+        }
+
+        /* Try a chain of shifts and additions */
+        if (g_mulconst (flags, val)) {
+            return;
+        }
+
+        /* If we go here, we didn't emit code. Push the lhs on stack and fall
+        ** into the normal, non-optimized stuff.
+        */
+        flags &= ~CF_FORCECHAR; /* Handle chars as ints */
+        g_push (flags & ~CF_CONST, 0);
+
+    }
+
+    /* Use long way over the stack */
+    oper (flags, val, ops);
+}
+
+
+
+/* Unsigned division and modulo by a constant that is not a power of two may
+** be done inline by shifting the dividend bit by bit into a remainder, and
+** subtracting the divisor whenever possible, while the quotient bits are
+** shifted into the vacated bits of the dividend. The leading iterations can
+** be replaced by plain shifts, since the remainder stays below the divisor.
+** If the divisor has the high bit of the dividend set, the quotient is zero
+** or one, and a single compare is enough. The inline code may be a loop or
+** unrolled, and is used if it is the fastest variant that doesn't exceed
+** the size of the runtime call by more than CodeSizeFactor allows, or if it
+** has the lowest weighted cost if a cycle weight is set.
+*/
+typedef struct UDivCost UDivCost;
+struct UDivCost {
+    unsigned long Size;                 /* Code size in bytes */
+    unsigned long Cycles;               /* Average cycles */
+};
+
+/* Variants of the division code */
+#define UDIV_CALL       0               /* Call the runtime */
+#define UDIV_LOOP       1               /* Inline loop */
+#define UDIV_UNROLLED   2               /* Unrolled inline code */
+
+
+
+static unsigned UDivBits (unsigned long Val)
+/* Return the number of significant bits in Val */
+{
+    unsigned Bits = 0;
+    while (Val) {
+        ++Bits;
+        Val >>= 1;
+    }
+    return Bits;
+}
+
+
+
+static int UDivWide (unsigned Flags)
+/* Return true if the dividend for an inline division has 16 bits */
+{
+    return (Flags & CF_TYPEMASK) == CF_INT;
+}
+
+
+
+static int UDivIsSingle (unsigned Flags, unsigned long Val)
+/* Return true if the quotient for an inline division is zero or one */
+{
+    return Val >= (UDivWide (Flags)? 0x8000UL : 0x80UL);
+}
+
+
+
+static void UDivCalcCost (unsigned Flags, unsigned long Val, int Mod,
+                          unsigned Variant, UDivCost* C)
+/* Calculate the cost of a division variant, see g_udivconst */
+{
+    unsigned Wide  = UDivWide (Flags);
+    unsigned Bits  = UDivBits (Val);
+    unsigned Count;
+    unsigned Lead;
+    unsigned long LeadSize, LeadCycles;
+    unsigned long IterSize, IterCycles;
+
+    if (Variant == UDIV_CALL) {
+        /* Push, load the divisor, call the runtime */
+        C->Size   = (Val > 0xFF)? 10 : 8;
+        C->Cycles = GetFuncCycles (Wide? "pushax" : "pusha0") +
+                    ((Val > 0xFF)? 4 : 2);
+        if (Val > 0xFF) {
+            C->Cycles += GetFuncCycles (Mod? "tosumodax" : "tosudivax");
+        } else {
+            C->Cycles += GetFuncCycles (Mod? "tosumoda0" : "tosudiva0");
+        }
+        return;
+    }
+
+    if (UDivIsSingle (Flags, Val)) {
+        if (Wide) {
+            C->Size   = Mod? 14 : 9;
+            C->Cycles = Mod? 21 : 12;
+        } else {
+            C->Size   = 6;
+            C->Cycles = Mod? 5 : 6;
+        }
+        return;
+    }
+
+    if (Val > 0xFF) {
+        /* 16 bit remainder, the high byte of the dividend is shifted in
+        ** by the setup.
+        */
+        Count      = 8;
+        Lead       = Bits - 9;
+        C->Size    = Mod? 9 : 11;
+        C->Cycles  = Mod? 13 : 15;
+        LeadSize   = 5;
+        LeadCycles = 12;
+        IterSize   = 23;
+        IterCycles = 33;
+    } else {
+        Count      = Wide? 16 : 8;
+        Lead       = Bits - 1;
+        C->Size    = 4 + 2 * Wide + (Mod? 2 * Wide : 2 + 2 * Wide);
+        C->Cycles  = 5 + 3 * Wide + (Mod? 2 * Wide : 3 + 3 * Wide);
+        LeadSize   = 3 + 2 * Wide;
+        LeadCycles = 7 + 5 * Wide;
+        IterSize   = 9 + 2 * Wide + ((Val >= 0x80)? 2 : 0);
+        IterCycles = 15 + 5 * Wide + ((Val >= 0x80)? 2 : 0);
+    }
+
+    if (Variant == UDIV_LOOP) {
+        /* ldx/dex/bne around one iteration */
+        C->Size   += IterSize + 5;
+        C->Cycles += (IterCycles + 5) * Count + 1;
+    } else {
+        C->Size   += LeadSize * Lead + IterSize * (Count - Lead);
+        C->Cycles += LeadCycles * Lead + IterCycles * (Count - Lead);
+    }
+}
+
+
+
+static unsigned UDivVariant (unsigned Flags, unsigned long Val, int Mod)
+/* Determine the variant to use for an unsigned division by Val */
+{
+    UDivCost      Costs[3];
+    unsigned      Best;
+    unsigned      I;
+    unsigned      Weight;
+    unsigned long MaxSize;
+
+    /* Check if the operands allow inline code */
+    if ((Flags & (CF_CONST | CF_UNSIGNED)) != (CF_CONST | CF_UNSIGNED) ||
+        Val < 3 || PowerOf2 (Val) >= 0) {
+        return UDIV_CALL;
+    }
+    switch (Flags & CF_TYPEMASK) {
+        case CF_CHAR:
+            if (Val > 0xFF) {
+                return UDIV_CALL;
+            }
+            break;
+        case CF_INT:
+            if (Val > 0xFFFF) {
+                return UDIV_CALL;
+            }
+            break;
+        default:
+            return UDIV_CALL;
+    }
+
+    for (I = UDIV_CALL; I <= UDIV_UNROLLED; ++I) {
+        UDivCalcCost (Flags, Val, Mod, I, Costs + I);
+    }
 
-            case CF_CHAR:
-                if (flags & CF_FORCECHAR) {
-                    /* Handle some special cases */
-                    switch (val) {
-                        case 0:
-                            AddCodeLine ("lda #$00");
-                            return;
-                        case 1:
-                            /* Nothing to do */
-                            return;
-                        case 3:
-                            AddCodeLine ("sta tmp1");
-                            AddCodeLine ("asl a");
-                            AddCodeLine ("clc");
-                            AddCodeLine ("adc tmp1");
-                            return;
+    Best   = UDIV_CALL;
+    Weight = (unsigned) IS_Get (&CycleWeight);
+    if (Weight > 0) {
+        for (I = UDIV_LOOP; I <= UDIV_UNROLLED; ++I) {
+            if (GetCodeCost (Costs[I].Size, Costs[I].Cycles, Weight) <
+                GetCodeCost (Costs[Best].Size, Costs[Best].Cycles, Weight)) {
+                Best = I;
+            }
+        }
+    } else {
+        MaxSize = Costs[UDIV_CALL].Size * IS_Get (&CodeSizeFactor) / 100;
+        for (I = UDIV_LOOP; I <= UDIV_UNROLLED; ++I) {
+            if (Costs[I].Size <= MaxSize &&
+                (Costs[I].Cycles < Costs[Best].Cycles ||
+                 (Costs[I].Cycles == Costs[Best].Cycles &&
+                  Costs[I].Size < Costs[Best].Size))) {
+                Best = I;
+            }
+        }
+    }
+    return Best;
+}
 
-                        case 5:
-                            AddCodeLine ("sta tmp1");
-                            AddCodeLine ("asl a");
-                            AddCodeLine ("asl a");
-                            AddCodeLine ("clc");
-                            AddCodeLine ("adc tmp1");
-                            return;
 
-                        case 6:
-                            AddCodeLine ("sta tmp1");
-                            AddCodeLine ("asl a");
-                            AddCodeLine ("clc");
-                            AddCodeLine ("adc tmp1");
-                            AddCodeLine ("asl a");
-                            return;
 
-                        case 10:
-                            AddCodeLine ("sta tmp1");
-                            AddCodeLine ("asl a");
-                            AddCodeLine ("asl a");
-                            AddCodeLine ("clc");
-                            AddCodeLine ("adc tmp1");
-                            AddCodeLine ("asl a");
-                            return;
-                    }
-                }
-                /* FALLTHROUGH */
+static void g_udivconst (unsigned flags, unsigned long val, int Mod,
+                         unsigned Variant)
+/* Generate inline code for an unsigned division or modulo of the primary
+** register by the constant val, using a variant determined by UDivVariant.
+*/
+{
+    unsigned Wide = UDivWide (flags);
+    unsigned Bits = UDivBits (val);
+    unsigned Count;
+    unsigned Lead;
+    unsigned LoopLabel = 0;
+    unsigned SkipLabel;
+    unsigned SubLabel;
+    unsigned I;
 
-            case CF_INT:
-                switch (val) {
-                    case 0:
-                        AddCodeLine ("lda #$00");
-                        AddCodeLine ("tax");
-                        return;
-                    case 1:
-                        /* Nothing to do */
-                        return;
-                    case 3:
-                        AddCodeLine ("%s mulax3", CrtJsrOrJsl());
-                        return;
-                    case 5:
-                        AddCodeLine ("%s mulax5", CrtJsrOrJsl());
-                        return;
-                    case 6:
-                        AddCodeLine ("%s mulax6", CrtJsrOrJsl());
-                        return;
-                    case 7:
-                        AddCodeLine ("%s mulax7", CrtJsrOrJsl());
-                        return;
-                    case 9:
-                        AddCodeLine ("%s mulax9", CrtJsrOrJsl());
-                        return;
-                    case 10:
-                        AddCodeLine ("%s mulax10", CrtJsrOrJsl());
-                        return;
-                }
-                break;
+    if (UDivIsSingle (flags, val)) {
+        /* The quotient is the result of a single compare */
+        SkipLabel = GetLocalLabel ();
+        if (Wide) {
+            if (Mod) {
+                AddCodeLine ("tay");
+            }
+            AddCodeLine ("cmp #$%02X", (unsigned char) val);
+            AddCodeLine ("txa");
+            AddCodeLine ("sbc #$%02X", (unsigned char) (val >> 8));
+            if (Mod) {
+                AddCodeLine ("bcc %s", LocalLabelName (SkipLabel));
+                AddCodeLine ("tax");
+                AddCodeLine ("tya");
+                AddCodeLine ("sbc #$%02X", (unsigned char) val);
+                AddCodeLine ("tay");
+                g_defcodelabel (SkipLabel);
+                AddCodeLine ("tya");
+            } else {
+                AddCodeLine ("lda #$00");
+                AddCodeLine ("tax");
+                AddCodeLine ("rol a");
+            }
+        } else {
+            AddCodeLine ("cmp #$%02X", (unsigned char) val);
+            if (Mod) {
+                AddCodeLine ("bcc %s", LocalLabelName (SkipLabel));
+                AddCodeLine ("sbc #$%02X", (unsigned char) val);
+                g_defcodelabel (SkipLabel);
+            } else {
+                AddCodeLine ("lda #$00");
+                AddCodeLine ("rol a");
+            }
+        }
+        return;
+    }
 
-            case CF_LONG:
-                break;
+    /* Setup. The dividend goes into tmp1/tmp2, the remainder into A/tmp3.
+    ** For a divisor with more than eight bits, the quotient has only eight
+    ** bits, and the high byte of the dividend is the initial remainder.
+    */
+    AddCodeLine ("sta tmp1");
+    if (val > 0xFF) {
+        AddCodeLine ("lda #$00");
+        AddCodeLine ("sta tmp3");
+        AddCodeLine ("txa");
+        Count = 8;
+        Lead  = Bits - 9;
+    } else {
+        if (Wide) {
+            AddCodeLine ("stx tmp2");
+        }
+        AddCodeLine ("lda #$00");
+        Count = Wide? 16 : 8;
+        Lead  = Bits - 1;
+    }
 
-            default:
-                typeerror (flags);
+    if (Variant == UDIV_LOOP) {
+        /* No leading shifts, just one iteration in a loop */
+        LoopLabel = GetLocalLabel ();
+        AddCodeLine ("ldx #$%02X", Count);
+        g_defcodelabel (LoopLabel);
+        Count = 1;
+    } else {
+        /* Shift the leading bits into the remainder */
+        for (I = 0; I < Lead; ++I) {
+            AddCodeLine ("asl tmp1");
+            if (val <= 0xFF && Wide) {
+                AddCodeLine ("rol tmp2");
+            }
+            AddCodeLine ("rol a");
+            if (val > 0xFF) {
+                AddCodeLine ("rol tmp3");
+            }
         }
+        Count -= Lead;
+    }
 
-        /* If we go here, we didn't emit code. Push the lhs on stack and fall
-        ** into the normal, non-optimized stuff.
-        */
-        flags &= ~CF_FORCECHAR; /* Handle chars as ints */
-        g_push (flags & ~CF_CONST, 0);
+    /* The iterations that may give a quotient bit */
+    for (I = 0; I < Count; ++I) {
+        SkipLabel = GetLocalLabel ();
+        AddCodeLine ("asl tmp1");
+        if (val > 0xFF) {
+            /* 16 bit remainder, low byte is kept in Y while comparing */
+            AddCodeLine ("rol a");
+            AddCodeLine ("rol tmp3");
+            AddCodeLine ("tay");
+            AddCodeLine ("cmp #$%02X", (unsigned char) val);
+            AddCodeLine ("lda tmp3");
+            AddCodeLine ("sbc #$%02X", (unsigned char) (val >> 8));
+            AddCodeLine ("bcc %s", LocalLabelName (SkipLabel));
+            AddCodeLine ("sta tmp3");
+            AddCodeLine ("tya");
+            AddCodeLine ("sbc #$%02X", (unsigned char) val);
+            AddCodeLine ("tay");
+            AddCodeLine ("inc tmp1");
+            g_defcodelabel (SkipLabel);
+            AddCodeLine ("tya");
+        } else {
+            if (Wide) {
+                AddCodeLine ("rol tmp2");
+            }
+            AddCodeLine ("rol a");
+            if (val >= 0x80) {
+                /* The remainder may overflow into the carry */
+                SubLabel = GetLocalLabel ();
+                AddCodeLine ("bcs %s", LocalLabelName (SubLabel));
+                AddCodeLine ("cmp #$%02X", (unsigned char) val);
+                AddCodeLine ("bcc %s", LocalLabelName (SkipLabel));
+                g_defcodelabel (SubLabel);
+            } else {
+                AddCodeLine ("cmp #$%02X", (unsigned char) val);
+                AddCodeLine ("bcc %s", LocalLabelName (SkipLabel));
+            }
+            AddCodeLine ("sbc #$%02X", (unsigned char) val);
+            AddCodeLine ("inc tmp1");
+            g_defcodelabel (SkipLabel);
+        }
+    }
 
+    if (Variant == UDIV_LOOP) {
+        AddCodeLine ("dex");
+        AddCodeLine ("bne %s", LocalLabelName (LoopLabel));
     }
 
-    /* Use long way over the stack */
-    oper (flags, val, ops);
+    /* Load the result. X is zero for an unsigned char operand that isn't
+    ** forced to char and after the loop.
+    */
+    if (Mod) {
+        if (val > 0xFF) {
+            AddCodeLine ("ldx tmp3");
+        } else if (Wide && Variant != UDIV_LOOP) {
+            AddCodeLine ("ldx #$00");
+        }
+    } else {
+        AddCodeLine ("lda tmp1");
+        if (val > 0xFF) {
+            AddCodeLine ("ldx #$00");
+        } else if (Wide) {
+            AddCodeLine ("ldx tmp2");
+        }
+    }
 }
 
 
@@ -2846,6 +4524,7 @@ void g_div (unsigned flags, unsigned long val)
         int           Negation   = (flags & CF_UNSIGNED) == 0 && (long)val < 0;
         unsigned long NegatedVal = 0UL - val;
         int           p2         = PowerOf2 (Negation ? NegatedVal : val);
+        unsigned      Variant;
 
         /* Generate a shift instead */
         if ((flags & CF_UNSIGNED) != 0 && p2 > 0) {
@@ -2853,6 +4532,13 @@ void g_div (unsigned flags, unsigned long val)
             return;
         }
 
+        /* Check if inline code should be used for other unsigned divisors */
+        Variant = UDivVariant (flags, val, 0);
+        if (Variant != UDIV_CALL) {
+            g_udivconst (flags, val, 0, Variant);
+            return;
+        }
+
         /* Check if we can afford using shift instead of multiplication at the
         ** cost of code size */
         if (p2 == 0 || (p2 > 0 && IS_Get (&CodeSizeFactor) >= (Negation ? 200 : 170))) {
@@ -2950,11 +4636,15 @@ void g_mod (unsigned flags, unsigned long val)
         "tosmodax", "tosumodax", "tosmodeax", "tosumodeax"
     };
     int p2;
+    unsigned Variant;
 
     /* Check if we can do some cost reduction */
     if ((flags & CF_CONST) && (flags & CF_UNSIGNED) && val != 0xFFFFFFFF && (p2 = PowerOf2 (val)) >= 0) {
         /* We can do that with an AND operation */
         g_and (flags, val - 1);
+    } else if ((Variant = UDivVariant (flags, val, 1)) != UDIV_CALL) {
+        /* Use inline code */
+        g_udivconst (flags, val, 1, Variant);
     } else {
         /* Do it the hard way... */
         if (flags & CF_CONST) {
@@ -2975,6 +4665,8 @@ void g_or (unsigned flags, unsigned long val)
         "tosorax", "tosorax", "tosoreax", "tosoreax"
     };
 
+    LongArg Arg;
+
     /* If the right hand side is const, the lhs is not on stack but still
     ** in the primary register.
     */
@@ -3018,6 +4710,10 @@ void g_or (unsigned flags, unsigned long val)
                     }
                     return;
                 }
+                LongArgConst (&Arg, val);
+                if (LongTryBitOp (&Arg, "ora", 0x00, 0xFF, "tosoreax")) {
+                    return;
+                }
                 break;
 
             default:
@@ -3045,6 +4741,8 @@ void g_xor (unsigned flags, unsigned long val)
         "tosxorax", "tosxorax", "tosxoreax", "tosxoreax"
     };
 
+    LongArg Arg;
+
 
     /* If the right hand side is const, the lhs is not on stack but still
     ** in the primary register.
@@ -3086,6 +4784,10 @@ void g_xor (unsigned flags, unsigned long val)
                     }
                     return;
                 }
+                LongArgConst (&Arg, val);
+                if (LongTryBitOp (&Arg, "eor", 0x00, -1, "tosxoreax")) {
+                    return;
+                }
                 break;
 
             default:
@@ -3113,6 +4815,8 @@ void g_and (unsigned Flags, unsigned long Val)
         "tosandax", "tosandax", "tosandeax", "tosandeax"
     };
 
+    LongArg Arg;
+
     /* If the right hand side is const, the lhs is not on stack but still
     ** in the primary register.
     */
@@ -3178,6 +4882,10 @@ void g_and (unsigned Flags, unsigned long Val)
                     AddCodeLine ("sta sreg");
                     return;
                 }
+                LongArgConst (&Arg, Val);
+                if (LongTryBitOp (&Arg, "and", 0xFF, 0x00, "tosandeax")) {
+                    return;
+                }
                 break;
 
             default:
@@ -3345,6 +5053,11 @@ void g_asr (unsigned flags, unsigned long val)
                     AddCodeLine ("sty sreg+1");
                     val -= 8;
                 }
+                if (val > 0 &&
+                    LongTryShift (val, 1, (flags & CF_UNSIGNED) == 0,
+                                  (flags & CF_UNSIGNED)? "shreax" : "asreax")) {
+                    return;
+                }
                 if (val >= 4) {
                     if (flags & CF_UNSIGNED) {
                         AddCodeLine ("%s shreax4", CrtJsrOrJsl());
@@ -3469,6 +5182,11 @@ void g_asl (unsigned flags, unsigned long val)
                     AddCodeLine ("lda #$00");
                     val -= 8;
                 }
+                if (val > 0 &&
+                    LongTryShift (val, 0, 0,
+                                  (flags & CF_UNSIGNED)? "shleax" : "asleax")) {
+                    return;
+                }
                 if (val > 4) {
                     if (flags & CF_UNSIGNED) {
                         AddCodeLine ("%s shleax4", CrtJsrOrJsl());
@@ -3668,8 +5386,18 @@ void g_inc (unsigned flags, unsigned long val)
 
         case CF_LONG:
             if (val <= 255) {
-                AddCodeLine ("ldy #$%02X", (unsigned char) val);
-                AddCodeLine ("%s inceaxy", CrtJsrOrJsl());
+                LongCost Inline = { 0, 0 };
+                LongCost Call   = { 5, 2 };
+                LongArg  Arg;
+                LongArgConst (&Arg, val);
+                LongAddSub (&Inline, &Arg, 0);
+                Call.Cycles += GetFuncCycles ("inceaxy");
+                if (LongInline (&Inline, &Call)) {
+                    LongAddSub (0, &Arg, 0);
+                } else {
+                    AddCodeLine ("ldy #$%02X", (unsigned char) val);
+                    AddCodeLine ("%s inceaxy", CrtJsrOrJsl());
+                }
             } else {
                 g_add (flags | CF_CONST, val);
             }
@@ -3760,8 +5488,18 @@ void g_dec (unsigned flags, unsigned long val)
 
         case CF_LONG:
             if (val <= 255) {
-                AddCodeLine ("ldy #$%02X", (unsigned char) val);
-                AddCodeLine ("%s deceaxy", CrtJsrOrJsl());
+                LongCost Inline = { 0, 0 };
+                LongCost Call   = { 5, 2 };
+                LongArg  Arg;
+                LongArgConst (&Arg, val);
+                LongAddSub (&Inline, &Arg, 1);
+                Call.Cycles += GetFuncCycles ("deceaxy");
+                if (LongInline (&Inline, &Call)) {
+                    LongAddSub (0, &Arg, 1);
+                } else {
+                    AddCodeLine ("ldy #$%02X", (unsigned char) val);
+                    AddCodeLine ("%s deceaxy", CrtJsrOrJsl());
+                }
             } else {
                 g_sub (flags | CF_CONST, val);
             }
@@ -3791,6 +5529,7 @@ void g_eq (unsigned flags, unsigned long val)
     };
 
     unsigned L;
+    LongArg  Arg;
 
     /* If the right hand side is const, the lhs is not on stack but still
     ** in the primary register.
@@ -3817,6 +5556,10 @@ void g_eq (unsigned flags, unsigned long val)
                 return;
 
             case CF_LONG:
+                LongArgConst (&Arg, val);
+                if (LongTryCmpEq (&Arg, "booleq", "toseqeax")) {
+                    return;
+                }
                 break;
 
             default:
@@ -3845,6 +5588,7 @@ void g_ne (unsigned flags, unsigned long val)
     };
 
     unsigned L;
+    LongArg  Arg;
 
     /* If the right hand side is const, the lhs is not on stack but still
     ** in the primary register.
@@ -3871,6 +5615,10 @@ void g_ne (unsigned flags, unsigned long val)
                 return;
 
             case CF_LONG:
+                LongArgConst (&Arg, val);
+                if (LongTryCmpEq (&Arg, "boolne", "tosneeax")) {
+                    return;
+                }
                 break;
 
             default:
@@ -3899,6 +5647,7 @@ void g_lt (unsigned flags, unsigned long val)
     };
 
     unsigned Label;
+    LongArg  Arg;
 
     /* If the right hand side is const, the lhs is not on stack but still
     ** in the primary register.
@@ -4030,7 +5779,11 @@ void g_lt (unsigned flags, unsigned long val)
                     return;
 
                 case CF_LONG:
-                    /* This one is too costly */
+                    /* The inline code is larger than the call */
+                    LongArgConst (&Arg, val);
+                    if (LongTryCmpSigned (&Arg, 0, "toslteax")) {
+                        return;
+                    }
                     break;
 
                 default:
@@ -4315,6 +6068,7 @@ void g_ge (unsigned flags, unsigned long val)
     };
 
     unsigned Label;
+    LongArg  Arg;
 
 
     /* If the right hand side is const, the lhs is not on stack but still
@@ -4443,7 +6197,11 @@ void g_ge (unsigned flags, unsigned long val)
                     return;
 
                 case CF_LONG:
-                    /* This one is too costly */
+                    /* The inline code is larger than the call */
+                    LongArgConst (&Arg, val);
+                    if (LongTryCmpSigned (&Arg, 1, "tosgeeax")) {
+                        return;
+                    }
                     break;
 
                 default:
@@ -4923,6 +6681,326 @@ void g_extractbitfield (unsigned Flags, unsigned FullWidthFlags, int IsSigned,
 
 
 
+/* Code for the last level of a switch, where the selector byte is in A, is
+** generated with one of three strategies: A cascade of compares, a binary
+** search, or a jump table. A simple cost model (code size and the sum of the
+** cycles needed to reach each of the cases) decides which one is used. The
+** fastest strategy is used unless its code size exceeds the size of the
+** smallest one by more than CodeSizeFactor allows. If a cycle weight is set,
+** the strategy with the lowest weighted cost is used instead.
+*/
+typedef struct SwitchCost SwitchCost;
+struct SwitchCost {
+    unsigned long Size;                 /* Code size in bytes */
+    unsigned long Cycles;               /* Sum of cycles over all cases */
+};
+
+/* Binary search is used down to this number of nodes, below that, a compare
+** cascade is used.
+*/
+#define SWITCH_BSEARCH_MIN      5U
+
+/* Jump tables are not used for less than this number of nodes */
+#define SWITCH_TABLE_MIN        4U
+
+
+
+static void SwitchCascadeCost (unsigned Count, SwitchCost* C)
+/* Calculate the cost of a compare cascade with Count nodes */
+{
+    /* cmp/beq per node, jmp to the default label */
+    C->Size   = 4UL * Count + 3UL;
+    C->Cycles = 2UL * Count * Count + 3UL * Count;
+}
+
+
+
+static void SwitchBSearchCost (unsigned Count, SwitchCost* C)
+/* Calculate the cost of a binary search over Count nodes */
+{
+    if (Count < SWITCH_BSEARCH_MIN) {
+        SwitchCascadeCost (Count, C);
+    } else {
+        SwitchCost Lower, Upper;
+        unsigned LowerCount = Count / 2;
+        unsigned UpperCount = Count - LowerCount - 1;
+        SwitchBSearchCost (LowerCount, &Lower);
+        SwitchBSearchCost (UpperCount, &Upper);
+
+        /* cmp/beq/bcs, the middle node is found after 5 cycles */
+        C->Size   = 6UL + Lower.Size + Upper.Size;
+        C->Cycles = 5UL + Lower.Cycles + 6UL * LowerCount +
+                    Upper.Cycles + 7UL * UpperCount;
+    }
+}
+
+
+
+static int SwitchTableIsShort (unsigned Range)
+/* Return true if a jump table for Range values may use jmp (abs,x) */
+{
+    return (CPUIsets[CPU] & CPU_ISET_65SC02) != 0 && Range <= 128;
+}
+
+
+
+static void SwitchTableCost (unsigned Count, unsigned char Low, unsigned Range,
+                             SwitchCost* C)
+/* Calculate the cost of a jump table with Count nodes for Range values
+** starting at Low.
+*/
+{
+    unsigned long Cycles;
+
+    /* Table and range check */
+    C->Size = 2UL * Range;
+    Cycles  = 0;
+    if (Low != 0) {
+        /* sec/sbc */
+        C->Size += 3;
+        Cycles  += 4;
+    }
+    if (Range < 256) {
+        /* cmp/bcs */
+        C->Size += 4;
+        Cycles  += 4;
+    }
+    if (SwitchTableIsShort (Range)) {
+        /* asl/tax/jmp (abs,x) */
+        C->Size += 5;
+        Cycles  += 10;
+    } else {
+        /* tay/lda/ldx/jmp callax plus the code in callax */
+        C->Size += 10;
+        Cycles  += 24;
+    }
+    C->Cycles = Cycles * Count;
+}
+
+
+
+static void SwitchCascade (Collection* Nodes, unsigned First, unsigned Count,
+                           unsigned DefaultLabel)
+/* Generate a compare cascade for Count nodes starting at First */
+{
+    while (Count--) {
+        const CaseNode* N = CollAtUnchecked (Nodes, First++);
+        AddCodeLine ("cmp #$%02X", CN_GetValue (N));
+        g_falsejump (0, CN_GetLabel (N));
+    }
+    g_jump (DefaultLabel);
+}
+
+
+
+static void SwitchBSearch (Collection* Nodes, unsigned First, unsigned Count,
+                           unsigned DefaultLabel)
+/* Generate a binary search over Count nodes starting at First */
+{
+    if (Count < SWITCH_BSEARCH_MIN) {
+        SwitchCascade (Nodes, First, Count, DefaultLabel);
+    } else {
+        unsigned LowerCount = Count / 2;
+        unsigned UpperLabel = GetLocalLabel ();
+        const CaseNode* N = CollAtUnchecked (Nodes, First + LowerCount);
+
+        /* Check the middle node, then search the lower or upper half */
+        AddCodeLine ("cmp #$%02X", CN_GetValue (N));
+        g_falsejump (0, CN_GetLabel (N));
+        AddCodeLine ("jcs %s", LocalLabelName (UpperLabel));
+        SwitchBSearch (Nodes, First, LowerCount, DefaultLabel);
+        g_defcodelabel (UpperLabel);
+        SwitchBSearch (Nodes, First + LowerCount + 1, Count - LowerCount - 1,
+                       DefaultLabel);
+    }
+}
+
+
+
+static void SwitchTableEntries (const char* Directive, const unsigned* Labels,
+                                unsigned Count)
+/* Output the labels of a jump table with the given data directive */
+{
+    StrBuf   Line = AUTO_STRBUF_INITIALIZER;
+    unsigned I;
+
+    for (I = 0; I < Count; ++I) {
+        if (I % 8 == 0) {
+            if (I > 0) {
+                SB_Terminate (&Line);
+                AddDataLine ("%s", SB_GetConstBuf (&Line));
+            }
+            SB_Printf (&Line, "\t%s\t%s", Directive, LocalLabelName (Labels[I]));
+        } else {
+            SB_AppendStr (&Line, ",");
+            SB_AppendStr (&Line, LocalLabelName (Labels[I]));
+        }
+    }
+    SB_Terminate (&Line);
+    AddDataLine ("%s", SB_GetConstBuf (&Line));
+    SB_Done (&Line);
+}
+
+
+
+static void SwitchTable (Collection* Nodes, unsigned DefaultLabel)
+/* Generate a jump table for the nodes */
+{
+    unsigned char Low   = CN_GetValue ((const CaseNode*) CollAtUnchecked (Nodes, 0));
+    unsigned char High  = CN_GetValue ((const CaseNode*) CollLast (Nodes));
+    unsigned      Range = High - Low + 1;
+    unsigned      Table = GetLocalDataLabel ();
+    segment_t     OldSeg;
+    unsigned*     Labels;
+    unsigned      I, J;
+
+    /* Collect the label names, values without a case go to the default
+    ** label. All these labels may be reached by an indirect jump.
+    */
+    Labels = xmalloc (Range * sizeof (Labels[0]));
+    for (I = 0, J = 0; I < Range; ++I) {
+        const CaseNode* N = CollAtUnchecked (Nodes, J);
+        if (CN_GetValue (N) == Low + I) {
+            Labels[I] = CN_GetLabel (N);
+            ++J;
+        } else {
+            Labels[I] = DefaultLabel;
+        }
+        CS_SetIndirectLabel (CS->Code, LocalLabelName (Labels[I]));
+    }
+
+    /* Range check */
+    if (Low != 0) {
+        AddCodeLine ("sec");
+        AddCodeLine ("sbc #$%02X", Low);
+    }
+    if (Range < 256) {
+        AddCodeLine ("cmp #$%02X", Range);
+        AddCodeLine ("jcs %s", LocalLabelName (DefaultLabel));
+    }
+
+    /* Dispatch */
+    if (SwitchTableIsShort (Range)) {
+        AddCodeLine ("asl a");
+        AddCodeLine ("tax");
+        AddCodeLine ("jmp (.loword(%s),x)", LocalDataLabelName (Table));
+    } else {
+        AddCodeLine ("tay");
+        AddCodeLine ("lda %s,y", LocalDataLabelName (Table));
+        AddCodeLine ("ldx %s+%u,y", LocalDataLabelName (Table), Range);
+        AddCodeLine ("jmp callax");
+    }
+
+    /* Output the table */
+    OldSeg = CS->CurDSeg;
+    g_userodata ();
+    g_defdatalabel (Table);
+    if (SwitchTableIsShort (Range)) {
+        SwitchTableEntries (".addr", Labels, Range);
+    } else {
+        SwitchTableEntries (".lobytes", Labels, Range);
+        SwitchTableEntries (".hibytes", Labels, Range);
+    }
+    UseDataSeg (OldSeg);
+
+    xfree (Labels);
+}
+
+
+
+static unsigned long SwitchWeightedCost (const SwitchCost* C, unsigned Count,
+                                         unsigned Weight)
+/* Return the cost of a strategy for Count nodes with the given cycle weight */
+{
+    return GetCodeCost (C->Size, C->Cycles / Count, Weight);
+}
+
+
+
+static void SwitchLastLevel (Collection* Nodes, unsigned DefaultLabel)
+/* Generate code for the last level of a switch, the selector byte is in A */
+{
+    unsigned      Count = CollCount (Nodes);
+    unsigned char Low   = CN_GetValue ((const CaseNode*) CollAtUnchecked (Nodes, 0));
+    unsigned char High  = CN_GetValue ((const CaseNode*) CollLast (Nodes));
+    SwitchCost    Cascade, BSearch, Table;
+    const SwitchCost* Best;
+    unsigned long MinSize;
+    unsigned long MaxSize;
+    unsigned      Weight;
+
+    /* Calculate the costs. A strategy that is not applicable gets the cost
+    ** of the cascade, which makes sure it isn't used.
+    */
+    SwitchCascadeCost (Count, &Cascade);
+    SwitchBSearchCost (Count, &BSearch);
+    if (Count >= SWITCH_TABLE_MIN) {
+        SwitchTableCost (Count, Low, High - Low + 1, &Table);
+    } else {
+        Table = Cascade;
+    }
+
+    /* With a cycle weight, use the strategy with the lowest weighted cost,
+    ** based on the average cycles per case.
+    */
+    Weight = (unsigned) IS_Get (&CycleWeight);
+    if (Weight > 0) {
+        Best = &Cascade;
+        if (SwitchWeightedCost (&BSearch, Count, Weight) <
+            SwitchWeightedCost (Best, Count, Weight)) {
+            Best = &BSearch;
+        }
+        if (SwitchWeightedCost (&Table, Count, Weight) <
+            SwitchWeightedCost (Best, Count, Weight)) {
+            Best = &Table;
+        }
+    } else {
+        /* Determine the allowed code size */
+        MinSize = Cascade.Size;
+        if (BSearch.Size < MinSize) {
+            MinSize = BSearch.Size;
+        }
+        if (Table.Size < MinSize) {
+            MinSize = Table.Size;
+        }
+        MaxSize = MinSize * IS_Get (&CodeSizeFactor) / 100;
+        if (MaxSize < MinSize) {
+            /* A code size factor below 100 asks for the smallest code */
+            MaxSize = MinSize;
+        }
+
+        /* Use the fastest strategy within the size limit. Since the limit
+        ** is at least the size of the smallest one, we will always find one.
+        */
+        Best = 0;
+        if (Cascade.Size <= MaxSize) {
+            Best = &Cascade;
+        }
+        if (BSearch.Size <= MaxSize &&
+            (Best == 0 || BSearch.Cycles < Best->Cycles ||
+             (BSearch.Cycles == Best->Cycles && BSearch.Size < Best->Size))) {
+            Best = &BSearch;
+        }
+        if (Table.Size <= MaxSize &&
+            (Best == 0 || Table.Cycles < Best->Cycles ||
+             (Table.Cycles == Best->Cycles && Table.Size < Best->Size))) {
+            Best = &Table;
+        }
+    }
+    CHECK (Best != 0);
+
+    /* Generate the code */
+    if (Best == &Table) {
+        SwitchTable (Nodes, DefaultLabel);
+    } else if (Best == &BSearch) {
+        SwitchBSearch (Nodes, 0, Count, DefaultLabel);
+    } else {
+        SwitchCascade (Nodes, 0, Count, DefaultLabel);
+    }
+}
+
+
+
 void g_switch (Collection* Nodes, unsigned DefaultLabel, unsigned Depth)
 /* Generate code for a switch statement */
 {
@@ -4933,8 +7011,13 @@ void g_switch (Collection* Nodes, unsigned DefaultLabel, unsigned Depth)
     const char* Compare;
     switch (Depth) {
         case 1:
-            Compare = "cmp #$%02X";
-            break;
+            /* The last level has its own strategies */
+            if (CollCount (Nodes) > 0) {
+                SwitchLastLevel (Nodes, DefaultLabel);
+            } else {
+                g_jump (DefaultLabel);
+            }
+            return;
         case 2:
             Compare = "cpx #$%02X";
             break;
@@ -4965,28 +7048,18 @@ void g_switch (Collection* Nodes, unsigned DefaultLabel, unsigned Depth)
         /* Do the compare */
         AddCodeLine (Compare, CN_GetValue (N));
 
-        /* If this is the last level, jump directly to the case code if found */
-        if (Depth == 1) {
-
-            /* Branch if equal */
-            g_falsejump (0, CN_GetLabel (N));
-
+        /* Determine the next label */
+        if (I == CollCount (Nodes) - 1) {
+            /* Last node means not found */
+            g_truejump (0, DefaultLabel);
         } else {
-
-            /* Determine the next label */
-            if (I == CollCount (Nodes) - 1) {
-                /* Last node means not found */
-                g_truejump (0, DefaultLabel);
-            } else {
-                /* Jump to the next check */
-                NextLabel = GetLocalLabel ();
-                g_truejump (0, NextLabel);
-            }
-
-            /* Check the next level */
-            g_switch (N->Nodes, DefaultLabel, Depth-1);
-
+            /* Jump to the next check */
+            NextLabel = GetLocalLabel ();
+            g_truejump (0, NextLabel);
         }
+
+        /* Check the next level */
+        g_switch (N->Nodes, DefaultLabel, Depth-1);
     }
 
     /* If we go here, we haven't found the label */
@@ -330,6 +330,21 @@ void g_addlocal (unsigned flags, int offs);
 void g_addstatic (unsigned flags, uintptr_t label, long offs);
 /* Add a static variable to ax */
 
+void g_sublocal (unsigned flags, int offs);
+/* Subtract a local variable from ax */
+
+void g_substatic (unsigned flags, uintptr_t label, long offs);
+/* Subtract a static variable from ax */
+
+void g_andstatic (unsigned flags, uintptr_t label, long offs);
+/* And eax with a static variable. Only longs are supported. */
+
+void g_orstatic (unsigned flags, uintptr_t label, long offs);
+/* Or eax with a static variable. Only longs are supported. */
+
+void g_xorstatic (unsigned flags, uintptr_t label, long offs);
+/* Exclusive or eax with a static variable. Only longs are supported. */
+
 
 
 /*****************************************************************************/
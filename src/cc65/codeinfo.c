@@ -43,6 +43,7 @@
 
 /* cc65 */
 #include "codeent.h"
+#include "codepool.h"
 #include "codeseg.h"
 #include "datatype.h"
 #include "error.h"
@@ -80,6 +81,7 @@ struct FuncInfo {
     const char*     Name;       /* Function name */
     unsigned        Use;        /* Register usage */
     unsigned        Chg;        /* Changed/destroyed registers */
+    unsigned        Cycles;     /* Typical cycles of a call */
 };
 
 /* Functions that change the SP are regarded as using the SP as well.
@@ -89,293 +91,297 @@ struct FuncInfo {
 ** Note for the shift functions: Shifts are done modulo 32, so all shift
 ** routines are marked to use only the A register. The remainder is ignored
 ** anyway.
+** The cycles include the jsr and the rts. They were measured with sim65 on a
+** 6502 with typical arguments (a shift count of 3, 16 bit operands in the
+** $1000 range), so they are estimates only.
 */
 static const FuncInfo FuncInfoTable[] = {
-    { "addeq0sp",   SLV_TOP | REG_AX,   PSTATE_ALL | REG_AXY                        },
-    { "addeqysp",   SLV_IND | REG_AXY,  PSTATE_ALL | REG_AXY                        },
-    { "addysp",     REG_SP | REG_Y,     PSTATE_ALL | REG_SP                         },
-    { "along",      REG_A,              PSTATE_ALL | REG_X | REG_SREG               },
-    { "aslax1",     REG_AX,             PSTATE_ALL | REG_AX | REG_TMP1              },
-    { "aslax2",     REG_AX,             PSTATE_ALL | REG_AX | REG_TMP1              },
-    { "aslax3",     REG_AX,             PSTATE_ALL | REG_AX | REG_TMP1              },
-    { "aslax4",     REG_AX,             PSTATE_ALL | REG_AX | REG_TMP1              },
-    { "aslax7",     REG_AX,             PSTATE_ALL | REG_AXY                        },
-    { "aslaxy",     REG_AXY,            PSTATE_ALL | REG_AXY | REG_TMP1             },
-    { "asleax1",    REG_EAX,            PSTATE_ALL | REG_EAX | REG_TMP1             },
-    { "asleax2",    REG_EAX,            PSTATE_ALL | REG_EAX | REG_TMP1             },
-    { "asleax3",    REG_EAX,            PSTATE_ALL | REG_EAX | REG_TMP1             },
-    { "asleax4",    REG_EAX,            PSTATE_ALL | REG_EAXY | REG_TMP1            },
-    { "asrax1",     REG_AX,             PSTATE_ALL | REG_AX | REG_TMP1              },
-    { "asrax2",     REG_AX,             PSTATE_ALL | REG_AX | REG_TMP1              },
-    { "asrax3",     REG_AX,             PSTATE_ALL | REG_AX | REG_TMP1              },
-    { "asrax4",     REG_AX,             PSTATE_ALL | REG_AX | REG_TMP1              },
-    { "asrax7",     REG_AX,             PSTATE_ALL | REG_AX                         },
-    { "asraxy",     REG_AXY,            PSTATE_ALL | REG_AXY | REG_TMP1             },
-    { "asreax1",    REG_EAX,            PSTATE_ALL | REG_EAX | REG_TMP1             },
-    { "asreax2",    REG_EAX,            PSTATE_ALL | REG_EAX | REG_TMP1             },
-    { "asreax3",    REG_EAX,            PSTATE_ALL | REG_EAX | REG_TMP1             },
-    { "asreax4",    REG_EAX,            PSTATE_ALL | REG_EAXY | REG_TMP1            },
-    { "aulong",     REG_NONE,           PSTATE_ALL | REG_X | REG_SREG               },
-    { "axlong",     REG_X,              PSTATE_ALL | REG_Y | REG_SREG               },
-    { "axulong",    REG_NONE,           PSTATE_ALL | REG_Y | REG_SREG               },
-    { "bcasta",     REG_A,              PSTATE_ALL | REG_AX                         },
-    { "bcastax",    REG_AX,             PSTATE_ALL | REG_AX                         },
-    { "bcasteax",   REG_EAX,            PSTATE_ALL | REG_EAX | REG_TMP1             },
-    { "bnega",      REG_A,              PSTATE_ALL | REG_AX                         },
-    { "bnegax",     REG_AX,             PSTATE_ALL | REG_AX                         },
-    { "bnegeax",    REG_EAX,            PSTATE_ALL | REG_EAX | REG_TMP1             },
-    { "booleq",     PSTATE_Z,           PSTATE_ALL | REG_AX                         },
-    { "boolge",     PSTATE_N,           PSTATE_ALL | REG_AX                         },
-    { "boolgt",     PSTATE_ZN,          PSTATE_ALL | REG_AX                         },
-    { "boolle",     PSTATE_ZN,          PSTATE_ALL | REG_AX                         },
-    { "boollt",     PSTATE_N,           PSTATE_ALL | REG_AX                         },
-    { "boolne",     PSTATE_Z,           PSTATE_ALL | REG_AX                         },
-    { "booluge",    PSTATE_C,           PSTATE_ALL | REG_AX                         },
-    { "boolugt",    PSTATE_CZ,          PSTATE_ALL | REG_AX                         },
-    { "boolule",    PSTATE_CZ,          PSTATE_ALL | REG_AX                         },
-    { "boolult",    PSTATE_C,           PSTATE_ALL | REG_AX                         },
-    { "callax",     REG_AX,             PSTATE_ALL | REG_ALL                        }, /* PSTATE_ZN | REG_PTR1 */
-    { "complax",    REG_AX,             PSTATE_ALL | REG_AX                         },
-    { "decax1",     REG_AX,             PSTATE_ALL | REG_AX                         },
-    { "decax2",     REG_AX,             PSTATE_ALL | REG_AX                         },
-    { "decax3",     REG_AX,             PSTATE_ALL | REG_AX                         },
-    { "decax4",     REG_AX,             PSTATE_ALL | REG_AX                         },
-    { "decax5",     REG_AX,             PSTATE_ALL | REG_AX                         },
-    { "decax6",     REG_AX,             PSTATE_ALL | REG_AX                         },
-    { "decax7",     REG_AX,             PSTATE_ALL | REG_AX                         },
-    { "decax8",     REG_AX,             PSTATE_ALL | REG_AX                         },
-    { "decaxy",     REG_AXY,            PSTATE_ALL | REG_AX | REG_TMP1              },
-    { "deceaxy",    REG_EAXY,           PSTATE_ALL | REG_EAX                        },
-    { "decsp1",     REG_SP,             PSTATE_ALL | REG_SP | REG_Y                 },
-    { "decsp2",     REG_SP,             PSTATE_ALL | REG_SP | REG_A                 },
-    { "decsp3",     REG_SP,             PSTATE_ALL | REG_SP | REG_A                 },
-    { "decsp4",     REG_SP,             PSTATE_ALL | REG_SP | REG_A                 },
-    { "decsp5",     REG_SP,             PSTATE_ALL | REG_SP | REG_A                 },
-    { "decsp6",     REG_SP,             PSTATE_ALL | REG_SP | REG_A                 },
-    { "decsp7",     REG_SP,             PSTATE_ALL | REG_SP | REG_A                 },
-    { "decsp8",     REG_SP,             PSTATE_ALL | REG_SP | REG_A                 },
-    { "enter",      REG_SP | REG_Y,     PSTATE_ALL | REG_SP | REG_AY                },
-    { "incax1",     REG_AX,             PSTATE_ALL | REG_AX                         },
-    { "incax2",     REG_AX,             PSTATE_ALL | REG_AX                         },
-    { "incax3",     REG_AX,             PSTATE_ALL | REG_AXY | REG_TMP1             },
-    { "incax4",     REG_AX,             PSTATE_ALL | REG_AXY | REG_TMP1             },
-    { "incax5",     REG_AX,             PSTATE_ALL | REG_AXY | REG_TMP1             },
-    { "incax6",     REG_AX,             PSTATE_ALL | REG_AXY | REG_TMP1             },
-    { "incax7",     REG_AX,             PSTATE_ALL | REG_AXY | REG_TMP1             },
-    { "incax8",     REG_AX,             PSTATE_ALL | REG_AXY | REG_TMP1             },
-    { "incaxy",     REG_AXY,            PSTATE_ALL | REG_AXY | REG_TMP1             },
-    { "incsp1",     REG_SP,             PSTATE_ALL | REG_SP                         },
-    { "incsp2",     REG_SP,             PSTATE_ALL | REG_SP | REG_Y                 },
-    { "incsp3",     REG_SP,             PSTATE_ALL | REG_SP | REG_Y                 },
-    { "incsp4",     REG_SP,             PSTATE_ALL | REG_SP | REG_Y                 },
-    { "incsp5",     REG_SP,             PSTATE_ALL | REG_SP | REG_Y                 },
-    { "incsp6",     REG_SP,             PSTATE_ALL | REG_SP | REG_Y                 },
-    { "incsp7",     REG_SP,             PSTATE_ALL | REG_SP | REG_Y                 },
-    { "incsp8",     REG_SP,             PSTATE_ALL | REG_SP | REG_Y                 },
-    { "jmpvec",     REG_EVERYTHING,         PSTATE_ALL | REG_ALL                    }, /* NONE */
-    { "laddeq",     REG_EAXY | REG_PTR1_LO, PSTATE_ALL | REG_EAXY | REG_PTR1_HI     },
-    { "laddeq0sp",  SLV_TOP | REG_EAX,      PSTATE_ALL | REG_EAXY                   },
-    { "laddeq1",    REG_Y | REG_PTR1_LO,    PSTATE_ALL | REG_EAXY | REG_PTR1_HI     },
-    { "laddeqa",    REG_AY | REG_PTR1_LO,   PSTATE_ALL | REG_EAXY | REG_PTR1_HI     },
-    { "laddeqysp",  SLV_IND | REG_EAXY,     PSTATE_ALL | REG_EAXY                   },
-    { "ldaidx",     REG_AXY,                PSTATE_ALL | REG_AX | REG_PTR1          },
-    { "ldauidx",    REG_AXY,                PSTATE_ALL | REG_AX | REG_PTR1          },
-    { "ldax0sp",    SLV_TOP,                PSTATE_ALL | REG_AXY                    },
-    { "ldaxi",      REG_AX,                 PSTATE_ALL | REG_AXY | REG_PTR1         },
-    { "ldaxidx",    REG_AXY,                PSTATE_ALL | REG_AXY | REG_PTR1         },
-    { "ldaxysp",    SLV_IND | REG_Y,        PSTATE_ALL | REG_AXY                    },
-    { "ldeax0sp",   SLV_TOP,                PSTATE_ALL | REG_EAXY                   },
-    { "ldeaxi",     REG_AX,                 PSTATE_ALL | REG_EAXY | REG_PTR1        },
-    { "ldeaxidx",   REG_AXY,                PSTATE_ALL | REG_EAXY | REG_PTR1        },
-    { "ldeaxysp",   SLV_IND | REG_Y,        PSTATE_ALL | REG_EAXY                   },
-    { "leaa0sp",    REG_SP | REG_A,         PSTATE_ALL | REG_AX                     },
-    { "leaaxsp",    REG_SP | REG_AX,        PSTATE_ALL | REG_AX                     },
-    { "leave00",    REG_SP,                 PSTATE_ALL | REG_SP | REG_AXY           },
-    { "leave0",     REG_SP,                 PSTATE_ALL | REG_SP | REG_XY            },
-    { "leave",      REG_SP,                 PSTATE_ALL | REG_SP | REG_Y             },
-    { "leavey00",   REG_SP,                 PSTATE_ALL | REG_SP | REG_AXY           },
-    { "leavey0",    REG_SP,                 PSTATE_ALL | REG_SP | REG_XY            },
-    { "leavey",     REG_SP | REG_Y,         PSTATE_ALL | REG_SP | REG_Y             },
-    { "lsubeq",     REG_EAXY | REG_PTR1_LO, PSTATE_ALL | REG_EAXY | REG_PTR1_HI     },
-    { "lsubeq0sp",  SLV_TOP | REG_EAX,      PSTATE_ALL | REG_EAXY                   },
-    { "lsubeq1",    REG_Y | REG_PTR1_LO,    PSTATE_ALL | REG_EAXY | REG_PTR1_HI     },
-    { "lsubeqa",    REG_AY | REG_PTR1_LO,   PSTATE_ALL | REG_EAXY | REG_PTR1_HI     },
-    { "lsubeqysp",  SLV_IND | REG_EAXY,     PSTATE_ALL | REG_EAXY                   },
-    { "mulax10",    REG_AX,             PSTATE_ALL | REG_AX | REG_PTR1              },
-    { "mulax3",     REG_AX,             PSTATE_ALL | REG_AX | REG_PTR1              },
-    { "mulax5",     REG_AX,             PSTATE_ALL | REG_AX | REG_PTR1              },
-    { "mulax6",     REG_AX,             PSTATE_ALL | REG_AX | REG_PTR1              },
-    { "mulax7",     REG_AX,             PSTATE_ALL | REG_AX | REG_PTR1              },
-    { "mulax9",     REG_AX,             PSTATE_ALL | REG_AX | REG_PTR1              },
-    { "negax",      REG_AX,             PSTATE_ALL | REG_AX                         },
-    { "negeax",     REG_EAX,            PSTATE_ALL | REG_EAX                        },
-    { "popa",       SLV_TOP,            PSTATE_ALL | REG_SP | REG_AY                },
-    { "popax",      SLV_TOP,            PSTATE_ALL | REG_SP | REG_AXY               },
-    { "popeax",     SLV_TOP,            PSTATE_ALL | REG_SP | REG_EAXY              },
-    { "push0",      REG_SP,             PSTATE_ALL | REG_SP | REG_AXY               },
-    { "push0ax",    REG_SP | REG_AX,    PSTATE_ALL | REG_SP | REG_Y | REG_SREG      },
-    { "push1",      REG_SP,             PSTATE_ALL | REG_SP | REG_AXY               },
-    { "push2",      REG_SP,             PSTATE_ALL | REG_SP | REG_AXY               },
-    { "push3",      REG_SP,             PSTATE_ALL | REG_SP | REG_AXY               },
-    { "push4",      REG_SP,             PSTATE_ALL | REG_SP | REG_AXY               },
-    { "push5",      REG_SP,             PSTATE_ALL | REG_SP | REG_AXY               },
-    { "push6",      REG_SP,             PSTATE_ALL | REG_SP | REG_AXY               },
-    { "push7",      REG_SP,             PSTATE_ALL | REG_SP | REG_AXY               },
-    { "pusha",      REG_SP | REG_A,     PSTATE_ALL | REG_SP | REG_Y                 },
-    { "pusha0",     REG_SP | REG_A,     PSTATE_ALL | REG_SP | REG_XY                },
-    { "pusha0sp",   SLV_TOP,            PSTATE_ALL | REG_SP | REG_AY                },
-    { "pushaFF",    REG_SP | REG_A,     PSTATE_ALL | REG_SP | REG_Y                 },
-    { "pushax",     REG_SP | REG_AX,    PSTATE_ALL | REG_SP | REG_Y                 },
-    { "pushaysp",   SLV_IND | REG_Y,    PSTATE_ALL | REG_SP | REG_AY                },
-    { "pushc0",     REG_SP,             PSTATE_ALL | REG_SP | REG_A | REG_Y         },
-    { "pushc1",     REG_SP,             PSTATE_ALL | REG_SP | REG_A | REG_Y         },
-    { "pushc2",     REG_SP,             PSTATE_ALL | REG_SP | REG_A | REG_Y         },
-    { "pusheax",    REG_SP | REG_EAX,   PSTATE_ALL | REG_SP | REG_Y                 },
-    { "pushl0",     REG_SP,             PSTATE_ALL | REG_SP | REG_AXY               },
-    { "pushw",      REG_SP | REG_AX,    PSTATE_ALL | REG_SP | REG_AXY | REG_PTR1    },
-    { "pushw0sp",   SLV_TOP,            PSTATE_ALL | REG_SP | REG_AXY               },
-    { "pushwidx",   REG_SP | REG_AXY,   PSTATE_ALL | REG_SP | REG_AXY | REG_PTR1    },
-    { "pushwysp",   SLV_IND | REG_Y,    PSTATE_ALL | REG_SP | REG_AXY               },
-    { "regswap",    REG_AXY,            PSTATE_ALL | REG_AXY | REG_TMP1             },
-    { "regswap1",   REG_XY,             PSTATE_ALL | REG_A                          },
-    { "regswap2",   REG_XY,             PSTATE_ALL | REG_A | REG_Y                  },
-    { "resteax",    REG_SAVE,           PSTATE_ZN  | REG_EAX                        }, /* also uses regsave+2/+3 */
-    { "return0",    REG_NONE,           PSTATE_ALL | REG_AX                         },
-    { "return1",    REG_NONE,           PSTATE_ALL | REG_AX                         },
-    { "saveeax",    REG_EAX,            PSTATE_ZN  | REG_Y | REG_SAVE               }, /* also regsave+2/+3 */
-    { "shlax1",     REG_AX,             PSTATE_ALL | REG_AX | REG_TMP1              },
-    { "shlax2",     REG_AX,             PSTATE_ALL | REG_AX | REG_TMP1              },
-    { "shlax3",     REG_AX,             PSTATE_ALL | REG_AX | REG_TMP1              },
-    { "shlax4",     REG_AX,             PSTATE_ALL | REG_AX | REG_TMP1              },
-    { "shlax7",     REG_AX,             PSTATE_ALL | REG_AXY                        },
-    { "shlaxy",     REG_AXY,            PSTATE_ALL | REG_AXY | REG_TMP1             },
-    { "shleax1",    REG_EAX,            PSTATE_ALL | REG_EAX | REG_TMP1             },
-    { "shleax2",    REG_EAX,            PSTATE_ALL | REG_EAX | REG_TMP1             },
-    { "shleax3",    REG_EAX,            PSTATE_ALL | REG_EAX | REG_TMP1             },
-    { "shleax4",    REG_EAX,            PSTATE_ALL | REG_EAXY | REG_TMP1            },
-    { "shrax1",     REG_AX,             PSTATE_ALL | REG_AX | REG_TMP1              },
-    { "shrax2",     REG_AX,             PSTATE_ALL | REG_AX | REG_TMP1              },
-    { "shrax3",     REG_AX,             PSTATE_ALL | REG_AX | REG_TMP1              },
-    { "shrax4",     REG_AX,             PSTATE_ALL | REG_AX | REG_TMP1              },
-    { "shrax7",     REG_AX,             PSTATE_ALL | REG_AX                         },
-    { "shraxy",     REG_AXY,            PSTATE_ALL | REG_AXY | REG_TMP1             },
-    { "shreax1",    REG_EAX,            PSTATE_ALL | REG_EAX | REG_TMP1             },
-    { "shreax2",    REG_EAX,            PSTATE_ALL | REG_EAX | REG_TMP1             },
-    { "shreax3",    REG_EAX,            PSTATE_ALL | REG_EAX | REG_TMP1             },
-    { "shreax4",    REG_EAX,            PSTATE_ALL | REG_EAXY | REG_TMP1            },
-    { "staspidx",   SLV_TOP | REG_AY,   PSTATE_ALL | REG_SP | REG_Y | REG_TMP1 | REG_PTR1   },
-    { "stax0sp",    REG_SP | REG_AX,    PSTATE_ALL | SLV_TOP | REG_Y                },
-    { "staxspidx",  SLV_TOP | REG_AXY,  PSTATE_ALL | REG_SP | REG_TMP1 | REG_PTR1   },
-    { "staxysp",    REG_SP | REG_AXY,   PSTATE_ALL | SLV_IND | REG_Y                },
-    { "steax0sp",   REG_SP | REG_EAX,   PSTATE_ALL | SLV_TOP | REG_Y                },
-    { "steaxspidx", SLV_TOP | REG_EAXY, PSTATE_ALL | REG_SP | REG_Y | REG_TMP1 | REG_PTR1   }, /* also tmp2, tmp3 */
-    { "steaxysp",   REG_SP | REG_EAXY,  PSTATE_ALL | SLV_IND | REG_Y                },
-    { "subeq0sp",   SLV_TOP | REG_AX,   PSTATE_ALL | REG_AXY                        },
-    { "subeqysp",   SLV_IND | REG_AXY,  PSTATE_ALL | REG_AXY                        },
-    { "subysp",     REG_SP | REG_Y,     PSTATE_ALL | REG_SP | REG_AY                },
-    { "swapstk",    SLV_TOP | REG_AX,   PSTATE_ALL | SLV_TOP | REG_AXY              }, /* also ptr4 */
-    { "tosadd0ax",  SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_EAXY | REG_TMP1   },
-    { "tosadda0",   SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_AXY               },
-    { "tosaddax",   SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_AXY               },
-    { "tosaddeax",  SLV_TOP | REG_EAX,  PSTATE_ALL | REG_SP | REG_EAXY | REG_TMP1   },
-    { "tosand0ax",  SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_EAXY | REG_TMP1   },
-    { "tosanda0",   SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_AXY               },
-    { "tosandax",   SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_AXY               },
-    { "tosandeax",  SLV_TOP | REG_EAX,  PSTATE_ALL | REG_SP | REG_EAXY | REG_TMP1   },
-    { "tosaslax",   SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_AXY | REG_TMP1    },
-    { "tosasleax",  SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_EAXY | REG_TMP1   },
-    { "tosasrax",   SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_AXY | REG_TMP1    },
-    { "tosasreax",  SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_EAXY | REG_TMP1   },
-    { "tosdiv0ax",  SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_ALL               },
-    { "tosdiva0",   SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_ALL               },
-    { "tosdivax",   SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_ALL               },
-    { "tosdiveax",  SLV_TOP | REG_EAX,  PSTATE_ALL | REG_SP | REG_ALL               },
-    { "toseq00",    SLV_TOP,            PSTATE_ALL | REG_SP | REG_AXY | REG_SREG    },
-    { "toseqa0",    SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_AXY | REG_SREG    },
-    { "toseqax",    SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_AXY | REG_SREG    },
-    { "toseqeax",   SLV_TOP | REG_EAX,  PSTATE_ALL | REG_SP | REG_AXY | REG_PTR1    },
-    { "tosge00",    SLV_TOP,            PSTATE_ALL | REG_SP | REG_AXY | REG_SREG    },
-    { "tosgea0",    SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_AXY | REG_SREG    },
-    { "tosgeax",    SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_AXY | REG_SREG    },
-    { "tosgeeax",   SLV_TOP | REG_EAX,  PSTATE_ALL | REG_SP | REG_AXY | REG_PTR1    },
-    { "tosgt00",    SLV_TOP,            PSTATE_ALL | REG_SP | REG_AXY | REG_SREG    },
-    { "tosgta0",    SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_AXY | REG_SREG    },
-    { "tosgtax",    SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_AXY | REG_SREG    },
-    { "tosgteax",   SLV_TOP | REG_EAX,  PSTATE_ALL | REG_SP | REG_AXY | REG_PTR1    },
-    { "tosicmp",    SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_AXY | REG_SREG    },
-    { "tosicmp0",   SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_AXY | REG_SREG    },
-    { "tosint",     SLV_TOP,            PSTATE_ALL | REG_SP | REG_Y                 },
-    { "toslcmp",    SLV_TOP | REG_EAX,  PSTATE_ALL | REG_SP | REG_A | REG_Y | REG_PTR1  },
-    { "tosle00",    SLV_TOP,            PSTATE_ALL | REG_SP | REG_AXY | REG_SREG    },
-    { "toslea0",    SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_AXY | REG_SREG    },
-    { "tosleax",    SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_AXY | REG_SREG    },
-    { "tosleeax",   SLV_TOP | REG_EAX,  PSTATE_ALL | REG_SP | REG_AXY | REG_PTR1    },
-    { "toslong",    SLV_TOP,            PSTATE_ALL | REG_SP | REG_Y                 },
-    { "toslt00",    SLV_TOP,            PSTATE_ALL | REG_SP | REG_AXY | REG_SREG    },
-    { "toslta0",    SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_AXY | REG_SREG    },
-    { "tosltax",    SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_AXY | REG_SREG    },
-    { "toslteax",   SLV_TOP | REG_EAX,  PSTATE_ALL | REG_SP | REG_AXY | REG_PTR1    },
-    { "tosmod0ax",  SLV_TOP | REG_AX,   PSTATE_ALL | REG_ALL                        },
-    { "tosmodeax",  SLV_TOP | REG_EAX,  PSTATE_ALL | REG_ALL                        },
-    { "tosmul0ax",  SLV_TOP | REG_AX,   PSTATE_ALL | REG_ALL                        },
-    { "tosmula0",   SLV_TOP | REG_A,    PSTATE_ALL | REG_ALL                        },
-    { "tosmulax",   SLV_TOP | REG_AX,   PSTATE_ALL | REG_ALL                        },
-    { "tosmuleax",  SLV_TOP | REG_EAX,  PSTATE_ALL | REG_ALL                        },
-    { "tosne00",    SLV_TOP,            PSTATE_ALL | REG_SP | REG_AXY | REG_SREG    },
-    { "tosnea0",    SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_AXY | REG_SREG    },
-    { "tosneax",    SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_AXY | REG_SREG    },
-    { "tosneeax",   SLV_TOP | REG_EAX,  PSTATE_ALL | REG_SP | REG_AXY | REG_PTR1    },
-    { "tosor0ax",   SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_EAXY | REG_TMP1   },
-    { "tosora0",    SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_AXY | REG_TMP1    },
-    { "tosorax",    SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_AXY | REG_TMP1    },
-    { "tosoreax",   SLV_TOP | REG_EAX,  PSTATE_ALL | REG_SP | REG_EAXY | REG_TMP1   },
-    { "tosrsub0ax", SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_EAXY | REG_TMP1   },
-    { "tosrsuba0",  SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_AXY | REG_TMP1    },
-    { "tosrsubax",  SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_AXY | REG_TMP1    },
-    { "tosrsubeax", SLV_TOP | REG_EAX,  PSTATE_ALL | REG_SP | REG_EAXY | REG_TMP1   },
-    { "tosshlax",   SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_AXY | REG_TMP1    },
-    { "tosshleax",  SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_EAXY | REG_TMP1   },
-    { "tosshrax",   SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_AXY | REG_TMP1    },
-    { "tosshreax",  SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_EAXY | REG_TMP1   },
-    { "tossub0ax",  SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_EAXY              },
-    { "tossuba0",   SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_AXY               },
-    { "tossubax",   SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_AXY               },
-    { "tossubeax",  SLV_TOP | REG_EAX,  PSTATE_ALL | REG_SP | REG_EAXY              },
-    { "tosudiv0ax", SLV_TOP | REG_AX,   PSTATE_ALL | (REG_ALL & ~REG_SAVE)          },
-    { "tosudiva0",  SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_EAXY | REG_PTR1   }, /* also ptr4 */
-    { "tosudivax",  SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_EAXY | REG_PTR1   }, /* also ptr4 */
-    { "tosudiveax", SLV_TOP | REG_EAX,  PSTATE_ALL | (REG_ALL & ~REG_SAVE)          },
-    { "tosuge00",   SLV_TOP,            PSTATE_ALL | REG_SP | REG_AXY | REG_SREG    },
-    { "tosugea0",   SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_AXY | REG_SREG    },
-    { "tosugeax",   SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_AXY | REG_SREG    },
-    { "tosugeeax",  SLV_TOP | REG_EAX,  PSTATE_ALL | REG_SP | REG_AXY | REG_PTR1    },
-    { "tosugt00",   SLV_TOP,            PSTATE_ALL | REG_SP | REG_AXY | REG_SREG    },
-    { "tosugta0",   SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_AXY | REG_SREG    },
-    { "tosugtax",   SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_AXY | REG_SREG    },
-    { "tosugteax",  SLV_TOP | REG_EAX,  PSTATE_ALL | REG_SP | REG_AXY | REG_PTR1    },
-    { "tosule00",   SLV_TOP,            PSTATE_ALL | REG_SP | REG_AXY | REG_SREG    },
-    { "tosulea0",   SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_AXY | REG_SREG    },
-    { "tosuleax",   SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_AXY | REG_SREG    },
-    { "tosuleeax",  SLV_TOP | REG_EAX,  PSTATE_ALL | REG_SP | REG_AXY | REG_PTR1    },
-    { "tosulong",   SLV_TOP,            PSTATE_ALL | REG_SP | REG_Y                 },
-    { "tosult00",   SLV_TOP,            PSTATE_ALL | REG_SP | REG_AXY | REG_SREG    },
-    { "tosulta0",   SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_AXY | REG_SREG    },
-    { "tosultax",   SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_AXY | REG_SREG    },
-    { "tosulteax",  SLV_TOP | REG_EAX,  PSTATE_ALL | REG_SP | REG_AXY | REG_PTR1    },
-    { "tosumod0ax", SLV_TOP | REG_AX,   PSTATE_ALL | (REG_ALL & ~REG_SAVE)          },
-    { "tosumoda0",  SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_EAXY | REG_PTR1   }, /* also ptr4 */
-    { "tosumodax",  SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_EAXY | REG_PTR1   }, /* also ptr4 */
-    { "tosumodeax", SLV_TOP | REG_EAX,  PSTATE_ALL | (REG_ALL & ~REG_SAVE)          },
-    { "tosumul0ax", SLV_TOP | REG_AX,   PSTATE_ALL | REG_ALL                        },
-    { "tosumula0",  SLV_TOP | REG_A,    PSTATE_ALL | REG_ALL                        },
-    { "tosumulax",  SLV_TOP | REG_AX,   PSTATE_ALL | REG_ALL                        },
-    { "tosumuleax", SLV_TOP | REG_EAX,  PSTATE_ALL | REG_ALL                        },
-    { "tosxor0ax",  SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_EAXY | REG_TMP1   },
-    { "tosxora0",   SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_AXY | REG_TMP1    },
-    { "tosxorax",   SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_AXY | REG_TMP1    },
-    { "tosxoreax",  SLV_TOP | REG_EAX,  PSTATE_ALL | REG_SP | REG_EAXY | REG_TMP1   },
-    { "tsteax",     REG_EAX,            PSTATE_ALL | REG_Y                          },
-    { "utsteax",    REG_EAX,            PSTATE_ALL | REG_Y                          },
+    { "addeq0sp",   SLV_TOP | REG_AX,   PSTATE_ALL | REG_AXY,                    51 },
+    { "addeqysp",   SLV_IND | REG_AXY,  PSTATE_ALL | REG_AXY,                    49 },
+    { "addysp",     REG_SP | REG_Y,     PSTATE_ALL | REG_SP,                     32 },
+    { "along",      REG_A,              PSTATE_ALL | REG_X | REG_SREG,           26 },
+    { "aslax1",     REG_AX,             PSTATE_ALL | REG_AX | REG_TMP1,          25 },
+    { "aslax2",     REG_AX,             PSTATE_ALL | REG_AX | REG_TMP1,          32 },
+    { "aslax3",     REG_AX,             PSTATE_ALL | REG_AX | REG_TMP1,          39 },
+    { "aslax4",     REG_AX,             PSTATE_ALL | REG_AX | REG_TMP1,          46 },
+    { "aslax7",     REG_AX,             PSTATE_ALL | REG_AXY,                    28 },
+    { "aslaxy",     REG_AXY,            PSTATE_ALL | REG_AXY | REG_TMP1,         67 },
+    { "asleax1",    REG_EAX,            PSTATE_ALL | REG_EAX | REG_TMP1,         35 },
+    { "asleax2",    REG_EAX,            PSTATE_ALL | REG_EAX | REG_TMP1,         52 },
+    { "asleax3",    REG_EAX,            PSTATE_ALL | REG_EAX | REG_TMP1,         69 },
+    { "asleax4",    REG_EAX,            PSTATE_ALL | REG_EAXY | REG_TMP1,       107 },
+    { "asrax1",     REG_AX,             PSTATE_ALL | REG_AX | REG_TMP1,          27 },
+    { "asrax2",     REG_AX,             PSTATE_ALL | REG_AX | REG_TMP1,          36 },
+    { "asrax3",     REG_AX,             PSTATE_ALL | REG_AX | REG_TMP1,          45 },
+    { "asrax4",     REG_AX,             PSTATE_ALL | REG_AX | REG_TMP1,          54 },
+    { "asrax7",     REG_AX,             PSTATE_ALL | REG_AX,                     23 },
+    { "asraxy",     REG_AXY,            PSTATE_ALL | REG_AXY | REG_TMP1,         71 },
+    { "asreax1",    REG_EAX,            PSTATE_ALL | REG_EAX | REG_TMP1,         40 },
+    { "asreax2",    REG_EAX,            PSTATE_ALL | REG_EAX | REG_TMP1,         59 },
+    { "asreax3",    REG_EAX,            PSTATE_ALL | REG_EAX | REG_TMP1,         78 },
+    { "asreax4",    REG_EAX,            PSTATE_ALL | REG_EAXY | REG_TMP1,       118 },
+    { "aulong",     REG_NONE,           PSTATE_ALL | REG_X | REG_SREG,           20 },
+    { "axlong",     REG_X,              PSTATE_ALL | REG_Y | REG_SREG,           26 },
+    { "axulong",    REG_NONE,           PSTATE_ALL | REG_Y | REG_SREG,           20 },
+    { "bcasta",     REG_A,              PSTATE_ALL | REG_AX,                     20 },
+    { "bcastax",    REG_AX,             PSTATE_ALL | REG_AX,                     21 },
+    { "bcasteax",   REG_EAX,            PSTATE_ALL | REG_EAX | REG_TMP1,         30 },
+    { "bnega",      REG_A,              PSTATE_ALL | REG_AX,                     21 },
+    { "bnegax",     REG_AX,             PSTATE_ALL | REG_AX,                     21 },
+    { "bnegeax",    REG_EAX,            PSTATE_ALL | REG_EAX | REG_TMP1,         31 },
+    { "booleq",     PSTATE_Z,           PSTATE_ALL | REG_AX,                     19 },
+    { "boolge",     PSTATE_N,           PSTATE_ALL | REG_AX,                     19 },
+    { "boolgt",     PSTATE_ZN,          PSTATE_ALL | REG_AX,                     21 },
+    { "boolle",     PSTATE_ZN,          PSTATE_ALL | REG_AX,                     20 },
+    { "boollt",     PSTATE_N,           PSTATE_ALL | REG_AX,                     18 },
+    { "boolne",     PSTATE_Z,           PSTATE_ALL | REG_AX,                     19 },
+    { "booluge",    PSTATE_C,           PSTATE_ALL | REG_AX,                     18 },
+    { "boolugt",    PSTATE_CZ,          PSTATE_ALL | REG_AX,                     20 },
+    { "boolule",    PSTATE_CZ,          PSTATE_ALL | REG_AX,                     20 },
+    { "boolult",    PSTATE_C,           PSTATE_ALL | REG_AX,                     18 },
+    { "callax",     REG_AX,             PSTATE_ALL | REG_ALL,                    23 }, /* PSTATE_ZN | REG_PTR1 */
+    { "complax",    REG_AX,             PSTATE_ALL | REG_AX,                     27 },
+    { "decax1",     REG_AX,             PSTATE_ALL | REG_AX,                     19 },
+    { "decax2",     REG_AX,             PSTATE_ALL | REG_AX,                     19 },
+    { "decax3",     REG_AX,             PSTATE_ALL | REG_AX,                     19 },
+    { "decax4",     REG_AX,             PSTATE_ALL | REG_AX,                     19 },
+    { "decax5",     REG_AX,             PSTATE_ALL | REG_AX,                     19 },
+    { "decax6",     REG_AX,             PSTATE_ALL | REG_AX,                     19 },
+    { "decax7",     REG_AX,             PSTATE_ALL | REG_AX,                     19 },
+    { "decax8",     REG_AX,             PSTATE_ALL | REG_AX,                     19 },
+    { "decaxy",     REG_AXY,            PSTATE_ALL | REG_AX | REG_TMP1,          23 },
+    { "deceaxy",    REG_EAXY,           PSTATE_ALL | REG_EAX,                    23 },
+    { "decsp1",     REG_SP,             PSTATE_ALL | REG_SP | REG_Y,             23 },
+    { "decsp2",     REG_SP,             PSTATE_ALL | REG_SP | REG_A,             24 },
+    { "decsp3",     REG_SP,             PSTATE_ALL | REG_SP | REG_A,             24 },
+    { "decsp4",     REG_SP,             PSTATE_ALL | REG_SP | REG_A,             24 },
+    { "decsp5",     REG_SP,             PSTATE_ALL | REG_SP | REG_A,             24 },
+    { "decsp6",     REG_SP,             PSTATE_ALL | REG_SP | REG_A,             24 },
+    { "decsp7",     REG_SP,             PSTATE_ALL | REG_SP | REG_A,             24 },
+    { "decsp8",     REG_SP,             PSTATE_ALL | REG_SP | REG_A,             24 },
+    { "enter",      REG_SP | REG_Y,     PSTATE_ALL | REG_SP | REG_AY,            33 },
+    { "incax1",     REG_AX,             PSTATE_ALL | REG_AX,                     19 },
+    { "incax2",     REG_AX,             PSTATE_ALL | REG_AX,                     19 },
+    { "incax3",     REG_AX,             PSTATE_ALL | REG_AXY | REG_TMP1,         28 },
+    { "incax4",     REG_AX,             PSTATE_ALL | REG_AXY | REG_TMP1,         25 },
+    { "incax5",     REG_AX,             PSTATE_ALL | REG_AXY | REG_TMP1,         28 },
+    { "incax6",     REG_AX,             PSTATE_ALL | REG_AXY | REG_TMP1,         28 },
+    { "incax7",     REG_AX,             PSTATE_ALL | REG_AXY | REG_TMP1,         28 },
+    { "incax8",     REG_AX,             PSTATE_ALL | REG_AXY | REG_TMP1,         28 },
+    { "incaxy",     REG_AXY,            PSTATE_ALL | REG_AXY | REG_TMP1,         23 },
+    { "inceaxy",    REG_EAXY,           PSTATE_ALL | REG_EAX,                    23 },
+    { "incsp1",     REG_SP,             PSTATE_ALL | REG_SP,                     20 },
+    { "incsp2",     REG_SP,             PSTATE_ALL | REG_SP | REG_Y,             26 },
+    { "incsp3",     REG_SP,             PSTATE_ALL | REG_SP | REG_Y,             37 },
+    { "incsp4",     REG_SP,             PSTATE_ALL | REG_SP | REG_Y,             37 },
+    { "incsp5",     REG_SP,             PSTATE_ALL | REG_SP | REG_Y,             37 },
+    { "incsp6",     REG_SP,             PSTATE_ALL | REG_SP | REG_Y,             37 },
+    { "incsp7",     REG_SP,             PSTATE_ALL | REG_SP | REG_Y,             37 },
+    { "incsp8",     REG_SP,             PSTATE_ALL | REG_SP | REG_Y,             37 },
+    { "jmpvec",     REG_EVERYTHING,         PSTATE_ALL | REG_ALL,                15 }, /* NONE */
+    { "laddeq",     REG_EAXY | REG_PTR1_LO, PSTATE_ALL | REG_EAXY | REG_PTR1_HI,  92 },
+    { "laddeq0sp",  SLV_TOP | REG_EAX,      PSTATE_ALL | REG_EAXY,               89 },
+    { "laddeq1",    REG_Y | REG_PTR1_LO,    PSTATE_ALL | REG_EAXY | REG_PTR1_HI, 102 },
+    { "laddeqa",    REG_AY | REG_PTR1_LO,   PSTATE_ALL | REG_EAXY | REG_PTR1_HI, 100 },
+    { "laddeqysp",  SLV_IND | REG_EAXY,     PSTATE_ALL | REG_EAXY,               87 },
+    { "ldaidx",     REG_AXY,                PSTATE_ALL | REG_AX | REG_PTR1,      28 },
+    { "ldauidx",    REG_AXY,                PSTATE_ALL | REG_AX | REG_PTR1,      25 },
+    { "ldax0sp",    SLV_TOP,                PSTATE_ALL | REG_AXY,                28 },
+    { "ldaxi",      REG_AX,                 PSTATE_ALL | REG_AXY | REG_PTR1,     34 },
+    { "ldaxidx",    REG_AXY,                PSTATE_ALL | REG_AXY | REG_PTR1,     32 },
+    { "ldaxysp",    SLV_IND | REG_Y,        PSTATE_ALL | REG_AXY,                26 },
+    { "ldeax0sp",   SLV_TOP,                PSTATE_ALL | REG_EAXY,               48 },
+    { "ldeaxi",     REG_AX,                 PSTATE_ALL | REG_EAXY | REG_PTR1,    54 },
+    { "ldeaxidx",   REG_AXY,                PSTATE_ALL | REG_EAXY | REG_PTR1,    53 },
+    { "ldeaxysp",   SLV_IND | REG_Y,        PSTATE_ALL | REG_EAXY,               47 },
+    { "leaa0sp",    REG_SP | REG_A,         PSTATE_ALL | REG_AX,                 33 },
+    { "leaaxsp",    REG_SP | REG_AX,        PSTATE_ALL | REG_AX,                 31 },
+    { "leave00",    REG_SP,                 PSTATE_ALL | REG_SP | REG_AXY,       44 },
+    { "leave0",     REG_SP,                 PSTATE_ALL | REG_SP | REG_XY,        42 },
+    { "leave",      REG_SP,                 PSTATE_ALL | REG_SP | REG_Y,         37 },
+    { "leavey00",   REG_SP,                 PSTATE_ALL | REG_SP | REG_AXY,       77 },
+    { "leavey0",    REG_SP,                 PSTATE_ALL | REG_SP | REG_XY,        75 },
+    { "leavey",     REG_SP | REG_Y,         PSTATE_ALL | REG_SP | REG_Y,         73 },
+    { "lsubeq",     REG_EAXY | REG_PTR1_LO, PSTATE_ALL | REG_EAXY | REG_PTR1_HI,  96 },
+    { "lsubeq0sp",  SLV_TOP | REG_EAX,      PSTATE_ALL | REG_EAXY,               93 },
+    { "lsubeq1",    REG_Y | REG_PTR1_LO,    PSTATE_ALL | REG_EAXY | REG_PTR1_HI, 106 },
+    { "lsubeqa",    REG_AY | REG_PTR1_LO,   PSTATE_ALL | REG_EAXY | REG_PTR1_HI, 104 },
+    { "lsubeqysp",  SLV_IND | REG_EAXY,     PSTATE_ALL | REG_EAXY,               91 },
+    { "mulax10",    REG_AX,             PSTATE_ALL | REG_AX | REG_PTR1,          57 },
+    { "mulax3",     REG_AX,             PSTATE_ALL | REG_AX | REG_PTR1,          44 },
+    { "mulax5",     REG_AX,             PSTATE_ALL | REG_AX | REG_PTR1,          51 },
+    { "mulax6",     REG_AX,             PSTATE_ALL | REG_AX | REG_PTR1,          50 },
+    { "mulax7",     REG_AX,             PSTATE_ALL | REG_AX | REG_PTR1,          60 },
+    { "mulax9",     REG_AX,             PSTATE_ALL | REG_AX | REG_PTR1,          58 },
+    { "negax",      REG_AX,             PSTATE_ALL | REG_AX,                     33 },
+    { "negeax",     REG_EAX,            PSTATE_ALL | REG_EAX,                    53 },
+    { "popa",       SLV_TOP,            PSTATE_ALL | REG_SP | REG_AY,            26 },
+    { "popax",      SLV_TOP,            PSTATE_ALL | REG_SP | REG_AXY,           42 },
+    { "popeax",     SLV_TOP,            PSTATE_ALL | REG_SP | REG_EAXY,          76 },
+    { "push0",      REG_SP,             PSTATE_ALL | REG_SP | REG_AXY,           54 },
+    { "push0ax",    REG_SP | REG_AX,    PSTATE_ALL | REG_SP | REG_Y | REG_SREG,  91 },
+    { "push1",      REG_SP,             PSTATE_ALL | REG_SP | REG_AXY,           57 },
+    { "push2",      REG_SP,             PSTATE_ALL | REG_SP | REG_AXY,           57 },
+    { "push3",      REG_SP,             PSTATE_ALL | REG_SP | REG_AXY,           57 },
+    { "push4",      REG_SP,             PSTATE_ALL | REG_SP | REG_AXY,           57 },
+    { "push5",      REG_SP,             PSTATE_ALL | REG_SP | REG_AXY,           57 },
+    { "push6",      REG_SP,             PSTATE_ALL | REG_SP | REG_AXY,           57 },
+    { "push7",      REG_SP,             PSTATE_ALL | REG_SP | REG_AXY,           57 },
+    { "pusha",      REG_SP | REG_A,     PSTATE_ALL | REG_SP | REG_Y,             30 },
+    { "pusha0",     REG_SP | REG_A,     PSTATE_ALL | REG_SP | REG_XY,            52 },
+    { "pusha0sp",   SLV_TOP,            PSTATE_ALL | REG_SP | REG_AY,            37 },
+    { "pushaFF",    REG_SP | REG_A,     PSTATE_ALL | REG_SP | REG_Y,             55 },
+    { "pushax",     REG_SP | REG_AX,    PSTATE_ALL | REG_SP | REG_Y,             50 },
+    { "pushaysp",   SLV_IND | REG_Y,    PSTATE_ALL | REG_SP | REG_AY,            35 },
+    { "pushc0",     REG_SP,             PSTATE_ALL | REG_SP | REG_A | REG_Y,     35 },
+    { "pushc1",     REG_SP,             PSTATE_ALL | REG_SP | REG_A | REG_Y,     35 },
+    { "pushc2",     REG_SP,             PSTATE_ALL | REG_SP | REG_A | REG_Y,     35 },
+    { "pusheax",    REG_SP | REG_EAX,   PSTATE_ALL | REG_SP | REG_Y,             83 },
+    { "pushl0",     REG_SP,             PSTATE_ALL | REG_SP | REG_AXY,           95 },
+    { "pushw",      REG_SP | REG_AX,    PSTATE_ALL | REG_SP | REG_AXY | REG_PTR1,  75 },
+    { "pushw0sp",   SLV_TOP,            PSTATE_ALL | REG_SP | REG_AXY,           59 },
+    { "pushwidx",   REG_SP | REG_AXY,   PSTATE_ALL | REG_SP | REG_AXY | REG_PTR1,  73 },
+    { "pushwysp",   SLV_IND | REG_Y,    PSTATE_ALL | REG_SP | REG_AXY,           57 },
+    { "regswap",    REG_AXY,            PSTATE_ALL | REG_AXY | REG_TMP1,         90 },
+    { "regswap1",   REG_XY,             PSTATE_ALL | REG_A,                      38 },
+    { "regswap2",   REG_XY,             PSTATE_ALL | REG_A | REG_Y,              66 },
+    { "resteax",    REG_SAVE,           PSTATE_ZN  | REG_EAX,                    30 }, /* also uses regsave+2/+3 */
+    { "return0",    REG_NONE,           PSTATE_ALL | REG_AX,                     16 },
+    { "return1",    REG_NONE,           PSTATE_ALL | REG_AX,                     16 },
+    { "saveeax",    REG_EAX,            PSTATE_ZN  | REG_Y | REG_SAVE,           30 }, /* also regsave+2/+3 */
+    { "shlax1",     REG_AX,             PSTATE_ALL | REG_AX | REG_TMP1,          25 },
+    { "shlax2",     REG_AX,             PSTATE_ALL | REG_AX | REG_TMP1,          32 },
+    { "shlax3",     REG_AX,             PSTATE_ALL | REG_AX | REG_TMP1,          39 },
+    { "shlax4",     REG_AX,             PSTATE_ALL | REG_AX | REG_TMP1,          46 },
+    { "shlax7",     REG_AX,             PSTATE_ALL | REG_AXY,                    28 },
+    { "shlaxy",     REG_AXY,            PSTATE_ALL | REG_AXY | REG_TMP1,         67 },
+    { "shleax1",    REG_EAX,            PSTATE_ALL | REG_EAX | REG_TMP1,         35 },
+    { "shleax2",    REG_EAX,            PSTATE_ALL | REG_EAX | REG_TMP1,         52 },
+    { "shleax3",    REG_EAX,            PSTATE_ALL | REG_EAX | REG_TMP1,         69 },
+    { "shleax4",    REG_EAX,            PSTATE_ALL | REG_EAXY | REG_TMP1,       107 },
+    { "shrax1",     REG_AX,             PSTATE_ALL | REG_AX | REG_TMP1,          25 },
+    { "shrax2",     REG_AX,             PSTATE_ALL | REG_AX | REG_TMP1,          32 },
+    { "shrax3",     REG_AX,             PSTATE_ALL | REG_AX | REG_TMP1,          39 },
+    { "shrax4",     REG_AX,             PSTATE_ALL | REG_AX | REG_TMP1,          46 },
+    { "shrax7",     REG_AX,             PSTATE_ALL | REG_AX,                     23 },
+    { "shraxy",     REG_AXY,            PSTATE_ALL | REG_AXY | REG_TMP1,         67 },
+    { "shreax1",    REG_EAX,            PSTATE_ALL | REG_EAX | REG_TMP1,         35 },
+    { "shreax2",    REG_EAX,            PSTATE_ALL | REG_EAX | REG_TMP1,         52 },
+    { "shreax3",    REG_EAX,            PSTATE_ALL | REG_EAX | REG_TMP1,         69 },
+    { "shreax4",    REG_EAX,            PSTATE_ALL | REG_EAXY | REG_TMP1,       110 },
+    { "staspidx",   SLV_TOP | REG_AY,   PSTATE_ALL | REG_SP | REG_Y | REG_TMP1 | REG_PTR1,  68 },
+    { "stax0sp",    REG_SP | REG_AX,    PSTATE_ALL | SLV_TOP | REG_Y,            37 },
+    { "staxspidx",  SLV_TOP | REG_AXY,  PSTATE_ALL | REG_SP | REG_TMP1 | REG_PTR1,  80 },
+    { "staxysp",    REG_SP | REG_AXY,   PSTATE_ALL | SLV_IND | REG_Y,            35 },
+    { "steax0sp",   REG_SP | REG_EAX,   PSTATE_ALL | SLV_TOP | REG_Y,            59 },
+    { "steaxspidx", SLV_TOP | REG_EAXY, PSTATE_ALL | REG_SP | REG_Y | REG_TMP1 | REG_PTR1, 120 }, /* also tmp2, tmp3 */
+    { "steaxysp",   REG_SP | REG_EAXY,  PSTATE_ALL | SLV_IND | REG_Y,            57 },
+    { "subeq0sp",   SLV_TOP | REG_AX,   PSTATE_ALL | REG_AXY,                    55 },
+    { "subeqysp",   SLV_IND | REG_AXY,  PSTATE_ALL | REG_AXY,                    53 },
+    { "subysp",     REG_SP | REG_Y,     PSTATE_ALL | REG_SP | REG_AY,            27 },
+    { "swapstk",    SLV_TOP | REG_AX,   PSTATE_ALL | SLV_TOP | REG_AXY,          59 }, /* also ptr4 */
+    { "tosadd0ax",  SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_EAXY | REG_TMP1,  97 },
+    { "tosadda0",   SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_AXY,           53 },
+    { "tosaddax",   SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_AXY,           51 },
+    { "tosaddeax",  SLV_TOP | REG_EAX,  PSTATE_ALL | REG_SP | REG_EAXY | REG_TMP1,  89 },
+    { "tosand0ax",  SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_EAXY | REG_TMP1,  95 },
+    { "tosanda0",   SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_AXY,           64 },
+    { "tosandax",   SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_AXY,           62 },
+    { "tosandeax",  SLV_TOP | REG_EAX,  PSTATE_ALL | REG_SP | REG_EAXY | REG_TMP1,  87 },
+    { "tosaslax",   SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_AXY | REG_TMP1, 127 },
+    { "tosasleax",  SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_EAXY | REG_TMP1, 169 },
+    { "tosasrax",   SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_AXY | REG_TMP1, 133 },
+    { "tosasreax",  SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_EAXY | REG_TMP1, 178 },
+    { "tosdiv0ax",  SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_ALL,         2715 },
+    { "tosdiva0",   SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_ALL,          550 },
+    { "tosdivax",   SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_ALL,          734 },
+    { "tosdiveax",  SLV_TOP | REG_EAX,  PSTATE_ALL | REG_SP | REG_ALL,         2515 },
+    { "toseq00",    SLV_TOP,            PSTATE_ALL | REG_SP | REG_AXY | REG_SREG,  85 },
+    { "toseqa0",    SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_AXY | REG_SREG,  83 },
+    { "toseqax",    SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_AXY | REG_SREG,  81 },
+    { "toseqeax",   SLV_TOP | REG_EAX,  PSTATE_ALL | REG_SP | REG_AXY | REG_PTR1, 102 },
+    { "tosge00",    SLV_TOP,            PSTATE_ALL | REG_SP | REG_AXY | REG_SREG,  85 },
+    { "tosgea0",    SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_AXY | REG_SREG,  83 },
+    { "tosgeax",    SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_AXY | REG_SREG,  80 },
+    { "tosgeeax",   SLV_TOP | REG_EAX,  PSTATE_ALL | REG_SP | REG_AXY | REG_PTR1, 102 },
+    { "tosgt00",    SLV_TOP,            PSTATE_ALL | REG_SP | REG_AXY | REG_SREG,  87 },
+    { "tosgta0",    SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_AXY | REG_SREG,  85 },
+    { "tosgtax",    SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_AXY | REG_SREG,  82 },
+    { "tosgteax",   SLV_TOP | REG_EAX,  PSTATE_ALL | REG_SP | REG_AXY | REG_PTR1, 104 },
+    { "tosicmp",    SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_AXY | REG_SREG,  59 },
+    { "tosicmp0",   SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_AXY | REG_SREG,  61 },
+    { "tosint",     SLV_TOP,            PSTATE_ALL | REG_SP | REG_Y,             66 },
+    { "toslcmp",    SLV_TOP | REG_EAX,  PSTATE_ALL | REG_SP | REG_A | REG_Y | REG_PTR1,  80 },
+    { "tosle00",    SLV_TOP,            PSTATE_ALL | REG_SP | REG_AXY | REG_SREG,  86 },
+    { "toslea0",    SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_AXY | REG_SREG,  84 },
+    { "tosleax",    SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_AXY | REG_SREG,  83 },
+    { "tosleeax",   SLV_TOP | REG_EAX,  PSTATE_ALL | REG_SP | REG_AXY | REG_PTR1, 103 },
+    { "toslong",    SLV_TOP,            PSTATE_ALL | REG_SP | REG_Y,             94 },
+    { "toslt00",    SLV_TOP,            PSTATE_ALL | REG_SP | REG_AXY | REG_SREG,  84 },
+    { "toslta0",    SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_AXY | REG_SREG,  82 },
+    { "tosltax",    SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_AXY | REG_SREG,  81 },
+    { "toslteax",   SLV_TOP | REG_EAX,  PSTATE_ALL | REG_SP | REG_AXY | REG_PTR1, 101 },
+    { "tosmod0ax",  SLV_TOP | REG_AX,   PSTATE_ALL | REG_ALL,                  2724 },
+    { "tosmodeax",  SLV_TOP | REG_EAX,  PSTATE_ALL | REG_ALL,                  2524 },
+    { "tosmul0ax",  SLV_TOP | REG_AX,   PSTATE_ALL | REG_ALL,                  1988 },
+    { "tosmula0",   SLV_TOP | REG_A,    PSTATE_ALL | REG_ALL,                   340 },
+    { "tosmulax",   SLV_TOP | REG_AX,   PSTATE_ALL | REG_ALL,                   685 },
+    { "tosmuleax",  SLV_TOP | REG_EAX,  PSTATE_ALL | REG_ALL,                  2120 },
+    { "tosne00",    SLV_TOP,            PSTATE_ALL | REG_SP | REG_AXY | REG_SREG,  85 },
+    { "tosnea0",    SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_AXY | REG_SREG,  83 },
+    { "tosneax",    SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_AXY | REG_SREG,  81 },
+    { "tosneeax",   SLV_TOP | REG_EAX,  PSTATE_ALL | REG_SP | REG_AXY | REG_PTR1, 102 },
+    { "tosor0ax",   SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_EAXY | REG_TMP1,  95 },
+    { "tosora0",    SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_AXY | REG_TMP1,  63 },
+    { "tosorax",    SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_AXY | REG_TMP1,  61 },
+    { "tosoreax",   SLV_TOP | REG_EAX,  PSTATE_ALL | REG_SP | REG_EAXY | REG_TMP1,  87 },
+    { "tosrsub0ax", SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_EAXY | REG_TMP1,  97 },
+    { "tosrsuba0",  SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_AXY | REG_TMP1,  65 },
+    { "tosrsubax",  SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_AXY | REG_TMP1,  63 },
+    { "tosrsubeax", SLV_TOP | REG_EAX,  PSTATE_ALL | REG_SP | REG_EAXY | REG_TMP1,  89 },
+    { "tosshlax",   SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_AXY | REG_TMP1, 127 },
+    { "tosshleax",  SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_EAXY | REG_TMP1, 169 },
+    { "tosshrax",   SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_AXY | REG_TMP1, 127 },
+    { "tosshreax",  SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_EAXY | REG_TMP1, 169 },
+    { "tossub0ax",  SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_EAXY,         102 },
+    { "tossuba0",   SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_AXY,           70 },
+    { "tossubax",   SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_AXY,           68 },
+    { "tossubeax",  SLV_TOP | REG_EAX,  PSTATE_ALL | REG_SP | REG_EAXY,          94 },
+    { "tosudiv0ax", SLV_TOP | REG_AX,   PSTATE_ALL | (REG_ALL & ~REG_SAVE),    2675 },
+    { "tosudiva0",  SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_EAXY | REG_PTR1, 523 }, /* also ptr4 */
+    { "tosudivax",  SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_EAXY | REG_PTR1, 707 }, /* also ptr4 */
+    { "tosudiveax", SLV_TOP | REG_EAX,  PSTATE_ALL | (REG_ALL & ~REG_SAVE),    2475 },
+    { "tosuge00",   SLV_TOP,            PSTATE_ALL | REG_SP | REG_AXY | REG_SREG,  84 },
+    { "tosugea0",   SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_AXY | REG_SREG,  82 },
+    { "tosugeax",   SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_AXY | REG_SREG,  80 },
+    { "tosugeeax",  SLV_TOP | REG_EAX,  PSTATE_ALL | REG_SP | REG_AXY | REG_PTR1, 101 },
+    { "tosugt00",   SLV_TOP,            PSTATE_ALL | REG_SP | REG_AXY | REG_SREG,  86 },
+    { "tosugta0",   SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_AXY | REG_SREG,  84 },
+    { "tosugtax",   SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_AXY | REG_SREG,  82 },
+    { "tosugteax",  SLV_TOP | REG_EAX,  PSTATE_ALL | REG_SP | REG_AXY | REG_PTR1, 103 },
+    { "tosule00",   SLV_TOP,            PSTATE_ALL | REG_SP | REG_AXY | REG_SREG,  86 },
+    { "tosulea0",   SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_AXY | REG_SREG,  84 },
+    { "tosuleax",   SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_AXY | REG_SREG,  83 },
+    { "tosuleeax",  SLV_TOP | REG_EAX,  PSTATE_ALL | REG_SP | REG_AXY | REG_PTR1, 103 },
+    { "tosulong",   SLV_TOP,            PSTATE_ALL | REG_SP | REG_Y,             91 },
+    { "tosult00",   SLV_TOP,            PSTATE_ALL | REG_SP | REG_AXY | REG_SREG,  16 },
+    { "tosulta0",   SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_AXY | REG_SREG,  82 },
+    { "tosultax",   SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_AXY | REG_SREG,  81 },
+    { "tosulteax",  SLV_TOP | REG_EAX,  PSTATE_ALL | REG_SP | REG_AXY | REG_PTR1, 101 },
+    { "tosumod0ax", SLV_TOP | REG_AX,   PSTATE_ALL | (REG_ALL & ~REG_SAVE),    2687 },
+    { "tosumoda0",  SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_EAXY | REG_PTR1, 523 }, /* also ptr4 */
+    { "tosumodax",  SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_EAXY | REG_PTR1, 707 }, /* also ptr4 */
+    { "tosumodeax", SLV_TOP | REG_EAX,  PSTATE_ALL | (REG_ALL & ~REG_SAVE),    2487 },
+    { "tosumul0ax", SLV_TOP | REG_AX,   PSTATE_ALL | REG_ALL,                  1988 },
+    { "tosumula0",  SLV_TOP | REG_A,    PSTATE_ALL | REG_ALL,                   340 },
+    { "tosumulax",  SLV_TOP | REG_AX,   PSTATE_ALL | REG_ALL,                   685 },
+    { "tosumuleax", SLV_TOP | REG_EAX,  PSTATE_ALL | REG_ALL,                  2120 },
+    { "tosxor0ax",  SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_EAXY | REG_TMP1,  95 },
+    { "tosxora0",   SLV_TOP | REG_A,    PSTATE_ALL | REG_SP | REG_AXY | REG_TMP1,  63 },
+    { "tosxorax",   SLV_TOP | REG_AX,   PSTATE_ALL | REG_SP | REG_AXY | REG_TMP1,  61 },
+    { "tosxoreax",  SLV_TOP | REG_EAX,  PSTATE_ALL | REG_SP | REG_EAXY | REG_TMP1,  87 },
+    { "tsteax",     REG_EAX,            PSTATE_ALL | REG_Y,                      32 },
+    { "utsteax",    REG_EAX,            PSTATE_ALL | REG_Y,                      32 },
 };
 #define FuncInfoCount   (sizeof(FuncInfoTable) / sizeof(FuncInfoTable[0]))
 
@@ -617,6 +623,60 @@ fncls_t GetFuncInfo (const char* Name, unsigned int* Use, unsigned int* Chg)
 
 
 
+fncls_t GetArgFuncInfo (const char* Arg, unsigned int* Use, unsigned int* Chg)
+/* Same as GetFuncInfo, but Arg must be an interned argument of a code entry.
+** The results for runtime functions and numeric addresses don't change, so
+** they are remembered with the string.
+*/
+{
+    CPStrInfo* Info = CP_GetStrInfo (Arg);
+    fncls_t    Class;
+
+    if ((Info->Flags & CPSI_FUNC) == 0) {
+        Class = GetFuncInfo (Arg, Use, Chg);
+        if (Class != FNCLS_BUILTIN && Class != FNCLS_NUMERIC) {
+            /* Depends on the symbol table */
+            return Class;
+        }
+        Info->FuncClass = Class;
+        Info->FuncUse   = *Use;
+        Info->FuncChg   = *Chg;
+        Info->Flags    |= CPSI_FUNC;
+    }
+    *Use = Info->FuncUse;
+    *Chg = Info->FuncChg;
+    return (fncls_t) Info->FuncClass;
+}
+
+
+
+unsigned long GetCodeCost (unsigned long Size, unsigned long Cycles,
+                           unsigned Weight)
+/* Return the cost of code with the given size in bytes and cycles. Weight is
+** the weight of the cycles against the size in percent.
+*/
+{
+    return Size * (100 - Weight) + Cycles * Weight;
+}
+
+
+
+unsigned GetFuncCycles (const char* Name)
+/* Return the typical number of cycles for a call of the given function,
+** including the jsr and the rts. For functions other than the runtime
+** functions, FUNC_CYCLES_UNKNOWN is returned.
+*/
+{
+    const FuncInfo* Info = 0;
+    if (Name[0] != '_' && !IsDigit (Name[0]) && Name[0] != '$') {
+        Info = bsearch (Name, FuncInfoTable, FuncInfoCount,
+                        sizeof(FuncInfo), CompareFuncInfo);
+    }
+    return Info? Info->Cycles : FUNC_CYCLES_UNKNOWN;
+}
+
+
+
 static int CompareZPInfo (const void* Name, const void* Info)
 /* Compare function for bsearch */
 {
@@ -655,6 +715,21 @@ const ZPInfo* GetZPInfo (const char* Name)
 
 
 
+const ZPInfo* GetArgZPInfo (const char* Arg)
+/* Same as GetZPInfo, but Arg must be an interned argument of a code entry.
+** The result is remembered with the string.
+*/
+{
+    CPStrInfo* Info = CP_GetStrInfo (Arg);
+    if ((Info->Flags & CPSI_ZP) == 0) {
+        Info->ZP     = GetZPInfo (Arg);
+        Info->Flags |= CPSI_ZP;
+    }
+    return Info->ZP;
+}
+
+
+
 static unsigned GetRegInfo2 (CodeSeg* S,
                              CodeEntry* E,
                              int Index,
@@ -901,6 +976,26 @@ int LoadFlagsUsed (struct CodeSeg* S, unsigned Index)
 
 
 
+int StackAddrTaken (struct CodeSeg* S)
+/* Check if the code computes the address of a location on the C stack */
+{
+    unsigned I;
+    for (I = 0; I < CS_GetEntryCount (S); ++I) {
+        const CodeEntry* E = CS_GetEntry (S, I);
+        if (CE_IsCallTo (E, "leaa0sp") || CE_IsCallTo (E, "leaaxsp")) {
+            return 1;
+        }
+        if ((E->Info & (OF_CALL | OF_BRA)) == 0  &&
+            (E->AM == AM65_ZP || E->AM == AM65_ABS)     &&
+            (E->Use & REG_SP) != 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+
+
 unsigned GetKnownReg (unsigned Use, const RegContents* RC)
 /* Return the register or zero page location from the set in Use, thats
 ** contents are known. If Use does not contain any register, or if the
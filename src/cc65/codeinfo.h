@@ -158,6 +158,9 @@ typedef enum {
     FNCLS_NUMERIC       /* A call to a numeric address */
 } fncls_t;
 
+/* Cycles assumed for a call of a function without cycle information */
+#define FUNC_CYCLES_UNKNOWN     100U
+
 
 
 /*****************************************************************************/
@@ -176,11 +179,34 @@ fncls_t GetFuncInfo (const char* Name, unsigned int* Use, unsigned int* Chg);
 ** Return the whatever category the function is in.
 */
 
+fncls_t GetArgFuncInfo (const char* Arg, unsigned int* Use, unsigned int* Chg);
+/* Same as GetFuncInfo, but Arg must be an interned argument of a code entry.
+** The results for runtime functions and numeric addresses don't change, so
+** they are remembered with the string.
+*/
+
+unsigned long GetCodeCost (unsigned long Size, unsigned long Cycles,
+                           unsigned Weight);
+/* Return the cost of code with the given size in bytes and cycles. Weight is
+** the weight of the cycles against the size in percent.
+*/
+
+unsigned GetFuncCycles (const char* Name);
+/* Return the typical number of cycles for a call of the given function,
+** including the jsr and the rts. For functions other than the runtime
+** functions, FUNC_CYCLES_UNKNOWN is returned.
+*/
+
 const ZPInfo* GetZPInfo (const char* Name);
 /* If the given name is a zero page symbol, return a pointer to the info
 ** struct for this symbol, otherwise return NULL.
 */
 
+const ZPInfo* GetArgZPInfo (const char* Arg);
+/* Same as GetZPInfo, but Arg must be an interned argument of a code entry.
+** The result is remembered with the string.
+*/
+
 unsigned GetRegInfo (struct CodeSeg* S, unsigned Index, unsigned Wanted);
 /* Determine register usage information for the instructions starting at the
 ** given index.
@@ -204,6 +230,9 @@ int RegEAXUsed (struct CodeSeg* S, unsigned Index);
 int LoadFlagsUsed (struct CodeSeg* S, unsigned Index);
 /* Check if one of the flags set by a register load (Z and N) are used. */
 
+int StackAddrTaken (struct CodeSeg* S);
+/* Check if the code computes the address of a location on the C stack */
+
 unsigned GetKnownReg (unsigned Use, const struct RegContents* RC);
 /* Return the register or zero page location from the set in Use, thats
 ** contents are known. If Use does not contain any register, or if the
@@ -40,6 +40,7 @@
 /* cc65 */
 #include "codeent.h"
 #include "codelab.h"
+#include "codepool.h"
 #include "output.h"
 
 
@@ -54,12 +55,13 @@ CodeLabel* NewCodeLabel (const char* Name, unsigned Hash)
 /* Create a new code label, initialize and return it */
 {
     /* Allocate memory */
-    CodeLabel* L = xmalloc (sizeof (CodeLabel));
+    CodeLabel* L = CP_Alloc (sizeof (CodeLabel));
 
     /* Initialize the fields */
     L->Next  = 0;
-    L->Name  = xstrdup (Name);
+    L->Name  = CP_Intern (Name);
     L->Hash  = Hash;
+    L->Flags = 0;
     L->Owner = 0;
     InitCollection (&L->JumpFrom);
 
@@ -72,14 +74,32 @@ CodeLabel* NewCodeLabel (const char* Name, unsigned Hash)
 void FreeCodeLabel (CodeLabel* L)
 /* Free the given code label */
 {
-    /* Free the name */
-    xfree (L->Name);
+    /* The name is interned and lives as long as the pool */
 
     /* Free the collection */
     DoneCollection (&L->JumpFrom);
 
     /* Delete the struct */
-    xfree (L);
+    CP_Free (L, sizeof (CodeLabel));
+}
+
+
+
+CodeLabel* CL_Move (CodeLabel* L)
+/* Copy the label and its name into memory from the current pool and return
+** the copy. The copy takes over the JumpFrom collection of the old label,
+** and the old label must not be freed.
+*/
+{
+    /* Allocate memory and copy the fields */
+    CodeLabel* N = CP_Alloc (sizeof (CodeLabel));
+    *N = *L;
+
+    /* Intern the name in the new pool */
+    N->Name = CP_Intern (L->Name);
+
+    /* Return the new label */
+    return N;
 }
 
 
@@ -59,12 +59,16 @@ struct CodeEntry;
 
 
 
+/* Label flags */
+#define CLF_INDIRECT    0x0001U         /* Label is used in data (jump table) */
+
 /* Label structure */
 typedef struct CodeLabel CodeLabel;
 struct CodeLabel {
     CodeLabel*          Next;           /* Next in hash list */
     char*               Name;           /* Label name */
     unsigned            Hash;           /* Hash over the name */
+    unsigned            Flags;          /* Label flags */
     struct CodeEntry*   Owner;          /* Owner entry */
     Collection          JumpFrom;       /* Entries that jump here */
 };
@@ -83,6 +87,12 @@ CodeLabel* NewCodeLabel (const char* Name, unsigned Hash);
 void FreeCodeLabel (CodeLabel* L);
 /* Free the given code label */
 
+CodeLabel* CL_Move (CodeLabel* L);
+/* Copy the label and its name into memory from the current pool and return
+** the copy. The copy takes over the JumpFrom collection of the old label,
+** and the old label must not be freed.
+*/
+
 #if defined(HAVE_INLINE)
 INLINE unsigned CL_GetRefCount (const CodeLabel* L)
 /* Get the number of references for this label */
@@ -103,6 +113,18 @@ INLINE struct CodeEntry* CL_GetRef (CodeLabel* L, unsigned Index)
 #  define CL_GetRef(L, Index)   CollAt (&(L)->JumpFrom, (Index))
 #endif
 
+#if defined(HAVE_INLINE)
+INLINE int CL_IsIndirect (const CodeLabel* L)
+/* Return true if the label is used in data, so it may be reached by indirect
+** jumps that are not in JumpFrom.
+*/
+{
+    return (L->Flags & CLF_INDIRECT) != 0;
+}
+#else
+#  define CL_IsIndirect(L)      (((L)->Flags & CLF_INDIRECT) != 0)
+#endif
+
 void CL_AddRef (CodeLabel* L, struct CodeEntry* E);
 /* Let the CodeEntry E reference the label L */
 
@@ -44,10 +44,12 @@
 #include "debugflag.h"
 #include "print.h"
 #include "strbuf.h"
+#include "thread.h"
 #include "xmalloc.h"
 #include "xsprintf.h"
 
 /* cc65 */
+#include "asmlabel.h"
 #include "codeent.h"
 #include "codeinfo.h"
 #include "codeopt.h"
@@ -55,9 +57,11 @@
 #include "coptbool.h"
 #include "coptc02.h"
 #include "coptcmp.h"
+#include "coptfunc.h"
 #include "coptind.h"
 #include "coptjmp.h"
 #include "coptlong.h"
+#include "coptloop.h"
 #include "coptmisc.h"
 #include "coptptrload.h"
 #include "coptptrstore.h"
@@ -72,6 +76,7 @@
 #include "error.h"
 #include "global.h"
 #include "output.h"
+#include "segments.h"
 
 
 
@@ -149,11 +154,14 @@ static OptFunc DOptJumpCascades = { OptJumpCascades, "OptJumpCascades", 100, 0,
 static OptFunc DOptJumpTarget1  = { OptJumpTarget1,  "OptJumpTarget1",  100, 0, 0, 0, 0, 0 };
 static OptFunc DOptJumpTarget2  = { OptJumpTarget2,  "OptJumpTarget2",  100, 0, 0, 0, 0, 0 };
 static OptFunc DOptJumpTarget3  = { OptJumpTarget3,  "OptJumpTarget3",  100, 0, 0, 0, 0, 0 };
+static OptFunc DOptLeafFrame    = { OptLeafFrame,    "OptLeafFrame",    100, 0, 0, 0, 0, 0 };
 static OptFunc DOptLoad1        = { OptLoad1,        "OptLoad1",        100, 0, 0, 0, 0, 0 };
 static OptFunc DOptLoad2        = { OptLoad2,        "OptLoad2",        200, 0, 0, 0, 0, 0 };
 static OptFunc DOptLoad3        = { OptLoad3,        "OptLoad3",          0, 0, 0, 0, 0, 0 };
 static OptFunc DOptLongAssign   = { OptLongAssign,   "OptLongAssign",   100, 0, 0, 0, 0, 0 };
 static OptFunc DOptLongCopy     = { OptLongCopy,     "OptLongCopy",     100, 0, 0, 0, 0, 0 };
+static OptFunc DOptLoopIndex    = { OptLoopIndex,    "OptLoopIndex",    100, 0, 0, 0, 0, 0 };
+static OptFunc DOptLoopInvariant= { OptLoopInvariant,"OptLoopInvariant",100, 0, 0, 0, 0, 0 };
 static OptFunc DOptNegAX1       = { OptNegAX1,       "OptNegAX1",       165, 0, 0, 0, 0, 0 };
 static OptFunc DOptNegAX2       = { OptNegAX2,       "OptNegAX2",       200, 0, 0, 0, 0, 0 };
 static OptFunc DOptPrecalc      = { OptPrecalc,      "OptPrecalc",      100, 0, 0, 0, 0, 0 };
@@ -209,6 +217,7 @@ static OptFunc DOptLoadStoreLoad= { OptLoadStoreLoad,"OptLoadStoreLoad",  0, 0,
 static OptFunc DOptSub1         = { OptSub1,         "OptSub1",         100, 0, 0, 0, 0, 0 };
 static OptFunc DOptSub2         = { OptSub2,         "OptSub2",         100, 0, 0, 0, 0, 0 };
 static OptFunc DOptSub3         = { OptSub3,         "OptSub3",         100, 0, 0, 0, 0, 0 };
+static OptFunc DOptTailCall     = { OptTailCall,     "OptTailCall",     100, 0, 0, 0, 0, 0 };
 static OptFunc DOptTest1        = { OptTest1,        "OptTest1",         65, 0, 0, 0, 0, 0 };
 static OptFunc DOptTest2        = { OptTest2,        "OptTest2",         50, 0, 0, 0, 0, 0 };
 static OptFunc DOptTransfers1   = { OptTransfers1,   "OptTransfers1",     0, 0, 0, 0, 0, 0 };
@@ -268,11 +277,14 @@ static OptFunc* OptFuncs[] = {
     &DOptJumpTarget1,
     &DOptJumpTarget2,
     &DOptJumpTarget3,
+    &DOptLeafFrame,
     &DOptLoad1,
     &DOptLoad2,
     &DOptLoad3,
     &DOptLongAssign,
     &DOptLongCopy,
+    &DOptLoopIndex,
+    &DOptLoopInvariant,
     &DOptNegAX1,
     &DOptNegAX2,
     &DOptPrecalc,
@@ -328,6 +340,7 @@ static OptFunc* OptFuncs[] = {
     &DOptSub1,
     &DOptSub2,
     &DOptSub3,
+    &DOptTailCall,
     &DOptTest1,
     &DOptTest2,
     &DOptTransfers1,
@@ -339,6 +352,19 @@ static OptFunc* OptFuncs[] = {
 };
 #define OPTFUNC_COUNT  (sizeof(OptFuncs) / sizeof(OptFuncs[0]))
 
+/* Lock protecting the step statistics while functions are optimized in
+** parallel. Zero when the optimizer runs in a single thread.
+*/
+static Mutex* StatsLock = 0;
+
+/* Work queue for parallel optimization */
+typedef struct OptQueue OptQueue;
+struct OptQueue {
+    const Collection*   Segs;           /* Code segments to optimize */
+    unsigned            Next;           /* Index of next segment to take */
+    Mutex*              Lock;           /* Protects Next */
+};
+
 
 
 static int CmpOptStep (const void* Key, const void* Func)
@@ -573,9 +599,9 @@ static unsigned RunOptFunc (CodeSeg* S, OptFunc* F, unsigned Max)
     unsigned Changes, C;
 
     /* Don't run the function if it is removed, disabled or prohibited by the
-    ** code size factor
+    ** code size factor (which is raised by the cycle weight)
     */
-    if (F->Func == 0 || F->Disabled || F->CodeSizeFactor > S->CodeSizeFactor) {
+    if (F->Func == 0 || F->Disabled || F->CodeSizeFactor > CS_GetSizeFactor (S)) {
         return 0;
     }
 
@@ -588,10 +614,16 @@ static unsigned RunOptFunc (CodeSeg* S, OptFunc* F, unsigned Max)
         Changes += C;
 
         /* Do statistics */
+        if (StatsLock) {
+            LockMutex (StatsLock);
+        }
         ++F->TotalRuns;
         ++F->LastRuns;
         F->TotalChanges += C;
         F->LastChanges  += C;
+        if (StatsLock) {
+            UnlockMutex (StatsLock);
+        }
 
         /* If we had changes, output stuff and regenerate register info */
         if (C) {
@@ -784,6 +816,11 @@ static unsigned RunOptGroup4 (CodeSeg* S)
     Changes += RunOptFunc (S, &DOptTransfers2, 1);
     Changes += RunOptFunc (S, &DOptLoad2, 1);
     Changes += RunOptFunc (S, &DOptLoad3, 1);
+    Changes += RunOptFunc (S, &DOptLoopIndex, 1);       /* After OptLoad2/3 */
+    Changes += RunOptFunc (S, &DOptLoopInvariant, 1);   /* After OptLoopIndex */
+    Changes += RunOptFunc (S, &DOptLeafFrame, 1);       /* After OptLoad2/3 */
+    Changes += RunOptFunc (S, &DOptTailCall, 1);
+    Changes += RunOptFunc (S, &DOptUnusedLoads, 1);
     Changes += RunOptFunc (S, &DOptDupLoads, 1);
 
     /* Return the number of changes */
@@ -912,28 +949,23 @@ static unsigned RunOptGroup7 (CodeSeg* S)
 
 
 
-void RunOpt (CodeSeg* S)
-/* Run the optimizer */
+static void PrintOptHeader (const CodeSeg* S)
+/* Print the name of the function we are working on */
 {
-    const char* StatFileName;
-
-    /* If we shouldn't run the optimizer, bail out */
-    if (!S->Optimize) {
-        return;
-    }
-
-    /* Check if we are requested to write optimizer statistics */
-    StatFileName = getenv ("CC65_OPTSTATS");
-    if (StatFileName) {
-        ReadOptStats (StatFileName);
-    }
-
-    /* Print the name of the function we are working on */
     if (S->Func) {
         Print (stdout, 1, "Running optimizer for function '%s'\n", S->Func->Name);
     } else {
         Print (stdout, 1, "Running optimizer for global code segment\n");
     }
+}
+
+
+
+static void RunOptGroups (CodeSeg* S)
+/* Run all optimizer groups for one code segment */
+{
+    /* Use the memory pool of the segment */
+    CodePool* OldPool = CP_Use (S->Pool);
 
     /* If requested, open an output file */
     OpenDebugFile (S);
@@ -954,13 +986,166 @@ void RunOpt (CodeSeg* S)
     /* Free register info */
     CS_FreeRegInfo (S);
 
+    /* Release the memory of the code that was removed */
+    CS_CompactCode (S);
+
     /* Close output file if necessary */
     if (DebugOptOutput) {
         CloseOutputFile ();
     }
 
+    CP_Use (OldPool);
+}
+
+
+
+void RunOpt (CodeSeg* S)
+/* Run the optimizer */
+{
+    const char* StatFileName;
+
+    /* If we shouldn't run the optimizer, bail out */
+    if (!S->Optimize) {
+        return;
+    }
+
+    /* Check if we are requested to write optimizer statistics */
+    StatFileName = getenv ("CC65_OPTSTATS");
+    if (StatFileName) {
+        ReadOptStats (StatFileName);
+    }
+
+    /* Print the name of the function we are working on */
+    PrintOptHeader (S);
+
+    /* Optimize the code */
+    RunOptGroups (S);
+
     /* Write statistics */
     if (StatFileName) {
         WriteOptStats (StatFileName);
     }
 }
+
+
+
+static void OptWorker (void* Data)
+/* Thread function: Take code segments from the queue and optimize them */
+{
+    OptQueue* Q = Data;
+
+    while (1) {
+
+        CodeSeg* S;
+        unsigned I;
+
+        /* Get the next segment */
+        LockMutex (Q->Lock);
+        I = Q->Next++;
+        UnlockMutex (Q->Lock);
+        if (I >= CollCount (Q->Segs)) {
+            break;
+        }
+        S = CollAtUnchecked (Q->Segs, I);
+
+        /* New labels are taken from the function's own label pool, so the
+        ** label numbers don't depend on the order of optimization.
+        */
+        if (S->Func) {
+            UseLabelPoolFromSegments (S->Func->V.F.Seg);
+        }
+        RunOptGroups (S);
+    }
+}
+
+
+
+void RunOptList (const Collection* Segs, unsigned Jobs)
+/* Run the optimizer for all code segments in Segs. The segments must belong
+** to functions. If Jobs is greater than one, the segments are distributed
+** over that many threads. The generated code is the same in both cases.
+*/
+{
+    Collection  Work = AUTO_COLLECTION_INITIALIZER;
+    OptQueue    Q;
+    Thread**    Workers;
+    const char* StatFileName;
+    unsigned    I;
+
+    /* Output of the debug options is written per step and cannot be
+    ** interleaved, so run single threaded in this case.
+    */
+    if (!HAVE_THREADS || Debug || DebugOptOutput) {
+        Jobs = 1;
+    }
+
+    if (Jobs <= 1) {
+        for (I = 0; I < CollCount (Segs); ++I) {
+            CodeSeg* S = CollAtUnchecked (Segs, I);
+            if (S->Func) {
+                UseLabelPoolFromSegments (S->Func->V.F.Seg);
+            }
+            RunOpt (S);
+        }
+        return;
+    }
+
+    /* Collect the segments to optimize and print the headers in the order
+    ** of the functions.
+    */
+    for (I = 0; I < CollCount (Segs); ++I) {
+        CodeSeg* S = CollAtUnchecked (Segs, I);
+        if (S->Optimize) {
+            PrintOptHeader (S);
+            CollAppend (&Work, S);
+        }
+    }
+
+    /* Don't start more threads than there is work */
+    if (Jobs > CollCount (&Work)) {
+        Jobs = CollCount (&Work);
+    }
+
+    /* The statistics file is read and written once for the whole batch */
+    StatFileName = getenv ("CC65_OPTSTATS");
+    if (StatFileName) {
+        ReadOptStats (StatFileName);
+    }
+
+    /* Start the workers and wait until they're done */
+    Q.Segs = &Work;
+    Q.Next = 0;
+    Q.Lock = NewMutex ();
+    StatsLock = NewMutex ();
+    Workers = xmalloc (Jobs * sizeof (Thread*));
+    for (I = 0; I < Jobs; ++I) {
+        Workers[I] = NewThread (OptWorker, &Q);
+    }
+    for (I = 0; I < Jobs; ++I) {
+        JoinThread (Workers[I]);
+    }
+    xfree (Workers);
+    FreeMutex (StatsLock);
+    StatsLock = 0;
+    FreeMutex (Q.Lock);
+
+    if (StatFileName) {
+        WriteOptStats (StatFileName);
+    }
+
+    DoneCollection (&Work);
+}
+
+
+
+void ResetOptStats (void)
+/* Reset the statistics of the last run, so the statistics file contains the
+** numbers for the next translation unit only.
+*/
+{
+    unsigned I;
+    for (I = 0; I < OPTFUNC_COUNT; ++I) {
+        OptFuncs[I]->LastRuns    = 0;
+        OptFuncs[I]->LastChanges = 0;
+    }
+}
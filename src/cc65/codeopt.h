@@ -62,6 +62,17 @@ void ListOptSteps (FILE* F);
 void RunOpt (CodeSeg* S);
 /* Run the optimizer */
 
+void RunOptList (const Collection* Segs, unsigned Jobs);
+/* Run the optimizer for all code segments in Segs. The segments must belong
+** to functions. If Jobs is greater than one, the segments are distributed
+** over that many threads. The generated code is the same in both cases.
+*/
+
+void ResetOptStats (void);
+/* Reset the statistics of the last run, so the statistics file contains the
+** numbers for the next translation unit only.
+*/
+
 
 
 /* End of codeopt.h */
@@ -260,7 +260,7 @@ static int Affected (LoadRegInfo* LRI, const CodeEntry* E)
                 goto L_Affected;
             }
             /* We have to manually set up the use/chg flags for builtin functions */
-            ZI = GetZPInfo (AE->ArgBase);
+            ZI = GetArgZPInfo (AE->ArgBase);
             if (ZI != 0) {
                 UseToCheck |= ZI->ByteUse;
                 ChgToCheck |= ZI->ByteUse;
@@ -285,7 +285,7 @@ static int Affected (LoadRegInfo* LRI, const CodeEntry* E)
                 goto L_Affected;
             }
             /* We have to manually set up the use/chg flags for builtin functions */
-            ZI = GetZPInfo (YE->ArgBase);
+            ZI = GetArgZPInfo (YE->ArgBase);
             if (ZI != 0) {
                 UseToCheck |= ZI->ByteUse;
                 ChgToCheck |= ZI->ByteUse;
@@ -301,7 +301,7 @@ static int Affected (LoadRegInfo* LRI, const CodeEntry* E)
 
     if (E->OPC == OP65_JSR || E->OPC == OP65_JSL) {
         /* Try to know about the function */
-        fncls = GetFuncInfo (E->Arg, &Use, &Chg);
+        fncls = GetArgFuncInfo (E->Arg, &Use, &Chg);
         if (fncls == FNCLS_BUILTIN) {
             /* Builtin functions are usually harmless */
             if ((ChgToCheck & Use & REG_ALL) != 0) {
@@ -340,7 +340,7 @@ static int Affected (LoadRegInfo* LRI, const CodeEntry* E)
                          (AE->AM != AM65_ZP_INDY ||
                           strcmp (AE->ArgBase, "sp") != 0)) ||
                          (AE->ArgOff == E->ArgOff &&
-                          strcmp (AE->ArgBase, E->ArgBase) == 0)) {
+                          AE->ArgBase == E->ArgBase)) {
 
                         if ((E->Info & OF_READ) != 0) {
                             /* Used */
@@ -358,7 +358,7 @@ static int Affected (LoadRegInfo* LRI, const CodeEntry* E)
                     ** used by Y, we just assume all.
                     */
                     if (YE == 0 ||
-                        (YE->ArgOff == E->ArgOff && strcmp (YE->ArgBase, E->ArgBase) == 0)) {
+                        (YE->ArgOff == E->ArgOff && YE->ArgBase == E->ArgBase)) {
 
                         if ((E->Info & OF_READ) != 0) {
                             /* Used */
@@ -1230,7 +1230,7 @@ int HarmlessCall (const CodeEntry* E, int PushedBytes)
 */
 {
     unsigned Use = 0, Chg = 0;
-    if (GetFuncInfo (E->Arg, &Use, &Chg) == FNCLS_BUILTIN) {
+    if (GetArgFuncInfo (E->Arg, &Use, &Chg) == FNCLS_BUILTIN) {
         if ((Chg & REG_SP) != 0) {
             return 0;
         }
@@ -2541,7 +2541,7 @@ int BackupArgAfter (CodeSeg* S, BackupInfo* B, int Idx, const CodeEntry* E, Coll
         }
     } else if (E->OPC == OP65_JSR || E->OPC == OP65_JSL) {
         /* For function calls we load their arguments instead */
-        GetFuncInfo (E->Arg, &Use, &Chg);
+        GetArgFuncInfo (E->Arg, &Use, &Chg);
         if ((Use & ~REG_AXY) == 0) {
             if (Use == REG_A) {
                 ArgSize = BU_B8;
@@ -2613,7 +2613,7 @@ static int LoadAAt (CodeSeg* S, int Idx, const LoadRegInfo* LRI, Collection* Ind
     } else if (E->OPC == OP65_JSR || E->OPC == OP65_JSL) {
 
         /* For other function calls we load their arguments instead */
-        GetFuncInfo (E->Arg, &Use, &Chg);
+        GetArgFuncInfo (E->Arg, &Use, &Chg);
         if ((Use & ~REG_AXY) == 0) {
             if (Use == REG_X) {
                 X = NewCodeEntry (OP65_TXA, AM65_IMP, 0, 0, E->LI);
@@ -2706,7 +2706,7 @@ static int LoadXAt (CodeSeg* S, int Idx, const LoadRegInfo* LRI, Collection* Ind
         }
     } else if (E->OPC == OP65_JSR || E->OPC == OP65_JSL) {
         /* For function calls we load their arguments instead */
-        GetFuncInfo (E->Arg, &Use, &Chg);
+        GetArgFuncInfo (E->Arg, &Use, &Chg);
         if ((Use & ~REG_AXY) == 0) {
             if (Use == REG_A) {
                 X = NewCodeEntry (OP65_TAY, AM65_IMP, 0, 0, E->LI);
@@ -2799,7 +2799,7 @@ static int LoadYAt (CodeSeg* S, int Idx, const LoadRegInfo* LRI, Collection* Ind
         }
     } else if (E->OPC == OP65_JSR || E->OPC == OP65_JSL) {
         /* For function calls we load their arguments instead */
-        GetFuncInfo (E->Arg, &Use, &Chg);
+        GetArgFuncInfo (E->Arg, &Use, &Chg);
         if ((Use & ~REG_AXY) == 0) {
             if (Use == REG_A) {
                 X = NewCodeEntry (OP65_TAY, AM65_IMP, 0, 0, E->LI);
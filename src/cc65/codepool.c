@@ -0,0 +1,395 @@
+/*****************************************************************************/
+/*                                                                           */
+/*                                codepool.c                                 */
+/*                                                                           */
+/*             Memory pools for code entries, labels and reg infos           */
+/*                                                                           */
+/*                                                                           */
+/*                                                                           */
+/* Copyright 2026 The cc65 Authors                                           */
+/*                                                                           */
+/*                                                                           */
+/* This software is provided 'as-is', without any expressed or implied       */
+/* warranty.  In no event will the authors be held liable for any damages    */
+/* arising from the use of this software.                                    */
+/*                                                                           */
+/* Permission is granted to anyone to use this software for any purpose,     */
+/* including commercial applications, and to alter it and redistribute it    */
+/* freely, subject to the following restrictions:                            */
+/*                                                                           */
+/* 1. The origin of this software must not be misrepresented; you must not   */
+/*    claim that you wrote the original software. If you use this software   */
+/*    in a product, an acknowledgment in the product documentation would be  */
+/*    appreciated but is not required.                                       */
+/* 2. Altered source versions must be plainly marked as such, and must not   */
+/*    be misrepresented as being the original software.                      */
+/* 3. This notice may not be removed or altered from any source              */
+/*    distribution.                                                          */
+/*                                                                           */
+/*****************************************************************************/
+
+
+
+#include <stddef.h>
+#include <string.h>
+
+/* common */
+#include "check.h"
+#include "hashfunc.h"
+#include "thread.h"
+#include "xmalloc.h"
+
+/* cc65 */
+#include "codepool.h"
+
+
+
+/*****************************************************************************/
+/*                                   Data                                    */
+/*****************************************************************************/
+
+
+
+/* Blocks up to CP_MAX_SIZE are taken from the pool, rounded up to a multiple
+** of CP_GRANULARITY. Larger blocks come from the heap.
+*/
+#define CP_GRANULARITY  8U
+#define CP_MAX_SIZE     256U
+#define CP_CLASS_COUNT  (CP_MAX_SIZE / CP_GRANULARITY)
+
+/* Size of the memory chunks. Small functions need little memory, so start
+** small and double the chunk size up to the maximum.
+*/
+#define CP_MIN_CHUNK    1024U
+#define CP_MAX_CHUNK    65536U
+
+/* A chunk of memory. The data follows the header. */
+typedef union CPChunk CPChunk;
+union CPChunk {
+    CPChunk*    Next;                   /* Next chunk in list */
+    double      Align;                  /* Force alignment of the data */
+    void*       AlignPtr;
+};
+
+/* A free block in one of the free lists */
+typedef struct CPFree CPFree;
+struct CPFree {
+    CPFree*     Next;
+};
+
+/* An interned string. The characters follow the header. */
+typedef struct CPString CPString;
+struct CPString {
+    CPString*   Next;                   /* Next in hash chain */
+    unsigned    Hash;                   /* Hash over the string */
+    CPStrInfo   Info;                   /* Cached information */
+    char        Str[1];                 /* The string, dynamically allocated */
+};
+
+/* Initial size of the string hash table, it is doubled when needed */
+#define CP_MIN_STRTAB   64U
+
+struct CodePool {
+    CPFree*         FreeList[CP_CLASS_COUNT];   /* Free lists per size class */
+    CPChunk*        Chunks;                     /* List of chunks */
+    char*           Cur;                        /* Free space in last chunk */
+    char*           End;                        /* End of last chunk */
+    unsigned        ChunkSize;                  /* Size of the next chunk */
+    unsigned long   FreeBytes;                  /* Bytes in the free lists */
+    CPString**      StrTab;                     /* Hash table for strings */
+    unsigned        StrTabSize;                 /* Size of the hash table */
+    unsigned        StrCount;                   /* Number of strings */
+
+    /* Statistics */
+    unsigned long   ChunkCount;                 /* Number of chunks */
+    unsigned long   ChunkBytes;                 /* Total size of chunks */
+    unsigned long   Allocs;                     /* Blocks allocated */
+    unsigned long   Reused;                     /* Blocks taken from free lists */
+};
+
+/* Pool used by the calling thread */
+static THREAD_LOCAL CodePool* CurPool = 0;
+
+/* Statistics for all released pools. Pools may be released by optimizer
+** threads, so the statistics are protected by a lock. It is created with
+** the first pool, which is always done by the main thread.
+*/
+static Mutex*        StatsLock      = 0;
+static unsigned long PoolCount      = 0;
+static unsigned long PoolChunks     = 0;
+static unsigned long PoolBytes      = 0;
+static unsigned long PoolMaxBytes   = 0;
+static unsigned long PoolAllocs     = 0;
+static unsigned long PoolReused     = 0;
+
+
+
+/*****************************************************************************/
+/*                                   Code                                    */
+/*****************************************************************************/
+
+
+
+CodePool* NewCodePool (unsigned long Size)
+/* Create a new, empty code pool. Size is the expected amount of memory used
+** by the pool, it is used for the size of the first chunk. Zero means that
+** the size is unknown.
+*/
+{
+    CodePool* P = xmalloc (sizeof (CodePool));
+    if (StatsLock == 0) {
+        StatsLock = NewMutex ();
+    }
+    memset (P->FreeList, 0, sizeof (P->FreeList));
+    P->Chunks       = 0;
+    P->Cur          = 0;
+    P->End          = 0;
+    P->ChunkSize    = Size < CP_MIN_CHUNK? CP_MIN_CHUNK : (unsigned) Size;
+    P->FreeBytes    = 0;
+    P->StrTab       = 0;
+    P->StrTabSize   = 0;
+    P->StrCount     = 0;
+    P->ChunkCount   = 0;
+    P->ChunkBytes   = 0;
+    P->Allocs       = 0;
+    P->Reused       = 0;
+    return P;
+}
+
+
+
+void FreeCodePool (CodePool* P)
+/* Release all memory of the pool at once. Objects allocated from the pool
+** must not be used after this.
+*/
+{
+    CPChunk* C = P->Chunks;
+    while (C) {
+        CPChunk* Next = C->Next;
+        xfree (C);
+        C = Next;
+    }
+    xfree (P->StrTab);
+
+    /* Remember the statistics */
+    LockMutex (StatsLock);
+    ++PoolCount;
+    PoolChunks += P->ChunkCount;
+    PoolBytes  += P->ChunkBytes;
+    PoolAllocs += P->Allocs;
+    PoolReused += P->Reused;
+    if (P->ChunkBytes > PoolMaxBytes) {
+        PoolMaxBytes = P->ChunkBytes;
+    }
+    UnlockMutex (StatsLock);
+
+    xfree (P);
+}
+
+
+
+CodePool* CP_Use (CodePool* P)
+/* Make P the current pool for the calling thread and return the pool that
+** was current before. P may be NULL, in which case memory is allocated from
+** the heap.
+*/
+{
+    CodePool* Old = CurPool;
+    CurPool = P;
+    return Old;
+}
+
+
+
+CodePool* CP_Current (void)
+/* Return the current pool of the calling thread */
+{
+    return CurPool;
+}
+
+
+
+static void* AllocFromChunk (CodePool* P, unsigned Size)
+/* Take Size bytes from the last chunk of the pool, allocating a new chunk if
+** needed. Size must be a multiple of CP_GRANULARITY.
+*/
+{
+    if ((unsigned long) (P->End - P->Cur) < Size) {
+        unsigned ChunkSize = P->ChunkSize < Size? Size : P->ChunkSize;
+        CPChunk* C = xmalloc (sizeof (CPChunk) + ChunkSize);
+        C->Next   = P->Chunks;
+        P->Chunks = C;
+        P->Cur    = (char*) (C + 1);
+        P->End    = P->Cur + ChunkSize;
+        ++P->ChunkCount;
+        P->ChunkBytes += ChunkSize;
+        if (P->ChunkSize < CP_MAX_CHUNK / 2) {
+            P->ChunkSize *= 2;
+        } else {
+            P->ChunkSize = CP_MAX_CHUNK;
+        }
+    }
+    P->Cur += Size;
+    return P->Cur - Size;
+}
+
+
+
+static void GrowStrTab (CodePool* P)
+/* Double the size of the string hash table */
+{
+    unsigned   NewSize = P->StrTabSize? P->StrTabSize * 2 : CP_MIN_STRTAB;
+    CPString** NewTab  = xmalloc (NewSize * sizeof (CPString*));
+    unsigned   I;
+
+    memset (NewTab, 0, NewSize * sizeof (CPString*));
+    for (I = 0; I < P->StrTabSize; ++I) {
+        CPString* S = P->StrTab[I];
+        while (S) {
+            CPString* Next = S->Next;
+            S->Next = NewTab[S->Hash % NewSize];
+            NewTab[S->Hash % NewSize] = S;
+            S = Next;
+        }
+    }
+    xfree (P->StrTab);
+    P->StrTab     = NewTab;
+    P->StrTabSize = NewSize;
+}
+
+
+
+unsigned long CP_GetUnusedBytes (const CodePool* P)
+/* Return the number of bytes held by the pool that are not allocated */
+{
+    return P->FreeBytes + (unsigned long) (P->End - P->Cur);
+}
+
+
+
+unsigned long CP_GetUsedBytes (const CodePool* P)
+/* Return the number of bytes in blocks that are currently allocated */
+{
+    return P->ChunkBytes - CP_GetUnusedBytes (P);
+}
+
+
+
+void* CP_Alloc (unsigned Size)
+/* Allocate Size bytes from the current pool */
+{
+    CodePool* P = CurPool;
+    unsigned  Class;
+
+    if (P == 0 || Size > CP_MAX_SIZE) {
+        return xmalloc (Size);
+    }
+
+    /* Use a free block of the size class if we have one */
+    Class = (Size + CP_GRANULARITY - 1) / CP_GRANULARITY - (Size > 0);
+    ++P->Allocs;
+    if (P->FreeList[Class]) {
+        CPFree* F = P->FreeList[Class];
+        P->FreeList[Class] = F->Next;
+        P->FreeBytes -= (Class + 1) * CP_GRANULARITY;
+        ++P->Reused;
+        return F;
+    }
+
+    /* Take the block from the last chunk */
+    return AllocFromChunk (P, (Class + 1) * CP_GRANULARITY);
+}
+
+
+
+void CP_Free (void* Block, unsigned Size)
+/* Return a block of the given size to the current pool */
+{
+    CodePool* P = CurPool;
+    unsigned  Class;
+    CPFree*   F;
+
+    if (P == 0 || Size > CP_MAX_SIZE) {
+        xfree (Block);
+        return;
+    }
+
+    Class = (Size + CP_GRANULARITY - 1) / CP_GRANULARITY - (Size > 0);
+    F = Block;
+    F->Next = P->FreeList[Class];
+    P->FreeList[Class] = F;
+    P->FreeBytes += (Class + 1) * CP_GRANULARITY;
+}
+
+
+
+char* CP_Intern (const char* S)
+/* Return the copy of S in the current pool, creating it if there is none.
+** Equal strings have the same address within a pool, so they may be compared
+** by pointer. Interned strings must not be changed, and they live as long as
+** the pool.
+*/
+{
+    CodePool* P = CurPool;
+    unsigned  Hash = HashStr (S);
+    unsigned  Len;
+    CPString* N;
+
+    /* Interned strings are never freed, so there must be a pool */
+    CHECK (P != 0);
+
+    /* Search for the string */
+    if (P->StrTabSize > 0) {
+        N = P->StrTab[Hash % P->StrTabSize];
+        while (N) {
+            if (N->Hash == Hash && strcmp (N->Str, S) == 0) {
+                return N->Str;
+            }
+            N = N->Next;
+        }
+    }
+
+    /* Not found, grow the table if it is getting crowded */
+    if (P->StrCount >= P->StrTabSize) {
+        GrowStrTab (P);
+    }
+
+    /* Create a new entry */
+    Len = strlen (S);
+    N = AllocFromChunk (P, (offsetof (CPString, Str) + Len + CP_GRANULARITY) &
+                           ~(CP_GRANULARITY - 1));
+    N->Hash       = Hash;
+    N->Info.Flags = 0;
+    memcpy (N->Str, S, Len + 1);
+    N->Next = P->StrTab[Hash % P->StrTabSize];
+    P->StrTab[Hash % P->StrTabSize] = N;
+    ++P->StrCount;
+
+    /* Return the copy */
+    return N->Str;
+}
+
+
+
+CPStrInfo* CP_GetStrInfo (const char* S)
+/* Return the info for a string returned by CP_Intern */
+{
+    return &((CPString*) (S - offsetof (CPString, Str)))->Info;
+}
+
+
+
+void PrintCodePoolStats (FILE* F)
+/* Print statistics about the released code pools */
+{
+    fprintf (F,
+             "\n"
+             "Code pool statistics:\n"
+             "  Pools released:     %9lu\n"
+             "  Chunks:             %9lu\n"
+             "  Chunk bytes:        %9lu (max %lu per pool)\n"
+             "  Blocks allocated:   %9lu\n"
+             "  Blocks reused:      %9lu\n",
+             PoolCount, PoolChunks, PoolBytes, PoolMaxBytes,
+             PoolAllocs, PoolReused);
+}
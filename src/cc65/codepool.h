@@ -0,0 +1,138 @@
+/*****************************************************************************/
+/*                                                                           */
+/*                                codepool.h                                 */
+/*                                                                           */
+/*             Memory pools for code entries, labels and reg infos           */
+/*                                                                           */
+/*                                                                           */
+/*                                                                           */
+/* Copyright 2026 The cc65 Authors                                           */
+/*                                                                           */
+/*                                                                           */
+/* This software is provided 'as-is', without any expressed or implied       */
+/* warranty.  In no event will the authors be held liable for any damages    */
+/* arising from the use of this software.                                    */
+/*                                                                           */
+/* Permission is granted to anyone to use this software for any purpose,     */
+/* including commercial applications, and to alter it and redistribute it    */
+/* freely, subject to the following restrictions:                            */
+/*                                                                           */
+/* 1. The origin of this software must not be misrepresented; you must not   */
+/*    claim that you wrote the original software. If you use this software   */
+/*    in a product, an acknowledgment in the product documentation would be  */
+/*    appreciated but is not required.                                       */
+/* 2. Altered source versions must be plainly marked as such, and must not   */
+/*    be misrepresented as being the original software.                      */
+/* 3. This notice may not be removed or altered from any source              */
+/*    distribution.                                                          */
+/*                                                                           */
+/*****************************************************************************/
+
+
+
+/* Each code segment owns a pool. The code entries, labels and register infos
+** of the segment are allocated from size class free lists in the pool, and
+** argument strings and label names are interned in the pool. The whole pool
+** is released at once after the segment has been output. Since deleted
+** blocks stay in the pool, the live objects of a segment are moved to a new
+** pool of the right size after code generation and after optimization (see
+** CS_CompactCode).
+** Since the allocation functions of code entries and labels don't know the
+** segment, they use the pool that is current for the calling thread. The
+** code segment layer makes the pool of a segment current while code for the
+** segment is generated or optimized.
+*/
+
+
+
+#ifndef CODEPOOL_H
+#define CODEPOOL_H
+
+
+
+#include <stdio.h>
+
+
+
+/*****************************************************************************/
+/*                                   Data                                    */
+/*****************************************************************************/
+
+
+
+typedef struct CodePool CodePool;
+
+/* Information derived from an interned string. It is computed by the users
+** of the string when first needed and then kept with the string.
+*/
+typedef struct CPStrInfo CPStrInfo;
+struct CPStrInfo {
+    unsigned            Flags;          /* CPSI_xxx, which fields are valid */
+    int                 FuncClass;      /* Class of a function with this name */
+    unsigned            FuncUse;        /* Registers used by the function */
+    unsigned            FuncChg;        /* Registers changed by the function */
+    const struct ZPInfo* ZP;            /* Zero page info or NULL */
+};
+
+/* Flags for CPStrInfo */
+#define CPSI_FUNC       0x01U           /* FuncClass, FuncUse, FuncChg valid */
+#define CPSI_ZP         0x02U           /* ZP valid */
+
+
+
+/*****************************************************************************/
+/*                                   Code                                    */
+/*****************************************************************************/
+
+
+
+CodePool* NewCodePool (unsigned long Size);
+/* Create a new, empty code pool. Size is the expected amount of memory used
+** by the pool, it is used for the size of the first chunk. Zero means that
+** the size is unknown.
+*/
+
+void FreeCodePool (CodePool* P);
+/* Release all memory of the pool at once. Objects allocated from the pool
+** must not be used after this.
+*/
+
+CodePool* CP_Use (CodePool* P);
+/* Make P the current pool for the calling thread and return the pool that
+** was current before. P may be NULL, in which case memory is allocated from
+** the heap.
+*/
+
+CodePool* CP_Current (void);
+/* Return the current pool of the calling thread */
+
+unsigned long CP_GetUnusedBytes (const CodePool* P);
+/* Return the number of bytes held by the pool that are not allocated */
+
+unsigned long CP_GetUsedBytes (const CodePool* P);
+/* Return the number of bytes in blocks that are currently allocated */
+
+void* CP_Alloc (unsigned Size);
+/* Allocate Size bytes from the current pool */
+
+void CP_Free (void* Block, unsigned Size);
+/* Return a block of the given size to the current pool */
+
+char* CP_Intern (const char* S);
+/* Return the copy of S in the current pool, creating it if there is none.
+** Equal strings have the same address within a pool, so they may be compared
+** by pointer. Interned strings must not be changed, and they live as long as
+** the pool.
+*/
+
+CPStrInfo* CP_GetStrInfo (const char* S);
+/* Return the info for a string returned by CP_Intern */
+
+void PrintCodePoolStats (FILE* F);
+/* Print statistics about the released code pools */
+
+
+
+/* End of codepool.h */
+
+#endif
@@ -33,6 +33,7 @@
 
 
 
+#include <limits.h>
 #include <string.h>
 #include <ctype.h>
 
@@ -48,6 +49,7 @@
 
 /* cc65 */
 #include "asmlabel.h"
+#include "codecfg.h"
 #include "codeent.h"
 #include "codeinfo.h"
 #include "codeseg.h"
@@ -60,6 +62,17 @@
 
 
 
+/*****************************************************************************/
+/*                                   Data                                    */
+/*****************************************************************************/
+
+
+
+/* Maximum number of runs over the blocks when generating register infos */
+#define MAX_REGINFO_PASSES      16
+
+
+
 /*****************************************************************************/
 /*                             Helper functions                              */
 /*****************************************************************************/
@@ -144,8 +157,13 @@ static CodeLabel* CS_FindLabel (CodeSeg* S, const char* Name, unsigned Hash)
 static CodeLabel* CS_NewCodeLabel (CodeSeg* S, const char* Name, unsigned Hash)
 /* Create a new label and insert it into the label hash table */
 {
+    CodeLabel* L;
+
+    /* Labels are allocated from the pool of the segment */
+    CHECK (CP_Current () == S->Pool);
+
     /* Create a new label */
-    CodeLabel* L = NewCodeLabel (Name, Hash);
+    L = NewCodeLabel (Name, Hash);
 
     /* Enter the label into the hash table */
     L->Next = S->LabelHash[L->Hash];
@@ -512,6 +530,7 @@ CodeSeg* NewCodeSeg (const char* SegName, SymEntry* Func)
     /* Initialize the fields */
     S->SegName  = xstrdup (SegName);
     S->Func     = Func;
+    S->Pool     = NewCodePool (0);
     InitCollection (&S->Entries);
     InitCollection (&S->Labels);
     for (I = 0; I < sizeof(S->LabelHash) / sizeof(S->LabelHash[0]); ++I) {
@@ -534,6 +553,7 @@ CodeSeg* NewCodeSeg (const char* SegName, SymEntry* Func)
     /* Copy the global optimization settings */
     S->Optimize       = (unsigned char) IS_Get (&Optimize);
     S->CodeSizeFactor = (unsigned) IS_Get (&CodeSizeFactor);
+    S->CycleWeight    = (unsigned) IS_Get (&CycleWeight);
 
     /* Return the new struct */
     return S;
@@ -544,6 +564,9 @@ CodeSeg* NewCodeSeg (const char* SegName, SymEntry* Func)
 void CS_AddEntry (CodeSeg* S, struct CodeEntry* E)
 /* Add an entry to the given code segment */
 {
+    /* The entry must have been allocated from the pool of the segment */
+    CHECK (CP_Current () == S->Pool);
+
     /* Transfer the labels if we have any */
     CS_MoveLabelsToEntry (S, E);
 
@@ -617,6 +640,9 @@ void CS_InsertEntry (CodeSeg* S, struct CodeEntry* E, unsigned Index)
 ** moved to slots with higher indices.
 */
 {
+    /* The entry must have been allocated from the pool of the segment */
+    CHECK (CP_Current () == S->Pool);
+
     /* Insert the entry into the collection */
     CollInsert (&S->Entries, E, Index);
 }
@@ -634,6 +660,9 @@ void CS_DelEntry (CodeSeg* S, unsigned Index)
     /* Get the code entry for the given index */
     CodeEntry* E = CS_GetEntry (S, Index);
 
+    /* The entry is returned to the pool of the segment */
+    CHECK (CP_Current () == S->Pool);
+
     /* If the entry has a labels, we have to move this label to the next insn.
     ** If there is no next insn, move the label into the code segement label
     ** pool. The operation is further complicated by the fact that the next
@@ -887,11 +916,36 @@ CodeLabel* CS_GenLabel (CodeSeg* S, struct CodeEntry* E)
 
 
 
+void CS_SetIndirectLabel (CodeSeg* S, const char* Name)
+/* Mark the code label with the given name as used in data, for example in a
+** jump table. Such a label may be reached by jumps the optimizer doesn't see,
+** so it is never removed, and the code following it is never assumed to be
+** unreachable. The label is created if it does not exist.
+*/
+{
+    /* Calculate the hash from the name */
+    unsigned Hash = HashStr (Name) % CS_LABEL_HASH_SIZE;
+
+    /* Find the label or create a new one */
+    CodeLabel* L = CS_FindLabel (S, Name, Hash);
+    if (L == 0) {
+        L = CS_NewCodeLabel (S, Name, Hash);
+    }
+
+    /* Mark it */
+    L->Flags |= CLF_INDIRECT;
+}
+
+
+
 void CS_DelLabel (CodeSeg* S, CodeLabel* L)
 /* Remove references from this label and delete it. */
 {
     unsigned Count, I;
 
+    /* The label is returned to the pool of the segment */
+    CHECK (CP_Current () == S->Pool);
+
     /* First, remove the label from the hash chain */
     CS_RemoveLabelFromHash (S, L);
 
@@ -928,6 +982,9 @@ void CS_MergeLabels (CodeSeg* S)
     unsigned I;
     unsigned J;
 
+    /* Labels are returned to the pool of the segment */
+    CHECK (CP_Current () == S->Pool);
+
     /* First, remove all labels from the label symbol table that don't have an
     ** owner (this means that they are actually external labels but we didn't
     ** know that previously since they may have also been forward references).
@@ -1001,15 +1058,19 @@ void CS_MergeLabels (CodeSeg* S)
             /* Move all references from this label to the reference label */
             CL_MoveRefs (L, RefLab);
 
-            /* Remove the label completely. */
-            CS_DelLabel (S, L);
+            /* Remove the label completely. Labels used in data must stay,
+            ** since they are referenced by name.
+            */
+            if (!CL_IsIndirect (L)) {
+                CS_DelLabel (S, L);
+            }
         }
 
         /* The reference label is the only remaining label. Check if there
         ** are any references to this label, and delete it if this is not
         ** the case.
         */
-        if (CollCount (&RefLab->JumpFrom) == 0) {
+        if (CollCount (&RefLab->JumpFrom) == 0 && !CL_IsIndirect (RefLab)) {
             /* Delete the label */
             CS_DelLabel (S, RefLab);
         }
@@ -1041,8 +1102,12 @@ void CS_MoveLabels (CodeSeg* S, struct CodeEntry* Old, struct CodeEntry* New)
             /* Move references */
             CL_MoveRefs (OldLabel, NewLabel);
 
-            /* Delete the label */
-            CS_DelLabel (S, OldLabel);
+            /* Delete the label. A label used in data is moved instead. */
+            if (CL_IsIndirect (OldLabel)) {
+                CE_MoveLabel (OldLabel, New);
+            } else {
+                CS_DelLabel (S, OldLabel);
+            }
 
         }
 
@@ -1079,7 +1144,7 @@ void CS_RemoveLabelRef (CodeSeg* S, struct CodeEntry* E)
     CE_ClearJumpTo (E);
 
     /* If there are no more references, delete the label */
-    if (CollCount (&L->JumpFrom) == 0) {
+    if (CollCount (&L->JumpFrom) == 0 && !CL_IsIndirect (L)) {
         CS_DelLabel (S, L);
     }
 }
@@ -1102,7 +1167,7 @@ void CS_MoveLabelRef (CodeSeg* S, struct CodeEntry* E, CodeLabel* L)
     CollDeleteItem (&OldLabel->JumpFrom, E);
 
     /* If there are no more references, delete the label */
-    if (CollCount (&OldLabel->JumpFrom) == 0) {
+    if (CollCount (&OldLabel->JumpFrom) == 0 && !CL_IsIndirect (OldLabel)) {
         CS_DelLabel (S, OldLabel);
     }
 
@@ -1122,6 +1187,9 @@ void CS_DelCodeRange (CodeSeg* S, unsigned First, unsigned Last)
     unsigned   I;
     CodeEntry* FirstEntry;
 
+    /* The entries are returned to the pool of the segment */
+    CHECK (CP_Current () == S->Pool);
+
     /* Do some sanity checks */
     CHECK (First <= Last && Last < CS_GetEntryCount (S));
 
@@ -1198,6 +1266,9 @@ void CS_DelCodeAfter (CodeSeg* S, unsigned Last)
     /* Get the number of entries in this segment */
     unsigned Count = CS_GetEntryCount (S);
 
+    /* The entries are returned to the pool of the segment */
+    CHECK (CP_Current () == S->Pool);
+
     /* First pass: Delete all references to labels. If the reference count
     ** for a label drops to zero, delete it.
     */
@@ -1301,6 +1372,12 @@ int CS_IsBasicBlock (CodeSeg* S, unsigned First, unsigned Last)
             */
             unsigned RefCount = CL_GetRefCount (L);
             unsigned RefIndex;
+
+            /* A label used in data may be reached from anywhere */
+            if (CL_IsIndirect (L)) {
+                CS_ResetMarks (S, First, Last);
+                return 0;
+            }
             for (RefIndex = 0; RefIndex < RefCount; ++RefIndex) {
 
                 /* Get the code entry that jumps here */
@@ -1372,6 +1449,37 @@ int CS_IsBasicBlock (CodeSeg* S, unsigned First, unsigned Last)
 
 
 
+unsigned CS_GetSizeFactor (const CodeSeg* S)
+/* Return the code size factor for the segment. With a cycle weight, larger
+** code is accepted: A weight of 50 doubles the factor, a weight of 100 lifts
+** any limit.
+*/
+{
+    if (S->CycleWeight >= 100) {
+        return UINT_MAX;
+    }
+    return S->CodeSizeFactor * 100 / (100 - S->CycleWeight);
+}
+
+
+
+int CS_PreferCode (const CodeSeg* S, unsigned NewSize, unsigned NewCycles,
+                   unsigned OldSize, unsigned OldCycles, int Default)
+/* Return true if code with NewSize bytes and NewCycles cycles should replace
+** code with OldSize bytes and OldCycles cycles. If the segment doesn't have a
+** cycle weight, Default is returned, which should be the decision of the
+** size factor based heuristics of the caller.
+*/
+{
+    if (S->CycleWeight == 0) {
+        return Default;
+    }
+    return GetCodeCost (NewSize, NewCycles, S->CycleWeight) <
+           GetCodeCost (OldSize, OldCycles, S->CycleWeight);
+}
+
+
+
 void CS_OutputPrologue (const CodeSeg* S)
 /* If the given code segment is a code segment for a function, output the
 ** assembler prologue into the file. That is: Output a comment header, switch
@@ -1419,6 +1527,7 @@ void CS_Output (CodeSeg* S)
 {
     unsigned I;
     const LineInfo* LI;
+    CodePool* OldPool;
 
     /* Get the number of entries in this segment */
     unsigned Count = CS_GetEntryCount (S);
@@ -1428,7 +1537,10 @@ void CS_Output (CodeSeg* S)
         return;
     }
 
-    /* Generate register info */
+    /* Generate register info. Since output may happen with another segment
+    ** being current, switch to the memory pool of this one.
+    */
+    OldPool = CP_Use (S->Pool);
     CS_GenRegInfo (S);
 
     /* Output the segment directive */
@@ -1488,261 +1600,433 @@ void CS_Output (CodeSeg* S)
 
     /* Free register info */
     CS_FreeRegInfo (S);
+    CP_Use (OldPool);
 }
 
 
 
-void CS_FreeRegInfo (CodeSeg* S)
-/* Free register infos for all instructions */
+void CS_ReleaseCode (CodeSeg* S)
+/* Release all code entries and labels of the segment at once. This is used
+** after the segment has been output. The segment is empty afterwards.
+*/
 {
     unsigned I;
+
+    /* The entries and labels themselves live in the pool, so only release
+    ** what they reference outside of it.
+    */
     for (I = 0; I < CS_GetEntryCount (S); ++I) {
-        CE_FreeRegInfo (CS_GetEntry(S, I));
+        CodeEntry* E = CS_GetEntry (S, I);
+        DoneCollection (&E->Labels);
+        ReleaseLineInfo (E->LI);
+    }
+    for (I = 0; I < CS_LABEL_HASH_SIZE; ++I) {
+        CodeLabel* L = S->LabelHash[I];
+        while (L) {
+            DoneCollection (&L->JumpFrom);
+            L = L->Next;
+        }
+        S->LabelHash[I] = 0;
+    }
+    CollDeleteAll (&S->Entries);
+    CollDeleteAll (&S->Labels);
+
+    /* Release the memory in one go. Later allocations for the segment come
+    ** from the heap.
+    */
+    if (S->Pool) {
+        if (CP_Current () == S->Pool) {
+            CP_Use (0);
+        }
+        FreeCodePool (S->Pool);
+        S->Pool = 0;
     }
 }
 
 
 
-void CS_GenRegInfo (CodeSeg* S)
-/* Generate register infos for all instructions */
+void CS_CompactCode (CodeSeg* S)
+/* Move the code entries and labels of the segment into a new memory pool and
+** release the old one. This returns the memory of entries and labels that
+** were deleted, for example by the optimizer, and the unused part of the
+** chunks to the heap. The pool of the
+** segment must be current and there must be no register info. The new pool
+** is current on return.
+*/
+{
+    CodePool* Old = S->Pool;
+    unsigned  I, J;
+
+    CHECK (CP_Current () == Old);
+
+    /* Don't bother if there is not much memory to gain */
+    if (Old == 0 || CP_GetUnusedBytes (Old) < CP_GetUsedBytes (Old) / 8) {
+        return;
+    }
+
+    /* Allocate the copies from a new pool that is large enough for all of them */
+    S->Pool = NewCodePool (CP_GetUsedBytes (Old));
+    CP_Use (S->Pool);
+
+    /* Copy the labels. Since the old labels are no longer needed, their Next
+    ** field is used to remember the address of the copy.
+    */
+    for (I = 0; I < CS_LABEL_HASH_SIZE; ++I) {
+        CodeLabel** Last = &S->LabelHash[I];
+        CodeLabel*  L    = *Last;
+        while (L) {
+            CodeLabel* Next = L->Next;
+            *Last = L->Next = CL_Move (L);
+            Last = &(*Last)->Next;
+            L = Next;
+        }
+        *Last = 0;
+    }
+
+    /* Copy the entries, using the RI field of the old entries in the same way */
+    for (I = 0; I < CS_GetEntryCount (S); ++I) {
+        CodeEntry* E = CS_GetEntry (S, I);
+        CHECK (E->RI == 0);
+        E->RI = (RegInfo*) CE_Move (E);
+        CollReplace (&S->Entries, E->RI, I);
+    }
+
+    /* Update the references between entries and labels */
+    for (I = 0; I < CS_GetEntryCount (S); ++I) {
+        CodeEntry* E = CS_GetEntry (S, I);
+        if (E->JumpTo) {
+            E->JumpTo = E->JumpTo->Next;
+        }
+        for (J = 0; J < CE_GetLabelCount (E); ++J) {
+            CollReplace (&E->Labels, CE_GetLabel (E, J)->Next, J);
+        }
+    }
+    for (I = 0; I < CS_LABEL_HASH_SIZE; ++I) {
+        CodeLabel* L = S->LabelHash[I];
+        while (L) {
+            if (L->Owner) {
+                L->Owner = (CodeEntry*) L->Owner->RI;
+            }
+            for (J = 0; J < CL_GetRefCount (L); ++J) {
+                CodeEntry* E = CL_GetRef (L, J);
+                CollReplace (&L->JumpFrom, E->RI, J);
+            }
+            L = L->Next;
+        }
+    }
+    for (I = 0; I < CollCount (&S->Labels); ++I) {
+        CodeLabel* L = CollAtUnchecked (&S->Labels, I);
+        CollReplace (&S->Labels, L->Next, I);
+    }
+
+    /* Release the old memory */
+    FreeCodePool (Old);
+}
+
+
+
+void CS_FreeRegInfo (CodeSeg* S)
+/* Free register infos for all instructions */
 {
     unsigned I;
-    RegContents Regs;           /* Initial register contents */
-    RegContents* CurrentRegs;   /* Current register contents */
-    int WasJump;                /* True if last insn was a jump */
-    int Done;                   /* All runs done flag */
 
-    /* Be sure to delete all register infos */
-    CS_FreeRegInfo (S);
+    /* The infos are returned to the pool of the segment */
+    CHECK (CP_Current () == S->Pool);
 
-    /* We may need two runs to get back references right */
-    do {
+    for (I = 0; I < CS_GetEntryCount (S); ++I) {
+        CE_FreeRegInfo (CS_GetEntry(S, I));
+    }
+}
 
-        /* Assume we're done after this run */
-        Done = 1;
 
-        /* On entry, the register contents are unknown */
-        RC_Invalidate (&Regs);
-        RC_InvalidatePS (&Regs);
-        CurrentRegs = &Regs;
 
-        /* Walk over all insns and note just the changes from one insn to the
-        ** next one.
-        */
-        WasJump = 0;
-        for (I = 0; I < CS_GetEntryCount (S); ++I) {
+static void CS_GenBlockRegInfo (CodeSeg* S, CodeBlock* B)
+/* Generate register infos for the instructions of one block, starting with
+** the register contents in B->In.
+*/
+{
+    unsigned I;
 
-            CodeEntry* P;
+    /* Walk over all insns and note just the changes from one insn to the
+    ** next one.
+    */
+    RegContents* CurrentRegs = &B->In;
+    for (I = B->First; I <= B->Last; ++I) {
 
-            /* Get the next instruction */
-            CodeEntry* E = CollAtUnchecked (&S->Entries, I);
+        /* Get the next instruction */
+        CodeEntry* E = CollAtUnchecked (&S->Entries, I);
 
-            /* If the instruction has a label, we need some special handling */
-            unsigned LabelCount = CE_GetLabelCount (E);
-            if (LabelCount > 0) {
+        /* Generate register info for this instruction */
+        CE_GenRegInfo (E, CurrentRegs);
 
-                /* Loop over all entry points that jump here. If these entry
-                ** points already have register info, check if all values are
-                ** known and identical. If all values are identical, and the
-                ** preceeding instruction was not an unconditional branch, check
-                ** if the register value on exit of the preceeding instruction
-                ** is also identical. If all these values are identical, the
-                ** value of a register is known, otherwise it is unknown.
-                */
-                CodeLabel* Label = CE_GetLabel (E, 0);
-                unsigned Entry;
-                if (WasJump) {
-                    /* Preceeding insn was an unconditional branch */
-                    CodeEntry* J = CL_GetRef(Label, 0);
-                    if (J->RI) {
-                        Regs = J->RI->Out2;
+        /* Output registers for this insn are input for the next */
+        CurrentRegs = &E->RI->Out;
+
+        /* If this insn is a branch on zero flag, we may have more info on
+        ** register contents for one of both flow directions, but only if
+        ** we've gone through a previous instruction.
+        */
+        if (I > B->First && (E->Info & OF_ZBRA) != 0) {
+
+            /* Get the previous instruction and the branch condition */
+            const CodeEntry* P = CollAtUnchecked (&S->Entries, I - 1);
+            bc_t BC = GetBranchCond (E->OPC);
+
+            /* Check the previous instruction */
+            switch (P->OPC) {
+
+                case OP65_ADC:
+                case OP65_AND:
+                case OP65_DEA:
+                case OP65_EOR:
+                case OP65_INA:
+                case OP65_LDA:
+                case OP65_ORA:
+                case OP65_PLA:
+                case OP65_SBC:
+                    /* A is zero in one execution flow direction */
+                    if (BC == BC_EQ) {
+                        E->RI->Out2.RegA = 0;
                     } else {
-                        RC_Invalidate (&Regs);
-                        RC_InvalidatePS (&Regs);
+                        E->RI->Out.RegA = 0;
                     }
-                    Entry = 1;
-                } else {
-                    Regs = *CurrentRegs;
-                    Entry = 0;
-                }
+                    break;
 
-                while (Entry < CL_GetRefCount (Label)) {
-                    /* Get this entry */
-                    CodeEntry* J = CL_GetRef (Label, Entry);
-                    if (J->RI == 0) {
-                        /* No register info for this entry. This means that the
-                        ** instruction that jumps here is at higher addresses and
-                        ** the jump is a backward jump. We need a second run to
-                        ** get the register info right in this case. Until then,
-                        ** assume unknown register contents.
-                        */
-                        Done = 0;
-                        RC_Invalidate (&Regs);
-                        RC_InvalidatePS (&Regs);
-                        break;
+                case OP65_CMP:
+                    /* If this is an immidiate compare, the A register has
+                    ** the value of the compare later.
+                    */
+                    if (CE_IsConstImm (P)) {
+                        if (BC == BC_EQ) {
+                            E->RI->Out2.RegA = (unsigned char)P->Num;
+                        } else {
+                            E->RI->Out.RegA = (unsigned char)P->Num;
+                        }
                     }
-                    if (J->RI->Out2.RegA != Regs.RegA) {
-                        Regs.RegA = UNKNOWN_REGVAL;
+                    break;
+
+                case OP65_CPX:
+                    /* If this is an immidiate compare, the X register has
+                    ** the value of the compare later.
+                    */
+                    if (CE_IsConstImm (P)) {
+                        if (BC == BC_EQ) {
+                            E->RI->Out2.RegX = (unsigned char)P->Num;
+                        } else {
+                            E->RI->Out.RegX = (unsigned char)P->Num;
+                        }
                     }
-                    if (J->RI->Out2.RegX != Regs.RegX) {
-                        Regs.RegX = UNKNOWN_REGVAL;
+                    break;
+
+                case OP65_CPY:
+                    /* If this is an immidiate compare, the Y register has
+                    ** the value of the compare later.
+                    */
+                    if (CE_IsConstImm (P)) {
+                        if (BC == BC_EQ) {
+                            E->RI->Out2.RegY = (unsigned char)P->Num;
+                        } else {
+                            E->RI->Out.RegY = (unsigned char)P->Num;
+                        }
                     }
-                    if (J->RI->Out2.RegY != Regs.RegY) {
-                        Regs.RegY = UNKNOWN_REGVAL;
+                    break;
+
+                case OP65_DEX:
+                case OP65_INX:
+                case OP65_LDX:
+                case OP65_PLX:
+                    /* X is zero in one execution flow direction */
+                    if (BC == BC_EQ) {
+                        E->RI->Out2.RegX = 0;
+                    } else {
+                        E->RI->Out.RegX = 0;
                     }
-                    if (J->RI->Out2.SRegLo != Regs.SRegLo) {
-                        Regs.SRegLo = UNKNOWN_REGVAL;
+                    break;
+
+                case OP65_DEY:
+                case OP65_INY:
+                case OP65_LDY:
+                case OP65_PLY:
+                    /* X is zero in one execution flow direction */
+                    if (BC == BC_EQ) {
+                        E->RI->Out2.RegY = 0;
+                    } else {
+                        E->RI->Out.RegY = 0;
                     }
-                    if (J->RI->Out2.SRegHi != Regs.SRegHi) {
-                        Regs.SRegHi = UNKNOWN_REGVAL;
+                    break;
+
+                case OP65_TAX:
+                case OP65_TXA:
+                    /* If the branch is a beq, both A and X are zero at the
+                    ** branch target, otherwise they are zero at the next
+                    ** insn.
+                    */
+                    if (BC == BC_EQ) {
+                        E->RI->Out2.RegA = E->RI->Out2.RegX = 0;
+                    } else {
+                        E->RI->Out.RegA = E->RI->Out.RegX = 0;
                     }
-                    if (J->RI->Out2.Tmp1 != Regs.Tmp1) {
-                        Regs.Tmp1 = UNKNOWN_REGVAL;
+                    break;
+
+                case OP65_TAY:
+                case OP65_TYA:
+                    /* If the branch is a beq, both A and Y are zero at the
+                    ** branch target, otherwise they are zero at the next
+                    ** insn.
+                    */
+                    if (BC == BC_EQ) {
+                        E->RI->Out2.RegA = E->RI->Out2.RegY = 0;
+                    } else {
+                        E->RI->Out.RegA = E->RI->Out.RegY = 0;
                     }
-                    unsigned PF = J->RI->Out2.PFlags ^ Regs.PFlags;
-                    Regs.PFlags |= ((PF >> 8) | PF | (PF << 8)) & UNKNOWN_PFVAL_ALL;
-                    Regs.ZNRegs &= J->RI->Out2.ZNRegs;
-                    ++Entry;
-                }
+                    break;
 
-                /* Use this register info */
-                CurrentRegs = &Regs;
+                default:
+                    break;
 
             }
+        }
+    }
+}
 
-            /* Generate register info for this instruction */
-            CE_GenRegInfo (E, CurrentRegs);
 
-            /* Remember for the next insn if this insn was an uncondition branch */
-            WasJump = (E->Info & OF_UBRA) != 0;
 
-            /* Output registers for this insn are input for the next */
-            CurrentRegs = &E->RI->Out;
+static int CS_GetBlockInput (CodeSeg* S, CodeBlock* B, RegContents* In,
+                             int Pessimistic)
+/* Determine the register contents on entry of B by merging the contents at
+** the end of all predecessors that have already been processed. Return false
+** if there are no such predecessors. If Pessimistic is true, the contents are
+** unknown if B is reached by a jump from the same or a later block.
+*/
+{
+    unsigned I;
+    int      HaveIn = 0;
 
-            /* If this insn is a branch on zero flag, we may have more info on
-            ** register contents for one of both flow directions, but only if
-            ** we've gone through a previous instruction.
-            */
-            if (LabelCount == 0 && (E->Info & OF_ZBRA) != 0 && (P = CS_GetPrevEntry (S, I)) != 0) {
-
-                /* Get the branch condition */
-                bc_t BC = GetBranchCond (E->OPC);
-
-                /* Check the previous instruction */
-                switch (P->OPC) {
-
-                    case OP65_ADC:
-                    case OP65_AND:
-                    case OP65_DEA:
-                    case OP65_EOR:
-                    case OP65_INA:
-                    case OP65_LDA:
-                    case OP65_ORA:
-                    case OP65_PLA:
-                    case OP65_SBC:
-                        /* A is zero in one execution flow direction */
-                        if (BC == BC_EQ) {
-                            E->RI->Out2.RegA = 0;
-                        } else {
-                            E->RI->Out.RegA = 0;
-                        }
-                        break;
+    /* If the block may be entered from somewhere else, the register contents
+    ** are unknown.
+    */
+    if (B->Flags & CBF_ROOT) {
+        RC_Invalidate (In);
+        RC_InvalidatePS (In);
+        return 1;
+    }
 
-                    case OP65_CMP:
-                        /* If this is an immidiate compare, the A register has
-                        ** the value of the compare later.
-                        */
-                        if (CE_IsConstImm (P)) {
-                            if (BC == BC_EQ) {
-                                E->RI->Out2.RegA = (unsigned char)P->Num;
-                            } else {
-                                E->RI->Out.RegA = (unsigned char)P->Num;
-                            }
-                        }
-                        break;
+    /* Merge the contents from all predecessors */
+    for (I = 0; I < B->PredCount; ++I) {
 
-                    case OP65_CPX:
-                        /* If this is an immidiate compare, the X register has
-                        ** the value of the compare later.
-                        */
-                        if (CE_IsConstImm (P)) {
-                            if (BC == BC_EQ) {
-                                E->RI->Out2.RegX = (unsigned char)P->Num;
-                            } else {
-                                E->RI->Out.RegX = (unsigned char)P->Num;
-                            }
-                        }
-                        break;
+        const CodeBlock* P = B->Pred[I];
+        const RegInfo* RI;
 
-                    case OP65_CPY:
-                        /* If this is an immidiate compare, the Y register has
-                        ** the value of the compare later.
-                        */
-                        if (CE_IsConstImm (P)) {
-                            if (BC == BC_EQ) {
-                                E->RI->Out2.RegY = (unsigned char)P->Num;
-                            } else {
-                                E->RI->Out.RegY = (unsigned char)P->Num;
-                            }
-                        }
-                        break;
+        if (Pessimistic && P->Index >= B->Index) {
+            RC_Invalidate (In);
+            RC_InvalidatePS (In);
+            return 1;
+        }
+        if ((P->Flags & CBF_DONE) == 0) {
+            /* Not processed yet */
+            continue;
+        }
 
-                    case OP65_DEX:
-                    case OP65_INX:
-                    case OP65_LDX:
-                    case OP65_PLX:
-                        /* X is zero in one execution flow direction */
-                        if (BC == BC_EQ) {
-                            E->RI->Out2.RegX = 0;
-                        } else {
-                            E->RI->Out.RegX = 0;
-                        }
-                        break;
+        /* The flow falls through to the next block, and the alternative
+        ** contents are valid at the branch target.
+        */
+        RI = CS_GetEntry (S, P->Last)->RI;
+        if (P->Next == B) {
+            if (HaveIn) {
+                RC_Merge (In, &RI->Out);
+            } else {
+                *In = RI->Out;
+                HaveIn = 1;
+            }
+        }
+        if (P->Target == B) {
+            if (HaveIn) {
+                RC_Merge (In, &RI->Out2);
+            } else {
+                *In = RI->Out2;
+                HaveIn = 1;
+            }
+        }
+    }
 
-                    case OP65_DEY:
-                    case OP65_INY:
-                    case OP65_LDY:
-                    case OP65_PLY:
-                        /* X is zero in one execution flow direction */
-                        if (BC == BC_EQ) {
-                            E->RI->Out2.RegY = 0;
-                        } else {
-                            E->RI->Out.RegY = 0;
-                        }
-                        break;
+    return HaveIn;
+}
 
-                    case OP65_TAX:
-                    case OP65_TXA:
-                        /* If the branch is a beq, both A and X are zero at the
-                        ** branch target, otherwise they are zero at the next
-                        ** insn.
-                        */
-                        if (BC == BC_EQ) {
-                            E->RI->Out2.RegA = E->RI->Out2.RegX = 0;
-                        } else {
-                            E->RI->Out.RegA = E->RI->Out.RegX = 0;
-                        }
-                        break;
 
-                    case OP65_TAY:
-                    case OP65_TYA:
-                        /* If the branch is a beq, both A and Y are zero at the
-                        ** branch target, otherwise they are zero at the next
-                        ** insn.
-                        */
-                        if (BC == BC_EQ) {
-                            E->RI->Out2.RegA = E->RI->Out2.RegY = 0;
-                        } else {
-                            E->RI->Out.RegA = E->RI->Out.RegY = 0;
-                        }
-                        break;
 
-                    default:
-                        break;
+void CS_GenRegInfo (CodeSeg* S)
+/* Generate register infos for all instructions */
+{
+    CodeCFG* G;
+    unsigned I;
+    unsigned Pass;
+    int      Changed;
+
+    /* Be sure to delete all register infos */
+    CS_FreeRegInfo (S);
+
+    /* Split the code into basic blocks */
+    G = NewCodeCFG (S);
+
+    /* Propagate the register contents from block to block. Blocks reached
+    ** only by backward jumps are skipped until one of their predecessors has
+    ** been processed, so known values are kept around loops where they don't
+    ** change. Repeat until the contents on entry of all blocks are stable.
+    */
+    Pass = 0;
+    do {
 
+        Changed = 0;
+        for (I = 0; I < G->BlockCount; ++I) {
+
+            CodeBlock* B = G->Blocks + I;
+            RegContents In;
+
+            if (!CS_GetBlockInput (S, B, &In, 0)) {
+                /* Not reached yet */
+                continue;
+            }
+            if ((B->Flags & CBF_DONE) != 0 && RC_Equal (&In, &B->In)) {
+                /* Nothing new */
+                continue;
+            }
+
+            B->In     = In;
+            B->Flags |= CBF_DONE;
+            CS_GenBlockRegInfo (S, B);
+            Changed   = 1;
+        }
+
+        /* Blocks that haven't been reached are part of unreachable loops.
+        ** Process them with unknown register contents.
+        */
+        if (!Changed) {
+            for (I = 0; I < G->BlockCount; ++I) {
+                if ((G->Blocks[I].Flags & CBF_DONE) == 0) {
+                    G->Blocks[I].Flags |= CBF_ROOT;
+                    Changed = 1;
+                    break;
                 }
             }
         }
-    } while (!Done);
 
+    } while (Changed && ++Pass < MAX_REGINFO_PASSES);
+
+    /* If the contents didn't settle, do a last run that assumes unknown
+    ** contents at the targets of backward jumps.
+    */
+    if (Changed) {
+        for (I = 0; I < G->BlockCount; ++I) {
+            CodeBlock* B = G->Blocks + I;
+            CS_GetBlockInput (S, B, &B->In, 1);
+            B->Flags |= CBF_DONE;
+            CS_GenBlockRegInfo (S, B);
+        }
+    }
+
+    /* Determine the registers used after each instruction */
+    CFG_GenLiveInfo (G);
+
+    /* Release the graph */
+    FreeCodeCFG (G);
 }
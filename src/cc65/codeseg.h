@@ -47,6 +47,7 @@
 
 /* cc65 */
 #include "codelab.h"
+#include "codepool.h"
 #include "lineinfo.h"
 #include "symentry.h"
 
@@ -80,10 +81,12 @@ struct CodeSeg {
     Collection      Labels;                     /* Labels for next insn */
     CodeLabel*      LabelHash[CS_LABEL_HASH_SIZE]; /* Label hash table */
     unsigned short  ExitRegs;                   /* Register use on exit */
+    CodePool*       Pool;                       /* Memory for entries and labels */
 
     /* Optimization settings for this segment */
     unsigned char   Optimize;                   /* On/off switch */
     unsigned        CodeSizeFactor;
+    unsigned        CycleWeight;                /* Weight of cycles, 0..100 */
 };
 
 
@@ -212,6 +215,13 @@ CodeLabel* CS_GenLabel (CodeSeg* S, struct CodeEntry* E);
 ** create a new label, attach it to E and return it.
 */
 
+void CS_SetIndirectLabel (CodeSeg* S, const char* Name);
+/* Mark the code label with the given name as used in data, for example in a
+** jump table. Such a label may be reached by jumps the optimizer doesn't see,
+** so it is never removed, and the code following it is never assumed to be
+** unreachable. The label is created if it does not exist.
+*/
+
 void CS_DelLabel (CodeSeg* S, CodeLabel* L);
 /* Remove references from this label and delete it. */
 
@@ -273,6 +283,20 @@ int CS_IsBasicBlock (CodeSeg* S, unsigned First, unsigned Last);
 ** Last, and that no insn may jump into this block from the outside.
 */
 
+unsigned CS_GetSizeFactor (const CodeSeg* S);
+/* Return the code size factor for the segment. With a cycle weight, larger
+** code is accepted: A weight of 50 doubles the factor, a weight of 100 lifts
+** any limit.
+*/
+
+int CS_PreferCode (const CodeSeg* S, unsigned NewSize, unsigned NewCycles,
+                   unsigned OldSize, unsigned OldCycles, int Default);
+/* Return true if code with NewSize bytes and NewCycles cycles should replace
+** code with OldSize bytes and OldCycles cycles. If the segment doesn't have a
+** cycle weight, Default is returned, which should be the decision of the
+** size factor based heuristics of the caller.
+*/
+
 void CS_OutputPrologue (const CodeSeg* S);
 /* If the given code segment is a code segment for a function, output the
 ** assembler prologue into the file. That is: Output a comment header, switch
@@ -288,6 +312,20 @@ void CS_OutputEpilogue (const CodeSeg* S);
 void CS_Output (CodeSeg* S);
 /* Output the code segment data to a file */
 
+void CS_ReleaseCode (CodeSeg* S);
+/* Release all code entries and labels of the segment at once. This is used
+** after the segment has been output. The segment is empty afterwards.
+*/
+
+void CS_CompactCode (CodeSeg* S);
+/* Move the code entries and labels of the segment into a new memory pool and
+** release the old one. This returns the memory of entries and labels that
+** were deleted, for example by the optimizer, and the unused part of the
+** chunks to the heap. The pool of the
+** segment must be current and there must be no register info. The new pool
+** is current on return.
+*/
+
 void CS_FreeRegInfo (CodeSeg* S);
 /* Free register infos for all instructions */
 
@@ -38,17 +38,21 @@
 
 /* common */
 #include "addrsize.h"
+#include "coll.h"
 #include "debugflag.h"
 #include "segnames.h"
+#include "tgttrans.h"
 #include "version.h"
 #include "xmalloc.h"
 #include "xsprintf.h"
 
 /* cc65 */
+#include "anonname.h"
 #include "asmlabel.h"
 #include "asmstmt.h"
 #include "codegen.h"
 #include "codeopt.h"
+#include "codepool.h"
 #include "compile.h"
 #include "declare.h"
 #include "error.h"
@@ -58,15 +62,21 @@
 #include "global.h"
 #include "initdata.h"
 #include "input.h"
+#include "lineinfo.h"
 #include "litpool.h"
 #include "macrotab.h"
 #include "output.h"
+#include "overlay.h"
+#include "pch.h"
 #include "pragma.h"
 #include "preproc.h"
+#include "segments.h"
 #include "standard.h"
 #include "staticassert.h"
 #include "typecmp.h"
 #include "symtab.h"
+#include "unused.h"
+#include "wrappedcall.h"
 
 
 
@@ -88,6 +98,11 @@ static void Parse (void)
     /* Fill up the next token with a bogus semicolon and start the tokenizer */
     NextTok.Tok = TOK_SEMI;
     NextToken ();
+
+    /* Build the call graph before any function is translated */
+    if (AutoStaticLocals) {
+        ScanCallGraph ();
+    }
     NextToken ();
 
     /* Parse until end of input */
@@ -262,6 +277,7 @@ static void Parse (void)
                     }
 
                     /* Define a label */
+                    StartDataDef (Sym);
                     g_defgloblabel (Sym->Name);
 
                     /* Skip the '=' */
@@ -269,6 +285,7 @@ static void Parse (void)
 
                     /* Parse the initialization */
                     ParseInit (Sym->Type);
+                    EndDataDef ();
 
                 } else {
 
@@ -486,6 +503,11 @@ void Compile (const char* FileName)
     /* Open the input file */
     OpenMainFile (FileName);
 
+    /* Use or create the precompiled header */
+    if (SB_NotEmpty (&PchName) && !PreprocessOnly) {
+        InitPrecompiledHeader (FileName);
+    }
+
     /* Are we supposed to compile or just preprocess the input? */
     if (PreprocessOnly) {
 
@@ -543,8 +565,10 @@ void Compile (const char* FileName)
                         g_segname (SEG_BSS);
                     }
                     g_usebss ();
+                    StartDataDef (Entry);
                     g_defgloblabel (Entry->Name);
                     g_res (Size);
+                    EndDataDef ();
 
                     /* Mark as defined; so that it will be exported, not imported */
                     Entry->Flags |= SC_DEF;
@@ -585,11 +609,16 @@ void Compile (const char* FileName)
 void FinishCompile (void)
 /* Emit literals, debug info, do cleanup and optimizations */
 {
-    SymEntry* Entry;
+    SymEntry*  Entry;
+    Collection Segs = AUTO_COLLECTION_INITIALIZER;
+    CodePool*  OldPool = CP_Current ();
 
-    /* Walk over all global symbols and do clean-up and optimizations for
-    ** functions.
-    */
+    /* Drop the static functions and data that are never used */
+    if (!KeepUnused) {
+        RemoveUnused ();
+    }
+
+    /* Walk over all global symbols and do clean-up for functions */
     for (Entry = GetGlobalSymTab ()->SymHead; Entry; Entry = Entry->NextSym) {
         if (SymIsOutputFunc (Entry)) {
             /* Continue with previous label numbers */
@@ -597,11 +626,26 @@ void FinishCompile (void)
 
             /* Function which is defined and referenced or extern */
             MoveLiteralPool (Entry->V.F.LitPool);
+            CP_Use (Entry->V.F.Seg->Code->Pool);
             CS_MergeLabels (Entry->V.F.Seg->Code);
-            RunOpt (Entry->V.F.Seg->Code);
+            CollAppend (&Segs, Entry->V.F.Seg->Code);
         }
     }
 
+    CP_Use (OldPool);
+
+    /* Place the locals of non-reentrant functions */
+    if (AutoStaticLocals) {
+        OutputOverlay ();
+        DoneCallGraph ();
+    }
+
+    /* Optimize the functions. Since the code segments of the functions are
+    ** independent, this may be done in parallel.
+    */
+    RunOptList (&Segs, OptJobs);
+    DoneCollection (&Segs);
+
     /* Output the literal pool */
     OutputGlobalLiteralPool ();
 
@@ -614,3 +658,54 @@ void FinishCompile (void)
     /* Leave the main lexical level */
     LeaveGlobalLevel ();
 }
+
+
+
+void SaveCompilerSettings (void)
+/* Remember the settings from the command line, so that ResetCompiler can
+** restore them before the next translation unit is compiled.
+*/
+{
+    SaveStackableOptions ();
+    SaveWarnings ();
+    SaveSegNames ();
+    SaveMacros ();
+}
+
+
+
+void ResetCompiler (void)
+/* Reset the state left behind by the last translation unit, so that the next
+** one is compiled as if it were the first one.
+*/
+{
+    /* Symbols and input files */
+    DoneSymTab ();
+    DoneCallGraph ();
+    DoneSymRefs ();
+    DoneLineInfo ();
+    DoneInput ();
+
+    /* Label and name counters, optimizer statistics */
+    ResetAnonNames ();
+    ResetPooledLiteralLabels ();
+    ResetOptStats ();
+
+    /* Settings that may have been changed by #pragma */
+    RestoreStackableOptions ();
+    RestoreWarnings ();
+    RestoreSegNames ();
+    DoneSegAddrSizes ();
+    InitSegAddrSizes ();
+    ClearWrappedCalls ();
+    while (TgtTranslatePop ()) {
+        /* Drop the pushed charmaps */
+    }
+    TgtTranslateInit ();
+
+    /* The macros from the command line */
+    RestoreMacros ();
+
+    /* Diagnostics */
+    ResetErrorCounts ();
+}
@@ -50,6 +50,16 @@ void Compile (const char* FileName);
 void FinishCompile (void);
 /* Emit literals, debug info, do cleanup and optimizations */
 
+void SaveCompilerSettings (void);
+/* Remember the settings from the command line, so that ResetCompiler can
+** restore them before the next translation unit is compiled.
+*/
+
+void ResetCompiler (void);
+/* Reset the state left behind by the last translation unit, so that the next
+** one is compiled as if it were the first one.
+*/
+
 
 
 /* End of compile.h */
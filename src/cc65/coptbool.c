@@ -167,6 +167,17 @@ static void ReplaceBranchCond (CodeSeg* S, unsigned I, cmp_t Cond)
 
 
 
+static int BoolValueUsed (CodeSeg* S, unsigned I)
+/* Check if the boolean value that the subroutine at index I returns in A/X
+** is used after the conditional branch that follows it. Other steps may
+** have removed a load of X, since it is known to be zero after the call.
+*/
+{
+    return (GetRegInfo (S, I + 1, REG_AX) & REG_AX) != 0;
+}
+
+
+
 /*****************************************************************************/
 /*    Optimize bool comparison and transformer subroutines with branches     */
 /*****************************************************************************/
@@ -197,7 +208,8 @@ unsigned OptBoolCmp (CodeSeg* S)
             (Cond = FindTosCmpCond (E->Arg)) != CMP_INV &&
             (N = CS_GetNextEntry (S, I)) != 0           &&
             (N->Info & OF_ZBRA) != 0                    &&
-            !CE_HasLabel (N)) {
+            !CE_HasLabel (N)                            &&
+            !BoolValueUsed (S, I)) {
 
             /* The tos... functions will return a boolean value in a/x and
             ** the Z flag says if this value is zero or not. We will call
@@ -257,7 +269,8 @@ unsigned OptBoolTrans (CodeSeg* S)
             (Cond = FindBoolCmpCond (E->Arg)) != CMP_INV &&
             (N = CS_GetNextEntry (S, I)) != 0            &&
             (N->Info & OF_ZBRA) != 0                     &&
-            (GetRegInfo (S, I + 2, PSTATE_Z) & PSTATE_Z) == 0) {
+            (GetRegInfo (S, I + 2, PSTATE_Z) & PSTATE_Z) == 0 &&
+            !BoolValueUsed (S, I)) {
 
             /* Make the boolean transformer unnecessary by changing the
             ** the conditional jump to evaluate the condition flags that
@@ -313,7 +326,8 @@ unsigned OptBoolUnary (CodeSeg* S)
         if ((E->OPC == OP65_JSR || E->OPC == OP65_JSL)   &&
             (Cond = FindBoolCmpCond (E->Arg)) != CMP_INV &&
             (N = CS_GetNextEntry (S, I)) != 0            &&
-            (N->Info & OF_ZBRA) != 0) {
+            (N->Info & OF_ZBRA) != 0                     &&
+            !BoolValueUsed (S, I)) {
 
             /* Make the boolean transformer unnecessary by changing the
             ** the conditional jump to evaluate the condition flags that
@@ -362,6 +376,7 @@ unsigned OptBoolUnary1 (CodeSeg* S)
 {
     unsigned Changes = 0;
     int      Neg = 0;
+    int      CmpOk;
 
     /* Walk over the entries */
     unsigned I = 0;
@@ -387,7 +402,13 @@ unsigned OptBoolUnary1 (CodeSeg* S)
                 ++I;
                 continue;
             }
-            if ((L[1]->OPC == OP65_CMP && CE_IsKnownImm (L[1], 0x0)) ||
+
+            /* The compare sets the carry, which the bool transformer
+            ** doesn't, so it may only be removed if the carry is unused.
+            */
+            CmpOk = L[1]->OPC == OP65_CMP &&
+                    (GetRegInfo (S, I + 2, PSTATE_C) & PSTATE_C) == 0;
+            if ((CmpOk && CE_IsKnownImm (L[1], 0x0)) ||
                 CE_IsCallTo (L[1], "boolne") ||
                 CE_IsCallTo (L[1], "bcastax")) {
                 /* Delete the entry no longer needed. */
@@ -399,7 +420,7 @@ unsigned OptBoolUnary1 (CodeSeg* S)
                 /* We are still at this index */
                 continue;
 
-            } else if ((L[1]->OPC == OP65_CMP && CE_IsKnownImm (L[1], 0x1)) ||
+            } else if ((CmpOk && CE_IsKnownImm (L[1], 0x1)) ||
                 CE_IsCallTo (L[1], "booleq") ||
                 CE_IsCallTo (L[1], "bnegax")) {
                 /* Invert the previous bool conversion */
@@ -453,7 +474,12 @@ unsigned OptBoolUnary2 (CodeSeg* S)
             (L[1] = CS_GetNextEntry (S, I)) != 0             &&
             !CE_HasLabel (L[1])                              &&
             (Cond = FindBoolCmpCond (L[0]->Arg)) != CMP_INV) {
-            if ((L[1]->OPC == OP65_CMP && CE_IsKnownImm (L[1], 0x0)) ||
+            /* The compare sets the carry, which the bool transformer
+            ** doesn't, so it may only be removed if the carry is unused.
+            */
+            int CmpOk = L[1]->OPC == OP65_CMP &&
+                        (GetRegInfo (S, I + 2, PSTATE_C) & PSTATE_C) == 0;
+            if ((CmpOk && CE_IsKnownImm (L[1], 0x0)) ||
                 CE_IsCallTo (L[1], "boolne") ||
                 CE_IsCallTo (L[1], "bcastax")) {
                 /* Delete the entry no longer needed */
@@ -465,7 +491,7 @@ unsigned OptBoolUnary2 (CodeSeg* S)
                 /* We are still at this index */
                 continue;
 
-            } else if ((L[1]->OPC == OP65_CMP && CE_IsKnownImm (L[1], 0x1)) ||
+            } else if ((CmpOk && CE_IsKnownImm (L[1], 0x1)) ||
                 CE_IsCallTo (L[1], "booleq") ||
                 CE_IsCallTo (L[1], "bnegax")) {
                 /* Invert the bool conversion */
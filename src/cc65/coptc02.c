@@ -125,7 +125,7 @@ unsigned Opt65C02BitOps (CodeSeg* S)
             CE_IsConstImm (L[1])                                &&
             L[2]->OPC == OP65_STA                               &&
             L[2]->AM == L[0]->AM                                &&
-            strcmp (L[2]->Arg, L[0]->Arg) == 0                  &&
+            L[2]->Arg == L[0]->Arg                              &&
             !RegAUsed (S, I+3)) {
 
             char Buf[32];
@@ -682,7 +682,9 @@ unsigned OptCmp9 (CodeSeg* S)
 **    bcc/bcs   somewhere
 **
 ** If A is not used later (which should be the case), we can branch on the N
-** flag instead of the carry flag and remove the asl.
+** flag instead of the carry flag and remove the asl. This is not possible if
+** the carry is used later, for example because the clc at the branch target
+** has been removed.
 */
 {
     unsigned Changes = 0;
@@ -715,7 +717,8 @@ unsigned OptCmp9 (CodeSeg* S)
              L[4]->OPC == OP65_JCC              ||
              L[4]->OPC == OP65_JCS)                     &&
             !CE_HasLabel (L[4])                         &&
-            !RegAUsed (S, I+4)) {
+            !RegAUsed (S, I+4)                          &&
+            (L[4]->RI->LiveOut & PSTATE_C) == 0) {
 
             /* Replace the branch condition */
             switch (GetBranchCond (L[4]->OPC)) {
@@ -0,0 +1,369 @@
+/*****************************************************************************/
+/*                                                                           */
+/*                                 coptfunc.c                                */
+/*                                                                           */
+/*                  Optimize function frames and tail calls                  */
+/*                                                                           */
+/*                                                                           */
+/*                                                                           */
+/* Copyright 2026 The cc65 Authors                                           */
+/*                                                                           */
+/*                                                                           */
+/* This software is provided 'as-is', without any expressed or implied       */
+/* warranty.  In no event will the authors be held liable for any damages    */
+/* arising from the use of this software.                                    */
+/*                                                                           */
+/* Permission is granted to anyone to use this software for any purpose,     */
+/* including commercial applications, and to alter it and redistribute it    */
+/* freely, subject to the following restrictions:                            */
+/*                                                                           */
+/* 1. The origin of this software must not be misrepresented; you must not   */
+/*    claim that you wrote the original software. If you use this software   */
+/*    in a product, an acknowledgment in the product documentation would be  */
+/*    appreciated but is not required.                                       */
+/* 2. Altered source versions must be plainly marked as such, and must not   */
+/*    be misrepresented as being the original software.                      */
+/* 3. This notice may not be removed or altered from any source              */
+/*    distribution.                                                          */
+/*                                                                           */
+/*****************************************************************************/
+
+
+
+#include <string.h>
+
+/* cc65 */
+#include "codeent.h"
+#include "codeinfo.h"
+#include "coptfunc.h"
+#include "symentry.h"
+
+
+
+/*****************************************************************************/
+/*                                   Data                                    */
+/*****************************************************************************/
+
+
+
+/* Origin of a register value in OptLeafFrame */
+#define VAL_A           0       /* Value of A on entry */
+#define VAL_X           1       /* Value of X on entry */
+
+/* Register bits of code that accesses the C stack */
+#define STACK_USE       (REG_SP | SLV_IND | SLV_TOP)
+
+
+
+/*****************************************************************************/
+/*                             Helper functions                              */
+/*****************************************************************************/
+
+
+
+static unsigned DropSize (const CodeEntry* E)
+/* If E is a "jsr/jmp incspN", return N, otherwise return zero */
+{
+    if ((E->OPC == OP65_JSR || E->OPC == OP65_JMP)     &&
+        strncmp (E->Arg, "incsp", 5) == 0               &&
+        E->Arg[5] >= '1' && E->Arg[5] <= '8'            &&
+        E->Arg[6] == '\0') {
+        return E->Arg[5] - '0';
+    }
+    return 0;
+}
+
+
+
+static int IsRegCall (const CodeEntry* E)
+/* Return true if E calls a C function that takes all parameters in registers
+** and has no use for Y.
+*/
+{
+    return E->OPC == OP65_JSR                                   &&
+           E->Arg[0] == '_'                                     &&
+           (E->Use & (STACK_USE | REG_Y | SLV_SP65 | SLV_PL65)) == 0;
+}
+
+
+
+static int IsSelfCall (const CodeSeg* S, const CodeEntry* E)
+/* Return true if E calls the function that contains it */
+{
+    return S->Func != 0 && strcmp (E->Arg, SymGetAsmName (S->Func)) == 0;
+}
+
+
+
+static unsigned GetDrop (CodeSeg* S, CodeEntry* E, CodeEntry** D)
+/* Check if E, or the target of a chain of jumps starting at E, drops a
+** frame from the stack and returns to the caller. If so, store the first
+** entry into D and return the count of entries, otherwise return zero.
+** Entries after the first one must not have labels.
+*/
+{
+    unsigned Count = 1;
+    unsigned Steps = 0;
+    while (E->OPC == OP65_JMP && E->JumpTo != 0 && Steps++ < 10) {
+        E = E->JumpTo->Owner;
+    }
+    *D = E;
+
+    /* ldy #N; jsr/jmp addysp, or jsr/jmp incspN */
+    if (E->OPC == OP65_LDY && CE_IsConstImm (E)) {
+        E = CS_GetNextEntry (S, CS_GetEntryIndex (S, E));
+        if (E == 0                                                  ||
+            CE_HasLabel (E)                                         ||
+            (E->OPC != OP65_JSR && E->OPC != OP65_JMP)              ||
+            strcmp (E->Arg, "addysp") != 0) {
+            return 0;
+        }
+        ++Count;
+    } else if (DropSize (E) == 0) {
+        return 0;
+    }
+
+    /* A subroutine call must be followed by the return */
+    if (E->OPC == OP65_JSR) {
+        E = CS_GetNextEntry (S, CS_GetEntryIndex (S, E));
+        if (E == 0 || CE_HasLabel (E) || E->OPC != OP65_RTS) {
+            return 0;
+        }
+        ++Count;
+    }
+
+    return Count;
+}
+
+
+
+/*****************************************************************************/
+/*                           Leaf function frames                            */
+/*****************************************************************************/
+
+
+
+unsigned OptLeafFrame (CodeSeg* S)
+/* Search for a function that starts with
+**
+**      jsr     pushax
+**      ldy     #$01
+**      lda     (sp),y
+**      tax
+**      dey
+**      lda     (sp),y
+**
+** (or "jsr pusha" followed by "ldy #$00; lda (sp),y") and that doesn't
+** access the C stack otherwise, except for dropping the parameter with
+** "jsr/jmp incsp2" (or incsp1). Remove the push and the loads, replace
+** "jmp incspN" by "rts" and remove "jsr incspN".
+*/
+{
+    unsigned    Count = CS_GetEntryCount (S);
+    unsigned    Size;
+    int         Slot[2];
+    int         A = VAL_A;
+    int         X = VAL_X;
+    unsigned    Last;
+    unsigned    I;
+    CodeEntry*  E;
+
+    /* The function must start with the push */
+    if (Count == 0 || CE_HasLabel (E = CS_GetEntry (S, 0))) {
+        return 0;
+    }
+    if (CE_IsCallTo (E, "pushax")) {
+        Size = 2;
+    } else if (CE_IsCallTo (E, "pusha")) {
+        Size = 1;
+    } else {
+        return 0;
+    }
+    Slot[0] = VAL_A;
+    Slot[1] = VAL_X;
+
+    /* Follow the loads from the pushed bytes */
+    for (Last = 0, I = 1; I < Count; Last = I++) {
+
+        short Y;
+
+        E = CS_GetEntry (S, I);
+        if (CE_HasLabel (E)) {
+            break;
+        }
+
+        Y = E->RI->In.RegY;
+        if ((E->OPC == OP65_LDY && CE_IsConstImm (E)) ||
+            E->OPC == OP65_INY                          ||
+            E->OPC == OP65_DEY) {
+            /* Y is tracked by the register info */
+        } else if (E->OPC == OP65_LDA                   &&
+                   E->AM == AM65_ZP_INDY                &&
+                   strcmp (E->Arg, "sp") == 0           &&
+                   RegValIsKnown (Y)                    &&
+                   (unsigned) Y < Size) {
+            A = Slot[Y];
+        } else if (E->OPC == OP65_TAX) {
+            X = A;
+        } else if (E->OPC == OP65_TXA) {
+            A = X;
+        } else if (Size == 2 && CE_IsCallTo (E, "ldax0sp")) {
+            A = Slot[0];
+            X = Slot[1];
+        } else {
+            break;
+        }
+    }
+
+    /* After the loads, A and X must hold their values on entry, and the
+    ** flags must not be used. Y may be reloaded if needed.
+    */
+    E = CS_GetEntry (S, Last);
+    if (((E->RI->LiveOut & REG_A) != 0 && A != VAL_A)           ||
+        ((E->RI->LiveOut & REG_X) != 0 && X != VAL_X)           ||
+        (E->RI->LiveOut & PSTATE_ALL) != 0                      ||
+        ((E->RI->LiveOut & REG_Y) != 0 &&
+         RegValIsUnknown (E->RI->Out.RegY))) {
+        return 0;
+    }
+
+    /* The remaining code may not access the stack other than by dropping
+    ** the parameter.
+    */
+    for (I = Last + 1; I < Count; ++I) {
+        const CodeEntry* N = CS_GetEntry (S, I);
+        unsigned Regs = N->Use;
+        if ((N->Info & (OF_CALL | OF_UBRA)) == 0) {
+            /* Subroutines are marked as changing everything */
+            Regs |= N->Chg;
+        }
+        if ((Regs & STACK_USE) == 0) {
+            continue;
+        }
+        if (DropSize (N) != Size) {
+            return 0;
+        }
+        if (N->OPC == OP65_JSR &&
+            (N->RI->LiveOut & (REG_Y | PSTATE_ALL)) != 0) {
+            return 0;
+        }
+    }
+
+    /* Replace the drops */
+    I = Last + 1;
+    while (I < Count) {
+        CodeEntry* N = CS_GetEntry (S, I);
+        if (DropSize (N) == 0) {
+            ++I;
+            continue;
+        }
+        if (N->OPC == OP65_JMP) {
+            CodeEntry* R = NewCodeEntry (OP65_RTS, AM65_IMP, 0, 0, N->LI);
+            CS_InsertEntry (S, R, I + 1);
+        } else {
+            --Count;
+        }
+        CS_DelEntry (S, I);
+    }
+
+    /* Replace the push and the loads */
+    if ((E->RI->LiveOut & REG_Y) != 0) {
+        const char* Arg = MakeHexArg (E->RI->Out.RegY);
+        CodeEntry* R = NewCodeEntry (OP65_LDY, AM65_IMM, Arg, 0, E->LI);
+        CS_InsertEntry (S, R, Last + 1);
+    }
+    CS_DelEntries (S, 0, Last + 1);
+
+    /* We had changes */
+    return 1;
+}
+
+
+
+/*****************************************************************************/
+/*                                Tail calls                                 */
+/*****************************************************************************/
+
+
+
+unsigned OptTailCall (CodeSeg* S)
+/* Search for the sequence
+**
+**      jsr     _func
+**      jmp     incspN
+**
+** where _func is a C function that takes all of its parameters in
+** registers, and replace it by
+**
+**      jsr     incspN
+**      jmp     _func
+**
+** The frame may also be dropped by "jsr incspN; rts" or by addysp, and
+** the drop may be reached by a jump.
+*/
+{
+    unsigned Changes = 0;
+    unsigned I;
+
+    /* The callee must not get a pointer into the frame that is dropped */
+    if (StackAddrTaken (S)) {
+        return 0;
+    }
+
+    /* Walk over the entries */
+    I = 0;
+    while (I < CS_GetEntryCount (S)) {
+
+        CodeEntry* L[2];
+        CodeEntry* D;
+        unsigned   Drop;
+
+        /* Get next entry */
+        L[0] = CS_GetEntry (S, I);
+
+        /* Check for the sequence */
+        if (IsRegCall (L[0])                                    &&
+            (L[1] = CS_GetNextEntry (S, I)) != 0                &&
+            (!CE_HasLabel (L[1]) || IsSelfCall (S, L[0]))       &&
+            (Drop = GetDrop (S, L[1], &D)) > 0) {
+
+            CodeEntry* X;
+
+            /* Drop the frame before the call */
+            if (D->OPC == OP65_LDY) {
+                X = NewCodeEntry (OP65_LDY, AM65_IMM, D->Arg, 0, D->LI);
+                CS_InsertEntry (S, X, I++);
+                CS_MoveLabels (S, L[0], X);
+                X = NewCodeEntry (OP65_JSR, AM65_ABS, "addysp", 0, D->LI);
+                CS_InsertEntry (S, X, I++);
+            } else {
+                X = NewCodeEntry (OP65_JSR, AM65_ABS, D->Arg, 0, D->LI);
+                CS_InsertEntry (S, X, I++);
+                CS_MoveLabels (S, L[0], X);
+            }
+
+            /* Jump to the callee */
+            L[0]->AM = AM65_BRA;
+            CE_ReplaceOPC (L[0], OP65_JMP);
+
+            /* Remove the old drop, or the jump to it, if no other code
+            ** needs it. Otherwise the code gets larger, which is done only
+            ** for recursive calls, since they don't use the hardware stack
+            ** any longer.
+            */
+            if (!CE_HasLabel (L[1])) {
+                CS_DelEntries (S, I+1, D == L[1]? Drop : 1);
+            }
+
+            /* Remember, we had changes */
+            ++Changes;
+        }
+
+        /* Next entry */
+        ++I;
+
+    }
+
+    /* Return the number of changes made */
+    return Changes;
+}
@@ -0,0 +1,94 @@
+/*****************************************************************************/
+/*                                                                           */
+/*                                 coptfunc.h                                */
+/*                                                                           */
+/*                  Optimize function frames and tail calls                  */
+/*                                                                           */
+/*                                                                           */
+/*                                                                           */
+/* Copyright 2026 The cc65 Authors                                           */
+/*                                                                           */
+/*                                                                           */
+/* This software is provided 'as-is', without any expressed or implied       */
+/* warranty.  In no event will the authors be held liable for any damages    */
+/* arising from the use of this software.                                    */
+/*                                                                           */
+/* Permission is granted to anyone to use this software for any purpose,     */
+/* including commercial applications, and to alter it and redistribute it    */
+/* freely, subject to the following restrictions:                            */
+/*                                                                           */
+/* 1. The origin of this software must not be misrepresented; you must not   */
+/*    claim that you wrote the original software. If you use this software   */
+/*    in a product, an acknowledgment in the product documentation would be  */
+/*    appreciated but is not required.                                       */
+/* 2. Altered source versions must be plainly marked as such, and must not   */
+/*    be misrepresented as being the original software.                      */
+/* 3. This notice may not be removed or altered from any source              */
+/*    distribution.                                                          */
+/*                                                                           */
+/*****************************************************************************/
+
+
+
+/* A __fastcall__ function pushes its last parameter onto the C stack on
+** entry and drops it again on return. If the parameter is only read back
+** into the registers it came in, the frame is not needed at all. A call
+** that ends a function which has a frame is done after the frame is
+** dropped, so the callee returns directly to the caller of the function.
+*/
+
+
+
+#ifndef COPTFUNC_H
+#define COPTFUNC_H
+
+
+
+/* cc65 */
+#include "codeseg.h"
+
+
+
+/*****************************************************************************/
+/*                                   Code                                    */
+/*****************************************************************************/
+
+
+
+unsigned OptLeafFrame (CodeSeg* S);
+/* Search for a function that starts with
+**
+**      jsr     pushax
+**      ldy     #$01
+**      lda     (sp),y
+**      tax
+**      dey
+**      lda     (sp),y
+**
+** (or "jsr pusha" followed by "ldy #$00; lda (sp),y") and that doesn't
+** access the C stack otherwise, except for dropping the parameter with
+** "jsr/jmp incsp2" (or incsp1). Remove the push and the loads, replace
+** "jmp incspN" by "rts" and remove "jsr incspN".
+*/
+
+unsigned OptTailCall (CodeSeg* S);
+/* Search for the sequence
+**
+**      jsr     _func
+**      jmp     incspN
+**
+** where _func is a C function that takes all of its parameters in
+** registers, and replace it by
+**
+**      jsr     incspN
+**      jmp     _func
+**
+** The frame may also be dropped by "jsr incspN; rts" or by addysp, and
+** the drop may be reached by a jump.
+*/
+
+
+
+/* End of coptfunc.h */
+
+#endif
@@ -92,7 +92,7 @@ static int MemAccess (CodeSeg* S, unsigned From, unsigned To, const CodeEntry* N
 
             unsigned ELen;
 
-            if (strcmp (E->Arg, N->Arg) == 0) {
+            if (E->Arg == N->Arg) {
                 /* Found an access */
                 return 1;
             }
@@ -172,8 +172,13 @@ unsigned OptUnusedLoads (CodeSeg* S)
                    E->OPC == OP65_EOR                                   ||
                    E->OPC == OP65_ORA;
 
-        /* Check for the necessary preconditions */
-        if (IsOp && (N = CS_GetNextEntry (S, I)) != 0 && !LoadFlagsUsed (S, I+1)) {
+        /* Check for the necessary preconditions. The liveness info is from
+        ** before this step, but removing unused loads makes fewer registers
+        ** live, so it is still safe to use.
+        */
+        if (IsOp                                    &&
+            (N = CS_GetNextEntry (S, I)) != 0       &&
+            (E->RI->LiveOut & PSTATE_ZN) == 0) {
 
             /* Check which sort of load or transfer it is */
             unsigned R;
@@ -197,8 +202,8 @@ unsigned OptUnusedLoads (CodeSeg* S)
                 default:        goto NextEntry;         /* OOPS */
             }
 
-            /* Get register usage and check if the register value is used later */
-            if ((GetRegInfo (S, I+1, R) & R) == 0) {
+            /* Check if the register value is used later */
+            if ((E->RI->LiveOut & R) == 0) {
 
                 /* Register value is not used, remove the load */
                 CS_DelEntry (S, I);
@@ -244,8 +249,8 @@ unsigned OptUnusedStores (CodeSeg* S)
             */
             unsigned R = E->Chg & REG_ZP;
 
-            /* Get register usage and check if the register value is used later */
-            if ((GetRegInfo (S, I+1, R) & R) == 0) {
+            /* Check if the register value is used later */
+            if ((E->RI->LiveOut & R) == 0) {
 
                 /* Register value is not used, remove the load */
                 CS_DelEntry (S, I);
@@ -299,7 +304,7 @@ unsigned OptLoad3 (CodeSeg* S)
                 E->OPC == Load->OPC                     &&
                 E->AM == Load->AM                       &&
                 ((E->Arg == 0 && Load->Arg == 0) ||
-                 strcmp (E->Arg, Load->Arg) == 0)       &&
+                 E->Arg == Load->Arg)                   &&
                 (N = CS_GetNextEntry (S, I)) != 0       &&
                 (N->Info & OF_CBRA) == 0) {
 
@@ -362,7 +367,7 @@ unsigned OptDupLoads (CodeSeg* S)
                 if (RegValIsKnown (In->RegA)          && /* Value of A is known */
                     CE_IsKnownImm (E, In->RegA)       && /* Value to be loaded is known */
                     (N = CS_GetNextEntry (S, I)) != 0 && /* There is a next entry */
-                    !CE_UseLoadFlags (N)) {              /* Which does not use the flags */
+                    (E->RI->LiveOut & PSTATE_ZN) == 0) { /* Flags aren't used */
                     Delete = 1;
                 }
                 break;
@@ -371,7 +376,7 @@ unsigned OptDupLoads (CodeSeg* S)
                 if (RegValIsKnown (In->RegX)          && /* Value of X is known */
                     CE_IsKnownImm (E, In->RegX)       && /* Value to be loaded is known */
                     (N = CS_GetNextEntry (S, I)) != 0 && /* There is a next entry */
-                    !CE_UseLoadFlags (N)) {              /* Which does not use the flags */
+                    (E->RI->LiveOut & PSTATE_ZN) == 0) { /* Flags aren't used */
                     Delete = 1;
                 }
                 break;
@@ -380,7 +385,7 @@ unsigned OptDupLoads (CodeSeg* S)
                 if (RegValIsKnown (In->RegY)          && /* Value of Y is known */
                     CE_IsKnownImm (E, In->RegY)       && /* Value to be loaded is known */
                     (N = CS_GetNextEntry (S, I)) != 0 && /* There is a next entry */
-                    !CE_UseLoadFlags (N)) {              /* Which does not use the flags */
+                    (E->RI->LiveOut & PSTATE_ZN) == 0) { /* Flags aren't used */
                     Delete = 1;
                 }
                 break;
@@ -469,7 +474,7 @@ unsigned OptDupLoads (CodeSeg* S)
                 if (RegValIsKnown (In->RegA)          &&
                     In->RegA == In->RegX              &&
                     (N = CS_GetNextEntry (S, I)) != 0 &&
-                    !CE_UseLoadFlags (N)) {
+                    (E->RI->LiveOut & PSTATE_ZN) == 0) {
                     /* Value is identical and not followed by a branch */
                     Delete = 1;
                 }
@@ -479,7 +484,7 @@ unsigned OptDupLoads (CodeSeg* S)
                 if (RegValIsKnown (In->RegA)            &&
                     In->RegA == In->RegY                &&
                     (N = CS_GetNextEntry (S, I)) != 0   &&
-                    !CE_UseLoadFlags (N)) {
+                    (E->RI->LiveOut & PSTATE_ZN) == 0) {
                     /* Value is identical and not followed by a branch */
                     Delete = 1;
                 }
@@ -489,7 +494,7 @@ unsigned OptDupLoads (CodeSeg* S)
                 if (RegValIsKnown (In->RegX)            &&
                     In->RegX == In->RegA                &&
                     (N = CS_GetNextEntry (S, I)) != 0   &&
-                    !CE_UseLoadFlags (N)) {
+                    (E->RI->LiveOut & PSTATE_ZN) == 0) {
                     /* Value is identical and not followed by a branch */
                     Delete = 1;
                 }
@@ -499,7 +504,7 @@ unsigned OptDupLoads (CodeSeg* S)
                 if (RegValIsKnown (In->RegY)            &&
                     In->RegY == In->RegA                &&
                     (N = CS_GetNextEntry (S, I)) != 0   &&
-                    !CE_UseLoadFlags (N)) {
+                    (E->RI->LiveOut & PSTATE_ZN) == 0) {
                     /* Value is identical and not followed by a branch */
                     Delete = 1;
                 }
@@ -567,7 +572,7 @@ unsigned OptStoreLoad (CodeSeg* S)
             ((E->OPC == OP65_STA && N->OPC == OP65_LDA) ||
              (E->OPC == OP65_STX && N->OPC == OP65_LDX) ||
              (E->OPC == OP65_STY && N->OPC == OP65_LDY))    &&
-            strcmp (E->Arg, N->Arg) == 0                    &&
+            E->Arg == N->Arg                                &&
             (X = CS_GetNextEntry (S, I+1)) != 0             &&
             !CE_UseLoadFlags (X)) {
 
@@ -623,7 +628,7 @@ unsigned OptLoadStoreLoad (CodeSeg* S)
              L[1]->OPC == OP65_STY)                         &&
             L[2]->OPC == L[0]->OPC                          &&
             L[2]->AM == L[0]->AM                            &&
-            strcmp (L[0]->Arg, L[2]->Arg) == 0) {
+            L[0]->Arg == L[2]->Arg) {
 
             /* Remove the second load */
             CS_DelEntries (S, I+2, 1);
@@ -181,6 +181,14 @@ unsigned OptBranchDist (CodeSeg* S)
             /* The jump is short and may be replaced by a BRA on the 65C02 CPU */
             CE_ReplaceOPC (E, OP65_BRA);
             ++Changes;
+
+        } else if (E->OPC == OP65_BRA                             &&
+                   E->JumpTo != 0                                 &&
+                   !IsShortDist (GetBranchDist (S, I, E->JumpTo->Owner))) {
+
+            /* Later steps may have moved the target out of reach */
+            CE_ReplaceOPC (E, OP65_JMP);
+            ++Changes;
         }
 
         /* Next entry */
@@ -562,7 +570,8 @@ unsigned OptDeadCode (CodeSeg* S)
              ((N->Info & OF_UBRA) != 0          &&              /* Uncond branch */
               (LN = N->JumpTo) != 0             &&              /* Jumps to known label */
               LN->Owner == N                    &&              /* Attached to insn */
-              CL_GetRefCount (LN) == 1))) {                     /* Only reference */
+              CL_GetRefCount (LN) == 1          &&              /* Only reference */
+              !CE_HasIndirectLabel (N)))) {                     /* Not in data */
 
             /* Delete the next entry */
             CS_DelEntry (S, I+1);
@@ -0,0 +1,604 @@
+/*****************************************************************************/
+/*                                                                           */
+/*                                 coptloop.c                                */
+/*                                                                           */
+/*                               Optimize loops                              */
+/*                                                                           */
+/*                                                                           */
+/*                                                                           */
+/* Copyright 2026 The cc65 Authors                                           */
+/*                                                                           */
+/*                                                                           */
+/* This software is provided 'as-is', without any expressed or implied       */
+/* warranty.  In no event will the authors be held liable for any damages    */
+/* arising from the use of this software.                                    */
+/*                                                                           */
+/* Permission is granted to anyone to use this software for any purpose,     */
+/* including commercial applications, and to alter it and redistribute it    */
+/* freely, subject to the following restrictions:                            */
+/*                                                                           */
+/* 1. The origin of this software must not be misrepresented; you must not   */
+/*    claim that you wrote the original software. If you use this software   */
+/*    in a product, an acknowledgment in the product documentation would be  */
+/*    appreciated but is not required.                                       */
+/* 2. Altered source versions must be plainly marked as such, and must not   */
+/*    be misrepresented as being the original software.                      */
+/* 3. This notice may not be removed or altered from any source              */
+/*    distribution.                                                          */
+/*                                                                           */
+/*****************************************************************************/
+
+
+
+#include <string.h>
+
+/* cc65 */
+#include "codecfg.h"
+#include "codeent.h"
+#include "codeinfo.h"
+#include "coptloop.h"
+
+
+
+/*****************************************************************************/
+/*                                   Data                                    */
+/*****************************************************************************/
+
+
+
+/* Zero page pointers handled by the loop optimizations */
+#define LOOP_PTR_LO     (REG_PTR1_LO | REG_PTR2_LO | REG_SREG_LO)
+#define LOOP_PTR_REGS   (REG_PTR1 | REG_PTR2 | REG_SREG)
+
+/* Maximum number of entries between the address computation and the access */
+#define MAX_INDEX_DIST  16
+
+/* The entries of a loop */
+typedef struct LoopRange LoopRange;
+struct LoopRange {
+    unsigned    First;          /* Index of the first entry of the loop */
+    unsigned    Last;           /* Index of the last entry of the loop */
+    unsigned    PreFirst;       /* Lowest index for code before the loop */
+};
+
+
+
+/*****************************************************************************/
+/*                             Helper functions                              */
+/*****************************************************************************/
+
+
+
+static unsigned LiveIn (const CodeEntry* E)
+/* Return the registers and flags used before the entry is executed */
+{
+    return (E->RI->LiveOut & ~E->Chg) | E->Use;
+}
+
+
+
+static int WritesMemory (const CodeEntry* E)
+/* Return true if the entry writes to memory */
+{
+    return (E->Info & OF_WRITE) != 0 && E->AM != AM65_ACC && E->AM != AM65_IMP;
+}
+
+
+
+static int IsIndirect (const CodeEntry* E)
+/* Return true if the entry accesses memory through a zero page pointer */
+{
+    return E->AM == AM65_ZP_INDY    ||
+           E->AM == AM65_ZP_IND     ||
+           E->AM == AM65_ZPX_IND;
+}
+
+
+
+static int IsStackAccess (const CodeEntry* E)
+/* Return true if E accesses the C stack with a known offset in Y */
+{
+    return E->AM == AM65_ZP_INDY            &&
+           strcmp (E->Arg, "sp") == 0       &&
+           RegValIsKnown (E->RI->In.RegY);
+}
+
+
+
+static int IsInvariantSrc (const CodeEntry* E)
+/* Return true if the operand of E is an immediate value, a memory location
+** that is no zero page register, or a location on the C stack.
+*/
+{
+    return E->AM == AM65_IMM                                    ||
+           ((E->AM == AM65_ZP || E->AM == AM65_ABS) &&
+            (E->Use & REG_ZP) == 0)                             ||
+           IsStackAccess (E);
+}
+
+
+
+static int FindLoop (CodeSeg* S, const CodeCFG* G, const CodeBlock* H,
+                     LoopRange* L)
+/* Check if H is the head of a loop that is entered only by falling through
+** from the preceding block and that doesn't call subroutines. If so, return
+** true and the entries of the loop in L. The loop extends up to the last
+** block that jumps back to H.
+*/
+{
+    const CodeBlock* Pre;
+    unsigned Last;
+    int      Back;
+    unsigned I, J;
+
+    /* The loop is entered by falling through from the preceding block */
+    if (H->Index == 0 || (H->Flags & (CBF_ROOT | CBF_INDJMP)) != 0) {
+        return 0;
+    }
+    Pre = &G->Blocks[H->Index - 1];
+    if (Pre->Next != H) {
+        return 0;
+    }
+
+    /* Find the last block that jumps back to the head */
+    Last = H->Index;
+    Back = 0;
+    for (I = 0; I < H->PredCount; ++I) {
+        const CodeBlock* P = H->Pred[I];
+        if (P->Index >= H->Index) {
+            Back = 1;
+            if (P->Index > Last) {
+                Last = P->Index;
+            }
+        } else if (P != Pre) {
+            return 0;
+        }
+    }
+    if (!Back) {
+        return 0;
+    }
+
+    /* All other blocks of the loop are entered from within the loop */
+    for (I = H->Index + 1; I <= Last; ++I) {
+        const CodeBlock* B = &G->Blocks[I];
+        if ((B->Flags & (CBF_ROOT | CBF_INDJMP)) != 0) {
+            return 0;
+        }
+        for (J = 0; J < B->PredCount; ++J) {
+            if (B->Pred[J]->Index < H->Index || B->Pred[J]->Index > Last) {
+                return 0;
+            }
+        }
+    }
+
+    /* Determine the range of entries */
+    L->First    = H->First;
+    L->Last     = G->Blocks[Last].Last;
+    L->PreFirst = Pre->First;
+    if (CE_HasLabel (CS_GetEntry (S, Pre->First))) {
+        ++L->PreFirst;
+    }
+
+    /* The loop must not call subroutines or change the stack pointer */
+    for (I = L->First; I <= L->Last; ++I) {
+        const CodeEntry* E = CS_GetEntry (S, I);
+        if ((E->Info & OF_CALL) != 0 || (E->Chg & REG_SP) != 0) {
+            return 0;
+        }
+    }
+
+    /* Found a loop */
+    return 1;
+}
+
+
+
+static void InsertLoad (CodeSeg* S, unsigned* Pos, const CodeEntry* Src,
+                        opc_t OPC)
+/* Insert a copy of the load Src with opcode OPC at *Pos. If Src accesses the
+** C stack, the offset is loaded into Y before.
+*/
+{
+    CodeEntry* X;
+    if (IsStackAccess (Src)) {
+        const char* Arg = MakeHexArg (Src->RI->In.RegY);
+        X = NewCodeEntry (OP65_LDY, AM65_IMM, Arg, 0, Src->LI);
+        CS_InsertEntry (S, X, (*Pos)++);
+    }
+    X = NewCodeEntry (OPC, Src->AM, Src->Arg, 0, Src->LI);
+    CS_InsertEntry (S, X, (*Pos)++);
+}
+
+
+
+static void InsertEntry (CodeSeg* S, unsigned* Pos, opc_t OPC, am_t AM,
+                         const char* Arg, LineInfo* LI)
+/* Insert a new entry at *Pos */
+{
+    CodeEntry* X = NewCodeEntry (OPC, AM, Arg, 0, LI);
+    CS_InsertEntry (S, X, (*Pos)++);
+}
+
+
+
+static CodeEntry* NextEntry (CodeSeg* S, unsigned* J, unsigned Last)
+/* Return the entry after *J if it is part of the loop and has no label */
+{
+    CodeEntry* E;
+    if (*J >= Last || CE_HasLabel (E = CS_GetEntry (S, *J + 1))) {
+        return 0;
+    }
+    ++*J;
+    return E;
+}
+
+
+
+static unsigned IndexPtr (CodeSeg* S, unsigned I, unsigned Last)
+/* Replace the address computation starting at I as described for
+** OptLoopIndex. Return the number of changes.
+*/
+{
+    CodeEntry* Idx;
+    CodeEntry* Lo;
+    CodeEntry* Hi;
+    CodeEntry* StLo;
+    CodeEntry* StHi;
+    CodeEntry* Acc;
+    CodeEntry* E;
+    unsigned   Ptr;
+    unsigned   J, A, V, Pos;
+    int        Reload;
+
+    /* The index is a byte in memory */
+    Idx = CS_GetEntry (S, I);
+    if (Idx->OPC != OP65_LDA || Idx->AM == AM65_IMM || !IsInvariantSrc (Idx)) {
+        return 0;
+    }
+
+    /* Check for the addition of the base address */
+    J = I;
+    if ((E = NextEntry (S, &J, Last)) == 0 || E->OPC != OP65_CLC ||
+        (Lo = NextEntry (S, &J, Last)) == 0) {
+        return 0;
+    }
+    if (Lo->OPC == OP65_LDY && CE_IsConstImm (Lo)) {
+        if ((Lo = NextEntry (S, &J, Last)) == 0) {
+            return 0;
+        }
+    }
+    if (Lo->OPC != OP65_ADC || !IsInvariantSrc (Lo)                     ||
+        (StLo = NextEntry (S, &J, Last)) == 0                           ||
+        StLo->OPC != OP65_STA || StLo->AM != AM65_ZP                    ||
+        (Ptr = (StLo->Chg & LOOP_PTR_LO)) == 0                          ||
+        (E = NextEntry (S, &J, Last)) == 0                              ||
+        !CE_IsKnownImm (E, 0)                                           ||
+        (Hi = NextEntry (S, &J, Last)) == 0) {
+        return 0;
+    }
+    if (Hi->OPC == OP65_INY || (Hi->OPC == OP65_LDY && CE_IsConstImm (Hi))) {
+        if ((Hi = NextEntry (S, &J, Last)) == 0) {
+            return 0;
+        }
+    }
+    if (Hi->OPC != OP65_ADC || !IsInvariantSrc (Hi)                     ||
+        (StHi = NextEntry (S, &J, Last)) == 0                           ||
+        StHi->OPC != OP65_STA || StHi->AM != AM65_ZP                    ||
+        StHi->Chg != (Ptr << 1)) {
+        return 0;
+    }
+    Ptr |= Ptr << 1;
+
+    /* The computation must not leave anything that is used later */
+    if ((StHi->RI->LiveOut & (REG_AY | PSTATE_CZVN)) != 0) {
+        return 0;
+    }
+
+    /* Search for the access through the pointer. The code in between must
+    ** not use the pointer or change the index.
+    */
+    for (A = J + 1; ; ++A) {
+        if (A > Last || A > J + MAX_INDEX_DIST) {
+            return 0;
+        }
+        E = CS_GetEntry (S, A);
+        if (CE_HasLabel (E) || (E->Info & (OF_BRA | OF_CALL | OF_RET)) != 0) {
+            return 0;
+        }
+        if (E->AM == AM65_ZP_INDY && strcmp (E->Arg, StLo->Arg) == 0) {
+            break;
+        }
+        if (((E->Use | E->Chg) & Ptr) != 0 || (E->Chg & REG_SP) != 0) {
+            return 0;
+        }
+        if (WritesMemory (E) &&
+            (E->AM != AM65_ZP || strcmp (E->Arg, Idx->Arg) == 0)) {
+            return 0;
+        }
+    }
+    Acc = E;
+    if ((Acc->OPC != OP65_STA && Acc->OPC != OP65_LDA) ||
+        Acc->RI->In.RegY != 0                           ||
+        (Acc->RI->LiveOut & (Ptr | PSTATE_CZVN)) != 0) {
+        return 0;
+    }
+
+    /* When storing, a value loaded from the C stack needs A. Reload the value
+    ** if possible, otherwise use X to save it.
+    */
+    V = A;
+    Reload = 0;
+    if (Acc->OPC == OP65_STA && IsStackAccess (Idx)) {
+        while (V > J + 1) {
+            E = CS_GetEntry (S, V - 1);
+            if (E->OPC != OP65_LDY  &&
+                E->OPC != OP65_INY  &&
+                E->OPC != OP65_DEY) {
+                break;
+            }
+            --V;
+        }
+        E = CS_GetEntry (S, V - 1);
+        if (V > J + 1                                           &&
+            E->OPC == OP65_LDA                                  &&
+            E->AM != AM65_ZP_INDY && IsInvariantSrc (E)) {
+            Reload = 1;
+            --V;
+        } else if ((Acc->RI->LiveOut & REG_X) != 0) {
+            return 0;
+        } else {
+            V = A;
+        }
+    }
+
+    /* Restore Y after the access if it is used later */
+    if ((Acc->RI->LiveOut & REG_Y) != 0) {
+        Pos = A + 1;
+        InsertEntry (S, &Pos, OP65_LDY, AM65_IMM, "$00", Acc->LI);
+    }
+
+    /* Load the index into Y before the access */
+    if (!IsStackAccess (Idx)) {
+        Pos = A;
+        InsertEntry (S, &Pos, OP65_LDY, Idx->AM, Idx->Arg, Idx->LI);
+    } else if (Acc->OPC == OP65_LDA || Reload) {
+        if (Reload) {
+            /* The Y loads between the value and the access aren't needed */
+            CS_DelEntries (S, V + 1, A - V - 1);
+        }
+        Pos = V;
+        InsertLoad (S, &Pos, Idx, OP65_LDA);
+        InsertEntry (S, &Pos, OP65_TAY, AM65_IMP, 0, Idx->LI);
+    } else {
+        Pos = A;
+        InsertEntry (S, &Pos, OP65_TAX, AM65_IMP, 0, Idx->LI);
+        InsertLoad (S, &Pos, Idx, OP65_LDA);
+        InsertEntry (S, &Pos, OP65_TAY, AM65_IMP, 0, Idx->LI);
+        InsertEntry (S, &Pos, OP65_TXA, AM65_IMP, 0, Idx->LI);
+    }
+
+    /* Load the base address into the pointer */
+    Pos = J + 1;
+    InsertLoad (S, &Pos, Lo, OP65_LDA);
+    InsertEntry (S, &Pos, OP65_STA, AM65_ZP, StLo->Arg, StLo->LI);
+    InsertLoad (S, &Pos, Hi, OP65_LDA);
+    InsertEntry (S, &Pos, OP65_STA, AM65_ZP, StHi->Arg, StHi->LI);
+
+    /* Remove the old computation, keeping the labels */
+    CS_MoveLabels (S, Idx, CS_GetEntry (S, J + 1));
+    CS_DelEntries (S, I, J - I + 1);
+
+    /* One change */
+    return 1;
+}
+
+
+
+static unsigned HoistLoads (CodeSeg* S, const LoopRange* L, int StackAddr)
+/* Move loads of zero page pointers that don't change within the loop L in
+** front of the loop. Return the number of changes.
+*/
+{
+    unsigned char Written[256];
+    CodeEntry*    Stores[8];
+    unsigned      Count;
+    int           AnyWritten;
+    unsigned      Chg, Multi, Live, Regs, Clobber;
+    unsigned      I, Pos;
+
+    /* Determine the registers changed more than once, and the locations on
+    ** the C stack that are written.
+    */
+    memset (Written, 0, sizeof (Written));
+    AnyWritten = 0;
+    Chg = Multi = 0;
+    for (I = L->First; I <= L->Last; ++I) {
+        const CodeEntry* E = CS_GetEntry (S, I);
+        Multi |= Chg & E->Chg;
+        Chg   |= E->Chg;
+        if (WritesMemory (E) && IsIndirect (E)) {
+            if (IsStackAccess (E)) {
+                Written[E->RI->In.RegY] = 1;
+            } else if (strcmp (E->Arg, "sp") == 0 || StackAddr) {
+                AnyWritten = 1;
+            }
+        }
+    }
+
+    /* Collect the stores of invariant values into pointers that aren't used
+    ** before they're stored in the loop.
+    */
+    Live    = LiveIn (CS_GetEntry (S, L->First));
+    Count   = 0;
+    Regs    = 0;
+    Clobber = REG_A | PSTATE_ZN;
+    for (I = L->First + 1; I <= L->Last; ++I) {
+        CodeEntry* E = CS_GetEntry (S, I);
+        CodeEntry* P = CS_GetEntry (S, I - 1);
+        unsigned   Reg = E->Chg & LOOP_PTR_REGS;
+
+        if ((E->OPC != OP65_STA && E->OPC != OP65_STX)  ||
+            E->AM != AM65_ZP                            ||
+            CE_HasLabel (E)                             ||
+            Reg == 0 || (Reg & (Reg - 1)) != 0          ||
+            (Reg & (Multi | Live)) != 0                 ||
+            P->OPC != (E->OPC == OP65_STA? OP65_LDA : OP65_LDX)) {
+            continue;
+        }
+        if (IsStackAccess (P)) {
+            if (AnyWritten || Written[P->RI->In.RegY]) {
+                continue;
+            }
+            Clobber |= REG_Y;
+        } else if (P->AM != AM65_IMM) {
+            continue;
+        }
+        Stores[Count++] = E;
+        Regs |= Reg;
+        if (Count == sizeof (Stores) / sizeof (Stores[0])) {
+            break;
+        }
+    }
+    if (Count == 0) {
+        return 0;
+    }
+
+    /* Search backwards for a place in front of the loop where the registers
+    ** needed for the loads are unused.
+    */
+    Pos = L->First;
+    while ((LiveIn (CS_GetEntry (S, Pos)) & Clobber) != 0) {
+        const CodeEntry* E;
+        if (Pos == L->PreFirst) {
+            return 0;
+        }
+        E = CS_GetEntry (S, Pos - 1);
+        if ((E->Info & OF_CALL) != 0                    ||
+            ((E->Use | E->Chg) & (Regs | REG_SP)) != 0  ||
+            (WritesMemory (E) && IsIndirect (E))) {
+            return 0;
+        }
+        --Pos;
+    }
+
+    /* Insert the loads */
+    for (I = 0; I < Count; ++I) {
+        CodeEntry* E = Stores[I];
+        CodeEntry* P = CS_GetPrevEntry (S, CS_GetEntryIndex (S, E));
+        InsertLoad (S, &Pos, P, OP65_LDA);
+        InsertEntry (S, &Pos, OP65_STA, AM65_ZP, E->Arg, E->LI);
+    }
+
+    /* Remove the stores from the loop */
+    for (I = 0; I < Count; ++I) {
+        CS_DelEntry (S, CS_GetEntryIndex (S, Stores[I]));
+    }
+
+    /* Return the number of changes */
+    return Count;
+}
+
+
+
+/*****************************************************************************/
+/*                                   Code                                    */
+/*****************************************************************************/
+
+
+
+unsigned OptLoopIndex (CodeSeg* S)
+/* Search for the sequence
+**
+**      lda     idx
+**      clc
+**      adc     lo
+**      sta     zp
+**      lda     #$00
+**      adc     hi
+**      sta     zp+1
+**      ...
+**      ldy     #$00
+**      sta     (zp),y
+**
+** within a loop, where idx, lo and hi may be loaded from the C stack, and
+** replace it by
+**
+**      lda     lo
+**      sta     zp
+**      lda     hi
+**      sta     zp+1
+**      ...
+**      ldy     idx
+**      sta     (zp),y
+**
+** An "lda (zp),y" is handled the same way.
+*/
+{
+    unsigned Changes = 0;
+    unsigned C;
+
+    /* Since a change invalidates the control flow graph, rebuild it and the
+    ** register info after each change.
+    */
+    do {
+        unsigned B;
+        CodeCFG* G = NewCodeCFG (S);
+        C = 0;
+        for (B = 0; B < G->BlockCount && C == 0; ++B) {
+            LoopRange L;
+            if (FindLoop (S, G, &G->Blocks[B], &L)) {
+                unsigned I;
+                for (I = L.First; I < L.Last && C == 0; ++I) {
+                    C = IndexPtr (S, I, L.Last);
+                }
+            }
+        }
+        FreeCodeCFG (G);
+        if (C) {
+            CS_GenRegInfo (S);
+            Changes += C;
+        }
+    } while (C);
+
+    /* Return the number of changes made */
+    return Changes;
+}
+
+
+
+unsigned OptLoopInvariant (CodeSeg* S)
+/* Move loads of zero page pointers that don't change within a loop in front
+** of the loop.
+*/
+{
+    unsigned Changes = 0;
+    unsigned C;
+
+    /* If addresses of locals are taken, any store through a pointer may
+    ** change the C stack.
+    */
+    int StackAddr = StackAddrTaken (S);
+
+    /* Since a change invalidates the control flow graph, rebuild it and the
+    ** register info after each change.
+    */
+    do {
+        unsigned B;
+        CodeCFG* G = NewCodeCFG (S);
+        C = 0;
+        for (B = 0; B < G->BlockCount && C == 0; ++B) {
+            LoopRange L;
+            if (FindLoop (S, G, &G->Blocks[B], &L)) {
+                C = HoistLoads (S, &L, StackAddr);
+            }
+        }
+        FreeCodeCFG (G);
+        if (C) {
+            CS_GenRegInfo (S);
+            Changes += C;
+        }
+    } while (C);
+
+    /* Return the number of changes made */
+    return Changes;
+}
@@ -0,0 +1,100 @@
+/*****************************************************************************/
+/*                                                                           */
+/*                                 coptloop.h                                */
+/*                                                                           */
+/*                               Optimize loops                              */
+/*                                                                           */
+/*                                                                           */
+/*                                                                           */
+/* Copyright 2026 The cc65 Authors                                           */
+/*                                                                           */
+/*                                                                           */
+/* This software is provided 'as-is', without any expressed or implied       */
+/* warranty.  In no event will the authors be held liable for any damages    */
+/* arising from the use of this software.                                    */
+/*                                                                           */
+/* Permission is granted to anyone to use this software for any purpose,     */
+/* including commercial applications, and to alter it and redistribute it    */
+/* freely, subject to the following restrictions:                            */
+/*                                                                           */
+/* 1. The origin of this software must not be misrepresented; you must not   */
+/*    claim that you wrote the original software. If you use this software   */
+/*    in a product, an acknowledgment in the product documentation would be  */
+/*    appreciated but is not required.                                       */
+/* 2. Altered source versions must be plainly marked as such, and must not   */
+/*    be misrepresented as being the original software.                      */
+/* 3. This notice may not be removed or altered from any source              */
+/*    distribution.                                                          */
+/*                                                                           */
+/*****************************************************************************/
+
+
+
+
+
+/* The steps in this module work on loops of the control flow graph that are
+** entered only by falling into the first block, and that contain no
+** subroutine calls. Within such a loop, pointers that are computed from a
+** base address and a byte index in every iteration are replaced by the base
+** address and an access with the index in the Y register. The page carry of
+** the addition is then done by the indirect indexed addressing mode. Loads
+** of the base address into a zero page pointer do no longer depend on the
+** index and are moved in front of the loop.
+*/
+
+
+
+#ifndef COPTLOOP_H
+#define COPTLOOP_H
+
+
+
+/* cc65 */
+#include "codeseg.h"
+
+
+
+/*****************************************************************************/
+/*                                   Code                                    */
+/*****************************************************************************/
+
+
+
+unsigned OptLoopIndex (CodeSeg* S);
+/* Search for the sequence
+**
+**      lda     idx
+**      clc
+**      adc     lo
+**      sta     zp
+**      lda     #$00
+**      adc     hi
+**      sta     zp+1
+**      ...
+**      ldy     #$00
+**      sta     (zp),y
+**
+** within a loop, where idx, lo and hi may be loaded from the C stack, and
+** replace it by
+**
+**      lda     lo
+**      sta     zp
+**      lda     hi
+**      sta     zp+1
+**      ...
+**      ldy     idx
+**      sta     (zp),y
+**
+** An "lda (zp),y" is handled the same way.
+*/
+
+unsigned OptLoopInvariant (CodeSeg* S);
+/* Move loads of zero page pointers that don't change within a loop in front
+** of the loop.
+*/
+
+
+
+/* End of coptloop.h */
+
+#endif
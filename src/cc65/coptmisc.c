@@ -666,7 +666,7 @@ unsigned OptLoad2 (CodeSeg* S)
                 L[2]->OPC == OP65_STX                           &&
                 (L[1]->Arg == 0                         ||
                  L[2]->Arg == 0                         ||
-                 strcmp (L[1]->Arg, L[2]->Arg) != 0)            &&
+                 L[1]->Arg != L[2]->Arg)                        &&
                 !CS_RangeHasLabel (S, I+1, 2)                   &&
                 !RegXUsed (S, I+3)) {
 
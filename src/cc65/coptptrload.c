@@ -994,10 +994,10 @@ unsigned OptPtrLoad12 (CodeSeg* S)
             L[7]->OPC == OP65_INX                               &&
             L[8]->OPC == OP65_STA                               &&
             L[8]->AM == AM65_ZP                                 &&
-            strcmp (L[8]->Arg, L[0]->Arg) == 0                  &&
+            L[8]->Arg == L[0]->Arg                              &&
             L[9]->OPC == OP65_STX                               &&
             L[9]->AM == AM65_ZP                                 &&
-            strcmp (L[9]->Arg, L[1]->Arg) == 0                  &&
+            L[9]->Arg == L[1]->Arg                              &&
             L[10]->OPC == OP65_LDA                              &&
             L[10]->AM == AM65_ZP                                &&
             strcmp (L[10]->Arg, "regsave") == 0                 &&
@@ -38,6 +38,7 @@
 /* common */
 #include "chartype.h"
 #include "strbuf.h"
+#include "thread.h"
 #include "xmalloc.h"
 #include "xsprintf.h"
 
@@ -133,11 +134,11 @@ static const char* LoadAXImm (CodeSeg* S, unsigned I)
 /* If the instructions preceeding S/I are a load of A/X of a constant value
 ** or a word sized address label, return the address of the location as a
 ** string.
-** Beware: In case of a numeric value, the result is returned in static
-** storage which is overwritten with each call.
+** Beware: In case of a numeric value, the result is returned in static per
+** thread storage which is overwritten with each call.
 */
 {
-    static StrBuf Buf = STATIC_STRBUF_INITIALIZER;
+    static THREAD_LOCAL StrBuf Buf = STATIC_STRBUF_INITIALIZER;
     CodeEntry* L[2];
     CodeEntry* ALoad;
     CodeEntry* XLoad;
@@ -227,7 +227,9 @@ unsigned OptShift1 (CodeSeg* S)
 
                     CodeLabel* L;
 
-                    if (S->CodeSizeFactor < 200) {
+                    /* The loop takes 29 cycles for a shift count of 3 */
+                    if (!CS_PreferCode (S, 6, 29, E->Size, CE_GetCycles (E),
+                                        S->CodeSizeFactor >= 200)) {
                         goto NextEntry;
                     }
 
@@ -334,7 +336,8 @@ unsigned OptShift2 (CodeSeg* S)
     while (I < CS_GetEntryCount (S)) {
         unsigned Shift;
         unsigned Count, Count2;
-        unsigned K;
+        unsigned K, N;
+        unsigned OldSize, OldCycles;
         CodeEntry* L[4];
 
         /* Get next entry */
@@ -364,7 +367,16 @@ unsigned OptShift2 (CodeSeg* S)
             } else {
                 K = 3;
             }
-            if (Count * 100 <= S->CodeSizeFactor        &&
+
+            /* The replacement needs 3 bytes and 4 cycles per shift */
+            OldSize   = 0;
+            OldCycles = 0;
+            for (N = 0; N < K; ++N) {
+                OldSize   += L[N]->Size;
+                OldCycles += CE_GetCycles (L[N]);
+            }
+            if (CS_PreferCode (S, 3 * Count, 4 * Count, OldSize, OldCycles,
+                               Count * 100 <= S->CodeSizeFactor)    &&
                 !RegXUsed (S, I+K)) {
 
                 CodeEntry* X;
@@ -503,7 +515,9 @@ unsigned OptShift4 (CodeSeg* S)
 
                 CodeLabel* L;
 
-                if (S->CodeSizeFactor < 200) {
+                /* The loop takes 29 cycles for a shift count of 3 */
+                if (!CS_PreferCode (S, 6, 29, E->Size, CE_GetCycles (E),
+                                    S->CodeSizeFactor >= 200)) {
                     /* Not acceptable */
                     goto NextEntry;
                 }
@@ -700,6 +714,8 @@ unsigned OptShift6 (CodeSeg* S)
 
         unsigned   Shift;
         unsigned   Count;
+        unsigned   Size;
+        unsigned   Cycles;
         CodeEntry* X;
         unsigned   IP;
 
@@ -726,12 +742,13 @@ unsigned OptShift6 (CodeSeg* S)
             ** and replaces a txa, so for a shift count of 1, we get a factor
             ** of 200, which matches nicely the CodeSizeFactor enabled with -Oi
             */
-            if (Count > 1 || S->CodeSizeFactor > 200) {
-                unsigned Size = 4 + 3 * Count;
-                if ((Size * 100 / 3) > S->CodeSizeFactor) {
-                    /* Not acceptable */
-                    goto NextEntry;
-                }
+            Size   = 4 + 3 * Count;
+            Cycles = 6 + 7 * Count;
+            if (!CS_PreferCode (S, Size, Cycles, E->Size, CE_GetCycles (E),
+                                (Count == 1 && S->CodeSizeFactor <= 200) ||
+                                (Size * 100 / 3) <= S->CodeSizeFactor)) {
+                /* Not acceptable */
+                goto NextEntry;
             }
 
             /* Inline the code. Insertion point is behind the subroutine call */
@@ -862,6 +862,25 @@ static int RegMatch (short Expected, short Actual)
 
 
 
+static int PreferSlower (const CodeSeg* S, const CodeEntry* E,
+                         const CallDesc* D, int Default)
+/* Check if the slower call to D->ShortFunc should replace E. The register
+** loads made unnecessary by it are assumed to take two bytes and two cycles
+** each.
+*/
+{
+    unsigned Loads = !RegValIsUnknown (D->Regs.RegA)   +
+                     !RegValIsUnknown (D->Regs.RegX)   +
+                     !RegValIsUnknown (D->Regs.RegY)   +
+                     !RegValIsUnknown (D->Regs.SRegLo) +
+                     !RegValIsUnknown (D->Regs.SRegHi);
+    return CS_PreferCode (S, E->Size, GetFuncCycles (D->ShortFunc),
+                          E->Size + 2 * Loads, CE_GetCycles (E) + 2 * Loads,
+                          Default);
+}
+
+
+
 /*****************************************************************************/
 /*                                   Code                                    */
 /*****************************************************************************/
@@ -903,9 +922,11 @@ unsigned OptSize1 (CodeSeg* S)
             while (1) {
 
                 /* Check the registers and allow slower code only if
-                ** optimizing for size.
+                ** optimizing for size, or if it's cheaper with the cycle
+                ** weight of the segment.
                 */
-                if ((OptForSize || (D->Flags & F_SLOWER) == 0)          &&
+                if (((D->Flags & F_SLOWER) == 0                         ||
+                     PreferSlower (S, E, D, OptForSize))                &&
                     RegMatch (D->Regs.RegA,    In->RegA)                &&
                     RegMatch (D->Regs.RegX,    In->RegX)                &&
                     RegMatch (D->Regs.RegY,    In->RegY)                &&
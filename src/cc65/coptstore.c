@@ -349,8 +349,8 @@ unsigned OptStore4 (CodeSeg* S)
             L[2]->AM == L[0]->AM                            &&
             L[3]->OPC == OP65_LDX                           &&
             L[3]->AM == L[1]->AM                            &&
-            strcmp (L[0]->Arg, L[2]->Arg) == 0              &&
-            strcmp (L[1]->Arg, L[3]->Arg) == 0              &&
+            L[0]->Arg == L[2]->Arg                          &&
+            L[1]->Arg == L[3]->Arg                          &&
             !CE_UseLoadFlags (L[4])) {
 
             /* Register has already the correct value, remove the loads */
@@ -141,7 +141,7 @@ unsigned OptSub2 (CodeSeg* S)
             L[3]->OPC == OP65_SBC                          &&
             strcmp (L[3]->Arg, "tmp1") == 0                &&
             L[4]->OPC == OP65_STA                          &&
-            strcmp (L[4]->Arg, L[2]->Arg) == 0) {
+            L[4]->Arg == L[2]->Arg) {
 
             /* Remove the store to tmp1 */
             CS_DelEntry (S, I+2);
@@ -83,7 +83,7 @@ unsigned OptTest1 (CodeSeg* S)
             CS_GetEntries (S, L+1, I+1, 2)     &&
             !CE_HasLabel (L[1])                &&
             L[1]->OPC == OP65_ORA              &&
-            strcmp (L[0]->Arg, L[1]->Arg) == 0 &&
+            L[0]->Arg == L[1]->Arg             &&
             !CE_HasLabel (L[2])                &&
             (L[2]->Info & OF_ZBRA) != 0) {
 
@@ -152,7 +152,7 @@ unsigned OptTest2 (CodeSeg* S)
             (L[1]->Info & OF_LOAD) != 0                         &&
             (L[2]->Info & OF_FBRA) != 0                         &&
             L[1]->AM == L[0]->AM                                &&
-            strcmp (L[0]->Arg, L[1]->Arg) == 0                  &&
+            L[0]->Arg == L[1]->Arg                              &&
             (GetRegInfo (S, I+2, L[1]->Chg & ~PSTATE_ZN) & L[1]->Chg & ~PSTATE_ZN) == 0) {
 
             /* Remove the load */
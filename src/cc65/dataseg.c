@@ -106,6 +106,18 @@ void DS_AddLine (DataSeg* S, const char* Format, ...)
 
 
 
+void DS_DelLines (DataSeg* S, unsigned Start, unsigned Count)
+/* Delete Count lines starting with Start from the given data segment */
+{
+    /* Delete from the end, so that fewer lines have to be moved */
+    while (Count-- > 0) {
+        xfree (CollAt (&S->Lines, Start + Count));
+        CollDelete (&S->Lines, Start + Count);
+    }
+}
+
+
+
 void DS_Output (const DataSeg* S)
 /* Output the data segment data to the output file */
 {
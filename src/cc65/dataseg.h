@@ -82,6 +82,9 @@ void DS_AddVLine (DataSeg* S, const char* Format, va_list ap) attribute ((format
 void DS_AddLine (DataSeg* S, const char* Format, ...) attribute ((format(printf,2,3)));
 /* Add a line to the given data segment */
 
+void DS_DelLines (DataSeg* S, unsigned Start, unsigned Count);
+/* Delete Count lines starting with Start from the given data segment */
+
 void DS_Output (const DataSeg* S);
 /* Output the data segment data to the output file */
 
@@ -57,6 +57,7 @@
 /* Forwards for attribute handlers */
 static void NoReturnAttr (Declarator* D);
 static void UnusedAttr (Declarator* D);
+static void InterruptAttr (Declarator* D);
 
 
 
@@ -67,8 +68,10 @@ struct AttrDesc {
     void        (*Handler) (Declarator*);
 };
 static const AttrDesc AttrTable [] = {
+    { "__interrupt__",  InterruptAttr   },
     { "__noreturn__",   NoReturnAttr    },
     { "__unused__",     UnusedAttr      },
+    { "interrupt",      InterruptAttr   },
     { "noreturn",       NoReturnAttr    },
     { "unused",         UnusedAttr      },
 };
@@ -177,6 +180,15 @@ static void UnusedAttr (Declarator* D)
 
 
 
+static void InterruptAttr (Declarator* D)
+/* Parse the "interrupt" attribute */
+{
+    /* Add the interrupt attribute */
+    AddAttr (D, NewDeclAttr (atInterrupt));
+}
+
+
+
 void ParseAttribute (Declarator* D)
 /* Parse an additional __attribute__ modifier */
 {
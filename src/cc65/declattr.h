@@ -51,6 +51,7 @@ struct Declarator;
 typedef enum {
     atNoReturn,                 /* Function does not return */
     atUnused,                   /* Symbol is unused - don't warn */
+    atInterrupt,                /* Function may run in an interrupt handler */
 } DeclAttrType;
 
 /* An actual attribute description */
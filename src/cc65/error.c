@@ -75,6 +75,7 @@ IntStack WarnNoEffect       = INTSTACK(1);  /* - statements without an effect */
 IntStack WarnPointerSign    = INTSTACK(1);  /* - pointer conversion to pointer differing in signedness */
 IntStack WarnPointerTypes   = INTSTACK(1);  /* - pointer conversion to incompatible pointer type */
 IntStack WarnRemapZero      = INTSTACK(1);  /* - remapping character code zero */
+IntStack WarnRemovedUnused  = INTSTACK(0);  /* - removed unused static symbols */
 IntStack WarnReturnType     = INTSTACK(1);  /* - control reaches end of non-void function */
 IntStack WarnStructParam    = INTSTACK(0);  /* - structs passed by val */
 IntStack WarnUnknownPragma  = INTSTACK(1);  /* - unknown #pragmas */
@@ -99,6 +100,7 @@ static WarnMapEntry WarnMap[] = {
     { &WarnPointerSign,         "pointer-sign"          },
     { &WarnPointerTypes,        "pointer-types"         },
     { &WarnRemapZero,           "remap-zero"            },
+    { &WarnRemovedUnused,       "removed-unused"        },
     { &WarnReturnType,          "return-type"           },
     { &WarnStructParam,         "struct-param"          },
     { &WarnUnknownPragma,       "unknown-pragma"        },
@@ -110,6 +112,10 @@ static WarnMapEntry WarnMap[] = {
     { &WarnConstOverflow,       "const-overflow"        },
 };
 
+/* Saved state of the warnings */
+static IntStack SavedWarnEnable;
+static IntStack SavedWarnings[sizeof (WarnMap) / sizeof (WarnMap[0])];
+
 Collection DiagnosticStrBufs;
 
 
@@ -408,6 +414,34 @@ void ListWarnings (FILE* F)
 
 
 
+void SaveWarnings (void)
+/* Remember the state of all warnings, so it can be restored by
+** RestoreWarnings.
+*/
+{
+    unsigned I;
+
+    SavedWarnEnable = WarnEnable;
+    for (I = 0; I < sizeof(WarnMap) / sizeof (WarnMap[0]); ++I) {
+        SavedWarnings[I] = *WarnMap[I].Stack;
+    }
+}
+
+
+
+void RestoreWarnings (void)
+/* Restore the state of the warnings saved before */
+{
+    unsigned I;
+
+    WarnEnable = SavedWarnEnable;
+    for (I = 0; I < sizeof(WarnMap) / sizeof (WarnMap[0]); ++I) {
+        *WarnMap[I].Stack = SavedWarnings[I];
+    }
+}
+
+
+
 /*****************************************************************************/
 /*                          Handling of other infos                          */
 /*****************************************************************************/
@@ -490,6 +524,19 @@ void ErrorReport (void)
 
 
 
+void ResetErrorCounts (void)
+/* Reset the counts of errors and warnings for a new translation unit */
+{
+    PPErrorCount     = 0;
+    PPWarningCount   = 0;
+    ErrorCount       = 0;
+    WarningCount     = 0;
+    RecentLineNo     = 0;
+    RecentErrorCount = 0;
+}
+
+
+
 /*****************************************************************************/
 /*                              Tracked StrBufs                              */
 /*****************************************************************************/
@@ -79,6 +79,7 @@ extern IntStack WarnPointerSign;        /* - pointer conversion to pointer diffe
 extern IntStack WarnPointerTypes;       /* - pointer conversion to incompatible pointer type */
 extern IntStack WarnNoEffect;           /* - statements without an effect */
 extern IntStack WarnRemapZero;          /* - remapping character code zero */
+extern IntStack WarnRemovedUnused;      /* - removed unused static symbols */
 extern IntStack WarnReturnType;         /* - control reaches end of non-void function */
 extern IntStack WarnStructParam;        /* - structs passed by val */
 extern IntStack WarnUnknownPragma;      /* - unknown #pragmas */
@@ -135,6 +136,14 @@ IntStack* FindWarning (const char* Name);
 void ListWarnings (FILE* F);
 /* Print a list of warning types/names to the given file */
 
+void SaveWarnings (void);
+/* Remember the state of all warnings, so it can be restored by
+** RestoreWarnings.
+*/
+
+void RestoreWarnings (void);
+/* Restore the state of the warnings saved before */
+
 void Note (const char* Format, ...) attribute ((format (printf, 1, 2)));
 /* Print a note message */
 
@@ -153,6 +162,9 @@ unsigned GetTotalWarnings (void);
 void ErrorReport (void);
 /* Report errors (called at end of compile) */
 
+void ResetErrorCounts (void);
+/* Reset the counts of errors and warnings for a new translation unit */
+
 void InitDiagnosticStrBufs (void);
 /* Init tracking string buffers used for diagnostics */
 
@@ -26,6 +26,7 @@
 #include "function.h"
 #include "global.h"
 #include "initdata.h"
+#include "inliner.h"
 #include "litpool.h"
 #include "loadexpr.h"
 #include "macrotab.h"
@@ -39,6 +40,7 @@
 #include "symtab.h"
 #include "typecmp.h"
 #include "typeconv.h"
+#include "unused.h"
 #include "expr.h"
 #include "util.h"
 
@@ -289,6 +291,34 @@ static unsigned typeadjust (ExprDesc* lhs, const ExprDesc* rhs, int NoPush)
 
 
 
+static int IsDirectOperand (const ExprDesc* Expr)
+/* Return true if the expression is a variable that an instruction can use as
+** its operand directly, with no code needed to load it.
+*/
+{
+    return ED_IsLVal (Expr)                     &&
+           ED_IsLocQuasiConst (Expr)            &&
+           !IsTypeBitField (Expr->Type)         &&
+           ED_CodeRangeIsEmpty (Expr);
+}
+
+
+
+static int IsStaticLongOperand (const ExprDesc* Lhs, const ExprDesc* Rhs)
+/* Return true if a binary operation with the long lhs in the primary register
+** may use the rhs directly, because it is a long variable at a fixed address.
+*/
+{
+    return IsClassInt (Lhs->Type)                       &&
+           IsClassInt (Rhs->Type)                       &&
+           CheckedSizeOf (Lhs->Type) == SIZEOF_LONG     &&
+           CheckedSizeOf (Rhs->Type) == SIZEOF_LONG     &&
+           IsDirectOperand (Rhs)                        &&
+           !ED_IsLocStack (Rhs);
+}
+
+
+
 void LimitExprValue (ExprDesc* Expr, int WarnOverflow)
 /* Limit the constant value of the expression to the range of its type */
 {
@@ -334,6 +364,67 @@ void LimitExprValue (ExprDesc* Expr, int WarnOverflow)
 
 
 
+int ByteResultOnly (const ExprDesc* Expr)
+/* Return true if only the low byte of the result of the operation just parsed
+** is used. This is the case if the expression has the E_NEED_BYTE hint, and
+** no other operator follows that could use the high byte of the result. Since
+** the code for an operation is generated before the next operator is known,
+** only the last operation of the expression can be narrowed this way.
+*/
+{
+    if (!ED_NeedsByte (Expr)) {
+        return 0;
+    }
+    switch (CurTok.Tok) {
+        case TOK_SEMI:
+        case TOK_COMMA:
+        case TOK_COLON:
+        case TOK_RBRACK:
+            return 1;
+        case TOK_RPAREN:
+            /* The parenthesis may close a subexpression that is an operand
+            ** itself, so check what follows it.
+            */
+            return NextTok.Tok < TOK_FIRST_PUNC || NextTok.Tok > TOK_QUEST;
+        default:
+            return 0;
+    }
+}
+
+
+
+int NarrowToByte (const ExprDesc* Lhs, const ExprDesc* Rhs)
+/* Return true if a binary operation with the given integer operands may be
+** done with their low bytes only, because only the low byte of its result is
+** used.
+*/
+{
+    return ByteResultOnly (Lhs)                         &&
+           IsClassInt (Lhs->Type)                       &&
+           IsClassInt (Rhs->Type)                       &&
+           CheckedSizeOf (Lhs->Type) <= SIZEOF_INT      &&
+           CheckedSizeOf (Rhs->Type) <= SIZEOF_INT;
+}
+
+
+
+void LoadLowByte (ExprDesc* Expr, const CodeMark* Mark)
+/* Replace the code since Mark that loaded the operand Expr into the primary
+** register by code that loads just the low byte, if the operand is a char
+** lvalue. This saves the zero or sign extension of the operand. The low byte
+** of larger operands is in A anyway, so their load is left alone.
+*/
+{
+    if (ED_IsLVal (Expr)                        &&
+        !IsTypeBitField (Expr->Type)            &&
+        CheckedSizeOf (Expr->Type) == SIZEOF_CHAR) {
+        RemoveCode (Mark);
+        LoadExpr (CF_FORCECHAR, Expr);
+    }
+}
+
+
+
 static const GenDesc* FindGen (token_t Tok, const GenDesc* Table)
 /* Find a token in a generator table */
 {
@@ -857,7 +948,12 @@ static unsigned FunctionArgList (FuncDesc* Func, int IsFastcall, ExprDesc* ED)
             Ellipsis = 1;
         }
 
-        /* Evaluate the argument expression */
+        /* Evaluate the argument expression. Only the low byte of the value
+        ** is used for a char parameter.
+        */
+        if (ParamComplete && !Ellipsis) {
+            ED_RequireByteFor (&Expr, Param->Type);
+        }
         hie1 (&Expr);
 
         /* Skip to the next parameter if there are any incomplete types */
@@ -984,6 +1080,11 @@ static void FunctionCall (ExprDesc* Expr)
     /* Skip the left paren */
     NextToken ();
 
+    /* Remember that the current function calls other functions */
+    if (CurrentFunc) {
+        F_CallFound (CurrentFunc);
+    }
+
     /* Get a pointer to the function descriptor from the type string */
     Func = GetFuncDesc (Expr->Type);
 
@@ -1041,6 +1142,11 @@ static void FunctionCall (ExprDesc* Expr)
             }
         }
 
+        /* Replace calls of small functions by their body */
+        if (InlineCall (Expr)) {
+            return;
+        }
+
         /* If we didn't inline the function, get fastcall info */
         IsFastcall = (Func->ParamCount > 0 || (Func->Flags & FD_EMPTY) != 0) &&
                      IsFastcallFunc (Expr->Type);
@@ -1214,6 +1320,12 @@ static void Primary (ExprDesc* E)
             break;
 
         case TOK_IDENT:
+            /* Parameter of a function that is inlined */
+            if (InlineParam (CurTok.Ident, E)) {
+                NextToken ();
+                break;
+            }
+
             /* Identifier. Get a pointer to the symbol table entry */
             Sym = E->Sym = FindSym (CurTok.Ident);
 
@@ -1238,6 +1350,7 @@ static void Primary (ExprDesc* E)
 
                 /* Mark the symbol as referenced */
                 Sym->Flags |= SC_REF;
+                AddSymRef (Sym);
 
                 /* The expression type is the symbol type */
                 E->Type = Sym->Type;
@@ -1330,6 +1443,7 @@ static void Primary (ExprDesc* E)
                         Warning ("Call to undeclared function '%s'", Ident);
                     }
                     Sym = AddGlobalSym (Ident, GetImplicitFuncType(), SC_REF | SC_FUNC);
+                    AddSymRef (Sym);
                     E->Type  = Sym->Type;
                     E->Flags = E_LOC_GLOBAL | E_RTYPE_RVAL;
                     E->Name  = (uintptr_t) Sym->Name;
@@ -1350,6 +1464,7 @@ static void Primary (ExprDesc* E)
             /* String literal */
             if ((Flags & E_EVAL_UNEVAL) != E_EVAL_UNEVAL) {
                 E->V.LVal = UseLiteral (CurTok.SVal);
+                AddLiteralRef (E->V.LVal);
             } else {
                 E->V.LVal = CurTok.SVal;
             }
@@ -1957,15 +2072,24 @@ static void UnaryOp (ExprDesc* Expr)
             ED_MakeConstAbsInt (Expr, 1);
         }
 
-        /* Value is not constant */
-        LoadExpr (CF_NONE, Expr);
+        /* Value is not constant. If only the low byte of the result is
+        ** used, it doesn't depend on the high byte of the operand, so just
+        ** the low byte needs to be loaded and processed.
+        */
+        if (ByteResultOnly (Expr) && CheckedSizeOf (Expr->Type) <= SIZEOF_INT) {
+            LoadExpr (CF_FORCECHAR, Expr);
+            Expr->Type = IntPromotion (Expr->Type);
+            Flags = CF_CHAR | CF_FORCECHAR;
+        } else {
+            LoadExpr (CF_NONE, Expr);
 
-        /* Adjust the type of the expression */
-        Expr->Type = IntPromotion (Expr->Type);
-        TypeConversion (Expr, Expr->Type);
+            /* Adjust the type of the expression */
+            Expr->Type = IntPromotion (Expr->Type);
+            TypeConversion (Expr, Expr->Type);
 
-        /* Get code generation flags */
-        Flags = CG_TypeOf (Expr->Type);
+            /* Get code generation flags */
+            Flags = CG_TypeOf (Expr->Type);
+        }
 
         /* Handle the operation */
         switch (Tok) {
@@ -1987,6 +2111,13 @@ void hie10 (ExprDesc* Expr)
 {
     unsigned long Size;
 
+    /* Only the unary plus, minus and complement operators, parenthesized
+    ** expressions and casts pass a byte hint on to their operand. For the
+    ** other operators, the result depends on the high byte of the operand.
+    */
+    unsigned NeedByte = Expr->Flags & E_NEED_BYTE;
+    Expr->Flags &= ~E_NEED_BYTE;
+
     switch (CurTok.Tok) {
 
         case TOK_INC:
@@ -2000,6 +2131,7 @@ void hie10 (ExprDesc* Expr)
         case TOK_PLUS:
         case TOK_MINUS:
         case TOK_COMP:
+            Expr->Flags |= NeedByte;
             UnaryOp (Expr);
             break;
 
@@ -2113,6 +2245,7 @@ void hie10 (ExprDesc* Expr)
             break;
 
         default:
+            Expr->Flags |= NeedByte;
             if (TypeSpecAhead ()) {
 
                 /* A typecast */
@@ -2126,6 +2259,9 @@ void hie10 (ExprDesc* Expr)
             }
             break;
     }
+
+    /* The hint applies again to the operators that follow */
+    Expr->Flags |= NeedByte;
 }
 
 
@@ -2143,6 +2279,8 @@ static void hie_internal (const GenDesc* Ops,   /* List of generators */
     unsigned ltype, type;
     int lconst;                         /* Left operand is a constant */
     int rconst;                         /* Right operand is a constant */
+    int Narrow;                         /* Use the low bytes only */
+    int Direct;                         /* Use a long rhs variable directly */
 
 
     ExprWithCheck (hienext, Expr);
@@ -2193,7 +2331,14 @@ static void hie_internal (const GenDesc* Ops,   /* List of generators */
 
         /* Check for a constant expression */
         rconst = (ED_IsConstAbs (&Expr2) && ED_CodeRangeIsEmpty (&Expr2));
-        if (!rconst) {
+
+        /* A bitwise operation of a long lhs with a long variable at a fixed
+        ** address may be done without pushing the lhs and loading the rhs.
+        */
+        Direct = (Tok == TOK_AND || Tok == TOK_OR || Tok == TOK_XOR) &&
+                 !lconst && !rconst                                   &&
+                 IsStaticLongOperand (Expr, &Expr2);
+        if (!rconst && !Direct) {
             /* Not constant, load into the primary */
             LoadExpr (CF_NONE, &Expr2);
         }
@@ -2203,6 +2348,14 @@ static void hie_internal (const GenDesc* Ops,   /* List of generators */
             Error ("Integer expression expected");
         }
 
+        /* The low byte of the result of a bitwise operation depends on the
+        ** low bytes of the operands only. If nothing else is used, and one
+        ** operand is constant, operate on the low byte of the other one.
+        */
+        Narrow = (Tok == TOK_AND || Tok == TOK_OR || Tok == TOK_XOR) &&
+                 (lconst || rconst)                                   &&
+                 NarrowToByte (Expr, &Expr2);
+
         /* Check for const operands */
         if (lconst && rconst) {
 
@@ -2293,7 +2446,12 @@ static void hie_internal (const GenDesc* Ops,   /* List of generators */
             }
 
             /* Determine the type of the operation result. */
-            type |= g_typeadjust (ltype, rtype);
+            if (Narrow) {
+                LoadLowByte (&Expr2, &Expr2.End);
+                type = CF_CHAR | CF_FORCECHAR | CF_CONST;
+            } else {
+                type |= g_typeadjust (ltype, rtype);
+            }
             Expr->Type = ArithmeticConvert (Expr->Type, Expr2.Type);
 
             /* Generate code */
@@ -2302,6 +2460,30 @@ static void hie_internal (const GenDesc* Ops,   /* List of generators */
             /* We have an rvalue in the primary now */
             ED_FinalizeRValLoad (Expr);
 
+        } else if (Direct) {
+
+            /* The lhs is still in the primary, remove its push */
+            RemoveCode (&Mark2);
+            type = g_typeadjust (ltype | CF_PRIMARY, CG_TypeOf (Expr2.Type)) |
+                   CG_AddrModeFlags (&Expr2);
+            Expr->Type = ArithmeticConvert (Expr->Type, Expr2.Type);
+
+            /* Generate code */
+            switch (Tok) {
+                case TOK_AND:
+                    g_andstatic (type, Expr2.Name, Expr2.IVal);
+                    break;
+                case TOK_OR:
+                    g_orstatic (type, Expr2.Name, Expr2.IVal);
+                    break;
+                default:
+                    g_xorstatic (type, Expr2.Name, Expr2.IVal);
+                    break;
+            }
+
+            /* We have an rvalue in the primary now */
+            ED_FinalizeRValLoad (Expr);
+
         } else {
 
             /* If the right hand side is constant, and the generator function
@@ -2332,7 +2514,12 @@ static void hie_internal (const GenDesc* Ops,   /* List of generators */
             }
 
             /* Determine the type of the operation result. */
-            type |= g_typeadjust (ltype, rtype);
+            if (Narrow) {
+                LoadLowByte (Expr, &Mark1);
+                type = CF_CHAR | CF_FORCECHAR | CF_CONST;
+            } else {
+                type |= g_typeadjust (ltype, rtype);
+            }
             Expr->Type = ArithmeticConvert (Expr->Type, Expr2.Type);
 
             /* Generate code */
@@ -2798,7 +2985,8 @@ static void parseadd (ExprDesc* Expr, int DoArrayRef)
 {
     ExprDesc Expr2;
     unsigned flags;             /* Operation flags */
-    CodeMark Mark;              /* Remember code position */
+    CodeMark Mark1;             /* Remember code position */
+    CodeMark Mark;              /* Another code position */
     const Type* lhst;           /* Type of left hand side */
     const Type* rhst;           /* Type of right hand side */
     int lscale;
@@ -2987,9 +3175,14 @@ static void parseadd (ExprDesc* Expr, int DoArrayRef)
 
             /* Generate the code for the add */
             if (!AddDone) {
-                if (ED_IsAbs (Expr) &&
-                    Expr->IVal >= 0 &&
-                    Expr->IVal * lscale < 256) {
+                if (ED_IsAbs (Expr) && lscale == 1 && NarrowToByte (Expr, &Expr2)) {
+                    /* Only the low byte of the result is used */
+                    LoadLowByte (&Expr2, &Mark);
+                    g_inc (CF_CHAR | CF_FORCECHAR | CF_CONST, Expr->IVal);
+                    AddDone = 1;
+                } else if (ED_IsAbs (Expr) &&
+                           Expr->IVal >= 0 &&
+                           Expr->IVal * lscale < 256) {
                     /* Numeric constant */
                     g_inc (flags, Expr->IVal * lscale);
                     AddDone = 1;
@@ -3042,6 +3235,7 @@ static void parseadd (ExprDesc* Expr, int DoArrayRef)
     } else {
 
         /* Left hand side is not constant. Get the value onto the stack. */
+        GetCodePos (&Mark1);
         LoadExpr (CF_NONE, Expr);               /* --> primary register */
         GetCodePos (&Mark);
         flags = CG_TypeOf (Expr->Type);         /* default codegen type */
@@ -3072,8 +3266,16 @@ static void parseadd (ExprDesc* Expr, int DoArrayRef)
                 flags = CF_PTR;
                 Expr->Type = Expr2.Type;
             } else if (!DoArrayRef && IsClassInt (lhst) && IsClassInt (rhst)) {
-                /* Integer addition */
-                flags = typeadjust (Expr, &Expr2, 1);
+                /* Integer addition. If only the low byte of the result is
+                ** used, add to the low byte of the lhs only.
+                */
+                if (NarrowToByte (Expr, &Expr2)) {
+                    LoadLowByte (Expr, &Mark1);
+                    typeadjust (Expr, &Expr2, 1);
+                    flags = CF_CHAR | CF_FORCECHAR;
+                } else {
+                    flags = typeadjust (Expr, &Expr2, 1);
+                }
             } else {
                 /* OOPS */
                 AddDone = -1;
@@ -3119,11 +3321,36 @@ static void parseadd (ExprDesc* Expr, int DoArrayRef)
                 flags = CF_PTR;
                 Expr->Type = Expr2.Type;
             } else if (!DoArrayRef && IsClassInt (lhst) && IsClassInt (rhst)) {
-                /* Integer addition */
-                /* Load rhs into the primary */
-                LoadExpr (CF_NONE, &Expr2);
-                /* Adjust rhs primary if needed  */
-                flags = typeadjust (Expr, &Expr2, 0);
+                if (NarrowToByte (Expr, &Expr2) && IsDirectOperand (&Expr2)) {
+                    /* Only the low byte of the result is used, and the rhs
+                    ** is a variable. Add its low byte to the low byte of the
+                    ** lhs in the primary.
+                    */
+                    RemoveCode (&Mark);
+                    LoadLowByte (Expr, &Mark1);
+                    typeadjust (Expr, &Expr2, 1);
+                    flags = CF_CHAR | CF_FORCECHAR | CG_AddrModeFlags (&Expr2);
+                    if (ED_IsLocStack (&Expr2)) {
+                        g_addlocal (flags, Expr2.IVal);
+                    } else {
+                        g_addstatic (flags, Expr2.Name, Expr2.IVal);
+                    }
+                    AddDone = 1;
+                } else if (IsStaticLongOperand (Expr, &Expr2)) {
+                    /* The rhs is a long variable at a fixed address. Add it
+                    ** to the lhs in the primary.
+                    */
+                    RemoveCode (&Mark);
+                    flags = typeadjust (Expr, &Expr2, 1) | CG_AddrModeFlags (&Expr2);
+                    g_addstatic (flags, Expr2.Name, Expr2.IVal);
+                    AddDone = 1;
+                } else {
+                    /* Integer addition */
+                    /* Load rhs into the primary */
+                    LoadExpr (CF_NONE, &Expr2);
+                    /* Adjust rhs primary if needed  */
+                    flags = typeadjust (Expr, &Expr2, 0);
+                }
             } else {
                 /* OOPS */
                 AddDone = -1;
@@ -3131,7 +3358,9 @@ static void parseadd (ExprDesc* Expr, int DoArrayRef)
             }
 
             /* Generate code for the add (the & is a hack here) */
-            g_add (flags & ~CF_CONST, 0);
+            if (AddDone <= 0) {
+                g_add (flags & ~CF_CONST, 0);
+            }
 
         }
 
@@ -3412,7 +3641,12 @@ static void parsesub (ExprDesc* Expr)
             if (ED_IsConstAbs (&Expr2)) {
                 /* Remove pushed value from stack */
                 RemoveCode (&Mark2);
-                if (IsClassInt (lhst)) {
+                if (NarrowToByte (Expr, &Expr2)) {
+                    /* Only the low byte of the result is used */
+                    LoadLowByte (Expr, &Mark1);
+                    typeadjust (Expr, &Expr2, 1);
+                    flags = CF_CHAR | CF_FORCECHAR;
+                } else if (IsClassInt (lhst)) {
                     /* Adjust the types */
                     flags = typeadjust (Expr, &Expr2, 1);
                 }
@@ -3434,6 +3668,36 @@ static void parsesub (ExprDesc* Expr)
             ED_FinalizeRValLoad (Expr);
         }
 
+    } else if (NarrowToByte (Expr, &Expr2) && IsDirectOperand (&Expr2)) {
+
+        /* Only the low byte of the result is used, and the rhs is a variable.
+        ** Subtract its low byte from the low byte of the lhs in the primary.
+        */
+        RemoveCode (&Mark2);
+        LoadLowByte (Expr, &Mark1);
+        typeadjust (Expr, &Expr2, 1);
+        flags = CF_CHAR | CF_FORCECHAR | CG_AddrModeFlags (&Expr2);
+        if (ED_IsLocStack (&Expr2)) {
+            g_sublocal (flags, Expr2.IVal);
+        } else {
+            g_substatic (flags, Expr2.Name, Expr2.IVal);
+        }
+
+        /* Result is an rvalue in the primary register */
+        ED_FinalizeRValLoad (Expr);
+
+    } else if (IsStaticLongOperand (Expr, &Expr2)) {
+
+        /* The rhs is a long variable at a fixed address. Subtract it from the
+        ** lhs in the primary.
+        */
+        RemoveCode (&Mark2);
+        flags = typeadjust (Expr, &Expr2, 1) | CG_AddrModeFlags (&Expr2);
+        g_substatic (flags, Expr2.Name, Expr2.IVal);
+
+        /* Result is an rvalue in the primary register */
+        ED_FinalizeRValLoad (Expr);
+
     } else {
 
         /* We'll use the pushed lhs on stack instead of the original source */
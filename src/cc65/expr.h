@@ -63,6 +63,24 @@ void MarkedExprWithCheck (void (*Func) (ExprDesc*), ExprDesc* Expr);
 void LimitExprValue (ExprDesc* Expr, int WarnOverflow);
 /* Limit the constant value of the expression to the range of its type */
 
+int ByteResultOnly (const ExprDesc* Expr);
+/* Return true if only the low byte of the result of the operation just parsed
+** is used. This is the case if the expression has the E_NEED_BYTE hint, and
+** no other operator follows that could use the high byte of the result.
+*/
+
+int NarrowToByte (const ExprDesc* Lhs, const ExprDesc* Rhs);
+/* Return true if a binary operation with the given integer operands may be
+** done with their low bytes only, because only the low byte of its result is
+** used.
+*/
+
+void LoadLowByte (ExprDesc* Expr, const CodeMark* Mark);
+/* Replace the code since Mark that loaded the operand Expr into the primary
+** register by code that loads just the low byte, if the operand is a char
+** lvalue.
+*/
+
 void PushAddr (const ExprDesc* Expr);
 /* If the expression contains an address that was somehow evaluated,
 ** push this address on the stack. This is a helper function for all
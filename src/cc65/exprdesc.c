@@ -518,6 +518,18 @@ void ED_IndExpr (ExprDesc* Expr)
 
 
 
+void ED_RequireByteFor (ExprDesc* Expr, const Type* T)
+/* Mark the expression as needing only the low byte of its result, if it is
+** converted to the type T, and this is a char type.
+*/
+{
+    if (IsClassInt (T) && !IsTypeBitField (T) && SizeOf (T) == SIZEOF_CHAR) {
+        Expr->Flags |= E_NEED_BYTE;
+    }
+}
+
+
+
 void ED_MarkForUneval (ExprDesc* Expr)
 /* Mark the expression as not to be evaluated */
 {
@@ -619,6 +631,11 @@ void PrintExprDesc (FILE* F, ExprDesc* E)
         Flags &= ~E_NEED_TEST;
         Sep = ',';
     }
+    if (Flags & E_NEED_BYTE) {
+        fprintf (F, "%cE_NEED_BYTE", Sep);
+        Flags &= ~E_NEED_BYTE;
+        Sep = ',';
+    }
     if (Flags & E_CC_SET) {
         fprintf (F, "%cE_CC_SET", Sep);
         Flags &= ~E_CC_SET;
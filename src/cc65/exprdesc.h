@@ -132,6 +132,7 @@ enum {
     E_NEED_EAX          = 0x000000,     /* Expression result needs to be loaded in Primary */
     E_NEED_NONE         = 0x010000,     /* Expression result is unused */
     E_NEED_TEST         = 0x020000,     /* Expression needs a test to set cc */
+    E_NEED_BYTE         = 0x1000000,    /* Only the low byte of the result is used */
 
     /* Expression evaluation requirements.
     ** Usage: (Flags & E_EVAL_<Flag>) == E_EVAL_<Flag>
@@ -192,7 +193,7 @@ enum {
     E_MASK_KEEP_RESULT      = E_MASK_NEED | E_MASK_EVAL,
 
     /* Flags to keep when using the ED_Make functions */
-    E_MASK_KEEP_MAKE        = E_HAVE_MARKS | E_MASK_KEEP_RESULT,
+    E_MASK_KEEP_MAKE        = E_HAVE_MARKS | E_NEED_BYTE | E_MASK_KEEP_RESULT,
 };
 
 /* Forward */
@@ -403,6 +404,16 @@ INLINE int ED_NeedsTest (const ExprDesc* Expr)
 #  define ED_NeedsTest(Expr)    (((Expr)->Flags & E_NEED_TEST) != 0)
 #endif
 
+#if defined(HAVE_INLINE)
+INLINE int ED_NeedsByte (const ExprDesc* Expr)
+/* Check if only the low byte of the expression result is used. */
+{
+    return (Expr->Flags & E_NEED_BYTE) != 0;
+}
+#else
+#  define ED_NeedsByte(Expr)    (((Expr)->Flags & E_NEED_BYTE) != 0)
+#endif
+
 #if defined(HAVE_INLINE)
 INLINE int ED_IsTested (const ExprDesc* Expr)
 /* Check if the expression has set the condition codes. */
@@ -677,6 +688,11 @@ INLINE void ED_RequireNoTest (ExprDesc* Expr)
 #  define ED_RequireNoTest(Expr)    do { (Expr)->Flags &= ~E_NEED_TEST; } while (0)
 #endif
 
+void ED_RequireByteFor (ExprDesc* Expr, const Type* T);
+/* Mark the expression as needing only the low byte of its result, if it is
+** converted to the type T, and this is a char type.
+*/
+
 #if defined(HAVE_INLINE)
 INLINE void ED_TestDone (ExprDesc* Expr)
 /* Mark the expression as tested and condition codes set. */
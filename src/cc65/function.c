@@ -41,12 +41,18 @@
 #include "asmcode.h"
 #include "asmlabel.h"
 #include "codegen.h"
+#include "codeseg.h"
 #include "error.h"
 #include "expr.h"
 #include "funcdesc.h"
 #include "global.h"
+#include "inliner.h"
 #include "litpool.h"
 #include "locals.h"
+#include "loopvars.h"
+#include "overlay.h"
+#include "profile.h"
+#include "regalloc.h"
 #include "scanner.h"
 #include "stackptr.h"
 #include "standard.h"
@@ -89,7 +95,15 @@ static Function* NewFunction (struct SymEntry* Sym, FuncDesc* D)
     F->RegOffs    = RegisterSpace;
     F->Flags      = IsTypeVoid (F->ReturnType) ? FF_VOID_RETURN : FF_NONE;
 
+    /* Check if the locals may be placed into the overlay area */
+    if (AutoStaticLocals && OV_IsOverlayFunc (Sym->Name)) {
+        F->Flags |= FF_OVERLAY;
+    }
+
     InitCollection (&F->LocalsBlockStack);
+    F->RegAlloc = 0;
+    F->LoopVars = 0;
+    F->Inline   = 0;
 
     /* Return the new structure */
     return F;
@@ -101,6 +115,9 @@ static void FreeFunction (Function* F)
 /* Free a function activation structure */
 {
     DoneCollection (&F->LocalsBlockStack);
+    FreeRegAlloc (F->RegAlloc);
+    FreeLoopVars (F->LoopVars);
+    FreeInlineFunc (F->Inline);
     xfree (F);
 }
 
@@ -224,6 +241,22 @@ int F_HasReturn (const Function* F)
 
 
 
+void F_CallFound (Function* F)
+/* Mark the function as calling other functions */
+{
+    F->Flags |= FF_HAS_CALL;
+}
+
+
+
+int F_HasCall (const Function* F)
+/* Return true if the function calls other functions */
+{
+    return (F->Flags & FF_HAS_CALL) != 0;
+}
+
+
+
 int F_IsMainFunc (const Function* F)
 /* Return true if this is the main function */
 {
@@ -232,6 +265,16 @@ int F_IsMainFunc (const Function* F)
 
 
 
+int F_HasOverlay (const Function* F)
+/* Return true if the locals of the function are placed into the overlay
+** area.
+*/
+{
+    return (F->Flags & FF_OVERLAY) != 0;
+}
+
+
+
 int F_IsVariadic (const Function* F)
 /* Return true if this is a variadic function */
 {
@@ -358,6 +401,38 @@ int F_AllocRegVar (Function* F, const Type* Type)
 
 
 
+int F_AllocAutoRegVar (Function* F, const char* Name, const Type* Type, int IsParam)
+/* Allocate a register variable for an auto variable or parameter if it is
+** used often enough, and return its offset in the register bank. Return -1
+** if the variable should stay on the stack.
+*/
+{
+    /* The main function in cc65 mode doesn't save the register bank */
+    int Save = (IS_Get (&Standard) != STD_CC65) || !F_IsMainFunc (F);
+
+    /* Allow register variables only on top level */
+    if (F->RegAlloc && GetLexicalLevel () == LEX_LEVEL_FUNCTION &&
+        RA_WantRegVar (F->RegAlloc, Name, Type, IsParam, Save, F->RegOffs)) {
+        F->RegOffs -= CheckedSizeOf (Type);
+        return F->RegOffs;
+    }
+
+    /* Leave the variable on the stack */
+    return -1;
+}
+
+
+
+int F_IsByteLoopVar (const Function* F, const char* Name, const Type* Type)
+/* Return true if the local variable with the given name and type is a loop
+** counter that may be declared as unsigned char.
+*/
+{
+    return F->LoopVars && LV_IsByteVar (F->LoopVars, Name, Type);
+}
+
+
+
 static void F_RestoreRegVars (Function* F)
 /* Restore the register variables for the local function if there are any. */
 {
@@ -461,7 +536,8 @@ void NewFunc (SymEntry* Func, FuncDesc* D)
     SymEntry*   Param;
     const Type* RType;          /* Real type used for struct parameters */
     const Type* ReturnType;     /* Return type */
-    
+    const ProfFunc* Prof;       /* Profile data if any */
+
     /* Remember this function descriptor used for definition */
     GetFuncDesc (Func->Type)->FuncDef = D;
 
@@ -544,6 +620,12 @@ void NewFunc (SymEntry* Func, FuncDesc* D)
         CurrentFunc->Flags |= FF_IS_FAR;
     }
 
+    /* Optimize the function for speed or size according to the profile.
+    ** This must be done before the code segment is created.
+    */
+    Prof = PF_FindFunc (GetActualFileName (CurTok.LI), Func->Name);
+    PF_EnterFunc (Prof);
+
     /* Allocate code and data segments for this function */
     Func->V.F.Seg = PushSegContext (Func);
 
@@ -581,6 +663,23 @@ void NewFunc (SymEntry* Func, FuncDesc* D)
     /* Setup the stack */
     StackPtr = 0;
 
+    /* Scan the function body for int loop counters that fit into a byte */
+    if (IS_Get (&NarrowLoopVars)) {
+        CurrentFunc->LoopVars = NewLoopVars ();
+    }
+
+    /* Scan the function body for variables that should be placed into the
+    ** register bank.
+    */
+    if (IS_Get (&AutoRegVars) && PF_GetHeat (Prof) != PF_COLD) {
+        CurrentFunc->RegAlloc = NewRegAlloc (Prof);
+    }
+
+    /* Record the body of a small function for inlining */
+    if (IS_Get (&InlineFuncs)) {
+        CurrentFunc->Inline = NewInlineFunc (Func, D);
+    }
+
     /* Emit code to handle the parameters if all of them have complete types */
     if (ParamComplete) {
         /* Walk through the parameter list and allocate register variable space
@@ -620,6 +719,15 @@ void NewFunc (SymEntry* Func, FuncDesc* D)
                     /* Generate swap code */
                     g_swap_regvars (Param->V.R.SaveOffs, Reg, CheckedSizeOf (RType));
                 }
+
+            } else if (CurrentFunc->RegAlloc && RType == Param->Type) {
+
+                /* Place a frequently used parameter into the register bank */
+                int Reg = F_AllocAutoRegVar (CurrentFunc, Param->Name, RType, 1);
+                if (Reg >= 0) {
+                    SymCvtAutoToRegVar (Param, Reg);
+                    g_swap_regvars (Param->V.R.SaveOffs, Reg, CheckedSizeOf (RType));
+                }
             }
 
             /* Next parameter */
@@ -646,6 +754,15 @@ void NewFunc (SymEntry* Func, FuncDesc* D)
         AnyStatement (0);
     }
 
+    /* Keep the recorded body if the function may be inlined. This is done
+    ** before warnings about unused parameters are output.
+    */
+    if (CurrentFunc->Inline &&
+        FinishInlineFunc (CurrentFunc->Inline, F_HasCall (CurrentFunc))) {
+        Func->V.F.Inline = CurrentFunc->Inline;
+        CurrentFunc->Inline = 0;
+    }
+
     /* Check if this function is missing a return value */
     if (!F_HasVoidReturn (CurrentFunc) && !F_HasReturn (CurrentFunc)) {
         /* If this is the main function in a C99 environment returning an int,
@@ -691,9 +808,17 @@ void NewFunc (SymEntry* Func, FuncDesc* D)
         OutputLocalLiteralPool (Func->V.F.LitPool);
     }
 
+    /* The code is kept until the end of the compilation, so give memory
+    ** that is not used back to the heap.
+    */
+    CS_CompactCode (Func->V.F.Seg->Code);
+
     /* Switch back to the old segments */
     PopSegContext ();
 
+    /* Restore the settings changed for the profile */
+    PF_LeaveFunc ();
+
     /* Eat the closing brace after we've done everything with the function
     ** definition. This way we won't have troubles with pragmas right after
     ** the closing brace.
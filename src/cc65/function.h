@@ -50,6 +50,8 @@ typedef enum {
     FF_IS_MAIN          = 0x0002,       /* This is the main function */
     FF_VOID_RETURN      = 0x0004,       /* Function returning void */
     FF_IS_FAR           = 0x0008,       /* Function is declared "far" (called with JSL and returned from with RTL) */
+    FF_HAS_CALL         = 0x0010,       /* Function calls other functions */
+    FF_OVERLAY          = 0x0020,       /* Locals are in the overlay area */
 } funcflags_t;
 
 /* Structure that holds all data needed for function activation */
@@ -63,6 +65,9 @@ struct Function {
     unsigned            RegOffs;          /* Register variable space offset */
     funcflags_t         Flags;            /* Function flags */
     Collection          LocalsBlockStack; /* Stack of blocks with local vars */
+    struct RegAlloc*    RegAlloc;         /* Automatic register variables */
+    struct LoopVars*    LoopVars;         /* Loop counters that fit into a byte */
+    struct InlineFunc*  Inline;           /* Body recorded for inlining */
 };
 
 /* Structure that holds all data needed for function activation */
@@ -109,9 +114,20 @@ void F_ReturnFound (Function* F);
 int F_HasReturn (const Function* F);
 /* Return true if the function contains a return statement*/
 
+void F_CallFound (Function* F);
+/* Mark the function as calling other functions */
+
+int F_HasCall (const Function* F);
+/* Return true if the function calls other functions */
+
 int F_IsMainFunc (const Function* F);
 /* Return true if this is the main function */
 
+int F_HasOverlay (const Function* F);
+/* Return true if the locals of the function are placed into the overlay
+** area.
+*/
+
 int F_IsVariadic (const Function* F);
 /* Return true if this is a variadic function */
 
@@ -154,6 +170,17 @@ int F_AllocRegVar (Function* F, const Type* Type);
 ** bank (zero page storage). If there is no register space left, return -1.
 */
 
+int F_AllocAutoRegVar (Function* F, const char* Name, const Type* Type, int IsParam);
+/* Allocate a register variable for an auto variable or parameter if it is
+** used often enough, and return its offset in the register bank. Return -1
+** if the variable should stay on the stack.
+*/
+
+int F_IsByteLoopVar (const Function* F, const char* Name, const Type* Type);
+/* Return true if the local variable with the given name and type is a loop
+** counter that may be declared as unsigned char.
+*/
+
 void NewFunc (struct SymEntry* Func, struct FuncDesc* D);
 /* Parse argument declarations and function body. */
 
@@ -45,18 +45,24 @@
 
 unsigned char AddSource         = 0;    /* Add source lines as comments */
 unsigned char AutoCDecl         = 0;    /* Make functions default to __cdecl__ */
+unsigned char AutoStaticLocals  = 0;    /* Make locals static if possible */
 unsigned char DebugInfo         = 0;    /* Add debug info to the obj */
 unsigned char PreprocessOnly    = 0;    /* Just preprocess the input */
 unsigned char DebugOptOutput    = 0;    /* Output debug stuff */
+unsigned char KeepUnused        = 0;    /* Output unused static symbols */
 unsigned      RegisterSpace     = 6;    /* Space available for register vars */
 unsigned      AllowNewComments  = 0;    /* Allow new style comments in C89 mode */
+unsigned      OptJobs           = 1;    /* Number of optimizer threads */
 
 /* Stackable options */
 IntStack WritableStrings    = INTSTACK(0);  /* Literal strings are r/w */
 IntStack LocalStrings       = INTSTACK(0);  /* Emit string literals immediately */
 IntStack InlineStdFuncs     = INTSTACK(0);  /* Inline some standard functions */
+IntStack InlineFuncs        = INTSTACK(0);  /* Inline small functions */
 IntStack EagerlyInlineFuncs = INTSTACK(0);  /* Eagerly inline some known functions */
 IntStack EnableRegVars      = INTSTACK(0);  /* Enable register variables */
+IntStack AutoRegVars        = INTSTACK(0);  /* Place hot locals into registers */
+IntStack NarrowLoopVars     = INTSTACK(0);  /* Use bytes for small loop counters */
 IntStack AllowRegVarAddr    = INTSTACK(0);  /* Allow taking addresses of register vars */
 IntStack RegVarsToCallStack = INTSTACK(0);  /* Save reg variables on call stack */
 IntStack StaticLocals       = INTSTACK(0);  /* Make local variables static */
@@ -64,6 +70,7 @@ IntStack SignedChars        = INTSTACK(0);  /* Make characters signed by default
 IntStack CheckStack         = INTSTACK(0);  /* Generate stack overflow checks */
 IntStack Optimize           = INTSTACK(0);  /* Optimize flag */
 IntStack CodeSizeFactor     = INTSTACK(100);/* Size factor for generated code */
+IntStack CycleWeight        = INTSTACK(0);  /* Weight of cycles against size */
 IntStack DataAlignment      = INTSTACK(1);  /* Alignment for data */
 IntStack CRTIsLong          = INTSTACK(0);  /* C runtime functions must be called with jsl/jml instead of jsr/jmp */
 
@@ -72,3 +79,59 @@ StrBuf DepName        = STATIC_STRBUF_INITIALIZER; /* Name of dependencies file
 StrBuf FullDepName    = STATIC_STRBUF_INITIALIZER; /* Name of full dependencies file */
 StrBuf DepTarget      = STATIC_STRBUF_INITIALIZER; /* Name of dependency target */
 StrBuf DebugTableName = STATIC_STRBUF_INITIALIZER; /* Name of debug table dump file */
+StrBuf PchName        = STATIC_STRBUF_INITIALIZER; /* Name of precompiled header */
+
+/* The stackable options and their saved values */
+static IntStack* const StackableOptions[] = {
+    &WritableStrings,
+    &LocalStrings,
+    &InlineStdFuncs,
+    &InlineFuncs,
+    &EagerlyInlineFuncs,
+    &EnableRegVars,
+    &AutoRegVars,
+    &NarrowLoopVars,
+    &AllowRegVarAddr,
+    &RegVarsToCallStack,
+    &StaticLocals,
+    &SignedChars,
+    &CheckStack,
+    &Optimize,
+    &CodeSizeFactor,
+    &CycleWeight,
+    &DataAlignment,
+    &CRTIsLong,
+};
+#define STACKABLE_OPTION_COUNT \
+    (sizeof (StackableOptions) / sizeof (StackableOptions[0]))
+static IntStack SavedOptions[STACKABLE_OPTION_COUNT];
+
+
+
+/*****************************************************************************/
+/*                                   Code                                    */
+/*****************************************************************************/
+
+
+
+void SaveStackableOptions (void)
+/* Remember the values of the stackable options, so they can be restored
+** by RestoreStackableOptions.
+*/
+{
+    unsigned I;
+    for (I = 0; I < STACKABLE_OPTION_COUNT; ++I) {
+        SavedOptions[I] = *StackableOptions[I];
+    }
+}
+
+
+
+void RestoreStackableOptions (void)
+/* Restore the stackable options to the values saved before */
+{
+    unsigned I;
+    for (I = 0; I < STACKABLE_OPTION_COUNT; ++I) {
+        *StackableOptions[I] = SavedOptions[I];
+    }
+}
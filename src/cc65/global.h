@@ -53,18 +53,24 @@
 /* Options */
 extern unsigned char    AddSource;              /* Add source lines as comments */
 extern unsigned char    AutoCDecl;              /* Make functions default to __cdecl__ */
+extern unsigned char    AutoStaticLocals;       /* Make locals static if possible */
 extern unsigned char    DebugInfo;              /* Add debug info to the obj */
 extern unsigned char    PreprocessOnly;         /* Just preprocess the input */
 extern unsigned char    DebugOptOutput;         /* Output debug stuff */
+extern unsigned char    KeepUnused;             /* Output unused static symbols */
 extern unsigned         RegisterSpace;          /* Space available for register vars */
 extern unsigned         AllowNewComments;       /* Allow new style comments in C89 mode */
+extern unsigned         OptJobs;                /* Number of optimizer threads */
 
 /* Stackable options */
 extern IntStack         WritableStrings;        /* Literal strings are r/w */
 extern IntStack         LocalStrings;           /* Emit string literals immediately */
 extern IntStack         InlineStdFuncs;         /* Inline some standard functions */
+extern IntStack         InlineFuncs;            /* Inline small functions */
 extern IntStack         EagerlyInlineFuncs;     /* Eagerly inline some known functions */
 extern IntStack         EnableRegVars;          /* Enable register variables */
+extern IntStack         AutoRegVars;            /* Place hot locals into registers */
+extern IntStack         NarrowLoopVars;         /* Use bytes for small loop counters */
 extern IntStack         AllowRegVarAddr;        /* Allow taking addresses of register vars */
 extern IntStack         RegVarsToCallStack;     /* Save reg variables on call stack */
 extern IntStack         StaticLocals;           /* Make local variables static */
@@ -72,6 +78,7 @@ extern IntStack         SignedChars;            /* Use 'signed char' as the unde
 extern IntStack         CheckStack;             /* Generate stack overflow checks */
 extern IntStack         Optimize;               /* Optimize flag */
 extern IntStack         CodeSizeFactor;         /* Size factor for generated code */
+extern IntStack         CycleWeight;            /* Weight of cycles against size */
 extern IntStack         DataAlignment;          /* Alignment for data */
 extern IntStack         CRTIsLong;              /* C runtime functions must be called with jsl/jml instead of jsr/jmp */
 
@@ -80,6 +87,23 @@ extern StrBuf           DepName;                /* Name of dependencies file */
 extern StrBuf           FullDepName;            /* Name of full dependencies file */
 extern StrBuf           DepTarget;              /* Name of dependency target */
 extern StrBuf           DebugTableName;         /* Name of debug table dump file */
+extern StrBuf           PchName;                /* Name of precompiled header */
+
+
+
+/*****************************************************************************/
+/*                                   Code                                    */
+/*****************************************************************************/
+
+
+
+void SaveStackableOptions (void);
+/* Remember the values of the stackable options, so they can be restored
+** by RestoreStackableOptions.
+*/
+
+void RestoreStackableOptions (void);
+/* Restore the stackable options to the values saved before */
 
 
 
@@ -0,0 +1,687 @@
+/*****************************************************************************/
+/*                                                                           */
+/*                                 inliner.c                                 */
+/*                                                                           */
+/*                        Inlining of small functions                        */
+/*                                                                           */
+/*                                                                           */
+/*                                                                           */
+/* Copyright 2026 The cc65 Authors                                           */
+/*                                                                           */
+/*                                                                           */
+/* This software is provided 'as-is', without any expressed or implied       */
+/* warranty.  In no event will the authors be held liable for any damages    */
+/* arising from the use of this software.                                    */
+/*                                                                           */
+/* Permission is granted to anyone to use this software for any purpose,     */
+/* including commercial applications, and to alter it and redistribute it    */
+/* freely, subject to the following restrictions:                            */
+/*                                                                           */
+/* 1. The origin of this software must not be misrepresented; you must not   */
+/*    claim that you wrote the original software. If you use this software   */
+/*    in a product, an acknowledgment in the product documentation would be  */
+/*    appreciated but is not required.                                       */
+/* 2. Altered source versions must be plainly marked as such, and must not   */
+/*    be misrepresented as being the original software.                      */
+/* 3. This notice may not be removed or altered from any source              */
+/*    distribution.                                                          */
+/*                                                                           */
+/*****************************************************************************/
+
+
+
+#include <string.h>
+
+/* common */
+#include "tgttrans.h"
+#include "xmalloc.h"
+
+/* cc65 */
+#include "asmcode.h"
+#include "codegen.h"
+#include "error.h"
+#include "expr.h"
+#include "function.h"
+#include "global.h"
+#include "loadexpr.h"
+#include "scanner.h"
+#include "seqpoint.h"
+#include "stackptr.h"
+#include "symtab.h"
+#include "typeconv.h"
+#include "inliner.h"
+
+
+
+/*****************************************************************************/
+/*                                   Data                                    */
+/*****************************************************************************/
+
+
+
+/* Maximum number of tokens in the expression of an inlined function with a
+** code size factor of 100. The limit is doubled for functions declared
+** inline, and it is never larger than IL_MAX_TOKENS.
+*/
+#define IL_TOKENS       16U
+#define IL_MAX_TOKENS   256U
+
+/* A parameter of the function */
+typedef struct ILParam ILParam;
+struct ILParam {
+    SymEntry*       Sym;                /* Parameter symbol */
+    unsigned        Uses;               /* Number of uses in the body */
+    int             AddrTaken;          /* Address may be taken */
+    ExprDesc        Arg;                /* Argument while inlining */
+};
+
+/* An identifier in the body that is not a parameter */
+typedef struct ILIdent ILIdent;
+struct ILIdent {
+    const char*     Name;               /* Name of the identifier */
+    SymEntry*       Sym;                /* Symbol found in the definition */
+};
+
+/* State while scanning the body */
+enum {
+    IS_RETURN,                          /* Expecting "return" */
+    IS_EXPR,                            /* In the returned expression */
+    IS_END,                             /* Expecting the closing brace */
+    IS_DONE,                            /* Body is suitable */
+    IS_FAIL                             /* Body cannot be inlined */
+};
+
+struct InlineFunc {
+    SymEntry*       Func;               /* The function */
+    const Type*     ReturnType;         /* Return type of the function */
+    unsigned        ParamCount;         /* Number of parameters */
+    ILParam*        Params;             /* Parameters */
+    unsigned        IdentCount;         /* Number of other identifiers */
+    ILIdent*        Idents;             /* Other identifiers */
+    unsigned        TokCount;           /* Number of tokens in the body */
+    Token*          Toks;               /* Tokens of the returned expression */
+
+    /* Scanner state */
+    FuncDesc*       Desc;               /* Function descriptor */
+    unsigned        MaxToks;            /* Maximum number of tokens */
+    unsigned        State;              /* IS_xxx */
+    unsigned        Depth;              /* Parenthesis and bracket nesting */
+    token_t         PrevTok;            /* Previous token */
+    ILParam*        AddrOf;             /* Parameter after '&' */
+    unsigned        Errors;             /* Error count before the body */
+    unsigned        Warnings;           /* Warning count before the body */
+};
+
+/* Function that is currently inlined */
+static InlineFunc* Active = 0;
+
+/* State while scanning the arguments of a call */
+typedef struct ILArgScan ILArgScan;
+struct ILArgScan {
+    unsigned        Depth;              /* Nesting of parens, brackets, braces */
+    unsigned        Count;              /* Number of arguments */
+    int             Effects;            /* Arguments may have side effects */
+    token_t         PrevTok;            /* Previous token */
+};
+
+
+
+/*****************************************************************************/
+/*                              Helper functions                             */
+/*****************************************************************************/
+
+
+
+static ILParam* FindParam (InlineFunc* I, const char* Name)
+/* Return the parameter with the given name or NULL */
+{
+    unsigned N;
+    for (N = 0; N < I->ParamCount; ++N) {
+        if (strcmp (I->Params[N].Sym->Name, Name) == 0) {
+            return I->Params + N;
+        }
+    }
+    return 0;
+}
+
+
+
+static int IsOperandEnd (token_t Tok)
+/* Return true if the token may be the last token of an operand */
+{
+    return Tok == TOK_IDENT  || Tok == TOK_ICONST || Tok == TOK_CCONST ||
+           Tok == TOK_FCONST || Tok == TOK_RPAREN || Tok == TOK_RBRACK;
+}
+
+
+
+static int AddIdent (InlineFunc* I, const Token* T)
+/* Handle an identifier in the body. Return false if the body cannot be
+** inlined.
+*/
+{
+    ILParam*  P;
+    SymEntry* Sym;
+
+    /* Struct and union members are resolved by the parser */
+    if (I->PrevTok == TOK_DOT || I->PrevTok == TOK_PTR_REF) {
+        return 1;
+    }
+
+    /* Parameters are replaced by the arguments */
+    P = FindParam (I, T->Ident);
+    if (P) {
+        ++P->Uses;
+        if (I->PrevTok == TOK_AND) {
+            I->AddrOf = P;
+        }
+        return 1;
+    }
+
+    /* Other identifiers must mean the same at the call site. Local symbols
+    ** of the function like __func__ cannot be used there.
+    */
+    Sym = FindSym (T->Ident);
+    if (Sym == 0 || Sym->Owner == I->Desc->SymTab) {
+        return 0;
+    }
+    I->Idents = xrealloc (I->Idents, (I->IdentCount + 1) * sizeof (ILIdent));
+    I->Idents[I->IdentCount].Name = Sym->Name;
+    I->Idents[I->IdentCount].Sym  = Sym;
+    ++I->IdentCount;
+    return 1;
+}
+
+
+
+static int ScanToken (const Token* T, void* Data)
+/* Check and record one token of the function body */
+{
+    InlineFunc* I = Data;
+    unsigned    N;
+
+    switch (I->State) {
+
+        case IS_RETURN:
+            I->State = (T->Tok == TOK_RETURN)? IS_EXPR : IS_FAIL;
+            break;
+
+        case IS_END:
+            I->State = (T->Tok == TOK_RCURLY)? IS_DONE : IS_FAIL;
+            break;
+
+        case IS_EXPR:
+            /* '&' applies to a parameter unless a postfix operator follows */
+            if (I->AddrOf && T->Tok != TOK_LBRACK &&
+                T->Tok != TOK_DOT && T->Tok != TOK_PTR_REF) {
+                I->AddrOf->AddrTaken = 1;
+            }
+            I->AddrOf = 0;
+
+            switch (T->Tok) {
+
+                case TOK_SEMI:
+                    if (I->Depth > 0 || I->TokCount == 0) {
+                        I->State = IS_FAIL;
+                    } else {
+                        I->State = IS_END;
+                    }
+                    return 1;
+
+                case TOK_LPAREN:
+                    /* '&(' may take the address of any parameter */
+                    if (I->PrevTok == TOK_AND) {
+                        for (N = 0; N < I->ParamCount; ++N) {
+                            I->Params[N].AddrTaken = 1;
+                        }
+                    }
+                    ++I->Depth;
+                    break;
+
+                case TOK_LBRACK:
+                    ++I->Depth;
+                    break;
+
+                case TOK_RPAREN:
+                case TOK_RBRACK:
+                    if (I->Depth == 0) {
+                        I->State = IS_FAIL;
+                        return 0;
+                    }
+                    --I->Depth;
+                    break;
+
+                case TOK_BOOL_AND:
+                    /* Not the address of a label */
+                    if (!IsOperandEnd (I->PrevTok)) {
+                        I->State = IS_FAIL;
+                        return 0;
+                    }
+                    break;
+
+                case TOK_DOT:       case TOK_PTR_REF:   case TOK_AND:
+                case TOK_STAR:      case TOK_PLUS:      case TOK_MINUS:
+                case TOK_COMP:      case TOK_BOOL_NOT:  case TOK_DIV:
+                case TOK_MOD:       case TOK_SHL:       case TOK_SHR:
+                case TOK_LT:        case TOK_GT:        case TOK_LE:
+                case TOK_GE:        case TOK_EQ:        case TOK_NE:
+                case TOK_XOR:       case TOK_OR:        case TOK_BOOL_OR:
+                case TOK_QUEST:     case TOK_COLON:     case TOK_COMMA:
+                case TOK_ICONST:    case TOK_FCONST:    case TOK_CCONST:
+                case TOK_SIZEOF:
+                case TOK_CONST:     case TOK_VOLATILE:  case TOK_RESTRICT:
+                case TOK_CHAR:      case TOK_INT:       case TOK_DOUBLE:
+                case TOK_FLOAT:     case TOK_LONG:      case TOK_UNSIGNED:
+                case TOK_SIGNED:    case TOK_SHORT:     case TOK_VOID:
+                    break;
+
+                case TOK_IDENT:
+                    if (!AddIdent (I, T)) {
+                        I->State = IS_FAIL;
+                        return 0;
+                    }
+                    break;
+
+                default:
+                    /* Side effects, literals, tags, pragmas and others */
+                    I->State = IS_FAIL;
+                    return 0;
+            }
+
+            /* Record the token */
+            if (I->TokCount == I->MaxToks) {
+                I->State = IS_FAIL;
+                return 0;
+            }
+            I->Toks[I->TokCount] = *T;
+            I->Toks[I->TokCount].LI = UseLineInfo (T->LI);
+            if (T->Tok == TOK_CCONST) {
+                /* Translate the character now, the charmap may change */
+                I->Toks[I->TokCount].Tok = TOK_ICONST;
+                if (!NoCharMap) {
+                    I->Toks[I->TokCount].IVal =
+                        SignExtendChar (TgtTranslateChar (T->IVal));
+                }
+            }
+            ++I->TokCount;
+            I->PrevTok = T->Tok;
+            return 1;
+
+        default:
+            break;
+    }
+
+    return I->State != IS_DONE && I->State != IS_FAIL;
+}
+
+
+
+static int ScanArgToken (const Token* T, void* Data)
+/* Count the arguments of a call and check them for side effects */
+{
+    ILArgScan* S = Data;
+
+    switch (T->Tok) {
+
+        case TOK_LPAREN:
+            /* Assume that a function is called */
+            if (S->PrevTok == TOK_IDENT || S->PrevTok == TOK_RPAREN ||
+                S->PrevTok == TOK_RBRACK) {
+                S->Effects = 1;
+            }
+            ++S->Depth;
+            break;
+
+        case TOK_LBRACK:
+        case TOK_LCURLY:
+            ++S->Depth;
+            break;
+
+        case TOK_RPAREN:
+            if (S->Depth == 0) {
+                /* End of the argument list */
+                if (S->PrevTok != TOK_INVALID) {
+                    ++S->Count;
+                }
+                return 0;
+            }
+            --S->Depth;
+            break;
+
+        case TOK_RBRACK:
+        case TOK_RCURLY:
+            if (S->Depth > 0) {
+                --S->Depth;
+            }
+            break;
+
+        case TOK_COMMA:
+            if (S->Depth == 0) {
+                ++S->Count;
+            }
+            break;
+
+        case TOK_ASSIGN:        case TOK_MUL_ASSIGN:    case TOK_DIV_ASSIGN:
+        case TOK_MOD_ASSIGN:    case TOK_PLUS_ASSIGN:   case TOK_MINUS_ASSIGN:
+        case TOK_SHL_ASSIGN:    case TOK_SHR_ASSIGN:    case TOK_AND_ASSIGN:
+        case TOK_XOR_ASSIGN:    case TOK_OR_ASSIGN:     case TOK_INC:
+        case TOK_DEC:           case TOK_ASM:           case TOK_A:
+        case TOK_X:             case TOK_Y:             case TOK_AX:
+        case TOK_EAX:
+            S->Effects = 1;
+            break;
+
+        case TOK_SEMI:
+        case TOK_CEOF:
+            /* Syntax error, let the normal call handle it */
+            S->Count = ~0U;
+            return 0;
+
+        default:
+            break;
+    }
+
+    S->PrevTok = T->Tok;
+    return 1;
+}
+
+
+
+static int IsSimpleArg (const ExprDesc* Arg, int Effects)
+/* Return true if the converted argument may be used in place of the
+** parameter without evaluating it into a temporary.
+*/
+{
+    if ((Arg->Flags & E_SIDE_EFFECTS) != 0) {
+        return 0;
+    }
+
+    /* Constants and addresses */
+    if (ED_IsRVal (Arg) && ED_IsQuasiConst (Arg)) {
+        return 1;
+    }
+
+    /* Variables that cannot be changed by the other arguments */
+    return !Effects                     &&
+           ED_IsLVal (Arg)              &&
+           ED_IsLocQuasiConst (Arg)     &&
+           !ED_IsLocAbs (Arg)           &&
+           !IsTypeBitField (Arg->Type)  &&
+           !IsQualVolatile (Arg->Type);
+}
+
+
+
+/*****************************************************************************/
+/*                                   Code                                    */
+/*****************************************************************************/
+
+
+
+InlineFunc* NewInlineFunc (SymEntry* Func, FuncDesc* D)
+/* Check if the function that is being defined may be inlined, and record
+** the tokens of its body. CurTok must be the opening curly brace of the body.
+** Return NULL if the function cannot be inlined.
+*/
+{
+    InlineFunc* I;
+    SymEntry*   Param;
+    const Type* ReturnType = GetFuncReturnType (Func->Type);
+    unsigned    MaxToks;
+
+    /* Only static and inline functions with scalar parameters and result
+    ** are inlined, main() and variadic functions are not.
+    */
+    if (CurTok.Tok != TOK_LCURLY                                        ||
+        ((Func->Flags & SC_STORAGEMASK) != SC_STATIC &&
+         (Func->Flags & SC_INLINE) == 0)                                ||
+        strcmp (Func->Name, "main") == 0                                ||
+        (D->Flags & (FD_VARIADIC | FD_OLDSTYLE | FD_UNNAMED_PARAMS)) != 0 ||
+        IsLongFnFunc (Func->Type)                                       ||
+        (!IsClassInt (ReturnType) && !IsClassPtr (ReturnType))) {
+        return 0;
+    }
+    for (Param = D->SymTab->SymHead; Param && (Param->Flags & SC_PARAM) != 0;
+         Param = Param->NextSym) {
+        if (!IsClassInt (Param->Type) && !IsClassPtr (Param->Type)) {
+            return 0;
+        }
+    }
+
+    /* Determine the size limit */
+    MaxToks = IL_TOKENS * IS_Get (&CodeSizeFactor) / 100;
+    if ((Func->Flags & SC_INLINE) != 0) {
+        MaxToks *= 2;
+    }
+    if (MaxToks > IL_MAX_TOKENS) {
+        MaxToks = IL_MAX_TOKENS;
+    }
+    if (MaxToks == 0) {
+        return 0;
+    }
+
+    /* Create the record */
+    I = xmalloc (sizeof (InlineFunc));
+    I->Func         = Func;
+    I->ReturnType   = ReturnType;
+    I->ParamCount   = D->ParamCount;
+    I->Params       = xmalloc (D->ParamCount * sizeof (ILParam));
+    I->IdentCount   = 0;
+    I->Idents       = 0;
+    I->TokCount     = 0;
+    I->Toks         = xmalloc (MaxToks * sizeof (Token));
+    I->Desc         = D;
+    I->MaxToks      = MaxToks;
+    I->State        = IS_RETURN;
+    I->Depth        = 0;
+    I->PrevTok      = TOK_INVALID;
+    I->AddrOf       = 0;
+    I->Errors       = ErrorCount;
+    I->Warnings     = WarningCount;
+
+    Param = D->SymTab->SymHead;
+    I->ParamCount = 0;
+    while (Param && (Param->Flags & SC_PARAM) != 0 && I->ParamCount < D->ParamCount) {
+        ILParam* P   = I->Params + I->ParamCount++;
+        P->Sym       = Param;
+        P->Uses      = 0;
+        P->AddrTaken = 0;
+        Param = Param->NextSym;
+    }
+
+    /* Scan the body */
+    if (I->ParamCount == D->ParamCount) {
+        LookAhead (ScanToken, I);
+    }
+    if (I->State != IS_DONE) {
+        FreeInlineFunc (I);
+        return 0;
+    }
+    return I;
+}
+
+
+
+void FreeInlineFunc (InlineFunc* I)
+/* Free the data of a function */
+{
+    if (I) {
+        unsigned N;
+        for (N = 0; N < I->TokCount; ++N) {
+            ReleaseLineInfo (I->Toks[N].LI);
+        }
+        xfree (I->Toks);
+        xfree (I->Idents);
+        xfree (I->Params);
+        xfree (I);
+    }
+}
+
+
+
+int FinishInlineFunc (InlineFunc* I, int HasCall)
+/* Check the function after its body has been parsed. HasCall is true if the
+** body contains a function call. Return true if the function may be inlined.
+*/
+{
+    /* Diagnostics would be repeated for each call, and calls may have side
+    ** effects.
+    */
+    return !HasCall && ErrorCount == I->Errors && WarningCount == I->Warnings;
+}
+
+
+
+int InlineCall (ExprDesc* Expr)
+/* Replace a call of the function in Expr by its body if possible, and return
+** true in this case. CurTok must be the first token after the left paren of
+** the argument list.
+*/
+{
+    InlineFunc* I;
+    ILArgScan   S;
+    ExprDesc    Result;
+    CodeMark    Start;
+    CodeMark    End;
+    int         OldStackPtr;
+    unsigned    N;
+
+    /* Check if the function can be inlined here */
+    if (!IS_Get (&InlineFuncs)                                          ||
+        CurrentFunc == 0                                                ||
+        Expr->Sym == 0                                                  ||
+        (Expr->Sym->Flags & SC_TYPEMASK) != SC_FUNC                     ||
+        (I = Expr->Sym->V.F.Inline) == 0                                ||
+        Expr->Sym->V.F.WrappedCall != 0                                 ||
+        ED_IsUneval (Expr)                                              ||
+        ED_NeedsConst (Expr)) {
+        return 0;
+    }
+
+    /* The identifiers in the body must have the same meaning here, and the
+    ** parameters must not be hidden by type names.
+    */
+    for (N = 0; N < I->IdentCount; ++N) {
+        if (FindSym (I->Idents[N].Name) != I->Idents[N].Sym) {
+            return 0;
+        }
+    }
+    for (N = 0; N < I->ParamCount; ++N) {
+        SymEntry* Sym = FindSym (I->Params[N].Sym->Name);
+        if (Sym && (Sym->Flags & SC_TYPEMASK) == SC_TYPEDEF) {
+            return 0;
+        }
+    }
+
+    /* Count the arguments and check them for side effects */
+    S.Depth   = 0;
+    S.Count   = 0;
+    S.Effects = 0;
+    S.PrevTok = TOK_INVALID;
+    if (ScanArgToken (&CurTok, &S)) {
+        LookAhead (ScanArgToken, &S);
+    }
+    if (S.Count != I->ParamCount) {
+        return 0;
+    }
+
+    /* Evaluate the arguments */
+    GetCodePos (&Start);
+    OldStackPtr = StackPtr;
+    for (N = 0; N < I->ParamCount; ++N) {
+
+        ILParam* P = I->Params + N;
+        ExprDesc Arg;
+        int      IsBitField;
+
+        if (N > 0) {
+            ConsumeComma ();
+        }
+
+        ED_Init (&Arg);
+        Arg.Flags |= Expr->Flags & E_MASK_KEEP_SUBEXPR;
+        hie1 (&Arg);
+        IsBitField = IsTypeBitField (Arg.Type);
+        TypeConversion (&Arg, P->Sym->Type);
+        ED_PropagateFrom (Expr, &Arg);
+
+        if (P->Uses == 0) {
+            /* Evaluate the argument for its side effects only */
+            if (!IsSimpleArg (&Arg, 0)) {
+                LoadExpr (CF_NONE, &Arg);
+            }
+        } else if (!P->AddrTaken && !IsBitField && IsSimpleArg (&Arg, S.Effects)) {
+            /* Use the argument directly */
+            P->Arg = Arg;
+            P->Arg.Flags &= ~(E_MASK_KEEP_MAKE | E_MASK_VIRAL);
+        } else {
+            /* Evaluate the argument into a temporary on the stack */
+            LoadExpr (CF_NONE, &Arg);
+            g_push (CG_TypeOf (P->Sym->Type) | CF_FORCECHAR, 0);
+            ED_Init (&P->Arg);
+            P->Arg.Flags = E_LOC_STACK | E_RTYPE_LVAL;
+            P->Arg.IVal  = StackPtr;
+        }
+        P->Arg.Type = P->Sym->Type;
+
+        /* Append deferred inc/dec at sequence point */
+        DoDeferred (SQP_KEEP_NONE, &Arg);
+    }
+    ConsumeRParen ();
+
+    /* Parse the expression of the function with the parameters replaced.
+    ** Diagnostics have been output for the function definition.
+    */
+    IS_Push (&WarnEnable, 0);
+    Active = I;
+    ReplayTokens (I->Toks, I->TokCount);
+    ED_Init (&Result);
+    Result.Flags |= Expr->Flags & E_MASK_KEEP_SUBEXPR;
+    hie0 (&Result);
+    CHECK (CurTok.Tok == TOK_SEMI);
+    EndReplay ();
+    Active = 0;
+    TypeConversion (&Result, I->ReturnType);
+    IS_Drop (&WarnEnable);
+
+    /* A constant result is kept if there is no code. Otherwise the result is
+    ** loaded into the primary register, and the temporaries are dropped.
+    */
+    GetCodePos (&End);
+    if (ED_IsConstAbs (&Result) && CodeRangeIsEmpty (&Start, &End)) {
+        ED_MakeConstAbs (Expr, Result.IVal, I->ReturnType);
+    } else {
+        LoadExpr (CF_NONE, &Result);
+        if (StackPtr != OldStackPtr) {
+            g_drop (OldStackPtr - StackPtr);
+            StackPtr = OldStackPtr;
+        }
+        ED_FinalizeRValLoad (Expr);
+        Expr->Type = I->ReturnType;
+    }
+
+    /* Calls are assumed to have side effects like in FunctionCall */
+    Expr->Flags |= E_SIDE_EFFECTS;
+    return 1;
+}
+
+
+
+int InlineParam (const char* Name, ExprDesc* Expr)
+/* If Name is a parameter of the function that is currently inlined, set Expr
+** to the argument and return true.
+*/
+{
+    ILParam* P;
+
+    if (Active == 0 || (P = FindParam (Active, Name)) == 0) {
+        return 0;
+    }
+    Expr->Flags = P->Arg.Flags;
+    Expr->Type  = P->Arg.Type;
+    Expr->Sym   = P->Arg.Sym;
+    Expr->Name  = P->Arg.Name;
+    Expr->IVal  = P->Arg.IVal;
+    Expr->V     = P->Arg.V;
+    return 1;
+}
@@ -0,0 +1,102 @@
+/*****************************************************************************/
+/*                                                                           */
+/*                                 inliner.h                                 */
+/*                                                                           */
+/*                        Inlining of small functions                        */
+/*                                                                           */
+/*                                                                           */
+/*                                                                           */
+/* Copyright 2026 The cc65 Authors                                           */
+/*                                                                           */
+/*                                                                           */
+/* This software is provided 'as-is', without any expressed or implied       */
+/* warranty.  In no event will the authors be held liable for any damages    */
+/* arising from the use of this software.                                    */
+/*                                                                           */
+/* Permission is granted to anyone to use this software for any purpose,     */
+/* including commercial applications, and to alter it and redistribute it    */
+/* freely, subject to the following restrictions:                            */
+/*                                                                           */
+/* 1. The origin of this software must not be misrepresented; you must not   */
+/*    claim that you wrote the original software. If you use this software   */
+/*    in a product, an acknowledgment in the product documentation would be  */
+/*    appreciated but is not required.                                       */
+/* 2. Altered source versions must be plainly marked as such, and must not   */
+/*    be misrepresented as being the original software.                      */
+/* 3. This notice may not be removed or altered from any source              */
+/*    distribution.                                                          */
+/*                                                                           */
+/*****************************************************************************/
+
+
+
+/* With --inline-funcs, calls of small static or inline functions are
+** replaced by the body of the function. Since the compiler translates a
+** function in one pass, only functions whose body consists of a single
+** return statement without side effects are handled. The tokens of the
+** expression are recorded when the function is defined, and parsed again in
+** place of each call, with the parameters replaced by the arguments. Constant
+** arguments and variables are used directly, other arguments are evaluated
+** once into temporaries on the stack.
+*/
+
+
+
+#ifndef INLINER_H
+#define INLINER_H
+
+
+
+/* cc65 */
+#include "exprdesc.h"
+#include "funcdesc.h"
+#include "symentry.h"
+
+
+
+/*****************************************************************************/
+/*                                   Data                                    */
+/*****************************************************************************/
+
+
+
+typedef struct InlineFunc InlineFunc;
+
+
+
+/*****************************************************************************/
+/*                                   Code                                    */
+/*****************************************************************************/
+
+
+
+InlineFunc* NewInlineFunc (SymEntry* Func, FuncDesc* D);
+/* Check if the function that is being defined may be inlined, and record
+** the tokens of its body. CurTok must be the opening curly brace of the body.
+** Return NULL if the function cannot be inlined.
+*/
+
+void FreeInlineFunc (InlineFunc* I);
+/* Free the data of a function */
+
+int FinishInlineFunc (InlineFunc* I, int HasCall);
+/* Check the function after its body has been parsed. HasCall is true if the
+** body contains a function call. Return true if the function may be inlined.
+*/
+
+int InlineCall (ExprDesc* Expr);
+/* Replace a call of the function in Expr by its body if possible, and return
+** true in this case. CurTok must be the first token after the left paren of
+** the argument list.
+*/
+
+int InlineParam (const char* Name, ExprDesc* Expr);
+/* If Name is a parameter of the function that is currently inlined, set Expr
+** to the argument and return true.
+*/
+
+
+
+/* End of inliner.h */
+
+#endif
@@ -45,6 +45,7 @@
 #include "print.h"
 #include "strbuf.h"
 #include "xmalloc.h"
+#include "xsprintf.h"
 
 /* cc65 */
 #include "codegen.h"
@@ -53,7 +54,9 @@
 #include "incpath.h"
 #include "input.h"
 #include "lineinfo.h"
+#include "macrotab.h"
 #include "output.h"
+#include "pch.h"
 #include "preproc.h"
 
 
@@ -77,6 +80,9 @@ char NextC = '\0';
 /* Maximum count of nested includes */
 #define MAX_INC_NESTING         16
 
+/* Size of the read buffer of an input file */
+#define INPUT_BUF_SIZE          16384
+
 /* Struct that describes an input file */
 typedef struct IFile IFile;
 struct IFile {
@@ -85,6 +91,8 @@ struct IFile {
     unsigned long   Size;       /* File size */
     unsigned long   MTime;      /* Time of last modification */
     InputType       Type;       /* Type of input file */
+    int             Once;       /* File had #pragma once */
+    char*           Guard;      /* Include guard macro or NULL */
     char            Name[1];    /* Name of file (dynamically allocated) */
 };
 
@@ -99,6 +107,10 @@ struct AFile {
     char*       PName;          /* Presumed name of the file */
     PPIfStack   IfStack;        /* PP #if stack */
     int         MissingNL;      /* Last input line was missing a newline */
+    char*       Buf;            /* Read buffer */
+    unsigned    BufPos;         /* Position of the next character in Buf */
+    unsigned    BufLen;         /* Number of characters in Buf */
+    int         Precompiled;    /* Text of a precompiled header */
 };
 
 /* List of all input files */
@@ -112,6 +124,15 @@ static Collection* CurrentInputStack;
 
 /* Counter for the __COUNTER__ macro */
 static unsigned MainFileCounter;
+
+/* Number of includes skipped because of an include guard or #pragma once */
+static unsigned SkippedIncludes;
+
+/* Recording of the header prefix of the main file for a precompiled header */
+static StrBuf*      PrefixText;         /* Preprocessed text or NULL */
+static unsigned     PrefixLines;        /* Number of lines in the prefix */
+static const IFile* PrefixFile;         /* Input file of the last line */
+static unsigned     PrefixLine;         /* Line number of the last line */
 LineInfo* PrevDiagnosticLI;
 
 
@@ -137,6 +158,8 @@ static IFile* NewIFile (const char* Name, InputType Type)
     IF->Size  = 0;
     IF->MTime = 0;
     IF->Type  = Type;
+    IF->Once  = 0;
+    IF->Guard = 0;
     memcpy (IF->Name, Name, Len+1);
 
     /* Insert the new structure into the IFile collection */
@@ -172,6 +195,10 @@ static AFile* NewAFile (IFile* IF, FILE* F)
     AF->PName     = 0;
     AF->IfStack.Index = -1;
     AF->MissingNL = 0;
+    AF->Buf       = xmalloc (INPUT_BUF_SIZE);
+    AF->BufPos    = 0;
+    AF->BufLen    = 0;
+    AF->Precompiled = 0;
 
     /* Increment the usage counter of the corresponding IFile. If this
     ** is the first use, set the file data and output debug info if
@@ -223,6 +250,7 @@ static void FreeAFile (AFile* AF)
     if (AF->PName != 0) {
         xfree (AF->PName);
     }
+    xfree (AF->Buf);
     xfree (AF);
 }
 
@@ -292,6 +320,32 @@ void OpenMainFile (const char* Name)
 
     /* Initialize the __COUNTER__ counter */
     MainFileCounter = 0;
+
+    /* No includes skipped so far */
+    SkippedIncludes = 0;
+
+    /* No header prefix recorded */
+    PrefixText = 0;
+}
+
+
+
+void DoneInput (void)
+/* Forget all input files, so the next main file starts with empty lists */
+{
+    unsigned I;
+
+    /* All files must have been closed at the end of the main file */
+    PRECONDITION (CollCount (&AFiles) == 0);
+
+    for (I = 0; I < CollCount (&IFiles); ++I) {
+        IFile* IF = CollAtUnchecked (&IFiles, I);
+        xfree (IF->Guard);
+        xfree (IF);
+    }
+    CollDeleteAll (&IFiles);
+
+    CurReusedLine = 0;
 }
 
 
@@ -328,6 +382,14 @@ void OpenIncludeFile (const char* Name, InputType IT)
     /* We don't need N any longer, since we may now use IF->Name */
     xfree (N);
 
+    /* If the file had #pragma once, or if it is wrapped into an include
+    ** guard that is still defined, including it again has no effect.
+    */
+    if (IF->Once || (IF->Guard != 0 && IsMacro (IF->Guard))) {
+        ++SkippedIncludes;
+        return;
+    }
+
     /* Open the file */
     F = fopen (IF->Name, "r");
     if (F == 0) {
@@ -370,6 +432,11 @@ void CloseIncludeFile (void)
     /* Get the current active input file */
     Input = CollLast (&AFiles);
 
+    /* Remember the include guard of the file */
+    if (Input->IfStack.GuardState == PPGUARD_CLOSED && Input->Input->Guard == 0) {
+        Input->Input->Guard = xstrdup (Input->IfStack.Guard);
+    }
+
     /* Close the current input file (we're just reading so no error check) */
     fclose (Input->F);
 
@@ -389,11 +456,25 @@ void CloseIncludeFile (void)
     if (AFileCount > 0) {
         Input = CollLast (&AFiles);
         SetPPIfStack (&Input->IfStack);
+    } else {
+        Print (stdout, 1, "Skipped %u repeated include%s\n",
+               SkippedIncludes, (SkippedIncludes == 1)? "" : "s");
     }
 }
 
 
 
+void SetIncludeOnce (void)
+/* Mark the current input file, so it isn't included again (#pragma once) */
+{
+    /* Must have an input file when called */
+    PRECONDITION (CollCount (&AFiles) > 0);
+
+    ((AFile*) CollLast (&AFiles))->Input->Once = 1;
+}
+
+
+
 static void GetInputChar (void)
 /* Read the next character from the input stream and make CurC and NextC
 ** valid. If end of line is reached, both are set to NUL, no more lines
@@ -489,12 +570,75 @@ StrBuf* InitLine (StrBuf* Buf)
 
 
 
+static void AppendInput (StrBuf* B, const char* Buf, unsigned Count)
+/* Append characters read from a file to B, skipping embedded NULs */
+{
+    const char* Z;
+
+    while ((Z = memchr (Buf, '\0', Count)) != 0) {
+        SB_AppendBuf (B, Buf, Z - Buf);
+        Count -= Z - Buf + 1;
+        Buf    = Z + 1;
+    }
+    SB_AppendBuf (B, Buf, Count);
+}
+
+
+
+static void SetPrecompiledPos (AFile* AF)
+/* Set the input file and line number from a "#file line" line of a
+** precompiled header. The file is given by its index.
+*/
+{
+    unsigned Index;
+    unsigned LineNum;
+
+    SB_Terminate (Line);
+    if (sscanf (SB_GetConstBuf (Line), "#%u %u", &Index, &LineNum) != 2 ||
+        Index >= CollCount (&IFiles)) {
+        Fatal ("Invalid precompiled header");
+    }
+
+    /* The line number is incremented when the next line is read */
+    AF->Input   = CollAt (&IFiles, Index);
+    AF->LineNum = LineNum - 1;
+}
+
+
+
+static void RecordPrefixLine (void)
+/* Add the preprocessed line to the text of the header prefix */
+{
+    const AFile* AF = CollConstLast (&AFiles);
+
+    /* Set the input file and line number unless the line follows the last */
+    if (AF->Input != PrefixFile || AF->LineNum != PrefixLine + 1) {
+        char Buf[64];
+        xsprintf (Buf, sizeof (Buf), "#%d %u\n",
+                  CollIndex (&IFiles, AF->Input), AF->LineNum);
+        SB_AppendStr (PrefixText, Buf);
+        PrefixFile = AF->Input;
+    }
+    PrefixLine = AF->LineNum;
+
+    /* A leading blank doesn't change the meaning of the line, and it's not
+    ** mistaken for a position then.
+    */
+    if (SB_LookAt (Line, 0) == '#') {
+        SB_AppendChar (PrefixText, ' ');
+    }
+    SB_Append (PrefixText, Line);
+    SB_AppendChar (PrefixText, '\n');
+}
+
+
+
 int NextLine (void)
 /* Get a line from the current input. Returns 0 on end of file with no new
 ** input bytes.
 */
 {
-    int         C;
+    int         AtEOF = 0;
     AFile*      Input;
 
     /* Overwrite the next input line with the pushed line if there is one */
@@ -544,14 +688,30 @@ int NextLine (void)
     /* Get the current input file */
     Input = CollLast (&AFiles);
 
-    /* Read characters until we have one complete line */
+    /* Check for the end of the header prefix if it is recorded */
+    if (PrefixText != 0 && CollCount (&AFiles) == 1 && Input->LineNum == PrefixLines) {
+        PrefixText = 0;
+        EndHeaderPrefix ();
+    }
+
+    /* Read until we have one complete line. Instead of reading the file
+    ** character by character, search the buffer for the end of the line and
+    ** add the characters before it in one go.
+    */
     while (1) {
 
-        /* Read the next character */
-        C = fgetc (Input->F);
+        const char* Start;
+        const char* End;
+        unsigned    Count;
+
+        /* Refill the buffer if it's empty */
+        if (Input->BufPos >= Input->BufLen) {
+            Input->BufPos = 0;
+            Input->BufLen = fread (Input->Buf, 1, INPUT_BUF_SIZE, Input->F);
+        }
 
         /* Check for EOF */
-        if (C == EOF) {
+        if (Input->BufLen == 0) {
 
             if (!Input->MissingNL || SB_NotEmpty (Line)) {
 
@@ -562,18 +722,43 @@ int NextLine (void)
                 Input->MissingNL = 1;
 
             }
+            AtEOF = 1;
             break;
         }
 
         /* Assume no new line */
         Input->MissingNL = 1;
 
+        /* Add the characters up to the end of the line or the buffer */
+        Start = Input->Buf + Input->BufPos;
+        Count = Input->BufLen - Input->BufPos;
+        End   = memchr (Start, '\n', Count);
+        if (End != 0) {
+            Count = End - Start;
+        }
+        AppendInput (Line, Start, Count);
+        Input->BufPos += Count;
+
         /* Check for end of line */
-        if (C == '\n') {
+        if (End != 0) {
 
             /* We got a new line */
+            ++Input->BufPos;
             ++Input->LineNum;
 
+            /* A line of a precompiled header is used as is, unless it sets
+            ** the input file and line number for the lines that follow.
+            */
+            if (Input->Precompiled) {
+                if (SB_LookAt (Line, 0) != '#') {
+                    Input->MissingNL = 0;
+                    break;
+                }
+                SetPrecompiledPos (Input);
+                SB_Clear (Line);
+                continue;
+            }
+
             /* If the \n is preceeded by a \r, remove the \r, so we can read
             ** DOS/Windows files under *nix.
             */
@@ -593,11 +778,6 @@ int NextLine (void)
                 ContinueLine ();
             }
 
-        } else if (C != '\0') {         /* Ignore embedded NULs */
-
-            /* Just some character, add it to the line */
-            SB_AppendChar (Line, C);
-
         }
     }
 
@@ -611,7 +791,7 @@ int NextLine (void)
     UpdateCurrentLineInfo (Line);
 
     /* Done */
-    return C != EOF || SB_NotEmpty (Line);
+    return !AtEOF || SB_NotEmpty (Line);
 }
 
 
@@ -634,8 +814,15 @@ int PreprocessNextLine (void)
         CloseIncludeFile ();
     }
 
-    /* Do preprocess anyways */
-    Preprocess ();
+    /* Do preprocess anyways, unless the line is from a precompiled header */
+    if (!((const AFile*) CollConstLast (&AFiles))->Precompiled) {
+        Preprocess ();
+    }
+
+    /* Add it to the header prefix if that is recorded */
+    if (PrefixText != 0) {
+        RecordPrefixLine ();
+    }
 
     /* Write it to the output file if in preprocess-only mode */
     if (PreprocessOnly) {
@@ -648,6 +835,36 @@ int PreprocessNextLine (void)
 
 
 
+void RecordHeaderPrefix (unsigned Lines, StrBuf* Text)
+/* Record the preprocessed text of the given number of lines at the start of
+** the main file, and of the files included by them, in Text. EndHeaderPrefix
+** is called when the main file reaches the following line.
+*/
+{
+    PrefixText  = Text;
+    PrefixLines = Lines;
+    PrefixFile  = 0;
+    PrefixLine  = 0;
+}
+
+
+
+void OpenPrecompiledFile (FILE* F)
+/* Use the preprocessed text of a precompiled header from F as input */
+{
+    /* The input file is set by the first line of the text */
+    AFile* AF = NewAFile (CollLast (&IFiles), F);
+    AF->Precompiled = 1;
+
+    /* Use this file with PP */
+    SetPPIfStack (&AF->IfStack);
+
+    /* Begin PP for this file */
+    PreprocessBegin ();
+}
+
+
+
 static LineInfoFile* NewLineInfoFile (const AFile* AF)
 {
     const char* Name = AF->PName == 0 ? AF->Input->Name : AF->PName;
@@ -786,6 +1003,58 @@ const char* GetInputFileName (const struct IFile* IF)
 
 
 
+InputType GetInputFileType (const struct IFile* IF)
+/* Return the type of the file from an IFile struct */
+{
+    return IF->Type;
+}
+
+
+
+unsigned GetInputFileCount (void)
+/* Return the number of input files including the main file */
+{
+    return CollCount (&IFiles);
+}
+
+
+
+void GetInputFileInfo (unsigned Index, InputFileInfo* Info)
+/* Get information about the input file with the given index. The main file
+** has index zero.
+*/
+{
+    const IFile* IF = CollConstAt (&IFiles, Index);
+
+    Info->Name  = IF->Name;
+    Info->Type  = IF->Type;
+    Info->Size  = IF->Size;
+    Info->MTime = IF->MTime;
+    Info->Once  = IF->Once;
+    Info->Guard = IF->Guard;
+}
+
+
+
+void AddInputFile (const InputFileInfo* Info)
+/* Add an input file that was read for a precompiled header */
+{
+    IFile* IF = NewIFile (Info->Name, Info->Type);
+
+    IF->Usage = 1;
+    IF->Size  = Info->Size;
+    IF->MTime = Info->MTime;
+    IF->Once  = Info->Once;
+    if (Info->Guard != 0) {
+        IF->Guard = xstrdup (Info->Guard);
+    }
+
+    /* Set the debug data as if the file was read */
+    g_fileinfo (IF->Name, IF->Size, IF->MTime);
+}
+
+
+
 const char* GetCurrentFileName (void)
 /* Return the name of the current input file */
 {
@@ -853,6 +1122,24 @@ unsigned GetCurrentCounter (void)
 
 
 
+unsigned PeekCurrentCounter (void)
+/* Return the counter number in the current input file without incrementing
+** it.
+*/
+{
+    return MainFileCounter;
+}
+
+
+
+void SetCurrentCounter (unsigned Counter)
+/* Set the counter number in the current input file */
+{
+    MainFileCounter = Counter;
+}
+
+
+
 static void WriteEscaped (FILE* F, const char* Name)
 /* Write a file name to a dependency file escaping spaces */
 {
@@ -65,6 +65,17 @@ typedef enum {
     IT_USRINC = 0x04,           /* User include file (using "") */
 } InputType;
 
+/* Information about an input file */
+typedef struct InputFileInfo InputFileInfo;
+struct InputFileInfo {
+    const char*     Name;       /* Name of the file */
+    InputType       Type;       /* Type of input file */
+    unsigned long   Size;       /* File size */
+    unsigned long   MTime;      /* Time of last modification */
+    int             Once;       /* File had #pragma once */
+    const char*     Guard;      /* Include guard macro or NULL */
+};
+
 /* The current input line */
 extern StrBuf* Line;
 
@@ -83,6 +94,9 @@ extern char NextC;
 void OpenMainFile (const char* Name);
 /* Open the main file. Will call Fatal() in case of failures. */
 
+void DoneInput (void);
+/* Forget all input files, so the next main file starts with empty lists */
+
 void OpenIncludeFile (const char* Name, InputType IT);
 /* Open an include file and insert it into the tables. */
 
@@ -91,6 +105,9 @@ void CloseIncludeFile (void);
 ** NULL if this was the main file.
 */
 
+void SetIncludeOnce (void);
+/* Mark the current input file, so it isn't included again (#pragma once) */
+
 void NextChar (void);
 /* Read the next character from the input stream and make CurC and NextC
 ** valid. If end of line is reached, both are set to NUL, no more lines
@@ -126,6 +143,15 @@ int PreprocessNextLine (void);
 ** main file.
 */
 
+void RecordHeaderPrefix (unsigned Lines, StrBuf* Text);
+/* Record the preprocessed text of the given number of lines at the start of
+** the main file, and of the files included by them, in Text. EndHeaderPrefix
+** is called when the main file reaches the following line.
+*/
+
+void OpenPrecompiledFile (FILE* F);
+/* Use the preprocessed text of a precompiled header from F as input */
+
 void GetFileInclusionInfo (struct LineInfo* LI);
 /* Get info about source file inclusion for LineInfo struct */
 
@@ -138,6 +164,20 @@ int HasFileInclusionChanged (const struct LineInfo* LI);
 const char* GetInputFileName (const struct IFile* IF);
 /* Return the name of the file from an IFile struct */
 
+InputType GetInputFileType (const struct IFile* IF);
+/* Return the type of the file from an IFile struct */
+
+unsigned GetInputFileCount (void);
+/* Return the number of input files including the main file */
+
+void GetInputFileInfo (unsigned Index, InputFileInfo* Info);
+/* Get information about the input file with the given index. The main file
+** has index zero.
+*/
+
+void AddInputFile (const InputFileInfo* Info);
+/* Add an input file that was read for a precompiled header */
+
 const char* GetCurrentFileName (void);
 /* Return the name of the current input file */
 
@@ -153,6 +193,14 @@ void SetCurrentFileName (const char* Name);
 unsigned GetCurrentCounter (void);
 /* Return the counter number in the current input file */
 
+unsigned PeekCurrentCounter (void);
+/* Return the counter number in the current input file without incrementing
+** it.
+*/
+
+void SetCurrentCounter (unsigned Counter);
+/* Set the counter number in the current input file */
+
 void CreateDependencies (void);
 /* Create dependency files requested by the user */
 
@@ -38,6 +38,7 @@
 /* common */
 #include "chartype.h"
 #include "check.h"
+#include "thread.h"
 #include "xmalloc.h"
 
 /* cc65 */
@@ -131,7 +132,10 @@ LineInfo* UseLineInfo (LineInfo* LI)
 /* Increase the reference count of the given line info and return it. */
 {
     CHECK (LI != 0);
-    ++LI->RefCount;
+    /* Code entries of different functions may share a line info, and the
+    ** optimizer may run for these functions in parallel.
+    */
+    AtomicInc (&LI->RefCount);
     return LI;
 }
 
@@ -142,8 +146,17 @@ void ReleaseLineInfo (LineInfo* LI)
 ** reference count drops to zero.
 */
 {
-    CHECK (LI && LI->RefCount > 0);
-    if (--LI->RefCount == 0) {
+    int Count;
+
+    CHECK (LI != 0);
+
+    /* Other threads may change the counter at any time, so use the value
+    ** returned by the decrement instead of reading it. A negative count means
+    ** the line info was released once too often.
+    */
+    Count = (int) AtomicDec (&LI->RefCount);
+    CHECK (Count >= 0);
+    if (Count == 0) {
         /* No more references, free it */
         FreeLineInfo (LI);
     }
@@ -203,6 +216,21 @@ LineInfo* GetPrevCheckedLI (void)
 
 
 
+void DoneLineInfo (void)
+/* Release the current and the latest checked line infos */
+{
+    if (CurLineInfo) {
+        ReleaseLineInfo (CurLineInfo);
+        CurLineInfo = 0;
+    }
+    if (PrevCheckedLI) {
+        ReleaseLineInfo (PrevCheckedLI);
+        PrevCheckedLI = 0;
+    }
+}
+
+
+
 const char* GetPresumedFileName (const LineInfo* LI)
 /* Return the presumed file name from a line info */
 {
@@ -110,6 +110,9 @@ void RememberCheckedLI (struct LineInfo* LI);
 LineInfo* GetPrevCheckedLI (void);
 /* Get the latest checked line info struct */
 
+void DoneLineInfo (void);
+/* Release the current and the latest checked line infos */
+
 const char* GetPresumedFileName (const LineInfo* LI);
 /* Return the presumed file name from a line info */
 
@@ -84,6 +84,25 @@ static LiteralPool*     LP         = 0;
 */
 static Collection       LPStack  = STATIC_COLLECTION_INITIALIZER;
 
+/* To find the literals that end with the data of another literal quickly,
+** the suffixes of the output literals are kept in a hash table.
+*/
+typedef struct Suffix Suffix;
+struct Suffix {
+    Suffix*             Next;           /* Next suffix in hash chain */
+    unsigned            Hash;           /* Hash value of the suffix data */
+    unsigned            Offs;           /* Offset of the suffix in the literal */
+    const Literal*      Lit;            /* Literal containing the suffix */
+};
+
+typedef struct SuffixTab SuffixTab;
+struct SuffixTab {
+    unsigned            Size;           /* Number of hash chains */
+    Suffix**            Tab;            /* The hash chains */
+    Suffix*             Free;           /* Next unused entry in Suffixes */
+    Suffix*             Suffixes;       /* Entries for all suffixes */
+};
+
 
 
 /*****************************************************************************/
@@ -210,6 +229,98 @@ unsigned GetLiteralSize (const Literal* L)
 
 
 
+/*****************************************************************************/
+/*                              struct SuffixTab                             */
+/*****************************************************************************/
+
+
+
+static unsigned HashSuffix (unsigned Hash, unsigned char C)
+/* Add the next character to the hash of a suffix. The characters of a
+** suffix are added from the last one to the first one, so the hash values
+** of all suffixes of a literal are computed in one pass.
+*/
+{
+    return Hash * 31U + C;
+}
+
+
+
+static void InitSuffixTab (SuffixTab* T, unsigned Count)
+/* Initialize a suffix table for literals with Count bytes of data */
+{
+    unsigned I;
+
+    /* Allow an average chain length of two */
+    T->Size = Count / 2 + 1;
+    T->Tab  = xmalloc (T->Size * sizeof (Suffix*));
+    for (I = 0; I < T->Size; ++I) {
+        T->Tab[I] = 0;
+    }
+    T->Suffixes = T->Free = xmalloc ((Count + 1) * sizeof (Suffix));
+}
+
+
+
+static void DoneSuffixTab (SuffixTab* T)
+/* Free the data of a suffix table */
+{
+    xfree (T->Tab);
+    xfree (T->Suffixes);
+}
+
+
+
+static void AddSuffixes (SuffixTab* T, const Literal* L)
+/* Add all suffixes of the given literal to the table */
+{
+    unsigned Hash = 0;
+    unsigned I    = SB_GetLen (&L->Data);
+
+    while (I-- > 0) {
+        Suffix* S = T->Free++;
+        Hash = HashSuffix (Hash, SB_AtUnchecked (&L->Data, I));
+        S->Hash = Hash;
+        S->Offs = I;
+        S->Lit  = L;
+        S->Next = T->Tab[Hash % T->Size];
+        T->Tab[Hash % T->Size] = S;
+    }
+}
+
+
+
+static const Suffix* FindSuffix (const SuffixTab* T, const Literal* L)
+/* Find a literal in the table that ends with the data of L. Return the
+** suffix or NULL if there is none.
+*/
+{
+    unsigned      Len  = SB_GetLen (&L->Data);
+    unsigned      Hash = 0;
+    unsigned      I    = Len;
+    const Suffix* S;
+
+    /* Compute the hash the same way as for the suffixes */
+    while (I-- > 0) {
+        Hash = HashSuffix (Hash, SB_AtUnchecked (&L->Data, I));
+    }
+
+    /* Search the hash chain */
+    for (S = T->Tab[Hash % T->Size]; S; S = S->Next) {
+        if (S->Hash == Hash                                             &&
+            SB_GetLen (&S->Lit->Data) - S->Offs == Len                  &&
+            memcmp (SB_GetConstBuf (&S->Lit->Data) + S->Offs,
+                    SB_GetConstBuf (&L->Data), Len) == 0) {
+            return S;
+        }
+    }
+
+    /* Not found */
+    return 0;
+}
+
+
+
 /*****************************************************************************/
 /*                                   Code                                    */
 /*****************************************************************************/
@@ -368,7 +479,9 @@ static void OutputWritableLiterals (Collection* Literals)
 static void OutputReadOnlyLiterals (Collection* Literals)
 /* Output the given readonly literals merging (even partial) duplicates */
 {
-    unsigned I;
+    unsigned  I;
+    unsigned  Count;
+    SuffixTab T;
 
     /* If nothing there, exit... */
     if (CollCount (Literals) == 0) {
@@ -381,11 +494,23 @@ static void OutputReadOnlyLiterals (Collection* Literals)
     /* Sort the literal pool by literal size. Larger strings go first */
     CollSort (Literals, Compare, 0);
 
+    /* Create a table for the suffixes of all literals that have a reference.
+    ** Since the literals are sorted by size, a literal can only be part of
+    ** one that was output before, so the table needs to contain only those.
+    */
+    Count = 0;
+    for (I = 0; I < CollCount (Literals); ++I) {
+        const Literal* L = CollAtUnchecked (Literals, I);
+        if (L->RefCount > 0 && !L->Output) {
+            Count += SB_GetLen (&L->Data);
+        }
+    }
+    InitSuffixTab (&T, Count);
+
     /* Emit all literals that have a reference */
     for (I = 0; I < CollCount (Literals); ++I) {
 
-        unsigned J;
-        Literal* C;
+        const Suffix* S;
 
         /* Get the next literal */
         Literal* L = CollAt (Literals, I);
@@ -395,40 +520,12 @@ static void OutputReadOnlyLiterals (Collection* Literals)
             continue;
         }
 
-        /* Check if this literal is part of another one. Since the literals
-        ** are sorted by size (larger ones first), it can only be part of a
-        ** literal with a smaller index.
-        ** Beware: Only check literals that have actually been referenced.
-        */
-        C = 0;
-        for (J = 0; J < I; ++J) {
-
-            const void* D;
-
-            /* Get a pointer to the compare literal */
-            Literal* L2 = CollAt (Literals, J);
-
-            /* Ignore literals that have no reference */
-            if (L2->RefCount == 0) {
-                continue;
-            }
-
-            /* Get a pointer to the data */
-            D = SB_GetConstBuf (&L2->Data) + SB_GetLen (&L2->Data) - SB_GetLen (&L->Data);
-
-            /* Compare the data */
-            if (memcmp (D, SB_GetConstBuf (&L->Data), SB_GetLen (&L->Data)) == 0) {
-                /* Remember the literal and terminate the loop */
-                C = L2;
-                break;
-            }
-        }
-
-        /* Check if we found a match */
-        if (C != 0) {
+        /* Check if this literal is part of another one */
+        S = FindSuffix (&T, L);
+        if (S != 0) {
 
             /* This literal is part of a longer literal, merge them */
-            g_aliasliterallabel (L->Label, C->Label, GetLiteralSize (C) - GetLiteralSize (L));
+            g_aliasliterallabel (L->Label, S->Lit->Label, S->Offs);
 
         } else {
 
@@ -438,11 +535,16 @@ static void OutputReadOnlyLiterals (Collection* Literals)
             /* Output the literal data */
             g_defbytes (SB_GetConstBuf (&L->Data), SB_GetLen (&L->Data));
 
+            /* Later literals may be part of this one */
+            AddSuffixes (&T, L);
+
         }
 
         /* Mark the literal */
         L->Output = 1;
     }
+
+    DoneSuffixTab (&T);
 }
 
 
@@ -49,6 +49,7 @@
 #include "initdata.h"
 #include "loadexpr.h"
 #include "locals.h"
+#include "overlay.h"
 #include "seqpoint.h"
 #include "stackptr.h"
 #include "standard.h"
@@ -98,6 +99,18 @@ static void AllocStorage (unsigned DataLabel, void (*UseSeg) (), unsigned Size)
 
 
 
+static void AllocStaticLocal (unsigned DataLabel, unsigned Size)
+/* Reserve Size bytes of storage for an auto variable that is made static */
+{
+    if (F_HasOverlay (CurrentFunc)) {
+        OV_AddLocal (CurrentFunc->FuncEntry, DataLabel, Size);
+    } else {
+        AllocStorage (DataLabel, g_usebss, Size);
+    }
+}
+
+
+
 static void ParseRegisterDecl (Declarator* Decl, int Reg)
 /* Parse the declarator of a register variable. Reg is the offset of the
 ** variable in the register bank.
@@ -171,7 +184,8 @@ static void ParseRegisterDecl (Declarator* Decl, int Reg)
             ExprDesc Expr;
             ED_Init (&Expr);
 
-            /* Parse the expression */
+            /* Parse the expression. Only its low byte is needed for a char. */
+            ED_RequireByteFor (&Expr, Sym->Type);
             hie1 (&Expr);
 
             /* Convert it to the target type */
@@ -231,7 +245,7 @@ static void ParseAutoDecl (Declarator* Decl)
     unsigned Size = SizeOf (Decl->Type);
 
     /* Check if this is a variable on the stack or in static memory */
-    if (IS_Get (&StaticLocals) == 0) {
+    if (IS_Get (&StaticLocals) == 0 && !F_HasOverlay (CurrentFunc)) {
 
         /* Add the symbol to the symbol table. The stack offset we use here
         ** may get corrected later.
@@ -289,7 +303,8 @@ static void ParseAutoDecl (Declarator* Decl)
                 /* Setup the type flags for the assignment */
                 Flags = (Size == SIZEOF_CHAR)? CF_FORCECHAR : CF_NONE;
 
-                /* Parse the expression */
+                /* Parse the expression. Only its low byte is needed for a char. */
+                ED_RequireByteFor (&Expr, Sym->Type);
                 hie1 (&Expr);
 
                 /* Convert it to the target type */
@@ -362,7 +377,7 @@ static void ParseAutoDecl (Declarator* Decl)
                 Size = ParseInit (Sym->Type);
 
                 /* Allocate space for the variable */
-                AllocStorage (DataLabel, g_usebss, Size);
+                AllocStaticLocal (DataLabel, Size);
 
                 /* Generate code to copy this data into the variable space */
                 g_initstatic (InitLabel, DataLabel, Size);
@@ -373,9 +388,10 @@ static void ParseAutoDecl (Declarator* Decl)
                 ED_Init (&Expr);
 
                 /* Allocate space for the variable */
-                AllocStorage (DataLabel, g_usebss, Size);
+                AllocStaticLocal (DataLabel, Size);
 
-                /* Parse the expression */
+                /* Parse the expression. Only its low byte is needed for a char. */
+                ED_RequireByteFor (&Expr, Sym->Type);
                 hie1 (&Expr);
 
                 /* Convert it to the target type */
@@ -397,7 +413,7 @@ static void ParseAutoDecl (Declarator* Decl)
         } else {
 
             /* No assignment - allocate a label and space for the variable */
-            AllocStorage (DataLabel, g_usebss, Size);
+            AllocStaticLocal (DataLabel, Size);
 
         }
     }
@@ -520,10 +536,23 @@ static int ParseOneDecl (DeclSpec* Spec)
         ** convert the declaration to "auto" if this is not possible.
         */
         int Reg = 0;    /* Initialize to avoid gcc complains */
+        /* A loop counter that never leaves the byte range needs one byte */
+        if (((Decl.StorageClass & SC_STORAGEMASK) == SC_AUTO ||
+             (Decl.StorageClass & SC_STORAGEMASK) == SC_REGISTER) &&
+            F_IsByteLoopVar (CurrentFunc, Decl.Ident, Decl.Type)) {
+            TypeCopy (Decl.Type, type_uchar);
+        }
+
         if ((Decl.StorageClass & SC_STORAGEMASK) == SC_REGISTER &&
             (Reg = F_AllocRegVar (CurrentFunc, Decl.Type)) < 0) {
             /* No space for this register variable, convert to auto */
             Decl.StorageClass = (Decl.StorageClass & ~SC_STORAGEMASK) | SC_AUTO;
+        } else if ((Decl.StorageClass & SC_STORAGEMASK) == SC_AUTO &&
+                   IS_Get (&StaticLocals) == 0                     &&
+                   !F_HasOverlay (CurrentFunc)                     &&
+                   (Reg = F_AllocAutoRegVar (CurrentFunc, Decl.Ident, Decl.Type, 0)) >= 0) {
+            /* Frequently used variable, place it into the register bank */
+            Decl.StorageClass = (Decl.StorageClass & ~SC_STORAGEMASK) | SC_REGISTER;
         }
 
         /* Check the variable type */
@@ -0,0 +1,639 @@
+/*****************************************************************************/
+/*                                                                           */
+/*                                loopvars.c                                 */
+/*                                                                           */
+/*                    Narrowing of small loop counters                       */
+/*                                                                           */
+/*                                                                           */
+/*                                                                           */
+/* Copyright 2026 The cc65 Authors                                           */
+/*                                                                           */
+/*                                                                           */
+/* This software is provided 'as-is', without any expressed or implied       */
+/* warranty.  In no event will the authors be held liable for any damages    */
+/* arising from the use of this software.                                    */
+/*                                                                           */
+/* Permission is granted to anyone to use this software for any purpose,     */
+/* including commercial applications, and to alter it and redistribute it    */
+/* freely, subject to the following restrictions:                            */
+/*                                                                           */
+/* 1. The origin of this software must not be misrepresented; you must not   */
+/*    claim that you wrote the original software. If you use this software   */
+/*    in a product, an acknowledgment in the product documentation would be  */
+/*    appreciated but is not required.                                       */
+/* 2. Altered source versions must be plainly marked as such, and must not   */
+/*    be misrepresented as being the original software.                      */
+/* 3. This notice may not be removed or altered from any source              */
+/*    distribution.                                                          */
+/*                                                                           */
+/*****************************************************************************/
+
+
+
+#include <string.h>
+
+/* common */
+#include "coll.h"
+#include "hashfunc.h"
+#include "xmalloc.h"
+
+/* cc65 */
+#include "scanner.h"
+#include "loopvars.h"
+
+
+
+/*****************************************************************************/
+/*                                   Data                                    */
+/*****************************************************************************/
+
+
+
+/* Size of the hash table for the identifiers */
+#define LV_HASH_SIZE    64U
+
+/* Flags for an identifier */
+#define LVF_BAD         0x01U           /* Value may leave the byte range */
+
+/* Flags for a token */
+#define LTF_CHANGE      0x01U           /* Changes the identifier */
+#define LTF_SMALL       0x02U           /* Change keeps the value small */
+
+/* An identifier */
+typedef struct LVEntry LVEntry;
+struct LVEntry {
+    LVEntry*        Next;               /* Next entry in hash chain */
+    unsigned        Flags;              /* LVF_xxx */
+    char            Name[1];            /* Identifier, dynamically allocated */
+};
+
+/* A token of the function body */
+typedef struct LVToken LVToken;
+struct LVToken {
+    token_t         Tok;                /* The token */
+    long            IVal;               /* Value of an integer constant */
+    LVEntry*        E;                  /* Entry of an identifier */
+    unsigned        Flags;              /* LTF_xxx */
+};
+
+struct LoopVars {
+    LVEntry*        Tab[LV_HASH_SIZE];  /* Hash table for identifiers */
+    Collection      Entries;            /* All identifiers */
+    LVToken*        Toks;               /* Tokens of the body */
+    unsigned        Count;              /* Number of tokens */
+    unsigned        Size;               /* Allocated number of tokens */
+    unsigned        Brace;              /* Curly brace nesting while reading */
+    int             Disabled;           /* Function must not be handled */
+};
+
+
+
+/*****************************************************************************/
+/*                              struct LoopVars                              */
+/*****************************************************************************/
+
+
+
+static LVEntry* FindEntry (const LoopVars* L, const char* Name)
+/* Find the entry for an identifier. Return NULL if there is none. */
+{
+    LVEntry* E = L->Tab[HashStr (Name) % LV_HASH_SIZE];
+    while (E && strcmp (E->Name, Name) != 0) {
+        E = E->Next;
+    }
+    return E;
+}
+
+
+
+static LVEntry* GetEntry (LoopVars* L, const char* Name)
+/* Find the entry for an identifier and create it if there is none */
+{
+    LVEntry* E = FindEntry (L, Name);
+    if (E == 0) {
+        unsigned Hash = HashStr (Name) % LV_HASH_SIZE;
+        unsigned Len  = strlen (Name);
+        E = xmalloc (sizeof (LVEntry) + Len);
+        E->Flags = 0;
+        memcpy (E->Name, Name, Len + 1);
+        E->Next = L->Tab[Hash];
+        L->Tab[Hash] = E;
+        CollAppend (&L->Entries, E);
+    }
+    return E;
+}
+
+
+
+static token_t Tok (const LoopVars* L, unsigned I)
+/* Return the token with the given index, or TOK_CEOF if there is none */
+{
+    return (I < L->Count)? L->Toks[I].Tok : TOK_CEOF;
+}
+
+
+
+/*****************************************************************************/
+/*                                 Scanning                                  */
+/*****************************************************************************/
+
+
+
+static int ReadToken (const Token* T, void* Data)
+/* Remember the tokens of the function body */
+{
+    LoopVars* L = Data;
+    LVToken*  LT;
+
+    /* Inline assembler may change the variables, and a goto may jump into
+    ** the body of a loop.
+    */
+    if (T->Tok == TOK_ASM || T->Tok == TOK_GOTO) {
+        L->Disabled = 1;
+        return 0;
+    }
+
+    if (L->Count == L->Size) {
+        L->Size = (L->Size == 0)? 256 : L->Size * 2;
+        L->Toks = xrealloc (L->Toks, L->Size * sizeof (LVToken));
+    }
+    LT = &L->Toks[L->Count++];
+    LT->Tok   = T->Tok;
+    LT->IVal  = T->IVal;
+    LT->E     = (T->Tok == TOK_IDENT)? GetEntry (L, T->Ident) : 0;
+    LT->Flags = 0;
+
+    if (T->Tok == TOK_LCURLY) {
+        ++L->Brace;
+    } else if (T->Tok == TOK_RCURLY && --L->Brace == 0) {
+        /* End of the function body */
+        return 0;
+    }
+    return 1;
+}
+
+
+
+static unsigned SkipParens (const LoopVars* L, unsigned I)
+/* If the token with the given index is an opening paren, return the index
+** following the matching closing paren. Otherwise return I.
+*/
+{
+    unsigned Depth = 0;
+    if (Tok (L, I) != TOK_LPAREN) {
+        return I;
+    }
+    while (I < L->Count) {
+        token_t T = L->Toks[I++].Tok;
+        if (T == TOK_LPAREN) {
+            ++Depth;
+        } else if (T == TOK_RPAREN && --Depth == 0) {
+            break;
+        }
+    }
+    return I;
+}
+
+
+
+static unsigned StmtEnd (const LoopVars* L, unsigned I)
+/* Return the index following the statement that starts at index I */
+{
+    unsigned Depth = 0;
+
+    switch (Tok (L, I)) {
+
+        case TOK_IF:
+            I = StmtEnd (L, SkipParens (L, I + 1));
+            if (Tok (L, I) == TOK_ELSE) {
+                I = StmtEnd (L, I + 1);
+            }
+            return I;
+
+        case TOK_FOR:
+        case TOK_WHILE:
+        case TOK_SWITCH:
+            return StmtEnd (L, SkipParens (L, I + 1));
+
+        case TOK_DO:
+            I = StmtEnd (L, I + 1);
+            if (Tok (L, I) == TOK_WHILE) {
+                I = SkipParens (L, I + 1);
+            }
+            if (Tok (L, I) == TOK_SEMI) {
+                ++I;
+            }
+            return I;
+
+        case TOK_LCURLY:
+            /* Compound statement */
+            while (I < L->Count) {
+                token_t T = L->Toks[I++].Tok;
+                if (T == TOK_LCURLY) {
+                    ++Depth;
+                } else if (T == TOK_RCURLY && --Depth == 0) {
+                    break;
+                }
+            }
+            return I;
+
+        default:
+            /* Statement that ends with a semicolon */
+            while (I < L->Count) {
+                switch (L->Toks[I].Tok) {
+                    case TOK_LPAREN:
+                    case TOK_LBRACK:
+                    case TOK_LCURLY:
+                        ++Depth;
+                        break;
+                    case TOK_RPAREN:
+                    case TOK_RBRACK:
+                    case TOK_RCURLY:
+                        if (Depth == 0) {
+                            /* End of the enclosing block */
+                            return I;
+                        }
+                        --Depth;
+                        break;
+                    case TOK_SEMI:
+                        if (Depth == 0) {
+                            return I + 1;
+                        }
+                        break;
+                    default:
+                        break;
+                }
+                ++I;
+            }
+            return I;
+    }
+}
+
+
+
+static int IsOperandEnd (token_t T)
+/* Return true if the token may end an operand of a binary operator */
+{
+    return T == TOK_IDENT  || T == TOK_ICONST || T == TOK_CCONST  ||
+           T == TOK_FCONST || T == TOK_SCONST || T == TOK_WCCONST ||
+           T == TOK_WCSCONST || T == TOK_RPAREN || T == TOK_RBRACK ||
+           T == TOK_INC    || T == TOK_DEC;
+}
+
+
+
+static int IsAssignOp (token_t T)
+/* Return true if the token is an assignment operator */
+{
+    return T >= TOK_ASSIGN && T <= TOK_OR_ASSIGN;
+}
+
+
+
+static void CheckUse (LoopVars* L, unsigned I)
+/* Check the use of the identifier with index I. Mark it as bad if its
+** address or size is taken, and note if it is changed.
+*/
+{
+    LVToken* T = &L->Toks[I];
+    unsigned P, N;
+    unsigned Open, Close;
+    token_t  Prev, Next;
+
+    /* Skip the parentheses around the identifier */
+    P = I;
+    while (P > 0 && L->Toks[P - 1].Tok == TOK_LPAREN) {
+        --P;
+    }
+    Prev = (P > 0)? L->Toks[P - 1].Tok : TOK_INVALID;
+    N = I + 1;
+    while (Tok (L, N) == TOK_RPAREN) {
+        ++N;
+    }
+    Next = Tok (L, N);
+
+    if (Prev == TOK_SIZEOF ||
+        (Prev == TOK_AND && (P < 2 || !IsOperandEnd (L->Toks[P - 2].Tok)))) {
+        T->E->Flags |= LVF_BAD;
+        return;
+    }
+
+    /* The parentheses of a call or a statement don't belong to the operand */
+    Open  = I - P;
+    Close = N - (I + 1);
+    if (Open > 0 && (Prev == TOK_IDENT || Prev == TOK_IF  || Prev == TOK_FOR ||
+                     Prev == TOK_WHILE || Prev == TOK_SWITCH)) {
+        --Open;
+    }
+
+    /* An operator following the closing parens applies to the identifier if
+    ** they don't close more than the parens around it.
+    */
+    if (Prev == TOK_INC || Prev == TOK_DEC ||
+        ((Next == TOK_INC || Next == TOK_DEC || IsAssignOp (Next)) &&
+         Close <= Open)) {
+        T->Flags |= LTF_CHANGE;
+
+        /* Assignment of a small constant */
+        if (Open == 0 && Close == 0 && Next == TOK_ASSIGN &&
+            Prev != TOK_INC && Prev != TOK_DEC &&
+            Tok (L, N + 1) == TOK_ICONST &&
+            L->Toks[N + 1].IVal >= 0 && L->Toks[N + 1].IVal <= 0xFF &&
+            (Tok (L, N + 2) == TOK_SEMI || Tok (L, N + 2) == TOK_COMMA ||
+             Tok (L, N + 2) == TOK_RPAREN)) {
+            T->Flags |= LTF_SMALL;
+        }
+    }
+}
+
+
+
+static int ConstExpr (const LoopVars* L, unsigned* I, unsigned End, long* Val);
+/* Forward */
+
+
+
+static int ConstPrimary (const LoopVars* L, unsigned* I, unsigned End,
+                         long* Val)
+/* Evaluate a constant or a constant expression in parens */
+{
+    if (*I < End && Tok (L, *I) == TOK_ICONST) {
+        *Val = L->Toks[(*I)++].IVal;
+        return 1;
+    }
+    if (*I < End && Tok (L, *I) == TOK_LPAREN) {
+        ++*I;
+        if (ConstExpr (L, I, End, Val)  &&
+            *I < End                    &&
+            Tok (L, *I) == TOK_RPAREN) {
+            ++*I;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+
+
+static int ConstTerm (const LoopVars* L, unsigned* I, unsigned End, long* Val)
+/* Evaluate a product of constants */
+{
+    long R;
+
+    if (!ConstPrimary (L, I, End, Val)) {
+        return 0;
+    }
+    while (*I < End && (Tok (L, *I) == TOK_STAR ||
+                        Tok (L, *I) == TOK_DIV  ||
+                        Tok (L, *I) == TOK_MOD)) {
+        token_t T = Tok (L, (*I)++);
+        if (!ConstPrimary (L, I, End, &R)) {
+            return 0;
+        }
+        if (T == TOK_STAR) {
+            *Val *= R;
+        } else if (R == 0) {
+            return 0;
+        } else if (T == TOK_DIV) {
+            *Val /= R;
+        } else {
+            *Val %= R;
+        }
+        if (*Val < -0x8000L || *Val > 0xFFFFL) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+
+
+static int ConstExpr (const LoopVars* L, unsigned* I, unsigned End, long* Val)
+/* Evaluate a simple integer constant expression as it is used for array
+** sizes. Return false if the tokens are something else.
+*/
+{
+    long R;
+
+    if (!ConstTerm (L, I, End, Val)) {
+        return 0;
+    }
+    while (*I < End && (Tok (L, *I) == TOK_PLUS || Tok (L, *I) == TOK_MINUS)) {
+        token_t T = Tok (L, (*I)++);
+        if (!ConstTerm (L, I, End, &R)) {
+            return 0;
+        }
+        *Val = (T == TOK_PLUS)? *Val + R : *Val - R;
+        if (*Val < -0x8000L || *Val > 0xFFFFL) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+
+
+static void CheckFor (LoopVars* L, unsigned I)
+/* Check the for statement with index I. If it increments or decrements a
+** variable that the condition keeps small, mark the change as small.
+*/
+{
+    unsigned S1, S2, R, B, End, J;
+    unsigned Depth = 0;
+    unsigned Step;
+    int      Up;
+    long     N;
+    const LVToken* C;
+
+    /* Find the semicolons and the closing paren of the header */
+    S1 = S2 = 0;
+    for (R = I + 1; R < L->Count; ++R) {
+        token_t T = L->Toks[R].Tok;
+        if (T == TOK_LPAREN) {
+            ++Depth;
+        } else if (T == TOK_RPAREN) {
+            if (--Depth == 0) {
+                break;
+            }
+        } else if (T == TOK_SEMI && Depth == 1) {
+            if (S1 == 0) {
+                S1 = R;
+            } else {
+                S2 = R;
+            }
+        }
+    }
+    if (S2 == 0 || R >= L->Count) {
+        return;
+    }
+
+    /* The third expression must change a variable by one */
+    if (R - S2 == 3                                                     &&
+        (Tok (L, S2 + 1) == TOK_INC || Tok (L, S2 + 1) == TOK_DEC)      &&
+        Tok (L, S2 + 2) == TOK_IDENT) {
+        Step = S2 + 2;
+        Up   = (Tok (L, S2 + 1) == TOK_INC);
+    } else if (R - S2 == 3 && Tok (L, S2 + 1) == TOK_IDENT &&
+               (Tok (L, S2 + 2) == TOK_INC || Tok (L, S2 + 2) == TOK_DEC)) {
+        Step = S2 + 1;
+        Up   = (Tok (L, S2 + 2) == TOK_INC);
+    } else if (R - S2 == 4 && Tok (L, S2 + 1) == TOK_IDENT &&
+               (Tok (L, S2 + 2) == TOK_PLUS_ASSIGN ||
+                Tok (L, S2 + 2) == TOK_MINUS_ASSIGN) &&
+               Tok (L, S2 + 3) == TOK_ICONST && L->Toks[S2 + 3].IVal == 1) {
+        Step = S2 + 1;
+        Up   = (Tok (L, S2 + 2) == TOK_PLUS_ASSIGN);
+    } else {
+        return;
+    }
+
+    /* The condition must compare the variable with a constant, so that the
+    ** step keeps the value in the range 0..255.
+    */
+    C = L->Toks + S1 + 1;
+    J = S1 + 3;
+    if (C[0].Tok != TOK_IDENT || C[0].E != L->Toks[Step].E ||
+        !ConstExpr (L, &J, S2, &N) || J != S2) {
+        return;
+    }
+    if (Up) {
+        if (!((C[1].Tok == TOK_LT && N <= 0xFF) ||
+              (C[1].Tok == TOK_LE && N <= 0xFE))) {
+            return;
+        }
+    } else {
+        if (!((C[1].Tok == TOK_GT && N >= 0) ||
+              (C[1].Tok == TOK_GE && N >= 1))) {
+            return;
+        }
+    }
+
+    /* The body must not change the variable */
+    B   = R + 1;
+    End = StmtEnd (L, B);
+    for (J = B; J < End; ++J) {
+        if (L->Toks[J].E == C[0].E && (L->Toks[J].Flags & LTF_CHANGE) != 0) {
+            return;
+        }
+    }
+
+    /* The body must not be entered by a case label of a switch outside */
+    J = B;
+    while (J < End) {
+        if (L->Toks[J].Tok == TOK_SWITCH) {
+            J = StmtEnd (L, J);
+        } else if (L->Toks[J].Tok == TOK_CASE    ||
+                   L->Toks[J].Tok == TOK_DEFAULT) {
+            return;
+        } else {
+            ++J;
+        }
+    }
+
+    L->Toks[Step].Flags |= LTF_SMALL;
+}
+
+
+
+/*****************************************************************************/
+/*                                   Code                                    */
+/*****************************************************************************/
+
+
+
+LoopVars* NewLoopVars (void)
+/* Scan the body of the current function ahead and determine the variables
+** that fit into a byte. CurTok must be the opening curly brace of the body.
+** Return NULL if no variable of the function may be narrowed.
+*/
+{
+    LoopVars* L;
+    unsigned  I;
+
+    if (CurTok.Tok != TOK_LCURLY) {
+        return 0;
+    }
+
+    /* Create the data */
+    L = xmalloc (sizeof (LoopVars));
+    memset (L->Tab, 0, sizeof (L->Tab));
+    InitCollection (&L->Entries);
+    L->Toks     = 0;
+    L->Count    = 0;
+    L->Size     = 0;
+    L->Brace    = 1;
+    L->Disabled = 0;
+
+    /* Read the tokens up to the end of the body */
+    LookAhead (ReadToken, L);
+    if (L->Disabled) {
+        FreeLoopVars (L);
+        return 0;
+    }
+
+    /* Find the uses that change the identifiers */
+    for (I = 0; I < L->Count; ++I) {
+        if (L->Toks[I].E && (I == 0 || (L->Toks[I - 1].Tok != TOK_DOT &&
+                                        L->Toks[I - 1].Tok != TOK_PTR_REF))) {
+            CheckUse (L, I);
+        }
+    }
+
+    /* Find the loops that keep their counters small */
+    for (I = 0; I < L->Count; ++I) {
+        if (L->Toks[I].Tok == TOK_FOR) {
+            CheckFor (L, I);
+        }
+    }
+
+    /* Every other change may leave the range */
+    for (I = 0; I < L->Count; ++I) {
+        if ((L->Toks[I].Flags & (LTF_CHANGE | LTF_SMALL)) == LTF_CHANGE) {
+            L->Toks[I].E->Flags |= LVF_BAD;
+        }
+    }
+
+    /* The tokens are no longer needed */
+    xfree (L->Toks);
+    L->Toks  = 0;
+    L->Count = 0;
+
+    return L;
+}
+
+
+
+void FreeLoopVars (LoopVars* L)
+/* Free the data of a function */
+{
+    if (L) {
+        unsigned I;
+        for (I = 0; I < CollCount (&L->Entries); ++I) {
+            xfree (CollAtUnchecked (&L->Entries, I));
+        }
+        DoneCollection (&L->Entries);
+        xfree (L->Toks);
+        xfree (L);
+    }
+}
+
+
+
+int LV_IsByteVar (const LoopVars* L, const char* Name, const Type* T)
+/* Return true if the local variable with the given name and type may be
+** declared as unsigned char.
+*/
+{
+    const LVEntry* E;
+
+    /* Only signed ints without qualifiers are handled. Since an unsigned
+    ** char is promoted to int, all expressions using them keep their type.
+    */
+    if (L == 0 || (T[0].C != T_INT && T[0].C != T_SHORT)) {
+        return 0;
+    }
+
+    /* Unused variables are not in the table */
+    E = FindEntry (L, Name);
+    return E != 0 && (E->Flags & LVF_BAD) == 0;
+}
@@ -0,0 +1,100 @@
+/*****************************************************************************/
+/*                                                                           */
+/*                                loopvars.h                                 */
+/*                                                                           */
+/*                    Narrowing of small loop counters                       */
+/*                                                                           */
+/*                                                                           */
+/*                                                                           */
+/* Copyright 2026 The cc65 Authors                                           */
+/*                                                                           */
+/*                                                                           */
+/* This software is provided 'as-is', without any expressed or implied       */
+/* warranty.  In no event will the authors be held liable for any damages    */
+/* arising from the use of this software.                                    */
+/*                                                                           */
+/* Permission is granted to anyone to use this software for any purpose,     */
+/* including commercial applications, and to alter it and redistribute it    */
+/* freely, subject to the following restrictions:                            */
+/*                                                                           */
+/* 1. The origin of this software must not be misrepresented; you must not   */
+/*    claim that you wrote the original software. If you use this software   */
+/*    in a product, an acknowledgment in the product documentation would be  */
+/*    appreciated but is not required.                                       */
+/* 2. Altered source versions must be plainly marked as such, and must not   */
+/*    be misrepresented as being the original software.                      */
+/* 3. This notice may not be removed or altered from any source              */
+/*    distribution.                                                          */
+/*                                                                           */
+/*****************************************************************************/
+
+
+
+/* With --narrow-loop-vars, local int variables that provably never leave
+** the range 0..255 are declared as unsigned char instead. Since an unsigned
+** char is promoted to int, the value of every expression using the variable
+** stays the same, but the loads, compares and increments need only one byte,
+** and the variable may be used as an index in the Y register.
+**
+** The tokens of the function body are scanned ahead before the variables
+** are declared. A variable qualifies if its address and its size are never
+** taken, and if every change of its value is one of these:
+**
+**  - an assignment of a constant in the range 0..255;
+**  - an increment as the third expression of a for loop whose condition is
+**    "i < N" or "i <= N" with a small enough constant N;
+**  - a decrement as the third expression of a for loop whose condition is
+**    "i > N" or "i >= N" with a large enough constant N;
+**
+** where the loop body doesn't change the variable and cannot be entered by
+** a case label. Since identifiers are not resolved while scanning, all
+** variables with the same name in the function must qualify.
+*/
+
+
+
+#ifndef LOOPVARS_H
+#define LOOPVARS_H
+
+
+
+/* cc65 */
+#include "datatype.h"
+
+
+
+/*****************************************************************************/
+/*                                   Data                                    */
+/*****************************************************************************/
+
+
+
+typedef struct LoopVars LoopVars;
+
+
+
+/*****************************************************************************/
+/*                                   Code                                    */
+/*****************************************************************************/
+
+
+
+LoopVars* NewLoopVars (void);
+/* Scan the body of the current function ahead and determine the variables
+** that fit into a byte. CurTok must be the opening curly brace of the body.
+** Return NULL if no variable of the function may be narrowed.
+*/
+
+void FreeLoopVars (LoopVars* L);
+/* Free the data of a function */
+
+int LV_IsByteVar (const LoopVars* L, const char* Name, const Type* T);
+/* Return true if the local variable with the given name and type may be
+** declared as unsigned char.
+*/
+
+
+
+/* End of loopvars.h */
+
+#endif
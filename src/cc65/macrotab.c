@@ -37,6 +37,7 @@
 #include <string.h>
 
 /* common */
+#include "attrib.h"
 #include "hashfunc.h"
 #include "xmalloc.h"
 
@@ -53,13 +54,22 @@
 
 
 
-/* The macro hash table */
-#define MACRO_TAB_SIZE  211
-static Macro* MacroTab[MACRO_TAB_SIZE];
+/* The macro hash table. It starts with MACRO_TAB_SIZE slots and grows
+** whenever the average length of the hash chains would exceed
+** MACRO_TAB_LOAD.
+*/
+#define MACRO_TAB_SIZE  211U
+#define MACRO_TAB_LOAD  2U
+static Macro**  MacroTab;
+static unsigned MacroTabSize;
+static unsigned MacroCount;
 
 /* The undefined macros list head */
 static Macro* UndefinedMacrosListHead;
 
+/* Copies of the macros saved by SaveMacros */
+static Collection SavedMacros = STATIC_COLLECTION_INITIALIZER;
+
 
 
 /*****************************************************************************/
@@ -81,6 +91,7 @@ Macro* NewMacro (const char* Name)
 
     /* Initialize the data */
     M->Next         = 0;
+    M->Hash         = HashStr (Name);
     M->ParamCount   = -1;        /* Flag: Not a function-like macro */
     InitCollection (&M->Params);
     SB_Init (&M->Replacement);
@@ -162,15 +173,52 @@ void DefineTextMacro (const char* Name, const char* Val)
 
 
 
+static void ResizeMacroTab (unsigned Size)
+/* Resize the macro table to the given number of slots. The macros are moved
+** into the new table using their stored hash values.
+*/
+{
+    unsigned I;
+    Macro**  NewTab = xmalloc (Size * sizeof (Macro*));
+
+    for (I = 0; I < Size; ++I) {
+        NewTab[I] = 0;
+    }
+    for (I = 0; I < MacroTabSize; ++I) {
+        Macro* M = MacroTab[I];
+        while (M) {
+            Macro*   Next = M->Next;
+            unsigned Slot = M->Hash % Size;
+            M->Next = NewTab[Slot];
+            NewTab[Slot] = M;
+            M = Next;
+        }
+    }
+    xfree (MacroTab);
+
+    MacroTab     = NewTab;
+    MacroTabSize = Size;
+}
+
+
+
 void InsertMacro (Macro* M)
 /* Insert the given macro into the macro table. */
 {
-    /* Get the hash value of the macro name */
-    unsigned Hash = HashStr (M->Name) % MACRO_TAB_SIZE;
+    unsigned Slot;
+
+    /* Create the table or make it larger if the chains get too long */
+    if (MacroTabSize == 0) {
+        ResizeMacroTab (MACRO_TAB_SIZE);
+    } else if (MacroCount >= MacroTabSize * MACRO_TAB_LOAD) {
+        ResizeMacroTab (MacroTabSize * 2 + 1);
+    }
 
     /* Insert the macro */
-    M->Next = MacroTab[Hash];
-    MacroTab[Hash] = M;
+    Slot = M->Hash % MacroTabSize;
+    M->Next = MacroTab[Slot];
+    MacroTab[Slot] = M;
+    ++MacroCount;
 }
 
 
@@ -182,22 +230,31 @@ Macro* UndefineMacro (const char* Name)
 ** To safely free the removed macro, use FreeUndefinedMacros().
 */
 {
+    Macro* L;
+    Macro* M;
+
     /* Get the hash value of the macro name */
-    unsigned Hash = HashStr (Name) % MACRO_TAB_SIZE;
+    unsigned Hash = HashStr (Name);
+
+    /* Nothing to do if the table is empty */
+    if (MacroTabSize == 0) {
+        return 0;
+    }
 
     /* Search the hash chain */
-    Macro* L = 0;
-    Macro* M = MacroTab[Hash];
+    L = 0;
+    M = MacroTab[Hash % MacroTabSize];
     while (M) {
-        if (strcmp (M->Name, Name) == 0) {
+        if (M->Hash == Hash && strcmp (M->Name, Name) == 0) {
 
             /* Found it */
             if (L == 0) {
                 /* First in chain */
-                MacroTab[Hash] = M->Next;
+                MacroTab[Hash % MacroTabSize] = M->Next;
             } else {
                 L->Next = M->Next;
             }
+            --MacroCount;
 
             /* Add this macro to pending deletion list */
             M->Next = UndefinedMacrosListHead;
@@ -238,13 +295,20 @@ void FreeUndefinedMacros (void)
 Macro* FindMacro (const char* Name)
 /* Find a macro with the given name. Return the macro definition or NULL */
 {
+    Macro* M;
+
     /* Get the hash value of the macro name */
-    unsigned Hash = HashStr (Name) % MACRO_TAB_SIZE;
+    unsigned Hash = HashStr (Name);
+
+    /* Nothing to do if the table is empty */
+    if (MacroTabSize == 0) {
+        return 0;
+    }
 
     /* Search the hash chain */
-    Macro* M = MacroTab[Hash];
+    M = MacroTab[Hash % MacroTabSize];
     while (M) {
-        if (strcmp (M->Name, Name) == 0) {
+        if (M->Hash == Hash && strcmp (M->Name, Name) == 0) {
             /* Check for some special macro names */
             if (Name[0] == '_') {
                 HandleSpecialMacro (M, Name);
@@ -329,14 +393,84 @@ int MacroCmp (const Macro* M1, const Macro* M2)
 
 
 
+static int CmpMacroName (void* Data attribute ((unused)),
+                         const void* Left, const void* Right)
+/* Compare function for CollSort, sorts macros by name */
+{
+    return strcmp (((const Macro*) Left)->Name, ((const Macro*) Right)->Name);
+}
+
+
+
+void CollectMacros (Collection* C)
+/* Add all defined macros to C and sort it by macro name */
+{
+    unsigned I;
+    Macro* M;
+
+    for (I = 0; I < MacroTabSize; ++I) {
+        for (M = MacroTab[I]; M != 0; M = M->Next) {
+            CollAppend (C, M);
+        }
+    }
+    CollSort (C, CmpMacroName, 0);
+}
+
+
+
+void SaveMacros (void)
+/* Remember copies of all defined macros, so they can be restored by
+** RestoreMacros.
+*/
+{
+    unsigned I;
+    Macro* M;
+
+    for (I = 0; I < CollCount (&SavedMacros); ++I) {
+        FreeMacro (CollAtUnchecked (&SavedMacros, I));
+    }
+    CollDeleteAll (&SavedMacros);
+
+    for (I = 0; I < MacroTabSize; ++I) {
+        for (M = MacroTab[I]; M != 0; M = M->Next) {
+            CollAppend (&SavedMacros, CloneMacro (M));
+        }
+    }
+}
+
+
+
+void RestoreMacros (void)
+/* Delete all macros and define copies of the ones saved by SaveMacros */
+{
+    unsigned I;
+
+    for (I = 0; I < MacroTabSize; ++I) {
+        while (MacroTab[I]) {
+            Macro* M = MacroTab[I];
+            MacroTab[I] = M->Next;
+            FreeMacro (M);
+        }
+    }
+    MacroCount = 0;
+    FreeUndefinedMacros ();
+
+    for (I = 0; I < CollCount (&SavedMacros); ++I) {
+        InsertMacro (CloneMacro (CollAtUnchecked (&SavedMacros, I)));
+    }
+}
+
+
+
 void PrintMacroStats (FILE* F)
 /* Print macro statistics to the given text file. */
 {
     unsigned I;
     Macro* M;
 
-    fprintf (F, "\n\nMacro Hash Table Summary\n");
-    for (I = 0; I < MACRO_TAB_SIZE; ++I) {
+    fprintf (F, "\n\nMacro Hash Table Summary (%u macros, %u slots)\n",
+             MacroCount, MacroTabSize);
+    for (I = 0; I < MacroTabSize; ++I) {
         fprintf (F, "%3u : ", I);
         M = MacroTab [I];
         if (M) {
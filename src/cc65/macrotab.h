@@ -54,7 +54,8 @@
 /* Structure describing a macro */
 typedef struct Macro Macro;
 struct Macro {
-    Macro*        Next;         /* Next macro with same hash value */
+    Macro*        Next;         /* Next macro in hash chain */
+    unsigned      Hash;         /* Full hash value of the name */
     int           ParamCount;   /* Number of parameters, -1 = no parens */
     Collection    Params;       /* Parameter list (char*) */
     StrBuf        Replacement;  /* Replacement text */
@@ -129,6 +130,17 @@ void AddMacroParam (Macro* M, const char* Param);
 int MacroCmp (const Macro* M1, const Macro* M2);
 /* Compare two macros and return zero if both are identical. */
 
+void CollectMacros (Collection* C);
+/* Add all defined macros to C and sort it by macro name */
+
+void SaveMacros (void);
+/* Remember copies of all defined macros, so they can be restored by
+** RestoreMacros.
+*/
+
+void RestoreMacros (void);
+/* Delete all macros and define copies of the ones saved by SaveMacros */
+
 void PrintMacroStats (FILE* F);
 /* Print macro statistics to the given text file. */
 
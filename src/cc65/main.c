@@ -42,6 +42,7 @@
 #include "abend.h"
 #include "chartype.h"
 #include "cmdline.h"
+#include "coll.h"
 #include "cpu.h"
 #include "debugflag.h"
 #include "fname.h"
@@ -51,6 +52,7 @@
 #include "strbuf.h"
 #include "target.h"
 #include "tgttrans.h"
+#include "thread.h"
 #include "version.h"
 #include "xmalloc.h"
 
@@ -58,12 +60,14 @@
 #include "asmcode.h"
 #include "compile.h"
 #include "codeopt.h"
+#include "codepool.h"
 #include "error.h"
 #include "global.h"
 #include "incpath.h"
 #include "input.h"
 #include "macrotab.h"
 #include "output.h"
+#include "profile.h"
 #include "scanner.h"
 #include "segments.h"
 #include "standard.h"
@@ -79,7 +83,7 @@
 static void Usage (void)
 /* Print usage information to stderr */
 {
-    printf ("Usage: %s [options] file\n"
+    printf ("Usage: %s [options] file ...\n"
             "Short options:\n"
             "  -Cl\t\t\t\tMake local variables static\n"
             "  -Dsym[=defn]\t\t\tDefine a symbol\n"
@@ -105,6 +109,8 @@ static void Usage (void)
             "Long options:\n"
             "  --add-source\t\t\tInclude source as comment\n"
             "  --all-cdecl\t\t\tMake functions default to __cdecl__\n"
+            "  --auto-register-vars\t\tPlace frequently used locals into registers\n"
+            "  --auto-static-locals\t\tMake locals static if functions aren't reentrant\n"
             "  --bss-name seg\t\tSet the name of the BSS segment\n"
             "  --check-stack\t\t\tGenerate stack overflow checks\n"
             "  --code-name seg\t\tSet the name of the CODE segment\n"
@@ -112,6 +118,7 @@ static void Usage (void)
             "  --cpu type\t\t\tSet cpu type (6502, 65c02)\n"
             "  --create-dep name\t\tCreate a make dependency file\n"
             "  --create-full-dep name\tCreate a full make dependency file\n"
+            "  --cycle-weight n\t\tWeight cycles against size by n percent\n"
             "  --data-name seg\t\tSet the name of the DATA segment\n"
             "  --debug\t\t\tDebug mode\n"
             "  --debug-tables name\t\tWrite symbol table debug info to a file\n"
@@ -124,11 +131,16 @@ static void Usage (void)
             "  --enable-opt name\t\tEnable an optimization step\n"
             "  --help\t\t\tHelp (this text)\n"
             "  --include-dir dir\t\tSet an include directory search path\n"
+            "  --inline-funcs\t\tInline small static and inline functions\n"
             "  --inline-stdfuncs\t\tInline some standard functions\n"
+            "  --keep-unused\t\t\tOutput unused static functions and data\n"
             "  --list-opt-steps\t\tList all optimizer steps and exit\n"
             "  --list-warnings\t\tList available warning types for -W\n"
             "  --local-strings\t\tEmit string literals immediately\n"
             "  --memory-model model\t\tSet the memory model\n"
+            "  --narrow-loop-vars\t\tUse bytes for small int loop counters\n"
+            "  --opt-jobs n\t\t\tOptimize functions using n threads\n"
+            "  --pch name\t\t\tUse or create a precompiled header\n"
             "  --register-space b\t\tSet space available for register variables\n"
             "  --register-vars\t\tEnable register variables\n"
             "  --rodata-name seg\t\tSet the name of the RODATA segment\n"
@@ -136,6 +148,7 @@ static void Usage (void)
             "  --standard std\t\tLanguage standard (c89, c99, cc65)\n"
             "  --static-locals\t\tMake local variables static\n"
             "  --target sys\t\t\tSet the target system\n"
+            "  --use-profile name\t\tOptimize using a sim65 profile\n"
             "  --verbose\t\t\tIncrease verbosity\n"
             "  --version\t\t\tPrint the compiler version number\n"
             "  --writable-strings\t\tMake string literals writable\n",
@@ -408,6 +421,24 @@ static void OptAllCDecl (const char* Opt attribute ((unused)),
 
 
 
+static void OptAutoRegisterVars (const char* Opt attribute ((unused)),
+                                 const char* Arg attribute ((unused)))
+/* Handle the --auto-register-vars option */
+{
+    IS_Set (&AutoRegVars, 1);
+}
+
+
+
+static void OptAutoStaticLocals (const char* Opt attribute ((unused)),
+                                 const char* Arg attribute ((unused)))
+/* Handle the --auto-static-locals option */
+{
+    AutoStaticLocals = 1;
+}
+
+
+
 static void OptBssName (const char* Opt attribute ((unused)), const char* Arg)
 /* Handle the --bss-name option */
 {
@@ -488,6 +519,21 @@ static void OptCPU (const char* Opt, const char* Arg)
 
 
 
+static void OptCycleWeight (const char* Opt, const char* Arg)
+/* Handle the --cycle-weight option */
+{
+    unsigned Weight;
+    char     BoundsCheck;
+
+    /* Numeric argument expected */
+    if (sscanf (Arg, "%u%c", &Weight, &BoundsCheck) != 1 || Weight > 100) {
+        AbEnd ("Argument for %s is invalid", Opt);
+    }
+    IS_Set (&CycleWeight, Weight);
+}
+
+
+
 static void OptDataName (const char* Opt attribute ((unused)), const char* Arg)
 /* Handle the --data-name option */
 {
@@ -651,6 +697,15 @@ static void OptIncludeDir (const char* Opt attribute ((unused)), const char* Arg
 
 
 
+static void OptInlineFuncs (const char* Opt attribute((unused)),
+                            const char* Arg attribute((unused)))
+/* Inline small static and inline functions */
+{
+    IS_Set (&InlineFuncs, 1);
+}
+
+
+
 static void OptInlineStdFuncs (const char* Opt attribute((unused)),
                                const char* Arg attribute((unused)))
 /* Inline some standard functions */
@@ -660,6 +715,15 @@ static void OptInlineStdFuncs (const char* Opt attribute((unused)),
 
 
 
+static void OptKeepUnused (const char* Opt attribute ((unused)),
+                           const char* Arg attribute ((unused)))
+/* Handle the --keep-unused option */
+{
+    KeepUnused = 1;
+}
+
+
+
 static void OptListOptSteps (const char* Opt attribute ((unused)),
                              const char* Arg attribute ((unused)))
 /* List all optimizer steps */
@@ -719,6 +783,37 @@ static void OptMemoryModel (const char* Opt, const char* Arg)
 
 
 
+static void OptNarrowLoopVars (const char* Opt attribute ((unused)),
+                               const char* Arg attribute ((unused)))
+/* Handle the --narrow-loop-vars option */
+{
+    IS_Set (&NarrowLoopVars, 1);
+}
+
+
+
+static void OptOptJobs (const char* Opt, const char* Arg)
+/* Handle the --opt-jobs option */
+{
+    /* Numeric argument expected, zero means one thread per processor */
+    if (sscanf (Arg, "%u", &OptJobs) != 1 || OptJobs > 256) {
+        AbEnd ("Argument for option %s is invalid", Opt);
+    }
+    if (OptJobs == 0) {
+        OptJobs = GetCPUCount ();
+    }
+}
+
+
+
+static void OptPch (const char* Opt, const char* Arg)
+/* Handle the --pch option */
+{
+    FileNameOption (Opt, Arg, &PchName);
+}
+
+
+
 static void OptRegisterSpace (const char* Opt, const char* Arg)
 /* Handle the --register-space option */
 {
@@ -793,6 +888,14 @@ static void OptTarget (const char* Opt attribute ((unused)), const char* Arg)
 
 
 
+static void OptUseProfile (const char* Opt attribute ((unused)), const char* Arg)
+/* Read a profile */
+{
+    ReadProfile (Arg);
+}
+
+
+
 static void OptVerbose (const char* Opt attribute ((unused)),
                         const char* Arg attribute ((unused)))
 /* Increase verbosity */
@@ -867,12 +970,55 @@ static void OptWritableStrings (const char* Opt attribute ((unused)),
 
 
 
+static void CompileFile (const char* InputFile)
+/* Compile one translation unit and write the output file */
+{
+    /* Create the output file name if it was not explicitly given */
+    MakeDefaultOutputName (InputFile);
+
+    /* Track string buffer allocation */
+    InitDiagnosticStrBufs ();
+
+    /* Go! */
+    Compile (InputFile);
+
+    /* Create the output file if we didn't had any errors */
+    if (PreprocessOnly == 0 && (GetTotalErrors () == 0 || Debug)) {
+
+        /* Emit literals, do cleanup and optimizations */
+        FinishCompile ();
+
+        /* Open the file */
+        OpenOutputFile ();
+
+        /* Write the output to the file */
+        WriteAsmOutput ();
+        Print (stdout, 1, "Wrote output to '%s'\n", OutputFilename);
+        if (Debug) {
+            PrintCodePoolStats (stdout);
+        }
+
+        /* Close the file, check for errors */
+        CloseOutputFile ();
+
+        /* Create dependencies if requested */
+        CreateDependencies ();
+    }
+
+    /* Done with tracked string buffer allocation */
+    DoneDiagnosticStrBufs ();
+}
+
+
+
 int main (int argc, char* argv[])
 {
     /* Program long options */
     static const LongOpt OptTab[] = {
         { "--add-source",           0,      OptAddSource            },
         { "--all-cdecl",            0,      OptAllCDecl             },
+        { "--auto-register-vars",   0,      OptAutoRegisterVars     },
+        { "--auto-static-locals",   0,      OptAutoStaticLocals     },
         { "--bss-name",             1,      OptBssName              },
         { "--check-stack",          0,      OptCheckStack           },
         { "--code-name",            1,      OptCodeName             },
@@ -880,6 +1026,7 @@ int main (int argc, char* argv[])
         { "--cpu",                  1,      OptCPU                  },
         { "--create-dep",           1,      OptCreateDep            },
         { "--create-full-dep",      1,      OptCreateFullDep        },
+        { "--cycle-weight",         1,      OptCycleWeight          },
         { "--data-name",            1,      OptDataName             },
         { "--debug",                0,      OptDebug                },
         { "--debug-tables",         1,      OptDebugTables          },
@@ -892,11 +1039,16 @@ int main (int argc, char* argv[])
         { "--enable-opt",           1,      OptEnableOpt            },
         { "--help",                 0,      OptHelp                 },
         { "--include-dir",          1,      OptIncludeDir           },
+        { "--inline-funcs",         0,      OptInlineFuncs          },
         { "--inline-stdfuncs",      0,      OptInlineStdFuncs       },
+        { "--keep-unused",          0,      OptKeepUnused           },
         { "--list-opt-steps",       0,      OptListOptSteps         },
         { "--list-warnings",        0,      OptListWarnings         },
         { "--local-strings",        0,      OptLocalStrings         },
         { "--memory-model",         1,      OptMemoryModel          },
+        { "--narrow-loop-vars",     0,      OptNarrowLoopVars       },
+        { "--opt-jobs",             1,      OptOptJobs              },
+        { "--pch",                  1,      OptPch                  },
         { "--register-space",       1,      OptRegisterSpace        },
         { "--register-vars",        0,      OptRegisterVars         },
         { "--rodata-name",          1,      OptRodataName           },
@@ -904,15 +1056,17 @@ int main (int argc, char* argv[])
         { "--standard",             1,      OptStandard             },
         { "--static-locals",        0,      OptStaticLocals         },
         { "--target",               1,      OptTarget               },
+        { "--use-profile",          1,      OptUseProfile           },
         { "--verbose",              0,      OptVerbose              },
         { "--version",              0,      OptVersion              },
         { "--writable-strings",     0,      OptWritableStrings      },
     };
 
     unsigned I;
+    int      Failed;
 
-    /* Initialize the input file name */
-    const char* InputFile  = 0;
+    /* The input files */
+    Collection InputFiles = AUTO_COLLECTION_INITIALIZER;
 
     /* Initialize the cmdline module */
     InitCmdLine (&argc, &argv, "cc65");
@@ -1041,11 +1195,7 @@ int main (int argc, char* argv[])
                     break;
             }
         } else {
-            if (InputFile) {
-                fprintf (stderr, "additional file specs ignored\n");
-            } else {
-                InputFile = Arg;
-            }
+            CollAppend (&InputFiles, (void*) Arg);
         }
 
         /* Next argument */
@@ -1053,16 +1203,26 @@ int main (int argc, char* argv[])
     }
 
     /* Did we have a file spec on the command line? */
-    if (InputFile == 0) {
+    if (CollCount (&InputFiles) == 0) {
         AbEnd ("No input files");
     }
 
+    /* Output names given on the command line are for a single file */
+    if (CollCount (&InputFiles) > 1) {
+        if (OutputFilename != 0) {
+            AbEnd ("Cannot use -o with more than one input file");
+        }
+        if (SB_NotEmpty (&DepName) || SB_NotEmpty (&FullDepName)) {
+            AbEnd ("Cannot create dependencies for more than one input file");
+        }
+        if (SB_NotEmpty (&DebugTableName)) {
+            AbEnd ("Cannot use --debug-tables with more than one input file");
+        }
+    }
+
     /* Add the default include search paths. */
     FinishIncludePaths ();
 
-    /* Create the output file name if it was not explicitly given */
-    MakeDefaultOutputName (InputFile);
-
     /* If no CPU given, use the default CPU for the target */
     if (CPU == CPU_UNKNOWN) {
         if (Target != TGT_UNKNOWN) {
@@ -1082,38 +1242,28 @@ int main (int argc, char* argv[])
         IS_Set (&Standard, STD_DEFAULT);
     }
 
-    /* Track string buffer allocation */
-    InitDiagnosticStrBufs ();
-
-    /* Go! */
-    Compile (InputFile);
-
-    /* Create the output file if we didn't had any errors */
-    if (PreprocessOnly == 0 && (GetTotalErrors () == 0 || Debug)) {
-
-        /* Emit literals, do cleanup and optimizations */
-        FinishCompile ();
-
-        /* Open the file */
-        OpenOutputFile ();
-
-        /* Write the output to the file */
-        WriteAsmOutput ();
-        Print (stdout, 1, "Wrote output to '%s'\n", OutputFilename);
-
-        /* Close the file, check for errors */
-        CloseOutputFile ();
-
-        /* Create dependencies if requested */
-        CreateDependencies ();
+    /* Compile the files. Each file after the first one starts with the
+    ** settings from the command line, so the output is the same as with
+    ** separate invocations, but the startup cost is paid only once.
+    */
+    Failed = 0;
+    for (I = 0; I < CollCount (&InputFiles); ++I) {
+        if (I > 0) {
+            ResetCompiler ();
+            SetOutputName (0);
+        } else if (CollCount (&InputFiles) > 1) {
+            SaveCompilerSettings ();
+        }
+        CompileFile (CollAtUnchecked (&InputFiles, I));
+        if (GetTotalErrors () > 0) {
+            Failed = 1;
+        }
     }
-
-    /* Done with tracked string buffer allocation */
-    DoneDiagnosticStrBufs ();
+    DoneCollection (&InputFiles);
 
     /* Free up the segment address sizes table */
     DoneSegAddrSizes ();
 
     /* Return an apropriate exit code */
-    return (GetTotalErrors () > 0)? EXIT_FAILURE : EXIT_SUCCESS;
+    return Failed? EXIT_FAILURE : EXIT_SUCCESS;
 }
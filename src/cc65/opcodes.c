@@ -61,6 +61,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_ADC,                               /* opcode */
         "adc",                                  /* mnemonic */
         0,                                      /* size */
+        0,                                      /* cycles */
+        1,                                      /* penalty */
         OF_SETF | OF_READ,                      /* flags */
         REG_A | PSTATE_C,                       /* use */
         REG_A | PSTATE_CZVN                     /* chg */
@@ -68,6 +70,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_AND,                               /* opcode */
         "and",                                  /* mnemonic */
         0,                                      /* size */
+        0,                                      /* cycles */
+        1,                                      /* penalty */
         OF_SETF | OF_READ,                      /* flags */
         REG_A,                                  /* use */
         REG_A | PSTATE_ZN                       /* chg */
@@ -75,6 +79,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_ASL,                               /* opcode */
         "asl",                                  /* mnemonic */
         0,                                      /* size */
+        0,                                      /* cycles */
+        0,                                      /* penalty */
         OF_SETF | OF_NOIMP | OF_RMW,            /* flags */
         REG_NONE,                               /* use */
         PSTATE_CZN                              /* chg */
@@ -82,6 +88,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_BCC,                               /* opcode */
         "bcc",                                  /* mnemonic */
         2,                                      /* size */
+        2,                                      /* cycles */
+        1,                                      /* penalty */
         OF_CBRA,                                /* flags */
         PSTATE_C,                               /* use */
         REG_NONE                                /* chg */
@@ -89,6 +97,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_BCS,                               /* opcode */
         "bcs",                                  /* mnemonic */
         2,                                      /* size */
+        2,                                      /* cycles */
+        1,                                      /* penalty */
         OF_CBRA,                                /* flags */
         PSTATE_C,                               /* use */
         REG_NONE                                /* chg */
@@ -96,6 +106,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_BEQ,                               /* opcode */
         "beq",                                  /* mnemonic */
         2,                                      /* size */
+        2,                                      /* cycles */
+        1,                                      /* penalty */
         OF_CBRA | OF_ZBRA | OF_FBRA,            /* flags */
         PSTATE_Z,                               /* use */
         REG_NONE                                /* chg */
@@ -103,6 +115,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_BIT,                               /* opcode */
         "bit",                                  /* mnemonic */
         0,                                      /* size */
+        0,                                      /* cycles */
+        1,                                      /* penalty */
         OF_READ,                                /* flags */
         REG_A,                                  /* use */
         PSTATE_ZVN                              /* chg */
@@ -110,6 +124,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_BMI,                               /* opcode */
         "bmi",                                  /* mnemonic */
         2,                                      /* size */
+        2,                                      /* cycles */
+        1,                                      /* penalty */
         OF_CBRA | OF_FBRA,                      /* flags */
         PSTATE_N,                               /* use */
         REG_NONE                                /* chg */
@@ -117,6 +133,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_BNE,                               /* opcode */
         "bne",                                  /* mnemonic */
         2,                                      /* size */
+        2,                                      /* cycles */
+        1,                                      /* penalty */
         OF_CBRA | OF_ZBRA | OF_FBRA,            /* flags */
         PSTATE_Z,                               /* use */
         REG_NONE                                /* chg */
@@ -124,6 +142,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_BPL,                               /* opcode */
         "bpl",                                  /* mnemonic */
         2,                                      /* size */
+        2,                                      /* cycles */
+        1,                                      /* penalty */
         OF_CBRA | OF_FBRA,                      /* flags */
         PSTATE_N,                               /* use */
         REG_NONE                                /* chg */
@@ -131,6 +151,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_BRA,                               /* opcode */
         "bra",                                  /* mnemonic */
         2,                                      /* size */
+        3,                                      /* cycles */
+        0,                                      /* penalty */
         OF_UBRA,                                /* flags */
         REG_NONE,                               /* use */
         REG_NONE                                /* chg */
@@ -138,6 +160,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_BRK,                               /* opcode */
         "brk",                                  /* mnemonic */
         1,                                      /* size */
+        7,                                      /* cycles */
+        0,                                      /* penalty */
         OF_NONE,                                /* flags */
         REG_NONE,                               /* use */
         PSTATE_B                                /* chg */
@@ -145,6 +169,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_BVC,                               /* opcode */
         "bvc",                                  /* mnemonic */
         2,                                      /* size */
+        2,                                      /* cycles */
+        1,                                      /* penalty */
         OF_CBRA,                                /* flags */
         PSTATE_V,                               /* use */
         REG_NONE                                /* chg */
@@ -152,6 +178,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_BVS,                               /* opcode */
         "bvs",                                  /* mnemonic */
         2,                                      /* size */
+        2,                                      /* cycles */
+        1,                                      /* penalty */
         OF_CBRA,                                /* flags */
         PSTATE_V,                               /* use */
         REG_NONE                                /* chg */
@@ -159,6 +187,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_CLC,                               /* opcode */
         "clc",                                  /* mnemonic */
         1,                                      /* size */
+        2,                                      /* cycles */
+        0,                                      /* penalty */
         OF_NONE,                                /* flags */
         REG_NONE,                               /* use */
         PSTATE_C                                /* chg */
@@ -166,6 +196,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_CLD,                               /* opcode */
         "cld",                                  /* mnemonic */
         1,                                      /* size */
+        2,                                      /* cycles */
+        0,                                      /* penalty */
         OF_NONE,                                /* flags */
         REG_NONE,                               /* use */
         PSTATE_D                                /* chg */
@@ -173,6 +205,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_CLI,                               /* opcode */
         "cli",                                  /* mnemonic */
         1,                                      /* size */
+        2,                                      /* cycles */
+        0,                                      /* penalty */
         OF_NONE,                                /* flags */
         REG_NONE,                               /* use */
         PSTATE_I                                /* chg */
@@ -180,6 +214,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_CLV,                               /* opcode */
         "clv",                                  /* mnemonic */
         1,                                      /* size */
+        2,                                      /* cycles */
+        0,                                      /* penalty */
         OF_NONE,                                /* flags */
         REG_NONE,                               /* use */
         PSTATE_V                                /* chg */
@@ -187,6 +223,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_CMP,                               /* opcode */
         "cmp",                                  /* mnemonic */
         0,                                      /* size */
+        0,                                      /* cycles */
+        1,                                      /* penalty */
         OF_SETF | OF_CMP | OF_READ,             /* flags */
         REG_A,                                  /* use */
         PSTATE_CZN                              /* chg */
@@ -194,6 +232,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_CPX,                               /* opcode */
         "cpx",                                  /* mnemonic */
         0,                                      /* size */
+        0,                                      /* cycles */
+        1,                                      /* penalty */
         OF_SETF | OF_CMP | OF_READ,             /* flags */
         REG_X,                                  /* use */
         PSTATE_CZN                              /* chg */
@@ -201,6 +241,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_CPY,                               /* opcode */
         "cpy",                                  /* mnemonic */
         0,                                      /* size */
+        0,                                      /* cycles */
+        1,                                      /* penalty */
         OF_SETF | OF_CMP | OF_READ,             /* flags */
         REG_Y,                                  /* use */
         PSTATE_CZN                              /* chg */
@@ -208,6 +250,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_DEA,                               /* opcode */
         "dea",                                  /* mnemonic */
         1,                                      /* size */
+        2,                                      /* cycles */
+        0,                                      /* penalty */
         OF_REG_INCDEC | OF_SETF,                /* flags */
         REG_A,                                  /* use */
         REG_A | PSTATE_ZN                       /* chg */
@@ -215,6 +259,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_DEC,                               /* opcode */
         "dec",                                  /* mnemonic */
         0,                                      /* size */
+        0,                                      /* cycles */
+        0,                                      /* penalty */
         OF_SETF | OF_NOIMP | OF_RMW,            /* flags */
         REG_NONE,                               /* use */
         PSTATE_ZN                               /* chg */
@@ -222,6 +268,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_DEX,                               /* opcode */
         "dex",                                  /* mnemonic */
         1,                                      /* size */
+        2,                                      /* cycles */
+        0,                                      /* penalty */
         OF_REG_INCDEC | OF_SETF,                /* flags */
         REG_X,                                  /* use */
         REG_X | PSTATE_ZN                       /* chg */
@@ -229,6 +277,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_DEY,                               /* opcode */
         "dey",                                  /* mnemonic */
         1,                                      /* size */
+        2,                                      /* cycles */
+        0,                                      /* penalty */
         OF_REG_INCDEC | OF_SETF,                /* flags */
         REG_Y,                                  /* use */
         REG_Y | PSTATE_ZN                       /* chg */
@@ -236,6 +286,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_EOR,                               /* opcode */
         "eor",                                  /* mnemonic */
         0,                                      /* size */
+        0,                                      /* cycles */
+        1,                                      /* penalty */
         OF_SETF | OF_READ,                      /* flags */
         REG_A,                                  /* use */
         REG_A | PSTATE_ZN                       /* chg */
@@ -243,6 +295,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_INA,                               /* opcode */
         "ina",                                  /* mnemonic */
         1,                                      /* size */
+        2,                                      /* cycles */
+        0,                                      /* penalty */
         OF_REG_INCDEC | OF_SETF,                /* flags */
         REG_A,                                  /* use */
         REG_A | PSTATE_ZN                       /* chg */
@@ -250,6 +304,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_INC,                               /* opcode */
         "inc",                                  /* mnemonic */
         0,                                      /* size */
+        0,                                      /* cycles */
+        0,                                      /* penalty */
         OF_SETF | OF_NOIMP | OF_RMW,            /* flags */
         REG_NONE,                               /* use */
         PSTATE_ZN                               /* chg */
@@ -257,6 +313,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_INX,                               /* opcode */
         "inx",                                  /* mnemonic */
         1,                                      /* size */
+        2,                                      /* cycles */
+        0,                                      /* penalty */
         OF_REG_INCDEC | OF_SETF,                /* flags */
         REG_X,                                  /* use */
         REG_X | PSTATE_ZN                       /* chg */
@@ -264,6 +322,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_INY,                               /* opcode */
         "iny",                                  /* mnemonic */
         1,                                      /* size */
+        2,                                      /* cycles */
+        0,                                      /* penalty */
         OF_REG_INCDEC | OF_SETF,                /* flags */
         REG_Y,                                  /* use */
         REG_Y | PSTATE_ZN                       /* chg */
@@ -271,6 +331,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_JCC,                               /* opcode */
         "jcc",                                  /* mnemonic */
         5,                                      /* size */
+        3,                                      /* cycles */
+        2,                                      /* penalty */
         OF_CBRA | OF_LBRA,                      /* flags */
         PSTATE_C,                               /* use */
         REG_NONE                                /* chg */
@@ -278,6 +340,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_JCS,                               /* opcode */
         "jcs",                                  /* mnemonic */
         5,                                      /* size */
+        3,                                      /* cycles */
+        2,                                      /* penalty */
         OF_CBRA | OF_LBRA,                      /* flags */
         PSTATE_C,                               /* use */
         REG_NONE                                /* chg */
@@ -285,6 +349,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_JEQ,                               /* opcode */
         "jeq",                                  /* mnemonic */
         5,                                      /* size */
+        3,                                      /* cycles */
+        2,                                      /* penalty */
         OF_CBRA | OF_LBRA | OF_ZBRA | OF_FBRA,  /* flags */
         PSTATE_Z,                               /* use */
         REG_NONE                                /* chg */
@@ -292,6 +358,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_JMI,                               /* opcode */
         "jmi",                                  /* mnemonic */
         5,                                      /* size */
+        3,                                      /* cycles */
+        2,                                      /* penalty */
         OF_CBRA | OF_LBRA | OF_FBRA,            /* flags */
         PSTATE_N,                               /* use */
         REG_NONE                                /* chg */
@@ -299,6 +367,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_JML,                               /* opcode */
         "jml",                                  /* mnemonic */
         4,                                      /* size */
+        4,                                      /* cycles */
+        0,                                      /* penalty */
         OF_UBRA | OF_LBRA | OF_READ,            /* flags */
         REG_NONE,                               /* use */
         REG_NONE                                /* chg */
@@ -306,6 +376,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_JMP,                               /* opcode */
         "jmp",                                  /* mnemonic */
         3,                                      /* size */
+        3,                                      /* cycles */
+        0,                                      /* penalty */
         OF_UBRA | OF_LBRA | OF_READ,            /* flags */
         REG_NONE,                               /* use */
         REG_NONE                                /* chg */
@@ -313,6 +385,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_JNE,                               /* opcode */
         "jne",                                  /* mnemonic */
         5,                                      /* size */
+        3,                                      /* cycles */
+        2,                                      /* penalty */
         OF_CBRA | OF_LBRA | OF_ZBRA | OF_FBRA,  /* flags */
         PSTATE_Z,                               /* use */
         REG_NONE                                /* chg */
@@ -320,6 +394,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_JPL,                               /* opcode */
         "jpl",                                  /* mnemonic */
         5,                                      /* size */
+        3,                                      /* cycles */
+        2,                                      /* penalty */
         OF_CBRA | OF_LBRA | OF_FBRA,            /* flags */
         PSTATE_N,                               /* use */
         REG_NONE                                /* chg */
@@ -327,6 +403,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_JSL,                               /* opcode */
         "jsl",                                  /* mnemonic */
         4,                                      /* size */
+        8,                                      /* cycles */
+        0,                                      /* penalty */
         OF_CALL | OF_READ,                      /* flags */
         REG_NONE,                               /* use */
         REG_NONE                                /* chg */
@@ -334,6 +412,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_JSR,                               /* opcode */
         "jsr",                                  /* mnemonic */
         3,                                      /* size */
+        6,                                      /* cycles */
+        0,                                      /* penalty */
         OF_CALL | OF_READ,                      /* flags */
         REG_NONE,                               /* use */
         REG_NONE                                /* chg */
@@ -341,6 +421,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_JVC,                               /* opcode */
         "jvc",                                  /* mnemonic */
         5,                                      /* size */
+        3,                                      /* cycles */
+        2,                                      /* penalty */
         OF_CBRA | OF_LBRA,                      /* flags */
         PSTATE_V,                               /* use */
         REG_NONE                                /* chg */
@@ -348,6 +430,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_JVS,                               /* opcode */
         "jvs",                                  /* mnemonic */
         5,                                      /* size */
+        3,                                      /* cycles */
+        2,                                      /* penalty */
         OF_CBRA | OF_LBRA,                      /* flags */
         PSTATE_V,                               /* use */
         REG_NONE                                /* chg */
@@ -355,6 +439,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_LDA,                               /* opcode */
         "lda",                                  /* mnemonic */
         0,                                      /* size */
+        0,                                      /* cycles */
+        1,                                      /* penalty */
         OF_LOAD | OF_SETF | OF_READ,            /* flags */
         REG_NONE,                               /* use */
         REG_A | PSTATE_ZN                       /* chg */
@@ -362,6 +448,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_LDX,                               /* opcode */
         "ldx",                                  /* mnemonic */
         0,                                      /* size */
+        0,                                      /* cycles */
+        1,                                      /* penalty */
         OF_LOAD | OF_SETF | OF_READ,            /* flags */
         REG_NONE,                               /* use */
         REG_X | PSTATE_ZN                       /* chg */
@@ -369,6 +457,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_LDY,                               /* opcode */
         "ldy",                                  /* mnemonic */
         0,                                      /* size */
+        0,                                      /* cycles */
+        1,                                      /* penalty */
         OF_LOAD | OF_SETF | OF_READ,            /* flags */
         REG_NONE,                               /* use */
         REG_Y | PSTATE_ZN                       /* chg */
@@ -376,6 +466,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_LSR,                               /* opcode */
         "lsr",                                  /* mnemonic */
         0,                                      /* size */
+        0,                                      /* cycles */
+        0,                                      /* penalty */
         OF_SETF | OF_NOIMP | OF_RMW,            /* flags */
         REG_NONE,                               /* use */
         PSTATE_CZN                              /* chg */
@@ -383,6 +475,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_NOP,                               /* opcode */
         "nop",                                  /* mnemonic */
         1,                                      /* size */
+        2,                                      /* cycles */
+        0,                                      /* penalty */
         OF_NONE,                                /* flags */
         REG_NONE,                               /* use */
         REG_NONE                                /* chg */
@@ -390,6 +484,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_ORA,                               /* opcode */
         "ora",                                  /* mnemonic */
         0,                                      /* size */
+        0,                                      /* cycles */
+        1,                                      /* penalty */
         OF_SETF | OF_READ,                      /* flags */
         REG_A,                                  /* use */
         REG_A | PSTATE_ZN                       /* chg */
@@ -397,6 +493,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_PHA,                               /* opcode */
         "pha",                                  /* mnemonic */
         1,                                      /* size */
+        3,                                      /* cycles */
+        0,                                      /* penalty */
         OF_NONE,                                /* flags */
         REG_A,                                  /* use */
         REG_NONE                                /* chg */
@@ -404,6 +502,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_PHB,                               /* opcode */
         "phb",                                  /* mnemonic */
         1,                                      /* size */
+        3,                                      /* cycles */
+        0,                                      /* penalty */
         OF_NONE,                                /* flags */
         PSTATE_ALL,                             /* use */
         REG_NONE                                /* chg */
@@ -411,6 +511,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_PHK,                               /* opcode */
         "phk",                                  /* mnemonic */
         1,                                      /* size */
+        3,                                      /* cycles */
+        0,                                      /* penalty */
         OF_NONE,                                /* flags */
         PSTATE_ALL,                             /* use */
         REG_NONE                                /* chg */
@@ -418,6 +520,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_PHP,                               /* opcode */
         "php",                                  /* mnemonic */
         1,                                      /* size */
+        3,                                      /* cycles */
+        0,                                      /* penalty */
         OF_NONE,                                /* flags */
         PSTATE_ALL,                             /* use */
         REG_NONE                                /* chg */
@@ -425,6 +529,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_PHX,                               /* opcode */
         "phx",                                  /* mnemonic */
         1,                                      /* size */
+        3,                                      /* cycles */
+        0,                                      /* penalty */
         OF_NONE,                                /* flags */
         REG_X,                                  /* use */
         REG_NONE                                /* chg */
@@ -432,6 +538,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_PHY,                               /* opcode */
         "phy",                                  /* mnemonic */
         1,                                      /* size */
+        3,                                      /* cycles */
+        0,                                      /* penalty */
         OF_NONE,                                /* flags */
         REG_Y,                                  /* use */
         REG_NONE                                /* chg */
@@ -439,6 +547,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_PLA,                               /* opcode */
         "pla",                                  /* mnemonic */
         1,                                      /* size */
+        4,                                      /* cycles */
+        0,                                      /* penalty */
         OF_SETF,                                /* flags */
         REG_NONE,                               /* use */
         REG_A | PSTATE_ZN                       /* chg */
@@ -446,6 +556,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_PLB,                               /* opcode */
         "plb",                                  /* mnemonic */
         1,                                      /* size */
+        4,                                      /* cycles */
+        0,                                      /* penalty */
         OF_SETF,                                /* flags */
         REG_NONE,                               /* use */
         REG_A | PSTATE_ZN                       /* chg */
@@ -453,6 +565,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_PLP,                               /* opcode */
         "plp",                                  /* mnemonic */
         1,                                      /* size */
+        4,                                      /* cycles */
+        0,                                      /* penalty */
         OF_NONE,                                /* flags */
         REG_NONE,                               /* use */
         PSTATE_ALL                              /* chg */
@@ -460,6 +574,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_PLX,                               /* opcode */
         "plx",                                  /* mnemonic */
         1,                                      /* size */
+        4,                                      /* cycles */
+        0,                                      /* penalty */
         OF_SETF,                                /* flags */
         REG_NONE,                               /* use */
         REG_X | PSTATE_ZN                       /* chg */
@@ -467,6 +583,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_PLY,                               /* opcode */
         "ply",                                  /* mnemonic */
         1,                                      /* size */
+        4,                                      /* cycles */
+        0,                                      /* penalty */
         OF_SETF,                                /* flags */
         REG_NONE,                               /* use */
         REG_Y | PSTATE_ZN                       /* chg */
@@ -474,6 +592,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_ROL,                               /* opcode */
         "rol",                                  /* mnemonic */
         0,                                      /* size */
+        0,                                      /* cycles */
+        0,                                      /* penalty */
         OF_SETF | OF_NOIMP | OF_RMW,            /* flags */
         PSTATE_C,                               /* use */
         PSTATE_CZN                              /* chg */
@@ -481,6 +601,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_ROR,                               /* opcode */
         "ror",                                  /* mnemonic */
         0,                                      /* size */
+        0,                                      /* cycles */
+        0,                                      /* penalty */
         OF_SETF | OF_NOIMP | OF_RMW,            /* flags */
         PSTATE_C,                               /* use */
         PSTATE_CZN                              /* chg */
@@ -491,6 +613,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_RTI,                               /* opcode */
         "rti",                                  /* mnemonic */
         1,                                      /* size */
+        6,                                      /* cycles */
+        0,                                      /* penalty */
         OF_RET,                                 /* flags */
         REG_AXY,                                /* use */
         PSTATE_ALL                              /* chg */
@@ -498,6 +622,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_RTL,                               /* opcode */
         "rtl",                                  /* mnemonic */
         1,                                      /* size */
+        6,                                      /* cycles */
+        0,                                      /* penalty */
         OF_RET,                                 /* flags */
         REG_NONE,                               /* use */
         REG_NONE                                /* chg */
@@ -505,6 +631,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_RTS,                               /* opcode */
         "rts",                                  /* mnemonic */
         1,                                      /* size */
+        6,                                      /* cycles */
+        0,                                      /* penalty */
         OF_RET,                                 /* flags */
         REG_NONE,                               /* use */
         REG_NONE                                /* chg */
@@ -512,6 +640,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_SBC,                               /* opcode */
         "sbc",                                  /* mnemonic */
         0,                                      /* size */
+        0,                                      /* cycles */
+        1,                                      /* penalty */
         OF_SETF | OF_READ,                      /* flags */
         REG_A | PSTATE_C,                       /* use */
         REG_A | PSTATE_CZVN                     /* chg */
@@ -519,6 +649,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_SEC,                               /* opcode */
         "sec",                                  /* mnemonic */
         1,                                      /* size */
+        2,                                      /* cycles */
+        0,                                      /* penalty */
         OF_NONE,                                /* flags */
         REG_NONE,                               /* use */
         PSTATE_C                                /* chg */
@@ -526,6 +658,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_SED,                               /* opcode */
         "sed",                                  /* mnemonic */
         1,                                      /* size */
+        2,                                      /* cycles */
+        0,                                      /* penalty */
         OF_NONE,                                /* flags */
         REG_NONE,                               /* use */
         PSTATE_D                                /* chg */
@@ -533,6 +667,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_SEI,                               /* opcode */
         "sei",                                  /* mnemonic */
         1,                                      /* size */
+        2,                                      /* cycles */
+        0,                                      /* penalty */
         OF_NONE,                                /* flags */
         REG_NONE,                               /* use */
         PSTATE_I                                /* chg */
@@ -540,6 +676,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_STA,                               /* opcode */
         "sta",                                  /* mnemonic */
         0,                                      /* size */
+        0,                                      /* cycles */
+        0,                                      /* penalty */
         OF_STORE | OF_WRITE,                    /* flags */
         REG_A,                                  /* use */
         REG_NONE                                /* chg */
@@ -547,6 +685,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_STP,                               /* opcode */
         "stp",                                  /* mnemonic */
         1,                                      /* size */
+        3,                                      /* cycles */
+        0,                                      /* penalty */
         OF_NONE,                                /* flags */
         REG_NONE,                               /* use */
         REG_NONE                                /* chg */
@@ -554,6 +694,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_STX,                               /* opcode */
         "stx",                                  /* mnemonic */
         0,                                      /* size */
+        0,                                      /* cycles */
+        0,                                      /* penalty */
         OF_STORE | OF_WRITE,                    /* flags */
         REG_X,                                  /* use */
         REG_NONE                                /* chg */
@@ -561,6 +703,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_STY,                               /* opcode */
         "sty",                                  /* mnemonic */
         0,                                      /* size */
+        0,                                      /* cycles */
+        0,                                      /* penalty */
         OF_STORE | OF_WRITE,                    /* flags */
         REG_Y,                                  /* use */
         REG_NONE                                /* chg */
@@ -568,6 +712,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_STZ,                               /* opcode */
         "stz",                                  /* mnemonic */
         0,                                      /* size */
+        0,                                      /* cycles */
+        0,                                      /* penalty */
         OF_STORE | OF_WRITE,                    /* flags */
         REG_NONE,                               /* use */
         REG_NONE                                /* chg */
@@ -575,6 +721,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_TAX,                               /* opcode */
         "tax",                                  /* mnemonic */
         1,                                      /* size */
+        2,                                      /* cycles */
+        0,                                      /* penalty */
         OF_XFR | OF_SETF,                       /* flags */
         REG_A,                                  /* use */
         REG_X | PSTATE_ZN                       /* chg */
@@ -582,6 +730,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_TAY,                               /* opcode */
         "tay",                                  /* mnemonic */
         1,                                      /* size */
+        2,                                      /* cycles */
+        0,                                      /* penalty */
         OF_XFR | OF_SETF,                       /* flags */
         REG_A,                                  /* use */
         REG_Y | PSTATE_ZN                       /* chg */
@@ -589,6 +739,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_TRB,                               /* opcode */
         "trb",                                  /* mnemonic */
         0,                                      /* size */
+        0,                                      /* cycles */
+        0,                                      /* penalty */
         OF_RMW,                                 /* flags */
         REG_A,                                  /* use */
         PSTATE_Z                                /* chg */
@@ -596,6 +748,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_TSB,                               /* opcode */
         "tsb",                                  /* mnemonic */
         0,                                      /* size */
+        0,                                      /* cycles */
+        0,                                      /* penalty */
         OF_RMW,                                 /* flags */
         REG_A,                                  /* use */
         PSTATE_Z                                /* chg */
@@ -603,6 +757,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_TSX,                               /* opcode */
         "tsx",                                  /* mnemonic */
         1,                                      /* size */
+        2,                                      /* cycles */
+        0,                                      /* penalty */
         OF_XFR | OF_SETF,                       /* flags */
         REG_NONE,                               /* use */
         REG_X | PSTATE_ZN                       /* chg */
@@ -610,6 +766,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_TXA,                               /* opcode */
         "txa",                                  /* mnemonic */
         1,                                      /* size */
+        2,                                      /* cycles */
+        0,                                      /* penalty */
         OF_XFR | OF_SETF,                       /* flags */
         REG_X,                                  /* use */
         REG_A | PSTATE_ZN                       /* chg */
@@ -617,6 +775,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_TXS,                               /* opcode */
         "txs",                                  /* mnemonic */
         1,                                      /* size */
+        2,                                      /* cycles */
+        0,                                      /* penalty */
         OF_XFR,                                 /* flags */
         REG_X,                                  /* use */
         REG_NONE                                /* chg */
@@ -624,6 +784,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_TYA,                               /* opcode */
         "tya",                                  /* mnemonic */
         1,                                      /* size */
+        2,                                      /* cycles */
+        0,                                      /* penalty */
         OF_XFR | OF_SETF,                       /* flags */
         REG_Y,                                  /* use */
         REG_A | PSTATE_ZN                       /* chg */
@@ -631,6 +793,8 @@ const OPCDesc OPCTable[OP65_COUNT] = {
     {   OP65_XBA,                               /* opcode */
         "xba",                                  /* mnemonic */
         1,                                      /* size */
+        3,                                      /* cycles */
+        0,                                      /* penalty */
         OF_XFR | OF_SETF,                       /* flags */
         REG_A,                                  /* use */
         REG_A | PSTATE_ZN                       /* chg */
@@ -713,6 +877,63 @@ unsigned GetInsnSize (opc_t OPC, am_t AM)
 
 
 
+unsigned GetInsnCycles (opc_t OPC, am_t AM)
+/* Return the number of cycles the given instruction takes on a 6502 if no
+** page boundary is crossed and a conditional branch is not taken.
+*/
+{
+    /* Get the opcode desc and check the cycles given there. Indirect jumps
+    ** take longer than the absolute one listed in the table.
+    */
+    const OPCDesc* D = &OPCTable[OPC];
+    if (OPC == OP65_JMP && AM != AM65_ABS && AM != AM65_BRA) {
+        return (AM == AM65_ABSX || AM == AM65_ZPX_IND)? 6 : 5;
+    }
+    if (D->Cycles != 0) {
+        return D->Cycles;
+    }
+
+    /* Check the addressing mode and the kind of memory access */
+    switch (AM) {
+        case AM65_IMP:
+        case AM65_ACC:
+        case AM65_IMM:     return 2;
+        case AM65_ZP:      return ((D->Info & OF_RMW) == OF_RMW)? 5 : 3;
+        case AM65_ZPX:
+        case AM65_ZPY:     return ((D->Info & OF_RMW) == OF_RMW)? 6 : 4;
+        case AM65_ABS:     return ((D->Info & OF_RMW) == OF_RMW)? 6 : 4;
+        case AM65_ABSX:
+        case AM65_ABSY:
+            if ((D->Info & OF_RMW) == OF_RMW) {
+                return 7;
+            }
+            return (D->Info & OF_WRITE)? 5 : 4;
+        case AM65_ZPX_IND: return 6;
+        case AM65_ZP_INDY: return (D->Info & OF_WRITE)? 6 : 5;
+        case AM65_ZP_IND:  return 5;
+        default:
+            Internal ("Invalid addressing mode");
+            return 0;
+    }
+}
+
+
+
+unsigned GetInsnPenalty (opc_t OPC, am_t AM)
+/* Return the number of extra cycles the given instruction takes if a
+** conditional branch is taken, or if an indexed read crosses a page boundary.
+*/
+{
+    const OPCDesc* D = &OPCTable[OPC];
+    if ((D->Info & OF_CBRA) != 0 ||
+        AM == AM65_ABSX || AM == AM65_ABSY || AM == AM65_ZP_INDY) {
+        return D->Penalty;
+    }
+    return 0;
+}
+
+
+
 unsigned char GetAMUseInfo (am_t AM)
 /* Get usage info for the given addressing mode (addressing modes that use
 ** index registers return REG_r info for these registers).
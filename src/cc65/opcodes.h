@@ -199,6 +199,8 @@ typedef struct {
     opc_t           OPC;                /* Opcode */
     char            Mnemo[9];           /* Mnemonic */
     unsigned char   Size;               /* Size, 0 = check addressing mode */
+    unsigned char   Cycles;             /* Cycles, 0 = check addressing mode */
+    unsigned char   Penalty;            /* Extra cycles, see GetInsnPenalty */
     unsigned short  Info;               /* Additional information */
     unsigned int    Use;                /* Registers used by this insn */
     unsigned int    Chg;                /* Registers changed by this insn */
@@ -223,6 +225,16 @@ const OPCDesc* FindOP65 (const char* OPC);
 unsigned GetInsnSize (opc_t OPC, am_t AM);
 /* Return the size of the given instruction */
 
+unsigned GetInsnCycles (opc_t OPC, am_t AM);
+/* Return the number of cycles the given instruction takes on a 6502 if no
+** page boundary is crossed and a conditional branch is not taken.
+*/
+
+unsigned GetInsnPenalty (opc_t OPC, am_t AM);
+/* Return the number of extra cycles the given instruction takes if a
+** conditional branch is taken, or if an indexed read crosses a page boundary.
+*/
+
 #if defined(HAVE_INLINE)
 INLINE const OPCDesc* GetOPCDesc (opc_t OPC)
 /* Get an opcode description */
@@ -0,0 +1,777 @@
+/*****************************************************************************/
+/*                                                                           */
+/*                                 overlay.c                                 */
+/*                                                                           */
+/*       Placement of the locals of non-reentrant functions into memory      */
+/*                                                                           */
+/*                                                                           */
+/*                                                                           */
+/* Copyright 2026 The cc65 Authors                                           */
+/*                                                                           */
+/*                                                                           */
+/* This software is provided 'as-is', without any expressed or implied       */
+/* warranty.  In no event will the authors be held liable for any damages    */
+/* arising from the use of this software.                                    */
+/*                                                                           */
+/* Permission is granted to anyone to use this software for any purpose,     */
+/* including commercial applications, and to alter it and redistribute it    */
+/* freely, subject to the following restrictions:                            */
+/*                                                                           */
+/* 1. The origin of this software must not be misrepresented; you must not   */
+/*    claim that you wrote the original software. If you use this software   */
+/*    in a product, an acknowledgment in the product documentation would be  */
+/*    appreciated but is not required.                                       */
+/* 2. Altered source versions must be plainly marked as such, and must not   */
+/*    be misrepresented as being the original software.                      */
+/* 3. This notice may not be removed or altered from any source              */
+/*    distribution.                                                          */
+/*                                                                           */
+/*****************************************************************************/
+
+
+
+#include <string.h>
+
+/* common */
+#include "check.h"
+#include "coll.h"
+#include "hashfunc.h"
+#include "xmalloc.h"
+
+/* cc65 */
+#include "asmlabel.h"
+#include "codegen.h"
+#include "dataseg.h"
+#include "input.h"
+#include "scanner.h"
+#include "segments.h"
+#include "overlay.h"
+
+
+
+/*****************************************************************************/
+/*                                   Data                                    */
+/*****************************************************************************/
+
+
+
+/* Size of the hash table for the identifiers */
+#define OV_HASH_SIZE    211U
+
+/* Maximum parenthesis nesting tracked in a function body */
+#define OV_MAX_PARENS   32U
+
+/* Flags for an identifier */
+#define OVF_DECL        0x0001U         /* Function declared on the top level */
+#define OVF_DEF         0x0002U         /* Function is defined */
+#define OVF_STATIC      0x0004U         /* Function is declared static */
+#define OVF_SYSTEM      0x0008U         /* Declared in a system header */
+#define OVF_INTERRUPT   0x0010U         /* Declared with "interrupt" attribute */
+#define OVF_ADDR        0x0020U         /* Used other than in a call */
+#define OVF_ASM         0x0040U         /* Body contains inline assembler */
+#define OVF_CALLEXT     0x0080U         /* Calls unknown functions */
+#define OVF_CALLLIB     0x0100U         /* Calls library functions */
+#define OVF_REENTRANT   0x0200U         /* May be reentered */
+#define OVF_OVERLAY     0x0400U         /* Locals go into the overlay area */
+
+/* Kinds of parentheses in a function body */
+#define PK_GROUP        0U              /* Grouping, maybe a cast */
+#define PK_CAST         1U              /* Cast to a type starting with a keyword */
+#define PK_CALL         2U              /* Argument list of a call */
+#define PK_KEYWORD      3U              /* After a keyword like "if" */
+
+/* A local placed into the overlay area */
+typedef struct OVLocal OVLocal;
+struct OVLocal {
+    unsigned            Label;          /* Data label of the local */
+    unsigned            Offs;           /* Offset in the locals of the function */
+};
+
+/* An identifier that may be a function */
+typedef struct OVFunc OVFunc;
+struct OVFunc {
+    OVFunc*             Next;           /* Next entry in hash chain */
+    unsigned            Flags;          /* OVF_xxx */
+    unsigned            Mark;           /* Mark for graph searches */
+    Collection          Callees;        /* Identifiers called in the body */
+    Collection          Succ;           /* Successors in the call graph */
+    Collection          Active;         /* Overlay functions active when called */
+    Collection          Locals;         /* Locals in the overlay area */
+    SymEntry*           Func;           /* Symbol of the function */
+    unsigned            Size;           /* Size of the locals */
+    unsigned            Offs;           /* Offset in the overlay area */
+    char                Name[1];        /* Identifier, dynamically allocated */
+};
+
+/* State while scanning the translation unit */
+typedef struct OVScan OVScan;
+struct OVScan {
+    OVFunc*             Body;           /* Function whose body is scanned */
+    unsigned            Brace;          /* Curly brace nesting */
+    unsigned            Paren;          /* Parenthesis nesting */
+    unsigned            ParenKind[OV_MAX_PARENS];
+    unsigned            LastParen;      /* Kind of the last closed parenthesis */
+    token_t             PrevTok;        /* Previous token */
+    ident               PrevIdent;      /* Previous token if identifier */
+    int                 PrevMember;     /* Identifier follows '.' or '->' */
+    int                 PrevSystem;     /* Identifier is from a system header */
+    int                 InAttr;         /* Within an attribute */
+    unsigned            AttrParen;      /* Parenthesis nesting of attribute */
+
+    /* Top level declaration */
+    OVFunc*             DeclFunc;       /* Declared function */
+    unsigned            DeclFlags;      /* OVF_STATIC and OVF_INTERRUPT */
+    int                 DeclSystem;     /* Function is from a system header */
+    int                 DeclInit;       /* In an initializer */
+    OVFunc*             LastFunc;       /* Last declared function for K&R */
+};
+
+/* All identifiers */
+static OVFunc*          Tab[OV_HASH_SIZE];
+static Collection       Entries = STATIC_COLLECTION_INITIALIZER;
+
+/* Nodes for unknown and library code. Unknown code includes the bodies that
+** could not be attributed to a function.
+*/
+static OVFunc*          Ext = 0;
+static OVFunc*          Lib = 0;
+
+/* Mark for graph searches */
+static unsigned         CurMark = 0;
+
+/* Name of the segment for the overlay area */
+static char*            BssName = 0;
+
+
+
+/*****************************************************************************/
+/*                              struct OVFunc                                */
+/*****************************************************************************/
+
+
+
+static OVFunc* NewOVFunc (const char* Name)
+/* Create a new entry, but don't add it to the hash table */
+{
+    unsigned Len = strlen (Name);
+    OVFunc*  F   = xmalloc (sizeof (OVFunc) + Len);
+
+    F->Next  = 0;
+    F->Flags = 0;
+    F->Mark  = 0;
+    InitCollection (&F->Callees);
+    InitCollection (&F->Succ);
+    InitCollection (&F->Active);
+    InitCollection (&F->Locals);
+    F->Func  = 0;
+    F->Size  = 0;
+    F->Offs  = 0;
+    memcpy (F->Name, Name, Len + 1);
+    CollAppend (&Entries, F);
+    return F;
+}
+
+
+
+static void FreeOVFunc (OVFunc* F)
+/* Free an entry */
+{
+    unsigned I;
+    for (I = 0; I < CollCount (&F->Locals); ++I) {
+        xfree (CollAtUnchecked (&F->Locals, I));
+    }
+    DoneCollection (&F->Callees);
+    DoneCollection (&F->Succ);
+    DoneCollection (&F->Active);
+    DoneCollection (&F->Locals);
+    xfree (F);
+}
+
+
+
+static OVFunc* FindFunc (const char* Name, int Create)
+/* Find the entry for an identifier. If there is none, create it if Create
+** is true, otherwise return NULL.
+*/
+{
+    unsigned Hash = HashStr (Name) % OV_HASH_SIZE;
+    OVFunc*  F    = Tab[Hash];
+    while (F) {
+        if (strcmp (F->Name, Name) == 0) {
+            return F;
+        }
+        F = F->Next;
+    }
+
+    if (Create) {
+        F = NewOVFunc (Name);
+        F->Next = Tab[Hash];
+        Tab[Hash] = F;
+    }
+    return F;
+}
+
+
+
+/*****************************************************************************/
+/*                                 Scanning                                  */
+/*****************************************************************************/
+
+
+
+static int IsSystemToken (const Token* T)
+/* Return true if the token comes from a system header */
+{
+    return T->LI != 0 && T->LI->File != 0 &&
+           GetInputFileType (T->LI->File->InputFile) == IT_SYSINC;
+}
+
+
+
+static void RecordDecl (OVScan* S)
+/* Record the function declared by the current top level declarator */
+{
+    if (S->DeclFunc) {
+        S->DeclFunc->Flags |= OVF_DECL | S->DeclFlags;
+        if (S->DeclSystem) {
+            S->DeclFunc->Flags |= OVF_SYSTEM;
+        }
+        S->LastFunc = S->DeclFunc;
+        S->DeclFunc = 0;
+    }
+    S->DeclInit = 0;
+}
+
+
+
+static void EndDecl (OVScan* S)
+/* End the current top level declaration */
+{
+    RecordDecl (S);
+    S->DeclFlags = 0;
+}
+
+
+
+static void StartBody (OVScan* S, OVFunc* F)
+/* Start the body of a function definition */
+{
+    if (F != Ext) {
+        F->Flags |= OVF_DEF;
+    }
+    S->Body = F;
+}
+
+
+
+static void UseIdent (OVScan* S, const Token* T)
+/* Handle the identifier in S->PrevIdent. T is the token following it. */
+{
+    OVFunc* F;
+
+    if (S->PrevMember) {
+        /* Struct member, may be a function pointer */
+        if (S->Body && T->Tok == TOK_LPAREN) {
+            S->Body->Flags |= OVF_CALLEXT;
+        }
+        return;
+    }
+
+    F = FindFunc (S->PrevIdent, 1);
+    if (S->Body) {
+        if (T->Tok == TOK_LPAREN) {
+            /* Called. Local function pointers with the name of a function
+            ** are not detected.
+            */
+            if (CollIndex (&S->Body->Callees, F) < 0) {
+                CollAppend (&S->Body->Callees, F);
+            }
+        } else {
+            F->Flags |= OVF_ADDR;
+        }
+    } else if (T->Tok == TOK_LPAREN && S->Brace == 0 &&
+               S->DeclFunc == 0 && !S->DeclInit) {
+        /* Function declarator */
+        S->DeclFunc   = F;
+        S->DeclSystem = S->PrevSystem;
+    } else {
+        /* Anything else including the names of parameters and of functions
+        ** used in initializers.
+        */
+        F->Flags |= OVF_ADDR;
+    }
+}
+
+
+
+static void StartParen (OVScan* S)
+/* Handle an opening parenthesis in a function body */
+{
+    unsigned Kind;
+
+    switch (S->PrevTok) {
+
+        case TOK_IDENT:
+            Kind = PK_CALL;
+            break;
+
+        case TOK_IF:
+        case TOK_WHILE:
+        case TOK_FOR:
+        case TOK_SWITCH:
+        case TOK_SIZEOF:
+        case TOK_PRAGMA:
+        case TOK_STATIC_ASSERT:
+        case TOK_ASM:
+            Kind = PK_KEYWORD;
+            break;
+
+        case TOK_RPAREN:
+            if (S->LastParen == PK_KEYWORD || S->LastParen == PK_CAST) {
+                Kind = PK_GROUP;
+                break;
+            }
+            /* FALLTHROUGH */
+
+        case TOK_RBRACK:
+            /* Call through a function pointer */
+            S->Body->Flags |= OVF_CALLEXT;
+            Kind = PK_CALL;
+            break;
+
+        default:
+            Kind = PK_GROUP;
+            break;
+    }
+
+    if (S->Paren < OV_MAX_PARENS) {
+        S->ParenKind[S->Paren] = Kind;
+    }
+}
+
+
+
+static int ScanToken (const Token* T, void* Data)
+/* Build the call graph from the tokens of the translation unit */
+{
+    OVScan* S = Data;
+
+    /* Handle a pending identifier */
+    if (S->PrevTok == TOK_IDENT && !S->InAttr) {
+        UseIdent (S, T);
+    }
+
+    /* Attributes of a top level declaration may mark interrupt handlers */
+    if (S->InAttr) {
+        if (T->Tok == TOK_LPAREN) {
+            ++S->Paren;
+            return 1;
+        } else if (S->Paren > S->AttrParen) {
+            if (T->Tok == TOK_RPAREN && --S->Paren == S->AttrParen) {
+                S->InAttr    = 0;
+                S->PrevTok   = TOK_RPAREN;
+                S->LastParen = PK_KEYWORD;
+            } else if (T->Tok == TOK_IDENT && S->Body == 0 &&
+                       (strcmp (T->Ident, "interrupt") == 0 ||
+                        strcmp (T->Ident, "__interrupt__") == 0)) {
+                S->DeclFlags |= OVF_INTERRUPT;
+            }
+            return 1;
+        }
+        /* No parenthesis after __attribute__ */
+        S->InAttr = 0;
+    }
+
+    switch (T->Tok) {
+
+        case TOK_IDENT:
+            strcpy (S->PrevIdent, T->Ident);
+            S->PrevMember = (S->PrevTok == TOK_DOT || S->PrevTok == TOK_PTR_REF);
+            S->PrevSystem = IsSystemToken (T);
+            break;
+
+        case TOK_ATTRIBUTE:
+            S->InAttr    = 1;
+            S->AttrParen = S->Paren;
+            return 1;
+
+        case TOK_ASM:
+            if (S->Body) {
+                S->Body->Flags |= OVF_ASM;
+            }
+            break;
+
+        case TOK_STATIC:
+            if (S->Brace == 0) {
+                S->DeclFlags |= OVF_STATIC;
+            }
+            break;
+
+        case TOK_LPAREN:
+            if (S->Body) {
+                StartParen (S);
+            }
+            ++S->Paren;
+            break;
+
+        case TOK_RPAREN:
+            if (S->Paren > 0) {
+                --S->Paren;
+                S->LastParen = PK_GROUP;
+                if (S->Body && S->Paren < OV_MAX_PARENS) {
+                    S->LastParen = S->ParenKind[S->Paren];
+                }
+            }
+            break;
+
+        case TOK_LCURLY:
+            if (S->Brace == 0 && S->Paren == 0 && !S->DeclInit) {
+                if (S->PrevTok == TOK_RPAREN && S->DeclFunc) {
+                    /* Function definition */
+                    OVFunc* F = S->DeclFunc;
+                    RecordDecl (S);
+                    StartBody (S, F);
+                } else if (S->PrevTok == TOK_SEMI && S->LastFunc) {
+                    /* Old style function definition */
+                    StartBody (S, S->LastFunc);
+                } else if (S->PrevTok == TOK_RPAREN || S->PrevTok == TOK_SEMI) {
+                    /* Some function that is handled as unknown code */
+                    StartBody (S, Ext);
+                }
+            }
+            ++S->Brace;
+            break;
+
+        case TOK_RCURLY:
+            if (S->Brace > 0 && --S->Brace == 0 && S->Body) {
+                S->Body = 0;
+                EndDecl (S);
+                S->PrevTok = TOK_SEMI;
+                return 1;
+            }
+            break;
+
+        case TOK_SEMI:
+            if (S->Brace == 0 && S->Paren == 0) {
+                EndDecl (S);
+            }
+            break;
+
+        case TOK_COMMA:
+            if (S->Brace == 0 && S->Paren == 0) {
+                RecordDecl (S);
+            }
+            break;
+
+        case TOK_ASSIGN:
+            if (S->Brace == 0 && S->Paren == 0) {
+                S->DeclInit = 1;
+            }
+            break;
+
+        default:
+            /* Check for a cast */
+            if (S->Body && S->PrevTok == TOK_LPAREN &&
+                S->Paren > 0 && S->Paren <= OV_MAX_PARENS &&
+                (TokIsType (T) || TokIsTypeQual (T))) {
+                S->ParenKind[S->Paren - 1] = PK_CAST;
+            }
+            break;
+    }
+
+    S->PrevTok = T->Tok;
+    return 1;
+}
+
+
+
+/*****************************************************************************/
+/*                                Call graph                                 */
+/*****************************************************************************/
+
+
+
+static void Visit (OVFunc* F)
+/* Mark all functions reachable from F including F itself */
+{
+    unsigned I;
+    if (F->Mark != CurMark) {
+        F->Mark = CurMark;
+        for (I = 0; I < CollCount (&F->Succ); ++I) {
+            Visit (CollAtUnchecked (&F->Succ, I));
+        }
+    }
+}
+
+
+
+static void VisitSucc (OVFunc* F)
+/* Mark all functions reachable from F by at least one call */
+{
+    unsigned I;
+    ++CurMark;
+    for (I = 0; I < CollCount (&F->Succ); ++I) {
+        Visit (CollAtUnchecked (&F->Succ, I));
+    }
+}
+
+
+
+static int IsNode (const OVFunc* F)
+/* Return true if F is a node of the call graph */
+{
+    return (F->Flags & OVF_DEF) != 0 || F == Ext || F == Lib;
+}
+
+
+
+static void BuildGraph (void)
+/* Resolve the calls and determine the overlay functions */
+{
+    unsigned I, J;
+
+    /* Resolve the calls */
+    for (I = 0; I < CollCount (&Entries); ++I) {
+        OVFunc* F = CollAtUnchecked (&Entries, I);
+        if (!IsNode (F)) {
+            continue;
+        }
+        for (J = 0; J < CollCount (&F->Callees); ++J) {
+            OVFunc* C = CollAtUnchecked (&F->Callees, J);
+            if (C->Flags & OVF_DEF) {
+                CollAppend (&F->Succ, C);
+            } else if (C->Flags & OVF_SYSTEM) {
+                F->Flags |= OVF_CALLLIB;
+            } else {
+                F->Flags |= OVF_CALLEXT;
+            }
+        }
+        if (F->Flags & OVF_CALLLIB) {
+            CollAppend (&F->Succ, Lib);
+        }
+        if (F->Flags & OVF_CALLEXT) {
+            CollAppend (&F->Succ, Ext);
+        }
+    }
+
+    /* Library code may call functions whose address is taken, unknown code
+    ** may call all functions that are visible outside.
+    */
+    for (I = 0; I < CollCount (&Entries); ++I) {
+        OVFunc* F = CollAtUnchecked (&Entries, I);
+        if ((F->Flags & OVF_DEF) == 0) {
+            continue;
+        }
+        if (F->Flags & OVF_ADDR) {
+            CollAppend (&Lib->Succ, F);
+        }
+        if ((F->Flags & OVF_ADDR) || (F->Flags & OVF_STATIC) == 0) {
+            CollAppend (&Ext->Succ, F);
+        }
+    }
+
+    /* Find the functions that may be reentered */
+    for (I = 0; I < CollCount (&Entries); ++I) {
+        OVFunc* F = CollAtUnchecked (&Entries, I);
+        if (F->Flags & OVF_DEF) {
+            VisitSucc (F);
+            if (F->Mark == CurMark) {
+                F->Flags |= OVF_REENTRANT;
+            }
+        }
+    }
+
+    /* Everything reachable from an interrupt handler may be reentered */
+    ++CurMark;
+    for (I = 0; I < CollCount (&Entries); ++I) {
+        OVFunc* F = CollAtUnchecked (&Entries, I);
+        if (F->Flags & OVF_INTERRUPT) {
+            Visit ((F->Flags & OVF_DEF)? F : Ext);
+        }
+    }
+    for (I = 0; I < CollCount (&Entries); ++I) {
+        OVFunc* F = CollAtUnchecked (&Entries, I);
+        if (F->Mark == CurMark) {
+            F->Flags |= OVF_REENTRANT;
+        }
+    }
+
+    /* Determine the overlay functions */
+    for (I = 0; I < CollCount (&Entries); ++I) {
+        OVFunc* F = CollAtUnchecked (&Entries, I);
+        if ((F->Flags & (OVF_DEF | OVF_REENTRANT | OVF_ASM)) == OVF_DEF) {
+            F->Flags |= OVF_OVERLAY;
+        }
+    }
+
+    /* Remember the overlay functions that may be active when another one is
+    ** called. Since none of them is reentrant, this relation is acyclic.
+    */
+    for (I = 0; I < CollCount (&Entries); ++I) {
+        OVFunc* F = CollAtUnchecked (&Entries, I);
+        if ((F->Flags & OVF_OVERLAY) == 0) {
+            continue;
+        }
+        VisitSucc (F);
+        for (J = 0; J < CollCount (&Entries); ++J) {
+            OVFunc* G = CollAtUnchecked (&Entries, J);
+            if ((G->Flags & OVF_OVERLAY) != 0 && G->Mark == CurMark) {
+                CollAppend (&G->Active, F);
+            }
+        }
+    }
+}
+
+
+
+static int CmpActive (void* Data attribute ((unused)),
+                      const void* Left, const void* Right)
+/* Compare function for sorting the overlay functions, so that every function
+** follows the functions that may be active when it is called.
+*/
+{
+    return (int) CollCount (&((const OVFunc*) Left)->Active) -
+           (int) CollCount (&((const OVFunc*) Right)->Active);
+}
+
+
+
+/*****************************************************************************/
+/*                                   Code                                    */
+/*****************************************************************************/
+
+
+
+void ScanCallGraph (void)
+/* Scan the translation unit ahead starting with NextTok, build the call
+** graph and determine the functions whose locals may be placed into the
+** overlay area.
+*/
+{
+    OVScan S;
+
+    Ext = NewOVFunc ("");
+    Lib = NewOVFunc ("");
+
+    /* Use the BSS segment in effect at the start of the translation unit */
+    BssName = xstrdup (GetSegName (SEG_BSS));
+
+    memset (&S, 0, sizeof (S));
+    S.PrevTok = TOK_SEMI;
+
+    /* Scan the tokens up to the end of input */
+    LookAhead (ScanToken, &S);
+
+    BuildGraph ();
+}
+
+
+
+int OV_IsOverlayFunc (const char* Name)
+/* Return true if the locals of the function with the given name may be
+** placed into the overlay area.
+*/
+{
+    const OVFunc* F = FindFunc (Name, 0);
+    return F != 0 && (F->Flags & OVF_OVERLAY) != 0;
+}
+
+
+
+void OV_AddLocal (SymEntry* Func, unsigned DataLabel, unsigned Size)
+/* Reserve Size bytes in the overlay area for a local of the given function
+** and use DataLabel for it.
+*/
+{
+    OVFunc*  F = FindFunc (Func->Name, 0);
+    OVLocal* L = xmalloc (sizeof (OVLocal));
+
+    PRECONDITION (F != 0 && (F->Flags & OVF_OVERLAY) != 0);
+
+    L->Label = DataLabel;
+    L->Offs  = F->Size;
+    CollAppend (&F->Locals, L);
+    F->Size += Size;
+    F->Func  = Func;
+}
+
+
+
+void OutputOverlay (void)
+/* Place the locals of the functions into the overlay area and emit it */
+{
+    Collection Funcs = AUTO_COLLECTION_INITIALIZER;
+    unsigned   Size = 0;
+    unsigned   Label;
+    unsigned   I, J;
+
+    /* Get the functions with locals in the overlay area */
+    for (I = 0; I < CollCount (&Entries); ++I) {
+        OVFunc* F = CollAtUnchecked (&Entries, I);
+        if (F->Size > 0) {
+            CollAppend (&Funcs, F);
+        }
+    }
+
+    /* Place the locals of each function after those of the functions that
+    ** may be active when it is called.
+    */
+    CollSort (&Funcs, CmpActive, 0);
+    for (I = 0; I < CollCount (&Funcs); ++I) {
+        OVFunc* F = CollAtUnchecked (&Funcs, I);
+        for (J = 0; J < CollCount (&F->Active); ++J) {
+            const OVFunc* G = CollConstAt (&F->Active, J);
+            if (G->Offs + G->Size > F->Offs) {
+                F->Offs = G->Offs + G->Size;
+            }
+        }
+        if (F->Offs + F->Size > Size) {
+            Size = F->Offs + F->Size;
+        }
+    }
+
+    if (Size > 0) {
+        /* Define the labels of the locals in the functions */
+        Label = GetPooledLiteralLabel ();
+        for (I = 0; I < CollCount (&Funcs); ++I) {
+            OVFunc* F = CollAtUnchecked (&Funcs, I);
+            if (!SymIsOutputFunc (F->Func)) {
+                continue;
+            }
+            for (J = 0; J < CollCount (&F->Locals); ++J) {
+                const OVLocal* L = CollConstAt (&F->Locals, J);
+                DS_AddLine (F->Func->V.F.Seg->BSS, "%s\t:=\t%s+%u",
+                            LocalDataLabelName (L->Label),
+                            PooledLiteralLabelName (Label),
+                            F->Offs + L->Offs);
+            }
+        }
+
+        /* Reserve the overlay area */
+        if (strcmp (GetSegName (SEG_BSS), BssName) != 0) {
+            SetSegName (SEG_BSS, BssName);
+            g_segname (SEG_BSS);
+        }
+        g_usebss ();
+        g_defliterallabel (Label);
+        g_res (Size);
+    }
+
+    DoneCollection (&Funcs);
+}
+
+
+
+void DoneCallGraph (void)
+/* Free the call graph */
+{
+    unsigned I;
+    for (I = 0; I < CollCount (&Entries); ++I) {
+        FreeOVFunc (CollAtUnchecked (&Entries, I));
+    }
+    CollDeleteAll (&Entries);
+    memset (Tab, 0, sizeof (Tab));
+    Ext = Lib = 0;
+    xfree (BssName);
+    BssName = 0;
+}
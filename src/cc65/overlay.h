@@ -0,0 +1,99 @@
+/*****************************************************************************/
+/*                                                                           */
+/*                                 overlay.h                                 */
+/*                                                                           */
+/*       Placement of the locals of non-reentrant functions into memory      */
+/*                                                                           */
+/*                                                                           */
+/*                                                                           */
+/* Copyright 2026 The cc65 Authors                                           */
+/*                                                                           */
+/*                                                                           */
+/* This software is provided 'as-is', without any expressed or implied       */
+/* warranty.  In no event will the authors be held liable for any damages    */
+/* arising from the use of this software.                                    */
+/*                                                                           */
+/* Permission is granted to anyone to use this software for any purpose,     */
+/* including commercial applications, and to alter it and redistribute it    */
+/* freely, subject to the following restrictions:                            */
+/*                                                                           */
+/* 1. The origin of this software must not be misrepresented; you must not   */
+/*    claim that you wrote the original software. If you use this software   */
+/*    in a product, an acknowledgment in the product documentation would be  */
+/*    appreciated but is not required.                                       */
+/* 2. Altered source versions must be plainly marked as such, and must not   */
+/*    be misrepresented as being the original software.                      */
+/* 3. This notice may not be removed or altered from any source              */
+/*    distribution.                                                          */
+/*                                                                           */
+/*****************************************************************************/
+
+
+
+/* With --auto-static-locals, the auto variables of functions that cannot be
+** reentered are placed into static memory instead of onto the stack, as
+** with --static-locals. Since the compiler translates a function in one
+** pass, the whole translation unit is scanned ahead before the first
+** declaration is parsed, and the call graph of the functions defined in it
+** is built from the tokens.
+**
+** Calls of functions that are declared in system headers but not defined
+** are assumed to call back into the translation unit only through function
+** pointers, so they may reach any function whose address is taken. Calls of
+** other unknown functions and calls through pointers may reach any function
+** that is not static as well. A function may be reentered if it can reach
+** itself in this graph. Functions that are declared with the "interrupt"
+** attribute may be called from an interrupt handler, so they and all
+** functions they reach are left alone, too.
+**
+** Two functions whose calls cannot be active at the same time may use the
+** same memory for their locals. So the locals of all handled functions are
+** placed into one overlay area at the end of the translation unit, where
+** each function follows the functions that may be active when it is called.
+*/
+
+
+
+#ifndef OVERLAY_H
+#define OVERLAY_H
+
+
+
+/* cc65 */
+#include "symentry.h"
+
+
+
+/*****************************************************************************/
+/*                                   Code                                    */
+/*****************************************************************************/
+
+
+
+void ScanCallGraph (void);
+/* Scan the translation unit ahead starting with NextTok, build the call
+** graph and determine the functions whose locals may be placed into the
+** overlay area.
+*/
+
+int OV_IsOverlayFunc (const char* Name);
+/* Return true if the locals of the function with the given name may be
+** placed into the overlay area.
+*/
+
+void OV_AddLocal (SymEntry* Func, unsigned DataLabel, unsigned Size);
+/* Reserve Size bytes in the overlay area for a local of the given function
+** and use DataLabel for it.
+*/
+
+void OutputOverlay (void);
+/* Place the locals of the functions into the overlay area and emit it */
+
+void DoneCallGraph (void);
+/* Free the call graph */
+
+
+
+/* End of overlay.h */
+
+#endif
@@ -0,0 +1,660 @@
+/*****************************************************************************/
+/*                                                                           */
+/*                                   pch.c                                   */
+/*                                                                           */
+/*                            Precompiled headers                            */
+/*                                                                           */
+/*                                                                           */
+/*                                                                           */
+/* Copyright 2026 The cc65 Authors                                           */
+/*                                                                           */
+/*                                                                           */
+/* This software is provided 'as-is', without any expressed or implied       */
+/* warranty.  In no event will the authors be held liable for any damages    */
+/* arising from the use of this software.                                    */
+/*                                                                           */
+/* Permission is granted to anyone to use this software for any purpose,     */
+/* including commercial applications, and to alter it and redistribute it    */
+/* freely, subject to the following restrictions:                            */
+/*                                                                           */
+/* 1. The origin of this software must not be misrepresented; you must not   */
+/*    claim that you wrote the original software. If you use this software   */
+/*    in a product, an acknowledgment in the product documentation would be  */
+/*    appreciated but is not required.                                       */
+/* 2. Altered source versions must be plainly marked as such, and must not   */
+/*    be misrepresented as being the original software.                      */
+/* 3. This notice may not be removed or altered from any source              */
+/*    distribution.                                                          */
+/*                                                                           */
+/*****************************************************************************/
+
+
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+
+/* common */
+#include "chartype.h"
+#include "coll.h"
+#include "filestat.h"
+#include "print.h"
+#include "strbuf.h"
+#include "version.h"
+#include "xmalloc.h"
+
+/* cc65 */
+#include "error.h"
+#include "global.h"
+#include "incpath.h"
+#include "input.h"
+#include "macrotab.h"
+#include "pch.h"
+
+
+
+/*****************************************************************************/
+/*                                   Data                                    */
+/*****************************************************************************/
+
+
+
+/* First line of a precompiled header */
+static const char PchMagic[] = "cc65 precompiled header\n";
+
+/* Classification of the lines at the start of the main file */
+typedef enum {
+    PL_BLANK,                   /* Empty or only comments */
+    PL_INCLUDE,                 /* #include directive */
+    PL_OTHER                    /* Anything else, ends the prefix */
+} plinetype_t;
+
+/* Everything that must be unchanged to use a precompiled header */
+static StrBuf Key = STATIC_STRBUF_INITIALIZER;
+
+/* Preprocessed text of the header prefix while it is recorded */
+static StrBuf Text = STATIC_STRBUF_INITIALIZER;
+
+
+
+/*****************************************************************************/
+/*                              Header prefix                                */
+/*****************************************************************************/
+
+
+
+static plinetype_t ClassifyLine (const char* L, int* InComment)
+/* Classify a line of the main file. InComment tells if the line starts within
+** a block comment and is updated for the next line.
+*/
+{
+    int Include = 0;
+
+    while (*L) {
+        if (*InComment) {
+            if (L[0] == '*' && L[1] == '/') {
+                *InComment = 0;
+                L += 2;
+            } else {
+                ++L;
+            }
+        } else if (IsSpace (*L)) {
+            ++L;
+        } else if (L[0] == '/' && L[1] == '*') {
+            *InComment = 1;
+            L += 2;
+        } else if (L[0] == '/' && L[1] == '/') {
+            break;
+        } else if (!Include && *L == '#') {
+            /* Must be an #include directive */
+            ++L;
+            while (IsBlank (*L)) {
+                ++L;
+            }
+            if (strncmp (L, "include", 7) != 0 ||
+                IsAlNum (L[7]) || L[7] == '_') {
+                return PL_OTHER;
+            }
+            L += 7;
+            Include = 1;
+        } else if (Include && (*L == '\"' || *L == '<')) {
+            /* Skip the header name, it may contain comment characters */
+            L = strchr (L + 1, (*L == '\"')? '\"' : '>');
+            if (L == 0) {
+                return PL_OTHER;
+            }
+            ++L;
+        } else if (Include) {
+            /* Macro that expands to the header name */
+            ++L;
+        } else {
+            return PL_OTHER;
+        }
+    }
+
+    return Include? PL_INCLUDE : PL_BLANK;
+}
+
+
+
+static unsigned ScanPrefix (const char* FileName, StrBuf* Prefix)
+/* Determine the header prefix of the main file. It ends with the last #include
+** before anything else than #include directives, comments and white space.
+** Return the number of lines in the prefix and place its text into Prefix.
+*/
+{
+    StrBuf   L         = AUTO_STRBUF_INITIALIZER;
+    unsigned LineNum   = 0;
+    unsigned Lines     = 0;
+    unsigned PrefixLen = 0;
+    int      InComment = 0;
+    int      C;
+
+    /* Open the file */
+    FILE* F = fopen (FileName, "r");
+    if (F == 0) {
+        return 0;
+    }
+
+    /* Read lines until the prefix ends */
+    SB_Clear (Prefix);
+    while ((C = getc (F)) != EOF) {
+
+        plinetype_t Type;
+
+        /* Collect the line, skip embedded NULs like the input module */
+        if (C != '\n') {
+            if (C != '\0') {
+                SB_AppendChar (&L, C);
+            }
+            continue;
+        }
+        ++LineNum;
+        if (SB_LookAtLast (&L) == '\r') {
+            SB_Drop (&L, 1);
+        }
+        SB_Terminate (&L);
+
+        /* Continued lines are not part of the prefix */
+        if (SB_LookAtLast (&L) == '\\') {
+            break;
+        }
+        Type = ClassifyLine (SB_GetConstBuf (&L), &InComment);
+        if (Type == PL_OTHER) {
+            break;
+        }
+        SB_Append (Prefix, &L);
+        SB_AppendChar (Prefix, '\n');
+
+        /* The prefix may only end with an #include that isn't followed by
+        ** the start of a block comment.
+        */
+        if (Type == PL_INCLUDE && !InComment) {
+            Lines     = LineNum;
+            PrefixLen = SB_GetLen (Prefix);
+        }
+        SB_Clear (&L);
+    }
+    SB_Cut (Prefix, PrefixLen);
+
+    /* Close the file, we're just reading so no error check */
+    fclose (F);
+    SB_Done (&L);
+
+    return Lines;
+}
+
+
+
+/*****************************************************************************/
+/*                               Serialization                               */
+/*****************************************************************************/
+
+
+
+static void PutNum (StrBuf* B, unsigned long N)
+/* Add a number to B */
+{
+    char Buf[32];
+    sprintf (Buf, "%lu\n", N);
+    SB_AppendStr (B, Buf);
+}
+
+
+
+static void PutBuf (StrBuf* B, const char* S, unsigned Len)
+/* Add a string with the given length to B */
+{
+    PutNum (B, Len);
+    SB_AppendBuf (B, S, Len);
+    SB_AppendChar (B, '\n');
+}
+
+
+
+static void PutStr (StrBuf* B, const char* S)
+/* Add a string to B */
+{
+    PutBuf (B, S, strlen (S));
+}
+
+
+
+static int GetNum (StrBuf* B, unsigned long* N)
+/* Read a number from B. Return true if successful. */
+{
+    unsigned Digits = 0;
+
+    *N = 0;
+    while (IsDigit (SB_Peek (B))) {
+        *N = *N * 10 + (SB_Get (B) - '0');
+        ++Digits;
+    }
+    return Digits > 0 && SB_Get (B) == '\n';
+}
+
+
+
+static int GetStr (StrBuf* B, StrBuf* S)
+/* Read a string from B into S. Return true if successful. */
+{
+    unsigned long Len;
+
+    if (!GetNum (B, &Len) || Len >= SB_GetLen (B) - SB_GetIndex (B)) {
+        return 0;
+    }
+    SB_CopyBuf (S, SB_GetConstBuf (B) + SB_GetIndex (B), Len);
+    SB_Terminate (S);
+    SB_SkipMultiple (B, Len);
+    return SB_Get (B) == '\n';
+}
+
+
+
+static int IsTimeMacro (const char* Name)
+/* Return true if Name is __DATE__ or __TIME__. They change with every run of
+** the compiler, so they aren't part of a precompiled header.
+*/
+{
+    return strcmp (Name, "__DATE__") == 0 || strcmp (Name, "__TIME__") == 0;
+}
+
+
+
+static void PutMacros (StrBuf* B)
+/* Add all macros except __DATE__ and __TIME__ to B */
+{
+    Collection Macros = AUTO_COLLECTION_INITIALIZER;
+    unsigned   Count  = 0;
+    unsigned   I, J;
+
+    CollectMacros (&Macros);
+    for (I = 0; I < CollCount (&Macros); ++I) {
+        const Macro* M = CollConstAt (&Macros, I);
+        if (!IsTimeMacro (M->Name)) {
+            ++Count;
+        }
+    }
+
+    PutNum (B, Count);
+    for (I = 0; I < CollCount (&Macros); ++I) {
+        const Macro* M = CollConstAt (&Macros, I);
+        if (IsTimeMacro (M->Name)) {
+            continue;
+        }
+        PutStr (B, M->Name);
+        PutNum (B, M->ParamCount + 1);
+        for (J = 0; J < CollCount (&M->Params); ++J) {
+            PutStr (B, CollConstAt (&M->Params, J));
+        }
+        PutNum (B, M->Variadic);
+        PutBuf (B, SB_GetConstBuf (&M->Replacement), SB_GetLen (&M->Replacement));
+    }
+
+    DoneCollection (&Macros);
+}
+
+
+
+static Macro* GetMacro (StrBuf* B)
+/* Read a macro from B. Return NULL in case of errors. */
+{
+    StrBuf        S = AUTO_STRBUF_INITIALIZER;
+    Macro*        M;
+    unsigned long ParamCount;
+    unsigned long Variadic;
+    unsigned long I;
+    int           Ok;
+
+    if (!GetStr (B, &S)) {
+        SB_Done (&S);
+        return 0;
+    }
+    M = NewMacro (SB_GetConstBuf (&S));
+
+    Ok = GetNum (B, &ParamCount);
+    for (I = 1; Ok && I < ParamCount; ++I) {
+        Ok = GetStr (B, &S);
+        if (Ok) {
+            CollAppend (&M->Params, xstrdup (SB_GetConstBuf (&S)));
+        }
+    }
+    Ok = Ok && GetNum (B, &Variadic) && GetStr (B, &M->Replacement);
+    SB_Done (&S);
+
+    if (!Ok) {
+        FreeMacro (M);
+        return 0;
+    }
+    M->ParamCount = (int) ParamCount - 1;
+    M->Variadic   = (unsigned char) Variadic;
+    return M;
+}
+
+
+
+static void PutSearchPath (StrBuf* B, SearchPaths* P)
+/* Add a search path list to B */
+{
+    unsigned I;
+
+    PutNum (B, CollCount (P));
+    for (I = 0; I < CollCount (P); ++I) {
+        PutStr (B, GetSearchPath (P, I));
+    }
+}
+
+
+
+static void MakeKey (const StrBuf* Prefix)
+/* Create the key for the header prefix of the main file */
+{
+    SB_Clear (&Key);
+    PutStr (&Key, GetVersionAsString ());
+    PutSearchPath (&Key, SysIncSearchPath);
+    PutSearchPath (&Key, UsrIncSearchPath);
+    PutMacros (&Key);
+    PutBuf (&Key, SB_GetConstBuf (Prefix), SB_GetLen (Prefix));
+}
+
+
+
+static void PutState (StrBuf* B)
+/* Add the state after the header prefix to B */
+{
+    unsigned Count = GetInputFileCount ();
+    unsigned I;
+
+    /* The input files except for the main file */
+    PutNum (B, Count - 1);
+    for (I = 1; I < Count; ++I) {
+        InputFileInfo Info;
+        GetInputFileInfo (I, &Info);
+        PutStr (B, Info.Name);
+        PutNum (B, Info.Type);
+        PutNum (B, Info.Size);
+        PutNum (B, Info.MTime);
+        PutNum (B, Info.Once);
+        PutStr (B, Info.Guard? Info.Guard : "");
+    }
+
+    /* The __COUNTER__ value and the macros */
+    PutNum (B, PeekCurrentCounter ());
+    PutMacros (B);
+}
+
+
+
+static void UndefineMacros (void)
+/* Remove all macros except __DATE__ and __TIME__ from the macro table */
+{
+    Collection Macros = AUTO_COLLECTION_INITIALIZER;
+    unsigned   I;
+
+    CollectMacros (&Macros);
+    for (I = 0; I < CollCount (&Macros); ++I) {
+        const Macro* M = CollConstAt (&Macros, I);
+        if (!IsTimeMacro (M->Name)) {
+            UndefineMacro (M->Name);
+        }
+    }
+    DoneCollection (&Macros);
+}
+
+
+
+static int GetState (StrBuf* B, int Apply)
+/* Read the state after the header prefix from B. If Apply is false, just
+** check that it is valid and that none of the input files has changed.
+** Otherwise add the input files and replace the macro table. Return true if
+** successful.
+*/
+{
+    StrBuf        Name  = AUTO_STRBUF_INITIALIZER;
+    StrBuf        Guard = AUTO_STRBUF_INITIALIZER;
+    unsigned long Count, Type, Size, MTime, Once, Counter;
+    int           Ok;
+
+    SB_Reset (B);
+
+    /* The input files */
+    Ok = GetNum (B, &Count);
+    while (Ok && Count-- > 0) {
+        Ok = GetStr (B, &Name)   &&
+             GetNum (B, &Type)   &&
+             GetNum (B, &Size)   &&
+             GetNum (B, &MTime)  &&
+             GetNum (B, &Once)   &&
+             GetStr (B, &Guard);
+        if (Ok && Apply) {
+            InputFileInfo Info;
+            Info.Name  = SB_GetConstBuf (&Name);
+            Info.Type  = (InputType) Type;
+            Info.Size  = Size;
+            Info.MTime = MTime;
+            Info.Once  = (int) Once;
+            Info.Guard = SB_IsEmpty (&Guard)? 0 : SB_GetConstBuf (&Guard);
+            AddInputFile (&Info);
+        } else if (Ok) {
+            struct stat Buf;
+            Ok = FileStat (SB_GetConstBuf (&Name), &Buf) == 0 &&
+                 (unsigned long) Buf.st_size  == Size         &&
+                 (unsigned long) Buf.st_mtime == MTime;
+        }
+    }
+
+    /* The __COUNTER__ value */
+    Ok = Ok && GetNum (B, &Counter);
+    if (Ok && Apply) {
+        SetCurrentCounter ((unsigned) Counter);
+        UndefineMacros ();
+    }
+
+    /* The macros */
+    Ok = Ok && GetNum (B, &Count);
+    while (Ok && Count-- > 0) {
+        Macro* M = GetMacro (B);
+        if (M == 0) {
+            Ok = 0;
+        } else if (Apply) {
+            InsertMacro (M);
+        } else {
+            FreeMacro (M);
+        }
+    }
+
+    SB_Done (&Name);
+    SB_Done (&Guard);
+
+    return Ok && SB_GetIndex (B) == SB_GetLen (B);
+}
+
+
+
+/*****************************************************************************/
+/*                                   Files                                   */
+/*****************************************************************************/
+
+
+
+static void WriteSection (FILE* F, const StrBuf* B)
+/* Write a section of a precompiled header */
+{
+    fprintf (F, "%u\n", SB_GetLen (B));
+    fwrite (SB_GetConstBuf (B), 1, SB_GetLen (B), F);
+    fputc ('\n', F);
+}
+
+
+
+static int ReadSection (FILE* F, StrBuf* B)
+/* Read a section of a precompiled header into B. Return true if successful. */
+{
+    char          Buf[4096];
+    unsigned long Len    = 0;
+    unsigned      Digits = 0;
+    int           C;
+
+    while ((C = getc (F)) != EOF && IsDigit ((char) C)) {
+        Len = Len * 10 + (C - '0');
+        ++Digits;
+    }
+    if (Digits == 0 || C != '\n') {
+        return 0;
+    }
+
+    SB_Clear (B);
+    while (Len > 0) {
+        size_t Count = fread (Buf, 1, (Len < sizeof (Buf))? Len : sizeof (Buf), F);
+        if (Count == 0) {
+            return 0;
+        }
+        SB_AppendBuf (B, Buf, Count);
+        Len -= Count;
+    }
+    SB_Terminate (B);
+
+    return getc (F) == '\n';
+}
+
+
+
+static int LoadPrecompiledHeader (FILE* F, unsigned Lines)
+/* Use the precompiled header in F if it matches. Return true if it was used,
+** F is then owned by the input module.
+*/
+{
+    char   Magic[sizeof (PchMagic)];
+    StrBuf B  = AUTO_STRBUF_INITIALIZER;
+
+    int Ok = fgets (Magic, sizeof (Magic), F) != 0      &&
+             strcmp (Magic, PchMagic) == 0              &&
+             ReadSection (F, &B)                        &&
+             SB_Compare (&B, &Key) == 0                 &&
+             ReadSection (F, &B)                        &&
+             GetState (&B, 0);
+
+    if (Ok) {
+        /* Restore the state */
+        GetState (&B, 1);
+
+        /* Skip the prefix in the main file and read the preprocessed text
+        ** instead, which is the rest of the file.
+        */
+        while (Lines-- > 0) {
+            NextLine ();
+        }
+        ClearLine ();
+        OpenPrecompiledFile (F);
+    }
+
+    SB_Done (&B);
+    return Ok;
+}
+
+
+
+/*****************************************************************************/
+/*                                   Code                                    */
+/*****************************************************************************/
+
+
+
+void InitPrecompiledHeader (const char* FileName)
+/* Load the precompiled header if it matches the header prefix of the main
+** file with the given name. Otherwise, arrange for it to be written when the
+** prefix was read. Must be called after the main file was opened.
+*/
+{
+    StrBuf      Prefix = AUTO_STRBUF_INITIALIZER;
+    const char* Name   = SB_GetConstBuf (&PchName);
+    unsigned    Lines;
+    FILE*       F;
+
+    /* Determine the header prefix */
+    Lines = ScanPrefix (FileName, &Prefix);
+    if (Lines == 0) {
+        Print (stdout, 1, "No header prefix in '%s'\n", FileName);
+        SB_Done (&Prefix);
+        return;
+    }
+    MakeKey (&Prefix);
+    SB_Done (&Prefix);
+
+    /* Use the precompiled header if it matches */
+    F = fopen (Name, "r");
+    if (F != 0) {
+        if (LoadPrecompiledHeader (F, Lines)) {
+            Print (stdout, 1, "Using precompiled header '%s'\n", Name);
+            return;
+        }
+        fclose (F);
+        Print (stdout, 1, "Precompiled header '%s' is out of date\n", Name);
+    }
+
+    /* Otherwise record the preprocessed text of the prefix */
+    SB_Clear (&Text);
+    RecordHeaderPrefix (Lines, &Text);
+}
+
+
+
+void EndHeaderPrefix (void)
+/* Called by the input module when the end of the recorded header prefix is
+** reached. Writes the precompiled header.
+*/
+{
+    StrBuf      State = AUTO_STRBUF_INITIALIZER;
+    const char* Name  = SB_GetConstBuf (&PchName);
+    FILE*       F;
+
+    /* Don't write a precompiled header for a prefix with errors or warnings.
+    ** They are not stored, so they would get lost when it is used.
+    */
+    if (PPErrorCount > 0 || ErrorCount > 0 ||
+        PPWarningCount > 0 || WarningCount > 0) {
+        SB_Clear (&Text);
+        return;
+    }
+
+    /* Get the state after the prefix */
+    PutState (&State);
+
+    /* Write the file */
+    F = fopen (Name, "w");
+    if (F == 0) {
+        Fatal ("Cannot open precompiled header '%s': %s", Name, strerror (errno));
+    }
+    fputs (PchMagic, F);
+    WriteSection (F, &Key);
+    WriteSection (F, &State);
+    fwrite (SB_GetConstBuf (&Text), 1, SB_GetLen (&Text), F);
+    if (fclose (F) != 0) {
+        remove (Name);
+        Fatal ("Cannot write to precompiled header '%s' (disk full?)", Name);
+    }
+    Print (stdout, 1, "Wrote precompiled header '%s'\n", Name);
+
+    SB_Done (&State);
+    SB_Clear (&Text);
+}
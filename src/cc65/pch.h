@@ -0,0 +1,77 @@
+/*****************************************************************************/
+/*                                                                           */
+/*                                   pch.h                                   */
+/*                                                                           */
+/*                            Precompiled headers                            */
+/*                                                                           */
+/*                                                                           */
+/*                                                                           */
+/* Copyright 2026 The cc65 Authors                                           */
+/*                                                                           */
+/*                                                                           */
+/* This software is provided 'as-is', without any expressed or implied       */
+/* warranty.  In no event will the authors be held liable for any damages    */
+/* arising from the use of this software.                                    */
+/*                                                                           */
+/* Permission is granted to anyone to use this software for any purpose,     */
+/* including commercial applications, and to alter it and redistribute it    */
+/* freely, subject to the following restrictions:                            */
+/*                                                                           */
+/* 1. The origin of this software must not be misrepresented; you must not   */
+/*    claim that you wrote the original software. If you use this software   */
+/*    in a product, an acknowledgment in the product documentation would be  */
+/*    appreciated but is not required.                                       */
+/* 2. Altered source versions must be plainly marked as such, and must not   */
+/*    be misrepresented as being the original software.                      */
+/* 3. This notice may not be removed or altered from any source              */
+/*    distribution.                                                          */
+/*                                                                           */
+/*****************************************************************************/
+
+
+
+/* With --pch, the compiler keeps the result of the header prefix of the main
+** file in a cache file. The header prefix are the leading lines of the file
+** that contain only #include directives, comments and white space. When the
+** cache file matches, the macro table, the input file list and the fully
+** preprocessed text of the prefix are loaded from it, and the compiler reads
+** this text instead of searching, reading and preprocessing the headers
+** again. Declarations and pragmas are taken from the preprocessed text, so
+** the symbol table and the pragma state end up as without the cache. If the
+** cache doesn't match, it is written when the end of the prefix is reached.
+**
+** The cache is only used if the compiler version, the include paths, the
+** macros defined before the main file is read (by the command line, the
+** target, the CPU and the options), the text of the prefix, and the size and
+** modification time of all headers read by the prefix are unchanged.
+*/
+
+
+
+#ifndef PCH_H
+#define PCH_H
+
+
+
+/*****************************************************************************/
+/*                                   Code                                    */
+/*****************************************************************************/
+
+
+
+void InitPrecompiledHeader (const char* FileName);
+/* Load the precompiled header if it matches the header prefix of the main
+** file with the given name. Otherwise, arrange for it to be written when the
+** prefix was read. Must be called after the main file was opened.
+*/
+
+void EndHeaderPrefix (void);
+/* Called by the input module when the end of the recorded header prefix is
+** reached. Writes the precompiled header.
+*/
+
+
+
+/* End of pch.h */
+
+#endif
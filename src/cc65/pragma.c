@@ -51,6 +51,7 @@
 #include "scanner.h"
 #include "scanstrbuf.h"
 #include "symtab.h"
+#include "unused.h"
 #include "pragma.h"
 #include "wrappedcall.h"
 
@@ -67,16 +68,20 @@ typedef enum {
     PRAGMA_ILLEGAL = -1,
     PRAGMA_ALIGN,
     PRAGMA_ALLOW_EAGER_INLINE,
+    PRAGMA_AUTO_REGISTER_VARS,
     PRAGMA_BSS_NAME,
     PRAGMA_CHARMAP,
     PRAGMA_CHECK_STACK,
     PRAGMA_CODE_NAME,
     PRAGMA_CODESIZE,
+    PRAGMA_CYCLE_WEIGHT,
     PRAGMA_DATA_NAME,
+    PRAGMA_INLINE_FUNCS,
     PRAGMA_INLINE_STDFUNCS,
     PRAGMA_LOCAL_STRINGS,
     PRAGMA_LONGCRT,
     PRAGMA_MESSAGE,
+    PRAGMA_NARROW_LOOP_VARS,
     PRAGMA_OPTIMIZE,
     PRAGMA_REGISTER_VARS,
     PRAGMA_REGVARADDR,
@@ -97,6 +102,8 @@ static const struct Pragma {
     { "align",                  PRAGMA_ALIGN              },
     { "allow-eager-inline",     PRAGMA_ALLOW_EAGER_INLINE },
     { "allow_eager_inline",     PRAGMA_ALLOW_EAGER_INLINE },
+    { "auto-register-vars",     PRAGMA_AUTO_REGISTER_VARS },
+    { "auto_register_vars",     PRAGMA_AUTO_REGISTER_VARS },
     { "bss-name",               PRAGMA_BSS_NAME           },
     { "bss_name",               PRAGMA_BSS_NAME           },
     { "charmap",                PRAGMA_CHARMAP            },
@@ -105,14 +112,20 @@ static const struct Pragma {
     { "code-name",              PRAGMA_CODE_NAME          },
     { "code_name",              PRAGMA_CODE_NAME          },
     { "codesize",               PRAGMA_CODESIZE           },
+    { "cycle-weight",           PRAGMA_CYCLE_WEIGHT       },
+    { "cycle_weight",           PRAGMA_CYCLE_WEIGHT       },
     { "data-name",              PRAGMA_DATA_NAME          },
     { "data_name",              PRAGMA_DATA_NAME          },
+    { "inline-funcs",           PRAGMA_INLINE_FUNCS       },
     { "inline-stdfuncs",        PRAGMA_INLINE_STDFUNCS    },
+    { "inline_funcs",           PRAGMA_INLINE_FUNCS       },
     { "inline_stdfuncs",        PRAGMA_INLINE_STDFUNCS    },
     { "local-strings",          PRAGMA_LOCAL_STRINGS      },
     { "local_strings",          PRAGMA_LOCAL_STRINGS      },
     { "longcrt",                PRAGMA_LONGCRT            },
     { "message",                PRAGMA_MESSAGE            },
+    { "narrow-loop-vars",       PRAGMA_NARROW_LOOP_VARS   },
+    { "narrow_loop_vars",       PRAGMA_NARROW_LOOP_VARS   },
     { "optimize",               PRAGMA_OPTIMIZE           },
     { "register-vars",          PRAGMA_REGISTER_VARS      },
     { "register_vars",          PRAGMA_REGISTER_VARS      },
@@ -629,6 +642,7 @@ static void WrappedCallPragma (pragma_scope_t Scope, StrBuf* B)
 
         PushWrappedCall(Entry, (unsigned int) Val);
         Entry->Flags |= SC_REF;
+        AddSymRoot (Entry);
         GetFuncDesc (Entry->Type)->Flags |= FD_CALL_WRAPPER;
 
     } else {
@@ -928,6 +942,11 @@ static void ParsePragmaString (void)
             FlagPragma (PES_STMT, Pragma, &B, &EagerlyInlineFuncs);
             break;
 
+        case PRAGMA_AUTO_REGISTER_VARS:
+            /* TODO: PES_STMT or even PES_EXPR (PES_DECL) maybe? */
+            FlagPragma (PES_FUNC, Pragma, &B, &AutoRegVars);
+            break;
+
         case PRAGMA_BSS_NAME:
             /* TODO: PES_STMT or even PES_EXPR (PES_DECL) maybe? */
             SegNamePragma (PES_FUNC, PRAGMA_BSS_NAME, &B);
@@ -952,11 +971,19 @@ static void ParsePragmaString (void)
             IntPragma (PES_STMT, Pragma, &B, &CodeSizeFactor, 10, 1000);
             break;
 
+        case PRAGMA_CYCLE_WEIGHT:
+            IntPragma (PES_STMT, Pragma, &B, &CycleWeight, 0, 100);
+            break;
+
         case PRAGMA_DATA_NAME:
             /* TODO: PES_STMT or even PES_EXPR (PES_DECL) maybe? */
             SegNamePragma (PES_FUNC, PRAGMA_DATA_NAME, &B);
             break;
 
+        case PRAGMA_INLINE_FUNCS:
+            FlagPragma (PES_STMT, Pragma, &B, &InlineFuncs);
+            break;
+
         case PRAGMA_INLINE_STDFUNCS:
             /* TODO: PES_EXPR maybe? */
             FlagPragma (PES_STMT, Pragma, &B, &InlineStdFuncs);
@@ -972,6 +999,11 @@ static void ParsePragmaString (void)
             StringPragma (PES_IMM, &B, NoteMessagePragma);
             break;
 
+        case PRAGMA_NARROW_LOOP_VARS:
+            /* TODO: PES_STMT or even PES_EXPR (PES_DECL) maybe? */
+            FlagPragma (PES_FUNC, Pragma, &B, &NarrowLoopVars);
+            break;
+
         case PRAGMA_OPTIMIZE:
             /* TODO: PES_STMT or even PES_EXPR maybe? */
             FlagPragma (PES_STMT, Pragma, &B, &Optimize);
@@ -2809,6 +2809,11 @@ static int DoIfDef (int skip, int flag)
             Value = IsMacro (Ident);
             /* Check for extra tokens */
             CheckExtraTokens (flag ? "ifdef" : "ifndef");
+            /* An #ifndef at the start of the file may be an include guard */
+            if (!flag && PPStack->GuardState == PPGUARD_START && PPStack->Index < 0) {
+                strcpy (PPStack->Guard, Ident);
+                PPStack->GuardState = PPGUARD_OPEN;
+            }
         }
     }
 
@@ -3009,6 +3014,22 @@ static void DoPragma (void)
     /* Add the source info to preprocessor output if needed */
     AddPreLine (PragmaLine);
 
+    /* #pragma once is about the input files, so it's handled here and is
+    ** not passed to the compiler.
+    */
+    SkipWhitespace (0);
+    if (SB_GetLen (Line) - SB_GetIndex (Line) >= 4                          &&
+        memcmp (SB_GetConstBuf (Line) + SB_GetIndex (Line), "once", 4) == 0 &&
+        !IsIdent (SB_LookAt (Line, SB_GetIndex (Line) + 4))                 &&
+        !IsDigit (SB_LookAt (Line, SB_GetIndex (Line) + 4))) {
+        SB_SkipMultiple (Line, 4);
+        InitLine (Line);
+        CheckExtraTokens ("pragma once");
+        ClearLine ();
+        SetIncludeOnce ();
+        return;
+    }
+
     /* Macro-replace a single line */
     SB_Clear (MLine);
     PreprocessDirective (Line, MLine, MSM_NONE);
@@ -3086,7 +3107,20 @@ static int ParseDirectives (unsigned ModeFlags)
                 }
                 ClearLine ();
             } else {
-                switch (FindPPDirectiveType (Directive)) {
+                ppdirective_t D = FindPPDirectiveType (Directive);
+
+                /* Track the include guard of the file. Only #ifndef may
+                ** start the guard, and there may be nothing after its
+                ** #endif.
+                */
+                if ((PPStack->GuardState == PPGUARD_START && D != PPD_IFNDEF) ||
+                    PPStack->GuardState == PPGUARD_CLOSED                     ||
+                    (PPStack->GuardState == PPGUARD_OPEN && PPStack->Index == 0 &&
+                     (D == PPD_ELIF || D == PPD_ELSE))) {
+                    PPStack->GuardState = PPGUARD_NONE;
+                }
+
+                switch (D) {
 
                     case PPD_DEFINE:
                         if (!PPSkip) {
@@ -3148,6 +3182,11 @@ static int ParseDirectives (unsigned ModeFlags)
                             /* Remove the clause that needs a terminator */
                             PPSkip = (PPStack->Stack[PPStack->Index--] & IFCOND_SKIP) != 0;
 
+                            /* Check for the end of the include guard */
+                            if (PPStack->Index < 0 && PPStack->GuardState == PPGUARD_OPEN) {
+                                PPStack->GuardState = PPGUARD_CLOSED;
+                            }
+
                             /* Check for extra tokens */
                             CheckExtraTokens ("endif");
                         } else {
@@ -3232,6 +3271,11 @@ static int ParseDirectives (unsigned ModeFlags)
         Whitespace = SkipWhitespace (0) || Whitespace;
     }
 
+    /* Text outside of any #if means that the file has no include guard */
+    if (CurC != '\0' && PPStack->Index < 0) {
+        PPStack->GuardState = PPGUARD_NONE;
+    }
+
     return Whitespace;
 }
 
@@ -3416,6 +3460,9 @@ void PreprocessBegin (void)
     /* Reset #if depth */
     PPStack->Index = -1;
 
+    /* Start looking for an include guard */
+    PPStack->GuardState = PPGUARD_START;
+
     /* Remember to update source file location in preprocess-only mode */
     FileChanged = 1;
 
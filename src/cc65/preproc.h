@@ -36,6 +36,7 @@
 #ifndef PREPROC_H
 #define PREPROC_H
 
+#include "ident.h"
 #include "macrotab.h"
 
 /*****************************************************************************/
@@ -47,11 +48,21 @@
 /* Maximum #if depth per file */
 #define MAX_PP_IFS      256
 
+/* States of the include guard detection */
+typedef enum {
+    PPGUARD_START,              /* Nothing seen so far */
+    PPGUARD_OPEN,               /* Inside of #ifndef guard */
+    PPGUARD_CLOSED,             /* #endif of the guard seen */
+    PPGUARD_NONE,               /* The file has no include guard */
+} ppguard_t;
+
 /* Data struct used for per-file-directive handling */
 typedef struct PPIfStack PPIfStack;
 struct PPIfStack {
     unsigned char   Stack[MAX_PP_IFS];
     int             Index;
+    ppguard_t       GuardState; /* Include guard detection */
+    ident           Guard;      /* Name of the guard macro */
 };
 
 
@@ -0,0 +1,401 @@
+/*****************************************************************************/
+/*                                                                           */
+/*                                 profile.c                                 */
+/*                                                                           */
+/*                        Profile-guided optimization                        */
+/*                                                                           */
+/*                                                                           */
+/*                                                                           */
+/* Copyright 2026 The cc65 Authors                                           */
+/*                                                                           */
+/*                                                                           */
+/* This software is provided 'as-is', without any expressed or implied       */
+/* warranty.  In no event will the authors be held liable for any damages    */
+/* arising from the use of this software.                                    */
+/*                                                                           */
+/* Permission is granted to anyone to use this software for any purpose,     */
+/* including commercial applications, and to alter it and redistribute it    */
+/* freely, subject to the following restrictions:                            */
+/*                                                                           */
+/* 1. The origin of this software must not be misrepresented; you must not   */
+/*    claim that you wrote the original software. If you use this software   */
+/*    in a product, an acknowledgment in the product documentation would be  */
+/*    appreciated but is not required.                                       */
+/* 2. Altered source versions must be plainly marked as such, and must not   */
+/*    be misrepresented as being the original software.                      */
+/* 3. This notice may not be removed or altered from any source              */
+/*    distribution.                                                          */
+/*                                                                           */
+/*****************************************************************************/
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+/* common */
+#include "abend.h"
+#include "attrib.h"
+#include "chartype.h"
+#include "coll.h"
+#include "fname.h"
+#include "hashfunc.h"
+#include "xmalloc.h"
+
+/* cc65 */
+#include "global.h"
+#include "lineinfo.h"
+#include "profile.h"
+
+
+
+/*****************************************************************************/
+/*                                   Data                                    */
+/*****************************************************************************/
+
+
+
+/* Size of the hash tables */
+#define PF_HASH_SIZE    1024U
+
+/* The hot functions together take this share of the cycles in percent */
+#define PF_HOT_SHARE    90U
+
+/* Functions that take less than this share of the cycles in per mille are
+** cold.
+*/
+#define PF_COLD_SHARE   1U
+
+/* Minimum settings for hot functions and maximum code size factor for cold
+** ones.
+*/
+#define PF_HOT_CODESIZE         200L
+#define PF_HOT_CYCLEWEIGHT      50L
+#define PF_COLD_CODESIZE        100L
+
+/* Maximum number of fields in a record */
+#define PF_MAX_FIELDS   5U
+
+struct ProfFunc {
+    ProfFunc*           Next;           /* Next entry in hash chain */
+    unsigned long       Calls;          /* Number of calls */
+    unsigned long long  Cycles;         /* Cycles spent in the function */
+    pfheat_t            Heat;           /* Classification */
+    char*               File;           /* File name without directory */
+    char                Name[1];        /* Function name, dynamically allocated */
+};
+
+typedef struct ProfLine ProfLine;
+struct ProfLine {
+    ProfLine*           Next;           /* Next entry in hash chain */
+    unsigned            Line;           /* Line number */
+    unsigned long       Count;          /* Execution count */
+    char                File[1];        /* File name, dynamically allocated */
+};
+
+/* The profile data */
+static ProfFunc*  FuncTab[PF_HASH_SIZE];
+static ProfLine*  LineTab[PF_HASH_SIZE];
+static Collection Funcs = STATIC_COLLECTION_INITIALIZER;
+
+/* Settings changed for the current function */
+static int        Changed = 0;
+static long       OldCodeSize;
+static long       OldCycleWeight;
+static long       NewCodeSize;
+static long       NewCycleWeight;
+
+
+
+/*****************************************************************************/
+/*                             Helper functions                              */
+/*****************************************************************************/
+
+
+
+static unsigned LineHash (const char* File, unsigned Line)
+/* Return the hash table index for a source line */
+{
+    return (HashStr (File) + Line) % PF_HASH_SIZE;
+}
+
+
+
+static ProfFunc* FindFunc (const char* File, const char* Name)
+/* Find a function in the hash table. File must be without directory. */
+{
+    ProfFunc* F = FuncTab[HashStr (Name) % PF_HASH_SIZE];
+    while (F && (strcmp (F->Name, Name) != 0 || strcmp (F->File, File) != 0)) {
+        F = F->Next;
+    }
+    return F;
+}
+
+
+
+static ProfLine* FindLine (const char* File, unsigned Line)
+/* Find a source line in the hash table. File must be without directory. */
+{
+    ProfLine* L = LineTab[LineHash (File, Line)];
+    while (L && (L->Line != Line || strcmp (L->File, File) != 0)) {
+        L = L->Next;
+    }
+    return L;
+}
+
+
+
+static void AddFunc (const char* File, const char* Name,
+                     unsigned long Calls, unsigned long long Cycles)
+/* Add a function record. Functions with the same name in files with the
+** same name are merged.
+*/
+{
+    ProfFunc* F;
+
+    File = FindName (File);
+    F = FindFunc (File, Name);
+    if (F == 0) {
+        unsigned Len = strlen (Name);
+        unsigned Hash = HashStr (Name) % PF_HASH_SIZE;
+        F = xmalloc (sizeof (ProfFunc) + Len);
+        F->Calls  = 0;
+        F->Cycles = 0;
+        F->Heat   = PF_NEUTRAL;
+        F->File   = xstrdup (File);
+        memcpy (F->Name, Name, Len + 1);
+        F->Next = FuncTab[Hash];
+        FuncTab[Hash] = F;
+        CollAppend (&Funcs, F);
+    }
+    F->Calls  += Calls;
+    F->Cycles += Cycles;
+}
+
+
+
+static void AddLine (const char* File, unsigned Line, unsigned long Count)
+/* Add a source line record */
+{
+    ProfLine* L;
+
+    File = FindName (File);
+    L = FindLine (File, Line);
+    if (L == 0) {
+        unsigned Len = strlen (File);
+        unsigned Hash = LineHash (File, Line);
+        L = xmalloc (sizeof (ProfLine) + Len);
+        L->Line  = Line;
+        L->Count = 0;
+        memcpy (L->File, File, Len + 1);
+        L->Next = LineTab[Hash];
+        LineTab[Hash] = L;
+    }
+    if (Count > L->Count) {
+        L->Count = Count;
+    }
+}
+
+
+
+static int CompareCycles (void* Data attribute ((unused)),
+                          const void* Left, const void* Right)
+/* Compare function for sorting the functions by descending cycles */
+{
+    const ProfFunc* L = Left;
+    const ProfFunc* R = Right;
+    return (L->Cycles < R->Cycles) - (L->Cycles > R->Cycles);
+}
+
+
+
+static void Classify (void)
+/* Classify the functions as hot or cold */
+{
+    unsigned long long Total = 0;
+    unsigned long long Sum = 0;
+    unsigned I;
+
+    for (I = 0; I < CollCount (&Funcs); ++I) {
+        const ProfFunc* F = CollAtUnchecked (&Funcs, I);
+        Total += F->Cycles;
+    }
+
+    /* Walk through the functions with the most cycles first */
+    CollSort (&Funcs, CompareCycles, 0);
+    for (I = 0; I < CollCount (&Funcs); ++I) {
+        ProfFunc* F = CollAtUnchecked (&Funcs, I);
+        if (F->Calls == 0 || F->Cycles * 1000U < Total * PF_COLD_SHARE) {
+            F->Heat = PF_COLD;
+        } else if (Sum * 100U < Total * PF_HOT_SHARE) {
+            F->Heat = PF_HOT;
+        }
+        Sum += F->Cycles;
+    }
+}
+
+
+
+/*****************************************************************************/
+/*                                   Code                                    */
+/*****************************************************************************/
+
+
+
+void ReadProfile (const char* Name)
+/* Read the profile with the given name */
+{
+    char     Buf[1024];
+    unsigned LineNum = 0;
+
+    /* Open the file */
+    FILE* F = fopen (Name, "r");
+    if (F == 0) {
+        AbEnd ("Cannot open profile '%s': %s", Name, strerror (errno));
+    }
+
+    /* Read and parse the lines */
+    while (fgets (Buf, sizeof (Buf), F) != 0) {
+
+        char*    Field[PF_MAX_FIELDS];
+        unsigned Count;
+        char*    B;
+        unsigned Len;
+
+        ++LineNum;
+
+        /* Remove trailing white space including the line terminator */
+        Len = strlen (Buf);
+        while (Len > 0 && IsSpace (Buf[Len-1])) {
+            --Len;
+        }
+        Buf[Len] = '\0';
+
+        /* Check for empty and comment lines */
+        if (Buf[0] == '\0' || Buf[0] == '#') {
+            continue;
+        }
+
+        /* Split the line into tab separated fields. File names may contain
+        ** blanks.
+        */
+        Count = 0;
+        B = Buf;
+        while (1) {
+            char* Tab = strchr (B, '\t');
+            if (Count == PF_MAX_FIELDS) {
+                Count = 0;
+                break;
+            }
+            Field[Count++] = B;
+            if (Tab == 0) {
+                break;
+            }
+            *Tab = '\0';
+            B = Tab + 1;
+        }
+
+        /* Add the records, ignore records of unknown types */
+        if (Count == 5 && strcmp (Field[0], "function") == 0) {
+            AddFunc (Field[1], Field[2], strtoul (Field[3], 0, 10),
+                     strtoull (Field[4], 0, 10));
+        } else if (Count == 4 && strcmp (Field[0], "line") == 0) {
+            AddLine (Field[1], strtoul (Field[2], 0, 10),
+                     strtoul (Field[3], 0, 10));
+        } else if (Count == 0 ||
+                   strcmp (Field[0], "function") == 0 ||
+                   strcmp (Field[0], "line") == 0) {
+            AbEnd ("Invalid record in line %u of profile '%s'", LineNum, Name);
+        }
+    }
+
+    /* Close the file, ignore errors here. */
+    fclose (F);
+
+    /* Classify the functions */
+    Classify ();
+}
+
+
+
+const ProfFunc* PF_FindFunc (const char* File, const char* Name)
+/* Return the profile data for the function with the given name defined in
+** the given source file. Return NULL if there is no profile, or if the
+** function isn't contained in it.
+*/
+{
+    return FindFunc (FindName (File), Name);
+}
+
+
+
+pfheat_t PF_GetHeat (const ProfFunc* F)
+/* Return the classification of a function. F may be NULL. */
+{
+    return F? F->Heat : PF_NEUTRAL;
+}
+
+
+
+void PF_EnterFunc (const ProfFunc* F)
+/* Change the code size factor and the cycle weight for the body of a
+** function according to its classification. F may be NULL.
+*/
+{
+    pfheat_t Heat = PF_GetHeat (F);
+    if (Heat == PF_NEUTRAL) {
+        return;
+    }
+
+    OldCodeSize    = IS_Get (&CodeSizeFactor);
+    OldCycleWeight = IS_Get (&CycleWeight);
+    if (Heat == PF_HOT) {
+        NewCodeSize    = OldCodeSize < PF_HOT_CODESIZE? PF_HOT_CODESIZE : OldCodeSize;
+        NewCycleWeight = OldCycleWeight < PF_HOT_CYCLEWEIGHT? PF_HOT_CYCLEWEIGHT : OldCycleWeight;
+    } else {
+        NewCodeSize    = OldCodeSize > PF_COLD_CODESIZE? PF_COLD_CODESIZE : OldCodeSize;
+        NewCycleWeight = 0;
+    }
+    IS_Set (&CodeSizeFactor, NewCodeSize);
+    IS_Set (&CycleWeight, NewCycleWeight);
+    Changed = 1;
+}
+
+
+
+void PF_LeaveFunc (void)
+/* Restore the settings changed by PF_EnterFunc unless the function body has
+** changed them by pragmas.
+*/
+{
+    if (Changed) {
+        if (IS_Get (&CodeSizeFactor) == NewCodeSize) {
+            IS_Set (&CodeSizeFactor, OldCodeSize);
+        }
+        if (IS_Get (&CycleWeight) == NewCycleWeight) {
+            IS_Set (&CycleWeight, OldCycleWeight);
+        }
+        Changed = 0;
+    }
+}
+
+
+
+unsigned long PF_GetLineWeight (const ProfFunc* F, const struct LineInfo* LI)
+/* Return the average number of executions of the given source line per
+** call of the function, rounded to the nearest integer.
+*/
+{
+    const ProfLine* L;
+
+    if (F == 0 || F->Calls == 0 || LI == 0) {
+        return 0;
+    }
+    L = FindLine (FindName (GetActualFileName (LI)), GetActualLineNum (LI));
+    if (L == 0) {
+        return 0;
+    }
+    return (L->Count + F->Calls / 2) / F->Calls;
+}
@@ -0,0 +1,119 @@
+/*****************************************************************************/
+/*                                                                           */
+/*                                 profile.h                                 */
+/*                                                                           */
+/*                        Profile-guided optimization                        */
+/*                                                                           */
+/*                                                                           */
+/*                                                                           */
+/* Copyright 2026 The cc65 Authors                                           */
+/*                                                                           */
+/*                                                                           */
+/* This software is provided 'as-is', without any expressed or implied       */
+/* warranty.  In no event will the authors be held liable for any damages    */
+/* arising from the use of this software.                                    */
+/*                                                                           */
+/* Permission is granted to anyone to use this software for any purpose,     */
+/* including commercial applications, and to alter it and redistribute it    */
+/* freely, subject to the following restrictions:                            */
+/*                                                                           */
+/* 1. The origin of this software must not be misrepresented; you must not   */
+/*    claim that you wrote the original software. If you use this software   */
+/*    in a product, an acknowledgment in the product documentation would be  */
+/*    appreciated but is not required.                                       */
+/* 2. Altered source versions must be plainly marked as such, and must not   */
+/*    be misrepresented as being the original software.                      */
+/* 3. This notice may not be removed or altered from any source              */
+/*    distribution.                                                          */
+/*                                                                           */
+/*****************************************************************************/
+
+
+
+/* With --use-profile, the compiler reads an execution profile written by
+** "sim65 --profile" for a previous build of the program. The functions that
+** take most of the cycles of the run are optimized for speed, the functions
+** that were never called or take almost no time are optimized for size. For
+** the remaining functions, the settings of the command line and the pragmas
+** are used unchanged. The execution counts of the source lines replace the
+** loop nesting when the uses of the variables of a function are weighted for
+** --auto-register-vars.
+**
+** Files are matched by their name without the directory, and functions by
+** their file and name, so the profile of a program may be used for all of
+** its modules.
+*/
+
+
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+
+
+/*****************************************************************************/
+/*                                   Forwards                                */
+/*****************************************************************************/
+
+
+
+struct LineInfo;
+
+
+
+/*****************************************************************************/
+/*                                   Data                                    */
+/*****************************************************************************/
+
+
+
+/* Classification of a function */
+typedef enum {
+    PF_NEUTRAL,                 /* Not in the profile or in between */
+    PF_HOT,                     /* Takes most of the cycles */
+    PF_COLD                     /* Never called or almost no cycles */
+} pfheat_t;
+
+/* Profile data for a function */
+typedef struct ProfFunc ProfFunc;
+
+
+
+/*****************************************************************************/
+/*                                   Code                                    */
+/*****************************************************************************/
+
+
+
+void ReadProfile (const char* Name);
+/* Read the profile with the given name */
+
+const ProfFunc* PF_FindFunc (const char* File, const char* Name);
+/* Return the profile data for the function with the given name defined in
+** the given source file. Return NULL if there is no profile, or if the
+** function isn't contained in it.
+*/
+
+pfheat_t PF_GetHeat (const ProfFunc* F);
+/* Return the classification of a function. F may be NULL. */
+
+void PF_EnterFunc (const ProfFunc* F);
+/* Change the code size factor and the cycle weight for the body of a
+** function according to its classification. F may be NULL.
+*/
+
+void PF_LeaveFunc (void);
+/* Restore the settings changed by PF_EnterFunc unless the function body has
+** changed them by pragmas.
+*/
+
+unsigned long PF_GetLineWeight (const ProfFunc* F, const struct LineInfo* LI);
+/* Return the average number of executions of the given source line per
+** call of the function, rounded to the nearest integer.
+*/
+
+
+
+/* End of profile.h */
+
+#endif
@@ -0,0 +1,526 @@
+/*****************************************************************************/
+/*                                                                           */
+/*                                regalloc.c                                 */
+/*                                                                           */
+/*                Automatic allocation of register variables                 */
+/*                                                                           */
+/*                                                                           */
+/*                                                                           */
+/* Copyright 2026 The cc65 Authors                                           */
+/*                                                                           */
+/*                                                                           */
+/* This software is provided 'as-is', without any expressed or implied       */
+/* warranty.  In no event will the authors be held liable for any damages    */
+/* arising from the use of this software.                                    */
+/*                                                                           */
+/* Permission is granted to anyone to use this software for any purpose,     */
+/* including commercial applications, and to alter it and redistribute it    */
+/* freely, subject to the following restrictions:                            */
+/*                                                                           */
+/* 1. The origin of this software must not be misrepresented; you must not   */
+/*    claim that you wrote the original software. If you use this software   */
+/*    in a product, an acknowledgment in the product documentation would be  */
+/*    appreciated but is not required.                                       */
+/* 2. Altered source versions must be plainly marked as such, and must not   */
+/*    be misrepresented as being the original software.                      */
+/* 3. This notice may not be removed or altered from any source              */
+/*    distribution.                                                          */
+/*                                                                           */
+/*****************************************************************************/
+
+
+
+
+
+
+#include <string.h>
+
+/* common */
+#include "coll.h"
+#include "hashfunc.h"
+#include "xmalloc.h"
+
+/* cc65 */
+#include "global.h"
+#include "profile.h"
+#include "scanner.h"
+#include "regalloc.h"
+
+
+
+/*****************************************************************************/
+/*                                   Data                                    */
+/*****************************************************************************/
+
+
+
+/* Size of the hash table for the identifiers */
+#define RA_HASH_SIZE    64U
+
+/* Each loop nesting level multiplies the weight of an identifier use by 8,
+** up to the given depth.
+*/
+#define RA_WEIGHT_SHIFT 3U
+#define RA_MAX_DEPTH    3U
+#define RA_MAX_USES     1000000UL
+
+/* Maximum loop nesting tracked. Deeper functions are not handled. */
+#define RA_MAX_LOOPS    32U
+
+/* Estimated cycles saved per access of a variable in the register bank
+** instead of on the stack.
+*/
+#define RA_GAIN_CHAR    4L
+#define RA_GAIN_INT     16L
+
+/* Estimated cycles for saving and restoring the register bank. For local
+** variables, the save area replaces the space on the stack. For parameters,
+** the value is swapped with the register bank on function entry.
+*/
+#define RA_COST_LOCAL   50L
+#define RA_COST_PARAM   70L
+#define RA_COST_BYTE    8L
+
+/* Space assumed for variables that are declared later */
+#define RA_RESERVE_SIZE 2U
+
+/* Flags for an identifier */
+#define RAF_ADDR        0x01U           /* Address is taken */
+#define RAF_DECL        0x02U           /* Declared on the top level */
+#define RAF_REGISTER    0x04U           /* Declared with "register" */
+#define RAF_DONE        0x08U           /* Passed to RA_WantRegVar */
+
+/* Usage info for an identifier */
+typedef struct RAEntry RAEntry;
+struct RAEntry {
+    RAEntry*        Next;               /* Next entry in hash chain */
+    unsigned long   Uses;               /* Weighted number of uses */
+    unsigned        Flags;              /* RAF_xxx */
+    char            Name[1];            /* Identifier, dynamically allocated */
+};
+
+/* State of a loop while scanning */
+enum {
+    LS_HEADER,                          /* In parenthesized header */
+    LS_BODY,                            /* Before the body */
+    LS_BLOCK,                           /* In a compound statement body */
+    LS_STMT                             /* In a single statement body */
+};
+
+typedef struct RALoop RALoop;
+struct RALoop {
+    unsigned        State;              /* LS_xxx */
+    unsigned        Brace;              /* Brace level of the loop */
+    unsigned        Paren;              /* Paren level of the loop */
+};
+
+/* State of declarations on the top level of the function body */
+enum {
+    DS_NONE,                            /* Not in a declaration */
+    DS_MAYBE,                           /* Started with an identifier */
+    DS_DECL,                            /* In a declaration */
+    DS_INIT,                            /* In an initializer */
+    DS_DONE                             /* Statements follow */
+};
+
+struct RegAlloc {
+    RAEntry*        Tab[RA_HASH_SIZE];  /* Hash table for identifiers */
+    Collection      Entries;            /* All identifiers */
+    int             Disabled;           /* Function must not be handled */
+    const ProfFunc* Prof;               /* Profile data if any */
+
+    /* Scanner state */
+    unsigned        Brace;              /* Curly brace nesting */
+    unsigned        Paren;              /* Parenthesis nesting */
+    unsigned        Bracket;            /* Bracket nesting */
+    unsigned        LoopCount;          /* Loop nesting */
+    RALoop          Loops[RA_MAX_LOOPS];
+    int             AddrOf;             /* Last token was '&' or '(' after it */
+    int             StmtStart;          /* Token starts a top level statement */
+    unsigned        DeclState;          /* DS_xxx */
+    int             DeclRegister;       /* Declaration with "register" */
+    RAEntry*        Declarator;         /* Possibly declared identifier */
+};
+
+
+
+/*****************************************************************************/
+/*                              struct RegAlloc                              */
+/*****************************************************************************/
+
+
+
+static RAEntry* FindEntry (RegAlloc* R, const char* Name, int Create)
+/* Find the entry for an identifier. If there is none, create it if Create
+** is true, otherwise return NULL.
+*/
+{
+    unsigned Hash = HashStr (Name) % RA_HASH_SIZE;
+    unsigned Len;
+    RAEntry* E = R->Tab[Hash];
+    while (E) {
+        if (strcmp (E->Name, Name) == 0) {
+            return E;
+        }
+        E = E->Next;
+    }
+
+    if (Create) {
+        Len = strlen (Name);
+        E = xmalloc (sizeof (RAEntry) + Len);
+        E->Uses  = 0;
+        E->Flags = 0;
+        memcpy (E->Name, Name, Len + 1);
+        E->Next = R->Tab[Hash];
+        R->Tab[Hash] = E;
+        CollAppend (&R->Entries, E);
+    }
+    return E;
+}
+
+
+
+static long Gain (unsigned long Uses, unsigned Size, int IsParam, int Save)
+/* Return the estimated cycles saved by placing a variable into the register
+** bank.
+*/
+{
+    long G = (long) Uses * (Size == 1? RA_GAIN_CHAR : RA_GAIN_INT);
+    if (IsParam) {
+        G -= RA_COST_PARAM + RA_COST_BYTE * (long) Size;
+    } else if (Save) {
+        G -= RA_COST_LOCAL + RA_COST_BYTE * (long) Size;
+    }
+    return G;
+}
+
+
+
+/*****************************************************************************/
+/*                                 Scanning                                  */
+/*****************************************************************************/
+
+
+
+static void PopLoops (RegAlloc* R, int Block)
+/* Remove the loops whose body ends at the current position. If Block is true,
+** a closing curly brace was read, otherwise a semicolon.
+*/
+{
+    while (R->LoopCount > 0) {
+        const RALoop* L = &R->Loops[R->LoopCount - 1];
+        if (L->Brace > R->Brace) {
+            /* Left the block containing the loop */
+        } else if (L->Brace < R->Brace) {
+            break;
+        } else if (Block) {
+            /* End of a compound statement body, or of a compound statement
+            ** that is part of a single statement body.
+            */
+            if (L->State != LS_BLOCK && L->State != LS_STMT) {
+                break;
+            }
+        } else if (L->State != LS_STMT || L->Paren != R->Paren) {
+            break;
+        }
+        --R->LoopCount;
+    }
+}
+
+
+
+static int ScanToken (const Token* T, void* Data)
+/* Count the uses of the identifiers in the function body */
+{
+    RegAlloc* R = Data;
+    RAEntry*  E;
+    int       AddrOf;
+
+    /* Start the body of a loop */
+    if (R->LoopCount > 0 && R->Loops[R->LoopCount - 1].State == LS_BODY) {
+        RALoop* L = &R->Loops[R->LoopCount - 1];
+        L->State = (T->Tok == TOK_LCURLY)? LS_BLOCK : LS_STMT;
+        L->Brace = R->Brace;
+        L->Paren = R->Paren;
+    }
+
+    /* Check for the end of a declarator */
+    if (R->Declarator) {
+        if (T->Tok == TOK_ASSIGN || T->Tok == TOK_COMMA || T->Tok == TOK_SEMI) {
+            R->Declarator->Flags |= RAF_DECL;
+            if (R->DeclRegister) {
+                R->Declarator->Flags |= RAF_REGISTER;
+            }
+        }
+        R->Declarator = 0;
+    }
+
+    /* A top level statement starting with an identifier is a declaration if
+    ** the identifier is followed by another one or a star.
+    */
+    if (R->DeclState == DS_MAYBE) {
+        if (T->Tok == TOK_IDENT || T->Tok == TOK_STAR) {
+            R->DeclState = DS_DECL;
+        } else {
+            R->DeclState = DS_DONE;
+        }
+    } else if (R->StmtStart && R->DeclState != DS_DONE) {
+        if (TokIsType (T) || TokIsStorageClass (T) || TokIsTypeQual (T)) {
+            R->DeclState = DS_DECL;
+        } else if (T->Tok == TOK_IDENT) {
+            R->DeclState = DS_MAYBE;
+        } else {
+            R->DeclState = DS_DONE;
+        }
+    }
+    R->StmtStart = 0;
+
+    AddrOf = R->AddrOf;
+    R->AddrOf = 0;
+    switch (T->Tok) {
+
+        case TOK_IDENT:
+            /* The function must not place variables into the register bank
+            ** if it may be left or reentered with longjmp.
+            */
+            if (strcmp (T->Ident, "setjmp") == 0 ||
+                strcmp (T->Ident, "longjmp") == 0) {
+                R->Disabled = 1;
+                return 0;
+            }
+            E = FindEntry (R, T->Ident, 1);
+            if (R->Prof) {
+                /* Use the executions per call from the profile */
+                unsigned long W = PF_GetLineWeight (R->Prof, T->LI);
+                E->Uses += (W < RA_MAX_USES)? W : RA_MAX_USES;
+            } else {
+                E->Uses += 1UL << (RA_WEIGHT_SHIFT *
+                            (R->LoopCount < RA_MAX_DEPTH? R->LoopCount : RA_MAX_DEPTH));
+            }
+            if (E->Uses > RA_MAX_USES) {
+                E->Uses = RA_MAX_USES;
+            }
+            if (AddrOf) {
+                E->Flags |= RAF_ADDR;
+            }
+            if (R->DeclState == DS_DECL && R->Brace == 1 &&
+                R->Paren == 0 && R->Bracket == 0) {
+                R->Declarator = E;
+            }
+            break;
+
+        case TOK_ASM:
+        case TOK_GOTO:
+            /* Inline assembler may access the variables on the stack, and
+            ** the checks for jumps into blocks need the input position.
+            */
+            R->Disabled = 1;
+            return 0;
+
+        case TOK_REGISTER:
+            R->DeclRegister = (R->DeclState == DS_DECL);
+            break;
+
+        case TOK_FOR:
+        case TOK_WHILE:
+        case TOK_DO:
+            if (R->LoopCount == RA_MAX_LOOPS) {
+                R->Disabled = 1;
+                return 0;
+            }
+            R->Loops[R->LoopCount].State = (T->Tok == TOK_DO)? LS_BODY : LS_HEADER;
+            R->Loops[R->LoopCount].Brace = R->Brace;
+            R->Loops[R->LoopCount].Paren = R->Paren;
+            ++R->LoopCount;
+            break;
+
+        case TOK_AND:
+            R->AddrOf = 1;
+            break;
+
+        case TOK_LPAREN:
+            R->AddrOf = AddrOf;
+            ++R->Paren;
+            break;
+
+        case TOK_RPAREN:
+            if (R->Paren > 0) {
+                --R->Paren;
+            }
+            if (R->LoopCount > 0) {
+                RALoop* L = &R->Loops[R->LoopCount - 1];
+                if (L->State == LS_HEADER && L->Paren == R->Paren) {
+                    L->State = LS_BODY;
+                }
+            }
+            break;
+
+        case TOK_LBRACK:
+            ++R->Bracket;
+            break;
+
+        case TOK_RBRACK:
+            if (R->Bracket > 0) {
+                --R->Bracket;
+            }
+            break;
+
+        case TOK_LCURLY:
+            ++R->Brace;
+            break;
+
+        case TOK_RCURLY:
+            if (--R->Brace == 0) {
+                /* End of the function body */
+                return 0;
+            }
+            PopLoops (R, 1);
+            break;
+
+        case TOK_SEMI:
+            PopLoops (R, 0);
+            if (R->Brace == 1 && R->Paren == 0) {
+                R->StmtStart = 1;
+                if (R->DeclState != DS_DONE) {
+                    R->DeclState = DS_NONE;
+                    R->DeclRegister = 0;
+                }
+            }
+            break;
+
+        case TOK_ASSIGN:
+            if (R->DeclState == DS_DECL && R->Brace == 1 && R->Paren == 0) {
+                R->DeclState = DS_INIT;
+            }
+            break;
+
+        case TOK_COMMA:
+            if (R->DeclState == DS_INIT && R->Brace == 1 && R->Paren == 0) {
+                R->DeclState = DS_DECL;
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    return 1;
+}
+
+
+
+/*****************************************************************************/
+/*                                   Code                                    */
+/*****************************************************************************/
+
+
+
+RegAlloc* NewRegAlloc (const ProfFunc* Prof)
+/* Scan the body of the current function ahead and return the usage counts
+** of the identifiers. CurTok must be the opening curly brace of the body.
+** If Prof isn't NULL, the uses are weighted with the execution counts of
+** the profile instead of the loop nesting. Return NULL if the function must
+** not use automatic register variables.
+*/
+{
+    RegAlloc* R;
+
+    if (CurTok.Tok != TOK_LCURLY) {
+        return 0;
+    }
+
+    /* Create the data */
+    R = xmalloc (sizeof (RegAlloc));
+    memset (R->Tab, 0, sizeof (R->Tab));
+    InitCollection (&R->Entries);
+    R->Disabled     = 0;
+    R->Prof         = Prof;
+    R->Brace        = 1;
+    R->Paren        = 0;
+    R->Bracket      = 0;
+    R->LoopCount    = 0;
+    R->AddrOf       = 0;
+    R->StmtStart    = 1;
+    R->DeclState    = DS_NONE;
+    R->DeclRegister = 0;
+    R->Declarator   = 0;
+
+    /* Scan the tokens up to the end of the body */
+    LookAhead (ScanToken, R);
+
+    if (R->Disabled) {
+        FreeRegAlloc (R);
+        return 0;
+    }
+    return R;
+}
+
+
+
+void FreeRegAlloc (RegAlloc* R)
+/* Free the data of a function */
+{
+    if (R) {
+        unsigned I;
+        for (I = 0; I < CollCount (&R->Entries); ++I) {
+            xfree (CollAtUnchecked (&R->Entries, I));
+        }
+        DoneCollection (&R->Entries);
+        xfree (R);
+    }
+}
+
+
+
+int RA_WantRegVar (RegAlloc* R, const char* Name, const Type* T,
+                   int IsParam, int Save, unsigned SpaceLeft)
+/* Return true if the variable with the given name and type should be placed
+** into the register bank. IsParam is true for parameters, Save is true if
+** the old contents of the register bank must be saved. SpaceLeft is the
+** free space in the register bank. Every variable must be passed only once.
+*/
+{
+    RAEntry* E;
+    unsigned Size;
+    unsigned Reserved;
+    unsigned I;
+
+    /* Unused variables are not in the table */
+    if (R == 0 || (E = FindEntry (R, Name, 0)) == 0 || (E->Flags & RAF_DONE)) {
+        return 0;
+    }
+    E->Flags |= RAF_DONE;
+
+    /* Only scalars whose address is not taken can be placed into the
+    ** register bank.
+    */
+    if ((E->Flags & RAF_ADDR) != 0 || IsQualVolatile (T) ||
+        (!IsClassInt (T) && !IsClassPtr (T))) {
+        return 0;
+    }
+    Size = SizeOf (T);
+    if ((Size != 1 && Size != 2) || Gain (E->Uses, Size, IsParam, Save) <= 0) {
+        return 0;
+    }
+
+    /* Keep space for the variables declared later that are used more often,
+    ** and for explicit register variables.
+    */
+    Reserved = 0;
+    for (I = 0; I < CollCount (&R->Entries); ++I) {
+        const RAEntry* Other = CollConstAt (&R->Entries, I);
+        if ((Other->Flags & (RAF_DECL | RAF_DONE)) != RAF_DECL) {
+            continue;
+        }
+        if ((Other->Flags & RAF_REGISTER) != 0) {
+            if (IS_Get (&EnableRegVars)) {
+                Reserved += RA_RESERVE_SIZE;
+            }
+        } else if ((Other->Flags & RAF_ADDR) == 0 && Other->Uses > E->Uses &&
+                   Gain (Other->Uses, RA_RESERVE_SIZE, 0, Save) > 0) {
+            Reserved += RA_RESERVE_SIZE;
+        }
+    }
+
+    return Size + Reserved <= SpaceLeft;
+}
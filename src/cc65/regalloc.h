@@ -0,0 +1,100 @@
+/*****************************************************************************/
+/*                                                                           */
+/*                                regalloc.h                                 */
+/*                                                                           */
+/*                Automatic allocation of register variables                 */
+/*                                                                           */
+/*                                                                           */
+/*                                                                           */
+/* Copyright 2026 The cc65 Authors                                           */
+/*                                                                           */
+/*                                                                           */
+/* This software is provided 'as-is', without any expressed or implied       */
+/* warranty.  In no event will the authors be held liable for any damages    */
+/* arising from the use of this software.                                    */
+/*                                                                           */
+/* Permission is granted to anyone to use this software for any purpose,     */
+/* including commercial applications, and to alter it and redistribute it    */
+/* freely, subject to the following restrictions:                            */
+/*                                                                           */
+/* 1. The origin of this software must not be misrepresented; you must not   */
+/*    claim that you wrote the original software. If you use this software   */
+/*    in a product, an acknowledgment in the product documentation would be  */
+/*    appreciated but is not required.                                       */
+/* 2. Altered source versions must be plainly marked as such, and must not   */
+/*    be misrepresented as being the original software.                      */
+/* 3. This notice may not be removed or altered from any source              */
+/*    distribution.                                                          */
+/*                                                                           */
+/*****************************************************************************/
+
+
+
+
+
+
+/* With --auto-register-vars, the compiler places the most used scalar locals
+** and parameters of a function into the register bank, as if they were
+** declared "register". Since the compiler translates a function in one pass,
+** the tokens of the function body are scanned ahead before the variables are
+** declared. The uses of all identifiers are counted and weighted with the
+** loop nesting depth, and identifiers whose address is taken are noted. A
+** variable is placed into the register bank if the estimated cycles saved by
+** the accesses are greater than the cost of saving and restoring the old
+** contents of the register bank, and if there is enough space left for the
+** variables that are used more often but are declared later.
+*/
+
+
+
+#ifndef REGALLOC_H
+#define REGALLOC_H
+
+
+
+/* cc65 */
+#include "datatype.h"
+#include "profile.h"
+
+
+
+/*****************************************************************************/
+/*                                   Data                                    */
+/*****************************************************************************/
+
+
+
+typedef struct RegAlloc RegAlloc;
+
+
+
+/*****************************************************************************/
+/*                                   Code                                    */
+/*****************************************************************************/
+
+
+
+RegAlloc* NewRegAlloc (const ProfFunc* Prof);
+/* Scan the body of the current function ahead and return the usage counts
+** of the identifiers. CurTok must be the opening curly brace of the body.
+** If Prof isn't NULL, the uses are weighted with the execution counts of
+** the profile instead of the loop nesting. Return NULL if the function must
+** not use automatic register variables.
+*/
+
+void FreeRegAlloc (RegAlloc* R);
+/* Free the data of a function */
+
+int RA_WantRegVar (RegAlloc* R, const char* Name, const Type* T,
+                   int IsParam, int Save, unsigned SpaceLeft);
+/* Return true if the variable with the given name and type should be placed
+** into the register bank. IsParam is true for parameters, Save is true if
+** the old contents of the register bank must be saved. SpaceLeft is the
+** free space in the register bank. Every variable must be passed only once.
+*/
+
+
+
+/* End of regalloc.h */
+
+#endif
@@ -37,6 +37,7 @@
 #include "xmalloc.h"
 
 /* cc65 */
+#include "codepool.h"
 #include "reginfo.h"
 
 
@@ -83,6 +84,61 @@ void RC_InvalidatePS (RegContents* C)
 
 
 
+void RC_Merge (RegContents* C, const RegContents* Other)
+/* Merge the contents of Other into C, where control flow from two places
+** joins. Values that are different in both become unknown.
+*/
+{
+    unsigned PF;
+
+    if (C->RegA != Other->RegA) {
+        C->RegA = UNKNOWN_REGVAL;
+    }
+    if (C->RegX != Other->RegX) {
+        C->RegX = UNKNOWN_REGVAL;
+    }
+    if (C->RegY != Other->RegY) {
+        C->RegY = UNKNOWN_REGVAL;
+    }
+    if (C->SRegLo != Other->SRegLo) {
+        C->SRegLo = UNKNOWN_REGVAL;
+    }
+    if (C->SRegHi != Other->SRegHi) {
+        C->SRegHi = UNKNOWN_REGVAL;
+    }
+    if (C->Ptr1Lo != Other->Ptr1Lo) {
+        C->Ptr1Lo = UNKNOWN_REGVAL;
+    }
+    if (C->Ptr1Hi != Other->Ptr1Hi) {
+        C->Ptr1Hi = UNKNOWN_REGVAL;
+    }
+    if (C->Tmp1 != Other->Tmp1) {
+        C->Tmp1 = UNKNOWN_REGVAL;
+    }
+    PF = C->PFlags ^ Other->PFlags;
+    C->PFlags |= ((PF >> 8) | PF | (PF << 8)) & UNKNOWN_PFVAL_ALL;
+    C->ZNRegs &= Other->ZNRegs;
+}
+
+
+
+int RC_Equal (const RegContents* C1, const RegContents* C2)
+/* Return true if both register contents are identical */
+{
+    return C1->RegA   == C2->RegA       &&
+           C1->RegX   == C2->RegX       &&
+           C1->RegY   == C2->RegY       &&
+           C1->SRegLo == C2->SRegLo     &&
+           C1->SRegHi == C2->SRegHi     &&
+           C1->Ptr1Lo == C2->Ptr1Lo     &&
+           C1->Ptr1Hi == C2->Ptr1Hi     &&
+           C1->Tmp1   == C2->Tmp1       &&
+           C1->PFlags == C2->PFlags     &&
+           C1->ZNRegs == C2->ZNRegs;
+}
+
+
+
 static void RC_Dump1 (FILE* F, const char* Desc, short Val)
 /* Dump one register value */
 {
@@ -156,7 +212,7 @@ RegInfo* NewRegInfo (const RegContents* RC)
 */
 {
     /* Allocate memory */
-    RegInfo* RI = xmalloc (sizeof (RegInfo));
+    RegInfo* RI = CP_Alloc (sizeof (RegInfo));
 
     /* Initialize the registers */
     if (RC) {
@@ -172,6 +228,9 @@ RegInfo* NewRegInfo (const RegContents* RC)
         RC_InvalidatePS (&RI->Out2);
     }
 
+    /* Until the liveness is known, assume that everything is used */
+    RI->LiveOut = ~0U;
+
     /* Return the new struct */
     return RI;
 }
@@ -181,7 +240,7 @@ RegInfo* NewRegInfo (const RegContents* RC)
 void FreeRegInfo (RegInfo* RI)
 /* Free a RegInfo struct */
 {
-    xfree (RI);
+    CP_Free (RI, sizeof (RegInfo));
 }
 
 
@@ -138,6 +138,7 @@ struct RegInfo {
     RegContents In;             /* Incoming register values */
     RegContents Out;            /* Outgoing register values */
     RegContents Out2;           /* Alternative outgoing reg values for branches */
+    unsigned    LiveOut;        /* Registers and flags used after the insn */
 };
 
 
@@ -157,6 +158,14 @@ void RC_InvalidateZP (RegContents* C);
 void RC_InvalidatePS (RegContents* C);
 /* Invalidate processor status */
 
+void RC_Merge (RegContents* C, const RegContents* Other);
+/* Merge the contents of Other into C, where control flow from two places
+** joins. Values that are different in both become unknown.
+*/
+
+int RC_Equal (const RegContents* C1, const RegContents* C2);
+/* Return true if both register contents are identical */
+
 void RC_Dump (FILE* F, const RegContents* RC);
 /* Dump the contents of the given RegContents struct */
 
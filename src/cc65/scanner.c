@@ -44,8 +44,10 @@
 
 /* common */
 #include "chartype.h"
+#include "check.h"
 #include "fp.h"
 #include "tgttrans.h"
+#include "xmalloc.h"
 
 /* cc65 */
 #include "datatype.h"
@@ -71,6 +73,16 @@
 
 
 static Token SavedTok;          /* Saved token */
+static Token* AheadToks = 0;    /* Tokens read by LookAhead */
+static unsigned AheadSize = 0;  /* Allocated size of AheadToks */
+static unsigned AheadCount = 0; /* Number of tokens in AheadToks */
+static unsigned AheadPos = 0;   /* Index of next token in AheadToks */
+static int InLookAhead = 0;     /* Reading tokens for LookAhead */
+static const Token* ReplayToks = 0; /* Tokens returned by ReplayTokens */
+static unsigned ReplayCount = 0;    /* Number of tokens in ReplayToks */
+static unsigned ReplayPos = 0;      /* Index of next token in ReplayToks */
+static Token ReplayCurTok;      /* CurTok saved by ReplayTokens */
+static Token ReplayNextTok;     /* NextTok saved by ReplayTokens */
 Token       CurTok;             /* The current token */
 Token       NextTok;            /* The next token */
 int         PPParserRunning;    /* Is tokenizer used by the preprocessor */
@@ -796,49 +808,31 @@ static void NumericConst (void)
 
 
 
-static void GetNextInputToken (void)
-/* Get next token from input stream */
+static void ReadToken (int AheadDiag)
+/* Read the next token from the input into NextTok. If AheadDiag is true, the
+** token is read by LookAhead, and CurTok is made to refer to the position of
+** the token, so diagnostics are reported for the right line.
+*/
 {
     ident token;
 
-    if (!NoCharMap && !InPragmaParser) {
-        /* Translate string and character literals into target charset */
-        if (NextTok.Tok == TOK_SCONST || NextTok.Tok == TOK_WCSCONST) {
-            TranslateLiteral (NextTok.SVal);
-        } else if (NextTok.Tok == TOK_CCONST || NextTok.Tok == TOK_WCCONST) {
-            NextTok.IVal = SignExtendChar (TgtTranslateChar (NextTok.IVal));
-        }
-    }
+    /* We have to skip white space here before shifting tokens, since the
+    ** tokens and the current line info is invalid at startup and will get
+    ** initialized by reading the first time from the file. Remember if we
+    ** were at end of input and handle that later.
+    */
+    int GotEOF = (SkipWhite () == 0);
 
-    /* Current token is the lookahead token */
-    if (CurTok.LI) {
-        ReleaseLineInfo (CurTok.LI);
+    /* Remember the starting position of the next token */
+    NextTok.LI = UseLineInfo (GetCurLineInfo ());
+    if (AheadDiag) {
+        CurTok.LI = NextTok.LI;
     }
 
-    /* Get the current token */
-    CurTok = NextTok;
-
-    if (SavedTok.Tok == TOK_INVALID) {
-        /* We have to skip white space here before shifting tokens, since the
-        ** tokens and the current line info is invalid at startup and will get
-        ** initialized by reading the first time from the file. Remember if we
-        ** were at end of input and handle that later.
-        */
-        int GotEOF = (SkipWhite () == 0);
-
-        /* Remember the starting position of the next token */
-        NextTok.LI = UseLineInfo (GetCurLineInfo ());
-
-        /* Now handle end of input */
-        if (GotEOF) {
-            /* End of file reached */
-            NextTok.Tok = TOK_CEOF;
-            return;
-        }
-    } else {
-        /* Just use the saved token */
-        NextTok = SavedTok;
-        SavedTok.Tok = TOK_INVALID;
+    /* Now handle end of input */
+    if (GotEOF) {
+        /* End of file reached */
+        NextTok.Tok = TOK_CEOF;
         return;
     }
 
@@ -1128,6 +1122,64 @@ static void GetNextInputToken (void)
 
 
 
+static void GetNextInputToken (void)
+/* Get next token from input stream */
+{
+    if (!NoCharMap && !InPragmaParser) {
+        /* Translate string and character literals into target charset */
+        if (NextTok.Tok == TOK_SCONST || NextTok.Tok == TOK_WCSCONST) {
+            TranslateLiteral (NextTok.SVal);
+        } else if (NextTok.Tok == TOK_CCONST || NextTok.Tok == TOK_WCCONST) {
+            NextTok.IVal = SignExtendChar (TgtTranslateChar (NextTok.IVal));
+        }
+    }
+
+    /* Current token is the lookahead token */
+    if (CurTok.LI) {
+        ReleaseLineInfo (CurTok.LI);
+    }
+
+    /* Get the current token */
+    CurTok = NextTok;
+
+    /* Tokens replayed by ReplayTokens are followed by a semicolon */
+    if (ReplayToks) {
+        if (ReplayPos < ReplayCount) {
+            NextTok = ReplayToks[ReplayPos++];
+        } else {
+            NextTok = ReplayToks[ReplayCount - 1];
+            NextTok.Tok = TOK_SEMI;
+        }
+        NextTok.LI = UseLineInfo (NextTok.LI);
+        return;
+    }
+
+    /* The preprocessor may read tokens while LookAhead is reading the input.
+    ** These come from the input line only.
+    */
+    if (!InLookAhead) {
+        if (SavedTok.Tok != TOK_INVALID) {
+            /* Just use the saved token */
+            NextTok = SavedTok;
+            SavedTok.Tok = TOK_INVALID;
+            return;
+        }
+        if (AheadPos < AheadCount) {
+            /* Use a token read by LookAhead */
+            NextTok = AheadToks[AheadPos++];
+            if (AheadPos == AheadCount) {
+                AheadPos = AheadCount = 0;
+            }
+            return;
+        }
+    }
+
+    /* Read a new token */
+    ReadToken (0);
+}
+
+
+
 void NextToken (void)
 /* Get next non-pragma token from input stream consuming any pragmas
 ** encountered. Adjacent string literal tokens will be concatenated.
@@ -1212,6 +1264,111 @@ void NextToken (void)
 
 
 
+void LookAhead (int (*Func) (const Token* T, void* Data), void* Data)
+/* Pass NextTok and the tokens following it to Func until Func returns zero
+** or the end of input is reached, without consuming them. The tokens are
+** kept and returned later by NextToken as usual. Func sees the tokens before
+** string literals are translated into the target character set and before
+** they are concatenated, and pragmas are not processed.
+*/
+{
+    Token    OldCurTok;
+    Token    OldNextTok;
+    unsigned I;
+
+    /* Visit the tokens that have already been read */
+    if (!Func (&NextTok, Data) || NextTok.Tok == TOK_CEOF) {
+        return;
+    }
+    if (SavedTok.Tok != TOK_INVALID) {
+        if (!Func (&SavedTok, Data) || SavedTok.Tok == TOK_CEOF) {
+            return;
+        }
+    }
+    for (I = AheadPos; I < AheadCount; ++I) {
+        if (!Func (&AheadToks[I], Data) || AheadToks[I].Tok == TOK_CEOF) {
+            return;
+        }
+    }
+
+    /* Read new tokens. NextTok is used for reading, and CurTok for the
+    ** position of diagnostics, so save both.
+    */
+    OldCurTok  = CurTok;
+    OldNextTok = NextTok;
+    InLookAhead = 1;
+    while (1) {
+
+        Token* T;
+
+        /* Make room for the token */
+        if (AheadCount == AheadSize) {
+            AheadSize = AheadSize? AheadSize * 2 : 64;
+            AheadToks = xrealloc (AheadToks, AheadSize * sizeof (Token));
+        }
+
+        /* Read it */
+        NextTok.Tok = TOK_INVALID;
+        NextTok.LI  = 0;
+        ReadToken (1);
+        T = &AheadToks[AheadCount++];
+        *T = NextTok;
+
+        /* Pass it to the caller */
+        if (!Func (T, Data) || T->Tok == TOK_CEOF) {
+            break;
+        }
+    }
+    InLookAhead = 0;
+    CurTok  = OldCurTok;
+    NextTok = OldNextTok;
+}
+
+
+
+void ReplayTokens (const Token* Toks, unsigned Count)
+/* Read the given tokens followed by a semicolon instead of the input, until
+** EndReplay is called. The current tokens are saved and restored by
+** EndReplay. The tokens must not contain string literals or pragmas, and
+** their line infos are used, not taken over. Count must not be zero.
+*/
+{
+    PRECONDITION (ReplayToks == 0 && Count > 0);
+
+    /* Save the current tokens */
+    ReplayCurTok  = CurTok;
+    ReplayNextTok = NextTok;
+
+    /* Load the first replayed token into CurTok */
+    ReplayToks  = Toks;
+    ReplayCount = Count;
+    ReplayPos   = 1;
+    CurTok.LI   = 0;
+    NextTok     = Toks[0];
+    NextTok.LI  = UseLineInfo (NextTok.LI);
+    NextToken ();
+}
+
+
+
+void EndReplay (void)
+/* Stop replaying tokens and restore the tokens saved by ReplayTokens */
+{
+    PRECONDITION (ReplayToks != 0);
+
+    if (CurTok.LI) {
+        ReleaseLineInfo (CurTok.LI);
+    }
+    if (NextTok.LI) {
+        ReleaseLineInfo (NextTok.LI);
+    }
+    CurTok     = ReplayCurTok;
+    NextTok    = ReplayNextTok;
+    ReplayToks = 0;
+}
+
+
+
 void SkipTokens (const token_t* TokenList, unsigned TokenCount)
 /* Skip tokens until we reach TOK_CEOF or a token in the given token list.
 ** This routine is used for error recovery.
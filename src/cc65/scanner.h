@@ -307,6 +307,24 @@ void NextToken (void);
 ** encountered. Adjacent string literal tokens will be concatenated.
 */
 
+void LookAhead (int (*Func) (const Token* T, void* Data), void* Data);
+/* Pass NextTok and the tokens following it to Func until Func returns zero
+** or the end of input is reached, without consuming them. The tokens are
+** kept and returned later by NextToken as usual. Func sees the tokens before
+** string literals are translated into the target character set and before
+** they are concatenated, and pragmas are not processed.
+*/
+
+void ReplayTokens (const Token* Toks, unsigned Count);
+/* Read the given tokens followed by a semicolon instead of the input, until
+** EndReplay is called. The current tokens are saved and restored by
+** EndReplay. The tokens must not contain string literals or pragmas, and
+** their line infos are used, not taken over. Count must not be zero.
+*/
+
+void EndReplay (void);
+/* Stop replaying tokens and restore the tokens saved by ReplayTokens */
+
 void SkipTokens (const token_t* TokenList, unsigned TokenCount);
 /* Skip tokens until we reach TOK_CEOF or a token in the given token list.
 ** This routine is used for error recovery.
@@ -78,6 +78,9 @@ SegContext* GS = 0;
 /* Actual names for the segments */
 static StrStack SegmentNames[SEG_COUNT];
 
+/* Names saved by SaveSegNames */
+static char* SavedSegNames[SEG_COUNT];
+
 /* Address size for the segments */
 static Collection SegmentAddrSizes;
 
@@ -226,6 +229,34 @@ const char* GetSegName (segment_t Seg)
 
 
 
+void SaveSegNames (void)
+/* Remember the current segment names, so they can be restored by
+** RestoreSegNames.
+*/
+{
+    unsigned I;
+    for (I = 0; I < SEG_COUNT; ++I) {
+        xfree (SavedSegNames[I]);
+        SavedSegNames[I] = xstrdup (GetSegName ((segment_t) I));
+    }
+}
+
+
+
+void RestoreSegNames (void)
+/* Empty the segment name stacks and restore the names saved before */
+{
+    unsigned I;
+    for (I = 0; I < SEG_COUNT; ++I) {
+        while (SS_GetCount (&SegmentNames[I]) > 1) {
+            SS_Drop (&SegmentNames[I]);
+        }
+        SS_Set (&SegmentNames[I], SavedSegNames[I]);
+    }
+}
+
+
+
 /*****************************************************************************/
 /*                              Segment context                              */
 /*****************************************************************************/
@@ -263,6 +294,9 @@ SegContext* PushSegContext (SymEntry* Func)
     /* Create a new SegContext structure */
     CS = NewSegContext (Func);
 
+    /* Code for the new context is allocated from its pool */
+    CP_Use (CS->Code->Pool);
+
     /* Return the new struct */
     return CS;
 }
@@ -277,6 +311,7 @@ void PopSegContext (void)
 
     /* Pop the last segment and set it as current */
     CS = CollPop (&SegContextStack);
+    CP_Use (CS? CS->Code->Pool : 0);
 }
 
 
@@ -132,6 +132,14 @@ void PopSegName (segment_t Seg);
 const char* GetSegName (segment_t Seg);
 /* Get the name of the given segment */
 
+void SaveSegNames (void);
+/* Remember the current segment names, so they can be restored by
+** RestoreSegNames.
+*/
+
+void RestoreSegNames (void);
+/* Empty the segment name stacks and restore the names saved before */
+
 SegContext* PushSegContext (struct SymEntry* Func);
 /* Make the new segment context current but remember the old one */
 
@@ -239,6 +239,23 @@ void ShiftExpr (struct ExprDesc* Expr)
                 }
             }
 
+            /* If only the low byte of the result is used, shift just the low
+            ** byte of the lhs. This works for left shifts, and for right
+            ** shifts of chars, where the high byte is only the extension of
+            ** the low byte. Signed chars are only shifted this way by small
+            ** counts, because the code generator would sign extend them for
+            ** larger ones anyway.
+            */
+            if (Expr2.IVal < 8 && NarrowToByte (Expr, &Expr2) &&
+                (Tok == TOK_SHL                                  ||
+                 (SizeOf (Expr->Type) == SIZEOF_CHAR &&
+                  !IsTypeBitField (Expr->Type)       &&
+                  (IsSignUnsigned (Expr->Type) || Expr2.IVal <= 2)))) {
+                LoadLowByte (Expr, &Mark1);
+                GenFlags = CF_CHAR | CF_FORCECHAR | CF_CONST |
+                           (CG_TypeOf (Expr->Type) & CF_UNSIGNED);
+            }
+
         }
 
         /* Generate code */
@@ -44,7 +44,9 @@
 #include "asmcode.h"
 #include "asmlabel.h"
 #include "codegen.h"
+#include "codeinfo.h"
 #include "error.h"
+#include "expr.h"
 #include "funcdesc.h"
 #include "global.h"
 #include "litpool.h"
@@ -65,11 +67,17 @@
 
 
 
+static void StdFunc_abs (FuncDesc*, ExprDesc*);
+static void StdFunc_labs (FuncDesc*, ExprDesc*);
+static void StdFunc_memcmp (FuncDesc*, ExprDesc*);
 static void StdFunc_memcpy (FuncDesc*, ExprDesc*);
+static void StdFunc_memmove (FuncDesc*, ExprDesc*);
 static void StdFunc_memset (FuncDesc*, ExprDesc*);
+static void StdFunc_strchr (FuncDesc*, ExprDesc*);
 static void StdFunc_strcmp (FuncDesc*, ExprDesc*);
 static void StdFunc_strcpy (FuncDesc*, ExprDesc*);
 static void StdFunc_strlen (FuncDesc*, ExprDesc*);
+static void StdFunc_strncpy (FuncDesc*, ExprDesc*);
 
 
 
@@ -86,11 +94,17 @@ static struct StdFuncDesc {
     const char*         Name;
     void                (*Handler) (FuncDesc*, ExprDesc*);
 } StdFuncs[] = {
+    {   "abs",          StdFunc_abs             },
+    {   "labs",         StdFunc_labs            },
+    {   "memcmp",       StdFunc_memcmp          },
     {   "memcpy",       StdFunc_memcpy          },
+    {   "memmove",      StdFunc_memmove         },
     {   "memset",       StdFunc_memset          },
+    {   "strchr",       StdFunc_strchr          },
     {   "strcmp",       StdFunc_strcmp          },
     {   "strcpy",       StdFunc_strcpy          },
     {   "strlen",       StdFunc_strlen          },
+    {   "strncpy",      StdFunc_strncpy         },
 
 };
 #define FUNC_COUNT      (sizeof (StdFuncs) / sizeof (StdFuncs[0]))
@@ -106,6 +120,23 @@ struct ArgDesc {
     unsigned    Flags;          /* Code generation flags */
 };
 
+/* Relation of the source and destination area of memmove */
+enum {
+    MOVE_UNKNOWN,               /* Areas may overlap in an unknown way */
+    MOVE_ANY,                   /* Areas don't overlap */
+    MOVE_UP,                    /* Copy from the lowest address up */
+    MOVE_DOWN                   /* Copy from the highest address down */
+};
+
+/* Size and cycles of the argument setup for a call of a fastcall function
+** with constant arguments: Each pushed argument is loaded into the primary
+** and pushed, the last one is loaded into the primary.
+*/
+#define PUSH_ARG_SIZE           7U
+#define PUSH_ARG_CYCLES         (4U + GetFuncCycles ("pushax"))
+#define LOAD_ARG_SIZE           4U
+#define LOAD_ARG_CYCLES         4U
+
 
 
 /*****************************************************************************/
@@ -207,6 +238,315 @@ void AddCmpCodeIfSizeNot256 (const char* Code, long Size)
 
 
 
+static unsigned GetCallSize (unsigned PushedArgs)
+/* Return the size of a call to a fastcall library function with constant
+** arguments, including the argument setup.
+*/
+{
+    return PushedArgs * PUSH_ARG_SIZE + LOAD_ARG_SIZE + 3;
+}
+
+
+
+static unsigned GetCallCycles (unsigned PushedArgs, unsigned FuncCycles)
+/* Return the cycles of a call to a fastcall library function with constant
+** arguments, including the argument setup. FuncCycles are the cycles of the
+** function itself including the rts.
+*/
+{
+    return PushedArgs * PUSH_ARG_CYCLES + LOAD_ARG_CYCLES + 6 + FuncCycles;
+}
+
+
+
+static int PreferInline (unsigned Size, unsigned Cycles,
+                         unsigned CallSize, unsigned CallCycles)
+/* Return true if inline code with the given size and cycles should replace
+** a call of a library function. The decision uses the cycle weight or the
+** code size factor in the same way as for other code alternatives.
+*/
+{
+    unsigned long MaxSize;
+    unsigned      Weight = (unsigned) IS_Get (&CycleWeight);
+
+    if (Weight > 0) {
+        return GetCodeCost (Size, Cycles, Weight) <
+               GetCodeCost (CallSize, CallCycles, Weight);
+    }
+    MaxSize = (Size < CallSize)? Size : CallSize;
+    MaxSize = MaxSize * IS_Get (&CodeSizeFactor) / 100;
+    return Size <= MaxSize && (CallSize > MaxSize || Cycles < CallCycles);
+}
+
+
+
+static int GetMoveDir (const ExprDesc* Dest, const ExprDesc* Src, long Count)
+/* Check how Count bytes may be moved from one constant address to another.
+** Different objects don't overlap. Within the same object or for absolute
+** addresses, the offsets tell the direction. Return one of the MOVE_xxx
+** constants.
+*/
+{
+    long Diff;
+
+    if (ED_GetLoc (Dest) != ED_GetLoc (Src)) {
+        return MOVE_UNKNOWN;
+    }
+    switch (ED_GetLoc (Dest)) {
+
+        case E_LOC_ABS:
+            break;
+
+        case E_LOC_GLOBAL:
+        case E_LOC_STATIC:
+            if (Dest->Sym == 0 || Src->Sym == 0) {
+                return MOVE_UNKNOWN;
+            }
+            if (Dest->Sym != Src->Sym) {
+                return MOVE_ANY;
+            }
+            break;
+
+        default:
+            return MOVE_UNKNOWN;
+    }
+
+    Diff = Dest->IVal - Src->IVal;
+    if (Diff >= Count || -Diff >= Count) {
+        return MOVE_ANY;
+    }
+    return (Diff > 0)? MOVE_DOWN : MOVE_UP;
+}
+
+
+
+/*****************************************************************************/
+/*                                    abs                                    */
+/*****************************************************************************/
+
+
+
+static void StdFunc_absval (ExprDesc* Expr, const Type* ArgType,
+                            const char* FuncName)
+/* Handle the abs and labs functions */
+{
+    ArgDesc  Arg;
+    unsigned Label;
+    int      IsLong = (SizeOf (ArgType) == SizeOf (type_long));
+
+    /* Parse the argument. It is passed in the primary register */
+    ParseArg (&Arg, ArgType, Expr);
+
+    /* If the argument is constant, the result is also a constant */
+    if ((Arg.Flags & CF_CONST) != 0 && IS_Get (&Optimize)) {
+
+        long Val = Arg.Expr.IVal;
+
+        /* Calculate the absolute value, the most negative value stays */
+        ED_MakeConstAbs (Expr, (Val < 0)? -Val : Val, ArgType);
+        LimitExprValue (Expr, 0);
+
+        /* Bail out, no need for further processing */
+        goto ExitPoint;
+    }
+
+    /* Load a constant argument */
+    if (Arg.Flags & CF_CONST) {
+        LoadExpr (CF_NONE, &Arg.Expr);
+    }
+
+    /* We still need to append deferred inc/dec before calling into the function */
+    DoDeferred (SQP_KEEP_EAX, &Arg.Expr);
+
+    /* The function result is an rvalue in the primary register */
+    ED_FinalizeRValLoad (Expr);
+    Expr->Type = GetFuncReturnType (Expr->Type);
+
+    if (IS_Get (&InlineStdFuncs)) {
+
+        /* An unsigned argument that was promoted cannot be negative, so
+        ** the result is the argument itself.
+        */
+        if (IsClassInt (Arg.Type) && IsSignUnsigned (Arg.Type) &&
+            SizeOf (Arg.Type) < SizeOf (ArgType)) {
+            goto ExitPoint;
+        }
+
+        /* Test the sign and call the negation routine of the runtime only
+        ** for negative values. This saves the call of the library function.
+        ** The code is 7 bytes instead of 3 for the call, and needs 5 or 6
+        ** cycles for positive values instead of 17 or 18.
+        */
+        if (PreferInline (7, IsLong? 6 : 5, 3, IsLong? 18 : 17)) {
+
+            Label = GetLocalLabel ();
+            if (IsLong) {
+                AddCodeLine ("ldy sreg+1");
+                AddCodeLine ("bpl %s", LocalLabelName (Label));
+                AddCodeLine ("jsr negeax");
+            } else {
+                AddCodeLine ("cpx #$00");
+                AddCodeLine ("bpl %s", LocalLabelName (Label));
+                AddCodeLine ("jsr negax");
+            }
+            g_defcodelabel (Label);
+
+            /* Bail out, no need for further processing */
+            goto ExitPoint;
+        }
+    }
+
+    /* Call the library function */
+    AddCodeLine ("%s _%s", CrtJsrOrJsl(), FuncName);
+
+ExitPoint:
+    /* We expect the closing brace */
+    ConsumeRParen ();
+}
+
+
+
+static void StdFunc_abs (FuncDesc* F attribute ((unused)), ExprDesc* Expr)
+/* Handle the abs function */
+{
+    /* Argument type: (int) */
+    StdFunc_absval (Expr, type_int, Func_abs);
+}
+
+
+
+static void StdFunc_labs (FuncDesc* F attribute ((unused)), ExprDesc* Expr)
+/* Handle the labs function */
+{
+    /* Argument type: (long) */
+    StdFunc_absval (Expr, type_long, Func_labs);
+}
+
+
+
+/*****************************************************************************/
+/*                                  memcmp                                   */
+/*****************************************************************************/
+
+
+
+static void StdFunc_memcmp (FuncDesc* F attribute ((unused)), ExprDesc* Expr)
+/* Handle the memcmp function */
+{
+    /* Argument types: (const void*, const void*, size_t) */
+    static const Type* Arg1Type = type_c_void_p;
+    static const Type* Arg2Type = type_c_void_p;
+    static const Type* Arg3Type = type_size_t;
+
+    ArgDesc  Arg1, Arg2, Arg3;
+    unsigned ParamSize = 0;
+    unsigned Loop, Diff, Fin;           /* Labels */
+
+    /* Argument #1 */
+    ParseArg (&Arg1, Arg1Type, Expr);
+    g_push (Arg1.Flags, Arg1.Expr.IVal);
+    GetCodePos (&Arg1.End);
+    ParamSize += SizeOf (Arg1Type);
+    ConsumeComma ();
+
+    /* Argument #2 */
+    ParseArg (&Arg2, Arg2Type, Expr);
+    g_push (Arg2.Flags, Arg2.Expr.IVal);
+    GetCodePos (&Arg2.End);
+    ParamSize += SizeOf (Arg2Type);
+    ConsumeComma ();
+
+    /* Argument #3. Since memcmp is a fastcall function, we must load the
+    ** arg into the primary if it is not already there. This parameter is
+    ** also ignored for the calculation of the parameter size, since it is
+    ** not passed via the stack.
+    */
+    ParseArg (&Arg3, Arg3Type, Expr);
+    if (Arg3.Flags & CF_CONST) {
+        LoadExpr (CF_NONE, &Arg3.Expr);
+    }
+
+    /* We still need to append deferred inc/dec before calling into the function */
+    DoDeferred (SQP_KEEP_EAX, &Arg3.Expr);
+
+    /* Emit the actual function call. This will also cleanup the stack. */
+    g_call (CF_FIXARGC, Func_memcmp, ParamSize, CrtIsLong());
+
+    /* The function result is an rvalue in the primary register */
+    ED_FinalizeRValLoad (Expr);
+    Expr->Type = GetFuncReturnType (Expr->Type);
+
+    if (IS_Get (&InlineStdFuncs)) {
+
+        /* If the count is a constant of at most 256, and both areas can be
+        ** addressed with an index register, compare the bytes inline. The
+        ** code is 26 bytes for absolute addresses and needs 17 cycles per
+        ** byte, the library function needs 21 cycles per byte after a setup
+        ** of about 125 cycles.
+        */
+        if (ED_IsConstAbsInt (&Arg3.Expr) &&
+            Arg3.Expr.IVal > 0 && Arg3.Expr.IVal <= 256 &&
+            (ED_IsConstAddr (&Arg1.Expr) || ED_IsZPInd (&Arg1.Expr)) &&
+            (ED_IsConstAddr (&Arg2.Expr) || ED_IsZPInd (&Arg2.Expr))) {
+
+            unsigned    Count = (unsigned) Arg3.Expr.IVal;
+            unsigned    ZPInd = ED_IsZPInd (&Arg1.Expr) + ED_IsZPInd (&Arg2.Expr);
+            const char* Load;
+            const char* Compare;
+
+            if (PreferInline (26 - ZPInd - (Count == 256? 2 : 0),
+                              8 + Count * (17 + ZPInd),
+                              GetCallSize (2),
+                              GetCallCycles (2, 125 + Count * 21))) {
+
+                if (ED_IsZPInd (&Arg1.Expr)) {
+                    Load = "lda (%s),y";
+                } else {
+                    Load = "lda %s,y";
+                }
+                if (ED_IsZPInd (&Arg2.Expr)) {
+                    Compare = "cmp (%s),y";
+                } else {
+                    Compare = "cmp %s,y";
+                }
+
+                /* Drop the generated code */
+                RemoveCode (&Arg1.Expr.Start);
+
+                /* We need labels */
+                Loop = GetLocalLabel ();
+                Diff = GetLocalLabel ();
+                Fin  = GetLocalLabel ();
+
+                /* Generate memcmp code. The result is the same as that of
+                ** the library function.
+                */
+                AddCodeLine ("ldy #$00");
+                g_defcodelabel (Loop);
+                AddCodeLine (Load, ED_GetLabelName (&Arg1.Expr, 0));
+                AddCodeLine (Compare, ED_GetLabelName (&Arg2.Expr, 0));
+                AddCodeLine ("bne %s", LocalLabelName (Diff));
+                AddCodeLine ("iny");
+                AddCmpCodeIfSizeNot256 ("cpy #$%02X", Count);
+                AddCodeLine ("bne %s", LocalLabelName (Loop));
+                AddCodeLine ("lda #$00");
+                AddCodeLine ("tax");
+                AddCodeLine ("beq %s", LocalLabelName (Fin));
+                g_defcodelabel (Diff);
+                AddCodeLine ("ldx #$01");
+                AddCodeLine ("bcs %s", LocalLabelName (Fin));
+                AddCodeLine ("ldx #$FF");
+                g_defcodelabel (Fin);
+            }
+        }
+    }
+
+    /* We expect the closing brace */
+    ConsumeRParen ();
+}
+
+
+
 /*****************************************************************************/
 /*                                  memcpy                                   */
 /*****************************************************************************/
@@ -549,6 +889,126 @@ ExitPoint:
 
 
 
+/*****************************************************************************/
+/*                                  memmove                                  */
+/*****************************************************************************/
+
+
+
+static void StdFunc_memmove (FuncDesc* F attribute ((unused)), ExprDesc* Expr)
+/* Handle the memmove function */
+{
+    /* Argument types: (void*, const void*, size_t) */
+    static const Type* Arg1Type = type_void_p;
+    static const Type* Arg2Type = type_c_void_p;
+    static const Type* Arg3Type = type_size_t;
+
+    ArgDesc  Arg1, Arg2, Arg3;
+    unsigned ParamSize = 0;
+    unsigned Label;
+    int      Dir;
+
+    /* Argument #1 */
+    ParseArg (&Arg1, Arg1Type, Expr);
+    g_push (Arg1.Flags, Arg1.Expr.IVal);
+    GetCodePos (&Arg1.End);
+    ParamSize += SizeOf (Arg1Type);
+    ConsumeComma ();
+
+    /* Argument #2 */
+    ParseArg (&Arg2, Arg2Type, Expr);
+    g_push (Arg2.Flags, Arg2.Expr.IVal);
+    GetCodePos (&Arg2.End);
+    ParamSize += SizeOf (Arg2Type);
+    ConsumeComma ();
+
+    /* Argument #3. Since memmove is a fastcall function, we must load the
+    ** arg into the primary if it is not already there. This parameter is
+    ** also ignored for the calculation of the parameter size, since it is
+    ** not passed via the stack.
+    */
+    ParseArg (&Arg3, Arg3Type, Expr);
+    if (Arg3.Flags & CF_CONST) {
+        LoadExpr (CF_NONE, &Arg3.Expr);
+    }
+
+    /* We still need to append deferred inc/dec before calling into the function */
+    DoDeferred (SQP_KEEP_EAX, &Arg3.Expr);
+
+    /* Emit the actual function call. This will also cleanup the stack. */
+    g_call (CF_FIXARGC, Func_memmove, ParamSize, CrtIsLong());
+
+    if (IS_Get (&InlineStdFuncs)) {
+
+        /* If the count is a constant of at most 256, both areas have constant
+        ** addresses, and it is known if and how they overlap, copy the bytes
+        ** inline in the right direction. The code is smaller than the call,
+        ** so there's no need to check the code size factor.
+        */
+        if (ED_IsConstAbsInt (&Arg3.Expr) &&
+            Arg3.Expr.IVal > 0 && Arg3.Expr.IVal <= 256 &&
+            ED_IsConstAddr (&Arg1.Expr) && ED_IsConstAddr (&Arg2.Expr) &&
+            (Dir = GetMoveDir (&Arg1.Expr, &Arg2.Expr, Arg3.Expr.IVal)) != MOVE_UNKNOWN) {
+
+            /* Drop the generated code */
+            RemoveCode (&Arg1.Expr.Start);
+
+            /* We need a label */
+            Label = GetLocalLabel ();
+
+            /* Generate memmove code */
+            if (Dir == MOVE_UP || (Dir == MOVE_ANY && Arg3.Expr.IVal > 129)) {
+
+                AddCodeLine ("ldy #$00");
+                g_defcodelabel (Label);
+                AddCodeLine ("lda %s,y", ED_GetLabelName (&Arg2.Expr, 0));
+                AddCodeLine ("sta %s,y", ED_GetLabelName (&Arg1.Expr, 0));
+                AddCodeLine ("iny");
+                AddCmpCodeIfSizeNot256 ("cpy #$%02X", Arg3.Expr.IVal);
+                AddCodeLine ("bne %s", LocalLabelName (Label));
+
+            } else if (Arg3.Expr.IVal <= 129) {
+
+                AddCodeLine ("ldy #$%02X", (unsigned char) (Arg3.Expr.IVal-1));
+                g_defcodelabel (Label);
+                AddCodeLine ("lda %s,y", ED_GetLabelName (&Arg2.Expr, 0));
+                AddCodeLine ("sta %s,y", ED_GetLabelName (&Arg1.Expr, 0));
+                AddCodeLine ("dey");
+                AddCodeLine ("bpl %s", LocalLabelName (Label));
+
+            } else {
+
+                AddCodeLine ("ldy #$%02X", (unsigned char) Arg3.Expr.IVal);
+                g_defcodelabel (Label);
+                AddCodeLine ("dey");
+                AddCodeLine ("lda %s,y", ED_GetLabelName (&Arg2.Expr, 0));
+                AddCodeLine ("sta %s,y", ED_GetLabelName (&Arg1.Expr, 0));
+                AddCodeLine ("tya");
+                AddCodeLine ("bne %s", LocalLabelName (Label));
+
+            }
+
+            /* memmove returns the address, so the result is actually identical
+            ** to the first argument.
+            */
+            *Expr = Arg1.Expr;
+
+            /* Bail out, no need for further processing */
+            goto ExitPoint;
+        }
+    }
+
+    /* The function result is an rvalue in the primary register */
+    ED_FinalizeRValLoad (Expr);
+    Expr->Type = GetFuncReturnType (Expr->Type);
+
+ExitPoint:
+    /* We expect the closing brace */
+    ConsumeRParen ();
+}
+
+
+
 /*****************************************************************************/
 /*                                  memset                                   */
 /*****************************************************************************/
@@ -774,6 +1234,125 @@ ExitPoint:
 
 
 
+/*****************************************************************************/
+/*                                  strchr                                   */
+/*****************************************************************************/
+
+
+
+static void StdFunc_strchr (FuncDesc* F attribute ((unused)), ExprDesc* Expr)
+/* Handle the strchr function */
+{
+    /* Argument types: (const char*, int) */
+    static const Type* Arg1Type = type_c_char_p;
+    static const Type* Arg2Type = type_int;
+
+    ArgDesc  Arg1, Arg2;
+    unsigned ParamSize = 0;
+    long     ECount;
+    unsigned Loop, Found, Fin;          /* Labels */
+
+    /* Argument #1 */
+    ParseArg (&Arg1, Arg1Type, Expr);
+    g_push (Arg1.Flags, Arg1.Expr.IVal);
+    GetCodePos (&Arg1.End);
+    ParamSize += SizeOf (Arg1Type);
+    ConsumeComma ();
+
+    /* Argument #2. Since strchr is a fastcall function, we must load the
+    ** arg into the primary if it is not already there. This parameter is
+    ** also ignored for the calculation of the parameter size, since it is
+    ** not passed via the stack.
+    */
+    ParseArg (&Arg2, Arg2Type, Expr);
+    if (Arg2.Flags & CF_CONST) {
+        LoadExpr (CF_NONE, &Arg2.Expr);
+    }
+
+    /* We still need to append deferred inc/dec before calling into the function */
+    DoDeferred (SQP_KEEP_EAX, &Arg2.Expr);
+
+    /* Emit the actual function call. This will also cleanup the stack. */
+    g_call (CF_FIXARGC, Func_strchr, ParamSize, CrtIsLong());
+
+    /* The function result is an rvalue in the primary register */
+    ED_FinalizeRValLoad (Expr);
+    Expr->Type = GetFuncReturnType (Expr->Type);
+
+    /* Get the element count of argument 1 if it is an array */
+    ECount = ArrayElementCount (&Arg1);
+
+    if (IS_Get (&InlineStdFuncs)) {
+
+        /* If the character is a constant, and the string can be addressed
+        ** with an index register, search inline. Since we cannot know how
+        ** long the string actually is, this is only safe for arrays smaller
+        ** than 256, unless requested on the command line. The code is 24
+        ** bytes for an absolute address and needs 15 cycles per character,
+        ** the library function needs 17 cycles per character after a setup
+        ** of about 66 cycles. A string is assumed to fill half of its array.
+        */
+        if (ED_IsConstAbsInt (&Arg2.Expr) &&
+            (ED_IsConstAddr (&Arg1.Expr) || ED_IsZPInd (&Arg1.Expr)) &&
+            (IS_Get (&EagerlyInlineFuncs) ||
+            (ECount != UNSPECIFIED && ECount < 256))) {
+
+            int      Reg   = ED_IsZPInd (&Arg1.Expr);
+            unsigned Chars = (ECount != UNSPECIFIED && ECount < 256)? ECount / 2 : 16;
+
+            if (PreferInline (24 - Reg, 14 + Chars * (15 + Reg),
+                              GetCallSize (1),
+                              GetCallCycles (1, 66 + Chars * 17))) {
+
+                /* Drop the generated code */
+                RemoveCode (&Arg1.Expr.Start);
+
+                /* We need labels */
+                Loop  = GetLocalLabel ();
+                Found = GetLocalLabel ();
+                Fin   = GetLocalLabel ();
+
+                /* Generate strchr code */
+                AddCodeLine ("ldy #$00");
+                g_defcodelabel (Loop);
+                if (Reg) {
+                    AddCodeLine ("lda (%s),y", ED_GetLabelName (&Arg1.Expr, 0));
+                } else {
+                    AddCodeLine ("lda %s,y", ED_GetLabelName (&Arg1.Expr, 0));
+                }
+                AddCodeLine ("cmp #$%02X", (unsigned char) Arg2.Expr.IVal);
+                AddCodeLine ("beq %s", LocalLabelName (Found));
+                AddCodeLine ("iny");
+                AddCodeLine ("tax");
+                AddCodeLine ("bne %s", LocalLabelName (Loop));
+
+                /* Not found, A and X are zero */
+                AddCodeLine ("beq %s", LocalLabelName (Fin));
+
+                /* Found, add the index to the address */
+                g_defcodelabel (Found);
+                AddCodeLine ("tya");
+                AddCodeLine ("clc");
+                if (Reg) {
+                    AddCodeLine ("adc %s", ED_GetLabelName (&Arg1.Expr, 0));
+                    AddCodeLine ("ldx %s", ED_GetLabelName (&Arg1.Expr, 1));
+                } else {
+                    AddCodeLine ("adc #<(%s)", ED_GetLabelName (&Arg1.Expr, 0));
+                    AddCodeLine ("ldx #>(%s)", ED_GetLabelName (&Arg1.Expr, 0));
+                }
+                AddCodeLine ("bcc %s", LocalLabelName (Fin));
+                AddCodeLine ("inx");
+                g_defcodelabel (Fin);
+            }
+        }
+    }
+
+    /* We expect the closing brace */
+    ConsumeRParen ();
+}
+
+
+
 /*****************************************************************************/
 /*                                  strcmp                                   */
 /*****************************************************************************/
@@ -1373,6 +1952,138 @@ ExitPoint:
 
 
 
+/*****************************************************************************/
+/*                                  strncpy                                  */
+/*****************************************************************************/
+
+
+
+static void StdFunc_strncpy (FuncDesc* F attribute ((unused)), ExprDesc* Expr)
+/* Handle the strncpy function */
+{
+    /* Argument types: (char*, const char*, size_t) */
+    static const Type* Arg1Type = type_char_p;
+    static const Type* Arg2Type = type_c_char_p;
+    static const Type* Arg3Type = type_size_t;
+
+    ArgDesc  Arg1, Arg2, Arg3;
+    unsigned ParamSize = 0;
+    unsigned L1, L2, L3, Fin;           /* Labels */
+
+    /* Argument #1 */
+    ParseArg (&Arg1, Arg1Type, Expr);
+    g_push (Arg1.Flags, Arg1.Expr.IVal);
+    GetCodePos (&Arg1.End);
+    ParamSize += SizeOf (Arg1Type);
+    ConsumeComma ();
+
+    /* Argument #2 */
+    ParseArg (&Arg2, Arg2Type, Expr);
+    g_push (Arg2.Flags, Arg2.Expr.IVal);
+    GetCodePos (&Arg2.End);
+    ParamSize += SizeOf (Arg2Type);
+    ConsumeComma ();
+
+    /* Argument #3. Since strncpy is a fastcall function, we must load the
+    ** arg into the primary if it is not already there. This parameter is
+    ** also ignored for the calculation of the parameter size, since it is
+    ** not passed via the stack.
+    */
+    ParseArg (&Arg3, Arg3Type, Expr);
+    if (Arg3.Flags & CF_CONST) {
+        LoadExpr (CF_NONE, &Arg3.Expr);
+    }
+
+    /* We still need to append deferred inc/dec before calling into the function */
+    DoDeferred (SQP_KEEP_EAX, &Arg3.Expr);
+
+    /* Emit the actual function call. This will also cleanup the stack. */
+    g_call (CF_FIXARGC, Func_strncpy, ParamSize, CrtIsLong());
+
+    if (IS_Get (&InlineStdFuncs)) {
+
+        /* If the count is a constant of at most 256, and both areas can be
+        ** addressed with an index register, copy inline and fill the rest
+        ** with zeroes. The code is 25 bytes for absolute addresses and needs
+        ** 18 cycles per byte, the library function needs 23 cycles per byte
+        ** after a setup of about 122 cycles.
+        */
+        if (ED_IsConstAbsInt (&Arg3.Expr) &&
+            Arg3.Expr.IVal > 0 && Arg3.Expr.IVal <= 256 &&
+            (ED_IsConstAddr (&Arg1.Expr) || ED_IsZPInd (&Arg1.Expr)) &&
+            (ED_IsConstAddr (&Arg2.Expr) || ED_IsZPInd (&Arg2.Expr))) {
+
+            unsigned    Count = (unsigned) Arg3.Expr.IVal;
+            int         Reg1  = ED_IsZPInd (&Arg1.Expr);
+            int         Reg2  = ED_IsZPInd (&Arg2.Expr);
+            const char* Load;
+            const char* Store;
+
+            if (PreferInline (25 - 2 * Reg1 - Reg2 - (Count == 256? 4 : 0),
+                              2 + Count * (18 + Reg1 + Reg2),
+                              GetCallSize (2),
+                              GetCallCycles (2, 122 + Count * 23))) {
+
+                if (Reg2) {
+                    Load = "lda (%s),y";
+                } else {
+                    Load = "lda %s,y";
+                }
+                if (Reg1) {
+                    Store = "sta (%s),y";
+                } else {
+                    Store = "sta %s,y";
+                }
+
+                /* Drop the generated code */
+                RemoveCode (&Arg1.Expr.Start);
+
+                /* We need labels */
+                L1  = GetLocalLabel ();
+                L2  = GetLocalLabel ();
+                L3  = GetLocalLabel ();
+                Fin = GetLocalLabel ();
+
+                /* Generate strncpy code. Copy up to the terminator ... */
+                AddCodeLine ("ldy #$00");
+                g_defcodelabel (L1);
+                AddCodeLine (Load, ED_GetLabelName (&Arg2.Expr, 0));
+                AddCodeLine (Store, ED_GetLabelName (&Arg1.Expr, 0));
+                AddCodeLine ("beq %s", LocalLabelName (L3));
+                AddCodeLine ("iny");
+                AddCmpCodeIfSizeNot256 ("cpy #$%02X", Count);
+                AddCodeLine ("bne %s", LocalLabelName (L1));
+                AddCodeLine ("beq %s", LocalLabelName (Fin));
+
+                /* ... and fill the rest with zeroes, A is zero here */
+                g_defcodelabel (L2);
+                AddCodeLine (Store, ED_GetLabelName (&Arg1.Expr, 0));
+                g_defcodelabel (L3);
+                AddCodeLine ("iny");
+                AddCmpCodeIfSizeNot256 ("cpy #$%02X", Count);
+                AddCodeLine ("bne %s", LocalLabelName (L2));
+                g_defcodelabel (Fin);
+
+                /* strncpy returns argument #1 */
+                *Expr = Arg1.Expr;
+
+                /* Bail out, no need for further processing */
+                goto ExitPoint;
+            }
+        }
+    }
+
+    /* The function result is an rvalue in the primary register */
+    ED_FinalizeRValLoad (Expr);
+    Expr->Type = GetFuncReturnType (Expr->Type);
+
+ExitPoint:
+    /* We expect the closing brace */
+    ConsumeRParen ();
+}
+
+
+
 /*****************************************************************************/
 /*                                   Code                                    */
 /*****************************************************************************/
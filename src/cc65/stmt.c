@@ -316,7 +316,12 @@ static void ReturnStatement (void)
     NextToken ();
     if (CurTok.Tok != TOK_SEMI) {
 
-        /* Evaluate the return expression */
+        /* Evaluate the return expression. If the function returns a char,
+        ** only the low byte of the value is used.
+        */
+        if (!F_HasVoidReturn (CurrentFunc)) {
+            ED_RequireByteFor (&Expr, F_GetReturnType (CurrentFunc));
+        }
         hie0 (&Expr);
 
         /* If we return something in a function with void or incomplete return
@@ -36,6 +36,7 @@
 #include <string.h>
 
 /* common */
+#include "hashfunc.h"
 #include "xmalloc.h"
 
 /* cc65 */
@@ -64,6 +65,7 @@ SymEntry* NewSymEntry (const char* Name, unsigned Flags)
 
     /* Initialize the entry */
     E->NextHash = 0;
+    E->Hash     = HashStr (Name);
     E->PrevSym  = 0;
     E->NextSym  = 0;
     E->Owner    = 0;
@@ -152,6 +154,7 @@ void DumpSymEntry (FILE* F, const SymEntry* E)
         { "SC_GOTO_IND",    SC_GOTO_IND         },
         { "SC_LOCALSCOPE",  SC_LOCALSCOPE       },
         { "SC_NOINLINEDEF", SC_NOINLINEDEF      },
+        { "SC_UNREACHABLE", SC_UNREACHABLE      },
     };
 
     unsigned I;
@@ -223,10 +226,11 @@ int SymIsOutputFunc (const SymEntry* Sym)
 /* Return true if this is a function that must be output */
 {
     /* Symbol must be a function which is defined and either extern or
-    ** static and referenced.
+    ** static and referenced by code or data that is output.
     */
     return IsTypeFunc (Sym->Type)                       &&
            SymIsDef (Sym)                               &&
+           (Sym->Flags & SC_UNREACHABLE) == 0           &&
            ((Sym->Flags & SC_REF) ||
             (Sym->Flags & SC_STORAGEMASK) != SC_STATIC);
 }
@@ -307,6 +311,24 @@ void SymCvtRegVarToAuto (SymEntry* Sym)
 
 
 
+void SymCvtAutoToRegVar (SymEntry* Sym, int Reg)
+/* Convert an auto variable to a register variable with the given offset in
+** the register bank.
+*/
+{
+    /* The stack location is used as the save area */
+    int Offs = Sym->V.Offs;
+
+    /* Change the storage class */
+    Sym->Flags = (Sym->Flags & ~SC_STORAGEMASK) | SC_REGISTER;
+
+    /* Set the offsets */
+    Sym->V.R.SaveOffs = Offs;
+    Sym->V.R.RegOffs  = Reg;
+}
+
+
+
 void SymChangeType (SymEntry* Sym, const Type* T)
 /* Change the type of the given symbol */
 {
@@ -155,6 +155,9 @@ struct CodeEntry;
 #define SC_INLINE       0x10000000U     /* Inline function */
 #define SC_NORETURN     0x20000000U     /* Noreturn function */
 
+/* Status set at the end of the translation unit */
+#define SC_UNREACHABLE  0x40000000U     /* Static symbol that is never used */
+
 
 
 /* Label definition or reference */
@@ -172,6 +175,7 @@ struct DefOrRef {
 typedef struct SymEntry SymEntry;
 struct SymEntry {
     SymEntry*                   NextHash; /* Next entry in hash list */
+    unsigned                    Hash;     /* Full hash value of the name */
     SymEntry*                   PrevSym;  /* Previous symbol in dl list */
     SymEntry*                   NextSym;  /* Next symbol double linked list */
     struct SymTable*            Owner;    /* Symbol table the symbol is in */
@@ -206,6 +210,7 @@ struct SymEntry {
             struct LiteralPool* LitPool;  /* Literal pool for this function */
             struct SymEntry*    WrappedCall;        /* Pointer to the WrappedCall */
             unsigned int        WrappedCallData;    /* The WrappedCall's user data */
+            struct InlineFunc*  Inline;   /* Body for inlining or NULL */
         } F;
 
         /* Label name for static symbols */
@@ -386,6 +391,11 @@ void SymSetAsmName (SymEntry* Sym);
 void SymCvtRegVarToAuto (SymEntry* Sym);
 /* Convert a register variable to an auto variable */
 
+void SymCvtAutoToRegVar (SymEntry* Sym, int Reg);
+/* Convert an auto variable to a register variable with the given offset in
+** the register bank.
+*/
+
 void SymChangeType (SymEntry* Sym, const Type* T);
 /* Change the type of the given symbol */
 
@@ -71,21 +71,25 @@
 /*****************************************************************************/
 
 /* An empty symbol table */
+static SymEntry* EmptySymTabSlot[1];
 SymTable        EmptySymTab = {
-    0,          /* PrevTab */
-    0,          /* SymHead */
-    0,          /* SymTail */
-    0,          /* SymCount */
-    1,          /* Size */
-    { 0 }       /* Tab[1] */
+    0,                  /* PrevTab */
+    0,                  /* SymHead */
+    0,                  /* SymTail */
+    0,                  /* SymCount */
+    1,                  /* Size */
+    EmptySymTabSlot     /* Tab */
 };
 
-/* Symbol table sizes */
+/* Initial symbol table sizes. A table grows when the average length of its
+** hash chains would exceed SYMTAB_LOAD.
+*/
 #define SYMTAB_SIZE_GLOBAL      211U
 #define SYMTAB_SIZE_FUNCTION     29U
 #define SYMTAB_SIZE_BLOCK        13U
 #define SYMTAB_SIZE_STRUCT       19U
 #define SYMTAB_SIZE_LABEL         7U
+#define SYMTAB_LOAD               2U
 
 /* The current and root symbol tables */
 static unsigned         LexLevelDepth   = 0;    /* For safety checks */
@@ -113,7 +117,7 @@ static SymTable* NewSymTable (unsigned Size)
     unsigned I;
 
     /* Allocate memory for the table */
-    SymTable* S = xmalloc (sizeof (SymTable) + (Size-1) * sizeof (SymEntry*));
+    SymTable* S = xmalloc (sizeof (SymTable));
 
     /* Initialize the symbol table structure */
     S->PrevTab  = 0;
@@ -121,6 +125,7 @@ static SymTable* NewSymTable (unsigned Size)
     S->SymTail  = 0;
     S->SymCount = 0;
     S->Size     = Size;
+    S->Tab      = xmalloc (Size * sizeof (SymEntry*));
     for (I = 0; I < Size; ++I) {
         S->Tab[I] = 0;
     }
@@ -143,10 +148,41 @@ static void FreeSymTable (SymTable* S)
     }
 
     /* Free the table itself */
+    xfree (S->Tab);
     xfree (S);
 }
 
 
+
+static void GrowSymTable (SymTable* S)
+/* Make the hash table of S larger. The symbols are moved into the new table
+** using their stored hash values.
+*/
+{
+    unsigned   I;
+    unsigned   Size = S->Size * 2 + 1;
+    SymEntry** Tab  = xmalloc (Size * sizeof (SymEntry*));
+
+    for (I = 0; I < Size; ++I) {
+        Tab[I] = 0;
+    }
+    for (I = 0; I < S->Size; ++I) {
+        SymEntry* E = S->Tab[I];
+        while (E) {
+            SymEntry* Next = E->NextHash;
+            unsigned  Slot = E->Hash % Size;
+            E->NextHash = Tab[Slot];
+            Tab[Slot]   = E;
+            E = Next;
+        }
+    }
+    xfree (S->Tab);
+
+    S->Size = Size;
+    S->Tab  = Tab;
+}
+
+
 /*****************************************************************************/
 /*                         Check symbols in a table                          */
 /*****************************************************************************/
@@ -341,6 +377,7 @@ void LeaveGlobalLevel (void)
         if (DebugTableFile != stdout && fclose (DebugTableFile) != 0) {
             Error ("Error closing table dump file '%s': %s", SB_GetConstBuf(&DebugTableName), strerror (errno));
         }
+        DebugTableFile = 0;
     }
 
     /* Don't delete the symbol and struct tables! */
@@ -353,6 +390,29 @@ void LeaveGlobalLevel (void)
 
 
 
+void DoneSymTab (void)
+/* Leave all lexical levels left open by a compile with errors and forget
+** the symbol tables, so that EnterGlobalLevel may be called again.
+*/
+{
+    while (LexLevelDepth > 0) {
+        PopLexicalLevel ();
+    }
+    SymTab0     = SymTab = 0;
+    TagTab0     = TagTab = 0;
+    FieldTab    = 0;
+    LabelTab    = 0;
+    SPAdjustTab = 0;
+    FailSafeTab = 0;
+
+    if (DebugTableFile != 0 && DebugTableFile != stdout) {
+        fclose (DebugTableFile);
+    }
+    DebugTableFile = 0;
+}
+
+
+
 void EnterFunctionLevel (void)
 /* Enter function lexical level */
 {
@@ -543,8 +603,8 @@ static SymEntry* FindSymInTable (const SymTable* T, const char* Name, unsigned H
     /* Get the start of the hash chain */
     SymEntry* E = T->Tab [Hash % T->Size];
     while (E) {
-        /* Compare the name */
-        if (strcmp (E->Name, Name) == 0) {
+        /* Compare the hash and the name */
+        if (E->Hash == Hash && strcmp (E->Name, Name) == 0) {
             /* Found */
             return E;
         }
@@ -810,8 +870,12 @@ static int HandleSymRedefinition (SymEntry* Sym, const Type* T, unsigned Flags)
 static void AddSymEntry (SymTable* T, SymEntry* S)
 /* Add a symbol to a symbol table */
 {
-    /* Get the hash value for the name */
-    unsigned Hash = HashStr (S->Name) % T->Size;
+    unsigned Slot;
+
+    /* Make the table larger if the hash chains get too long */
+    if (T->SymCount >= T->Size * SYMTAB_LOAD) {
+        GrowSymTable (T);
+    }
 
     /* Insert the symbol into the list of all symbols in this level */
     if (T->SymTail) {
@@ -826,8 +890,9 @@ static void AddSymEntry (SymTable* T, SymEntry* S)
     ++T->SymCount;
 
     /* Insert the symbol into the hash chain */
-    S->NextHash  = T->Tab[Hash];
-    T->Tab[Hash] = S;
+    Slot = S->Hash % T->Size;
+    S->NextHash  = T->Tab[Slot];
+    T->Tab[Slot] = S;
 
     /* Tell the symbol in which table it is */
     S->Owner = T;
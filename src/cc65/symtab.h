@@ -59,7 +59,7 @@ struct SymTable {
     SymEntry*           SymTail;        /* Double linked list of symbols */
     unsigned            SymCount;       /* Count of symbols in this table */
     unsigned            Size;           /* Size of table */
-    SymEntry*           Tab[1];         /* Actual table, dynamically allocated */
+    SymEntry**          Tab;            /* Actual table, dynamically allocated */
 };
 
 /* An empty symbol table */
@@ -109,6 +109,11 @@ void EnterGlobalLevel (void);
 void LeaveGlobalLevel (void);
 /* Leave the program global lexical level */
 
+void DoneSymTab (void);
+/* Leave all lexical levels left open by a compile with errors and forget
+** the symbol tables, so that EnterGlobalLevel may be called again.
+*/
+
 void EnterFunctionLevel (void);
 /* Enter function lexical level */
 
@@ -319,11 +319,21 @@ void TypeConversion (ExprDesc* Expr, const Type* NewType)
 void TypeCast (ExprDesc* Expr)
 /* Handle an explicit cast. */
 {
-    Type    NewType[MAXTYPELEN];
+    Type     NewType[MAXTYPELEN];
+    unsigned NeedByte = Expr->Flags & E_NEED_BYTE;
 
     /* Read the type enclosed in parentheses */
     ParseType (NewType);
 
+    /* A cast to an integer type keeps the low byte of the value, and a cast
+    ** to a char needs nothing else. So only the low byte of the operand is
+    ** used in these cases.
+    */
+    if (!IsClassInt (NewType)) {
+        Expr->Flags &= ~E_NEED_BYTE;
+    }
+    ED_RequireByteFor (Expr, NewType);
+
     /* Read the expression we have to cast */
     hie10 (Expr);
 
@@ -359,6 +369,9 @@ void TypeCast (ExprDesc* Expr)
         Expr->Flags |= E_EVAL_MAYBE_UNUSED;
     }
 
+    /* The hint of the cast applies to its result again */
+    Expr->Flags = (Expr->Flags & ~E_NEED_BYTE) | NeedByte;
+
     /* The result is always an rvalue */
     ED_MarkExprAsRVal (Expr);
 }
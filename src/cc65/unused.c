@@ -0,0 +1,457 @@
+/*****************************************************************************/
+/*                                                                           */
+/*                                 unused.c                                  */
+/*                                                                           */
+/*            Removal of unused static functions and data objects            */
+/*                                                                           */
+/*                                                                           */
+/*                                                                           */
+/* Copyright 2026 The cc65 Authors                                           */
+/*                                                                           */
+/*                                                                           */
+/* This software is provided 'as-is', without any expressed or implied       */
+/* warranty.  In no event will the authors be held liable for any damages    */
+/* arising from the use of this software.                                    */
+/*                                                                           */
+/* Permission is granted to anyone to use this software for any purpose,     */
+/* including commercial applications, and to alter it and redistribute it    */
+/* freely, subject to the following restrictions:                            */
+/*                                                                           */
+/* 1. The origin of this software must not be misrepresented; you must not   */
+/*    claim that you wrote the original software. If you use this software   */
+/*    in a product, an acknowledgment in the product documentation would be  */
+/*    appreciated but is not required.                                       */
+/* 2. Altered source versions must be plainly marked as such, and must not   */
+/*    be misrepresented as being the original software.                      */
+/* 3. This notice may not be removed or altered from any source              */
+/*    distribution.                                                          */
+/*                                                                           */
+/*****************************************************************************/
+
+
+
+#include <string.h>
+
+/* common */
+#include "chartype.h"
+#include "coll.h"
+#include "xmalloc.h"
+
+/* cc65 */
+#include "dataseg.h"
+#include "error.h"
+#include "function.h"
+#include "segments.h"
+#include "symtab.h"
+#include "unused.h"
+
+
+
+/*****************************************************************************/
+/*                                   Data                                    */
+/*****************************************************************************/
+
+
+
+/* Size of the hash table for the symbols */
+#define UR_HASH_SIZE    211U
+
+/* Flags for a symbol */
+#define URF_ROOT        0x0001U         /* Referenced from elsewhere */
+#define URF_TARGET      0x0002U         /* A reference to it was recorded */
+#define URF_DATA        0x0004U         /* Definition in a data segment known */
+#define URF_REACHED     0x0008U         /* Reachable from outside */
+
+/* A function or data object with linkage */
+typedef struct URSym URSym;
+struct URSym {
+    URSym*              Next;           /* Next entry in hash chain */
+    SymEntry*           Sym;            /* The symbol */
+    unsigned            Flags;          /* URF_xxx */
+    const URSym*        LastUser;       /* Last one that referenced this one */
+    Collection          Refs;           /* Symbols referenced by this one */
+    Collection          Literals;       /* Literals used in the initializer */
+    Collection          AsmNames;       /* Names used in inline assembler */
+    DataSeg*            Seg;            /* Data segment with the definition */
+    unsigned            Start;          /* First line of the definition */
+    unsigned            Count;          /* Number of lines of the definition */
+};
+
+/* All symbols */
+static URSym*           Tab[UR_HASH_SIZE];
+static Collection       Entries = STATIC_COLLECTION_INITIALIZER;
+
+/* Data objects in the order of their definitions */
+static Collection       DataDefs = STATIC_COLLECTION_INITIALIZER;
+
+/* Data object whose definition is parsed */
+static URSym*           DataUser = 0;
+
+/* Names used in inline assembler outside of functions and initializers */
+static Collection       RootAsmNames = STATIC_COLLECTION_INITIALIZER;
+
+
+
+/*****************************************************************************/
+/*                                struct URSym                               */
+/*****************************************************************************/
+
+
+
+static URSym* FindURSym (SymEntry* Sym, int Create)
+/* Find the entry for a symbol. If there is none, create it if Create is
+** true, otherwise return NULL.
+*/
+{
+    unsigned Hash = Sym->Hash % UR_HASH_SIZE;
+    URSym*   S    = Tab[Hash];
+    while (S) {
+        if (S->Sym == Sym) {
+            return S;
+        }
+        S = S->Next;
+    }
+
+    if (Create) {
+        S = xmalloc (sizeof (URSym));
+        S->Next     = Tab[Hash];
+        S->Sym      = Sym;
+        S->Flags    = 0;
+        S->LastUser = 0;
+        InitCollection (&S->Refs);
+        InitCollection (&S->Literals);
+        InitCollection (&S->AsmNames);
+        S->Seg      = 0;
+        S->Start    = 0;
+        S->Count    = 0;
+        Tab[Hash]   = S;
+        CollAppend (&Entries, S);
+    }
+    return S;
+}
+
+
+
+static void FreeNames (Collection* Names)
+/* Free the names in a collection and delete them from it */
+{
+    unsigned I;
+    for (I = 0; I < CollCount (Names); ++I) {
+        xfree (CollAtUnchecked (Names, I));
+    }
+    CollDeleteAll (Names);
+}
+
+
+
+static void FreeURSym (URSym* S)
+/* Free an entry */
+{
+    FreeNames (&S->AsmNames);
+    DoneCollection (&S->Refs);
+    DoneCollection (&S->Literals);
+    DoneCollection (&S->AsmNames);
+    xfree (S);
+}
+
+
+
+static int IsObjectOrFunc (const SymEntry* Sym)
+/* Return true if the symbol is a function or an object */
+{
+    return (Sym->Flags & SC_TYPEMASK) == SC_FUNC ||
+           ((Sym->Flags & SC_TYPEMASK) == SC_NONE &&
+            (Sym->Flags & SC_CONST) != SC_CONST);
+}
+
+
+
+static SymEntry* GetFileScopeSym (SymEntry* Sym)
+/* Return the file scope entry for a function or object with linkage, or NULL
+** if the symbol is something else.
+*/
+{
+    if (!IsObjectOrFunc (Sym)) {
+        return 0;
+    }
+    if (SymIsGlobal (Sym)) {
+        return Sym;
+    }
+    if ((Sym->Flags & SC_STORAGEMASK) == SC_EXTERN ||
+        (Sym->Flags & SC_TYPEMASK) == SC_FUNC) {
+        /* Block scope declaration of an external */
+        return FindGlobalSym (Sym->Name);
+    }
+    return 0;
+}
+
+
+
+static URSym* GetUser (void)
+/* Return the function or data object currently parsed, or NULL if there is
+** none.
+*/
+{
+    if (CurrentFunc) {
+        return FindURSym (CurrentFunc->FuncEntry, 1);
+    }
+    return DataUser;
+}
+
+
+
+static void ResolveAsmNames (URSym* User, const Collection* Names)
+/* Record references from User to the symbols whose names were used in
+** inline assembler. If User is NULL, the symbols are kept.
+*/
+{
+    unsigned I;
+    for (I = 0; I < CollCount (Names); ++I) {
+        SymEntry* Sym = FindGlobalSym (CollConstAt (Names, I));
+        if (Sym && IsObjectOrFunc (Sym)) {
+            URSym* Target = FindURSym (Sym, 1);
+            Target->Flags |= URF_TARGET;
+            if (User) {
+                CollAppend (&User->Refs, Target);
+            } else {
+                Target->Flags |= URF_ROOT;
+            }
+
+            /* A static function used this way is output, as long as the
+            ** code using it is output.
+            */
+            if ((Sym->Flags & SC_STORAGEMASK) == SC_STATIC) {
+                Sym->Flags |= SC_REF;
+            }
+        }
+    }
+}
+
+
+
+/*****************************************************************************/
+/*                                   Code                                    */
+/*****************************************************************************/
+
+
+
+void AddSymRef (SymEntry* Sym)
+/* Record a reference to the symbol from the function body or initializer
+** currently parsed.
+*/
+{
+    URSym* Target;
+    URSym* User;
+
+    Sym = GetFileScopeSym (Sym);
+    if (Sym == 0) {
+        return;
+    }
+
+    Target = FindURSym (Sym, 1);
+    Target->Flags |= URF_TARGET;
+
+    User = GetUser ();
+    if (User == 0) {
+        Target->Flags |= URF_ROOT;
+    } else if (Target->LastUser != User) {
+        /* Repeated references from the same user are recorded only once */
+        Target->LastUser = User;
+        CollAppend (&User->Refs, Target);
+    }
+}
+
+
+
+void AddSymRoot (SymEntry* Sym)
+/* Keep the symbol, whether it is referenced or not */
+{
+    Sym = GetFileScopeSym (Sym);
+    if (Sym) {
+        FindURSym (Sym, 1)->Flags |= URF_ROOT | URF_TARGET;
+    }
+}
+
+
+
+void AddLiteralRef (Literal* L)
+/* Record the use of a literal in the initializer currently parsed */
+{
+    /* Literals used in functions are in the literal pool of the function */
+    if (CurrentFunc == 0 && DataUser != 0) {
+        CollAppend (&DataUser->Literals, L);
+    }
+}
+
+
+
+void AddAsmRefs (const StrBuf* Text)
+/* Record the references of inline assembler code to functions and objects
+** by their assembler names, which are the C names with a leading underscore.
+*/
+{
+    URSym*      User = GetUser ();
+    const char* Buf  = SB_GetConstBuf (Text);
+    unsigned    Len  = SB_GetLen (Text);
+    unsigned    I    = 0;
+
+    while (I < Len) {
+        if (Buf[I] == '_' && (I == 0 || (!IsAlNum (Buf[I-1]) && Buf[I-1] != '_'))) {
+            /* Start of an identifier with a leading underscore */
+            unsigned Start = ++I;
+            while (I < Len && (IsAlNum (Buf[I]) || Buf[I] == '_')) {
+                ++I;
+            }
+            if (I > Start) {
+                char* Name = xmalloc (I - Start + 1);
+                memcpy (Name, Buf + Start, I - Start);
+                Name[I - Start] = '\0';
+                CollAppend (User ? &User->AsmNames : &RootAsmNames, Name);
+            }
+        } else {
+            ++I;
+        }
+    }
+}
+
+
+
+void StartDataDef (SymEntry* Sym)
+/* Start the definition of a data object at file scope. The lines added to
+** the current data segment until EndDataDef is called belong to it.
+*/
+{
+    URSym* S = FindURSym (Sym, 1);
+
+    S->Flags |= URF_DATA;
+    S->Seg    = GetDataSeg ();
+    S->Start  = CollCount (&S->Seg->Lines);
+    CollAppend (&DataDefs, S);
+    DataUser  = S;
+}
+
+
+
+void EndDataDef (void)
+/* End the definition of a data object at file scope */
+{
+    CHECK (DataUser != 0);
+    DataUser->Count = CollCount (&DataUser->Seg->Lines) - DataUser->Start;
+    DataUser = 0;
+}
+
+
+
+void RemoveUnused (void)
+/* Mark the static functions that cannot be reached from outside the
+** translation unit, so they are not output, and remove such data objects
+** from their data segments.
+*/
+{
+    Collection Stack = AUTO_COLLECTION_INITIALIZER;
+    SymEntry*  Entry;
+    URSym*     S;
+    unsigned   I;
+
+    /* The symbols used in inline assembler are only known now, since the
+    ** assembler code may use them before they are declared.
+    */
+    for (I = 0; I < CollCount (&Entries); ++I) {
+        S = CollAtUnchecked (&Entries, I);
+        ResolveAsmNames (S, &S->AsmNames);
+    }
+    ResolveAsmNames (0, &RootAsmNames);
+
+    /* The roots are the functions and objects with external linkage, the
+    ** ones referenced from elsewhere, and the ones referenced in a way that
+    ** wasn't recorded.
+    */
+    for (Entry = GetGlobalSymTab ()->SymHead; Entry; Entry = Entry->NextSym) {
+        if (!IsObjectOrFunc (Entry)) {
+            continue;
+        }
+        S = FindURSym (Entry, 0);
+        if ((SymIsDef (Entry) && (Entry->Flags & SC_STORAGEMASK) != SC_STATIC) ||
+            (SymIsRef (Entry) && (S == 0 || (S->Flags & URF_TARGET) == 0))) {
+            S = FindURSym (Entry, 1);
+            S->Flags |= URF_ROOT;
+        }
+        if (S && (S->Flags & URF_ROOT) != 0) {
+            S->Flags |= URF_REACHED;
+            CollAppend (&Stack, S);
+        }
+    }
+
+    /* Mark everything reachable from the roots */
+    while (CollCount (&Stack) > 0) {
+        S = CollPop (&Stack);
+        for (I = 0; I < CollCount (&S->Refs); ++I) {
+            URSym* T = CollAtUnchecked (&S->Refs, I);
+            if ((T->Flags & URF_REACHED) == 0) {
+                T->Flags |= URF_REACHED;
+                CollAppend (&Stack, T);
+            }
+        }
+    }
+    DoneCollection (&Stack);
+
+    /* Handle the functions and objects that weren't reached */
+    for (Entry = GetGlobalSymTab ()->SymHead; Entry; Entry = Entry->NextSym) {
+        if (!IsObjectOrFunc (Entry)) {
+            continue;
+        }
+        S = FindURSym (Entry, 0);
+        if (S == 0 || (S->Flags & URF_REACHED) != 0) {
+            continue;
+        }
+        if ((Entry->Flags & SC_STORAGEMASK) == SC_STATIC) {
+            if ((Entry->Flags & SC_TYPEMASK) == SC_FUNC) {
+                if (SymIsDef (Entry) && SymIsRef (Entry)) {
+                    Entry->Flags |= SC_UNREACHABLE;
+                    if (IS_Get (&WarnRemovedUnused)) {
+                        Warning ("Unused static function '%s' removed", Entry->Name);
+                    }
+                }
+            } else if ((S->Flags & URF_DATA) != 0) {
+                Entry->Flags |= SC_UNREACHABLE;
+                if (IS_Get (&WarnRemovedUnused)) {
+                    Warning ("Unused static variable '%s' removed", Entry->Name);
+                }
+            }
+        } else if (!SymIsDef (Entry)) {
+            /* Only used by removed code and data, so don't import it */
+            Entry->Flags &= ~SC_REF;
+        }
+    }
+
+    /* Remove the definitions of the unused data objects. Go backwards, so
+    ** the line numbers of the remaining ones stay valid.
+    */
+    I = CollCount (&DataDefs);
+    while (I-- > 0) {
+        S = CollAtUnchecked (&DataDefs, I);
+        if ((S->Sym->Flags & SC_UNREACHABLE) != 0) {
+            unsigned J;
+            for (J = 0; J < CollCount (&S->Literals); ++J) {
+                ReleaseLiteral (CollAtUnchecked (&S->Literals, J));
+            }
+            DS_DelLines (S->Seg, S->Start, S->Count);
+        }
+    }
+}
+
+
+
+void DoneSymRefs (void)
+/* Free the recorded references */
+{
+    unsigned I;
+    for (I = 0; I < CollCount (&Entries); ++I) {
+        FreeURSym (CollAtUnchecked (&Entries, I));
+    }
+    CollDeleteAll (&Entries);
+    CollDeleteAll (&DataDefs);
+    FreeNames (&RootAsmNames);
+    memset (Tab, 0, sizeof (Tab));
+    DataUser = 0;
+}
@@ -0,0 +1,106 @@
+/*****************************************************************************/
+/*                                                                           */
+/*                                 unused.h                                  */
+/*                                                                           */
+/*            Removal of unused static functions and data objects            */
+/*                                                                           */
+/*                                                                           */
+/*                                                                           */
+/* Copyright 2026 The cc65 Authors                                           */
+/*                                                                           */
+/*                                                                           */
+/* This software is provided 'as-is', without any expressed or implied       */
+/* warranty.  In no event will the authors be held liable for any damages    */
+/* arising from the use of this software.                                    */
+/*                                                                           */
+/* Permission is granted to anyone to use this software for any purpose,     */
+/* including commercial applications, and to alter it and redistribute it    */
+/* freely, subject to the following restrictions:                            */
+/*                                                                           */
+/* 1. The origin of this software must not be misrepresented; you must not   */
+/*    claim that you wrote the original software. If you use this software   */
+/*    in a product, an acknowledgment in the product documentation would be  */
+/*    appreciated but is not required.                                       */
+/* 2. Altered source versions must be plainly marked as such, and must not   */
+/*    be misrepresented as being the original software.                      */
+/* 3. This notice may not be removed or altered from any source              */
+/*    distribution.                                                          */
+/*                                                                           */
+/*****************************************************************************/
+
+
+
+/* While a translation unit is parsed, the references of each function body
+** and of each initializer of a data object at file scope to functions and
+** objects with linkage are recorded. At the end of the translation unit, all
+** symbols reachable from the functions and objects with external linkage are
+** marked. Static functions and objects that are not reached are not output,
+** and neither are the literals that only their initializers use. Externals
+** that are only used by them are not imported.
+**
+** The names used in the text of inline assembler code count as references,
+** too. References from anywhere else, for example from an expression in a
+** declaration at file scope, keep the symbol. So does any reference that
+** was not recorded here. With --keep-unused, nothing is removed.
+*/
+
+
+
+#ifndef UNUSED_H
+#define UNUSED_H
+
+
+
+/* common */
+#include "strbuf.h"
+
+/* cc65 */
+#include "litpool.h"
+#include "symentry.h"
+
+
+
+/*****************************************************************************/
+/*                                   Code                                    */
+/*****************************************************************************/
+
+
+
+void AddSymRef (SymEntry* Sym);
+/* Record a reference to the symbol from the function body or initializer
+** currently parsed.
+*/
+
+void AddSymRoot (SymEntry* Sym);
+/* Keep the symbol, whether it is referenced or not */
+
+void AddLiteralRef (Literal* L);
+/* Record the use of a literal in the initializer currently parsed */
+
+void AddAsmRefs (const StrBuf* Text);
+/* Record the references of inline assembler code to functions and objects
+** by their assembler names, which are the C names with a leading underscore.
+*/
+
+void StartDataDef (SymEntry* Sym);
+/* Start the definition of a data object at file scope. The lines added to
+** the current data segment until EndDataDef is called belong to it.
+*/
+
+void EndDataDef (void);
+/* End the definition of a data object at file scope */
+
+void RemoveUnused (void);
+/* Mark the static functions that cannot be reached from outside the
+** translation unit, so they are not output, and remove such data objects
+** from their data segments.
+*/
+
+void DoneSymRefs (void);
+/* Free the recorded references */
+
+
+
+/* End of unused.h */
+
+#endif
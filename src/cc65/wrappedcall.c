@@ -88,6 +88,16 @@ void PopWrappedCall (void)
 
 
 
+void ClearWrappedCalls (void)
+/* Remove all WrappedCalls */
+{
+    while (IPS_GetCount (&WrappedCalls) > 0) {
+        IPS_Drop (&WrappedCalls);
+    }
+}
+
+
+
 void GetWrappedCall (void **Ptr, unsigned int *Val)
 /* Get the current WrappedCall */
 {
@@ -56,6 +56,9 @@ void PushWrappedCall (void *Ptr, unsigned int Val);
 void PopWrappedCall (void);
 /* Pop the current WrappedCall */
 
+void ClearWrappedCalls (void);
+/* Remove all WrappedCalls */
+
 void GetWrappedCall (void **Ptr, unsigned int *Val);
 /* Get the current WrappedCall, if any */
 
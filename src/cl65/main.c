@@ -796,6 +796,8 @@ static void Usage (void)
             "  --asm-args options\t\tPass options to the assembler\n"
             "  --asm-define sym[=v]\t\tDefine an assembler symbol\n"
             "  --asm-include-dir dir\t\tSet an assembler include directory\n"
+            "  --auto-register-vars\t\tPlace frequently used locals into registers\n"
+            "  --auto-static-locals\t\tMake locals static if functions aren't reentrant\n"
             "  --bin-include-dir dir\t\tSet an assembler binary include directory\n"
             "  --bss-label name\t\tDefine and export a BSS segment label\n"
             "  --bss-name seg\t\tSet the name of the BSS segment\n"
@@ -809,6 +811,7 @@ static void Usage (void)
             "  --cpu type\t\t\tSet CPU type\n"
             "  --create-dep name\t\tCreate a make dependency file\n"
             "  --create-full-dep name\tCreate a full make dependency file\n"
+            "  --cycle-weight n\t\tWeight cycles against size by n percent\n"
             "  --data-label name\t\tDefine and export a DATA segment label\n"
             "  --data-name seg\t\tSet the name of the DATA segment\n"
             "  --debug\t\t\tDebug mode\n"
@@ -817,6 +820,8 @@ static void Usage (void)
             "  --force-import sym\t\tForce an import of symbol 'sym'\n"
             "  --help\t\t\tHelp (this text)\n"
             "  --include-dir dir\t\tSet a compiler include directory path\n"
+            "  --inline-funcs\t\tInline small static and inline functions\n"
+            "  --keep-unused\t\t\tOutput unused static functions and data\n"
             "  --ld-args options\t\tPass options to the linker\n"
             "  --lib-path path\t\tSpecify a library search path\n"
             "  --list-targets\t\tList all available targets\n"
@@ -826,10 +831,13 @@ static void Usage (void)
             "  --memory-model model\t\tSet the memory model\n"
             "  --module\t\t\tLink as a module\n"
             "  --module-id id\t\tSpecify a module ID for the linker\n"
+            "  --narrow-loop-vars\t\tUse bytes for small int loop counters\n"
             "  --no-target-lib\t\tDon't link the target library\n"
             "  --o65-model model\t\tOverride the o65 model\n"
             "  --obj file\t\t\tLink this object file\n"
             "  --obj-path path\t\tSpecify an object file search path\n"
+            "  --opt-jobs n\t\t\tOptimize functions using n threads\n"
+            "  --pch name\t\t\tUse or create a precompiled header\n"
             "  --print-target-path\t\tPrint the target file path\n"
             "  --register-space b\t\tSet space available for register variables\n"
             "  --register-vars\t\tEnable register variables\n"
@@ -839,6 +847,7 @@ static void Usage (void)
             "  --start-addr addr\t\tSet the default start address\n"
             "  --static-locals\t\tMake local variables static\n"
             "  --target sys\t\t\tSet the target system\n"
+            "  --use-profile name\t\tOptimize using a sim65 profile\n"
             "  --version\t\t\tPrint the version number\n"
             "  --verbose\t\t\tVerbose mode\n"
             "  --zeropage-label name\t\tDefine and export a ZEROPAGE segment label\n"
@@ -889,6 +898,24 @@ static void OptAsmIncludeDir (const char* Opt attribute ((unused)), const char*
 
 
 
+static void OptAutoRegisterVars (const char* Opt attribute ((unused)),
+                                 const char* Arg attribute ((unused)))
+/* Handle the --auto-register-vars option */
+{
+    CmdAddArg (&CC65, "--auto-register-vars");
+}
+
+
+
+static void OptAutoStaticLocals (const char* Opt attribute ((unused)),
+                                 const char* Arg attribute ((unused)))
+/* Handle the --auto-static-locals option */
+{
+    CmdAddArg (&CC65, "--auto-static-locals");
+}
+
+
+
 static void OptBinIncludeDir (const char* Opt attribute ((unused)), const char* Arg)
 /* Binary include directory (assembler) */
 {
@@ -1009,6 +1036,14 @@ static void OptCreateFullDep (const char* Opt attribute ((unused)), const char*
 
 
 
+static void OptCycleWeight (const char* Opt attribute ((unused)), const char* Arg)
+/* Handle the --cycle-weight option */
+{
+    CmdAddArg2 (&CC65, "--cycle-weight", Arg);
+}
+
+
+
 static void OptDataLabel (const char* Opt attribute ((unused)), const char* Arg)
 /* Handle the --data-label option */
 {
@@ -1082,6 +1117,15 @@ static void OptIncludeDir (const char* Opt attribute ((unused)), const char* Arg
 
 
 
+static void OptInlineFuncs (const char* Opt attribute ((unused)),
+                            const char* Arg attribute ((unused)))
+/* Handle the --inline-funcs option */
+{
+    CmdAddArg (&CC65, "--inline-funcs");
+}
+
+
+
 static void OptLdArgs (const char* Opt attribute ((unused)), const char* Arg)
 /* Pass arguments to the linker */
 {
@@ -1174,6 +1218,24 @@ static void OptModuleId (const char* Opt attribute ((unused)), const char* Arg)
 
 
 
+static void OptKeepUnused (const char* Opt attribute ((unused)),
+                           const char* Arg attribute ((unused)))
+/* Handle the --keep-unused option */
+{
+    CmdAddArg (&CC65, "--keep-unused");
+}
+
+
+
+static void OptNarrowLoopVars (const char* Opt attribute ((unused)),
+                               const char* Arg attribute ((unused)))
+/* Handle the --narrow-loop-vars option */
+{
+    CmdAddArg (&CC65, "--narrow-loop-vars");
+}
+
+
+
 static void OptNoTargetLib (const char* Opt attribute ((unused)),
                             const char* Arg attribute ((unused)))
 /* Disable the target library */
@@ -1207,6 +1269,22 @@ static void OptObjPath (const char* Opt attribute ((unused)), const char* Arg)
 
 
 
+static void OptOptJobs (const char* Opt attribute ((unused)), const char* Arg)
+/* Set the number of optimizer threads */
+{
+    CmdAddArg2 (&CC65, "--opt-jobs", Arg);
+}
+
+
+
+static void OptPch (const char* Opt attribute ((unused)), const char* Arg)
+/* Use or create a precompiled header */
+{
+    CmdAddArg2 (&CC65, "--pch", Arg);
+}
+
+
+
 static void OptPrintTargetPath (const char* Opt attribute ((unused)),
                                 const char* Arg attribute ((unused)))
 /* Print the target file path */
@@ -1318,6 +1396,14 @@ static void OptTarget (const char* Opt attribute ((unused)), const char* Arg)
 
 
 
+static void OptUseProfile (const char* Opt attribute ((unused)), const char* Arg)
+/* Optimize using a sim65 profile */
+{
+    CmdAddArg2 (&CC65, "--use-profile", Arg);
+}
+
+
+
 static void OptVerbose (const char* Opt attribute ((unused)),
                         const char* Arg attribute ((unused)))
 /* Verbose mode (compiler, assembler, linker) */
@@ -1366,6 +1452,8 @@ int main (int argc, char* argv [])
         { "--asm-args",          1, OptAsmArgs        },
         { "--asm-define",        1, OptAsmDefine      },
         { "--asm-include-dir",   1, OptAsmIncludeDir  },
+        { "--auto-register-vars", 0, OptAutoRegisterVars },
+        { "--auto-static-locals", 0, OptAutoStaticLocals },
         { "--bin-include-dir",   1, OptBinIncludeDir  },
         { "--bss-label",         1, OptBssLabel       },
         { "--bss-name",          1, OptBssName        },
@@ -1379,6 +1467,7 @@ int main (int argc, char* argv [])
         { "--cpu",               1, OptCPU            },
         { "--create-dep",        1, OptCreateDep      },
         { "--create-full-dep",   1, OptCreateFullDep  },
+        { "--cycle-weight",      1, OptCycleWeight    },
         { "--data-label",        1, OptDataLabel      },
         { "--data-name",         1, OptDataName       },
         { "--debug",             0, OptDebug          },
@@ -1387,6 +1476,8 @@ int main (int argc, char* argv [])
         { "--force-import",      1, OptForceImport    },
         { "--help",              0, OptHelp           },
         { "--include-dir",       1, OptIncludeDir     },
+        { "--inline-funcs",      0, OptInlineFuncs    },
+        { "--keep-unused",       0, OptKeepUnused     },
         { "--ld-args",           1, OptLdArgs         },
         { "--lib-path",          1, OptLibPath        },
         { "--list-targets",      0, OptListTargets    },
@@ -1396,10 +1487,13 @@ int main (int argc, char* argv [])
         { "--memory-model",      1, OptMemoryModel    },
         { "--module",            0, OptModule         },
         { "--module-id",         1, OptModuleId       },
+        { "--narrow-loop-vars",  0, OptNarrowLoopVars },
         { "--no-target-lib",     0, OptNoTargetLib    },
         { "--o65-model",         1, OptO65Model       },
         { "--obj",               1, OptObj            },
         { "--obj-path",          1, OptObjPath        },
+        { "--opt-jobs",          1, OptOptJobs        },
+        { "--pch",               1, OptPch            },
         { "--print-target-path", 0, OptPrintTargetPath},
         { "--register-space",    1, OptRegisterSpace  },
         { "--register-vars",     0, OptRegisterVars   },
@@ -1409,6 +1503,7 @@ int main (int argc, char* argv [])
         { "--start-addr",        1, OptStartAddr      },
         { "--static-locals",     0, OptStaticLocals   },
         { "--target",            1, OptTarget         },
+        { "--use-profile",       1, OptUseProfile     },
         { "--verbose",           0, OptVerbose        },
         { "--version",           0, OptVersion        },
         { "--zeropage-label",    1, OptZeropageLabel  },
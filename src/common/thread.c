@@ -0,0 +1,245 @@
+/*****************************************************************************/
+/*                                                                           */
+/*                                 thread.c                                  */
+/*                                                                           */
+/*                  Minimal portable threads and mutexes                     */
+/*                                                                           */
+/*                                                                           */
+/*                                                                           */
+/* Copyright 2026 The cc65 Authors                                           */
+/*                                                                           */
+/*                                                                           */
+/* This software is provided 'as-is', without any expressed or implied       */
+/* warranty.  In no event will the authors be held liable for any damages    */
+/* arising from the use of this software.                                    */
+/*                                                                           */
+/* Permission is granted to anyone to use this software for any purpose,     */
+/* including commercial applications, and to alter it and redistribute it    */
+/* freely, subject to the following restrictions:                            */
+/*                                                                           */
+/* 1. The origin of this software must not be misrepresented; you must not   */
+/*    claim that you wrote the original software. If you use this software   */
+/*    in a product, an acknowledgment in the product documentation would be  */
+/*    appreciated but is not required.                                       */
+/* 2. Altered source versions must be plainly marked as such, and must not   */
+/*    be misrepresented as being the original software.                      */
+/* 3. This notice may not be removed or altered from any source              */
+/*    distribution.                                                          */
+/*                                                                           */
+/*****************************************************************************/
+
+
+
+/* common */
+#include "thread.h"
+
+#if HAVE_THREADS && defined(_WIN32)
+#  include <windows.h>
+#elif HAVE_THREADS
+#  include <pthread.h>
+#  include <unistd.h>
+#endif
+
+/* common */
+#include "abend.h"
+#include "xmalloc.h"
+
+
+
+/*****************************************************************************/
+/*                                   Data                                    */
+/*****************************************************************************/
+
+
+
+struct Thread {
+#if HAVE_THREADS && defined(_WIN32)
+    HANDLE              Handle;
+#elif HAVE_THREADS
+    pthread_t           Handle;
+#endif
+    ThreadFunc          Func;           /* Function to run */
+    void*               Data;           /* Argument for the function */
+};
+
+struct Mutex {
+#if HAVE_THREADS && defined(_WIN32)
+    CRITICAL_SECTION    CS;
+#elif HAVE_THREADS
+    pthread_mutex_t     M;
+#else
+    int                 Dummy;
+#endif
+};
+
+
+
+/*****************************************************************************/
+/*                                   Code                                    */
+/*****************************************************************************/
+
+
+
+#if HAVE_THREADS && defined(_WIN32)
+
+static DWORD WINAPI ThreadStart (LPVOID Arg)
+/* Start routine passed to the operating system */
+{
+    Thread* T = Arg;
+    T->Func (T->Data);
+    return 0;
+}
+
+#elif HAVE_THREADS
+
+static void* ThreadStart (void* Arg)
+/* Start routine passed to the operating system */
+{
+    Thread* T = Arg;
+    T->Func (T->Data);
+    return 0;
+}
+
+#endif
+
+
+
+Thread* NewThread (ThreadFunc Func, void* Data)
+/* Create a new thread that runs Func with the given argument. The thread must
+** be released with JoinThread. Without thread support, Func is run before the
+** function returns.
+*/
+{
+    Thread* T = xmalloc (sizeof (Thread));
+    T->Func = Func;
+    T->Data = Data;
+
+#if HAVE_THREADS && defined(_WIN32)
+    T->Handle = CreateThread (0, 0, ThreadStart, T, 0, 0);
+    if (T->Handle == 0) {
+        AbEnd ("Cannot create thread");
+    }
+#elif HAVE_THREADS
+    if (pthread_create (&T->Handle, 0, ThreadStart, T) != 0) {
+        AbEnd ("Cannot create thread");
+    }
+#else
+    Func (Data);
+#endif
+
+    return T;
+}
+
+
+
+void JoinThread (Thread* T)
+/* Wait until the thread has terminated and free the thread structure */
+{
+#if HAVE_THREADS && defined(_WIN32)
+    WaitForSingleObject (T->Handle, INFINITE);
+    CloseHandle (T->Handle);
+#elif HAVE_THREADS
+    pthread_join (T->Handle, 0);
+#endif
+    xfree (T);
+}
+
+
+
+Mutex* NewMutex (void)
+/* Create and return a new mutex */
+{
+    Mutex* M = xmalloc (sizeof (Mutex));
+#if HAVE_THREADS && defined(_WIN32)
+    InitializeCriticalSection (&M->CS);
+#elif HAVE_THREADS
+    pthread_mutex_init (&M->M, 0);
+#endif
+    return M;
+}
+
+
+
+void FreeMutex (Mutex* M)
+/* Free a mutex created by NewMutex */
+{
+#if HAVE_THREADS && defined(_WIN32)
+    DeleteCriticalSection (&M->CS);
+#elif HAVE_THREADS
+    pthread_mutex_destroy (&M->M);
+#endif
+    xfree (M);
+}
+
+
+
+void LockMutex (Mutex* M)
+/* Lock the given mutex */
+{
+#if HAVE_THREADS && defined(_WIN32)
+    EnterCriticalSection (&M->CS);
+#elif HAVE_THREADS
+    pthread_mutex_lock (&M->M);
+#else
+    (void) M;
+#endif
+}
+
+
+
+void UnlockMutex (Mutex* M)
+/* Unlock the given mutex */
+{
+#if HAVE_THREADS && defined(_WIN32)
+    LeaveCriticalSection (&M->CS);
+#elif HAVE_THREADS
+    pthread_mutex_unlock (&M->M);
+#else
+    (void) M;
+#endif
+}
+
+
+
+unsigned AtomicInc (volatile unsigned* Val)
+/* Atomically increment Val and return the new value */
+{
+#if HAVE_THREADS && defined(_MSC_VER)
+    return (unsigned) InterlockedIncrement ((volatile LONG*) Val);
+#elif HAVE_THREADS
+    return __sync_add_and_fetch (Val, 1);
+#else
+    return ++*Val;
+#endif
+}
+
+
+
+unsigned AtomicDec (volatile unsigned* Val)
+/* Atomically decrement Val and return the new value */
+{
+#if HAVE_THREADS && defined(_MSC_VER)
+    return (unsigned) InterlockedDecrement ((volatile LONG*) Val);
+#elif HAVE_THREADS
+    return __sync_sub_and_fetch (Val, 1);
+#else
+    return --*Val;
+#endif
+}
+
+
+
+unsigned GetCPUCount (void)
+/* Return the number of processors available, or 1 if unknown */
+{
+#if HAVE_THREADS && defined(_WIN32)
+    SYSTEM_INFO Info;
+    GetSystemInfo (&Info);
+    return Info.dwNumberOfProcessors > 0? (unsigned) Info.dwNumberOfProcessors : 1;
+#elif HAVE_THREADS && defined(_SC_NPROCESSORS_ONLN)
+    long Count = sysconf (_SC_NPROCESSORS_ONLN);
+    return Count > 0? (unsigned) Count : 1;
+#else
+    return 1;
+#endif
+}
@@ -0,0 +1,121 @@
+/*****************************************************************************/
+/*                                                                           */
+/*                                 thread.h                                  */
+/*                                                                           */
+/*                  Minimal portable threads and mutexes                     */
+/*                                                                           */
+/*                                                                           */
+/*                                                                           */
+/* Copyright 2026 The cc65 Authors                                           */
+/*                                                                           */
+/*                                                                           */
+/* This software is provided 'as-is', without any expressed or implied       */
+/* warranty.  In no event will the authors be held liable for any damages    */
+/* arising from the use of this software.                                    */
+/*                                                                           */
+/* Permission is granted to anyone to use this software for any purpose,     */
+/* including commercial applications, and to alter it and redistribute it    */
+/* freely, subject to the following restrictions:                            */
+/*                                                                           */
+/* 1. The origin of this software must not be misrepresented; you must not   */
+/*    claim that you wrote the original software. If you use this software   */
+/*    in a product, an acknowledgment in the product documentation would be  */
+/*    appreciated but is not required.                                       */
+/* 2. Altered source versions must be plainly marked as such, and must not   */
+/*    be misrepresented as being the original software.                      */
+/* 3. This notice may not be removed or altered from any source              */
+/*    distribution.                                                          */
+/*                                                                           */
+/*****************************************************************************/
+
+
+
+/* This module wraps the few threading primitives used by the tools. On hosts
+** without thread support, HAVE_THREADS is zero, NewThread runs the thread
+** function synchronously, and mutexes do nothing, so callers need no special
+** cases.
+*/
+
+
+
+#ifndef THREAD_H
+#define THREAD_H
+
+
+
+/*****************************************************************************/
+/*                                  Defines                                  */
+/*****************************************************************************/
+
+
+
+/* Storage class for variables that must exist once per thread */
+#if defined(_MSC_VER)
+#  define THREAD_LOCAL  __declspec(thread)
+#  define HAVE_THREADS  1
+#elif defined(__GNUC__) && (defined(_WIN32) || defined(__unix__) || defined(__APPLE__))
+#  define THREAD_LOCAL  __thread
+#  define HAVE_THREADS  1
+#else
+#  define THREAD_LOCAL
+#  define HAVE_THREADS  0
+#endif
+
+
+
+/*****************************************************************************/
+/*                                   Data                                    */
+/*****************************************************************************/
+
+
+
+/* Opaque thread and mutex types */
+typedef struct Thread Thread;
+typedef struct Mutex Mutex;
+
+/* Function executed by a thread */
+typedef void (*ThreadFunc) (void* Data);
+
+
+
+/*****************************************************************************/
+/*                                   Code                                    */
+/*****************************************************************************/
+
+
+
+Thread* NewThread (ThreadFunc Func, void* Data);
+/* Create a new thread that runs Func with the given argument. The thread must
+** be released with JoinThread. Without thread support, Func is run before the
+** function returns.
+*/
+
+void JoinThread (Thread* T);
+/* Wait until the thread has terminated and free the thread structure */
+
+Mutex* NewMutex (void);
+/* Create and return a new mutex */
+
+void FreeMutex (Mutex* M);
+/* Free a mutex created by NewMutex */
+
+void LockMutex (Mutex* M);
+/* Lock the given mutex */
+
+void UnlockMutex (Mutex* M);
+/* Unlock the given mutex */
+
+unsigned AtomicInc (volatile unsigned* Val);
+/* Atomically increment Val and return the new value */
+
+unsigned AtomicDec (volatile unsigned* Val);
+/* Atomically decrement Val and return the new value */
+
+unsigned GetCPUCount (void);
+/* Return the number of processors available, or 1 if unknown */
+
+
+
+/* End of thread.h */
+
+#endif
@@ -40,6 +40,7 @@
 
 #include "error.h"
 #include "peripherals.h"
+#include "profile.h"
 
 
 /*****************************************************************************/
@@ -120,5 +121,6 @@ void SimExit (int Code)
     if (PrintCycles) {
         fprintf (stdout, "%" PRIu64 " cycles\n", Peripherals.Counter.ClockCycles);
     }
+    ProfWrite ();
     exit (Code);
 }
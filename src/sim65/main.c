@@ -50,6 +50,7 @@
 #include "memory.h"
 #include "peripherals.h"
 #include "paravirt.h"
+#include "profile.h"
 #include "trace.h"
 
 
@@ -101,6 +102,8 @@ static void Usage (void)
             "  --help\t\tHelp (this text)\n"
             "  --cycles\t\tPrint amount of executed CPU cycles\n"
             "  --cpu <type>\t\tOverride CPU type (6502, 65C02, 6502X)\n"
+            "  --dbgfile <name>\tRead debug info for the profile from <name>\n"
+            "  --profile <name>\tWrite an execution profile to <name>\n"
             "  --trace\t\tEnable CPU trace\n"
             "  --verbose\t\tIncrease verbosity\n"
             "  --version\t\tPrint the simulator version number\n",
@@ -139,6 +142,22 @@ static void OptCPU (const char* Opt, const char* Arg)
 
 
 
+static void OptDbgFile (const char* Opt attribute ((unused)), const char* Arg)
+/* Set the debug info file for the profile */
+{
+    DbgFileName = Arg;
+}
+
+
+
+static void OptProfile (const char* Opt attribute ((unused)), const char* Arg)
+/* Enable the profile */
+{
+    ProfileName = Arg;
+}
+
+
+
 static void OptTrace (const char* Opt attribute ((unused)),
                       const char* Arg attribute ((unused)))
 /* Enable trace mode */
@@ -284,6 +303,8 @@ int main (int argc, char* argv[])
         { "--help",             0,      OptHelp      },
         { "--cycles",           0,      OptCycles    },
         { "--cpu",              1,      OptCPU       },
+        { "--dbgfile",          1,      OptDbgFile   },
+        { "--profile",          1,      OptProfile   },
         { "--trace",            0,      OptTrace     },
         { "--verbose",          0,      OptVerbose   },
         { "--version",          0,      OptVersion   },
@@ -373,12 +394,19 @@ int main (int argc, char* argv[])
     TraceInit(SPAddr);
     ParaVirtInit (I, SPAddr);
 
+    /* Initialize the profile counters */
+    ProfInit ();
+
     /* Reset the CPU */
     Reset ();
 
     RemainCycles = MaxCycles;
     while (1) {
+        uint16_t PC = Regs.PC;
         Cycles = ExecuteInsn ();
+        if (ProfileName) {
+            ProfCount (PC, Cycles);
+        }
         if (MaxCycles) {
             if (Cycles > RemainCycles) {
                 ErrorCode (SIM65_ERROR_TIMEOUT, "Maximum number of cycles reached.");
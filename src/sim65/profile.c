@@ -0,0 +1,294 @@
+/*****************************************************************************/
+/*                                                                           */
+/*                                 profile.c                                 */
+/*                                                                           */
+/*              Execution profile for the sim65 6502 simulator               */
+/*                                                                           */
+/*                                                                           */
+/*                                                                           */
+/* Copyright 2026 The cc65 Authors                                           */
+/*                                                                           */
+/*                                                                           */
+/* This software is provided 'as-is', without any expressed or implied       */
+/* warranty.  In no event will the authors be held liable for any damages    */
+/* arising from the use of this software.                                    */
+/*                                                                           */
+/* Permission is granted to anyone to use this software for any purpose,     */
+/* including commercial applications, and to alter it and redistribute it    */
+/* freely, subject to the following restrictions:                            */
+/*                                                                           */
+/* 1. The origin of this software must not be misrepresented; you must not   */
+/*    claim that you wrote the original software. If you use this software   */
+/*    in a product, an acknowledgment in the product documentation would be  */
+/*    appreciated but is not required.                                       */
+/* 2. Altered source versions must be plainly marked as such, and must not   */
+/*    be misrepresented as being the original software.                      */
+/* 3. This notice may not be removed or altered from any source              */
+/*    distribution.                                                          */
+/*                                                                           */
+/*****************************************************************************/
+
+
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include <errno.h>
+
+/* common */
+#include "xmalloc.h"
+
+/* dbginfo */
+#include "../dbginfo/dbginfo.h"
+
+/* sim65 */
+#include "error.h"
+#include "profile.h"
+
+
+
+/*****************************************************************************/
+/*                                   Data                                    */
+/*****************************************************************************/
+
+
+
+/* Name of the profile output file, NULL if profiling is disabled */
+const char* ProfileName = 0;
+
+/* Name of the debug info file */
+const char* DbgFileName = 0;
+
+/* Execution counts and cycles per address */
+static unsigned long*   Counts = 0;
+static uint64_t*        Cycles = 0;
+
+/* The debug info */
+static cc65_dbginfo     DbgInfo = 0;
+
+/* Number of errors while reading the debug info */
+static unsigned DbgErrors = 0;
+
+
+
+/*****************************************************************************/
+/*                                   Code                                    */
+/*****************************************************************************/
+
+
+
+static void DbgError (const cc65_parseerror* Info)
+/* Callback function for errors in the debug info file */
+{
+    fprintf (stderr, "%s: %s(%lu): %s\n",
+             Info->type? "Error" : "Warning",
+             Info->name,
+             (unsigned long) Info->line,
+             Info->errormsg);
+    if (Info->type != CC65_WARNING) {
+        ++DbgErrors;
+    }
+}
+
+
+
+static const char* GetCSource (cc65_dbginfo Info, cc65_addr Addr)
+/* Return the name of the C source file for the code at the given address,
+** or an empty string if it is unknown.
+*/
+{
+    const char* Name = "";
+    const cc65_spaninfo* Spans = cc65_span_byaddr (Info, Addr);
+    unsigned I, J;
+
+    for (I = 0; Spans && I < Spans->count && *Name == '\0'; ++I) {
+        const cc65_lineinfo* Lines = cc65_line_byspan (Info, Spans->data[I].span_id);
+        for (J = 0; Lines && J < Lines->count; ++J) {
+            if (Lines->data[J].line_type == CC65_LINE_EXT) {
+                const cc65_sourceinfo* S =
+                    cc65_source_byid (Info, Lines->data[J].source_id);
+                if (S) {
+                    Name = S->data[0].source_name;
+                    cc65_free_sourceinfo (Info, S);
+                }
+                break;
+            }
+        }
+        cc65_free_lineinfo (Info, Lines);
+    }
+    cc65_free_spaninfo (Info, Spans);
+
+    return Name;
+}
+
+
+
+static int IsCFunc (cc65_dbginfo Info, const cc65_csymdata* C)
+/* Return true if the C symbol is a function. The debug info doesn't tell the
+** kind of a C symbol, but a function is the symbol attached to its own scope.
+*/
+{
+    const cc65_scopeinfo* S;
+    int IsFunc;
+
+    if (C->symbol_id == CC65_INV_ID || C->csym_sc == CC65_CSYM_AUTO) {
+        return 0;
+    }
+    S = cc65_scope_byid (Info, C->scope_id);
+    IsFunc = (S != 0 && S->data[0].symbol_id == C->symbol_id);
+    cc65_free_scopeinfo (Info, S);
+    return IsFunc;
+}
+
+
+
+static void WriteFunctions (FILE* F, cc65_dbginfo Info)
+/* Write the records for the C functions */
+{
+    const cc65_csyminfo* CSyms = cc65_get_csymlist (Info);
+    unsigned I;
+
+    for (I = 0; CSyms && I < CSyms->count; ++I) {
+
+        const cc65_csymdata*    C = &CSyms->data[I];
+        const cc65_symbolinfo*  Sym;
+        cc65_addr               Start;
+        cc65_addr               End;
+        cc65_addr               Addr;
+        uint64_t                Sum = 0;
+
+        if (!IsCFunc (Info, C)) {
+            continue;
+        }
+        Sym = cc65_symbol_byid (Info, C->symbol_id);
+        if (Sym == 0) {
+            continue;
+        }
+        Start = (cc65_addr) Sym->data[0].symbol_value;
+        End   = Start + Sym->data[0].symbol_size;
+        cc65_free_symbolinfo (Info, Sym);
+        if (Start > 0xFFFF || End > 0x10000) {
+            continue;
+        }
+
+        for (Addr = Start; Addr < End; ++Addr) {
+            Sum += Cycles[Addr];
+        }
+        fprintf (F, "function\t%s\t%s\t%lu\t%" PRIu64 "\n",
+                 GetCSource (Info, Start), C->csym_name, Counts[Start], Sum);
+    }
+    cc65_free_csyminfo (Info, CSyms);
+}
+
+
+
+static void WriteLines (FILE* F, cc65_dbginfo Info)
+/* Write the records for the executed C source lines */
+{
+    unsigned long*  LineCounts = 0;
+    unsigned        LineMax = 0;
+    unsigned        Addr;
+    unsigned        I, J;
+
+    /* Determine the highest count of the instructions of each line */
+    for (Addr = 0; Addr < 0x10000; ++Addr) {
+        const cc65_spaninfo* Spans;
+        if (Counts[Addr] == 0) {
+            continue;
+        }
+        Spans = cc65_span_byaddr (Info, Addr);
+        for (I = 0; Spans && I < Spans->count; ++I) {
+            const cc65_lineinfo* Lines = cc65_line_byspan (Info, Spans->data[I].span_id);
+            for (J = 0; Lines && J < Lines->count; ++J) {
+                unsigned Id = Lines->data[J].line_id;
+                if (Lines->data[J].line_type != CC65_LINE_EXT) {
+                    continue;
+                }
+                if (Id >= LineMax) {
+                    unsigned NewMax = (Id + 1) * 2;
+                    LineCounts = xrealloc (LineCounts, NewMax * sizeof (LineCounts[0]));
+                    memset (LineCounts + LineMax, 0,
+                            (NewMax - LineMax) * sizeof (LineCounts[0]));
+                    LineMax = NewMax;
+                }
+                if (Counts[Addr] > LineCounts[Id]) {
+                    LineCounts[Id] = Counts[Addr];
+                }
+            }
+            cc65_free_lineinfo (Info, Lines);
+        }
+        cc65_free_spaninfo (Info, Spans);
+    }
+
+    /* Write them */
+    for (I = 0; I < LineMax; ++I) {
+        const cc65_lineinfo*    Line;
+        const cc65_sourceinfo*  S;
+        if (LineCounts[I] == 0 || (Line = cc65_line_byid (Info, I)) == 0) {
+            continue;
+        }
+        S = cc65_source_byid (Info, Line->data[0].source_id);
+        if (S) {
+            fprintf (F, "line\t%s\t%lu\t%lu\n",
+                     S->data[0].source_name,
+                     (unsigned long) Line->data[0].source_line,
+                     LineCounts[I]);
+            cc65_free_sourceinfo (Info, S);
+        }
+        cc65_free_lineinfo (Info, Line);
+    }
+    xfree (LineCounts);
+}
+
+
+
+void ProfInit (void)
+/* Initialize the profile counters if profiling is enabled */
+{
+    if (ProfileName) {
+        if (DbgFileName == 0) {
+            Error ("Profiling needs a debug info file (--dbgfile)");
+        }
+        DbgInfo = cc65_read_dbginfo (DbgFileName, DbgError);
+        if (DbgInfo == 0 || DbgErrors > 0) {
+            Error ("Cannot read debug info from '%s'", DbgFileName);
+        }
+        Counts = xmalloc (0x10000 * sizeof (Counts[0]));
+        Cycles = xmalloc (0x10000 * sizeof (Cycles[0]));
+        memset (Counts, 0, 0x10000 * sizeof (Counts[0]));
+        memset (Cycles, 0, 0x10000 * sizeof (Cycles[0]));
+    }
+}
+
+
+
+void ProfCount (uint16_t Addr, unsigned Cyc)
+/* Count an instruction at the given address */
+{
+    ++Counts[Addr];
+    Cycles[Addr] += Cyc;
+}
+
+
+
+void ProfWrite (void)
+/* Write the profile file if profiling is enabled */
+{
+    FILE* F;
+
+    if (ProfileName == 0) {
+        return;
+    }
+
+    /* Write the profile */
+    F = fopen (ProfileName, "w");
+    if (F == 0) {
+        Error ("Cannot open '%s': %s", ProfileName, strerror (errno));
+    }
+    fprintf (F, "# sim65 profile\n");
+    WriteFunctions (F, DbgInfo);
+    WriteLines (F, DbgInfo);
+    if (fclose (F) != 0) {
+        Error ("Error writing to '%s': %s", ProfileName, strerror (errno));
+    }
+}
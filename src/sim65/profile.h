@@ -0,0 +1,93 @@
+/*****************************************************************************/
+/*                                                                           */
+/*                                 profile.h                                 */
+/*                                                                           */
+/*              Execution profile for the sim65 6502 simulator               */
+/*                                                                           */
+/*                                                                           */
+/*                                                                           */
+/* Copyright 2026 The cc65 Authors                                           */
+/*                                                                           */
+/*                                                                           */
+/* This software is provided 'as-is', without any expressed or implied       */
+/* warranty.  In no event will the authors be held liable for any damages    */
+/* arising from the use of this software.                                    */
+/*                                                                           */
+/* Permission is granted to anyone to use this software for any purpose,     */
+/* including commercial applications, and to alter it and redistribute it    */
+/* freely, subject to the following restrictions:                            */
+/*                                                                           */
+/* 1. The origin of this software must not be misrepresented; you must not   */
+/*    claim that you wrote the original software. If you use this software   */
+/*    in a product, an acknowledgment in the product documentation would be  */
+/*    appreciated but is not required.                                       */
+/* 2. Altered source versions must be plainly marked as such, and must not   */
+/*    be misrepresented as being the original software.                      */
+/* 3. This notice may not be removed or altered from any source              */
+/*    distribution.                                                          */
+/*                                                                           */
+/*****************************************************************************/
+
+
+
+/* The profile counts the executions and cycles of the instructions at each
+** address. When the program exits, the counts are mapped to the C functions
+** and source lines with the debug info file written by ld65, and the result
+** is written as a text file with one record per line and tab separated
+** fields:
+**
+**   function <file> <name> <calls> <cycles>
+**   line <file> <line> <count>
+**
+** <calls> is the number of executions of the first instruction of the
+** function, <cycles> the number of cycles spent in the function itself,
+** not counting called functions. <count> is the highest execution count of
+** the instructions generated for the source line. Lines that were never
+** executed are omitted. cc65 reads the file with --use-profile.
+*/
+
+
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+
+
+#include <stdint.h>
+
+
+
+/*****************************************************************************/
+/*                                   Data                                    */
+/*****************************************************************************/
+
+
+
+/* Name of the profile output file, NULL if profiling is disabled */
+extern const char* ProfileName;
+
+/* Name of the debug info file */
+extern const char* DbgFileName;
+
+
+
+/*****************************************************************************/
+/*                                   Code                                    */
+/*****************************************************************************/
+
+
+
+void ProfInit (void);
+/* Initialize the profile counters if profiling is enabled */
+
+void ProfCount (uint16_t Addr, unsigned Cyc);
+/* Count an instruction at the given address */
+
+void ProfWrite (void);
+/* Write the profile file if profiling is enabled */
+
+
+
+/* End of profile.h */
+
+#endif
@@ -0,0 +1,359 @@
+/*****************************************************************************/
+/*                                                                           */
+/*                                  exec.c                                   */
+/*                                                                           */
+/*                     Run code with the sim65 CPU core                      */
+/*                                                                           */
+/*                                                                           */
+/*                                                                           */
+/* Copyright 2026 The cc65 Authors                                           */
+/*                                                                           */
+/*                                                                           */
+/* This software is provided 'as-is', without any expressed or implied       */
+/* warranty.  In no event will the authors be held liable for any damages    */
+/* arising from the use of this software.                                    */
+/*                                                                           */
+/* Permission is granted to anyone to use this software for any purpose,     */
+/* including commercial applications, and to alter it and redistribute it    */
+/* freely, subject to the following restrictions:                            */
+/*                                                                           */
+/* 1. The origin of this software must not be misrepresented; you must not   */
+/*    claim that you wrote the original software. If you use this software   */
+/*    in a product, an acknowledgment in the product documentation would be  */
+/*    appreciated but is not required.                                       */
+/* 2. Altered source versions must be plainly marked as such, and must not   */
+/*    be misrepresented as being the original software.                      */
+/* 3. This notice may not be removed or altered from any source              */
+/*    distribution.                                                          */
+/*                                                                           */
+/*****************************************************************************/
+
+
+
+#include <string.h>
+
+/* common */
+#include "attrib.h"
+
+/* sim65 */
+#include "../sim65/6502.h"
+#include "../sim65/memory.h"
+#include "../sim65/paravirt.h"
+#include "../sim65/peripherals.h"
+#include "../sim65/trace.h"
+
+/* supopt65 */
+#include "exec.h"
+
+
+
+/*****************************************************************************/
+/*                                   Data                                    */
+/*****************************************************************************/
+
+
+
+/* Address of the code */
+#define CODE_BASE       0xF000U
+#define CODE_SIZE       0x0100U
+
+/* The memory */
+uint8_t Mem[0x10000];
+
+/* Used by the CPU core, but not by supopt65 */
+Sim65Peripherals Peripherals;
+uint8_t TraceMode = TRACE_DISABLED;
+
+/* Log of the writes of a run */
+typedef struct WriteEntry WriteEntry;
+struct WriteEntry {
+    uint16_t            Addr;
+    uint8_t             Old;
+};
+static WriteEntry       Log[MAX_WRITES];
+static unsigned         LogCount;
+static int              LogOverflow;
+
+/* State of the random number generator */
+static unsigned long    Seed = 0x2545F491UL;
+
+
+
+/*****************************************************************************/
+/*                              Stubs for sim65                              */
+/*****************************************************************************/
+
+
+
+void ParaVirtHooks (CPURegs* R attribute ((unused)))
+/* There are no paravirtualization hooks */
+{
+}
+
+
+
+void PrintTraceNMI (void)
+/* Tracing is not used */
+{
+}
+
+
+
+void PrintTraceIRQ (void)
+/* Tracing is not used */
+{
+}
+
+
+
+void PrintTraceInstruction (void)
+/* Tracing is not used */
+{
+}
+
+
+
+uint8_t MemReadByte (uint16_t Addr)
+/* Read a byte from a memory location */
+{
+    return Mem[Addr];
+}
+
+
+
+uint16_t MemReadWord (uint16_t Addr)
+/* Read a word from a memory location */
+{
+    return Mem[Addr] | (Mem[(uint16_t) (Addr + 1)] << 8);
+}
+
+
+
+uint16_t MemReadZPWord (uint8_t Addr)
+/* Read a word from the zero page */
+{
+    return Mem[Addr] | (Mem[(uint8_t) (Addr + 1)] << 8);
+}
+
+
+
+void MemWriteByte (uint16_t Addr, uint8_t Val)
+/* Write a byte to a memory location and record the old value */
+{
+    if (LogCount < MAX_WRITES) {
+        Log[LogCount].Addr = Addr;
+        Log[LogCount].Old  = Mem[Addr];
+        ++LogCount;
+        Mem[Addr] = Val;
+    } else {
+        LogOverflow = 1;
+    }
+}
+
+
+
+void MemWriteWord (uint16_t Addr, uint16_t Val)
+/* Write a word to a memory location */
+{
+    MemWriteByte (Addr, Val & 0xFF);
+    MemWriteByte (Addr + 1, Val >> 8);
+}
+
+
+
+/*****************************************************************************/
+/*                                   Code                                    */
+/*****************************************************************************/
+
+
+
+unsigned char RandomByte (void)
+/* Return a pseudo random byte. The sequence is the same for each run of the
+** program, so the results can be reproduced.
+*/
+{
+    Seed = (Seed * 1103515245UL + 12345UL) & 0xFFFFFFFFUL;
+    return (unsigned char) (Seed >> 16);
+}
+
+
+
+void SetPointer (State* S, const Insn* I)
+/* If I is an indirect instruction, let the pointer it uses point into the
+** heap, so that the memory read or written depends on the state.
+*/
+{
+    unsigned Addr = ZP_BASE + I->Slot * ZP_SPACING + I->Val;
+
+    if (I->AM == AM_ZPXI) {
+        Addr += S->X;
+    } else if (I->AM != AM_ZPIY) {
+        return;
+    }
+    S->ZP[(Addr + 1) & 0xFF] = (unsigned char) ((HEAP_BASE >> 8) + (S->ZP[Addr & 0xFF] & 0x01));
+}
+
+
+
+void InitExec (void)
+/* Initialize the CPU core and fill the memory with random values */
+{
+    unsigned I;
+
+    CPU = CPU_6502;
+    for (I = 0; I < sizeof (Mem); ++I) {
+        Mem[I] = RandomByte ();
+    }
+}
+
+
+
+static unsigned SlotAddr (const Insn* I)
+/* Return the address of the memory operand of an instruction */
+{
+    if (IsZPMode (I->AM)) {
+        return ZP_BASE + I->Slot * ZP_SPACING + I->Val;
+    } else {
+        return ABS_BASE + I->Slot * ABS_SIZE + I->Val;
+    }
+}
+
+
+
+static unsigned Assemble (const Insn* Code, unsigned Count, const State* S)
+/* Place the code into memory and return its end address */
+{
+    unsigned PC = CODE_BASE;
+    unsigned I;
+
+    for (I = 0; I < Count; ++I) {
+        const Insn* C = Code + I;
+        unsigned Addr;
+
+        Mem[PC++] = GetOPC (C->Mnemo, C->AM);
+        switch (C->AM) {
+            case AM_IMP:
+            case AM_ACC:
+                break;
+            case AM_IMM:
+                Mem[PC++] = (C->Slot == SLOT_CONST)? C->Val : S->Params[C->Slot];
+                break;
+            default:
+                Addr = SlotAddr (C);
+                Mem[PC++] = (uint8_t) Addr;
+                if (!IsZPMode (C->AM)) {
+                    Mem[PC++] = (uint8_t) (Addr >> 8);
+                }
+                break;
+        }
+    }
+    return PC;
+}
+
+
+
+int Run (const Insn* Code, unsigned Count, const State* S, Result* R)
+/* Run a sequence of instructions with the given initial state. Return false
+** if the sequence couldn't be run, because it wrote over its own code or
+** too many memory locations.
+*/
+{
+    unsigned End;
+    unsigned I, J;
+    int      Ok = 1;
+
+    /* Set the memory */
+    memcpy (Mem, S->ZP, sizeof (S->ZP));
+    memcpy (Mem + ABS_BASE, S->Slots, S->SlotCount * ABS_SIZE);
+    memcpy (Mem + HEAP_BASE, S->Heap, sizeof (S->Heap));
+
+    /* Set the code and the registers */
+    End = Assemble (Code, Count, S);
+    Regs.AC = S->A;
+    Regs.XR = S->X;
+    Regs.YR = S->Y;
+    Regs.SR = (S->P & (SF | OF | ZF | CF)) | 0x20 | IF;
+    Regs.SP = 0xFF;
+    Regs.PC = CODE_BASE;
+
+    /* Run the code */
+    LogCount    = 0;
+    LogOverflow = 0;
+    R->Cycles   = 0;
+    for (I = 0; I < Count && Regs.PC != End; ++I) {
+        R->Cycles += ExecuteInsn ();
+    }
+    if (Regs.PC != End || LogOverflow) {
+        Ok = 0;
+    }
+
+    /* Remember the registers and the changed memory locations, sorted by
+    ** address. Only the first write to a location has the initial value.
+    */
+    R->A = Regs.AC;
+    R->X = Regs.XR;
+    R->Y = Regs.YR;
+    R->P = Regs.SR & (SF | OF | ZF | CF);
+    R->Writes = 0;
+    for (I = 0; I < LogCount; ++I) {
+        uint16_t Addr = Log[I].Addr;
+        if (Addr >= CODE_BASE && Addr < CODE_BASE + CODE_SIZE) {
+            Ok = 0;
+        }
+        for (J = 0; J < I && Log[J].Addr != Addr; ++J) {
+        }
+        if (J == I && Mem[Addr] != Log[I].Old) {
+            for (J = R->Writes; J > 0 && R->Addr[J-1] > Addr; --J) {
+                R->Addr[J] = R->Addr[J-1];
+                R->Val[J]  = R->Val[J-1];
+            }
+            R->Addr[J] = Addr;
+            R->Val[J]  = Mem[Addr];
+            ++R->Writes;
+        }
+    }
+
+    /* Undo the writes */
+    for (I = LogCount; I-- > 0; ) {
+        Mem[Log[I].Addr] = Log[I].Old;
+    }
+
+    return Ok;
+}
+
+
+
+unsigned CompareResults (const Result* A, const Result* B)
+/* Compare two results and return the differences as a set of DIFF_xxx flags */
+{
+    unsigned Diff = 0;
+    unsigned char P = A->P ^ B->P;
+
+    if (A->A != B->A) {
+        Diff |= DIFF_A;
+    }
+    if (A->X != B->X) {
+        Diff |= DIFF_X;
+    }
+    if (A->Y != B->Y) {
+        Diff |= DIFF_Y;
+    }
+    if (P & CF) {
+        Diff |= DIFF_C;
+    }
+    if (P & ZF) {
+        Diff |= DIFF_Z;
+    }
+    if (P & OF) {
+        Diff |= DIFF_V;
+    }
+    if (P & SF) {
+        Diff |= DIFF_N;
+    }
+    if (A->Writes != B->Writes ||
+        memcmp (A->Addr, B->Addr, A->Writes * sizeof (A->Addr[0])) != 0 ||
+        memcmp (A->Val, B->Val, A->Writes * sizeof (A->Val[0])) != 0) {
+        Diff |= DIFF_MEM;
+    }
+    return Diff;
+}
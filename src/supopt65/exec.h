@@ -0,0 +1,140 @@
+/*****************************************************************************/
+/*                                                                           */
+/*                                  exec.h                                   */
+/*                                                                           */
+/*                     Run code with the sim65 CPU core                      */
+/*                                                                           */
+/*                                                                           */
+/*                                                                           */
+/* Copyright 2026 The cc65 Authors                                           */
+/*                                                                           */
+/*                                                                           */
+/* This software is provided 'as-is', without any expressed or implied       */
+/* warranty.  In no event will the authors be held liable for any damages    */
+/* arising from the use of this software.                                    */
+/*                                                                           */
+/* Permission is granted to anyone to use this software for any purpose,     */
+/* including commercial applications, and to alter it and redistribute it    */
+/* freely, subject to the following restrictions:                            */
+/*                                                                           */
+/* 1. The origin of this software must not be misrepresented; you must not   */
+/*    claim that you wrote the original software. If you use this software   */
+/*    in a product, an acknowledgment in the product documentation would be  */
+/*    appreciated but is not required.                                       */
+/* 2. Altered source versions must be plainly marked as such, and must not   */
+/*    be misrepresented as being the original software.                      */
+/* 3. This notice may not be removed or altered from any source              */
+/*    distribution.                                                          */
+/*                                                                           */
+/*****************************************************************************/
+
+
+
+/* Sequences are verified by running them with the CPU core of sim65. The
+** memory accesses are done by this module, which records all writes and
+** undoes them after a run, so the same machine state may be used for any
+** number of runs. The other parts of sim65 the core needs are replaced by
+** stubs.
+*/
+
+
+
+#ifndef EXEC_H
+#define EXEC_H
+
+
+
+/* supopt65 */
+#include "insn.h"
+
+
+
+/*****************************************************************************/
+/*                                   Data                                    */
+/*****************************************************************************/
+
+
+
+/* Memory layout. Slots in the zero page are ZP_SPACING bytes apart, so
+** offsets up to ZP_SPACING - 2 may be used with pointers. Slots outside of
+** the zero page are large enough for all offsets plus an index register.
+** Pointers used by indirect instructions point into the heap.
+*/
+#define ZP_BASE         0x10U
+#define ZP_SPACING      0x10U
+#define ABS_BASE        0x0400U
+#define ABS_SIZE        0x0200U
+#define HEAP_BASE       0x2000U
+#define HEAP_SIZE       0x0300U
+
+/* Maximum number of memory locations written by a sequence */
+#define MAX_WRITES      32U
+
+/* Initial machine state */
+typedef struct State State;
+struct State {
+    unsigned char       A, X, Y, P;
+    unsigned            SlotCount;              /* Number of slots used */
+    unsigned char       ZP[0x100];              /* The zero page */
+    unsigned char       Slots[MAX_SLOTS][ABS_SIZE];
+    unsigned char       Heap[HEAP_SIZE];
+    unsigned char       Params[MAX_PARAMS];
+};
+
+/* Machine state after running a sequence */
+typedef struct Result Result;
+struct Result {
+    unsigned char       A, X, Y, P;
+    unsigned            Cycles;
+    unsigned            Writes;                 /* Number of changed bytes */
+    unsigned short      Addr[MAX_WRITES];       /* Sorted addresses */
+    unsigned char       Val[MAX_WRITES];        /* New values */
+};
+
+/* Differences between two results */
+#define DIFF_A          0x0001U
+#define DIFF_X          0x0002U
+#define DIFF_Y          0x0004U
+#define DIFF_C          0x0008U
+#define DIFF_Z          0x0010U
+#define DIFF_V          0x0020U
+#define DIFF_N          0x0040U
+#define DIFF_MEM        0x0080U
+#define DIFF_REGS       (DIFF_A | DIFF_X | DIFF_Y)
+#define DIFF_FLAGS      (DIFF_C | DIFF_Z | DIFF_V | DIFF_N)
+
+
+
+/*****************************************************************************/
+/*                                   Code                                    */
+/*****************************************************************************/
+
+
+
+unsigned char RandomByte (void);
+/* Return a pseudo random byte. The sequence is the same for each run of the
+** program, so the results can be reproduced.
+*/
+
+void SetPointer (State* S, const Insn* I);
+/* If I is an indirect instruction, let the pointer it uses point into the
+** heap, so that the memory read or written depends on the state.
+*/
+
+void InitExec (void);
+/* Initialize the CPU core and fill the memory with random values */
+
+int Run (const Insn* Code, unsigned Count, const State* S, Result* R);
+/* Run a sequence of instructions with the given initial state. Return false
+** if the sequence couldn't be run, because it wrote over its own code or
+** too many memory locations.
+*/
+
+unsigned CompareResults (const Result* A, const Result* B);
+/* Compare two results and return the differences as a set of DIFF_xxx flags */
+
+
+
+/* End of exec.h */
+
+#endif
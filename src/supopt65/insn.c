@@ -0,0 +1,218 @@
+/*****************************************************************************/
+/*                                                                           */
+/*                                  insn.c                                   */
+/*                                                                           */
+/*                 6502 instructions for the superoptimizer                  */
+/*                                                                           */
+/*                                                                           */
+/*                                                                           */
+/* Copyright 2026 The cc65 Authors                                           */
+/*                                                                           */
+/*                                                                           */
+/* This software is provided 'as-is', without any expressed or implied       */
+/* warranty.  In no event will the authors be held liable for any damages    */
+/* arising from the use of this software.                                    */
+/*                                                                           */
+/* Permission is granted to anyone to use this software for any purpose,     */
+/* including commercial applications, and to alter it and redistribute it    */
+/* freely, subject to the following restrictions:                            */
+/*                                                                           */
+/* 1. The origin of this software must not be misrepresented; you must not   */
+/*    claim that you wrote the original software. If you use this software   */
+/*    in a product, an acknowledgment in the product documentation would be  */
+/*    appreciated but is not required.                                       */
+/* 2. Altered source versions must be plainly marked as such, and must not   */
+/*    be misrepresented as being the original software.                      */
+/* 3. This notice may not be removed or altered from any source              */
+/*    distribution.                                                          */
+/*                                                                           */
+/*****************************************************************************/
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* supopt65 */
+#include "insn.h"
+
+
+
+/*****************************************************************************/
+/*                                   Data                                    */
+/*****************************************************************************/
+
+
+
+/* Description of a mnemonic. The opcodes are indexed by the addressing mode,
+** a zero means that the mode doesn't exist.
+*/
+typedef struct MnemoDesc MnemoDesc;
+struct MnemoDesc {
+    const char*         Name;
+    unsigned char       OPC[AM_COUNT];
+};
+
+/* The mnemonics sorted by name. The columns are implied, accumulator,
+** immediate, zp, zp,x, zp,y, abs, abs,x, abs,y, (zp,x) and (zp),y.
+*/
+static const MnemoDesc MnemoTab[] = {
+    { "adc", { 0,    0,    0x69, 0x65, 0x75, 0,    0x6D, 0x7D, 0x79, 0x61, 0x71 } },
+    { "and", { 0,    0,    0x29, 0x25, 0x35, 0,    0x2D, 0x3D, 0x39, 0x21, 0x31 } },
+    { "asl", { 0,    0x0A, 0,    0x06, 0x16, 0,    0x0E, 0x1E, 0,    0,    0    } },
+    { "bit", { 0,    0,    0,    0x24, 0,    0,    0x2C, 0,    0,    0,    0    } },
+    { "clc", { 0x18, 0,    0,    0,    0,    0,    0,    0,    0,    0,    0    } },
+    { "clv", { 0xB8, 0,    0,    0,    0,    0,    0,    0,    0,    0,    0    } },
+    { "cmp", { 0,    0,    0xC9, 0xC5, 0xD5, 0,    0xCD, 0xDD, 0xD9, 0xC1, 0xD1 } },
+    { "cpx", { 0,    0,    0xE0, 0xE4, 0,    0,    0xEC, 0,    0,    0,    0    } },
+    { "cpy", { 0,    0,    0xC0, 0xC4, 0,    0,    0xCC, 0,    0,    0,    0    } },
+    { "dec", { 0,    0,    0,    0xC6, 0xD6, 0,    0xCE, 0xDE, 0,    0,    0    } },
+    { "dex", { 0xCA, 0,    0,    0,    0,    0,    0,    0,    0,    0,    0    } },
+    { "dey", { 0x88, 0,    0,    0,    0,    0,    0,    0,    0,    0,    0    } },
+    { "eor", { 0,    0,    0x49, 0x45, 0x55, 0,    0x4D, 0x5D, 0x59, 0x41, 0x51 } },
+    { "inc", { 0,    0,    0,    0xE6, 0xF6, 0,    0xEE, 0xFE, 0,    0,    0    } },
+    { "inx", { 0xE8, 0,    0,    0,    0,    0,    0,    0,    0,    0,    0    } },
+    { "iny", { 0xC8, 0,    0,    0,    0,    0,    0,    0,    0,    0,    0    } },
+    { "lda", { 0,    0,    0xA9, 0xA5, 0xB5, 0,    0xAD, 0xBD, 0xB9, 0xA1, 0xB1 } },
+    { "ldx", { 0,    0,    0xA2, 0xA6, 0,    0xB6, 0xAE, 0,    0xBE, 0,    0    } },
+    { "ldy", { 0,    0,    0xA0, 0xA4, 0xB4, 0,    0xAC, 0xBC, 0,    0,    0    } },
+    { "lsr", { 0,    0x4A, 0,    0x46, 0x56, 0,    0x4E, 0x5E, 0,    0,    0    } },
+    { "ora", { 0,    0,    0x09, 0x05, 0x15, 0,    0x0D, 0x1D, 0x19, 0x01, 0x11 } },
+    { "rol", { 0,    0x2A, 0,    0x26, 0x36, 0,    0x2E, 0x3E, 0,    0,    0    } },
+    { "ror", { 0,    0x6A, 0,    0x66, 0x76, 0,    0x6E, 0x7E, 0,    0,    0    } },
+    { "sbc", { 0,    0,    0xE9, 0xE5, 0xF5, 0,    0xED, 0xFD, 0xF9, 0xE1, 0xF1 } },
+    { "sec", { 0x38, 0,    0,    0,    0,    0,    0,    0,    0,    0,    0    } },
+    { "sta", { 0,    0,    0,    0x85, 0x95, 0,    0x8D, 0x9D, 0x99, 0x81, 0x91 } },
+    { "stx", { 0,    0,    0,    0x86, 0,    0x96, 0x8E, 0,    0,    0,    0    } },
+    { "sty", { 0,    0,    0,    0x84, 0x94, 0,    0x8C, 0,    0,    0,    0    } },
+    { "tax", { 0xAA, 0,    0,    0,    0,    0,    0,    0,    0,    0,    0    } },
+    { "tay", { 0xA8, 0,    0,    0,    0,    0,    0,    0,    0,    0,    0    } },
+    { "txa", { 0x8A, 0,    0,    0,    0,    0,    0,    0,    0,    0,    0    } },
+    { "tya", { 0x98, 0,    0,    0,    0,    0,    0,    0,    0,    0,    0    } },
+};
+#define MNEMO_COUNT     (sizeof (MnemoTab) / sizeof (MnemoTab[0]))
+
+
+
+/*****************************************************************************/
+/*                                   Code                                    */
+/*****************************************************************************/
+
+
+
+static int CmpMnemo (const void* Key, const void* Desc)
+/* Compare function for bsearch */
+{
+    return strcmp ((const char*) Key, ((const MnemoDesc*) Desc)->Name);
+}
+
+
+
+int FindMnemo (const char* Name)
+/* Return the index of the mnemonic with the given name or -1 if it isn't
+** one of the instructions used by the superoptimizer. Jumps, branches and
+** stack operations are not.
+*/
+{
+    const MnemoDesc* D = bsearch (Name, MnemoTab, MNEMO_COUNT,
+                                  sizeof (MnemoTab[0]), CmpMnemo);
+    return D? (int) (D - MnemoTab) : -1;
+}
+
+
+
+unsigned MnemoCount (void)
+/* Return the number of mnemonics */
+{
+    return MNEMO_COUNT;
+}
+
+
+
+const char* GetMnemoName (unsigned Mnemo)
+/* Return the name of a mnemonic */
+{
+    return MnemoTab[Mnemo].Name;
+}
+
+
+
+unsigned char GetOPC (unsigned Mnemo, am_t AM)
+/* Return the opcode for a mnemonic and an addressing mode or zero if the
+** combination doesn't exist.
+*/
+{
+    return MnemoTab[Mnemo].OPC[AM];
+}
+
+
+
+unsigned GetInsnSize (const Insn* I)
+/* Return the size of an instruction in bytes */
+{
+    switch (I->AM) {
+        case AM_IMP:
+        case AM_ACC:
+            return 1;
+        case AM_ABS:
+        case AM_ABSX:
+        case AM_ABSY:
+            return 3;
+        default:
+            return 2;
+    }
+}
+
+
+
+int IsZPMode (am_t AM)
+/* Return true if the addressing mode has a zero page operand */
+{
+    return AM == AM_ZP || AM == AM_ZPX || AM == AM_ZPY ||
+           AM == AM_ZPXI || AM == AM_ZPIY;
+}
+
+
+
+void FormatInsn (char* Buf, unsigned Size, const Insn* I)
+/* Format an instruction as assembler source. Slots are output as "zpN" or
+** "absN", parameters as "KN".
+*/
+{
+    char Arg[32];
+
+    if (I->AM == AM_IMP) {
+        Arg[0] = '\0';
+    } else if (I->AM == AM_ACC) {
+        strcpy (Arg, "a");
+    } else if (I->AM == AM_IMM) {
+        if (I->Slot == SLOT_CONST) {
+            sprintf (Arg, "#$%02X", I->Val);
+        } else {
+            sprintf (Arg, "#K%u", I->Slot);
+        }
+    } else {
+        char Mem[16];
+        if (I->Val) {
+            sprintf (Mem, "%s%u+%u", IsZPMode (I->AM)? "zp" : "abs", I->Slot, I->Val);
+        } else {
+            sprintf (Mem, "%s%u", IsZPMode (I->AM)? "zp" : "abs", I->Slot);
+        }
+        switch (I->AM) {
+            case AM_ZPX:
+            case AM_ABSX:   sprintf (Arg, "%s,x", Mem);         break;
+            case AM_ZPY:
+            case AM_ABSY:   sprintf (Arg, "%s,y", Mem);         break;
+            case AM_ZPXI:   sprintf (Arg, "(%s,x)", Mem);       break;
+            case AM_ZPIY:   sprintf (Arg, "(%s),y", Mem);       break;
+            default:        strcpy (Arg, Mem);                  break;
+        }
+    }
+
+    if (Arg[0]) {
+        snprintf (Buf, Size, "%-8s%s", GetMnemoName (I->Mnemo), Arg);
+    } else {
+        snprintf (Buf, Size, "%s", GetMnemoName (I->Mnemo));
+    }
+}
@@ -0,0 +1,120 @@
+/*****************************************************************************/
+/*                                                                           */
+/*                                  insn.h                                   */
+/*                                                                           */
+/*                 6502 instructions for the superoptimizer                  */
+/*                                                                           */
+/*                                                                           */
+/*                                                                           */
+/* Copyright 2026 The cc65 Authors                                           */
+/*                                                                           */
+/*                                                                           */
+/* This software is provided 'as-is', without any expressed or implied       */
+/* warranty.  In no event will the authors be held liable for any damages    */
+/* arising from the use of this software.                                    */
+/*                                                                           */
+/* Permission is granted to anyone to use this software for any purpose,     */
+/* including commercial applications, and to alter it and redistribute it    */
+/* freely, subject to the following restrictions:                            */
+/*                                                                           */
+/* 1. The origin of this software must not be misrepresented; you must not   */
+/*    claim that you wrote the original software. If you use this software   */
+/*    in a product, an acknowledgment in the product documentation would be  */
+/*    appreciated but is not required.                                       */
+/* 2. Altered source versions must be plainly marked as such, and must not   */
+/*    be misrepresented as being the original software.                      */
+/* 3. This notice may not be removed or altered from any source              */
+/*    distribution.                                                          */
+/*                                                                           */
+/*****************************************************************************/
+
+
+
+#ifndef INSN_H
+#define INSN_H
+
+
+
+/*****************************************************************************/
+/*                                   Data                                    */
+/*****************************************************************************/
+
+
+
+/* Addressing modes */
+typedef enum {
+    AM_IMP,                     /* Implied */
+    AM_ACC,                     /* Accumulator */
+    AM_IMM,                     /* Immediate */
+    AM_ZP,                      /* Zero page */
+    AM_ZPX,                     /* Zero page indexed by X */
+    AM_ZPY,                     /* Zero page indexed by Y */
+    AM_ABS,                     /* Absolute */
+    AM_ABSX,                    /* Absolute indexed by X */
+    AM_ABSY,                    /* Absolute indexed by Y */
+    AM_ZPXI,                    /* (zp,x) */
+    AM_ZPIY,                    /* (zp),y */
+    AM_COUNT
+} am_t;
+
+/* The operands of instructions are not real addresses and values. Memory
+** operands refer to a slot, which stands for a symbol in the source, plus an
+** offset. Immediate operands are either constants or refer to a parameter,
+** which stands for a symbolic value like "<(_foo)".
+*/
+#define SLOT_CONST      0xFFU   /* Slot of a constant immediate operand */
+
+/* Maximum number of slots and parameters in a sequence */
+#define MAX_SLOTS       8U
+#define MAX_PARAMS      4U
+
+/* An instruction */
+typedef struct Insn Insn;
+struct Insn {
+    unsigned char       Mnemo;          /* Index of the mnemonic */
+    unsigned char       AM;             /* Addressing mode */
+    unsigned char       Slot;           /* Memory slot or parameter */
+    unsigned char       Val;            /* Offset or immediate constant */
+};
+
+
+
+/*****************************************************************************/
+/*                                   Code                                    */
+/*****************************************************************************/
+
+
+
+int FindMnemo (const char* Name);
+/* Return the index of the mnemonic with the given name or -1 if it isn't
+** one of the instructions used by the superoptimizer. Jumps, branches and
+** stack operations are not.
+*/
+
+unsigned MnemoCount (void);
+/* Return the number of mnemonics */
+
+const char* GetMnemoName (unsigned Mnemo);
+/* Return the name of a mnemonic */
+
+unsigned char GetOPC (unsigned Mnemo, am_t AM);
+/* Return the opcode for a mnemonic and an addressing mode or zero if the
+** combination doesn't exist.
+*/
+
+unsigned GetInsnSize (const Insn* I);
+/* Return the size of an instruction in bytes */
+
+int IsZPMode (am_t AM);
+/* Return true if the addressing mode has a zero page operand */
+
+void FormatInsn (char* Buf, unsigned Size, const Insn* I);
+/* Format an instruction as assembler source. Slots are output as "zpN" or
+** "absN", parameters as "KN".
+*/
+
+
+
+/* End of insn.h */
+
+#endif
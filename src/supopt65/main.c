@@ -0,0 +1,418 @@
+/*****************************************************************************/
+/*                                                                           */
+/*                                  main.c                                   */
+/*                                                                           */
+/*                    Main program of the superoptimizer                     */
+/*                                                                           */
+/*                                                                           */
+/*                                                                           */
+/* Copyright 2026 The cc65 Authors                                           */
+/*                                                                           */
+/*                                                                           */
+/* This software is provided 'as-is', without any expressed or implied       */
+/* warranty.  In no event will the authors be held liable for any damages    */
+/* arising from the use of this software.                                    */
+/*                                                                           */
+/* Permission is granted to anyone to use this software for any purpose,     */
+/* including commercial applications, and to alter it and redistribute it    */
+/* freely, subject to the following restrictions:                            */
+/*                                                                           */
+/* 1. The origin of this software must not be misrepresented; you must not   */
+/*    claim that you wrote the original software. If you use this software   */
+/*    in a product, an acknowledgment in the product documentation would be  */
+/*    appreciated but is not required.                                       */
+/* 2. Altered source versions must be plainly marked as such, and must not   */
+/*    be misrepresented as being the original software.                      */
+/* 3. This notice may not be removed or altered from any source              */
+/*    distribution.                                                          */
+/*                                                                           */
+/*****************************************************************************/
+
+
+
+/* supopt65 reads assembler files written by cc65 and counts how often each
+** short sequence of instructions occurs. For the most frequent ones, it
+** enumerates all shorter or faster sequences built from the same operands
+** and runs them with the CPU core of sim65 on a set of machine states. The
+** sequences that behave like the original are output as candidates for new
+** rules of the peephole optimizer. The results are meant to be reviewed by a
+** human before they are added to the optimizer, since a test with a limited
+** number of states is no proof.
+**
+** Usage: supopt65 [options] file.s ...
+*/
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+/* common */
+#include "cmdline.h"
+#include "coll.h"
+#include "print.h"
+#include "version.h"
+
+/* supopt65 */
+#include "error.h"
+#include "exec.h"
+#include "insn.h"
+#include "mine.h"
+#include "search.h"
+
+
+
+/*****************************************************************************/
+/*                                   Data                                    */
+/*****************************************************************************/
+
+
+
+/* Options */
+static unsigned         WindowLen       = 3;    /* Maximum window length */
+static unsigned         SearchLen       = 3;    /* Maximum replacement length */
+static unsigned         WindowCount     = 100;  /* Number of windows searched */
+static unsigned long    MinCount        = 2;    /* Minimum occurrences */
+static const char*      OutputName      = 0;    /* Output file */
+
+
+
+/*****************************************************************************/
+/*                                   Code                                    */
+/*****************************************************************************/
+
+
+
+static void Usage (void)
+/* Print usage information and exit */
+{
+    printf ("Usage: %s [options] file ...\n"
+            "Short options:\n"
+            "  -V\t\t\tPrint the version number\n"
+            "  -h\t\t\tHelp (this text)\n"
+            "  -l n\t\t\tSet the maximum window length (default 3)\n"
+            "  -m n\t\t\tSet the minimum number of occurrences (default 2)\n"
+            "  -n n\t\t\tSet the number of windows searched (default 100)\n"
+            "  -o name\t\tName the output file\n"
+            "  -s n\t\t\tSet the maximum replacement length (default 3)\n"
+            "  -v\t\t\tIncrease verbosity\n"
+            "\n"
+            "Long options:\n"
+            "  --help\t\tHelp (this text)\n"
+            "  --min-count n\t\tSet the minimum number of occurrences\n"
+            "  --search-length n\tSet the maximum replacement length\n"
+            "  --verbose\t\tIncrease verbosity\n"
+            "  --version\t\tPrint the version number\n"
+            "  --window-length n\tSet the maximum window length\n"
+            "  --windows n\t\tSet the number of windows searched\n",
+            ProgName);
+}
+
+
+
+static unsigned GetNumber (const char* Opt, const char* Arg,
+                           unsigned Min, unsigned Max)
+/* Convert the argument of an option into a number and check its range */
+{
+    unsigned Val;
+    char     C;
+
+    if (sscanf (Arg, "%u%c", &Val, &C) != 1 || Val < Min || Val > Max) {
+        Error ("Argument of option '%s' must be in the range %u..%u",
+               Opt, Min, Max);
+    }
+    return Val;
+}
+
+
+
+static void OptHelp (const char* Opt attribute ((unused)),
+                     const char* Arg attribute ((unused)))
+/* Print usage information and exit */
+{
+    Usage ();
+    exit (EXIT_SUCCESS);
+}
+
+
+
+static void OptMinCount (const char* Opt, const char* Arg)
+/* Handle the --min-count option */
+{
+    MinCount = GetNumber (Opt, Arg, 1, 0xFFFF);
+}
+
+
+
+static void OptSearchLength (const char* Opt, const char* Arg)
+/* Handle the --search-length option */
+{
+    SearchLen = GetNumber (Opt, Arg, 0, MAX_WINDOW);
+}
+
+
+
+static void OptVerbose (const char* Opt attribute ((unused)),
+                        const char* Arg attribute ((unused)))
+/* Increase verbosity */
+{
+    ++Verbosity;
+}
+
+
+
+static void OptVersion (const char* Opt attribute ((unused)),
+                        const char* Arg attribute ((unused)))
+/* Print the program version */
+{
+    fprintf (stderr, "%s V%s\n", ProgName, GetVersionAsString ());
+    exit (EXIT_SUCCESS);
+}
+
+
+
+static void OptWindowLength (const char* Opt, const char* Arg)
+/* Handle the --window-length option */
+{
+    WindowLen = GetNumber (Opt, Arg, 2, MAX_WINDOW);
+}
+
+
+
+static void OptWindows (const char* Opt, const char* Arg)
+/* Handle the --windows option */
+{
+    WindowCount = GetNumber (Opt, Arg, 1, 0xFFFF);
+}
+
+
+
+static long Savings (const Rule* R)
+/* Return the savings of a rule for all occurrences of its window. Bytes and
+** cycles weigh the same.
+*/
+{
+    long Old = (long) (R->OldBytes * NUM_STATES + R->OldCycles);
+    long New = (long) (R->NewBytes * NUM_STATES + R->NewCycles);
+    return (long) R->W->Count * (Old - New) / (long) NUM_STATES;
+}
+
+
+
+static int CompareRules (void* Data attribute ((unused)),
+                         const void* Left, const void* Right)
+/* Compare two rules by their savings */
+{
+    long L = Savings (Left);
+    long R = Savings (Right);
+
+    if (L != R) {
+        return (L > R)? -1 : 1;
+    }
+    return 0;
+}
+
+
+
+static void PrintCode (FILE* F, const Insn* Code, unsigned Len)
+/* Output a sequence of instructions */
+{
+    char     Buf[64];
+    unsigned I;
+
+    if (Len == 0) {
+        fprintf (F, "        ; (nothing)\n");
+    }
+    for (I = 0; I < Len; ++I) {
+        FormatInsn (Buf, sizeof (Buf), Code + I);
+        fprintf (F, "        %s\n", Buf);
+    }
+}
+
+
+
+static void PrintCost (FILE* F, unsigned Bytes, unsigned Cycles)
+/* Output the size and the average number of cycles of a sequence */
+{
+    unsigned Avg = (Cycles * 10 + NUM_STATES / 2) / NUM_STATES;
+    fprintf (F, "%u byte%s, %u.%u cycles", Bytes, (Bytes == 1)? "" : "s",
+             Avg / 10, Avg % 10);
+}
+
+
+
+static void PrintUnused (FILE* F, unsigned Unused)
+/* Output the registers and flags that must be unused after a replacement */
+{
+    static const struct {
+        unsigned        Mask;
+        const char*     Name;
+    } Names[] = {
+        { DIFF_A, "A" }, { DIFF_X, "X" }, { DIFF_Y, "Y" },
+        { DIFF_C, "C" }, { DIFF_Z, "Z" }, { DIFF_V, "V" }, { DIFF_N, "N" },
+    };
+    unsigned Count = 0;
+    unsigned I;
+
+    if (Unused == 0) {
+        return;
+    }
+    fprintf (F, ", if ");
+    for (I = 0; I < sizeof (Names) / sizeof (Names[0]); ++I) {
+        if (Unused & Names[I].Mask) {
+            fprintf (F, "%s%s", (Count++ > 0)? ", " : "", Names[I].Name);
+        }
+    }
+    fprintf (F, " %s unused", (Count == 1)? "is" : "are");
+}
+
+
+
+static void PrintRules (FILE* F, Collection* Rules)
+/* Output the rules sorted by savings */
+{
+    unsigned I;
+
+    CollSort (Rules, CompareRules, 0);
+    for (I = 0; I < CollCount (Rules); ++I) {
+        const Rule* R = CollConstAt (Rules, I);
+
+        fprintf (F, "; %lu times, first in %s\n", R->W->Count, R->W->Where);
+        fprintf (F, "; ");
+        PrintCost (F, R->OldBytes, R->OldCycles);
+        fprintf (F, "\n");
+        PrintCode (F, R->W->Code, R->W->Len);
+        fprintf (F, "; Replacement: ");
+        PrintCost (F, R->NewBytes, R->NewCycles);
+        PrintUnused (F, R->Unused);
+        fprintf (F, "\n");
+        PrintCode (F, R->Code, R->Len);
+        fprintf (F, "\n");
+    }
+}
+
+
+
+int main (int argc, char* argv [])
+/* Superoptimizer main program */
+{
+    /* Program long options */
+    static const LongOpt OptTab[] = {
+        { "--help",             0,      OptHelp                 },
+        { "--min-count",        1,      OptMinCount             },
+        { "--search-length",    1,      OptSearchLength         },
+        { "--verbose",          0,      OptVerbose              },
+        { "--version",          0,      OptVersion              },
+        { "--window-length",    1,      OptWindowLength         },
+        { "--windows",          1,      OptWindows              },
+    };
+
+    Collection  Files   = STATIC_COLLECTION_INITIALIZER;
+    Collection  Windows = STATIC_COLLECTION_INITIALIZER;
+    Collection  Rules   = STATIC_COLLECTION_INITIALIZER;
+    FILE*       F;
+    unsigned    I;
+
+    /* Initialize the cmdline module */
+    InitCmdLine (&argc, &argv, "supopt65");
+
+    /* Check the parameters */
+    I = 1;
+    while (I < ArgCount) {
+
+        /* Get the argument */
+        const char* Arg = ArgVec [I];
+
+        /* Check for an option */
+        if (Arg [0] == '-') {
+            switch (Arg [1]) {
+
+                case '-':
+                    LongOption (&I, OptTab, sizeof(OptTab)/sizeof(OptTab[0]));
+                    break;
+
+                case 'h':
+                    OptHelp (Arg, 0);
+                    break;
+
+                case 'l':
+                    OptWindowLength (Arg, GetArg (&I, 2));
+                    break;
+
+                case 'm':
+                    OptMinCount (Arg, GetArg (&I, 2));
+                    break;
+
+                case 'n':
+                    OptWindows (Arg, GetArg (&I, 2));
+                    break;
+
+                case 'o':
+                    OutputName = GetArg (&I, 2);
+                    break;
+
+                case 's':
+                    OptSearchLength (Arg, GetArg (&I, 2));
+                    break;
+
+                case 'v':
+                    OptVerbose (Arg, 0);
+                    break;
+
+                case 'V':
+                    OptVersion (Arg, 0);
+                    break;
+
+                default:
+                    UnknownOption (Arg);
+                    break;
+            }
+        } else {
+            CollAppend (&Files, (void*) Arg);
+        }
+
+        /* Next argument */
+        ++I;
+    }
+
+    /* Do we have input files? */
+    if (CollCount (&Files) == 0) {
+        Error ("No input files");
+    }
+
+    /* Count the windows in all files */
+    for (I = 0; I < CollCount (&Files); ++I) {
+        Print (stderr, 2, "Reading %s\n", (const char*) CollConstAt (&Files, I));
+        MineFile (CollConstAt (&Files, I), WindowLen);
+    }
+    GetWindows (&Windows, MinCount);
+
+    /* Search for replacements of the most frequent ones */
+    InitExec ();
+    for (I = 0; I < CollCount (&Windows) && I < WindowCount; ++I) {
+        const Window* W = CollConstAt (&Windows, I);
+        Print (stderr, 2, "Searching window %u (%lu times)\n", I + 1, W->Count);
+        SearchWindow (W, SearchLen, &Rules);
+    }
+    Print (stderr, 1, "%u windows searched, %lu candidates tested\n",
+           I, GetTestedCount ());
+
+    /* Output the results */
+    if (OutputName) {
+        F = fopen (OutputName, "w");
+        if (F == 0) {
+            Error ("Cannot open output file '%s': %s", OutputName, strerror (errno));
+        }
+    } else {
+        F = stdout;
+    }
+    PrintRules (F, &Rules);
+    if (F != stdout && fclose (F) != 0) {
+        Error ("Error closing output file '%s': %s", OutputName, strerror (errno));
+    }
+
+    /* Return an appropriate exit code */
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,560 @@
+/*****************************************************************************/
+/*                                                                           */
+/*                                  mine.c                                   */
+/*                                                                           */
+/*                   Collect frequent instruction windows                    */
+/*                                                                           */
+/*                                                                           */
+/*                                                                           */
+/* Copyright 2026 The cc65 Authors                                           */
+/*                                                                           */
+/*                                                                           */
+/* This software is provided 'as-is', without any expressed or implied       */
+/* warranty.  In no event will the authors be held liable for any damages    */
+/* arising from the use of this software.                                    */
+/*                                                                           */
+/* Permission is granted to anyone to use this software for any purpose,     */
+/* including commercial applications, and to alter it and redistribute it    */
+/* freely, subject to the following restrictions:                            */
+/*                                                                           */
+/* 1. The origin of this software must not be misrepresented; you must not   */
+/*    claim that you wrote the original software. If you use this software   */
+/*    in a product, an acknowledgment in the product documentation would be  */
+/*    appreciated but is not required.                                       */
+/* 2. Altered source versions must be plainly marked as such, and must not   */
+/*    be misrepresented as being the original software.                      */
+/* 3. This notice may not be removed or altered from any source              */
+/*    distribution.                                                          */
+/*                                                                           */
+/*****************************************************************************/
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+/* common */
+#include "chartype.h"
+#include "xmalloc.h"
+#include "xsprintf.h"
+
+/* supopt65 */
+#include "error.h"
+#include "exec.h"
+#include "mine.h"
+
+
+
+/*****************************************************************************/
+/*                                   Data                                    */
+/*****************************************************************************/
+
+
+
+/* An instruction as read from the input file */
+typedef struct RawInsn RawInsn;
+struct RawInsn {
+    unsigned            Line;           /* Line number in the file */
+    unsigned char       Mnemo;          /* Index of the mnemonic */
+    unsigned char       AM;             /* Addressing mode */
+    unsigned char       Val;            /* Offset or immediate constant */
+    char                Name[64];       /* Symbol or parameter, may be empty */
+};
+
+/* The last instructions of the current block */
+static RawInsn          Block[MAX_WINDOW];
+static unsigned         BlockLen;
+
+/* Zero page symbols known in the current file */
+static Collection       ZPSyms = STATIC_COLLECTION_INITIALIZER;
+
+/* The zero page locations of the runtime are always known */
+static const char* const RuntimeZP[] = {
+    "sp", "sreg", "regsave", "regbank",
+    "tmp1", "tmp2", "tmp3", "tmp4",
+    "ptr1", "ptr2", "ptr3", "ptr4",
+};
+
+/* The current input file */
+static const char*      CurFile;
+
+/* Hash table with all windows */
+#define HASHTAB_SIZE    4099U
+static Window*          HashTab[HASHTAB_SIZE];
+
+
+
+/*****************************************************************************/
+/*                             Helper functions                              */
+/*****************************************************************************/
+
+
+
+static const char* SkipBlanks (const char* P)
+/* Skip white space */
+{
+    while (IsBlank (*P)) {
+        ++P;
+    }
+    return P;
+}
+
+
+
+static int IsIdentChar (char C)
+/* Return true if C may be part of an identifier */
+{
+    return IsAlNum (C) || C == '_' || C == '@' || C == '.';
+}
+
+
+
+static const char* ReadIdent (const char* P, char* Buf, unsigned Size)
+/* Read an identifier into Buf. Return a pointer behind the identifier or
+** NULL if there is no identifier or it is too long.
+*/
+{
+    unsigned Len = 0;
+
+    if (!IsIdentChar (*P) || IsDigit (*P)) {
+        return 0;
+    }
+    while (IsIdentChar (*P)) {
+        if (Len + 1 >= Size) {
+            return 0;
+        }
+        Buf[Len++] = *P++;
+    }
+    Buf[Len] = '\0';
+    return P;
+}
+
+
+
+static const char* ReadNumber (const char* P, unsigned long* Val)
+/* Read a number in ca65 syntax. Return a pointer behind the number or NULL
+** if there is no number.
+*/
+{
+    char* End;
+
+    if (*P == '$') {
+        ++P;
+        if (!IsXDigit (*P)) {
+            return 0;
+        }
+        *Val = strtoul (P, &End, 16);
+    } else if (IsDigit (*P)) {
+        *Val = strtoul (P, &End, 10);
+    } else {
+        return 0;
+    }
+    return End;
+}
+
+
+
+static int IsZPSym (const char* Name)
+/* Return true if the given symbol is a zero page location */
+{
+    unsigned I;
+
+    for (I = 0; I < sizeof (RuntimeZP) / sizeof (RuntimeZP[0]); ++I) {
+        if (strcmp (RuntimeZP[I], Name) == 0) {
+            return 1;
+        }
+    }
+    for (I = 0; I < CollCount (&ZPSyms); ++I) {
+        if (strcmp (CollConstAt (&ZPSyms, I), Name) == 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+
+
+static void AddZPSym (const char* Name)
+/* Remember a zero page symbol of the current file */
+{
+    if (!IsZPSym (Name)) {
+        CollAppend (&ZPSyms, xstrdup (Name));
+    }
+}
+
+
+
+static void FreeZPSyms (void)
+/* Forget the zero page symbols of the current file */
+{
+    unsigned I;
+
+    for (I = 0; I < CollCount (&ZPSyms); ++I) {
+        xfree (CollAtUnchecked (&ZPSyms, I));
+    }
+    CollDeleteAll (&ZPSyms);
+}
+
+
+
+static int ParseOperand (RawInsn* R, const char* Arg)
+/* Parse the operand of an instruction. Return false if it can't be handled */
+{
+    unsigned long Val = 0;
+    int           Indirect = 0;
+    char          Index = '\0';
+    int           ZP;
+    am_t          AM;
+
+    /* No operand or the accumulator */
+    if (*Arg == '\0' || strcmp (Arg, "a") == 0) {
+        R->AM = GetOPC (R->Mnemo, AM_IMP)? AM_IMP : AM_ACC;
+        return GetOPC (R->Mnemo, R->AM) != 0;
+    }
+
+    /* Immediate operand. Anything but a number is a parameter. */
+    if (*Arg == '#') {
+        const char* P = ReadNumber (Arg + 1, &Val);
+        R->AM = AM_IMM;
+        if (P && *P == '\0') {
+            if (Val > 0xFF) {
+                return 0;
+            }
+            R->Val = (unsigned char) Val;
+        } else if (strlen (Arg + 1) < sizeof (R->Name)) {
+            strcpy (R->Name, Arg + 1);
+        } else {
+            return 0;
+        }
+        return GetOPC (R->Mnemo, AM_IMM) != 0;
+    }
+
+    /* A memory operand. Addresses given as numbers are hardware registers or
+    ** similar and are not handled.
+    */
+    if (*Arg == '(') {
+        Indirect = 1;
+        ++Arg;
+    }
+    Arg = ReadIdent (Arg, R->Name, sizeof (R->Name));
+    if (Arg == 0) {
+        return 0;
+    }
+    if (*Arg == '+') {
+        Arg = ReadNumber (Arg + 1, &Val);
+        if (Arg == 0 || Val >= ABS_SIZE - 0xFF) {
+            return 0;
+        }
+    }
+    if (Indirect) {
+        if (strcmp (Arg, "),y") == 0) {
+            Index = 'y';
+        } else if (strcmp (Arg, ",x)") == 0) {
+            Index = 'x';
+        } else {
+            return 0;
+        }
+    } else if (Arg[0] == ',' && (Arg[1] == 'x' || Arg[1] == 'y') && Arg[2] == '\0') {
+        Index = Arg[1];
+    } else if (*Arg != '\0') {
+        return 0;
+    }
+
+    /* Determine the addressing mode */
+    ZP = IsZPSym (R->Name);
+    if (Indirect) {
+        AM = (Index == 'x')? AM_ZPXI : AM_ZPIY;
+    } else if (Index == 'x') {
+        AM = ZP? AM_ZPX : AM_ABSX;
+    } else if (Index == 'y') {
+        AM = ZP? AM_ZPY : AM_ABSY;
+    } else {
+        AM = ZP? AM_ZP : AM_ABS;
+    }
+    if (IsZPMode (AM) && (!ZP || Val > ZP_SPACING - 2)) {
+        return 0;
+    }
+    R->AM  = AM;
+    R->Val = (unsigned char) Val;
+    return GetOPC (R->Mnemo, AM) != 0;
+}
+
+
+
+static unsigned HashWindow (const Window* W)
+/* Return the hash value of a window */
+{
+    const unsigned char* P = (const unsigned char*) W->Code;
+    unsigned             Size = W->Len * sizeof (W->Code[0]);
+    unsigned             H = W->Len;
+
+    while (Size--) {
+        H = H * 31U + *P++;
+    }
+    return H;
+}
+
+
+
+static int Canonicalize (Window* W, const RawInsn* R, unsigned Len)
+/* Convert a sequence of raw instructions into a window. Return false if
+** there are too many different symbols.
+*/
+{
+    const char* Slots[MAX_SLOTS];
+    const char* Params[MAX_PARAMS];
+    unsigned    I, J;
+
+    memset (W, 0, sizeof (*W));
+    W->Len = Len;
+    for (I = 0; I < Len; ++I) {
+        Insn* C = W->Code + I;
+
+        C->Mnemo = R[I].Mnemo;
+        C->AM    = R[I].AM;
+        C->Val   = R[I].Val;
+        if (R[I].AM == AM_IMM) {
+            if (R[I].Name[0] == '\0') {
+                C->Slot = SLOT_CONST;
+                continue;
+            }
+            C->Val = 0;
+            for (J = 0; J < W->Params && strcmp (Params[J], R[I].Name) != 0; ++J) {
+            }
+            if (J == W->Params) {
+                if (J == MAX_PARAMS) {
+                    return 0;
+                }
+                Params[W->Params++] = R[I].Name;
+            }
+            C->Slot = (unsigned char) J;
+        } else if (R[I].AM != AM_IMP && R[I].AM != AM_ACC) {
+            for (J = 0; J < W->Slots && strcmp (Slots[J], R[I].Name) != 0; ++J) {
+            }
+            if (J == W->Slots) {
+                if (J == MAX_SLOTS) {
+                    return 0;
+                }
+                Slots[W->Slots++] = R[I].Name;
+            }
+            C->Slot = (unsigned char) J;
+        }
+    }
+    return 1;
+}
+
+
+
+static void CountWindow (const RawInsn* R, unsigned Len)
+/* Count one occurrence of a sequence of instructions */
+{
+    Window   W;
+    Window*  E;
+    unsigned Hash;
+
+    if (!Canonicalize (&W, R, Len)) {
+        return;
+    }
+
+    /* Search for the window in the hash table */
+    Hash = HashWindow (&W) % HASHTAB_SIZE;
+    E = HashTab[Hash];
+    while (E) {
+        if (E->Len == W.Len &&
+            memcmp (E->Code, W.Code, W.Len * sizeof (W.Code[0])) == 0) {
+            ++E->Count;
+            return;
+        }
+        E = E->Next;
+    }
+
+    /* Not found, add a new one */
+    {
+        char Buf[256];
+        xsprintf (Buf, sizeof (Buf), "%s(%u)", CurFile, R->Line);
+        E = xdup (&W, sizeof (W));
+        E->Count = 1;
+        E->Where = xstrdup (Buf);
+        E->Next  = HashTab[Hash];
+        HashTab[Hash] = E;
+    }
+}
+
+
+
+static void AddInsn (const RawInsn* R, unsigned MaxLen)
+/* Add an instruction to the current block and count all windows that end
+** with it.
+*/
+{
+    unsigned Len;
+
+    if (BlockLen == MaxLen) {
+        memmove (Block, Block + 1, (MaxLen - 1) * sizeof (Block[0]));
+        --BlockLen;
+    }
+    Block[BlockLen++] = *R;
+    for (Len = 2; Len <= BlockLen; ++Len) {
+        CountWindow (Block + BlockLen - Len, Len);
+    }
+}
+
+
+
+static void ParseDirective (const char* P)
+/* Handle the directives that tell about zero page symbols */
+{
+    char Name[64];
+
+    if (strncmp (P, ".importzp", 9) == 0 && IsBlank (P[9])) {
+        P += 9;
+        while (1) {
+            P = ReadIdent (SkipBlanks (P), Name, sizeof (Name));
+            if (P == 0) {
+                break;
+            }
+            AddZPSym (Name);
+            P = SkipBlanks (P);
+            if (*P != ',') {
+                break;
+            }
+            ++P;
+        }
+    }
+}
+
+
+
+/*****************************************************************************/
+/*                                   Code                                    */
+/*****************************************************************************/
+
+
+
+void MineFile (const char* Name, unsigned MaxLen)
+/* Read an assembler file written by cc65 and count all sequences of two up
+** to MaxLen instructions that don't cross a label or an instruction that
+** isn't handled by the superoptimizer.
+*/
+{
+    char     Line[512];
+    unsigned LineNum = 0;
+    int      InZP = 0;
+    FILE*    F;
+
+    F = fopen (Name, "r");
+    if (F == 0) {
+        Error ("Cannot open input file '%s': %s", Name, strerror (errno));
+    }
+    CurFile  = Name;
+    BlockLen = 0;
+
+    while (fgets (Line, sizeof (Line), F)) {
+        RawInsn     R;
+        char        Ident[64];
+        char*       Arg;
+        const char* P;
+        int         M;
+
+        ++LineNum;
+
+        /* Remove the comment and trailing white space */
+        Arg = strchr (Line, ';');
+        if (Arg) {
+            *Arg = '\0';
+        }
+        Arg = Line + strlen (Line);
+        while (Arg > Line && IsSpace (Arg[-1])) {
+            *--Arg = '\0';
+        }
+
+        /* Labels and other symbol definitions start in column one */
+        P = Line;
+        if (!IsBlank (*P) && *P != '\0') {
+            P = ReadIdent (Line, Ident, sizeof (Ident));
+            BlockLen = 0;
+            if (P && *P == ':') {
+                if (InZP) {
+                    AddZPSym (Ident);
+                }
+                ++P;
+            } else {
+                continue;
+            }
+        }
+        P = SkipBlanks (P);
+        if (*P == '\0') {
+            continue;
+        }
+
+        /* Directives. Line infos don't break a sequence. */
+        if (*P == '.') {
+            if (strncmp (P, ".dbg", 4) == 0 && IsBlank (P[4])) {
+                continue;
+            }
+            if (strncmp (P, ".segment", 8) == 0 && IsBlank (P[8])) {
+                InZP = strcmp (SkipBlanks (P + 8), "\"ZEROPAGE\"") == 0;
+            }
+            ParseDirective (P);
+            BlockLen = 0;
+            continue;
+        }
+
+        /* An instruction */
+        memset (&R, 0, sizeof (R));
+        R.Line = LineNum;
+        P = ReadIdent (P, Ident, sizeof (Ident));
+        M = P? FindMnemo (Ident) : -1;
+        if (M < 0) {
+            BlockLen = 0;
+            continue;
+        }
+        R.Mnemo = (unsigned char) M;
+        if (!ParseOperand (&R, SkipBlanks (P))) {
+            BlockLen = 0;
+            continue;
+        }
+        AddInsn (&R, MaxLen);
+    }
+
+    fclose (F);
+    FreeZPSyms ();
+}
+
+
+
+static int CompareWindows (void* Data attribute ((unused)),
+                           const void* Left, const void* Right)
+/* Compare two windows by number of occurrences, then by length */
+{
+    const Window* L = Left;
+    const Window* R = Right;
+
+    if (L->Count != R->Count) {
+        return (L->Count > R->Count)? -1 : 1;
+    }
+    return (int) R->Len - (int) L->Len;
+}
+
+
+
+void GetWindows (Collection* C, unsigned long MinCount)
+/* Add all windows found at least MinCount times to the collection, sorted
+** by descending number of occurrences.
+*/
+{
+    unsigned I;
+
+    for (I = 0; I < HASHTAB_SIZE; ++I) {
+        Window* W = HashTab[I];
+        while (W) {
+            if (W->Count >= MinCount) {
+                CollAppend (C, W);
+            }
+            W = W->Next;
+        }
+    }
+    CollSort (C, CompareWindows, 0);
+}
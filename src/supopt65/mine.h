@@ -0,0 +1,94 @@
+/*****************************************************************************/
+/*                                                                           */
+/*                                  mine.h                                   */
+/*                                                                           */
+/*                   Collect frequent instruction windows                    */
+/*                                                                           */
+/*                                                                           */
+/*                                                                           */
+/* Copyright 2026 The cc65 Authors                                           */
+/*                                                                           */
+/*                                                                           */
+/* This software is provided 'as-is', without any expressed or implied       */
+/* warranty.  In no event will the authors be held liable for any damages    */
+/* arising from the use of this software.                                    */
+/*                                                                           */
+/* Permission is granted to anyone to use this software for any purpose,     */
+/* including commercial applications, and to alter it and redistribute it    */
+/* freely, subject to the following restrictions:                            */
+/*                                                                           */
+/* 1. The origin of this software must not be misrepresented; you must not   */
+/*    claim that you wrote the original software. If you use this software   */
+/*    in a product, an acknowledgment in the product documentation would be  */
+/*    appreciated but is not required.                                       */
+/* 2. Altered source versions must be plainly marked as such, and must not   */
+/*    be misrepresented as being the original software.                      */
+/* 3. This notice may not be removed or altered from any source              */
+/*    distribution.                                                          */
+/*                                                                           */
+/*****************************************************************************/
+
+
+
+#ifndef MINE_H
+#define MINE_H
+
+
+
+/* common */
+#include "coll.h"
+
+/* supopt65 */
+#include "insn.h"
+
+
+
+/*****************************************************************************/
+/*                                   Data                                    */
+/*****************************************************************************/
+
+
+
+/* Maximum length of a window */
+#define MAX_WINDOW      4U
+
+/* A sequence of instructions found in the input files. The operands are in
+** canonical form: Slots and parameters are numbered in the order of their
+** first use, so sequences that differ only in the names of the symbols are
+** the same window.
+*/
+typedef struct Window Window;
+struct Window {
+    Window*             Next;           /* Next in hash chain */
+    unsigned long       Count;          /* Number of occurrences */
+    char*               Where;          /* Location of the first occurrence */
+    unsigned            Len;            /* Number of instructions */
+    unsigned            Slots;          /* Number of slots used */
+    unsigned            Params;         /* Number of parameters used */
+    Insn                Code[MAX_WINDOW];
+};
+
+
+
+/*****************************************************************************/
+/*                                   Code                                    */
+/*****************************************************************************/
+
+
+
+void MineFile (const char* Name, unsigned MaxLen);
+/* Read an assembler file written by cc65 and count all sequences of two up
+** to MaxLen instructions that don't cross a label or an instruction that
+** isn't handled by the superoptimizer.
+*/
+
+void GetWindows (Collection* C, unsigned long MinCount);
+/* Add all windows found at least MinCount times to the collection, sorted
+** by descending number of occurrences.
+*/
+
+
+
+/* End of mine.h */
+
+#endif
@@ -0,0 +1,457 @@
+/*****************************************************************************/
+/*                                                                           */
+/*                                 search.c                                  */
+/*                                                                           */
+/*                  Search for cheaper equivalent sequences                  */
+/*                                                                           */
+/*                                                                           */
+/*                                                                           */
+/* Copyright 2026 The cc65 Authors                                           */
+/*                                                                           */
+/*                                                                           */
+/* This software is provided 'as-is', without any expressed or implied       */
+/* warranty.  In no event will the authors be held liable for any damages    */
+/* arising from the use of this software.                                    */
+/*                                                                           */
+/* Permission is granted to anyone to use this software for any purpose,     */
+/* including commercial applications, and to alter it and redistribute it    */
+/* freely, subject to the following restrictions:                            */
+/*                                                                           */
+/* 1. The origin of this software must not be misrepresented; you must not   */
+/*    claim that you wrote the original software. If you use this software   */
+/*    in a product, an acknowledgment in the product documentation would be  */
+/*    appreciated but is not required.                                       */
+/* 2. Altered source versions must be plainly marked as such, and must not   */
+/*    be misrepresented as being the original software.                      */
+/* 3. This notice may not be removed or altered from any source              */
+/*    distribution.                                                          */
+/*                                                                           */
+/*****************************************************************************/
+
+
+
+#include <string.h>
+
+/* common */
+#include "xmalloc.h"
+
+/* supopt65 */
+#include "exec.h"
+#include "search.h"
+
+
+
+/*****************************************************************************/
+/*                                   Data                                    */
+/*****************************************************************************/
+
+
+
+/* Values that are tested in any case, because they trigger the special
+** cases of the flags.
+*/
+static const unsigned char EdgeValues[] = { 0x00, 0x01, 0x7F, 0x80, 0xFF };
+#define EDGE_COUNT      (sizeof (EdgeValues) / sizeof (EdgeValues[0]))
+
+/* The test states and the results of the window for them */
+static State            States[NUM_STATES];
+static Result           Expected[NUM_STATES];
+
+/* The instructions candidates are built from */
+#define MAX_ALPHABET    512U
+static Insn             Alphabet[MAX_ALPHABET];
+static unsigned         AlphaBytes[MAX_ALPHABET];
+static unsigned         AlphaCycles[MAX_ALPHABET];      /* Lower bound */
+static unsigned         AlphaCount;
+
+/* The window searched */
+static unsigned         OldBytes;
+static unsigned         OldCycles;
+
+/* The candidate sequence */
+static Insn             Cand[MAX_WINDOW];
+
+/* The best candidate for each set of differences. Only the flags may differ,
+** since removing loads of unused registers is done by the optimizer anyway.
+*/
+#define DIFF_SETS       (DIFF_FLAGS + 1)
+typedef struct Best Best;
+struct Best {
+    int                 Valid;
+    int                 Subset;         /* Uses only instructions of the window */
+    unsigned            Len;
+    Insn                Code[MAX_WINDOW];
+    unsigned            Bytes;
+    unsigned            Cycles;
+};
+static Best             BestTab[DIFF_SETS];
+
+/* Number of candidates tested */
+static unsigned long    Tested;
+
+
+
+/*****************************************************************************/
+/*                             Helper functions                              */
+/*****************************************************************************/
+
+
+
+static unsigned BitCount (unsigned Mask)
+/* Return the number of bits set in Mask */
+{
+    unsigned Count = 0;
+    while (Mask) {
+        Mask &= Mask - 1;
+        ++Count;
+    }
+    return Count;
+}
+
+
+
+static unsigned Cost (unsigned Bytes, unsigned Cycles)
+/* Return the cost of a sequence. Bytes and average cycles weigh the same. */
+{
+    return Bytes * NUM_STATES + Cycles;
+}
+
+
+
+static void Fill (unsigned char* Buf, unsigned Size, unsigned K, unsigned char V)
+/* Fill memory for state K. V is the value used for the states that test
+** equality.
+*/
+{
+    unsigned I;
+
+    for (I = 0; I < Size; ++I) {
+        if (K < EDGE_COUNT * EDGE_COUNT) {
+            Buf[I] = EdgeValues[(K + I) % EDGE_COUNT];
+        } else if (K < EDGE_COUNT * EDGE_COUNT + 8) {
+            Buf[I] = V;
+        } else {
+            Buf[I] = RandomByte ();
+        }
+    }
+}
+
+
+
+static void MakeStates (const Window* W)
+/* Create the machine states used for testing a window. The first ones use
+** the edge values, the next ones use the same value everywhere, so equality
+** is tested. The remaining ones are random.
+*/
+{
+    unsigned K, I;
+
+    for (K = 0; K < NUM_STATES; ++K) {
+        State*        S = States + K;
+        unsigned char V = RandomByte ();
+
+        if (K < EDGE_COUNT * EDGE_COUNT) {
+            S->A = EdgeValues[K % EDGE_COUNT];
+            S->X = EdgeValues[K / EDGE_COUNT];
+            S->Y = EdgeValues[(K + K / EDGE_COUNT) % EDGE_COUNT];
+        } else if (K < EDGE_COUNT * EDGE_COUNT + 8) {
+            S->A = S->X = S->Y = V;
+        } else {
+            S->A = RandomByte ();
+            S->X = RandomByte ();
+            S->Y = RandomByte ();
+        }
+        S->P = RandomByte ();
+        S->SlotCount = W->Slots;
+        Fill (S->ZP, sizeof (S->ZP), K, V);
+        Fill (S->Slots[0], W->Slots * ABS_SIZE, K, V);
+        Fill (S->Heap, sizeof (S->Heap), K, V);
+        Fill (S->Params, sizeof (S->Params), K, V);
+        for (I = 0; I < W->Len; ++I) {
+            SetPointer (S, W->Code + I);
+        }
+    }
+}
+
+
+
+static void AddToAlphabet (unsigned Mnemo, am_t AM, unsigned Slot, unsigned Val)
+/* Add an instruction to the alphabet if it exists and isn't already there */
+{
+    Insn     I;
+    Result   R;
+    unsigned K;
+
+    if (GetOPC (Mnemo, AM) == 0 || AlphaCount >= MAX_ALPHABET) {
+        return;
+    }
+    I.Mnemo = (unsigned char) Mnemo;
+    I.AM    = (unsigned char) AM;
+    I.Slot  = (unsigned char) Slot;
+    I.Val   = (unsigned char) Val;
+    for (K = 0; K < AlphaCount; ++K) {
+        if (memcmp (Alphabet + K, &I, sizeof (I)) == 0) {
+            return;
+        }
+    }
+
+    /* Determine the lowest number of cycles the instruction takes */
+    AlphaCycles[AlphaCount] = ~0U;
+    for (K = 0; K < NUM_STATES; ++K) {
+        if (!Run (&I, 1, States + K, &R)) {
+            /* Instructions that can't run don't need to be tried */
+            return;
+        }
+        if (R.Cycles < AlphaCycles[AlphaCount]) {
+            AlphaCycles[AlphaCount] = R.Cycles;
+        }
+    }
+    Alphabet[AlphaCount]   = I;
+    AlphaBytes[AlphaCount] = GetInsnSize (&I);
+    ++AlphaCount;
+}
+
+
+
+static void MakeAlphabet (const Window* W)
+/* Build the alphabet for a window. It contains all instructions without
+** operand, all immediate instructions with the constants and parameters of
+** the window and a few other constants, and all instructions using one of
+** the memory operands of the window.
+*/
+{
+    unsigned char Consts[MAX_WINDOW + EDGE_COUNT];
+    unsigned      ConstCount = 0;
+    unsigned      M, I, J;
+
+    /* Collect the constants */
+    Consts[ConstCount++] = 0x00;
+    Consts[ConstCount++] = 0x01;
+    Consts[ConstCount++] = 0xFF;
+    for (I = 0; I < W->Len; ++I) {
+        const Insn* C = W->Code + I;
+        if (C->AM == AM_IMM && C->Slot == SLOT_CONST) {
+            for (J = 0; J < ConstCount && Consts[J] != C->Val; ++J) {
+            }
+            if (J == ConstCount) {
+                Consts[ConstCount++] = C->Val;
+            }
+        }
+    }
+
+    AlphaCount = 0;
+    for (M = 0; M < MnemoCount (); ++M) {
+        AddToAlphabet (M, AM_IMP, 0, 0);
+        AddToAlphabet (M, AM_ACC, 0, 0);
+        for (I = 0; I < ConstCount; ++I) {
+            AddToAlphabet (M, AM_IMM, SLOT_CONST, Consts[I]);
+        }
+        for (I = 0; I < W->Params; ++I) {
+            AddToAlphabet (M, AM_IMM, I, 0);
+        }
+        for (I = 0; I < W->Len; ++I) {
+            const Insn* C = W->Code + I;
+            if (C->AM != AM_IMP && C->AM != AM_ACC && C->AM != AM_IMM) {
+                AddToAlphabet (M, C->AM, C->Slot, C->Val);
+            }
+        }
+    }
+}
+
+
+
+static int IsSubset (const Window* W, unsigned Len)
+/* Return true if the candidate consists of instructions of the window,
+** maybe in another order.
+*/
+{
+    int      Used[MAX_WINDOW] = { 0 };
+    unsigned I, J;
+
+    for (I = 0; I < Len; ++I) {
+        for (J = 0; J < W->Len; ++J) {
+            if (!Used[J] && memcmp (W->Code + J, Cand + I, sizeof (Cand[0])) == 0) {
+                Used[J] = 1;
+                break;
+            }
+        }
+        if (J == W->Len) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+
+
+static void Check (const Window* W, unsigned Len, unsigned Bytes)
+/* Check the candidate sequence against the window */
+{
+    Result   R;
+    unsigned Diff = 0;
+    unsigned Cycles = 0;
+    unsigned K;
+    Best*    B;
+
+    ++Tested;
+    for (K = 0; K < NUM_STATES; ++K) {
+        if (!Run (Cand, Len, States + K, &R)) {
+            return;
+        }
+        Diff |= CompareResults (Expected + K, &R);
+        if ((Diff & (DIFF_MEM | DIFF_REGS)) != 0) {
+            return;
+        }
+        Cycles += R.Cycles;
+        if (Cycles > OldCycles) {
+            return;
+        }
+    }
+
+    /* The candidate must be better in at least one way */
+    if (Bytes == OldBytes && Cycles == OldCycles) {
+        return;
+    }
+
+    /* Remember it if it's the best one for this set of differences */
+    B = BestTab + Diff;
+    if (B->Valid) {
+        unsigned New = Cost (Bytes, Cycles);
+        unsigned Old = Cost (B->Bytes, B->Cycles);
+        if (New > Old || (New == Old && Len >= B->Len)) {
+            return;
+        }
+    }
+    B->Valid  = 1;
+    B->Subset = IsSubset (W, Len);
+    B->Len    = Len;
+    B->Bytes  = Bytes;
+    B->Cycles = Cycles;
+    memcpy (B->Code, Cand, Len * sizeof (Cand[0]));
+}
+
+
+
+static void Enumerate (const Window* W, unsigned Depth, unsigned MaxLen,
+                       unsigned Bytes, unsigned Cycles)
+/* Enumerate all candidates starting with the Depth instructions already in
+** Cand. Bytes is their size, Cycles a lower bound of their cycles for all
+** states.
+*/
+{
+    unsigned I;
+
+    Check (W, Depth, Bytes);
+    if (Depth == MaxLen) {
+        return;
+    }
+    for (I = 0; I < AlphaCount; ++I) {
+        unsigned NewBytes  = Bytes + AlphaBytes[I];
+        unsigned NewCycles = Cycles + AlphaCycles[I] * NUM_STATES;
+        if (NewBytes > OldBytes || NewCycles > OldCycles ||
+            (NewBytes == OldBytes && NewCycles == OldCycles)) {
+            continue;
+        }
+        Cand[Depth] = Alphabet[I];
+        Enumerate (W, Depth + 1, MaxLen, NewBytes, NewCycles);
+    }
+}
+
+
+
+/*****************************************************************************/
+/*                                   Code                                    */
+/*****************************************************************************/
+
+
+
+void SearchWindow (const Window* W, unsigned MaxLen, Collection* Rules)
+/* Search for sequences of up to MaxLen instructions that are cheaper than
+** the given window and add them to Rules. There may be more than one
+** replacement, if a replacement requires that some flags are unused after
+** the window.
+*/
+{
+    unsigned K, Count, Unused;
+    Rule*    Found[DIFF_SETS];
+    int      Subset[DIFF_SETS];
+    unsigned FoundCount = 0;
+
+    /* Determine what the window does */
+    MakeStates (W);
+    OldBytes  = 0;
+    OldCycles = 0;
+    for (K = 0; K < W->Len; ++K) {
+        OldBytes += GetInsnSize (W->Code + K);
+    }
+    for (K = 0; K < NUM_STATES; ++K) {
+        if (!Run (W->Code, W->Len, States + K, Expected + K)) {
+            return;
+        }
+        OldCycles += Expected[K].Cycles;
+    }
+
+    /* Search */
+    memset (BestTab, 0, sizeof (BestTab));
+    MakeAlphabet (W);
+    if (MaxLen > W->Len) {
+        MaxLen = W->Len;
+    }
+    Enumerate (W, 0, MaxLen, 0, 0);
+
+    /* Output the replacements with the fewest unused flags first. A
+    ** replacement is only useful if it's cheaper than all others that have a
+    ** subset of its requirements. Replacements that just remove instructions
+    ** with unused results are not output, since the optimizer does that
+    ** anyway.
+    */
+    for (Count = 0; Count <= BitCount (DIFF_SETS - 1); ++Count) {
+        for (Unused = 0; Unused < DIFF_SETS; ++Unused) {
+            const Best* B = BestTab + Unused;
+            Rule*       R;
+            unsigned    I;
+
+            if (!B->Valid || BitCount (Unused) != Count) {
+                continue;
+            }
+            for (I = 0; I < FoundCount; ++I) {
+                const Rule* F = Found[I];
+                if ((F->Unused & ~Unused) == 0 &&
+                    Cost (F->NewBytes, F->NewCycles) <= Cost (B->Bytes, B->Cycles)) {
+                    break;
+                }
+            }
+            if (I < FoundCount) {
+                continue;
+            }
+
+            R = xmalloc (sizeof (Rule));
+            R->W         = W;
+            R->Unused    = Unused;
+            R->Len       = B->Len;
+            memcpy (R->Code, B->Code, B->Len * sizeof (B->Code[0]));
+            R->OldBytes  = OldBytes;
+            R->NewBytes  = B->Bytes;
+            R->OldCycles = OldCycles;
+            R->NewCycles = B->Cycles;
+            Subset[FoundCount]  = B->Subset;
+            Found[FoundCount++] = R;
+        }
+    }
+
+    for (K = 0; K < FoundCount; ++K) {
+        if (Subset[K]) {
+            xfree (Found[K]);
+        } else {
+            CollAppend (Rules, Found[K]);
+        }
+    }
+}
+
+
+
+unsigned long GetTestedCount (void)
+/* Return the number of candidate sequences tested so far */
+{
+    return Tested;
+}
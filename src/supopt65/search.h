@@ -0,0 +1,90 @@
+/*****************************************************************************/
+/*                                                                           */
+/*                                 search.h                                  */
+/*                                                                           */
+/*                  Search for cheaper equivalent sequences                  */
+/*                                                                           */
+/*                                                                           */
+/*                                                                           */
+/* Copyright 2026 The cc65 Authors                                           */
+/*                                                                           */
+/*                                                                           */
+/* This software is provided 'as-is', without any expressed or implied       */
+/* warranty.  In no event will the authors be held liable for any damages    */
+/* arising from the use of this software.                                    */
+/*                                                                           */
+/* Permission is granted to anyone to use this software for any purpose,     */
+/* including commercial applications, and to alter it and redistribute it    */
+/* freely, subject to the following restrictions:                            */
+/*                                                                           */
+/* 1. The origin of this software must not be misrepresented; you must not   */
+/*    claim that you wrote the original software. If you use this software   */
+/*    in a product, an acknowledgment in the product documentation would be  */
+/*    appreciated but is not required.                                       */
+/* 2. Altered source versions must be plainly marked as such, and must not   */
+/*    be misrepresented as being the original software.                      */
+/* 3. This notice may not be removed or altered from any source              */
+/*    distribution.                                                          */
+/*                                                                           */
+/*****************************************************************************/
+
+
+
+#ifndef SEARCH_H
+#define SEARCH_H
+
+
+
+/* common */
+#include "coll.h"
+
+/* supopt65 */
+#include "mine.h"
+
+
+
+/*****************************************************************************/
+/*                                   Data                                    */
+/*****************************************************************************/
+
+
+
+/* Number of machine states used to test a sequence */
+#define NUM_STATES      64U
+
+/* A cheaper replacement for a window */
+typedef struct Rule Rule;
+struct Rule {
+    const Window*       W;              /* The window replaced */
+    unsigned            Unused;         /* DIFF_xxx that must be unused */
+    unsigned            Len;            /* Length of the replacement */
+    Insn                Code[MAX_WINDOW];
+    unsigned            OldBytes;       /* Size of the window */
+    unsigned            NewBytes;       /* Size of the replacement */
+    unsigned            OldCycles;      /* Cycles of the window for all states */
+    unsigned            NewCycles;      /* Same for the replacement */
+};
+
+
+
+/*****************************************************************************/
+/*                                   Code                                    */
+/*****************************************************************************/
+
+
+
+void SearchWindow (const Window* W, unsigned MaxLen, Collection* Rules);
+/* Search for sequences of up to MaxLen instructions that are cheaper than
+** the given window and add them to Rules. There may be more than one
+** replacement, if a replacement requires that some flags are unused after
+** the window.
+*/
+
+unsigned long GetTestedCount (void);
+/* Return the number of candidate sequences tested so far */
+
+
+
+/* End of search.h */
+
+#endif
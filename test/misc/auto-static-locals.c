@@ -0,0 +1,172 @@
+/*
+  !!DESCRIPTION!! Locals of non-reentrant functions in static memory
+  !!ORIGIN!!      cc65 regression tests
+  !!LICENCE!!     Public Domain
+*/
+
+/* Must be compiled with --auto-static-locals */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static unsigned char failures = 0;
+
+#define CHECK(expr, expected)                                           \
+    do {                                                                \
+        long Result = (expr);                                           \
+        if (Result != (expected)) {                                     \
+            printf ("%s = %ld, expected %ld\n", #expr, Result,          \
+                    (long) (expected));                                 \
+            ++failures;                                                 \
+        }                                                               \
+    } while (0)
+
+static unsigned char* addr;
+
+/* Leaf function, the local must be static */
+static int leaf (int x)
+{
+    int a[4];
+    unsigned char i;
+    for (i = 0; i < 4; ++i) {
+        a[i] = x + i;
+    }
+    addr = (unsigned char*) a;
+    return a[3];
+}
+
+/* The locals must survive the calls, even if other functions share them */
+static int inner (int x)
+{
+    int v = x * 2;
+    int w = leaf (v);
+    return v + w;
+}
+
+static int outer (int x)
+{
+    int p = x;
+    int q = inner (x + 1);
+    int r = leaf (x);
+    return p * 100 + q + r;
+}
+
+/* Recursive functions */
+static int fact (int n)
+{
+    int r;
+    if (n < 2) {
+        return 1;
+    }
+    r = fact (n - 1);
+    return n * r;
+}
+
+static int is_odd (int n);
+
+static int is_even (int n)
+{
+    int m = n;
+    if (m == 0) {
+        return 1;
+    }
+    return is_odd (m - 1) && m >= 0;
+}
+
+static int is_odd (int n)
+{
+    int m = n;
+    if (m == 0) {
+        return 0;
+    }
+    return is_even (m - 1) && m >= 0;
+}
+
+/* Recursion through a function pointer */
+static int (*walker) (int);
+
+static int walk (int n)
+{
+    int k = n;
+    if (k == 0) {
+        return 0;
+    }
+    return walker (k - 1) + k;
+}
+
+/* Callback from the library */
+static int cmp (const void* l, const void* r)
+{
+    int d = *(const int*) l - *(const int*) r;
+    return d;
+}
+
+/* Functions called from interrupt handlers stay on the stack */
+static unsigned char* isr_addr;
+
+static void isr_helper (void)
+{
+    unsigned char b[2];
+    isr_addr = b;
+}
+
+void handler (void) __attribute__ ((interrupt));
+
+void handler (void)
+{
+    isr_helper ();
+}
+
+/* Calls the functions with some more bytes on the stack */
+static void deeper (void (*f) (void))
+{
+    volatile char pad[8];
+    pad[0] = 0;
+    f ();
+}
+
+static void call_leaf (void)
+{
+    leaf (1);
+}
+
+int main (void)
+{
+    unsigned char* a1;
+    unsigned char* a2;
+    int v[5] = { 5, 3, 9, 1, 7 };
+
+    CHECK (leaf (10), 13);
+    CHECK (inner (3), 15);
+    CHECK (outer (5), 500 + 12 + 15 + 8);
+
+    CHECK (fact (7), 5040);
+    CHECK (is_even (10), 1);
+    CHECK (is_odd (7), 1);
+    CHECK (is_even (7), 0);
+
+    walker = walk;
+    CHECK (walk (10), 55);
+
+    qsort (v, 5, sizeof (v[0]), cmp);
+    CHECK (v[0], 1);
+    CHECK (v[2], 5);
+    CHECK (v[4], 9);
+
+    /* A static local has the same address regardless of the stack */
+    call_leaf ();
+    a1 = addr;
+    deeper (call_leaf);
+    a2 = addr;
+    CHECK (a1 == a2, 1);
+
+    /* A local on the stack has not */
+    handler ();
+    a1 = isr_addr;
+    deeper (handler);
+    a2 = isr_addr;
+    CHECK (a1 == a2, 0);
+
+    printf ("failures: %u\n", failures);
+    return failures;
+}
@@ -0,0 +1,70 @@
+/*
+  !!DESCRIPTION!! Several files compiled in one invocation
+  !!ORIGIN!!      cc65 regression tests
+  !!LICENCE!!     Public Domain
+*/
+
+/* Compiled twice in one invocation, the output of the second translation
+** unit must be the same as the output of the first one. The end of this
+** file changes settings that must not leak into the next unit.
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#ifdef BATCH_DEFINED
+#error "Macro from the previous translation unit"
+#endif
+#define BATCH_DEFINED
+
+static unsigned char failures = 0;
+
+#define CHECK(expr, expected)                                           \
+    do {                                                                \
+        long Result = (expr);                                           \
+        if (Result != (expected)) {                                     \
+            printf ("%s = %ld, expected %ld\n", #expr, Result,          \
+                    (long) (expected));                                 \
+            ++failures;                                                 \
+        }                                                               \
+    } while (0)
+
+static struct {
+    union {
+        char    c;
+        int     i;
+    };
+    unsigned    n;
+} item;
+
+static char buffer[8];
+static char high = (char) 0x80;
+
+int main (void)
+{
+    static const char* const names[] = { "one", "two", "three" };
+
+    CHECK (__COUNTER__, 0);
+    CHECK (__COUNTER__, 1);
+    CHECK ('A', 0x41);
+    CHECK (high, 0x80);
+    CHECK (strlen (names[2]), 5);
+
+    item.i = 0x1234;
+    item.n = sizeof (item);
+    CHECK (item.n, 4);
+    strcpy (buffer, names[1]);
+    CHECK (strcmp (buffer, "two"), 0);
+
+    if (failures) {
+        printf ("failures: %u\n", failures);
+    }
+    return failures;
+}
+
+/* Left behind for the next translation unit */
+#pragma bss-name (push, "XBSS")
+#pragma charmap (0x41, 0x61)
+#pragma signed-chars (on)
+#pragma static-locals (push, on)
+#pragma warn (unused-var, push, off)
@@ -0,0 +1,19 @@
+/*
+  !!DESCRIPTION!! Precompiled headers that are out of date or have warnings
+  !!ORIGIN!!      cc65 regression tests
+  !!LICENCE!!     Public Domain
+*/
+
+/* The header is copied from pch-deps1.h and pch-deps2.h. The precompiled
+** header must not be used after it was changed, or with other macros on the
+** command line, and the warning from the header must be output each time.
+*/
+
+#include "pch-deps.h"
+
+int pch_deps_value = PCH_DEPS_VALUE;
+
+int main (void)
+{
+    return pch_deps_value == PCH_DEPS_VALUE? 0 : 1;
+}
@@ -0,0 +1,11 @@
+/* Second version of the header for pch-deps.c, it has another value */
+
+#ifdef PCH_DEPS_WARN
+#warning "Warning from the header prefix"
+#endif
+
+#ifndef PCH_DEPS_OFFSET
+#define PCH_DEPS_OFFSET 0
+#endif
+
+#define PCH_DEPS_VALUE  (20 + PCH_DEPS_OFFSET)
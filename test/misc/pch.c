@@ -0,0 +1,71 @@
+/*
+  !!DESCRIPTION!! Precompiled headers
+  !!ORIGIN!!      cc65 regression tests
+  !!LICENCE!!     Public Domain
+*/
+
+/* Compiled with and without --pch, the output must be the same */
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+/* The header prefix ends with the next include */
+#include "pch.h"
+
+/* Already included, must be skipped */
+#include "pch.h"
+
+static unsigned char failures = 0;
+
+#define CHECK(expr, expected)                                           \
+    do {                                                                \
+        long Result = (expr);                                           \
+        if (Result != (expected)) {                                     \
+            printf ("%s = %ld, expected %ld\n", #expr, Result,          \
+                    (long) (expected));                                 \
+            ++failures;                                                 \
+        }                                                               \
+    } while (0)
+
+static int pch_sum (int first, ...)
+{
+    va_list ap;
+    int sum = 0;
+    int v = first;
+
+    va_start (ap, first);
+    while (v >= 0) {
+        sum += v;
+        v = va_arg (ap, int);
+    }
+    va_end (ap);
+    return sum;
+}
+
+int main (void)
+{
+    unsigned char i;
+
+    for (i = 0; i < PCH_C; ++i) {
+        pch_items[i].kind = i;
+        pch_items[i].value = PCH_SQUARE (i);
+    }
+
+    CHECK (PCH_SQUARE (7), 49);
+    CHECK (PCH_SUM (1, 2, 3), 6);
+    CHECK (PCH_VALUE, 42);
+    CHECK (strlen (PCH_NAME), 3);
+    CHECK (pch_counter, 0);
+    CHECK (__COUNTER__, 1);
+    CHECK (pch_line, 11);
+    CHECK (__LINE__, 61);
+    CHECK (sizeof (pch_item), 3);
+    CHECK (PCH_B, 4);
+    CHECK (pch_items[4].value, 16);
+    CHECK (strcmp (__FILE__, "pch.c"), 0);
+
+    if (failures) {
+        printf ("failures: %u\n", failures);
+    }
+    return failures;
+}
@@ -0,0 +1,24 @@
+/* Header for pch.c, read from the precompiled header on the second run */
+
+#pragma once
+
+#define PCH_SQUARE(x)           ((x) * (x))
+#define PCH_SUM(...)            pch_sum (__VA_ARGS__, -1)
+#define PCH_VALUE               42
+#define PCH_NAME                "pch"
+
+static const unsigned pch_counter = __COUNTER__;
+static const unsigned pch_line = __LINE__;
+
+typedef struct {
+    unsigned char   kind;
+    int             value;
+} pch_item;
+
+enum { PCH_A = 3, PCH_B, PCH_C };
+
+#pragma bss-name (push, "BSS")
+static pch_item pch_items[PCH_C];
+#pragma bss-name (pop)
+
+static int pch_sum (int first, ...);
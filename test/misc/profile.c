@@ -0,0 +1,71 @@
+/*
+  !!DESCRIPTION!! Optimization guided by an execution profile
+  !!ORIGIN!!      cc65 regression tests
+  !!LICENCE!!     Public Domain
+*/
+
+/* The program is run once to write a profile with sim65 --profile, then
+** compiled again with --use-profile and with USE_PROFILE defined. The hot
+** and the cold function have the same source. Without a profile they must
+** have the same size. With the profile and the optimizer, the hot one is
+** optimized for speed and the cold one for size.
+*/
+
+#include <stdio.h>
+
+#define BODY                                                            \
+    {                                                                   \
+        switch (x & 0x0F) {                                             \
+            case 0:  x += 3;  break;                                    \
+            case 1:  x -= 7;  break;                                    \
+            case 2:  x ^= 9;  break;                                    \
+            case 3:  x += 11; break;                                    \
+            case 4:  x -= 13; break;                                    \
+            case 5:  x ^= 15; break;                                    \
+            case 6:  x += 17; break;                                    \
+            case 7:  x -= 19; break;                                    \
+            case 8:  x ^= 21; break;                                    \
+            case 9:  x += 23; break;                                    \
+        }                                                               \
+        return x * 45;                                                  \
+    }
+
+unsigned hot (unsigned x)
+BODY
+
+void hot_end (void)
+{
+}
+
+unsigned cold (unsigned x)
+BODY
+
+void cold_end (void)
+{
+}
+
+int main (void)
+{
+    unsigned HotSize  = (unsigned) hot_end - (unsigned) hot;
+    unsigned ColdSize = (unsigned) cold_end - (unsigned) cold;
+    unsigned Sum = cold (1);
+    unsigned I;
+
+    for (I = 0; I < 2000; ++I) {
+        Sum += hot (I);
+    }
+
+#if defined(USE_PROFILE) && defined(__OPT__)
+    if (HotSize == ColdSize) {
+        printf ("hot and cold function have the same size: %u\n", HotSize);
+        return 1;
+    }
+#elif !defined(USE_PROFILE)
+    if (HotSize != ColdSize) {
+        printf ("hot: %u bytes, cold: %u bytes\n", HotSize, ColdSize);
+        return 1;
+    }
+#endif
+    printf ("%u\n", Sum);
+    return 0;
+}
@@ -0,0 +1,143 @@
+/*
+  !!DESCRIPTION!! Frequently used locals and parameters in the register bank
+  !!ORIGIN!!      cc65 regression tests
+  !!LICENCE!!     Public Domain
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#pragma auto-register-vars (on)
+
+static unsigned char failures = 0;
+
+#define CHECK(expr, expected)                                           \
+    do {                                                                \
+        long Result = (expr);                                           \
+        if (Result != (expected)) {                                     \
+            printf ("%s = %ld, expected %ld\n", #expr, Result,          \
+                    (long) (expected));                                 \
+            ++failures;                                                 \
+        }                                                               \
+    } while (0)
+
+/* Loop counter and pointer in the register bank */
+static unsigned sum (const unsigned char* p, unsigned char n)
+{
+    unsigned s = 0;
+    unsigned char i;
+    for (i = 0; i < n; ++i) {
+        s += *p++;
+    }
+    return s;
+}
+
+/* Recursion, the callee must restore the register bank */
+static unsigned fib (unsigned n)
+{
+    unsigned a = 0, b = 1, t;
+    unsigned char k;
+    if (n > 10) {
+        /* Uses the register bank of this activation after the call */
+        return fib (n - 1) + fib (n - 2);
+    }
+    for (k = 0; k < n; ++k) {
+        t = a + b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+/* Address taken, must stay on the stack */
+static void inc (unsigned* p)
+{
+    ++*p;
+}
+
+static unsigned count (unsigned char n)
+{
+    unsigned c = 0;
+    unsigned char i;
+    for (i = 0; i < n; ++i) {
+        inc (&c);
+    }
+    return c;
+}
+
+/* More candidates than space in the register bank, nested loops, explicit
+** register variable, and preprocessor directives in the body.
+*/
+static long nested (unsigned char n)
+{
+    unsigned char i, j;
+    int x = 0, y = 0;
+    register int z = 0;
+    long r = 0;
+    for (i = 0; i < n; ++i) {
+#if 1
+#define STEP 2
+        for (j = 0; j < n; ++j) {
+            x += STEP;
+            y -= j;
+            z += i;
+            while (x > 100) {
+                x -= 7;
+            }
+        }
+#undef STEP
+#endif
+        r += x + y + z;
+    }
+    return r;
+}
+
+static long nested_ref (unsigned char n)
+{
+    volatile unsigned char i, j;
+    volatile int x = 0, y = 0, z = 0;
+    volatile long r = 0;
+    for (i = 0; i < n; ++i) {
+        for (j = 0; j < n; ++j) {
+            x += 2;
+            y -= j;
+            z += i;
+            while (x > 100) {
+                x -= 7;
+            }
+        }
+        r += x + y + z;
+    }
+    return r;
+}
+
+/* Parameters in the register bank, string literals read ahead */
+static unsigned char scan (const char* s, char c)
+{
+    unsigned char n = 0;
+    while (*s) {
+        if (*s++ == c) {
+            ++n;
+        }
+    }
+    return n + strlen ("abc" "def");
+}
+
+int main (void)
+{
+    static const unsigned char data[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+    unsigned char i;
+
+    CHECK (sum (data, sizeof (data)), 55);
+    CHECK (fib (10), 55);
+    CHECK (fib (12), 144);
+    CHECK (count (200), 200);
+    for (i = 0; i < 20; ++i) {
+        CHECK (nested (i), nested_ref (i));
+    }
+    CHECK (scan ("hello world", 'o'), 8);
+    CHECK (scan ("hello world", 'x'), 6);
+
+    printf ("failures: %u\n", failures);
+    return failures;
+}
@@ -0,0 +1,94 @@
+/*
+  !!DESCRIPTION!! Code variants chosen by the cycle weight
+  !!ORIGIN!!      cc65 regression tests
+  !!LICENCE!!     Public Domain
+*/
+
+#include <stdio.h>
+
+static unsigned char failures = 0;
+
+#define CHECK(expr, expected)                                           \
+    do {                                                                \
+        long Result = (expr);                                           \
+        if (Result != (expected)) {                                     \
+            printf ("%s = %ld, expected %ld\n", #expr, Result,          \
+                    (long) (expected));                                 \
+            ++failures;                                                 \
+        }                                                               \
+    } while (0)
+
+static unsigned char n;
+
+/* The same code is compiled with all weights, the results must not differ */
+#define FUNCS(suffix)                                                   \
+    static unsigned shl_##suffix (unsigned x)                           \
+    {                                                                   \
+        return x << 3;                                                  \
+    }                                                                   \
+    static unsigned char shly_##suffix (unsigned char x)                \
+    {                                                                   \
+        return (unsigned char) (x << n);                                \
+    }                                                                   \
+    static unsigned shry_##suffix (unsigned char x)                     \
+    {                                                                   \
+        return (unsigned) x >> n;                                       \
+    }                                                                   \
+    static int asr_##suffix (int x)                                     \
+    {                                                                   \
+        return x >> 2;                                                  \
+    }                                                                   \
+    static unsigned sel_##suffix (unsigned char x)                      \
+    {                                                                   \
+        switch (x) {                                                    \
+            case 1:     return 10;                                      \
+            case 2:     return 20;                                      \
+            case 3:     return 30;                                      \
+            case 5:     return 50;                                      \
+            case 7:     return 70;                                      \
+            case 8:     return 80;                                      \
+            case 9:     return 90;                                      \
+            case 12:    return 120;                                     \
+            default:    return 0;                                       \
+        }                                                               \
+    }
+
+#pragma cycle-weight (push, 0)
+FUNCS (size)
+#pragma cycle-weight (pop)
+
+#pragma cycle-weight (push, 50)
+FUNCS (mix)
+#pragma cycle-weight (pop)
+
+#pragma cycle-weight (push, 100)
+FUNCS (speed)
+#pragma cycle-weight (pop)
+
+#define TEST(suffix)                                                    \
+    do {                                                                \
+        n = 3;                                                          \
+        CHECK (shl_##suffix (0x1234), 0x91A0);                          \
+        CHECK (shly_##suffix (0x35), 0xA8);                             \
+        CHECK (shry_##suffix (0xF5), 0x1E);                             \
+        n = 0;                                                          \
+        CHECK (shly_##suffix (0x35), 0x35);                             \
+        CHECK (shry_##suffix (0xF5), 0xF5);                             \
+        CHECK (asr_##suffix (-1000), -250);                             \
+        CHECK (asr_##suffix (1001), 250);                               \
+        CHECK (sel_##suffix (0), 0);                                    \
+        CHECK (sel_##suffix (5), 50);                                   \
+        CHECK (sel_##suffix (6), 0);                                    \
+        CHECK (sel_##suffix (12), 120);                                 \
+        CHECK (sel_##suffix (200), 0);                                  \
+    } while (0)
+
+int main (void)
+{
+    TEST (size);
+    TEST (mix);
+    TEST (speed);
+
+    printf ("failures: %u\n", failures);
+    return failures;
+}
@@ -0,0 +1,156 @@
+/*
+  !!DESCRIPTION!! Unsigned division and modulo by constants
+  !!ORIGIN!!      cc65 regression tests
+  !!LICENCE!!     Public Domain
+*/
+
+#include <stdio.h>
+
+static unsigned char failures = 0;
+
+/* Not a constant, so the runtime division is used */
+static unsigned char d8;
+static unsigned d16;
+
+typedef unsigned char (*Func8) (unsigned char);
+typedef unsigned (*Func16) (unsigned);
+
+#define DIV8(d, suffix)                                                 \
+    static unsigned char div8_##d##_##suffix (unsigned char x)          \
+    {                                                                   \
+        return x / d;                                                   \
+    }                                                                   \
+    static unsigned char mod8_##d##_##suffix (unsigned char x)          \
+    {                                                                   \
+        return x % d;                                                   \
+    }                                                                   \
+    static unsigned char asg8_##d##_##suffix (unsigned char x)          \
+    {                                                                   \
+        x /= d;                                                         \
+        return x;                                                       \
+    }
+
+#define DIV16(name, d, suffix)                                          \
+    static unsigned div16_##name##_##suffix (unsigned x)                \
+    {                                                                   \
+        return x / d;                                                   \
+    }                                                                   \
+    static unsigned mod16_##name##_##suffix (unsigned x)                \
+    {                                                                   \
+        return x % d;                                                   \
+    }
+
+/* The same code is compiled with the runtime call, as a loop and unrolled */
+#define FUNCS(suffix)                                                   \
+    DIV8 (3, suffix)                                                    \
+    DIV8 (10, suffix)                                                   \
+    DIV8 (100, suffix)                                                  \
+    DIV8 (127, suffix)                                                  \
+    DIV8 (200, suffix)                                                  \
+    DIV16 (3, 3, suffix)                                                \
+    DIV16 (10, 10, suffix)                                              \
+    DIV16 (200, 200, suffix)                                            \
+    DIV16 (1000, 1000, suffix)                                          \
+    DIV16 (40000, 40000U, suffix)
+
+#pragma cycle-weight (push, 0)
+FUNCS (call)
+#pragma cycle-weight (pop)
+
+#pragma cycle-weight (push, 20)
+FUNCS (loop)
+#pragma cycle-weight (pop)
+
+#pragma cycle-weight (push, 100)
+FUNCS (unrolled)
+#pragma cycle-weight (pop)
+
+static void Test8 (unsigned char d, Func8 Div, Func8 Mod, Func8 Asg)
+/* Compare all results against the runtime division */
+{
+    unsigned char x = 0;
+    d8 = d;
+    do {
+        if (Div (x) != x / d8 || Mod (x) != x % d8 || Asg (x) != x / d8) {
+            printf ("%u / %u: %u %u %u\n", x, d, Div (x), Mod (x), Asg (x));
+            ++failures;
+            return;
+        }
+    } while (++x != 0);
+}
+
+static void Test16 (unsigned d, Func16 Div, Func16 Mod, unsigned Step)
+/* Compare the results for all dividends or for every Step one of them
+** against the runtime division.
+*/
+{
+    unsigned x = 0;
+    d16 = d;
+    do {
+        if (Div (x) != x / d16 || Mod (x) != x % d16) {
+            printf ("%u / %u: %u %u\n", x, d, Div (x), Mod (x));
+            ++failures;
+            return;
+        }
+        x += Step;
+    } while (x >= Step);
+}
+
+static void TestAll16 (unsigned d, Func16 Div, Func16 Mod)
+/* Check the results for all dividends, counting quotient and remainder */
+{
+    unsigned x = 0;
+    unsigned q = 0;
+    unsigned r = 0;
+    do {
+        if (Div (x) != q || Mod (x) != r) {
+            printf ("%u / %u: %u %u\n", x, d, Div (x), Mod (x));
+            ++failures;
+            return;
+        }
+        if (++r == d) {
+            r = 0;
+            ++q;
+        }
+    } while (++x != 0);
+}
+
+#define TEST8(d, suffix)                                                \
+    Test8 (d, div8_##d##_##suffix, mod8_##d##_##suffix,                 \
+           asg8_##d##_##suffix)
+
+#define TEST16(name, d, suffix, Step)                                   \
+    Test16 (d, div16_##name##_##suffix, mod16_##name##_##suffix, Step); \
+    Test16 (d, div16_##name##_##suffix, mod16_##name##_##suffix,        \
+            Step + 1)
+
+#define TESTALL16(name, d, suffix)                                      \
+    TestAll16 (d, div16_##name##_##suffix, mod16_##name##_##suffix)
+
+#define TEST(suffix)                                                    \
+    do {                                                                \
+        TEST8 (3, suffix);                                              \
+        TEST8 (10, suffix);                                             \
+        TEST8 (100, suffix);                                            \
+        TEST8 (127, suffix);                                            \
+        TEST8 (200, suffix);                                            \
+        TEST16 (3, 3, suffix, 97);                                      \
+        TEST16 (10, 10, suffix, 97);                                    \
+        TEST16 (200, 200, suffix, 97);                                  \
+        TEST16 (1000, 1000, suffix, 97);                                \
+        TEST16 (40000, 40000U, suffix, 97);                             \
+    } while (0)
+
+int main (void)
+{
+    TEST (call);
+    TEST (loop);
+    TEST (unrolled);
+
+    /* All dividends for the unrolled code */
+    TESTALL16 (10, 10, unrolled);
+    TESTALL16 (1000, 1000, unrolled);
+
+    printf ("failures: %u\n", failures);
+    return failures;
+}
@@ -0,0 +1,8 @@
+/* Header for include-guard.c with an #else at the level of the guard */
+
+#ifndef INCLUDE_ELSE_H
+#define INCLUDE_ELSE_H
+++first;
+#else
+++again;
+#endif
@@ -0,0 +1,63 @@
+/*
+  !!DESCRIPTION!! Include guards and #pragma once
+  !!ORIGIN!!      cc65 regression tests
+  !!LICENCE!!     Public Domain
+*/
+
+#include <stdio.h>
+
+static unsigned char failures = 0;
+
+static int noguard;
+static int once;
+static int first;
+static int again;
+
+/* A guarded header may be included twice */
+#define GUARDED guarded
+#include "include-guard.h"
+#include "include-guard.h"
+
+static void count (void)
+{
+    /* Text after the #endif means there is no include guard */
+#include "include-noguard.h"
+#include "include-noguard.h"
+
+#include "include-once.h"
+#include "include-once.h"
+
+    /* An #else at the level of the guard means there is no guard */
+#include "include-else.h"
+#include "include-else.h"
+}
+
+/* The header is read again if the guard macro is undefined */
+#undef INCLUDE_GUARD_H
+#undef GUARDED
+#define GUARDED guarded_again
+#include "include-guard.h"
+
+int main (void)
+{
+    count ();
+    if (guarded != 1 || guarded_again != 1) {
+        printf ("guarded: %d %d\n", guarded, guarded_again);
+        ++failures;
+    }
+    if (noguard != 2) {
+        printf ("noguard: %d\n", noguard);
+        ++failures;
+    }
+    if (once != 1) {
+        printf ("once: %d\n", once);
+        ++failures;
+    }
+    if (first != 1 || again != 1) {
+        printf ("else: %d %d\n", first, again);
+        ++failures;
+    }
+
+    printf ("failures: %u\n", failures);
+    return failures;
+}
@@ -0,0 +1,8 @@
+/* Header with an include guard for include-guard.c */
+
+#ifndef INCLUDE_GUARD_H
+#define INCLUDE_GUARD_H
+
+static int GUARDED = 1;
+
+#endif
@@ -0,0 +1,7 @@
+/* Header for include-guard.c with text after the #endif */
+
+#ifndef INCLUDE_NOGUARD_H
+#define INCLUDE_NOGUARD_H
+#endif
+
+++noguard;
@@ -0,0 +1,5 @@
+/* Header for include-guard.c with #pragma once */
+
+#pragma once
+
+++once;
@@ -0,0 +1,104 @@
+/*
+  !!DESCRIPTION!! Inlining of small static and inline functions
+  !!ORIGIN!!      cc65 regression tests
+  !!LICENCE!!     Public Domain
+*/
+
+#include <stdio.h>
+
+#pragma inline-funcs (on)
+
+static unsigned char failures = 0;
+
+#define CHECK(expr, expected)                                           \
+    do {                                                                \
+        long Result = (expr);                                           \
+        if (Result != (expected)) {                                     \
+            printf ("%s = %ld, expected %ld\n", #expr, Result,          \
+                    (long) (expected));                                 \
+            ++failures;                                                 \
+        }                                                               \
+    } while (0)
+
+typedef struct {
+    int x, y;
+} point;
+
+static unsigned char table[8] = { 3, 1, 4, 1, 5, 9, 2, 6 };
+static point origin = { 10, 20 };
+static unsigned calls;
+int g = 5;
+
+static int next (void)
+{
+    return ++calls;
+}
+
+/* Parameters used several times */
+static int sq (int x) { return x * x; }
+static int max (int a, int b) { return a > b ? a : b; }
+static unsigned char isdigit_ (char c) { return c >= '0' && c <= '9'; }
+
+/* Globals, arrays and members */
+static unsigned char get (unsigned char i) { return table[i]; }
+static int px (const point* p) { return p->x; }
+static int sum (const point* p) { return p->x + p->y + g; }
+
+/* Address of a parameter, the argument must be copied */
+static int same (int a, int* p) { return &a == p; }
+
+/* Unused parameter, casts and sizeof */
+static long widen (int a, int b) { return (long) a << (sizeof (b) * 4); }
+
+/* Constant result, and an inline function with external linkage */
+static int answer (void) { return 42; }
+inline int inc (int* p) { return *p + 1; }
+
+/* Shadowed global, must not be inlined with the wrong meaning */
+static int useg (int a) { return a + g; }
+
+/* Not inlined, since the body has a side effect or a call */
+static int bump (int* p) { return ++*p; }
+static int twice (int a) { return sq (a) * 2; }
+
+int main (void)
+{
+    unsigned char i;
+    unsigned s = 0;
+    int a = 3, b = -7;
+    point pt = { 1, 2 };
+
+    for (i = 0; i < sizeof (table); ++i) {
+        s += get (i);
+    }
+    CHECK (s, 31);
+    CHECK (sq (a), 9);
+    CHECK (sq (a + 1), 16);
+    CHECK (sq (a++), 9);
+    CHECK (a, 4);
+    CHECK (max (a, b), 4);
+    CHECK (max (b, 100), 100);
+    CHECK (max (next (), next ()), 2);
+    CHECK (calls, 2);
+    CHECK (isdigit_ ('5'), 1);
+    CHECK (isdigit_ ('x'), 0);
+    CHECK (px (&origin), 10);
+    CHECK (px (&pt), 1);
+    CHECK (sum (&pt), 8);
+    CHECK (same (a, &a), 0);
+    CHECK (widen (3, next ()), 768);
+    CHECK (calls, 3);
+    CHECK (answer () + 1, 43);
+    CHECK (inc (&a), 5);
+    CHECK (useg (1), 6);
+    {
+        int g = 100;
+        CHECK (useg (g), 105);
+    }
+    CHECK (bump (&a), 5);
+    CHECK (a, 5);
+    CHECK (twice (a), 50);
+
+    printf ("failures: %u\n", failures);
+    return failures;
+}
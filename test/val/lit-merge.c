@@ -0,0 +1,75 @@
+/*
+  !!DESCRIPTION!! Merging of read only string literals
+  !!ORIGIN!!      cc65 regression tests
+  !!LICENCE!!     Public Domain
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+static unsigned char failures = 0;
+
+static void check (const char* s, const char* expected)
+{
+    if (strcmp (s, expected) != 0) {
+        printf ("'%s' != '%s'\n", s, expected);
+        ++failures;
+    }
+}
+
+/* Literals kept until the end of the file */
+const char* whole (void)
+{
+    return "fatal error";
+}
+
+const char* tail (void)
+{
+    return "error";
+}
+
+const char* same (void)
+{
+    return "error";
+}
+
+/* Literals output at the end of the function */
+#pragma local-strings (push, on)
+
+const char* local (unsigned char i)
+{
+    switch (i) {
+        case 0:  return "local fatal error";
+        case 1:  return "fatal error";
+        case 2:  return "local";
+        default: return "error";
+    }
+}
+
+#pragma local-strings (pop)
+
+int main (void)
+{
+    check (whole (), "fatal error");
+    check (tail (), "error");
+    check (same (), "error");
+    check (local (0), "local fatal error");
+    check (local (1), "fatal error");
+    check (local (2), "local");
+    check (local (3), "error");
+
+    /* Equal literals and suffixes share the data of the longer literal */
+    if (tail () != whole () + 6 || same () != tail ()) {
+        printf ("'error' not merged\n");
+        ++failures;
+    }
+    if (local (1) != local (0) + 6 || local (3) != local (0) + 12) {
+        printf ("local literals not merged\n");
+        ++failures;
+    }
+
+    if (failures) {
+        printf ("failures: %u\n", failures);
+    }
+    return failures;
+}
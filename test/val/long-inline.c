@@ -0,0 +1,239 @@
+/*
+  !!DESCRIPTION!! Inline code for long operations with constant and static operands
+  !!ORIGIN!!      cc65 regression tests
+  !!LICENCE!!     Public Domain
+*/
+
+/* The results of the inline code are compared with the runtime functions,
+** which are always called in the reference functions, since they are
+** compiled with the lowest code size factor.
+*/
+
+#include <stdio.h>
+
+static unsigned char failures = 0;
+
+static long la, lb, lc;
+static unsigned long ua, ub, uc;
+
+#define CHECK(expr, expected)                                           \
+    do {                                                                \
+        long Result = (expr);                                           \
+        long Expected = (expected);                                     \
+        if (Result != Expected) {                                       \
+            printf ("%d: %s = %ld, expected %ld (a = %ld, b = %ld)\n",  \
+                    __LINE__, #expr, Result, Expected, la, lb);         \
+            ++failures;                                                 \
+        }                                                               \
+    } while (0)
+
+#pragma codesize (push, 10)
+static long r_add (long x, long y) { return x + y; }
+static long r_sub (long x, long y) { return x - y; }
+static long r_and (long x, long y) { return x & y; }
+static long r_or  (long x, long y) { return x | y; }
+static long r_xor (long x, long y) { return x ^ y; }
+static int  r_eq  (long x, long y) { return x == y; }
+static int  r_lt  (long x, long y) { return x < y; }
+static long r_shl (long x, unsigned char n) { return x << n; }
+static long r_asr (long x, unsigned char n) { return x >> n; }
+static unsigned long r_shr (unsigned long x, unsigned char n) { return x >> n; }
+#pragma codesize (pop)
+
+#pragma cycle-weight (push, 100)
+
+static void test_const (void)
+{
+    CHECK (la + 5, r_add (la, 5));
+    CHECK (la + 0xFF, r_add (la, 0xFF));
+    CHECK (la + 0x1234, r_add (la, 0x1234));
+    CHECK (la + 0xFF00, r_add (la, 0xFF00));
+    CHECK (la + 0x10000L, r_add (la, 0x10000L));
+    CHECK (la + 0x12345678L, r_add (la, 0x12345678L));
+    CHECK (la + 0x7F000000L, r_add (la, 0x7F000000L));
+    CHECK (la - 7, r_sub (la, 7));
+    CHECK (la - 0xFF, r_sub (la, 0xFF));
+    CHECK (la - 0x1234, r_sub (la, 0x1234));
+    CHECK (la - 0x1000000L, r_sub (la, 0x1000000L));
+    CHECK (la - 0x12345678L, r_sub (la, 0x12345678L));
+    CHECK (la - -70000L, r_sub (la, -70000L));
+
+    CHECK (la & 0xFFFF, r_and (la, 0xFFFF));
+    CHECK (la & 0xFF00FF00UL, r_and (la, 0xFF00FF00UL));
+    CHECK (la & 0x0FFFFFFFL, r_and (la, 0x0FFFFFFFL));
+    CHECK (la & 0x12345678L, r_and (la, 0x12345678L));
+    CHECK (la | 0x80000000UL, r_or (la, 0x80000000UL));
+    CHECK (la | 0x00FF0100L, r_or (la, 0x00FF0100L));
+    CHECK (la | 0xFFFF0000UL, r_or (la, 0xFFFF0000UL));
+    CHECK (la ^ 0x0F0F0F0FL, r_xor (la, 0x0F0F0F0FL));
+    CHECK (la ^ 0xFFFFFFFFUL, r_xor (la, 0xFFFFFFFFUL));
+    CHECK (la ^ 0x10000L, r_xor (la, 0x10000L));
+
+    CHECK (la == 0, r_eq (la, 0));
+    CHECK (la == -1, r_eq (la, -1));
+    CHECK (la == 0x10000L, r_eq (la, 0x10000L));
+    CHECK (la == 0x12345678L, r_eq (la, 0x12345678L));
+    CHECK (la != 0, !r_eq (la, 0));
+    CHECK (la != 255, !r_eq (la, 255));
+    CHECK (la < 1000, r_lt (la, 1000));
+    CHECK (la < -70000L, r_lt (la, -70000L));
+    CHECK (la < 0x7FFFFFFFL, r_lt (la, 0x7FFFFFFFL));
+    CHECK (la >= -5, !r_lt (la, -5));
+    CHECK (la >= 0x10000L, !r_lt (la, 0x10000L));
+    CHECK (la >= (long) 0x80000001UL, !r_lt (la, (long) 0x80000001UL));
+    CHECK (la <= 999, r_lt (la, 1000));
+    CHECK (la > -6, !r_lt (la, -5));
+    if (la > 0xFFFF) {
+        CHECK (1, !r_lt (la, 0x10000L));
+    } else {
+        CHECK (0, !r_lt (la, 0x10000L));
+    }
+}
+
+#define SHIFT(n)                                                        \
+    CHECK (la << n, r_shl (la, n));                                     \
+    CHECK (la >> n, r_asr (la, n));                                     \
+    CHECK (ua >> n, r_shr (ua, n));                                     \
+    CHECK (ua << n, r_shl (ua, n))
+
+static void test_shift (void)
+{
+    SHIFT (1);
+    SHIFT (2);
+    SHIFT (3);
+    SHIFT (4);
+    SHIFT (5);
+    SHIFT (7);
+    SHIFT (8);
+    SHIFT (9);
+    SHIFT (12);
+    SHIFT (15);
+    SHIFT (16);
+    SHIFT (17);
+    SHIFT (22);
+    SHIFT (24);
+    SHIFT (27);
+    SHIFT (31);
+}
+
+static void test_static (void)
+{
+    CHECK (la + lb, r_add (la, lb));
+    CHECK (la - lb, r_sub (la, lb));
+    CHECK (la & lb, r_and (la, lb));
+    CHECK (la | lb, r_or (la, lb));
+    CHECK (la ^ lb, r_xor (la, lb));
+    CHECK (ua + ub, r_add (ua, ub));
+    CHECK (ua - ub, r_sub (ua, ub));
+    CHECK ((la + 1) - lb, r_sub (r_add (la, 1), lb));
+    CHECK ((la ^ lb) & lb, r_and (r_xor (la, lb), lb));
+}
+
+static void test_opassign (void)
+{
+    lc = la;
+    lc += 3;
+    CHECK (lc, r_add (la, 3));
+    lc = la;
+    lc += 1;
+    CHECK (lc, r_add (la, 1));
+    lc = la;
+    lc += 100000L;
+    CHECK (lc, r_add (la, 100000L));
+    lc = la;
+    lc -= 5;
+    CHECK (lc, r_sub (la, 5));
+    lc = la;
+    lc -= 70000L;
+    CHECK (lc, r_sub (la, 70000L));
+    lc = la;
+    lc -= 0x1000000L;
+    CHECK (lc, r_sub (la, 0x1000000L));
+    lc = la;
+    lc += lb;
+    CHECK (lc, r_add (la, lb));
+    lc = la;
+    lc -= lb;
+    CHECK (lc, r_sub (la, lb));
+
+    /* The result is used */
+    lc = la;
+    CHECK (lc += 200, r_add (la, 200));
+    lc = la;
+    CHECK (lc -= 200, r_sub (la, 200));
+    lc = la;
+    CHECK (lc += 0x123456L, r_add (la, 0x123456L));
+    lc = la;
+    CHECK (lc -= 0x1000000L, r_sub (la, 0x1000000L));
+    lc = la;
+    CHECK (lc += lb, r_add (la, lb));
+    lc = la;
+    CHECK (lc -= lb, r_sub (la, lb));
+    uc = ua;
+    CHECK (uc -= ub, r_sub (ua, ub));
+}
+
+#pragma cycle-weight (pop)
+
+/* Compare results that are used as values, or tested while the registers
+** are used afterwards.
+*/
+static unsigned char guc;
+static long hv;
+
+static void H (long x)
+{
+    hv = x;
+}
+
+static void test_cmp_value (void)
+{
+    long ll = 0;
+    long lx = 7;
+
+    ll -= ((ll != 0x7FFFFFFFL) > 0);
+    CHECK (ll, -1);
+    lx ^= ((la == -70000L) >= 1);
+    CHECK (lx, (la == -70000L)? 6 : 7);
+}
+
+#pragma codesize (push, 400)
+static void test_cmp_branch (void)
+{
+    hv = 0;
+    if ((guc == 256) + (ua != -1)) H (1);
+    CHECK (hv, (ua != 0xFFFFFFFFUL)? 1 : 0);
+}
+#pragma codesize (pop)
+
+static const long values[] = {
+    0, 1, -1, 5, -5, -6, 255, 256, 999, 1000, 0xFFFF, 0x10000L, 0xFFFFFFL,
+    0x12345678L, -70000L, 0x7FFFFFFFL, (long) 0x80000000UL, (long) 0x80000001UL
+};
+
+#define COUNT   (sizeof (values) / sizeof (values[0]))
+
+int main (void)
+{
+    unsigned char i, j;
+
+    for (i = 0; i < COUNT; ++i) {
+        la = values[i];
+        ua = values[i];
+        test_const ();
+        test_shift ();
+        test_cmp_value ();
+        test_cmp_branch ();
+        for (j = 0; j < COUNT; ++j) {
+            lb = values[j];
+            ub = values[j];
+            test_static ();
+            test_opassign ();
+        }
+    }
+
+    if (failures) {
+        printf ("failures: %u\n", failures);
+    }
+    return failures;
+}
@@ -0,0 +1,105 @@
+/*
+  !!DESCRIPTION!! Register contents and liveness across branches and loops
+  !!ORIGIN!!      cc65 regression tests
+  !!LICENCE!!     Public Domain
+*/
+
+#include <stdio.h>
+
+static unsigned char failures = 0;
+
+#define CHECK(expr, expected)                                           \
+    do {                                                                \
+        long Result = (expr);                                           \
+        if (Result != (expected)) {                                     \
+            printf ("%s = %ld, expected %ld\n", #expr, Result,          \
+                    (long) (expected));                                 \
+            ++failures;                                                 \
+        }                                                               \
+    } while (0)
+
+static unsigned char buf[16];
+static unsigned char zero;
+
+/* Value that is constant around the loop */
+static void fill (unsigned char c)
+{
+    unsigned char i = sizeof (buf);
+    do {
+        buf[--i] = c;
+    } while (i);
+}
+
+/* Value that changes on the back edge only */
+static unsigned char count (unsigned char n)
+{
+    unsigned char r = 0;
+    unsigned char i;
+    for (i = 0; i < n; ++i) {
+        if (buf[i] == 0) {
+            continue;
+        }
+        r = r + 1;
+    }
+    return r;
+}
+
+/* Nested loops with conditional changes, loop entered at the condition */
+static unsigned mix (unsigned char n)
+{
+    unsigned r = 0;
+    unsigned char i = 0, j;
+    while (i < n) {
+        j = 0;
+        while (j < i) {
+            if (j & 1) {
+                r += j;
+            } else {
+                r -= 1;
+            }
+            ++j;
+        }
+        ++i;
+    }
+    return r;
+}
+
+/* Switch in a loop, targets reached by a jump table */
+static unsigned dispatch (unsigned char n)
+{
+    unsigned r = 0;
+    unsigned char i;
+    for (i = 0; i < n; ++i) {
+        switch (i & 7) {
+            case 0:     r += 1;     break;
+            case 1:     r += 2;     break;
+            case 2:     r += 4;     break;
+            case 3:     r += zero;  break;
+            case 4:     r += 16;    break;
+            case 5:     r += 32;    break;
+            case 6:     r += 64;    break;
+            default:    r += 128;   break;
+        }
+    }
+    return r;
+}
+
+int main (void)
+{
+    fill (0);
+    CHECK (count (sizeof (buf)), 0);
+    fill (1);
+    buf[3] = 0;
+    buf[7] = 0;
+    CHECK (count (sizeof (buf)), 14);
+    CHECK (count (5), 4);
+    CHECK (mix (0), 0);
+    CHECK (mix (5), 0);
+    CHECK (mix (10), 35);
+    CHECK (mix (12), 74);
+    CHECK (dispatch (8), 247);
+    CHECK (dispatch (20), 501);
+
+    printf ("failures: %u\n", failures);
+    return failures;
+}
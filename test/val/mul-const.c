@@ -0,0 +1,136 @@
+/*
+  !!DESCRIPTION!! Multiplication by constants
+  !!ORIGIN!!      cc65 regression tests
+  !!LICENCE!!     Public Domain
+*/
+
+#include <stdio.h>
+
+static unsigned char failures = 0;
+
+/* Not a constant, so the runtime multiplication is used */
+static long m;
+
+typedef unsigned char (*Func8) (unsigned char);
+typedef unsigned (*Func16) (unsigned);
+typedef long (*Func32) (long);
+
+#define MUL(name, c, suffix)                                            \
+    static unsigned char mul8_##name##_##suffix (unsigned char x)       \
+    {                                                                   \
+        x *= c;                                                         \
+        return x;                                                       \
+    }                                                                   \
+    static unsigned mul16_##name##_##suffix (unsigned x)                \
+    {                                                                   \
+        return x * c;                                                   \
+    }                                                                   \
+    static long mul32_##name##_##suffix (long x)                        \
+    {                                                                   \
+        return x * c;                                                   \
+    }
+
+/* The same code is compiled with all weights and with a code size factor
+** below 100, the results must not differ.
+*/
+#define FUNCS(suffix)                                                   \
+    MUL (3, 3, suffix)                                                  \
+    MUL (7, 7, suffix)                                                  \
+    MUL (11, 11, suffix)                                                \
+    MUL (12, 12, suffix)                                                \
+    MUL (15, 15, suffix)                                                \
+    MUL (24, 24, suffix)                                                \
+    MUL (45, 45, suffix)                                                \
+    MUL (100, 100, suffix)                                              \
+    MUL (119, 119, suffix)                                              \
+    MUL (255, 255, suffix)                                              \
+    MUL (320, 320, suffix)                                              \
+    MUL (1000, 1000, suffix)                                            \
+    MUL (40000, 40000L, suffix)                                         \
+    MUL (n3, -3, suffix)                                                \
+    MUL (n10, -10, suffix)
+
+#pragma cycle-weight (push, 0)
+FUNCS (size)
+#pragma cycle-weight (pop)
+
+#pragma cycle-weight (push, 50)
+FUNCS (mix)
+#pragma cycle-weight (pop)
+
+#pragma cycle-weight (push, 100)
+FUNCS (speed)
+#pragma cycle-weight (pop)
+
+#pragma codesize (push, 50)
+FUNCS (small)
+#pragma codesize (pop)
+
+static void Test (long c, Func8 Mul8, Func16 Mul16, Func32 Mul32)
+/* Compare the results against the runtime multiplication */
+{
+    unsigned I;
+    unsigned x16;
+    long     x32;
+
+    m = c;
+    for (I = 0; I < 256; ++I) {
+        if (Mul8 (I) != (unsigned char) (I * (unsigned char) m)) {
+            printf ("8 bit: %u * %ld = %u\n", I, c, Mul8 (I));
+            ++failures;
+            return;
+        }
+    }
+    x16 = 0;
+    do {
+        if (Mul16 (x16) != x16 * (unsigned) m) {
+            printf ("16 bit: %u * %ld = %u\n", x16, c, Mul16 (x16));
+            ++failures;
+            return;
+        }
+        x16 += 251;
+    } while (x16 >= 251);
+    x32 = 1;
+    for (I = 0; I < 100; ++I) {
+        if (Mul32 (x32) != x32 * m) {
+            printf ("32 bit: %ld * %ld = %ld\n", x32, c, Mul32 (x32));
+            ++failures;
+            return;
+        }
+        x32 = x32 * 69069L + 12345L;
+    }
+}
+
+#define TEST1(name, c, suffix)                                          \
+    Test (c, mul8_##name##_##suffix, mul16_##name##_##suffix,           \
+          mul32_##name##_##suffix)
+
+#define TEST(suffix)                                                    \
+    do {                                                                \
+        TEST1 (3, 3, suffix);                                           \
+        TEST1 (7, 7, suffix);                                           \
+        TEST1 (11, 11, suffix);                                         \
+        TEST1 (12, 12, suffix);                                         \
+        TEST1 (15, 15, suffix);                                         \
+        TEST1 (24, 24, suffix);                                         \
+        TEST1 (45, 45, suffix);                                         \
+        TEST1 (100, 100, suffix);                                       \
+        TEST1 (119, 119, suffix);                                       \
+        TEST1 (255, 255, suffix);                                       \
+        TEST1 (320, 320, suffix);                                       \
+        TEST1 (1000, 1000, suffix);                                     \
+        TEST1 (40000, 40000L, suffix);                                  \
+        TEST1 (n3, -3, suffix);                                         \
+        TEST1 (n10, -10, suffix);                                       \
+    } while (0)
+
+int main (void)
+{
+    TEST (size);
+    TEST (mix);
+    TEST (speed);
+    TEST (small);
+
+    printf ("failures: %u\n", failures);
+    return failures;
+}
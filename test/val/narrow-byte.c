@@ -0,0 +1,171 @@
+/*
+  !!DESCRIPTION!! Arithmetic done in 8 bits if only the low byte is used
+  !!ORIGIN!!      cc65 regression tests
+  !!LICENCE!!     Public Domain
+*/
+
+/* Each expression is evaluated once for a char result, where the compiler
+** may use the low bytes of the operands only, and once for a long result,
+** where it can't. The low bytes of both results must match.
+*/
+
+#include <stdio.h>
+
+static unsigned char failures = 0;
+
+static unsigned char a, b, c;
+static signed char s, t, u;
+static int i, j;
+static long l;
+
+#define CHECKU(expr)                                                    \
+    do {                                                                \
+        c = expr;                                                       \
+        l = expr;                                                       \
+        if (c != (unsigned char) l) {                                   \
+            printf ("%d: %s = %u, expected %u\n", __LINE__, #expr,      \
+                    c, (unsigned char) l);                              \
+            ++failures;                                                 \
+        }                                                               \
+    } while (0)
+
+#define CHECKS(expr)                                                    \
+    do {                                                                \
+        u = expr;                                                       \
+        l = expr;                                                       \
+        if (u != (signed char) l) {                                     \
+            printf ("%d: %s = %d, expected %d\n", __LINE__, #expr,      \
+                    u, (signed char) l);                                \
+            ++failures;                                                 \
+        }                                                               \
+    } while (0)
+
+#define CHECK(val, expected)                                            \
+    do {                                                                \
+        if ((val) != (expected)) {                                      \
+            printf ("%d: %s = %d, expected %d\n", __LINE__, #val,       \
+                    (val), (expected));                                 \
+            ++failures;                                                 \
+        }                                                               \
+    } while (0)
+
+static unsigned char ret_add (void)
+{
+    return a + b;
+}
+
+static signed char ret_shift (void)
+{
+    return s >> 1;
+}
+
+static unsigned char id (unsigned char x)
+{
+    return x;
+}
+
+static void test_ops (void)
+{
+    CHECKU (a + b);
+    CHECKU (a - b);
+    CHECKU (b - a);
+    CHECKU (a + 100);
+    CHECKU (a - 100);
+    CHECKU (100 + a);
+    CHECKU (i + j);
+    CHECKU (i - j);
+    CHECKU (i + a);
+    CHECKU (a - i);
+    CHECKU (a & 0x0F);
+    CHECKU (a | 0x81);
+    CHECKU (a ^ 0x3C);
+    CHECKU (0x0F & a);
+    CHECKU (0x81 | i);
+    CHECKU (0x3C ^ i);
+    CHECKU (a << 3);
+    CHECKU (i << 5);
+    CHECKU (a >> 3);
+    CHECKU (-a);
+    CHECKU (~a);
+    CHECKU (-i);
+    CHECKU (~i);
+    CHECKS (s + t);
+    CHECKS (s - t);
+    CHECKS (s >> 1);
+    CHECKS (s >> 3);
+    CHECKS (-s);
+    CHECKS (s & 0x70);
+
+    /* The high byte of these subexpressions is needed */
+    CHECKU ((a + b) >> 1);
+    CHECKU ((i - j) >> 4);
+    CHECKU (!(a + b));
+    CHECKU ((a + b) == 0);
+    CHECKU ((a + b) / 3);
+    CHECKU (i ? a + b : 7);
+    CHECKU (id ((a + b) >> 1));
+    CHECKU ((i << 4) >> 8);
+    CHECKS ((s - t) >> 2);
+}
+
+static void test_uses (void)
+{
+    unsigned char x = a + b;
+    static unsigned char y;
+    register unsigned char z = a - b;
+    unsigned char* p = &c;
+
+    y = a + 50;
+    CHECK (x, (unsigned char) (a + b));
+    CHECK (y, (unsigned char) (a + 50));
+    CHECK (z, (unsigned char) (a - b));
+    CHECK (ret_add (), (unsigned char) (a + b));
+    CHECK (ret_shift (), (signed char) (s >> 1));
+    CHECK (id (a + b), (unsigned char) (a + b));
+    CHECK (id (i - j), (unsigned char) (i - j));
+
+    *p = 1;
+    *p += a + b;
+    CHECK (c, (unsigned char) (1 + a + b));
+    c = 2;
+    c -= i + j;
+    CHECK (c, (unsigned char) (2 - i - j));
+
+    i = (unsigned char) (a + b);
+    CHECK (i, (unsigned char) (a + b));
+    i = (signed char) (s - t);
+    CHECK (i, (signed char) (s - t));
+    i = (unsigned char) (a + b) + 1;
+    CHECK (i, (unsigned char) (a + b) + 1);
+    i = (c = a + b);
+    CHECK (i, (unsigned char) (a + b));
+    if ((c = a + b) == 0) {
+        CHECK (c, 0);
+    }
+}
+
+static void test (unsigned char va, unsigned char vb, int vi, int vj,
+                  signed char vs, signed char vt)
+{
+    a = va;
+    b = vb;
+    i = vi;
+    j = vj;
+    s = vs;
+    t = vt;
+    test_ops ();
+    test_uses ();
+}
+
+int main (void)
+{
+    test (200, 100, 0x1234, 0x0FF0, -3, 100);
+    test (128, 128, -1, 1, -128, 127);
+    test (1, 255, 0x00FF, 0x0001, 127, -128);
+    test (0, 0, 0, 0, 0, 0);
+
+    if (failures) {
+        printf ("failures: %u\n", failures);
+    }
+    return failures;
+}
@@ -0,0 +1,176 @@
+/*
+  !!DESCRIPTION!! Int loop counters that fit into a byte
+  !!ORIGIN!!      cc65 regression tests
+  !!LICENCE!!     Public Domain
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#pragma narrow-loop-vars (on)
+
+static unsigned char failures = 0;
+
+#define CHECK(expr, expected)                                           \
+    do {                                                                \
+        long Result = (expr);                                           \
+        if (Result != (expected)) {                                     \
+            printf ("%s = %ld, expected %ld\n", #expr, Result,          \
+                    (long) (expected));                                 \
+            ++failures;                                                 \
+        }                                                               \
+    } while (0)
+
+#define WORDS   100
+
+static unsigned char buf[256];
+static int words[WORDS];
+
+/* The counter reaches 255 after the loop */
+static int up (void)
+{
+    int i;
+    unsigned n = 0;
+    for (i = 0; i < 255; ++i) {
+        buf[i] = i;
+        n += i;
+    }
+    CHECK (n, 32385U);
+    return i;
+}
+
+static int up_le (void)
+{
+    int i;
+    for (i = 10; i <= 254; i++) {
+        buf[i] = 0;
+    }
+    return i;
+}
+
+static int down (void)
+{
+    int i, n = 0;
+    for (i = 200; i > 0; --i) {
+        n += 2;
+    }
+    for (i = 5; i >= 1; i -= 1) {
+        ++n;
+    }
+    return n + i;
+}
+
+/* Expressions with the counter keep the type int */
+static long exprs (void)
+{
+    int i;
+    long s = 0;
+    for (i = 0; i < 20; ++i) {
+        s += i - 10;
+        s += (i - 10) / 3;
+        s += (i + 15) >> 1;
+        if (i - 5 < 0) {
+            s += 1000;
+        }
+        s += (long) (i * 1000);
+        s += i << 8;
+        s += ~i;
+        s += -i;
+    }
+    return s;
+}
+
+/* The counter is used as an index into an int array */
+static void fill (int v)
+{
+    int i;
+    for (i = 0; i < 2 * (WORDS / 2); ++i) {
+        words[i] = v + i;
+    }
+}
+
+/* Nested loops with different counters */
+static unsigned nested (void)
+{
+    int i, j;
+    unsigned n = 0;
+    for (i = 0; i < 10; ++i) {
+        for (j = 0; j < i; ++j) {
+            n += j;
+        }
+    }
+    return n + i + j;
+}
+
+/* Counters that must keep their size */
+static int big (void)
+{
+    int i, j, k, m, n, o;
+
+    for (i = 0; i < 300; ++i) {
+    }
+    for (j = 0; j < 255; ++j) {
+        if (j == 100) {
+            j += 200;
+        }
+    }
+    for (k = 0; k < 10; ++k) {
+        for (k = 0; k < 250; ++k) {
+        }
+    }
+    for (m = 0; m <= 255; ++m) {
+    }
+    for (o = 0; o < 128 * (1 + 1); ++o) {
+    }
+    n = 0;
+    for (n = 10; n >= 0; --n) {
+    }
+    return i + j + k + m + n + o;
+}
+
+/* The loop body may be entered by a case label */
+static int duff (unsigned char c)
+{
+    int i = 255;
+    int n = 0;
+    switch (c) {
+        case 0:
+            for (i = 0; i < 255; ++i) {
+        case 1:
+                ++n;
+            }
+    }
+    return n + i;
+}
+
+static int addr (void)
+{
+    int i, *p = &i;
+    for (i = 0; i < 10; ++i) {
+        if (i == 5) {
+            *p = 400;
+        }
+    }
+    return i;
+}
+
+int main (void)
+{
+    CHECK (up (), 255);
+    CHECK (buf[254], 254);
+    CHECK (up_le (), 255);
+    CHECK (buf[254], 0);
+    CHECK (down (), 405);
+    CHECK (exprs (), 243467L);
+    fill (1000);
+    CHECK (words[0], 1000);
+    CHECK (words[99], 1099);
+    CHECK (nested (), 139);
+    CHECK (big (), 300 + 301 + 251 + 256 + 256 - 1);
+    CHECK (duff (0), 510);
+    CHECK (duff (1), 257);
+    CHECK (addr (), 401);
+
+    printf ("failures: %u\n", failures);
+    return failures;
+}
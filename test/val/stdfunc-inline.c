@@ -0,0 +1,224 @@
+/*
+  !!DESCRIPTION!! Inline code for abs, labs, memcmp, memmove, strchr and strncpy
+  !!ORIGIN!!      cc65 regression tests
+  !!LICENCE!!     Public Domain
+*/
+
+/* The results of the inline code are compared with the library functions,
+** which are called through pointers and so never inlined.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+#pragma inline-stdfuncs (on)
+#pragma codesize (400)
+
+static unsigned char failures = 0;
+
+#define CHECK(expr, expected)                                           \
+    do {                                                                \
+        long Result = (expr);                                           \
+        if (Result != (expected)) {                                     \
+            printf ("%s = %ld, expected %ld\n", #expr, Result,          \
+                    (long) (expected));                                 \
+            ++failures;                                                 \
+        }                                                               \
+    } while (0)
+
+#define SIGN(x) ((x) < 0? -1 : (x) > 0)
+
+static int (*lib_memcmp) (const void*, const void*, size_t) = memcmp;
+static char* (*lib_strchr) (const char*, int) = strchr;
+static char* (*lib_strncpy) (char*, const char*, size_t) = strncpy;
+
+static char a[16] = "hello, world";
+static char b[16] = "hello, there";
+static unsigned char big1[256];
+static unsigned char big2[256];
+static char buf[300];
+static char ref[300];
+static char text[40] = "the quick brown fox";
+
+static int iv;
+static long lv;
+static unsigned char uc;
+
+static void test_abs (void)
+{
+    CHECK (abs (-5), 5);
+    CHECK (abs (7), 7);
+    CHECK (abs (INT_MIN), INT_MIN);
+    CHECK (labs (-100000L), 100000L);
+    CHECK (labs (LONG_MIN), LONG_MIN);
+
+    iv = -1234;
+    CHECK (abs (iv), 1234);
+    iv = 1234;
+    CHECK (abs (iv), 1234);
+    iv = INT_MIN;
+    CHECK (abs (iv), INT_MIN);
+    iv = -1;
+    CHECK (abs (iv + 2), 1);
+
+    lv = -70000L;
+    CHECK (labs (lv), 70000L);
+    lv = 70000L;
+    CHECK (labs (lv), 70000L);
+    lv = -1L;
+    CHECK (labs (lv), 1L);
+
+    uc = 200;
+    CHECK (abs (uc), 200);
+    CHECK (labs (uc), 200L);
+}
+
+static void test_memcmp (void)
+{
+    register const char* p = a;
+    register const char* q = b;
+    unsigned i;
+
+    CHECK (memcmp (a, b, 7), 0);
+    CHECK (SIGN (memcmp (a, b, 8)), SIGN (lib_memcmp (a, b, 8)));
+    CHECK (SIGN (memcmp (b, a, 8)), SIGN (lib_memcmp (b, a, 8)));
+    CHECK (SIGN (memcmp (a, b, 16)), 1);
+    CHECK (SIGN (memcmp (b, a, 16)), -1);
+    CHECK (memcmp (a, "hello", 5), 0);
+    CHECK (memcmp (p, q, 7), 0);
+    CHECK (SIGN (memcmp (p, q, 12)), 1);
+    CHECK (SIGN (memcmp (p, b, 12)), 1);
+
+    for (i = 0; i < 256; ++i) {
+        big1[i] = big2[i] = (unsigned char) i;
+    }
+    CHECK (memcmp (big1, big2, 256), 0);
+    big2[255] = 0;
+    CHECK (SIGN (memcmp (big1, big2, 256)), 1);
+    CHECK (memcmp (big1, big2, 255), 0);
+    big1[0] = 0x80;
+    CHECK (SIGN (memcmp (big1, big2, 200)), 1);
+    CHECK (SIGN (memcmp (big2, big1, 200)), -1);
+}
+
+static void test_memmove (void)
+{
+    void* r;
+    unsigned i;
+
+    /* Overlapping, upwards and downwards */
+    strcpy (buf, "0123456789");
+    memmove (buf + 2, buf, 8);
+    CHECK (strcmp (buf, "0101234567"), 0);
+    strcpy (buf, "0123456789");
+    memmove (buf, buf + 2, 8);
+    CHECK (strcmp (buf, "2345678989"), 0);
+
+    /* Different objects */
+    memmove (buf, a, 13);
+    CHECK (strcmp (buf, "hello, world"), 0);
+
+    /* More than 129 bytes */
+    for (i = 0; i < 300; ++i) {
+        buf[i] = (char) i;
+    }
+    memmove (buf + 40, buf, 200);
+    for (i = 0; i < 200; ++i) {
+        if (buf[i + 40] != (char) i) {
+            break;
+        }
+    }
+    CHECK (i, 200);
+    for (i = 0; i < 300; ++i) {
+        buf[i] = (char) i;
+    }
+    memmove (buf, buf + 40, 256);
+    for (i = 0; i < 256; ++i) {
+        if (buf[i] != (char) (i + 40)) {
+            break;
+        }
+    }
+    CHECK (i, 256);
+
+    /* The result is the destination */
+    r = memmove (buf + 1, buf, 3);
+    CHECK (r == buf + 1, 1);
+}
+
+static void test_strchr (void)
+{
+    register const char* p = text;
+
+    CHECK (strchr (text, 'q') - text, 4);
+    CHECK (strchr (text, 't') - text, 0);
+    CHECK (strchr (text, 'x') - text, 18);
+    CHECK (strchr (text, 'z') == 0, 1);
+    CHECK (strchr (text, '\0') - text, 19);
+    CHECK (strchr (text, 'o') == lib_strchr (text, 'o'), 1);
+    CHECK (strchr (text, 'o' + 256) == lib_strchr (text, 'o' + 256), 1);
+    CHECK (strchr (p, 'b') - text, 10);
+
+#pragma allow-eager-inline (push, on)
+    CHECK (strchr (p, 'f') - text, 16);
+    CHECK (strchr (p, 'Q') == 0, 1);
+#pragma allow-eager-inline (pop)
+}
+
+static void test_strncpy (void)
+{
+    register char* p = buf;
+    char* r;
+    unsigned i;
+
+    memset (buf, 'x', sizeof (buf));
+    memset (ref, 'x', sizeof (ref));
+    strncpy (buf, "abc", 8);
+    lib_strncpy (ref, "abc", 8);
+    CHECK (memcmp (buf, ref, 10), 0);
+
+    strncpy (buf, text, 5);
+    lib_strncpy (ref, text, 5);
+    CHECK (memcmp (buf, ref, 10), 0);
+
+    strncpy (buf, "", 3);
+    lib_strncpy (ref, "", 3);
+    CHECK (memcmp (buf, ref, 10), 0);
+
+    strncpy (buf, "1234", 4);
+    lib_strncpy (ref, "1234", 4);
+    CHECK (memcmp (buf, ref, 10), 0);
+
+    strncpy (p, "xy", 6);
+    lib_strncpy (ref, "xy", 6);
+    CHECK (memcmp (buf, ref, 10), 0);
+
+    memset (buf, 'x', sizeof (buf));
+    strncpy (buf, text, 256);
+    for (i = 19; i < 256; ++i) {
+        if (buf[i] != 0) {
+            break;
+        }
+    }
+    CHECK (i, 256);
+    CHECK (buf[256], 'x');
+    CHECK (strcmp (buf, text), 0);
+
+    r = strncpy (buf, a, 2);
+    CHECK (r == buf, 1);
+}
+
+int main (void)
+{
+    test_abs ();
+    test_memcmp ();
+    test_memmove ();
+    test_strchr ();
+    test_strncpy ();
+
+    if (failures) {
+        printf ("failures: %u\n", failures);
+    }
+    return failures;
+}
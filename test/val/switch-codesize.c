@@ -0,0 +1,80 @@
+/*
+  !!DESCRIPTION!! Switch statements with a code size factor below 100
+  !!ORIGIN!!      cc65 regression tests
+  !!LICENCE!!     Public Domain
+*/
+
+/* Same as --codesize 50. The smallest strategy must be used for each
+** switch statement, instead of none at all.
+*/
+#pragma codesize (50)
+
+#include <stdio.h>
+
+static unsigned char failures = 0;
+
+static unsigned char dense (unsigned char c)
+{
+    switch (c) {
+        case 1:  return 10;
+        case 2:  return 20;
+        case 3:  return 30;
+        case 4:  return 40;
+        case 5:  return 50;
+        case 6:  return 60;
+        case 7:  return 70;
+        case 8:  return 80;
+        case 9:  return 90;
+        case 10: return 100;
+        default: return 0;
+    }
+}
+
+static int sparse (int i)
+{
+    switch (i) {
+        case -1000: return 1;
+        case 3:     return 2;
+        case 77:    return 3;
+        case 500:   return 4;
+        case 1234:  return 5;
+        case 4096:  return 6;
+        case 30000: return 7;
+        default:    return 0;
+    }
+}
+
+static unsigned char small (unsigned char c)
+{
+    switch (c) {
+        case 'a': return 1;
+        case 'z': return 2;
+    }
+    return 0;
+}
+
+int main (void)
+{
+    unsigned char c;
+
+    for (c = 0; c < 12; ++c) {
+        if (dense (c) != (c >= 1 && c <= 10 ? c * 10 : 0)) {
+            printf ("dense (%u) = %u\n", c, dense (c));
+            ++failures;
+        }
+    }
+    if (sparse (-1000) != 1 || sparse (77) != 3 || sparse (30000) != 7 ||
+        sparse (4) != 0) {
+        printf ("sparse failed\n");
+        ++failures;
+    }
+    if (small ('a') != 1 || small ('z') != 2 || small ('b') != 0) {
+        printf ("small failed\n");
+        ++failures;
+    }
+
+    if (failures) {
+        printf ("failures: %u\n", failures);
+    }
+    return failures;
+}
@@ -0,0 +1,258 @@
+/*
+  !!DESCRIPTION!! Dense and sparse switch statements (jump tables, binary search)
+  !!ORIGIN!!      cc65 regression tests
+  !!LICENCE!!     Public Domain
+*/
+
+#include <stdio.h>
+
+static unsigned char failures = 0;
+
+/* Dense with holes, several labels for one statement, default in between */
+static unsigned char dense (unsigned char c)
+{
+    switch (c) {
+        case 10: case 11:   return 1;
+        case 12:            return 2;
+        case 13:            return 3;
+        case 14:            return 4;
+        case 16:            return 5;
+        case 17:            return 6;
+        case 18:            return 7;
+        case 19:            return 8;
+        case 20:            return 9;
+        case 21: default:   return 10;
+        case 22:            return 11;
+        case 23:            return 12;
+        case 24:            return 13;
+        case 25:            return 14;
+        case 26:            return 15;
+        case 27:            return 16;
+        case 28:            return 17;
+        case 29:            return 18;
+        case 30:            return 19;
+        case 31:            return 20;
+        case 32:            return 21;
+        case 33:            return 22;
+        case 34:            return 23;
+        case 35:            return 24;
+        case 36:            return 25;
+        case 37:            return 26;
+        case 38:            return 27;
+        case 39:            return 28;
+        case 40:            return 29;
+        case 41:            return 30;
+        case 42:            return 31;
+        case 43:            return 32;
+        case 44:            return 33;
+        case 45:            return 34;
+        case 46:            return 35;
+        case 47:            return 36;
+        case 48:            return 37;
+        case 49:            return 38;
+        case 50:            return 39;
+    }
+}
+
+static unsigned char dense_ref (unsigned char c)
+{
+    if (c == 10 || c == 11) {
+        return 1;
+    } else if (c < 10 || c == 15 || c == 21 || c > 50) {
+        return 10;
+    } else if (c < 15) {
+        return c - 10;
+    } else {
+        return c - 11;
+    }
+}
+
+/* Fall through, no default, labels at the end of the switch */
+static unsigned fallthrough (unsigned char c)
+{
+    unsigned r = 0;
+    switch (c) {
+        case 0:     r += 1;
+        case 1:     r += 2;
+        case 2:     r += 4;
+        case 3:     r += 8;
+                    break;
+        case 4:     r += 16;
+        case 5:     r += 32;
+        case 6:     r += 64;
+        case 7:     r += 128;
+        case 8:
+        case 9:
+        case 10:    ;
+    }
+    return r;
+}
+
+static unsigned fallthrough_ref (unsigned char c)
+{
+    static const unsigned t[] = {
+        15, 14, 12, 8, 240, 224, 192, 128, 0, 0, 0
+    };
+    return c <= 10 ? t[c] : 0;
+}
+
+/* Sparse values, more than 128 values in the range */
+static int sparse (signed char c)
+{
+    switch (c) {
+        case -128:  return 1;
+        case -100:  return 2;
+        case -60:   return 3;
+        case -20:   return 4;
+        case -1:    return 5;
+        case 0:     return 6;
+        case 1:     return 7;
+        case 20:    return 8;
+        case 40:    return 9;
+        case 60:    return 10;
+        case 80:    return 11;
+        case 100:   return 12;
+        case 127:   return 13;
+        default:    return -1;
+    }
+}
+
+static int sparse_ref (signed char c)
+{
+    static const signed char v[] = {
+        -128, -100, -60, -20, -1, 0, 1, 20, 40, 60, 80, 100, 127
+    };
+    unsigned char i;
+    for (i = 0; i < sizeof (v); ++i) {
+        if (v[i] == c) {
+            return i + 1;
+        }
+    }
+    return -1;
+}
+
+/* Dense low byte under several high bytes */
+static unsigned wide (unsigned v)
+{
+    switch (v) {
+        case 0x100: return 1;   case 0x101: return 2;   case 0x102: return 3;
+        case 0x103: return 4;   case 0x104: return 5;   case 0x105: return 6;
+        case 0x106: return 7;   case 0x107: return 8;   case 0x108: return 9;
+        case 0x109: return 10;  case 0x10A: return 11;  case 0x10B: return 12;
+        case 0x2F0: return 13;  case 0x2F1: return 14;  case 0x2F2: return 15;
+        case 0x2F3: return 16;  case 0x2F4: return 17;  case 0x2F5: return 18;
+        case 0x2F6: return 19;  case 0x2F7: return 20;  case 0x2FF: return 21;
+        default:    return 0;
+    }
+}
+
+static unsigned wide_ref (unsigned v)
+{
+    if (v >= 0x100 && v <= 0x10B) {
+        return v - 0x100 + 1;
+    } else if (v >= 0x2F0 && v <= 0x2F7) {
+        return v - 0x2F0 + 13;
+    } else if (v == 0x2FF) {
+        return 21;
+    }
+    return 0;
+}
+
+/* Long selector, nested switch in a loop with break and continue */
+static long nested (long v)
+{
+    long r = 0;
+    unsigned char i;
+    for (i = 0; i < 4; ++i) {
+        switch (v + i) {
+            case 100000L:   r += 1;     break;
+            case 100001L:   r += 2;     break;
+            case 100002L:   r += 3;     continue;
+            case 100003L:   r += 4;     break;
+            case 100004L:   r += 5;     break;
+            case 100005L:
+                switch ((unsigned char) i) {
+                    case 0: r += 100;   break;
+                    case 1: r += 200;   break;
+                    case 2: r += 300;   break;
+                    case 3: r += 400;   break;
+                    case 4: r += 500;   break;
+                    case 5: r += 600;   break;
+                }
+                break;
+            case 100006L:   r += 7;     break;
+            case 100007L:   r += 8;     break;
+            case -5L:       r -= 1;     break;
+            default:        r += 1000;  break;
+        }
+        r *= 2;
+    }
+    return r;
+}
+
+static long nested_ref (long v)
+{
+    long r = 0;
+    unsigned char i;
+    for (i = 0; i < 4; ++i) {
+        long x = v + i;
+        if (x >= 100000L && x <= 100007L) {
+            if (x == 100002L) {
+                r += 3;
+                continue;
+            } else if (x == 100005L) {
+                r += 100 * (i + 1);
+            } else {
+                r += x - 100000L + 1;
+            }
+        } else if (x == -5L) {
+            r -= 1;
+        } else {
+            r += 1000;
+        }
+        r *= 2;
+    }
+    return r;
+}
+
+int main (void)
+{
+    unsigned I;
+    long L;
+
+    for (I = 0; I < 256; ++I) {
+        if (dense (I) != dense_ref (I)) {
+            printf ("dense (%u) = %u, expected %u\n", I, dense (I), dense_ref (I));
+            ++failures;
+        }
+        if (fallthrough (I) != fallthrough_ref (I)) {
+            printf ("fallthrough (%u) = %u, expected %u\n", I, fallthrough (I), fallthrough_ref (I));
+            ++failures;
+        }
+        if (sparse (I) != sparse_ref (I)) {
+            printf ("sparse (%d) = %d, expected %d\n", (signed char) I, sparse (I), sparse_ref (I));
+            ++failures;
+        }
+    }
+    for (I = 0; I < 0x400; ++I) {
+        if (wide (I) != wide_ref (I)) {
+            printf ("wide (%u) = %u, expected %u\n", I, wide (I), wide_ref (I));
+            ++failures;
+        }
+    }
+    for (L = 99990L; L < 100010L; ++L) {
+        if (nested (L) != nested_ref (L)) {
+            printf ("nested (%ld) = %ld, expected %ld\n", L, nested (L), nested_ref (L));
+            ++failures;
+        }
+    }
+    for (L = -10L; L < 0L; ++L) {
+        if (nested (L) != nested_ref (L)) {
+            printf ("nested (%ld) = %ld, expected %ld\n", L, nested (L), nested_ref (L));
+            ++failures;
+        }
+    }
+
+    printf ("failures: %u\n", failures);
+    return failures;
+}
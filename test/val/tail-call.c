@@ -0,0 +1,157 @@
+/*
+  !!DESCRIPTION!! Leaf functions without frames and calls at function end
+  !!ORIGIN!!      cc65 regression tests
+  !!LICENCE!!     Public Domain
+*/
+
+#include <stdio.h>
+#include <stdarg.h>
+
+static unsigned char failures = 0;
+
+#define CHECK(expr, expected)                                           \
+    do {                                                                \
+        long Result = (expr);                                           \
+        if (Result != (expected)) {                                     \
+            printf ("%s = %ld, expected %ld\n", #expr, Result,          \
+                    (long) (expected));                                 \
+            ++failures;                                                 \
+        }                                                               \
+    } while (0)
+
+static int calls;
+
+/* Leaf functions */
+static int inc (int x)
+{
+    return x + 1;
+}
+
+static unsigned char lower (unsigned char c)
+{
+    return c | 0x20;
+}
+
+static int same (int x)
+{
+    return x;
+}
+
+static long widen (int x)
+{
+    return (long) x << 4;
+}
+
+/* Calls at the end of a function */
+static int twice (int x)
+{
+    ++calls;
+    return inc (inc (x));
+}
+
+static unsigned char upper (unsigned char c)
+{
+    return lower (c ^ 0x20) ^ 0x20;
+}
+
+static int sum (int a, int b)
+{
+    return inc (a + b);
+}
+
+static int sum6 (int a, int b, int c, int d, int e, int f)
+{
+    return same (a + b + c + d + e + f);
+}
+
+static int pick (int x)
+{
+    if (x < 0) {
+        return inc (-x);
+    }
+    if (x > 100) {
+        return same (x);
+    }
+    return twice (x);
+}
+
+/* Tail recursion */
+static unsigned count (unsigned n)
+{
+    if (n == 0) {
+        return calls;
+    }
+    ++calls;
+    return count (n - 1);
+}
+
+/* Callees that take parameters on the stack or are variadic */
+static int sub (int a, int b)
+{
+    return a - b;
+}
+
+static int neg (int x)
+{
+    return sub (0, x);
+}
+
+static int add_all (int n, ...)
+{
+    va_list ap;
+    int s = 0;
+    va_start (ap, n);
+    while (n--) {
+        s += va_arg (ap, int);
+    }
+    va_end (ap);
+    return s;
+}
+
+static int three (int x)
+{
+    return add_all (3, x, x, x);
+}
+
+/* The callee gets the address of the parameter */
+static int deref (int* p)
+{
+    return *p * 2;
+}
+
+static int addr (int x)
+{
+    return deref (&x);
+}
+
+/* Function pointers */
+static int (*fp) (int) = inc;
+
+static int indirect (int x)
+{
+    return fp (x);
+}
+
+int main (void)
+{
+    CHECK (inc (41), 42);
+    CHECK (lower ('A'), 'a');
+    CHECK (same (-5), -5);
+    CHECK (widen (0x123), 0x1230L);
+    CHECK (twice (40), 42);
+    CHECK (upper ('a'), 'A');
+    CHECK (sum (1000, 2000), 3001);
+    CHECK (sum6 (1, 2, 3, 4, 5, 6), 21);
+    CHECK (pick (-7), 8);
+    CHECK (pick (200), 200);
+    CHECK (pick (7), 9);
+    calls = 0;
+    CHECK (count (50), 50);
+    CHECK (neg (5), -5);
+    CHECK (three (7), 21);
+    CHECK (addr (21), 42);
+    CHECK (indirect (1), 2);
+
+    printf ("failures: %u\n", failures);
+    return failures;
+}
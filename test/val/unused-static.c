@@ -0,0 +1,117 @@
+/*
+  !!DESCRIPTION!! Removal of unused static functions and data
+  !!ORIGIN!!      cc65 regression tests
+  !!LICENCE!!     Public Domain
+*/
+
+/* The functions and variables declared here are never defined. The program
+** links only if the static functions and data that use them are removed,
+** since nothing else imports them.
+*/
+
+#include <stdio.h>
+
+#pragma warn (unused-var, off)
+
+extern int missing_func (int x);
+extern int missing_data;
+
+static unsigned char failures = 0;
+
+#define CHECK(expr, expected)                                           \
+    do {                                                                \
+        int Result = (expr);                                            \
+        if (Result != (expected)) {                                     \
+            printf ("%s = %d, expected %d\n", #expr, Result,            \
+                    (int) (expected));                                  \
+            ++failures;                                                 \
+        }                                                               \
+    } while (0)
+
+/* Unused, only referenced by each other */
+static int unused_b (int x);
+
+static int unused_a (int x)
+{
+    return x > 0 ? unused_b (x - 1) : missing_func (x);
+}
+
+static int unused_b (int x)
+{
+    return unused_a (x) + missing_data;
+}
+
+static int (* const unused_table[]) (int) = { unused_a, unused_b };
+static int* unused_ptr = &missing_data;
+static const char* unused_names[] = { "unused", "names" };
+static char unused_buf[64];
+
+/* Used through a table */
+static int twice (int x)
+{
+    return x * 2;
+}
+
+static int square (int x)
+{
+    return x * x;
+}
+
+static int (* const used_table[]) (int) = { twice, square };
+
+/* Used through a pointer in another used object */
+static int used_value = 5;
+static int* const used_ptr = &used_value;
+
+/* Used in a declaration at file scope */
+static char sized_buf[10];
+static unsigned char sizes[] = { sizeof (sized_buf) };
+
+/* Used in inline assembler */
+static unsigned char asm_value = 42;
+
+/* Used by name in the text of inline assembler */
+static unsigned char counter;
+static unsigned char asm_func_called;
+
+static void asm_func (void)
+{
+    ++asm_func_called;
+}
+
+/* Used by an external object */
+static const char* used_names[] = { "names", "used" };
+const char** ext_names = used_names;
+
+static int recurse (int x)
+{
+    return x > 0 ? recurse (x - 1) + 1 : 0;
+}
+
+int main (void)
+{
+    static unsigned char a;
+
+    CHECK (used_table[0] (7), 14);
+    CHECK (used_table[1] (7), 49);
+    CHECK (*used_ptr, 5);
+    CHECK (sizes[0], 10);
+    CHECK (ext_names[1][0], 'u');
+    CHECK (recurse (3), 3);
+
+    __asm__ ("lda %v", asm_value);
+    __asm__ ("sta %v", a);
+    CHECK (a, 42);
+
+    counter = 0;
+    __asm__ ("inc _counter");
+    __asm__ ("inc _counter");
+    CHECK (counter, 2);
+    __asm__ ("jsr _asm_func");
+    CHECK (asm_func_called, 1);
+
+    if (failures) {
+        printf ("failures: %u\n", failures);
+    }
+    return failures;
+}
@@ -0,0 +1,41 @@
+#!/usr/bin/awk -f
+#
+#	Generate a C source that stresses the macro and symbol tables of
+#	cc65, like machine-generated register maps do. It defines many
+#	macros and global variables and uses some of them in a function:
+#
+#	  awk -f symbench.awk > symbench.c
+#	  time cc65 -o symbench.s symbench.c
+#
+#	The counts can be changed with -v macros=n -v globals=n -v uses=n
+#
+#	(C) 2026 The cc65 Authors, under the cc65 license
+#
+
+BEGIN {
+	if (macros == "")
+		macros = 50000
+	if (globals == "")
+		globals = 20000
+	if (uses == "")
+		uses = 2000
+
+	print "/* Generated by symbench.awk, do not edit */"
+	print ""
+	for (i = 0; i < macros; i++)
+		printf "#define DEV%03u_REG%05u_ADDR\t0x%04XU\n", i % 97, i, i % 65536
+	print ""
+	for (i = 0; i < globals; i++)
+		printf "extern unsigned char dev_state_%05u;\n", i
+	print ""
+	print "unsigned sum (void)"
+	print "{"
+	print "    unsigned s = 0;"
+	for (i = 0; i < uses; i++) {
+		m = int(i * macros / uses)
+		g = int(i * globals / uses)
+		printf "    s += DEV%03u_REG%05u_ADDR + dev_state_%05u;\n", m % 97, m, g
+	}
+	print "    return s;"
+	print "}"
+}